@@ -0,0 +1,284 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_FLAT_HASH_MAP_H
+#define SRSRAN_FLAT_HASH_MAP_H
+
+#include "detail/type_storage.h"
+#include "srsran/support/srsran_assert.h"
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <tuple>
+
+namespace srsran {
+
+/**
+ * Hash map that stores its entries in a single array, using open addressing with linear probing and a load factor of
+ * at most 1/2. Lookups touch one or two cache lines instead of walking the nodes of a tree or of a bucket list, and
+ * the entries are not allocated one by one.
+ * Erased entries leave a tombstone, so erasing while iterating is safe. The tombstones are dropped when the table is
+ * rehashed. Inserting may rehash the table, which invalidates all the iterators and references to the entries.
+ */
+template <typename K, typename V, typename Hash = std::hash<K> >
+class flat_hash_map
+{
+  enum class slot_state : uint8_t { empty, used, erased };
+
+  struct slot_t {
+    slot_state                                     state = slot_state::empty;
+    detail::type_storage<std::pair<const K, V> > storage;
+  };
+
+  template <typename MapPtr, typename Value>
+  class iter_impl
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = Value;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = value_type*;
+    using reference         = value_type&;
+
+    iter_impl() = default;
+    iter_impl(MapPtr map_, size_t idx_) : map(map_), idx(idx_)
+    {
+      if (idx < map->cap and map->slots[idx].state != slot_state::used) {
+        ++(*this);
+      }
+    }
+
+    iter_impl& operator++()
+    {
+      while (++idx < map->cap and map->slots[idx].state != slot_state::used) {
+      }
+      return *this;
+    }
+    iter_impl operator++(int)
+    {
+      iter_impl ret = *this;
+      ++(*this);
+      return ret;
+    }
+
+    reference operator*() const
+    {
+      srsran_assert(idx < map->cap, "Iterator out-of-bounds (%zd >= %zd)", idx, map->cap);
+      return map->slots[idx].storage.get();
+    }
+    pointer operator->() const { return &(**this); }
+
+    bool operator==(const iter_impl& other) const { return map == other.map and idx == other.idx; }
+    bool operator!=(const iter_impl& other) const { return not(*this == other); }
+
+  private:
+    friend class flat_hash_map<K, V, Hash>;
+    MapPtr map = nullptr;
+    size_t idx = 0;
+  };
+
+public:
+  using key_type       = K;
+  using mapped_type    = V;
+  using value_type     = std::pair<const K, V>;
+  using iterator       = iter_impl<flat_hash_map<K, V, Hash>*, value_type>;
+  using const_iterator = iter_impl<const flat_hash_map<K, V, Hash>*, const value_type>;
+
+  flat_hash_map() = default;
+  explicit flat_hash_map(size_t nof_entries) { reserve(nof_entries); }
+  flat_hash_map(flat_hash_map&& other) noexcept :
+    slots(std::move(other.slots)), cap(other.cap), nof_used(other.nof_used), nof_erased(other.nof_erased)
+  {
+    other.cap        = 0;
+    other.nof_used   = 0;
+    other.nof_erased = 0;
+  }
+  flat_hash_map& operator=(flat_hash_map&& other) noexcept
+  {
+    if (this != &other) {
+      clear();
+      slots            = std::move(other.slots);
+      cap              = other.cap;
+      nof_used         = other.nof_used;
+      nof_erased       = other.nof_erased;
+      other.cap        = 0;
+      other.nof_used   = 0;
+      other.nof_erased = 0;
+    }
+    return *this;
+  }
+  flat_hash_map(const flat_hash_map&) = delete;
+  flat_hash_map& operator=(const flat_hash_map&) = delete;
+  ~flat_hash_map() { clear(); }
+
+  iterator       begin() { return iterator(this, 0); }
+  iterator       end() { return iterator(this, cap); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, cap); }
+
+  size_t size() const { return nof_used; }
+  bool   empty() const { return nof_used == 0; }
+  size_t capacity() const { return cap; }
+
+  iterator       find(const K& key) { return iterator(this, find_idx(key)); }
+  const_iterator find(const K& key) const { return const_iterator(this, find_idx(key)); }
+  size_t         count(const K& key) const { return find_idx(key) < cap ? 1 : 0; }
+
+  /// Inserts key with a value built from args, unless key is already present
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(const K& key, Args&&... args)
+  {
+    size_t idx = find_idx(key);
+    if (idx < cap) {
+      return {iterator(this, idx), false};
+    }
+    if ((nof_used + nof_erased + 1) * 2 > cap) {
+      rehash(nof_used + 1);
+    }
+    idx = probe_free_idx(key);
+    if (slots[idx].state == slot_state::erased) {
+      nof_erased--;
+    }
+    slots[idx].storage.emplace(std::piecewise_construct,
+                               std::forward_as_tuple(key),
+                               std::forward_as_tuple(std::forward<Args>(args)...));
+    slots[idx].state = slot_state::used;
+    nof_used++;
+    return {iterator(this, idx), true};
+  }
+  std::pair<iterator, bool> insert(const value_type& kv) { return emplace(kv.first, kv.second); }
+
+  V& operator[](const K& key) { return emplace(key).first->second; }
+
+  /// Returns the number of erased entries
+  size_t erase(const K& key)
+  {
+    size_t idx = find_idx(key);
+    if (idx >= cap) {
+      return 0;
+    }
+    erase_idx(idx);
+    return 1;
+  }
+  /// Returns the iterator to the entry after it
+  iterator erase(iterator it)
+  {
+    erase_idx(it.idx);
+    return ++it;
+  }
+
+  void clear()
+  {
+    for (size_t i = 0; i < cap; ++i) {
+      if (slots[i].state == slot_state::used) {
+        slots[i].storage.destroy();
+      }
+      slots[i].state = slot_state::empty;
+    }
+    nof_used   = 0;
+    nof_erased = 0;
+  }
+
+  /// Grows the table so that nof_entries fit without a rehash
+  void reserve(size_t nof_entries)
+  {
+    if (nof_entries * 2 > cap) {
+      rehash(nof_entries);
+    }
+  }
+
+private:
+  static const size_t min_capacity = 16;
+
+  size_t home_idx(const K& key) const
+  {
+    // Fibonacci hashing spreads consecutive keys, like S1AP ids or TMSIs, over the table
+    uint64_t h = (uint64_t)Hash{}(key) * 0x9e3779b97f4a7c15ULL;
+    return (size_t)(h >> 32u) & (cap - 1);
+  }
+
+  /// Returns cap if key is not present
+  size_t find_idx(const K& key) const
+  {
+    if (nof_used == 0) {
+      return cap;
+    }
+    for (size_t idx = home_idx(key);; idx = (idx + 1) & (cap - 1)) {
+      const slot_t& s = slots[idx];
+      if (s.state == slot_state::empty) {
+        return cap;
+      }
+      if (s.state == slot_state::used and s.storage.get().first == key) {
+        return idx;
+      }
+    }
+  }
+
+  /// First empty or erased slot of the probe sequence of key. The table must have a free slot
+  size_t probe_free_idx(const K& key) const
+  {
+    size_t idx = home_idx(key);
+    while (slots[idx].state == slot_state::used) {
+      idx = (idx + 1) & (cap - 1);
+    }
+    return idx;
+  }
+
+  void erase_idx(size_t idx)
+  {
+    slots[idx].storage.destroy();
+    slots[idx].state = slot_state::erased;
+    nof_used--;
+    nof_erased++;
+  }
+
+  /// Moves the entries to a table sized for nof_entries, dropping the tombstones
+  void rehash(size_t nof_entries)
+  {
+    size_t new_cap = min_capacity;
+    while (new_cap < 2 * nof_entries) {
+      new_cap *= 2;
+    }
+    std::unique_ptr<slot_t[]> old_slots = std::move(slots);
+    size_t                    old_cap   = cap;
+    slots.reset(new slot_t[new_cap]);
+    cap        = new_cap;
+    nof_erased = 0;
+    for (size_t i = 0; i < old_cap; ++i) {
+      slot_t& s = old_slots[i];
+      if (s.state == slot_state::used) {
+        size_t idx = probe_free_idx(s.storage.get().first);
+        slots[idx].storage.emplace(std::move(s.storage.get()));
+        slots[idx].state = slot_state::used;
+        s.storage.destroy();
+      }
+    }
+  }
+
+  std::unique_ptr<slot_t[]> slots;
+  size_t                    cap        = 0;
+  size_t                    nof_used   = 0;
+  size_t                    nof_erased = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_FLAT_HASH_MAP_H
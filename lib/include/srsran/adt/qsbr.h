@@ -0,0 +1,231 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_QSBR_H
+#define SRSRAN_QSBR_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Quiescent-state based reclamation domain.
+ * Reader threads register once and then report quiescent states, i.e. points where they hold no pointer to shared
+ * data, or go offline while they block. The memory retired by a writer can be freed once all the online readers went
+ * through a quiescent state, so the read side needs no locks nor atomic read-modify-write operations.
+ */
+class qsbr_domain
+{
+public:
+  /// Readers are kept in blocks of this size. A block is appended when all the readers of the previous ones are in use
+  static const uint32_t readers_per_block = 64;
+
+  qsbr_domain() = default;
+  qsbr_domain(const qsbr_domain&) = delete;
+  qsbr_domain& operator=(const qsbr_domain&) = delete;
+
+  /// Registers the calling thread as a reader, initially online. Returns the reader id
+  uint32_t register_reader()
+  {
+    uint32_t        first_id = 0;
+    reader_block_t* block    = &first_block;
+    while (true) {
+      for (uint32_t i = 0; i < readers_per_block; ++i) {
+        bool expected = false;
+        if (block->readers[i].used.compare_exchange_strong(expected, true)) {
+          go_online(first_id + i);
+          return first_id + i;
+        }
+      }
+      // Blocks are never moved nor freed while the domain exists, so the ids of the other readers stay valid
+      reader_block_t* next = block->next.load(std::memory_order_seq_cst);
+      if (next == nullptr) {
+        std::unique_ptr<reader_block_t> new_block(new reader_block_t);
+        if (block->next.compare_exchange_strong(next, new_block.get(), std::memory_order_seq_cst)) {
+          next = new_block.release();
+        }
+      }
+      block = next;
+      first_id += readers_per_block;
+    }
+  }
+  void unregister_reader(uint32_t reader_id)
+  {
+    go_offline(reader_id);
+    get_reader(reader_id).used.store(false, std::memory_order_release);
+  }
+
+  /// The reader holds no reference to the data protected by this domain
+  void quiescent(uint32_t reader_id) { go_online(reader_id); }
+  /// The reader stops accessing the protected data, e.g. before blocking. It does not delay reclamation while offline
+  void go_offline(uint32_t reader_id) { get_reader(reader_id).epoch.store(offline_epoch, std::memory_order_release); }
+  void go_online(uint32_t reader_id)
+  {
+    // The release store orders the reads of the previous critical section before the writer frees what they accessed
+    get_reader(reader_id).epoch.store(global_epoch.load(std::memory_order_acquire), std::memory_order_release);
+    // The announced epoch must be visible to the writer before the reader loads any shared pointer
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  /// Writer side. Called after unpublishing some data. Returns the epoch after which the data can be freed
+  uint64_t start_grace_period() { return global_epoch.fetch_add(1, std::memory_order_seq_cst) + 1; }
+
+  /// Writer side. True once no online reader can still hold data retired at the given epoch
+  bool is_grace_period_over(uint64_t epoch) const
+  {
+    for (const reader_block_t* block = &first_block; block != nullptr;
+         block                       = block->next.load(std::memory_order_seq_cst)) {
+      for (const reader_t& r : block->readers) {
+        uint64_t e = r.epoch.load(std::memory_order_seq_cst);
+        if (e != offline_epoch and e < epoch) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+private:
+  static const uint64_t offline_epoch = 0;
+
+  struct reader_t {
+    std::atomic<uint64_t> epoch{offline_epoch};
+    std::atomic<bool>     used{false};
+    char                  padding[64 - sizeof(std::atomic<uint64_t>) - sizeof(std::atomic<bool>)]; ///< no false sharing
+  };
+  struct reader_block_t {
+    reader_block_t() = default;
+    ~reader_block_t() { delete next.load(std::memory_order_relaxed); }
+    reader_block_t(const reader_block_t&) = delete;
+    reader_block_t& operator=(const reader_block_t&) = delete;
+
+    std::array<reader_t, readers_per_block> readers;
+    std::atomic<reader_block_t*>             next{nullptr};
+  };
+
+  reader_t& get_reader(uint32_t reader_id)
+  {
+    reader_block_t* block = &first_block;
+    for (; reader_id >= readers_per_block; reader_id -= readers_per_block) {
+      block = block->next.load(std::memory_order_acquire);
+    }
+    return block->readers[reader_id];
+  }
+
+  std::atomic<uint64_t> global_epoch{1};
+  reader_block_t        first_block;
+};
+
+/**
+ * Objects unpublished by the writer of a qsbr_domain, waiting for the readers to go through a quiescent state before
+ * being deleted. Writer side only.
+ */
+template <typename T>
+class qsbr_retire_list
+{
+public:
+  explicit qsbr_retire_list(qsbr_domain& qsbr_) : qsbr(qsbr_) {}
+  ~qsbr_retire_list()
+  {
+    for (auto& r : retired) {
+      delete r.second;
+    }
+  }
+  qsbr_retire_list(const qsbr_retire_list&) = delete;
+  qsbr_retire_list& operator=(const qsbr_retire_list&) = delete;
+
+  /// Takes the ownership of an object that no reader can find anymore
+  void retire(std::unique_ptr<T> obj)
+  {
+    retired.emplace_back(qsbr.start_grace_period(), obj.release());
+    reclaim();
+  }
+
+  /// Deletes the objects that no reader can access anymore
+  void reclaim()
+  {
+    size_t n = 0;
+    for (auto& r : retired) {
+      if (qsbr.is_grace_period_over(r.first)) {
+        delete r.second;
+      } else {
+        retired[n++] = r;
+      }
+    }
+    retired.resize(n);
+  }
+
+  size_t size() const { return retired.size(); }
+
+private:
+  qsbr_domain&                          qsbr;
+  std::vector<std::pair<uint64_t, T*> > retired;
+};
+
+/**
+ * Read-side critical section on a process-wide qsbr_domain, returned by get_domain(). Meant for readers that are not
+ * dedicated threads with a loop where to report quiescent states: every thread is registered as a reader the first
+ * time it enters a guard and unregistered when it exits, and it stays offline outside of the guards. Guards can be
+ * nested.
+ */
+template <qsbr_domain& (*get_domain)()>
+class qsbr_read_guard
+{
+public:
+  qsbr_read_guard() : reader(this_thread_reader())
+  {
+    if (reader.depth++ == 0) {
+      get_domain().go_online(reader.id);
+    }
+  }
+  ~qsbr_read_guard()
+  {
+    if (--reader.depth == 0) {
+      get_domain().go_offline(reader.id);
+    }
+  }
+  qsbr_read_guard(const qsbr_read_guard&) = delete;
+  qsbr_read_guard& operator=(const qsbr_read_guard&) = delete;
+
+private:
+  struct reader_t {
+    reader_t() : id(get_domain().register_reader()) { get_domain().go_offline(id); }
+    ~reader_t() { get_domain().unregister_reader(id); }
+    uint32_t id;
+    uint32_t depth = 0;
+  };
+
+  static reader_t& this_thread_reader()
+  {
+    static thread_local reader_t reader;
+    return reader;
+  }
+
+  reader_t& reader;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_QSBR_H
@@ -0,0 +1,189 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RCU_HASH_MAP_H
+#define SRSRAN_RCU_HASH_MAP_H
+
+#include "srsran/adt/qsbr.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Hash map with wait-free lookups from any number of reader threads and updates from a single writer at a time.
+ * Each bucket holds a chain of immutable nodes. The writer publishes a single-key update by relinking one node of the
+ * chain with an atomic store, and retires only the unlinked node, which is freed once the readers of the qsbr_domain
+ * went through a quiescent state. The bucket array is only copied when it doubles its size, so the cost of the updates
+ * does not grow with the number of entries. This suits tables that are looked up for every packet but only modified by
+ * control plane procedures.
+ */
+template <typename K, typename V, typename Hash = std::hash<K> >
+class rcu_hash_map
+{
+  struct node_t {
+    node_t(const K& key_, const V& value_, node_t* next_) : key(key_), value(value_), next(next_) {}
+    const K              key;
+    const V              value;
+    std::atomic<node_t*> next;
+  };
+  struct table_t {
+    explicit table_t(size_t capacity) : buckets(capacity), mask(capacity - 1)
+    {
+      for (std::atomic<node_t*>& b : buckets) {
+        b.store(nullptr, std::memory_order_relaxed);
+      }
+    }
+    ~table_t()
+    {
+      // The table owns the nodes still linked in its chains
+      for (std::atomic<node_t*>& b : buckets) {
+        node_t* n = b.load(std::memory_order_relaxed);
+        while (n != nullptr) {
+          node_t* next = n->next.load(std::memory_order_relaxed);
+          delete n;
+          n = next;
+        }
+      }
+    }
+    std::vector<std::atomic<node_t*> > buckets;
+    size_t                             mask;
+  };
+
+public:
+  explicit rcu_hash_map(qsbr_domain& qsbr_) :
+    table(new table_t(min_capacity)), retired_nodes(qsbr_), retired_tables(qsbr_)
+  {}
+  ~rcu_hash_map() { delete table.load(std::memory_order_relaxed); }
+  rcu_hash_map(const rcu_hash_map&) = delete;
+  rcu_hash_map& operator=(const rcu_hash_map&) = delete;
+
+  /// Reader side. Copies the value of key into value. Returns false if key is not present
+  bool find(const K& key, V& value) const
+  {
+    const table_t* t = table.load(std::memory_order_acquire);
+    for (const node_t* n = t->buckets[hash_index(*t, key)].load(std::memory_order_acquire); n != nullptr;
+         n               = n->next.load(std::memory_order_acquire)) {
+      if (n->key == key) {
+        value = n->value;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Writer side. Inserts key or replaces its value
+  void insert(const K& key, const V& value)
+  {
+    table_t*              t    = table.load(std::memory_order_relaxed);
+    std::atomic<node_t*>* link = find_link(*t, key);
+    node_t*               old  = link->load(std::memory_order_relaxed);
+    if (old != nullptr) {
+      // The new node takes the place of the old one in the chain
+      link->store(new node_t(key, value, old->next.load(std::memory_order_relaxed)), std::memory_order_seq_cst);
+      retired_nodes.retire(std::unique_ptr<node_t>(old));
+      return;
+    }
+
+    // New keys are pushed at the head of the chain
+    std::atomic<node_t*>& head = t->buckets[hash_index(*t, key)];
+    head.store(new node_t(key, value, head.load(std::memory_order_relaxed)), std::memory_order_release);
+    if (++count > t->buckets.size()) {
+      grow();
+    }
+  }
+
+  /// Writer side. Returns false if key is not present
+  bool erase(const K& key)
+  {
+    std::atomic<node_t*>* link = find_link(*table.load(std::memory_order_relaxed), key);
+    node_t*               old  = link->load(std::memory_order_relaxed);
+    if (old == nullptr) {
+      return false;
+    }
+    // The node must be unlinked before the grace period starts, hence the sequentially consistent store
+    link->store(old->next.load(std::memory_order_relaxed), std::memory_order_seq_cst);
+    retired_nodes.retire(std::unique_ptr<node_t>(old));
+    count--;
+    return true;
+  }
+
+  /// Writer side
+  size_t size() const { return count; }
+  bool   empty() const { return size() == 0; }
+
+  /// Writer side. Frees the nodes and tables that no reader can access anymore. Also called on every update
+  void reclaim()
+  {
+    retired_nodes.reclaim();
+    retired_tables.reclaim();
+  }
+
+  /// Writer side. Number of nodes and tables waiting for the readers to be freed
+  size_t nof_retired() const { return retired_nodes.size() + retired_tables.size(); }
+
+private:
+  static const size_t min_capacity = 16;
+
+  static size_t hash_index(const table_t& t, const K& key)
+  {
+    // Fibonacci hashing spreads consecutive keys, like UE IPs or TEIDs, over the table
+    uint64_t h = (uint64_t)Hash{}(key) * 0x9e3779b97f4a7c15ULL;
+    return (size_t)(h >> 32u) & t.mask;
+  }
+
+  /// Returns the link pointing to the node of key, or the null link at the end of its chain if not present
+  static std::atomic<node_t*>* find_link(table_t& t, const K& key)
+  {
+    std::atomic<node_t*>* link = &t.buckets[hash_index(t, key)];
+    for (node_t* n = link->load(std::memory_order_relaxed); n != nullptr and not(n->key == key);
+         n         = link->load(std::memory_order_relaxed)) {
+      link = &n->next;
+    }
+    return link;
+  }
+
+  /// Doubles the number of buckets. Readers may still traverse the old chains, so the nodes are copied
+  void grow()
+  {
+    table_t*                 old_t = table.load(std::memory_order_relaxed);
+    std::unique_ptr<table_t> new_t(new table_t(2 * old_t->buckets.size()));
+    for (std::atomic<node_t*>& b : old_t->buckets) {
+      for (node_t* n = b.load(std::memory_order_relaxed); n != nullptr; n = n->next.load(std::memory_order_relaxed)) {
+        std::atomic<node_t*>& head = new_t->buckets[hash_index(*new_t, n->key)];
+        head.store(new node_t(n->key, n->value, head.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+      }
+    }
+    table.store(new_t.release(), std::memory_order_seq_cst);
+    retired_tables.retire(std::unique_ptr<table_t>(old_t));
+  }
+
+  std::atomic<table_t*>     table;
+  size_t                    count = 0;
+  qsbr_retire_list<node_t>  retired_nodes;
+  qsbr_retire_list<table_t> retired_tables;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_RCU_HASH_MAP_H
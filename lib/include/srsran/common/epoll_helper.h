@@ -26,13 +26,20 @@
 #ifndef SRSRAN_EPOLL_HELPER_H
 #define SRSRAN_EPOLL_HELPER_H
 
+#include "srsran/adt/move_callback.h"
+#include "srsran/config.h"
 #include <atomic>
 #include <functional>
+#include <memory>
 #include <signal.h>
+#include <string.h>
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/signalfd.h>
 #include <sys/timerfd.h>
 #include <unistd.h>
+#include <unordered_map>
+#include <vector>
 
 ///< A virtual interface to handle epoll events (used by timer and port handler)
 class epoll_handler
@@ -175,4 +182,154 @@ inline int del_epoll(int fd, int epoll_fd)
   return SRSRAN_SUCCESS;
 }
 
+///< Reactor that dispatches the epoll events of a set of fds to their callbacks.
+///< The fds are level-triggered, so a callback may read a single message per call and is called again while the fd
+///< has data. The reactor is not thread-safe, except for wakeup(), which interrupts a blocked wait_events() from any
+///< thread. Fds can be added and removed from within the callbacks.
+class epoll_reactor
+{
+public:
+  using callback_t = srsran::move_callback<void(int)>;
+
+  epoll_reactor()
+  {
+    epoll_fd  = epoll_create1(EPOLL_CLOEXEC);
+    wakeup_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd == -1 or wakeup_fd == -1) {
+      fprintf(stderr, "failed to create epoll reactor: %s\n", strerror(errno));
+      return;
+    }
+    struct epoll_event ev = {};
+    ev.data.u64           = wakeup_id;
+    ev.events             = EPOLLIN;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wakeup_fd, &ev) == -1) {
+      fprintf(stderr, "epoll_ctl failed for fd=%d\n", wakeup_fd);
+    }
+  }
+  ~epoll_reactor()
+  {
+    if (epoll_fd >= 0) {
+      close(epoll_fd);
+    }
+    if (wakeup_fd >= 0) {
+      close(wakeup_fd);
+    }
+  }
+  epoll_reactor(const epoll_reactor&) = delete;
+  epoll_reactor& operator=(const epoll_reactor&) = delete;
+
+  bool   is_valid() const { return epoll_fd >= 0 and wakeup_fd >= 0; }
+  bool   has_fd(int fd) const { return fds.count(fd) > 0; }
+  size_t nof_fds() const { return fds.size(); }
+
+  ///< Registers fd. callback is called with the fd as argument whenever the fd is readable
+  bool add_fd(int fd, callback_t callback)
+  {
+    if (fd < 0 or has_fd(fd)) {
+      return false;
+    }
+    // The generation tells apart the events of a removed fd from the ones of a new fd with the same number
+    uint32_t           gen = next_gen++;
+    struct epoll_event ev  = {};
+    ev.data.u64            = ((uint64_t)gen << 32u) | (uint32_t)fd;
+    ev.events              = EPOLLIN;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+      fprintf(stderr, "epoll_ctl failed for fd=%d\n", fd);
+      return false;
+    }
+    fds.emplace(fd, fd_entry_t{gen, std::unique_ptr<callback_t>(new callback_t(std::move(callback)))});
+    return true;
+  }
+
+  ///< Unregisters fd. Its callback is not called anymore, even for events already returned by wait_events()
+  bool rem_fd(int fd)
+  {
+    auto it = fds.find(fd);
+    if (it == fds.end()) {
+      return false;
+    }
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr) == -1) {
+      // The fd may have been closed already, which removes it from the epoll set
+      if (errno != EBADF and errno != ENOENT) {
+        fprintf(stderr, "epoll_ctl failed for fd=%d\n", fd);
+      }
+    }
+    // The callback may be the one running. Destroy it once the events are handled, without moving it in memory
+    removed_callbacks.push_back(std::move(it->second.callback));
+    fds.erase(it);
+    return true;
+  }
+
+  ///< Blocks until an fd is readable, wakeup() is called or timeout_ms elapses (-1 for no timeout).
+  ///< Returns the number of events or -1 on error
+  int wait_events(int timeout_ms = -1)
+  {
+    nof_events = 0;
+    int n      = epoll_wait(epoll_fd, events, max_events, timeout_ms);
+    if (n == -1) {
+      return errno == EINTR ? 0 : SRSRAN_ERROR;
+    }
+    nof_events = n;
+    return n;
+  }
+
+  ///< Calls the callbacks of the fds returned by the last wait_events()
+  void handle_events()
+  {
+    for (int i = 0; i < nof_events; ++i) {
+      uint64_t id = events[i].data.u64;
+      if (id == wakeup_id) {
+        uint64_t val;
+        while (read(wakeup_fd, &val, sizeof(val)) == sizeof(val)) {
+        }
+        continue;
+      }
+      int  fd = (int)(uint32_t)id;
+      auto it = fds.find(fd);
+      if (it == fds.end() or it->second.gen != (uint32_t)(id >> 32u)) {
+        continue;
+      }
+      (*it->second.callback)(fd);
+    }
+    nof_events = 0;
+    removed_callbacks.clear();
+  }
+
+  ///< Waits for events and handles them. Returns the number of events or -1 on error
+  int run_once(int timeout_ms = -1)
+  {
+    int n = wait_events(timeout_ms);
+    if (n > 0) {
+      handle_events();
+    }
+    return n;
+  }
+
+  ///< Interrupts wait_events(). Can be called from any thread
+  void wakeup()
+  {
+    uint64_t val = 1;
+    if (write(wakeup_fd, &val, sizeof(val)) != sizeof(val)) {
+      fprintf(stderr, "failed to write to epoll reactor wakeup fd\n");
+    }
+  }
+
+private:
+  static const int      max_events = 64;
+  static const uint64_t wakeup_id  = UINT64_MAX;
+
+  struct fd_entry_t {
+    uint32_t                    gen;
+    std::unique_ptr<callback_t> callback;
+  };
+
+  int                                        epoll_fd  = -1;
+  int                                        wakeup_fd = -1;
+  uint32_t                                   next_gen  = 0;
+  std::unordered_map<int, fd_entry_t>        fds;
+  std::vector<std::unique_ptr<callback_t> > removed_callbacks;
+  struct epoll_event                         events[max_events];
+  int                                        nof_events = 0;
+};
+
 #endif // SRSRAN_EPOLL_HELPER_H
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_LATENCY_HISTOGRAM_H
+#define SRSRAN_LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace srsran {
+
+/// Latency percentiles of a processing stage over a metrics period, in microseconds.
+struct latency_metrics_t {
+  uint32_t nof_samples = 0;
+  float    p50_us      = 0;
+  float    p99_us      = 0;
+  float    p999_us     = 0;
+  float    max_us      = 0;
+};
+
+/**
+ * Histogram of latencies in the style of HDR histograms: buckets grow in powers of two and each one is split into
+ * nof_sub_buckets linear sub-buckets, so the percentiles have a relative error below 1/nof_sub_buckets for any value
+ * between 1 nsec and ~18 minutes, with a fixed memory footprint.
+ * record() is lock-free, so each worker thread can record into its own histogram at every TTI. The metrics thread
+ * collects and resets the samples of the last period with read_and_reset().
+ */
+class latency_histogram
+{
+public:
+  static constexpr uint32_t sub_bucket_bits = 5;
+  static constexpr uint32_t nof_sub_buckets = 1U << sub_bucket_bits;
+  static constexpr uint32_t max_value_bits  = 40;
+  static constexpr uint32_t nof_buckets     = nof_sub_buckets * (max_value_bits - sub_bucket_bits + 1);
+
+  /// Samples of one or more histograms, collected by the metrics thread.
+  struct snapshot {
+    std::array<uint64_t, nof_buckets> counts      = {};
+    uint64_t                          nof_samples = 0;
+    uint64_t                          max_ns      = 0;
+
+    /// Returns the highest latency among the q-quantile of samples, with q in [0, 1].
+    uint64_t          percentile_ns(double q) const;
+    latency_metrics_t get_metrics() const;
+  };
+
+  latency_histogram();
+  latency_histogram(const latency_histogram&) = delete;
+  latency_histogram& operator=(const latency_histogram&) = delete;
+
+  void record(std::chrono::nanoseconds latency)
+  {
+    uint64_t value = latency.count() > 0 ? static_cast<uint64_t>(latency.count()) : 0;
+    counts[bucket_idx(value)].fetch_add(1, std::memory_order_relaxed);
+    uint64_t prev_max = max_ns.load(std::memory_order_relaxed);
+    while (value > prev_max and not max_ns.compare_exchange_weak(prev_max, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  /// Adds the samples recorded since the last call to the given snapshot, and clears them from the histogram.
+  void read_and_reset(snapshot& s);
+
+  static uint32_t bucket_idx(uint64_t value_ns)
+  {
+    value_ns = std::min(value_ns, (uint64_t(1) << max_value_bits) - 1);
+    if (value_ns < nof_sub_buckets) {
+      return static_cast<uint32_t>(value_ns);
+    }
+    uint32_t shift = (63 - __builtin_clzll(value_ns)) - sub_bucket_bits;
+    return nof_sub_buckets * (shift + 1) + static_cast<uint32_t>(value_ns >> shift) - nof_sub_buckets;
+  }
+  /// Highest value that falls in the given bucket.
+  static uint64_t bucket_max_value(uint32_t idx);
+
+private:
+  std::array<std::atomic<uint32_t>, nof_buckets> counts;
+  std::atomic<uint64_t>                          max_ns{0};
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_LATENCY_HISTOGRAM_H
@@ -23,10 +23,12 @@
 #define SRSRAN_RX_SOCKET_HANDLER_H
 
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/epoll_helper.h"
 #include "srsran/common/multiqueue.h"
 #include "srsran/common/threads.h"
 
 #include <arpa/inet.h>
+#include <array>
 #include <map>
 #include <mutex>
 #include <netinet/in.h>
@@ -104,6 +106,66 @@ bool sctp_init_socket(unique_socket* socket, net_utils::socket_type socktype, co
 
 } // namespace net_utils
 
+/****************************
+ * UDP batched IO
+ ***************************/
+
+/**
+ * Description: Reads all the datagrams pending in a UDP socket with a single recvmmsg() call. The byte buffers are
+ *              allocated from the pool once per batch, only for the slots whose PDU was taken in the previous call
+ */
+class udp_rx_batch
+{
+public:
+  static const uint32_t max_batch_size = 32;
+
+  explicit udp_rx_batch(uint32_t batch_size_ = max_batch_size);
+
+  /// Reads up to batch_size datagrams without blocking. Returns the number of datagrams read or -1 on error
+  int recv(int fd);
+
+  uint32_t             size() const { return nof_pdus; }
+  byte_buffer_t*       get_pdu(uint32_t idx) { return pdus[idx].get(); }
+  unique_byte_buffer_t pop_pdu(uint32_t idx) { return std::move(pdus[idx]); }
+  const sockaddr_in&   get_addr(uint32_t idx) const { return addrs[idx]; }
+
+private:
+  uint32_t                                         batch_size;
+  uint32_t                                         nof_pdus = 0;
+  std::array<unique_byte_buffer_t, max_batch_size> pdus;
+  std::array<sockaddr_in, max_batch_size>          addrs;
+};
+
+/**
+ * Description: Queues UDP datagrams and sends them with a single sendmmsg() call once the batch is full or when
+ *              flush() is called
+ */
+class udp_tx_batch
+{
+public:
+  static const uint32_t max_batch_size = 32;
+
+  explicit udp_tx_batch(srslog::basic_logger& logger_, uint32_t batch_size_ = max_batch_size);
+
+  void set_fd(int fd_) { fd = fd_; }
+
+  /// Queues a datagram. With a batch size of 1 the datagram is sent right away
+  void push(unique_byte_buffer_t pdu, const sockaddr_in& dest_addr);
+
+  /// Sends the queued datagrams. Returns the number of datagrams sent
+  uint32_t flush();
+
+  uint32_t size() const { return nof_pdus; }
+
+private:
+  srslog::basic_logger&                            logger;
+  int                                              fd = -1;
+  uint32_t                                         batch_size;
+  uint32_t                                         nof_pdus = 0;
+  std::array<unique_byte_buffer_t, max_batch_size> pdus;
+  std::array<sockaddr_in, max_batch_size>          addrs;
+};
+
 /****************************
  * Rx multisocket handler
  ***************************/
@@ -132,7 +194,7 @@ protected:
 };
 
 /**
- * Description - Instantiates a thread that will block waiting for IO from multiple sockets, via a select
+ * Description - Instantiates a thread that will block waiting for IO from multiple sockets, via epoll
  *               The user can register their own (socket fd, data handler) in this class via the
  *               add_socket_handler(fd, task) API or its other variants
  */
@@ -145,7 +207,7 @@ public:
   ~socket_manager() final;
 
   void stop();
-  bool remove_socket_nonblocking(int fd, bool signal_completion = false);
+  /// Once it returns, the handler of the socket is not called anymore
   bool remove_socket(int fd) final;
   bool add_socket_handler(int fd, recv_callback_t handler) final;
 
@@ -154,23 +216,10 @@ public:
 private:
   const int thread_prio = 65;
 
-  // used to unlock select
-  struct ctrl_cmd_t {
-    enum class cmd_id_t { EXIT, NEW_FD, RM_FD };
-    cmd_id_t cmd;
-    int      new_fd;
-    bool     signal_rm_complete;
-    ctrl_cmd_t() { bzero(this, sizeof(ctrl_cmd_t)); }
-  };
-  std::map<int, recv_callback_t>::iterator remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max_fd);
-
-  // state
-  std::mutex                     socket_mutex;
-  std::map<int, recv_callback_t> active_sockets;
-  std::atomic<bool>              running   = {false};
-  int                            pipefd[2] = {-1, -1};
-  std::vector<int>               rem_fd_tmp_list;
-  std::condition_variable        rem_cvar;
+  // state. The mutex is held while the handlers run, so sockets can be added and removed from any other thread
+  std::mutex        socket_mutex;
+  epoll_reactor     reactor;
+  std::atomic<bool> running = {false};
 };
 
 /// Function signature for SDU byte buffers received from SCTP socket
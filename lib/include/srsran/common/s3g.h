@@ -39,8 +39,8 @@
 #include <string.h>
 
 typedef struct {
-  uint32_t* lfsr;
-  uint32_t* fsm;
+  uint32_t lfsr[16];
+  uint32_t fsm[3];
 } S3G_STATE;
 
 /* Initialization.
@@ -50,7 +50,7 @@ typedef struct {
  * See Section 4.1.
  */
 
-void s3g_initialize(S3G_STATE* state, uint32_t k[4], uint32_t iv[4]);
+void s3g_initialize(S3G_STATE* state, const uint32_t k[4], const uint32_t iv[4]);
 
 /*********************************************************************
     Name: s3g_deinitialize
@@ -72,6 +72,20 @@ void s3g_deinitialize(S3G_STATE* state);
 
 void s3g_generate_keystream(S3G_STATE* state, uint32_t n, uint32_t* ks);
 
+/* Generation of Keystream for several key/iv pairs.
+ * input nof_streams: number of independent keystreams.
+ * input k, iv: key and initialization variable of each keystream.
+ * input n: number of 32-bit words of each keystream.
+ * output: generated keystreams which are filled in ks.
+ * Keystreams are generated in parallel, one per SIMD lane.
+ */
+
+void s3g_generate_keystream_multi(uint32_t         nof_streams,
+                                  const uint32_t (*k)[4],
+                                  const uint32_t (*iv)[4],
+                                  const uint32_t*  n,
+                                  uint32_t* const* ks);
+
 /* f8.
  * Input key: 128 bit Confidentiality Key.
  * Input count:32-bit Count, Frame dependent input.
@@ -29,6 +29,7 @@
 #include "srsran/common/common.h"
 #include "srsran/srslog/srslog.h"
 
+#include <memory>
 #include <vector>
 
 #define AKA_RAND_LEN 16
@@ -42,6 +43,9 @@
 #define SQN_LEN 6
 
 #define KEY_LEN 32
+
+struct mbedtls_aes_context;
+
 namespace srsran {
 
 typedef enum {
@@ -309,6 +313,83 @@ uint8_t security_128_eea3(uint8_t* key,
                           uint32_t msg_len,
                           uint8_t* msg_out);
 
+/**
+ * @brief One message of a multi-buffer EEA1/EEA3 call. msg and msg_out may point to the same buffer.
+ */
+struct security_cipher_msg_t {
+  const uint8_t* key;       ///< 128-bit ciphering key
+  uint32_t       count;     ///< COUNT of the message
+  uint8_t        bearer;    ///< Bearer identity
+  uint8_t        direction; ///< Direction of transmission
+  const uint8_t* msg;       ///< Input message
+  uint32_t       msg_len;   ///< Length of the message in bytes
+  uint8_t*       msg_out;   ///< Output message
+};
+
+/**
+ * @brief Ciphers several independent messages with EEA1/EEA3. The keystreams of up to one SIMD vector of messages are
+ * generated in parallel, one per lane, so messages of similar length should be passed together.
+ */
+uint8_t security_128_eea1_multi(const security_cipher_msg_t* msgs, uint32_t nof_msgs);
+
+uint8_t security_128_eea3_multi(const security_cipher_msg_t* msgs, uint32_t nof_msgs);
+
+/******************************************************************************
+ * Expanded AES-128 keys
+ *****************************************************************************/
+
+/**
+ * @brief AES-128 key with its expanded schedule and CMAC subkeys. It is computed once when the key is configured, so
+ * EEA2/EIA2 do not repeat the key expansion for every message. The block cipher uses AES-NI/VAES or the ARMv8 crypto
+ * extensions when the build target supports them and falls back to mbedTLS otherwise.
+ */
+class security_aes128_key_t
+{
+public:
+  security_aes128_key_t();
+  ~security_aes128_key_t();
+  security_aes128_key_t(const security_aes128_key_t&) = delete;
+  security_aes128_key_t& operator=(const security_aes128_key_t&) = delete;
+
+  /// Expands the given 128-bit key
+  void set_key(const uint8_t* key);
+  bool is_set() const { return valid; }
+
+  /// Encrypts a single 16 byte block, input and output can be the same buffer
+  void encrypt_block(const uint8_t* in, uint8_t* out) const;
+
+  /// Generates the keystream of the given counter block and XOR it with the input, input and output can be the same
+  void crypt_ctr(const uint8_t* nonce_cnt, const uint8_t* in, uint32_t len, uint8_t* out) const;
+
+  const uint8_t* get_k1() const { return k1; }
+  const uint8_t* get_k2() const { return k2; }
+
+private:
+  static const uint32_t NOF_ROUND_KEYS = 11;
+
+  bool                                 valid = false;
+  alignas(16) uint8_t                  round_keys[NOF_ROUND_KEYS * 16];
+  uint8_t                              k1[16];
+  uint8_t                              k2[16];
+  std::unique_ptr<mbedtls_aes_context> sw_ctx; ///< Only used without hardware acceleration
+};
+
+uint8_t security_128_eia2(const security_aes128_key_t& key,
+                          uint32_t                     count,
+                          uint32_t                     bearer,
+                          uint8_t                      direction,
+                          const uint8_t*               msg,
+                          uint32_t                     msg_len,
+                          uint8_t*                     mac);
+
+uint8_t security_128_eea2(const security_aes128_key_t& key,
+                          uint32_t                     count,
+                          uint8_t                      bearer,
+                          uint8_t                      direction,
+                          const uint8_t*               msg,
+                          uint32_t                     msg_len,
+                          uint8_t*                     msg_out);
+
 /******************************************************************************
  * Authentication
  *****************************************************************************/
@@ -323,6 +404,30 @@ security_milenage_f2345(uint8_t* k, uint8_t* op, uint8_t* rand, uint8_t* res, ui
 
 uint8_t security_milenage_f5_star(uint8_t* k, uint8_t* op, uint8_t* rand, uint8_t* ak);
 
+/**
+ * @brief Inputs and outputs of the Milenage functions f1 to f5 for one authentication vector.
+ */
+struct security_milenage_vector_t {
+  uint8_t rand[16]; ///< Random challenge
+  uint8_t sqn[6];   ///< Sequence number
+  uint8_t amf[2];   ///< Authentication management field
+  uint8_t mac_a[8]; ///< Output of f1
+  uint8_t res[8];   ///< Output of f2
+  uint8_t ck[16];   ///< Output of f3
+  uint8_t ik[16];   ///< Output of f4
+  uint8_t ak[6];    ///< Output of f5
+};
+
+/**
+ * @brief Computes f1 to f5 of several authentication vectors of the same subscriber, with the same results as
+ * security_milenage_f1() and security_milenage_f2345(). K is expanded once for all the vectors and f1 and f2345 share the
+ * TEMP block, so each vector takes 5 AES block encryptions instead of 2 key expansions and 6 encryptions.
+ */
+uint8_t security_milenage_f12345_multi(const uint8_t*              k,
+                                       const uint8_t*              opc,
+                                       security_milenage_vector_t* vectors,
+                                       uint32_t                    nof_vectors);
+
 int security_xor_f2345(uint8_t* k, uint8_t* rand, uint8_t* res, uint8_t* ck, uint8_t* ik, uint8_t* ak);
 int security_xor_f1(uint8_t* k, uint8_t* rand, uint8_t* sqn, uint8_t* amf, uint8_t* mac_a);
 
@@ -53,7 +53,15 @@ typedef struct {
   u32 BRC_X3;
 } zuc_state_t;
 
-void zuc_initialize(zuc_state_t* state, const u8* k, u8* iv);
+void zuc_initialize(zuc_state_t* state, const u8* k, const u8* iv);
 void zuc_generate_keystream(zuc_state_t* state, int key_stream_len, u32* p_keystream);
 
+/* Generates the keystreams of nof_streams independent key/iv pairs. Streams are processed in groups as wide as the
+ * SIMD vector, each one in a lane, so a group costs as much as its longest stream. */
+void zuc_generate_keystream_multi(u32              nof_streams,
+                                  const u8* const* k,
+                                  const u8* const* iv,
+                                  const u32*       key_stream_len,
+                                  u32* const*      p_keystream);
+
 #endif // SRSRAN_ZUC_H
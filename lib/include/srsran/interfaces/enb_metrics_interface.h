@@ -57,6 +57,7 @@ struct stack_metrics_t {
 struct enb_metrics_t {
   srsran::rf_metrics_t       rf;
   std::vector<phy_metrics_t> phy;
+  phy_latency_metrics_t      phy_latency;
   stack_metrics_t            stack;
   stack_metrics_t            nr_stack;
   srsran::sys_metrics_t      sys;
@@ -28,6 +28,11 @@
 
 namespace srsenb {
 
+struct pdcp_args_t {
+  int32_t  nof_security_workers = -1; ///< Threads ciphering the DRB PDUs in batches, -1 to cipher each PDU inline
+  uint32_t nof_up_threads       = 0;  ///< User plane threads, each owning the PDCP entities of a disjoint set of RNTIs
+};
+
 // PDCP interface for GTPU
 class pdcp_interface_gtpu
 {
@@ -80,7 +80,14 @@ public:
 };
 
 class gw_interface_stack : public gw_interface_nas, public gw_interface_rrc, public gw_interface_pdcp
-{};
+{
+public:
+  /**
+   * Called by the stack once per TTI, after the PDUs of the TTI were passed to the GW. The GW writes out the
+   * DL packets it held back to merge them.
+   */
+  virtual void run_tti() = 0;
+};
 
 } // namespace srsue
 
@@ -28,6 +28,7 @@
 #include <array>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace srsue {
 
@@ -318,6 +319,7 @@ public:
   struct cell_search_args_t {
     double                      center_freq_hz;
     double                      ssb_freq_hz;
+    std::vector<double>         other_ssb_freq_hz; ///< Additional SSB center frequencies searched in the same base-band
     srsran_subcarrier_spacing_t ssb_scs;
     srsran_ssb_pattern_t        ssb_pattern;
     srsran_duplex_mode_t        duplex_mode;
@@ -102,6 +102,8 @@ struct phy_args_t {
   bool        pdsch_8bit_decoder           = false;
   uint32_t    intra_freq_meas_len_ms       = 20;
   uint32_t    intra_freq_meas_period_ms    = 200;
+  bool        intra_freq_meas_channelizer  = false;
+  int         intra_freq_meas_cpu          = -1;
   float       force_ul_amplitude           = 0.0f;
   bool        detect_cp                    = false;
 
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_UE_RLC_INTERFACES_H
 #define SRSRAN_UE_RLC_INTERFACES_H
 
+#include "srsran/adt/span.h"
 #include "srsran/common/interfaces_common.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 
@@ -52,6 +53,14 @@ public:
   ///< MAC pulls RLC PDUs according to TB size
   virtual void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu) = 0;
 
+  ///< Pushes several SDUs of the same bearer at once
+  virtual void write_sdu_batch(uint32_t lcid, srsran::span<srsran::unique_byte_buffer_t> sdus)
+  {
+    for (srsran::unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(lcid, std::move(sdu));
+    }
+  }
+
   ///< Indicate RLC that a certain SN can be discarded
   virtual void discard_sdu(uint32_t lcid, uint32_t discard_sn) = 0;
 
@@ -140,6 +140,26 @@ SRSRAN_API void srsran_ofdm_tx_free(srsran_ofdm_t* q);
 
 SRSRAN_API void srsran_ofdm_tx_sf(srsran_ofdm_t* q);
 
+/**
+ * @brief Generates the time domain signal of a range of OFDM symbols of a normal (non-MBSFN) subframe, leaving the rest
+ * of the subframe untouched. It allows modulating the symbols whose resource elements are complete while the rest of
+ * the subframe is still being encoded. Ranges of the same object must be generated in order if CFR is enabled.
+ *
+ * @param q OFDM object
+ * @param first_symbol Index of the first OFDM symbol within the subframe
+ * @param nof_symbols Number of OFDM symbols
+ */
+SRSRAN_API void srsran_ofdm_tx_symbols(srsran_ofdm_t* q, uint32_t first_symbol, uint32_t nof_symbols);
+
+/**
+ * @brief Computes the position of an OFDM symbol, including its cyclic prefix, within a normal subframe
+ *
+ * @param q OFDM object
+ * @param symbol_idx Index of the OFDM symbol within the subframe
+ * @return The sample index in the time domain subframe buffer
+ */
+SRSRAN_API uint32_t srsran_ofdm_get_symbol_offset(const srsran_ofdm_t* q, uint32_t symbol_idx);
+
 SRSRAN_API int srsran_ofdm_set_freq_shift(srsran_ofdm_t* q, float freq_shift);
 
 SRSRAN_API void srsran_ofdm_set_normalize(srsran_ofdm_t* q, bool normalize_enable);
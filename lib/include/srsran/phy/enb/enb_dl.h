@@ -123,6 +123,13 @@ SRSRAN_API int srsran_enb_dl_put_pmch(srsran_enb_dl_t* q, srsran_pmch_cfg_t* pmc
 
 SRSRAN_API void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q);
 
+/**
+ * @brief Generates the signal of a range of OFDM symbols of a normal subframe for a given port, so the symbols can be
+ * modulated as soon as their resource elements are complete. Ranges of a port must be generated in order.
+ */
+SRSRAN_API void
+srsran_enb_dl_gen_signal_symbols(srsran_enb_dl_t* q, uint32_t port, uint32_t first_symbol, uint32_t nof_symbols);
+
 SRSRAN_API bool srsran_enb_dl_gen_cqi_periodic(const srsran_cell_t*   cell,
                                                const srsran_dl_cfg_t* dl_cfg,
                                                uint32_t               tti,
@@ -74,6 +74,13 @@ SRSRAN_API int srsran_gnb_dl_base_zero(srsran_gnb_dl_t* q);
 
 SRSRAN_API void srsran_gnb_dl_gen_signal(srsran_gnb_dl_t* q);
 
+/**
+ * @brief Generates the signal of a range of OFDM symbols of the slot for a given antenna, so the symbols can be
+ * modulated as soon as their resource elements are complete. Ranges of an antenna must be generated in order.
+ */
+SRSRAN_API void
+srsran_gnb_dl_gen_signal_symbols(srsran_gnb_dl_t* q, uint32_t antenna, uint32_t first_symbol, uint32_t nof_symbols);
+
 SRSRAN_API int srsran_gnb_dl_add_ssb(srsran_gnb_dl_t* q, const srsran_pbch_msg_nr_t* pbch_msg, uint32_t sf_idx);
 
 SRSRAN_API int
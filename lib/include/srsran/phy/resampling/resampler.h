@@ -106,6 +106,79 @@ SRSRAN_API void srsran_resampler_fft_run(srsran_resampler_fft_t* q, const cf_t*
  */
 SRSRAN_API void srsran_resampler_fft_free(srsran_resampler_fft_t* q);
 
+/**
+ * @brief Polyphase FIR resampler internal buffers, it resamples by an arbitrary rational ratio interp/decim
+ */
+typedef struct {
+  uint32_t interp;    ///< Interpolation factor
+  uint32_t decim;     ///< Decimation factor
+  uint32_t nof_taps;  ///< Number of coefficients for each polyphase branch
+  uint32_t window_sz; ///< Maximum number of input samples processed at once
+  uint32_t t;         ///< High rate time index of the next output sample relative to the first new input sample
+  uint32_t stream_sz; ///< Number of samples of each decimated input stream
+  cf_t*    buffer;    ///< Filter state followed by the current input window
+  cf_t*    streams;   ///< Input buffer split in decim streams, so consecutive outputs read consecutive samples
+  float*   filter;    ///< Time reversed coefficients of each polyphase branch
+} srsran_resampler_polyphase_t;
+
+/**
+ * @brief Initialise a polyphase FIR resampler which converts the sampling rate by a factor interp/decim. The ratio is
+ * reduced to its lowest terms.
+ * @param q Object pointer
+ * @param interp Interpolation factor
+ * @param decim Decimation factor
+ * @return SRSRAN_SUCCES if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_resampler_polyphase_init(srsran_resampler_polyphase_t* q, uint32_t interp, uint32_t decim);
+
+/**
+ * @brief resets internal re-sampler state
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_resampler_polyphase_reset_state(srsran_resampler_polyphase_t* q);
+
+/**
+ * Get delay from the polyphase resampler.
+ * @param q Object pointer
+ * @return the delay in number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_polyphase_get_delay(srsran_resampler_polyphase_t* q);
+
+/**
+ * @brief Get the largest number of input samples for which the next call to srsran_resampler_polyphase_run() produces
+ * at most nof_output samples. It produces exactly nof_output samples when interp <= decim.
+ * @param q Object pointer
+ * @param nof_output Maximum number of output samples
+ * @return The number of input samples
+ */
+SRSRAN_API uint32_t srsran_resampler_polyphase_get_nof_input(const srsran_resampler_polyphase_t* q,
+                                                             uint32_t                            nof_output);
+
+/**
+ * @brief Run polyphase resampler.
+ *
+ * @note Setting the input to NULL is equivalent of feeding zeroes
+ * @note Setting the output to NULL is equivalent of dropping output samples
+ * @note The number of output samples is nsamples * interp / decim when the product is integer, otherwise the fractional
+ * part is carried to the next call
+ *
+ * @param q Object pointer, make sure it has been initialised
+ * @param input Points at the input complex buffer
+ * @param output Points at the output complex buffer
+ * @param nsamples Number of input samples
+ * @return The number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_polyphase_run(srsran_resampler_polyphase_t* q,
+                                                   const cf_t*                   input,
+                                                   cf_t*                         output,
+                                                   uint32_t                      nsamples);
+
+/**
+ * Free polyphase resampler buffers
+ * @param q  Object pointer
+ */
+SRSRAN_API void srsran_resampler_polyphase_free(srsran_resampler_polyphase_t* q);
+
 #ifdef __cplusplus
 }
 #endif
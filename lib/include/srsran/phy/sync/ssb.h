@@ -48,6 +48,11 @@
  */
 #define SRSRAN_SSB_NOF_CANDIDATES 64
 
+/**
+ * @brief Maximum number of SSB center frequencies that can be searched at once in the same base-band signal
+ */
+#define SRSRAN_SSB_SEARCH_MAX_NOF_FREQ 32
+
 /**
  * @brief Describes SSB object initialization arguments
  */
@@ -99,6 +104,7 @@ typedef struct SRSRAN_API {
   uint32_t corr_window;   ///< Correlation window length
   uint32_t ssb_sz;        ///< SSB size in samples at the configured sampling rate
   int32_t  f_offset;      ///< SSB integer frequency offset (multiple of SCS) between DC and the SSB center
+  int32_t  corr_f_offset; ///< SSB integer frequency offset the correlation sequences were generated for
   uint32_t cp_sz;         ///< CP length for the given symbol size
 
   /// Other parameters
@@ -113,11 +119,13 @@ typedef struct SRSRAN_API {
   srsran_pbch_nr_t  pbch;      ///< PBCH encoder and decoder
 
   /// Frequency/Time domain temporal data
-  cf_t* tmp_freq;                     ///< Temporal frequency domain buffer
-  cf_t* tmp_time;                     ///< Temporal time domain buffer
-  cf_t* tmp_corr;                     ///< Temporal correlation frequency domain buffer
-  cf_t* sf_buffer;                    ///< subframe buffer
-  cf_t* pss_seq[SRSRAN_NOF_NID_2_NR]; ///< Possible frequency domain PSS for find
+  cf_t*  tmp_freq;                     ///< Temporal frequency domain buffer
+  cf_t*  tmp_time;                     ///< Temporal time domain buffer
+  cf_t*  tmp_corr;                     ///< Temporal correlation frequency domain buffer
+  cf_t*  sf_buffer;                    ///< subframe buffer
+  cf_t*  pss_seq[SRSRAN_NOF_NID_2_NR]; ///< Possible frequency domain PSS for find
+  float* pss_pwr[SRSRAN_NOF_NID_2_NR]; ///< Power of each frequency domain PSS, used for normalising the correlation
+  float* tmp_pwr;                      ///< Temporal power of the frequency domain correlation window
 } srsran_ssb_t;
 
 /**
@@ -163,6 +171,30 @@ SRSRAN_API int srsran_ssb_set_cfg(srsran_ssb_t* q, const srsran_ssb_cfg_t* cfg);
  */
 SRSRAN_API int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srsran_ssb_search_res_t* res);
 
+/**
+ * @brief Searches for SSB transmissions in several SSB center frequencies of the same baseband buffer and decodes their
+ * PBCH messages
+ *
+ * @remark The PSS correlation of all the frequencies is done in a single pass: each correlation window is transformed
+ * to frequency domain once and correlated against the PSS sequences shifted to every given frequency
+ * @remark All the given frequencies must fit in the base-band bandwidth given by the current configuration
+ *
+ * @param q SSB object
+ * @param in Input baseband buffer
+ * @param nof_samples Number of samples available in the buffer
+ * @param ssb_freq_hz SSB center frequencies to search, for example, the synchronization raster points (GSCN) within
+ * the base-band bandwidth
+ * @param nof_freq Number of SSB center frequencies, up to SRSRAN_SSB_SEARCH_MAX_NOF_FREQ
+ * @param res SSB Search result for each of the given frequencies
+ * @return SRSRAN_SUCCESS if the parameters are valid, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ssb_search_multi(srsran_ssb_t*            q,
+                                       const cf_t*              in,
+                                       uint32_t                 nof_samples,
+                                       const double*            ssb_freq_hz,
+                                       uint32_t                 nof_freq,
+                                       srsran_ssb_search_res_t* res);
+
 /**
  * @brief Decides if the SSB object is configured and a given subframe is configured for SSB transmission
  * @param q SSB object
@@ -1297,6 +1297,103 @@ static inline simd_i_t srsran_simd_i_and(simd_i_t a, simd_i_t b)
 #endif /* LV_HAVE_AVX512 */
 }
 
+static inline simd_i_t srsran_simd_i_or(simd_i_t a, simd_i_t b)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_or_si512(a, b);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_or_si256(a, b);
+#else
+#ifdef LV_HAVE_SSE
+  return _mm_or_si128(a, b);
+#else
+#ifdef HAVE_NEON
+  return vorrq_s32(a, b);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+static inline simd_i_t srsran_simd_i_xor(simd_i_t a, simd_i_t b)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_xor_si512(a, b);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_xor_si256(a, b);
+#else
+#ifdef LV_HAVE_SSE
+  return _mm_xor_si128(a, b);
+#else
+#ifdef HAVE_NEON
+  return veorq_s32(a, b);
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+/* Logical shifts of every 32-bit element */
+static inline simd_i_t srsran_simd_i_sll(simd_i_t a, int n)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_maskz_slli_epi32(0xFFFF, a, n);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_slli_epi32(a, n);
+#else
+#ifdef LV_HAVE_SSE
+  return _mm_slli_epi32(a, n);
+#else
+#ifdef HAVE_NEON
+  return vreinterpretq_s32_u32(vshlq_u32(vreinterpretq_u32_s32(a), vdupq_n_s32(n)));
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+static inline simd_i_t srsran_simd_i_srl(simd_i_t a, int n)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_maskz_srli_epi32(0xFFFF, a, n);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_srli_epi32(a, n);
+#else
+#ifdef LV_HAVE_SSE
+  return _mm_srli_epi32(a, n);
+#else
+#ifdef HAVE_NEON
+  return vreinterpretq_s32_u32(vshlq_u32(vreinterpretq_u32_s32(a), vdupq_n_s32(-n)));
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
+/* Table lookup of every 32-bit element, x[i] = table[idx[i]] */
+static inline simd_i_t srsran_simd_i_gather(const int* table, simd_i_t idx)
+{
+#ifdef LV_HAVE_AVX512
+  return _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), 0xFFFF, idx, table, 4);
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  return _mm256_i32gather_epi32(table, idx, 4);
+#else
+  int idx_[SRSRAN_SIMD_I_SIZE] __attribute__((aligned(16)));
+  int res_[SRSRAN_SIMD_I_SIZE] __attribute__((aligned(16)));
+  srsran_simd_i_store(idx_, idx);
+  for (int i = 0; i < SRSRAN_SIMD_I_SIZE; i++) {
+    res_[i] = table[idx_[i]];
+  }
+  return srsran_simd_i_load(res_);
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
 static inline simd_sel_t srsran_simd_f_max(simd_f_t a, simd_f_t b)
 {
 #ifdef LV_HAVE_AVX512
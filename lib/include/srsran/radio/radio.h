@@ -31,6 +31,7 @@
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
 
+#include <chrono>
 #include <list>
 #include <string>
 
@@ -108,9 +109,20 @@ private:
   std::mutex                                              rx_mutex;
   std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      tx_buffer;
   std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      rx_buffer;
-  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> interpolators = {};
-  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> decimators    = {};
-  std::atomic<bool> decimator_busy = {false}; ///< Indicates the decimator is changing the rate
+  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS>       interpolators    = {};
+  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS>       decimators       = {};
+  std::array<srsran_resampler_polyphase_t, SRSRAN_MAX_CHANNELS> pp_interpolators = {};
+  std::array<srsran_resampler_polyphase_t, SRSRAN_MAX_CHANNELS> pp_decimators    = {};
+  std::array<bool, SRSRAN_MAX_CHANNELS> use_polyphase  = {};      ///< Selects the polyphase resampler for each channel
+  bool                                  all_polyphase  = false;   ///< All channels use the polyphase resampler
+  std::atomic<bool>                     decimator_busy = {false}; ///< Indicates the decimator is changing the rate
+  uint32_t                              rx_interp      = 1;       ///< Receive resampling interpolation factor
+  uint32_t                              rx_decim       = 1;       ///< Receive resampling decimation factor
+  uint32_t                              tx_interp      = 1;       ///< Transmit resampling interpolation factor
+  uint32_t                              tx_decim       = 1;       ///< Transmit resampling decimation factor
+
+  std::atomic<uint64_t>                 rx_nof_samples = {0}; ///< Received samples since the last metrics report
+  std::chrono::steady_clock::time_point metrics_tp     = {};  ///< Time of the last metrics report
 
   rf_timestamp_t    end_of_burst_time = {};
   std::atomic<bool> is_start_of_burst{false};
@@ -29,6 +29,7 @@ typedef struct {
   uint32_t rf_u;
   uint32_t rf_l;
   bool     rf_error;
+  float    tti_rate; ///< Achieved subframes per second, above 1000 when the radio runs in virtual time
 } rf_metrics_t;
 
 } // namespace srsran
@@ -31,6 +31,10 @@ void  reserve_rlc_memblocks(size_t nof_blocks);
 void* allocate_rlc_bearer(std::size_t size);
 void  deallocate_rlc_bearer(void* p);
 
+// Allocation of RLC window pages, shared by all bearers. Sizes above the pool node size fall back to the heap
+void* allocate_rlc_window_page(std::size_t size);
+void  deallocate_rlc_window_page(void* p, std::size_t size);
+
 } // namespace srsran
 
 #endif // SRSRAN_BEARER_MEM_POOL_H
@@ -22,6 +22,7 @@
 #ifndef SRSRAN_RLC_H
 #define SRSRAN_RLC_H
 
+#include "srsran/adt/qsbr.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/task_scheduler.h"
@@ -30,14 +31,25 @@
 #include "srsran/interfaces/ue_rrc_interfaces.h"
 #include "srsran/rlc/rlc_common.h"
 #include "srsran/rlc/rlc_metrics.h"
+#include <mutex>
 
 namespace srsran {
 
+/// Reclamation domain of the bearer tables of all the RLC instances of the process
+qsbr_domain& rlc_qsbr_domain();
+
+/// Read-side critical section on the RLC bearer tables. Entities removed from a table are deleted once no thread is
+/// inside one of these guards anymore
+using rlc_read_guard = qsbr_read_guard<rlc_qsbr_domain>;
+
 /****************************************************************************
  * RLC Layer
  * Ref: 3GPP TS 36.322 v10.0.0
  * Single interface for RLC layer - contains separate RLC entities for
  * each bearer.
+ * The entities are kept in arrays indexed by LCID. Bearers are added and
+ * removed under a mutex, while the lookups from the MAC, PDCP and stack
+ * threads only load the entity pointer inside an rlc_read_guard.
  ***************************************************************************/
 class rlc : public srsue::rlc_interface_mac, public srsue::rlc_interface_pdcp, public srsue::rlc_interface_rrc
 {
@@ -60,6 +72,7 @@ public:
 
   // PDCP interface
   void write_sdu(uint32_t lcid, unique_byte_buffer_t sdu);
+  void write_sdu_batch(uint32_t lcid, srsran::span<unique_byte_buffer_t> sdus);
   void write_sdu_mch(uint32_t lcid, unique_byte_buffer_t sdu);
   bool rb_is_um(uint32_t lcid);
   void discard_sdu(uint32_t lcid, uint32_t discard_sn);
@@ -105,10 +118,13 @@ private:
   srsue::rrc_interface_rlc*  rrc    = nullptr;
   srsran::timer_handler*     timers = nullptr;
 
-  typedef std::map<uint16_t, std::unique_ptr<rlc_common> >  rlc_map_t;
+  template <size_t N>
+  using rlc_table_t = std::array<std::atomic<rlc_common*>, N>;
 
-  rlc_map_t        rlc_array, rlc_array_mrb;
-  pthread_rwlock_t rwlock;
+  rlc_table_t<SRSRAN_N_RADIO_BEARERS> rlc_array;
+  rlc_table_t<SRSRAN_N_MCH_LCIDS>     rlc_array_mrb;
+  qsbr_retire_list<rlc_common>        retired_entities{rlc_qsbr_domain()};
+  std::mutex                          cfg_mutex; ///< Serializes the changes to the bearer tables
 
   uint32_t default_lcid = 0;
 
@@ -120,6 +136,12 @@ private:
   bool valid_lcid(uint32_t lcid);
   bool valid_lcid_mrb(uint32_t lcid);
 
+  /// Entity of the bearer, or nullptr if it doesn't exist. Must be called inside an rlc_read_guard
+  rlc_common* get_entity(uint32_t lcid);
+  rlc_common* get_entity_mrb(uint32_t lcid);
+
+  void remove_entity(std::atomic<rlc_common*>& slot);
+
   void update_bsr(uint32_t lcid);
   void update_bsr_mch(uint32_t lcid);
 };
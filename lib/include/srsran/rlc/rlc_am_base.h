@@ -84,6 +84,7 @@ public:
    * PDCP interface
    ***************************************************************************/
   void write_sdu(unique_byte_buffer_t sdu) final;
+  void write_sdu_batch(srsran::span<unique_byte_buffer_t> sdus) final;
 
   void discard_sdu(uint32_t discard_sn) final;
 
@@ -149,19 +150,20 @@ public:
     void set_bsr_callback(bsr_callback_t callback);
 
     int              write_sdu(unique_byte_buffer_t sdu);
+    uint32_t         write_sdu_batch(srsran::span<unique_byte_buffer_t> sdus);
     bool             sdu_queue_is_full();
     virtual void     discard_sdu(uint32_t pdcp_sn);
     virtual uint32_t read_pdu(uint8_t* payload, uint32_t nof_bytes) = 0;
 
-    bool                  tx_enabled = false;
+    std::atomic<bool>     tx_enabled = {false}; // read without the mutex when SDUs are written
     byte_buffer_pool*     pool       = nullptr;
     srslog::basic_logger& logger;
     std::string           rb_name;
 
     bsr_callback_t bsr_callback;
 
-    // Tx SDU buffers
-    byte_buffer_queue tx_sdu_queue;
+    // Tx SDU buffers. Written by PDCP without the mutex, read by the entity with the mutex held
+    byte_buffer_spsc_queue tx_sdu_queue;
 
     // Mutexes
     std::mutex mutex;
@@ -22,11 +22,17 @@
 #ifndef SRSRAN_RLC_AM_DATA_STRUCTS_H
 #define SRSRAN_RLC_AM_DATA_STRUCTS_H
 
+#include "srsran/adt/bounded_bitset.h"
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/adt/circular_map.h"
+#include "srsran/adt/detail/type_storage.h"
+#include "srsran/adt/flat_hash_map.h"
 #include "srsran/adt/intrusive_list.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/rlc/bearer_mem_pool.h"
+#include <algorithm>
 #include <array>
+#include <bitset>
 #include <list>
 #include <vector>
 
@@ -241,20 +247,184 @@ struct rlc_ringbuffer_t : public rlc_ringbuffer_base<T> {
 
   bool has_sn(uint32_t sn) const override { return window.contains(sn); }
 
-  // Return the sum data bytes of all active PDUs (check PDU is non-null)
-  uint32_t get_buffered_bytes()
+private:
+  srsran::static_circular_map<uint32_t, T, WINDOW_SIZE> window;
+};
+
+/// Number of consecutive SNs stored in one page of a rlc_paged_ringbuffer_t
+const static size_t RLC_WINDOW_PAGE_SIZE = 128;
+
+/// Block of PAGE_SIZE consecutive window slots. Slots are constructed only while their SN is in the window
+template <class T, std::size_t PAGE_SIZE>
+struct rlc_window_page {
+  std::bitset<PAGE_SIZE>                         present;
+  uint32_t                                       count = 0;
+  std::array<uint32_t, PAGE_SIZE>                sns;
+  std::array<detail::type_storage<T>, PAGE_SIZE> slots;
+};
+
+/**
+ * RLC window with the same SN to slot mapping as rlc_ringbuffer_t, but whose slots are allocated in pages from a pool
+ * shared by all bearers, and only for the SN ranges that are in use. An idle bearer with 18 bit SNs costs the page
+ * directory instead of 2^17 PDU slots. Lookups remain O(1): page directory, presence bitmap, slot.
+ */
+template <class T, std::size_t WINDOW_SIZE, std::size_t PAGE_SIZE = RLC_WINDOW_PAGE_SIZE>
+struct rlc_paged_ringbuffer_t : public rlc_ringbuffer_base<T> {
+  static_assert(WINDOW_SIZE % PAGE_SIZE == 0, "The window size must be a multiple of the page size");
+  using page_t = rlc_window_page<T, PAGE_SIZE>;
+
+  rlc_paged_ringbuffer_t() { pages.fill(nullptr); }
+  rlc_paged_ringbuffer_t(const rlc_paged_ringbuffer_t&) = delete;
+  rlc_paged_ringbuffer_t& operator=(const rlc_paged_ringbuffer_t&) = delete;
+  ~rlc_paged_ringbuffer_t() override { clear(); }
+
+  T& add_pdu(size_t sn) override
   {
-    uint32_t buff_size = 0;
-    for (const auto& pdu : window) {
-      if (pdu.second.buf != nullptr) {
-        buff_size += pdu.second.buf->N_bytes;
+    srsran_expect(not has_sn(sn), "The same SN=%zd should not be added twice", sn);
+    size_t   idx  = sn % WINDOW_SIZE;
+    page_t*& page = pages[idx / PAGE_SIZE];
+    if (page == nullptr) {
+      page = new (allocate_rlc_window_page(sizeof(page_t))) page_t;
+    }
+    size_t slot = idx % PAGE_SIZE;
+    if (page->present.test(slot)) {
+      // overwrite older SN that maps to the same slot
+      page->slots[slot].destroy();
+    } else {
+      page->present.set(slot);
+      page->count++;
+      count++;
+    }
+    page->sns[slot] = sn;
+    page->slots[slot].emplace(sn);
+    return page->slots[slot].get();
+  }
+  void remove_pdu(size_t sn) override
+  {
+    srsran_expect(has_sn(sn), "The removed SN=%zd is not in the window", sn);
+    if (not has_sn(sn)) {
+      return;
+    }
+    size_t  idx  = sn % WINDOW_SIZE;
+    page_t* page = pages[idx / PAGE_SIZE];
+    size_t  slot = idx % PAGE_SIZE;
+    page->slots[slot].destroy();
+    page->present.reset(slot);
+    page->count--;
+    count--;
+    if (page->count == 0) {
+      free_page(idx / PAGE_SIZE);
+    }
+  }
+  T& operator[](size_t sn) override
+  {
+    srsran_assert(has_sn(sn), "Accessing SN=%zd, which is not in the window", sn);
+    size_t idx = sn % WINDOW_SIZE;
+    return pages[idx / PAGE_SIZE]->slots[idx % PAGE_SIZE].get();
+  }
+  size_t size() const override { return count; }
+  bool   full() const override { return count == WINDOW_SIZE; }
+  bool   empty() const override { return count == 0; }
+  void   clear() override
+  {
+    for (size_t i = 0; i < pages.size(); ++i) {
+      if (pages[i] != nullptr) {
+        for (size_t slot = 0; slot < PAGE_SIZE; ++slot) {
+          if (pages[i]->present.test(slot)) {
+            pages[i]->slots[slot].destroy();
+          }
+        }
+        free_page(i);
       }
     }
-    return buff_size;
+    count = 0;
+  }
+
+  bool has_sn(uint32_t sn) const override
+  {
+    size_t        idx  = sn % WINDOW_SIZE;
+    const page_t* page = pages[idx / PAGE_SIZE];
+    return page != nullptr and page->present.test(idx % PAGE_SIZE) and page->sns[idx % PAGE_SIZE] == sn;
+  }
+
+  /// Number of pages currently allocated to this window
+  size_t nof_pages() const
+  {
+    return std::count_if(pages.begin(), pages.end(), [](const page_t* p) { return p != nullptr; });
   }
 
 private:
-  srsran::static_circular_map<uint32_t, T, WINDOW_SIZE> window;
+  void free_page(size_t page_idx)
+  {
+    pages[page_idx]->~page_t();
+    deallocate_rlc_window_page(pages[page_idx], sizeof(page_t));
+    pages[page_idx] = nullptr;
+  }
+
+  std::array<page_t*, WINDOW_SIZE / PAGE_SIZE> pages;
+  size_t                                       count = 0;
+};
+
+/**
+ * One bit per slot of an RLC window, with the same SN to slot mapping as rlc_ringbuffer_t. Searches for the next set or
+ * cleared bit test 64 SNs at a time, so that a status report can be built in time proportional to the number of NACK
+ * ranges rather than to the number of SNs between its edges.
+ */
+class rlc_sn_bitmap
+{
+public:
+  rlc_sn_bitmap() = default;
+  explicit rlc_sn_bitmap(uint32_t window_size) { resize(window_size); }
+
+  void resize(uint32_t window_size)
+  {
+    srsran_assert(window_size % bits_per_word == 0, "Window size %d is not a multiple of %d", window_size, bits_per_word);
+    words.assign(window_size / bits_per_word, 0);
+  }
+  uint32_t size() const { return words.size() * bits_per_word; }
+
+  void set(uint32_t sn, bool value = true)
+  {
+    uint32_t idx = sn % size();
+    if (value) {
+      words[idx / bits_per_word] |= (word_t)1u << (idx % bits_per_word);
+    } else {
+      words[idx / bits_per_word] &= ~((word_t)1u << (idx % bits_per_word));
+    }
+  }
+  void reset(uint32_t sn) { set(sn, false); }
+  bool test(uint32_t sn) const
+  {
+    uint32_t idx = sn % size();
+    return ((words[idx / bits_per_word] >> (idx % bits_per_word)) & 1u) != 0;
+  }
+  void clear() { std::fill(words.begin(), words.end(), 0); }
+
+  /**
+   * Searches the len SNs starting at sn, wrapping around the window if needed
+   * @return offset from sn of the first SN whose bit equals value, or len if there is none
+   */
+  uint32_t find_next(uint32_t sn, uint32_t len, bool value) const
+  {
+    uint32_t idx = sn % size();
+    for (uint32_t offset = 0; offset < len;) {
+      uint32_t bit  = idx % bits_per_word;
+      word_t   word = (value ? words[idx / bits_per_word] : ~words[idx / bits_per_word]) >> bit;
+      if (word != 0) {
+        return std::min(offset + (uint32_t)find_first_lsb_one(word), len);
+      }
+      offset += bits_per_word - bit;
+      idx = (idx + bits_per_word - bit) % size();
+    }
+    return len;
+  }
+
+private:
+  using word_t = uint64_t;
+
+  static constexpr uint32_t bits_per_word = 64;
+
+  std::vector<word_t> words;
 };
 
 template <typename HeaderType>
@@ -463,18 +633,23 @@ template <class T>
 class pdu_retx_queue_list
 {
   std::list<T> queue;
+  // Number of queued elements of each SN, so that SN lookups only walk the queue when the SN is in it
+  flat_hash_map<uint32_t, uint32_t> sn_count;
 
 public:
   ~pdu_retx_queue_list() = default;
-  T& push()
+  T& push(uint32_t sn)
   {
     queue.emplace_back();
+    queue.back().sn = sn;
+    sn_count[sn]++;
     return queue.back();
   }
 
   void pop()
   {
     if (not queue.empty()) {
+      dec_sn_count(queue.front().sn);
       queue.pop_front();
     }
   }
@@ -487,29 +662,22 @@ public:
 
   const std::list<T>& get_inner_queue() const { return queue; }
 
-  void   clear() { queue.clear(); }
+  void clear()
+  {
+    queue.clear();
+    sn_count.clear();
+  }
   size_t size() const { return queue.size(); }
   bool   empty() const { return queue.empty(); }
 
-  bool has_sn(uint32_t sn) const
-  {
-    if (queue.empty()) {
-      return false;
-    }
-    for (auto elem : queue) {
-      if (elem.sn == sn) {
-        return true;
-      }
-    }
-    return false;
-  };
+  bool has_sn(uint32_t sn) const { return sn_count.count(sn) > 0; }
 
   bool has_sn(uint32_t sn, uint32_t so) const
   {
-    if (queue.empty()) {
+    if (not has_sn(sn)) {
       return false;
     }
-    for (auto elem : queue) {
+    for (const T& elem : queue) {
       if (elem.sn == sn) {
         if (elem.overlaps(so)) {
           return true;
@@ -520,25 +688,41 @@ public:
   };
 
   /**
-   * @brief remove_sn removes SN from queue and returns after first match
+   * @brief remove_sn removes all entries of SN from queue
    * @param sn sequence number to be removed from queue
-   * @return true if one element was removed, false if no element to remove was found
+   * @param on_remove callback invoked with every element before it is removed
+   * @return true if at least one element was removed, false if no element to remove was found
    */
-  bool remove_sn(uint32_t sn)
+  template <typename RemoveCallback>
+  bool remove_sn(uint32_t sn, RemoveCallback on_remove)
   {
-    if (queue.empty()) {
+    auto count_it = sn_count.find(sn);
+    if (count_it == sn_count.end()) {
       return false;
     }
+    uint32_t nof_left = count_it->second;
+    sn_count.erase(count_it);
     auto iter = queue.begin();
-    while (iter != queue.end()) {
+    while (iter != queue.end() and nof_left > 0) {
       if (iter->sn == sn) {
+        on_remove(*iter);
         iter = queue.erase(iter);
-        return true;
+        nof_left--;
       } else {
         ++iter;
       }
     }
-    return false;
+    return true;
+  }
+  bool remove_sn(uint32_t sn) { return remove_sn(sn, [](const T&) {}); }
+
+private:
+  void dec_sn_count(uint32_t sn)
+  {
+    auto count_it = sn_count.find(sn);
+    if (count_it != sn_count.end() and --count_it->second == 0) {
+      sn_count.erase(count_it);
+    }
   }
 };
 
@@ -92,6 +92,7 @@ private:
   void update_notification_ack_info(uint32_t rlc_sn);
 
   int  required_buffer_size(const rlc_amd_retx_lte_t& retx);
+  int  required_buffer_size_cached(const rlc_amd_retx_lte_t& retx);
   void retransmit_pdu(uint32_t sn);
 
   // Helpers
@@ -149,6 +150,15 @@ private:
   pdu_retx_queue<rlc_amd_retx_lte_t, RLC_AM_WINDOW_SIZE>                     retx_queue;
   pdcp_sn_vector_t                                                           notify_info_vec;
 
+  // Size of the RETX at the head of retx_queue, reused by buffer state queries until the head changes
+  struct retx_size_cache_t {
+    uint32_t sn         = rlc_amd_retx_base_t::invalid_rlc_sn;
+    bool     is_segment = false;
+    uint32_t so_start   = 0;
+    uint32_t so_end     = 0;
+    int      nof_bytes  = 0;
+  } retx_size_cache;
+
   // Mutexes
   std::mutex mutex;
 
@@ -222,7 +232,13 @@ private:
 
   // Rx windows
   rlc_ringbuffer_t<rlc_amd_rx_pdu, RLC_AM_WINDOW_SIZE> rx_window;
+  rlc_sn_bitmap                                        rx_window_present{RLC_AM_WINDOW_SIZE}; // SNs held in rx_window
   std::map<uint32_t, rlc_amd_rx_pdu_segments_t>        rx_segments;
+  uint32_t                                             rx_window_bytes = 0; // Sum of PDU bytes in rx_window
+
+  // Length of the status PDU as of the last query. Invalidated whenever the RX state changes
+  int  status_pdu_len       = 0;
+  bool status_pdu_len_valid = false;
 
   bool              poll_received = false;
   std::atomic<bool> do_status     = {false}; // light-weight access from Tx entity
@@ -104,7 +104,7 @@ public:
   bool     configure(const rlc_config_t& cfg_) final;
   uint32_t read_pdu(uint8_t* payload, uint32_t nof_bytes) final;
   void     handle_control_pdu(uint8_t* payload, uint32_t nof_bytes) final;
-  void     handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>& retx_sn_set);
+  void     handle_nack(const rlc_status_nack_t& nack, std::vector<uint32_t>& retx_sns);
 
   void reestablish() final;
   void stop() final;
@@ -122,6 +122,7 @@ public:
   uint32_t build_retx_pdu_with_segmentation(rlc_amd_retx_nr_t& retx, uint8_t* payload, uint32_t nof_bytes);
   bool     is_retx_segmentation_required(const rlc_amd_retx_nr_t& retx, uint32_t nof_bytes);
   uint32_t get_retx_expected_hdr_len(const rlc_amd_retx_nr_t& retx);
+  uint32_t get_retx_pending_bytes(const rlc_amd_retx_nr_t& retx);
 
   // Buffer State
   bool     has_data() final;
@@ -165,8 +166,10 @@ private:
 
   // Queues, buffers and container
   pdu_retx_queue_list<rlc_amd_retx_nr_t> retx_queue;
-  uint32_t         sdu_under_segmentation_sn = INVALID_RLC_SN; // SN of the SDU currently being segmented.
-  pdcp_sn_vector_t notify_info_vec;
+  uint32_t              retx_queue_bytes          = 0; // Bytes of all RETXs in retx_queue, headers included.
+  uint32_t              sdu_under_segmentation_sn = INVALID_RLC_SN; // SN of the SDU currently being segmented.
+  pdcp_sn_vector_t      notify_info_vec;
+  std::vector<uint32_t> retx_sns; // SNs of the SDUs scheduled for RETX while handling a status PDU
 
   // Helper constants
   uint32_t min_hdr_size = 2; // Pre-initialized for 12 bit SN, updated by configure()
@@ -282,9 +285,23 @@ private:
   // RX Window
   std::unique_ptr<rlc_ringbuffer_base<rlc_amd_rx_sdu_nr_t> > rx_window;
 
+  // SNs of the RX window that have an entry, and those whose SDU has been fully received. They are kept in step with
+  // rx_window by the helpers below, and let the status report and the state variable updates skip runs of SNs
+  rlc_sn_bitmap rx_window_present;
+  rlc_sn_bitmap rx_window_complete;
+
+  rlc_amd_rx_sdu_nr_t& rx_window_add(uint32_t sn);
+  void                 rx_window_remove(uint32_t sn);
+  void                 rx_window_clear();
+  uint32_t             first_incomplete_sn(uint32_t sn, uint32_t end_sn) const;
+
   // Mutexes
   std::mutex mutex;
 
+  // Length of the status PDU as of the last time it was built. Invalidated whenever the RX state changes
+  uint32_t status_pdu_len       = 0;
+  bool     status_pdu_len_valid = false;
+
   /****************************************************************************
    * Rx timers
    * Ref: 3GPP TS 38.322 version 16.2.0 Section 7.3
@@ -93,6 +93,9 @@ constexpr uint32_t rlc_am_nr_status_pdu_sizeof_nack_sn_ext_18bit_sn = 3; ///< NA
 constexpr uint32_t rlc_am_nr_status_pdu_sizeof_nack_so              = 4; ///< NACK segment offsets (start and end)
 constexpr uint32_t rlc_am_nr_status_pdu_sizeof_nack_range           = 1; ///< NACK range (nof consecutively lost SDUs)
 
+/// Largest number of SDUs covered by a NACK, as the NACK range field is 8 bits wide
+constexpr uint32_t rlc_am_nr_status_pdu_max_nack_range = 255;
+
 /// AM NR Status PDU header
 class rlc_am_nr_status_pdu_t
 {
@@ -25,6 +25,7 @@
 #include "srsran/adt/circular_buffer.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/intrusive_list.h"
+#include "srsran/adt/span.h"
 #include "srsran/interfaces/rlc_interface_types.h"
 #include "srsran/rlc/bearer_mem_pool.h"
 #include "srsran/rlc/rlc_metrics.h"
@@ -279,6 +280,17 @@ public:
     }
   }
 
+  void write_sdu_batch_s(srsran::span<unique_byte_buffer_t> sdus)
+  {
+    if (suspended) {
+      for (unique_byte_buffer_t& sdu : sdus) {
+        queue_tx_sdu(std::move(sdu));
+      }
+    } else {
+      write_sdu_batch(sdus);
+    }
+  }
+
   virtual rlc_mode_t get_mode() = 0;
   virtual uint32_t   get_lcid() = 0;
 
@@ -290,6 +302,14 @@ public:
   virtual void discard_sdu(uint32_t discard_sn)    = 0;
   virtual bool sdu_queue_is_full()                 = 0;
 
+  /// Writes several SDUs of the bearer at once. SDUs that don't fit in the queue are dropped
+  virtual void write_sdu_batch(srsran::span<unique_byte_buffer_t> sdus)
+  {
+    for (unique_byte_buffer_t& sdu : sdus) {
+      write_sdu(std::move(sdu));
+    }
+  }
+
   // MAC interface
   virtual bool     has_data() = 0;
   bool             is_suspended() { return suspended; };
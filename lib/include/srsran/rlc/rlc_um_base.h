@@ -28,6 +28,7 @@
 #include "srsran/common/task_scheduler.h"
 #include "srsran/rlc/rlc_common.h"
 #include "srsran/upper/byte_buffer_queue.h"
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <pthread.h>
@@ -110,9 +111,9 @@ protected:
 
     rlc_config_t cfg = {};
 
-    // TX SDU buffers
-    byte_buffer_queue    tx_sdu_queue;
-    unique_byte_buffer_t tx_sdu;
+    // TX SDU buffers. Written by PDCP without the mutex, read by the entity with the mutex held
+    byte_buffer_spsc_queue tx_sdu_queue;
+    unique_byte_buffer_t   tx_sdu;
 
     // Mutexes
     std::mutex mutex;
@@ -175,8 +176,8 @@ protected:
   std::unique_ptr<rlc_um_base_tx> tx;
   std::unique_ptr<rlc_um_base_rx> rx;
 
-  bool tx_enabled = false;
-  bool rx_enabled = false;
+  std::atomic<bool> tx_enabled = {false}; // read without a mutex when SDUs are written
+  bool              rx_enabled = false;
 
   std::mutex           metrics_mutex;
   rlc_bearer_metrics_t metrics = {};
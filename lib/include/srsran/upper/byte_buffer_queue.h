@@ -31,11 +31,15 @@
 #define SRSRAN_BYTE_BUFFERQUEUE_H
 
 #include "srsran/adt/circular_buffer.h"
+#include "srsran/adt/span.h"
 #include "srsran/common/block_queue.h"
 #include "srsran/common/byte_buffer.h"
 #include "srsran/common/common.h"
+#include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <pthread.h>
+#include <vector>
 
 namespace srsran {
 
@@ -125,6 +129,167 @@ public:
   dyn_blocking_queue<unique_byte_buffer_t, push_callback, pop_callback> queue;
 };
 
+/**
+ * Bounded lock-free queue of byte buffers for one producer and one consumer thread, used for the RLC TX SDUs.
+ * The producer (PDCP) calls the write functions. All the other functions that touch queued SDUs, i.e. the reads and
+ * discard_first(), are for the consumer and must be serialized by the owner, as the RLC entity does with its mutex.
+ * The SDU and byte counters can be read from any thread.
+ */
+class byte_buffer_spsc_queue
+{
+public:
+  explicit byte_buffer_spsc_queue(uint32_t capacity = 128) : buffer(capacity) {}
+  byte_buffer_spsc_queue(const byte_buffer_spsc_queue&) = delete;
+  byte_buffer_spsc_queue& operator=(const byte_buffer_spsc_queue&) = delete;
+
+  /// Pushes a SDU, blocking while the queue is full until the consumer reads a SDU
+  void write(unique_byte_buffer_t msg)
+  {
+    if (is_full()) {
+      std::unique_lock<std::mutex> lock(writer_mutex);
+      writer_waiting.store(true, std::memory_order_relaxed);
+      // Pairs with the fence in try_read(), so that either the consumer sees the flag or this thread sees the new rpos
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      while (is_full()) {
+        writer_cvar.wait(lock);
+      }
+      writer_waiting.store(false, std::memory_order_relaxed);
+    }
+    try_write(std::move(msg));
+  }
+
+  /// Pushes a SDU. If the queue is full, the SDU is given back in the error
+  srsran::error_type<unique_byte_buffer_t> try_write(unique_byte_buffer_t&& msg)
+  {
+    size_t w = wpos.load(std::memory_order_relaxed);
+    if (w - rpos.load(std::memory_order_acquire) >= buffer.size()) {
+      return std::move(msg);
+    }
+    // Counters are incremented before the SDU is visible, so that the consumer never decrements them below zero
+    add_counters(msg);
+    buffer[w % buffer.size()] = std::move(msg);
+    wpos.store(w + 1, std::memory_order_release);
+    return {};
+  }
+
+  /// Pushes as many SDUs of msgs as fit, in order, and makes them visible to the consumer at once.
+  /// Returns the number of SDUs written. The SDUs that did not fit are left in msgs
+  uint32_t write_batch(srsran::span<unique_byte_buffer_t> msgs)
+  {
+    size_t w     = wpos.load(std::memory_order_relaxed);
+    size_t space = buffer.size() - (w - rpos.load(std::memory_order_acquire));
+    size_t n     = std::min(space, msgs.size());
+    for (size_t i = 0; i < n; ++i) {
+      add_counters(msgs[i]);
+      buffer[(w + i) % buffer.size()] = std::move(msgs[i]);
+    }
+    wpos.store(w + n, std::memory_order_release);
+    return n;
+  }
+
+  /// Pops the SDU at the front of the queue. Returns false if the queue is empty
+  bool try_read(unique_byte_buffer_t* msg)
+  {
+    size_t r = rpos.load(std::memory_order_relaxed);
+    if (r == wpos.load(std::memory_order_acquire)) {
+      return false;
+    }
+    *msg = std::move(buffer[r % buffer.size()]);
+    sub_counters(*msg);
+    rpos.store(r + 1, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writer_waiting.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(writer_mutex);
+      writer_cvar.notify_one();
+    }
+    return true;
+  }
+
+  /// Pops the SDU at the front of the queue, or returns nullptr if the queue is empty. Does not block
+  unique_byte_buffer_t read()
+  {
+    unique_byte_buffer_t msg;
+    try_read(&msg);
+    return msg;
+  }
+
+  /// Discards the first queued SDU for which match() returns true. Its slot stays in the queue holding a nullptr
+  template <typename F>
+  bool discard_first(const F& match)
+  {
+    size_t w = wpos.load(std::memory_order_acquire);
+    for (size_t r = rpos.load(std::memory_order_relaxed); r != w; ++r) {
+      unique_byte_buffer_t& sdu = buffer[r % buffer.size()];
+      if (sdu != nullptr and match(sdu)) {
+        sub_counters(sdu);
+        sdu.reset();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// Changes the capacity, keeping the queued SDUs that fit. Must not run concurrently with any other function
+  void resize(uint32_t capacity)
+  {
+    if (capacity == buffer.size()) {
+      return;
+    }
+    std::vector<unique_byte_buffer_t> new_buffer(capacity);
+    size_t                            n = 0;
+    unique_byte_buffer_t              msg;
+    while (n < capacity and try_read(&msg)) {
+      add_counters(msg);
+      new_buffer[n++] = std::move(msg);
+    }
+    while (try_read(&msg)) {
+    }
+    buffer = std::move(new_buffer);
+    rpos.store(0, std::memory_order_relaxed);
+    wpos.store(n, std::memory_order_relaxed);
+  }
+
+  uint32_t size() const
+  {
+    return (uint32_t)(wpos.load(std::memory_order_acquire) - rpos.load(std::memory_order_acquire));
+  }
+  uint32_t capacity() const { return buffer.size(); }
+  uint32_t get_n_sdus() const { return n_sdus.load(std::memory_order_relaxed); }
+  uint32_t size_bytes() const { return unread_bytes.load(std::memory_order_relaxed); }
+  bool     is_empty() const { return size() == 0; }
+  bool     is_full() const { return size() >= buffer.size(); }
+
+private:
+  void add_counters(const unique_byte_buffer_t& msg)
+  {
+    if (msg != nullptr) {
+      unread_bytes.fetch_add(msg->N_bytes, std::memory_order_relaxed);
+      n_sdus.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  void sub_counters(const unique_byte_buffer_t& msg)
+  {
+    if (msg != nullptr) {
+      unread_bytes.fetch_sub(msg->N_bytes, std::memory_order_relaxed);
+      n_sdus.fetch_sub(1, std::memory_order_relaxed);
+    }
+  }
+
+  std::vector<unique_byte_buffer_t> buffer;
+
+  // Positions grow monotonically, the slot is the position modulo the capacity. wpos is only written by the producer
+  // and rpos by the consumer
+  std::atomic<size_t>   wpos         = {0};
+  std::atomic<size_t>   rpos         = {0};
+  std::atomic<uint32_t> unread_bytes = {0};
+  std::atomic<uint32_t> n_sdus       = {0};
+
+  // Only used when the producer blocks in write() on a full queue
+  std::atomic<bool>       writer_waiting = {false};
+  std::mutex              writer_mutex;
+  std::condition_variable writer_cvar;
+};
+
 } // namespace srsran
 
 #endif // SRSRAN_BYTE_BUFFERQUEUE_H
@@ -38,6 +38,9 @@ public:
   void init(srsue::rlc_interface_pdcp* rlc_, srsue::rrc_interface_pdcp* rrc_, srsue::gw_interface_pdcp* gw_);
   void stop();
 
+  /// Ciphers the user plane PDUs of all the DRBs in the given engine, which must outlive this object
+  void set_security_engine(pdcp_security_engine* engine);
+
   // Stack interface
   bool is_lcid_enabled(uint32_t lcid);
 
@@ -84,6 +87,7 @@ private:
   srsue::gw_interface_pdcp*  gw     = nullptr;
   srsran::task_sched_handle  task_sched;
   srslog::basic_logger&      logger;
+  pdcp_security_engine*      sec_engine = nullptr;
 
   using pdcp_map_t = std::map<uint16_t, std::unique_ptr<pdcp_entity_base> >;
   pdcp_map_t pdcp_array, pdcp_array_mrb;
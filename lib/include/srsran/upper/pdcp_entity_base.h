@@ -33,6 +33,7 @@
 #include "srsran/interfaces/pdcp_interface_types.h"
 #include "srsran/upper/byte_buffer_queue.h"
 #include "srsran/upper/pdcp_metrics.h"
+#include "srsran/upper/pdcp_security_engine.h"
 
 namespace srsran {
 
@@ -59,7 +60,7 @@ static const char pdcp_d_c_text[PDCP_D_C_N_ITEMS][20] = {"Control PDU", "Data PD
  * PDCP Entity interface
  * Common interface for LTE and NR PDCP entities
  ***************************************************************************/
-class pdcp_entity_base
+class pdcp_entity_base : public pdcp_security_engine::pdu_handler
 {
 public:
   pdcp_entity_base(task_sched_handle task_sched_, srslog::basic_logger& logger);
@@ -118,6 +119,9 @@ public:
 
   void config_security(const as_security_config_t& sec_cfg_);
 
+  // Defer the ciphering of user plane PDUs to a shared engine
+  void set_security_engine(pdcp_security_engine* engine);
+
   // GW/SDAP/RRC interface
   virtual void write_sdu(unique_byte_buffer_t sdu, int sn = -1) = 0;
 
@@ -169,6 +173,20 @@ protected:
 
   srsran::as_security_config_t sec_cfg = {};
 
+  // Expanded EEA2/EIA2 keys, computed when security is configured
+  security_aes128_key_t k_rrc_enc_aes;
+  security_aes128_key_t k_up_enc_aes;
+  security_aes128_key_t k_rrc_int_aes;
+  security_aes128_key_t k_up_int_aes;
+
+  // Shared engine where the user plane PDUs are ciphered in batches, if any
+  pdcp_security_engine*                sec_engine    = nullptr;
+  uint32_t                             sec_engine_id = 0;
+  pdcp_security_engine::cipher_key_ptr up_cipher_key;
+
+  bool defer_cipher_encrypt();
+  void push_to_security_engine(unique_byte_buffer_t pdu, uint32_t count);
+
   // Security functions
   void integrity_generate(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
   bool integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac);
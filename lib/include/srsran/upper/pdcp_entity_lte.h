@@ -126,6 +126,7 @@ public:
 
   // GW/RRC interface
   void write_sdu(unique_byte_buffer_t sdu, int sn = -1) override;
+  void write_ciphered_pdu(unique_byte_buffer_t pdu) override;
 
   // RLC interface
   void write_pdu(unique_byte_buffer_t pdu) override;
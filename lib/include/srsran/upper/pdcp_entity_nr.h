@@ -55,6 +55,7 @@ public:
 
   // RRC interface
   void write_sdu(unique_byte_buffer_t sdu, int sn = -1) final;
+  void write_ciphered_pdu(unique_byte_buffer_t pdu) final;
 
   // RLC interface
   void write_pdu(unique_byte_buffer_t pdu) final;
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_PDCP_SECURITY_ENGINE_H
+#define SRSRAN_PDCP_SECURITY_ENGINE_H
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/security.h"
+#include "srsran/common/task_scheduler.h"
+#include "srsran/common/thread_pool.h"
+#include "srsran/srslog/srslog.h"
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * @brief Ciphers the user plane PDUs of many PDCP entities in batches.
+ *
+ * PDCP entities push their PDUs once the header and COUNT are set, and the engine ciphers all the PDUs queued during
+ * a TTI together when run_tti() is called. EEA1/EEA3 PDUs are grouped so the keystreams are generated in the SIMD
+ * lanes of the multi-buffer generators. The batch is ciphered in the calling thread or, when the engine has workers,
+ * in its own thread pool. Ciphered PDUs are always returned to their entity from the stack thread and in the order
+ * they were pushed.
+ */
+class pdcp_security_engine
+{
+public:
+  /// Receives the PDUs once they are ciphered. Called from the stack thread
+  class pdu_handler
+  {
+  public:
+    virtual ~pdu_handler()                                    = default;
+    virtual void write_ciphered_pdu(unique_byte_buffer_t pdu) = 0;
+  };
+
+  /// Snapshot of a ciphering key. Shared with the batches in flight, so the entity can change its key at any time
+  struct cipher_key_t {
+    CIPHERING_ALGORITHM_ID_ENUM algo = CIPHERING_ALGORITHM_ID_EEA0;
+    as_key_t                    k_enc;
+    security_aes128_key_t       k_enc_aes;
+  };
+  using cipher_key_ptr = std::shared_ptr<const cipher_key_t>;
+
+  static cipher_key_ptr make_cipher_key(CIPHERING_ALGORITHM_ID_ENUM algo, const as_key_t& k_enc);
+
+  static const uint32_t max_batch_size = 1024; ///< PDUs after which a batch is flushed without waiting for the TTI
+
+  explicit pdcp_security_engine(srsran::task_sched_handle task_sched_, uint32_t nof_workers = 0);
+  ~pdcp_security_engine();
+  pdcp_security_engine(const pdcp_security_engine&) = delete;
+  pdcp_security_engine& operator=(const pdcp_security_engine&) = delete;
+
+  void stop();
+
+  uint32_t add_handler(pdu_handler* handler);
+  void     rem_handler(uint32_t handler_id);
+
+  /// Queues a PDU to be ciphered. The first hdr_len bytes are sent in clear
+  void push(uint32_t             handler_id,
+            cipher_key_ptr       key,
+            uint32_t             count,
+            uint8_t              bearer,
+            uint8_t              direction,
+            uint32_t             hdr_len,
+            unique_byte_buffer_t pdu);
+
+  /// Ciphers the PDUs queued since the last call
+  void run_tti();
+
+  uint32_t nof_workers() const { return workers == nullptr ? 0 : workers->nof_workers(); }
+
+private:
+  struct job_t {
+    uint32_t             handler_id;
+    cipher_key_ptr       key;
+    uint32_t             count;
+    uint8_t              bearer;
+    uint8_t              direction;
+    uint32_t             hdr_len;
+    unique_byte_buffer_t pdu;
+  };
+  struct batch_t {
+    uint64_t           seq = 0;
+    std::vector<job_t> jobs;
+  };
+
+  static void cipher_batch(batch_t& batch);
+  void        flush();
+  void        deliver(std::unique_ptr<batch_t> batch);
+  void        handle_completed(std::unique_ptr<batch_t> batch);
+
+  srsran::task_sched_handle task_sched;
+  srslog::basic_logger&     logger;
+
+  std::unordered_map<uint32_t, pdu_handler*> handlers;
+  uint32_t                                   next_handler_id = 0;
+
+  std::unique_ptr<batch_t> pending;
+  uint64_t                 next_seq     = 0; ///< Sequence number of the next batch to be flushed
+  uint64_t                 next_deliver = 0; ///< Sequence number of the next batch to be delivered
+  std::map<uint64_t, std::unique_ptr<batch_t> > completed; ///< Batches finished out of order
+
+  // Lets the completions still queued in the task scheduler detect that the engine is gone
+  std::shared_ptr<pdcp_security_engine*> alive_token;
+  std::unique_ptr<task_thread_pool>      workers;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_PDCP_SECURITY_ENGINE_H
@@ -0,0 +1,89 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/latency_histogram.h"
+#include <cmath>
+
+namespace srsran {
+
+constexpr uint32_t latency_histogram::nof_sub_buckets;
+constexpr uint32_t latency_histogram::nof_buckets;
+
+latency_histogram::latency_histogram()
+{
+  for (auto& c : counts) {
+    c.store(0, std::memory_order_relaxed);
+  }
+}
+
+void latency_histogram::read_and_reset(snapshot& s)
+{
+  for (uint32_t i = 0; i < nof_buckets; ++i) {
+    // Buckets are mostly empty, so avoid the read-modify-write when there is nothing to collect
+    if (counts[i].load(std::memory_order_relaxed) == 0) {
+      continue;
+    }
+    uint32_t count = counts[i].exchange(0, std::memory_order_relaxed);
+    s.counts[i] += count;
+    s.nof_samples += count;
+  }
+  s.max_ns = std::max(s.max_ns, max_ns.exchange(0, std::memory_order_relaxed));
+}
+
+uint64_t latency_histogram::bucket_max_value(uint32_t idx)
+{
+  if (idx < nof_sub_buckets) {
+    return idx;
+  }
+  uint32_t shift = idx / nof_sub_buckets - 1;
+  uint64_t sub   = idx % nof_sub_buckets;
+  return ((nof_sub_buckets + sub + 1) << shift) - 1;
+}
+
+uint64_t latency_histogram::snapshot::percentile_ns(double q) const
+{
+  if (nof_samples == 0) {
+    return 0;
+  }
+  uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * nof_samples)));
+  uint64_t sum  = 0;
+  for (uint32_t i = 0; i < nof_buckets; ++i) {
+    sum += counts[i];
+    if (sum >= rank) {
+      // The max is exact, while the bucket bound is not
+      return std::min(bucket_max_value(i), max_ns);
+    }
+  }
+  return max_ns;
+}
+
+latency_metrics_t latency_histogram::snapshot::get_metrics() const
+{
+  latency_metrics_t m;
+  m.nof_samples = static_cast<uint32_t>(nof_samples);
+  m.p50_us      = percentile_ns(0.5) / 1e3;
+  m.p99_us      = percentile_ns(0.99) / 1e3;
+  m.p999_us     = percentile_ns(0.999) / 1e3;
+  m.max_us      = max_ns / 1e3;
+  return m;
+}
+
+} // namespace srsran
@@ -18,8 +18,10 @@
 #include "srsran/common/liblte_security.h"
 #include "math.h"
 #include "srsran/common/s3g.h"
+#include "srsran/common/security.h"
 #include "srsran/common/ssl.h"
 #include "srsran/common/zuc.h"
+#include "srsran/config.h"
 
 #include <arpa/inet.h>
 
@@ -537,84 +539,14 @@ LIBLTE_ERROR_ENUM liblte_security_128_eia2(const uint8* key,
                                            uint8*       mac)
 {
   LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-  uint8             M[msg_len + 8 + 16];
-  aes_context       ctx;
-  uint32            i;
-  uint32            j;
-  uint32            n;
-  uint32            pad_bits;
-  uint8             const_zero[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-  uint8             L[16];
-  uint8             K1[16];
-  uint8             K2[16];
-  uint8             T[16];
-  uint8             tmp[16];
 
   if (key != NULL && msg != NULL && mac != NULL) {
-    // Subkey L generation
-    aes_setkey_enc(&ctx, key, 128);
-    aes_crypt_ecb(&ctx, AES_ENCRYPT, const_zero, L);
-
-    // Subkey K1 generation
-    for (i = 0; i < 15; i++) {
-      K1[i] = (L[i] << 1) | ((L[i + 1] >> 7) & 0x01);
-    }
-    K1[15] = L[15] << 1;
-    if (L[0] & 0x80) {
-      K1[15] ^= 0x87;
-    }
-
-    // Subkey K2 generation
-    for (i = 0; i < 15; i++) {
-      K2[i] = (K1[i] << 1) | ((K1[i + 1] >> 7) & 0x01);
-    }
-    K2[15] = K1[15] << 1;
-    if (K1[0] & 0x80) {
-      K2[15] ^= 0x87;
-    }
-
-    // Construct M
-    memset(M, 0, msg_len + 8 + 16);
-    M[0] = (count >> 24) & 0xFF;
-    M[1] = (count >> 16) & 0xFF;
-    M[2] = (count >> 8) & 0xFF;
-    M[3] = count & 0xFF;
-    M[4] = (bearer << 3) | (direction << 2);
-    for (i = 0; i < msg_len; i++) {
-      M[8 + i] = msg[i];
-    }
-
-    // MAC generation
-    n = (uint32)(ceilf((float)(msg_len + 8) / (float)(16)));
-    for (i = 0; i < 16; i++) {
-      T[i] = 0;
-    }
-    for (i = 0; i < n - 1; i++) {
-      for (j = 0; j < 16; j++) {
-        tmp[j] = T[j] ^ M[i * 16 + j];
-      }
-      aes_crypt_ecb(&ctx, AES_ENCRYPT, tmp, T);
-    }
-    pad_bits = ((msg_len * 8) + 64) % 128;
-    if (pad_bits == 0) {
-      for (j = 0; j < 16; j++) {
-        tmp[j] = T[j] ^ K1[j] ^ M[i * 16 + j];
-      }
-      aes_crypt_ecb(&ctx, AES_ENCRYPT, tmp, T);
-    } else {
-      pad_bits = (128 - pad_bits) - 1;
-      M[i * 16 + (15 - (pad_bits / 8))] |= 0x1 << (pad_bits % 8);
-      for (j = 0; j < 16; j++) {
-        tmp[j] = T[j] ^ K2[j] ^ M[i * 16 + j];
-      }
-      aes_crypt_ecb(&ctx, AES_ENCRYPT, tmp, T);
-    }
+    srsran::security_aes128_key_t aes_key;
+    aes_key.set_key(key);
 
-    for (i = 0; i < 4; i++) {
-      mac[i] = T[i];
+    if (srsran::security_128_eia2(aes_key, count, bearer, direction, msg, msg_len, mac) == SRSRAN_SUCCESS) {
+      err = LIBLTE_SUCCESS;
     }
-
-    err = LIBLTE_SUCCESS;
   }
 
   return (err);
@@ -919,29 +851,13 @@ LIBLTE_ERROR_ENUM liblte_security_encryption_eea2(uint8* key,
                                                   uint8* out)
 {
   LIBLTE_ERROR_ENUM err = LIBLTE_ERROR_INVALID_INPUTS;
-  aes_context       ctx;
-  unsigned char     stream_blk[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-  unsigned char     nonce_cnt[16]  = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-  int32             i;
-  int               ret;
-  size_t            nc_off = 0;
 
   if (key != NULL && msg != NULL && out != NULL) {
-    ret = aes_setkey_enc(&ctx, key, 128);
-
-    if (ret == 0) {
-      // Construct nonce
-      nonce_cnt[0] = (count >> 24) & 0xFF;
-      nonce_cnt[1] = (count >> 16) & 0xFF;
-      nonce_cnt[2] = (count >> 8) & 0xFF;
-      nonce_cnt[3] = (count)&0xFF;
-      nonce_cnt[4] = ((bearer & 0x1F) << 3) | ((direction & 0x01) << 2);
-
-      // Encryption
-      ret = aes_crypt_ctr(&ctx, (msg_len + 7) / 8, &nc_off, nonce_cnt, stream_blk, msg, out);
-    }
+    srsran::security_aes128_key_t aes_key;
+    aes_key.set_key(key);
 
-    if (ret == 0) {
+    // Encryption
+    if (srsran::security_128_eea2(aes_key, count, bearer, direction, msg, (msg_len + 7) / 8, out) == SRSRAN_SUCCESS) {
       // Zero tailing bits
       zero_tailing_bits(out, msg_len);
       err = LIBLTE_SUCCESS;
@@ -24,7 +24,7 @@
 #include <netinet/sctp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
-#include <unistd.h> // for the pipe
+#include <unistd.h>
 
 #define rxSockError(fmt, ...) logger.error("RxSockets: " fmt, ##__VA_ARGS__)
 #define rxSockWarn(fmt, ...) logger.warning("RxSockets: " fmt, ##__VA_ARGS__)
@@ -391,15 +391,115 @@ bool unique_socket::sctp_set_init_msg_opts(int max_init_attempts, int max_init_t
   return net_utils::sctp_set_init_msg_opts(sockfd, max_init_attempts, max_init_timeo);
 }
 
+/***************************************************************
+ *                 UDP batched IO
+ **************************************************************/
+
+udp_rx_batch::udp_rx_batch(uint32_t batch_size_) : batch_size(std::min(std::max(batch_size_, 1u), max_batch_size)) {}
+
+int udp_rx_batch::recv(int fd)
+{
+  std::array<mmsghdr, max_batch_size> msgs;
+  std::array<iovec, max_batch_size>   iovs;
+
+  // Refill the slots whose PDUs were taken after the previous call
+  nof_pdus = 0;
+  for (; nof_pdus < batch_size; nof_pdus++) {
+    if (pdus[nof_pdus] == nullptr) {
+      pdus[nof_pdus] = make_byte_buffer();
+      if (pdus[nof_pdus] == nullptr) {
+        break;
+      }
+    }
+    pdus[nof_pdus]->clear();
+    iovs[nof_pdus].iov_base            = pdus[nof_pdus]->msg;
+    iovs[nof_pdus].iov_len             = pdus[nof_pdus]->get_tailroom();
+    msgs[nof_pdus]                     = {};
+    msgs[nof_pdus].msg_hdr.msg_name    = &addrs[nof_pdus];
+    msgs[nof_pdus].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    msgs[nof_pdus].msg_hdr.msg_iov     = &iovs[nof_pdus];
+    msgs[nof_pdus].msg_hdr.msg_iovlen  = 1;
+  }
+  if (nof_pdus == 0) {
+    errno = ENOBUFS;
+    return -1;
+  }
+
+  int n = recvmmsg(fd, msgs.data(), nof_pdus, MSG_DONTWAIT, nullptr);
+  if (n < 0) {
+    nof_pdus = 0;
+    return -1;
+  }
+  nof_pdus = static_cast<uint32_t>(n);
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    pdus[i]->N_bytes = msgs[i].msg_len;
+  }
+  return n;
+}
+
+udp_tx_batch::udp_tx_batch(srslog::basic_logger& logger_, uint32_t batch_size_) :
+  logger(logger_), batch_size(std::min(std::max(batch_size_, 1u), max_batch_size))
+{}
+
+void udp_tx_batch::push(unique_byte_buffer_t pdu, const sockaddr_in& dest_addr)
+{
+  pdus[nof_pdus]  = std::move(pdu);
+  addrs[nof_pdus] = dest_addr;
+  nof_pdus++;
+  if (nof_pdus >= batch_size) {
+    flush();
+  }
+}
+
+uint32_t udp_tx_batch::flush()
+{
+  if (nof_pdus == 0) {
+    return 0;
+  }
+
+  std::array<mmsghdr, max_batch_size> msgs;
+  std::array<iovec, max_batch_size>   iovs;
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    iovs[i].iov_base            = pdus[i]->msg;
+    iovs[i].iov_len             = pdus[i]->N_bytes;
+    msgs[i]                     = {};
+    msgs[i].msg_hdr.msg_name    = &addrs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    msgs[i].msg_hdr.msg_iov     = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen  = 1;
+  }
+
+  // sendmmsg() stops at the first datagram that fails. Skip it and send the rest
+  uint32_t nof_sent = 0;
+  for (uint32_t offset = 0; offset < nof_pdus;) {
+    int n = sendmmsg(fd, &msgs[offset], nof_pdus - offset, 0);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      logger.error("Error sending UDP datagram of %d bytes: %s", pdus[offset]->N_bytes, strerror(errno));
+      offset++;
+      continue;
+    }
+    offset += n;
+    nof_sent += n;
+  }
+
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    pdus[i].reset();
+  }
+  nof_pdus = 0;
+  return nof_sent;
+}
+
 /***************************************************************
  *                 Rx Multisocket Handler
  **************************************************************/
 
 socket_manager::socket_manager() : thread("RXsockets"), socket_manager_itf(srslog::fetch_basic_logger("COMN"))
 {
-  // register control pipe fd
-  int fd = pipe(pipefd);
-  srsran_assert(fd != -1, "Failed to open control pipe");
+  srsran_assert(reactor.is_valid(), "Failed to create epoll reactor");
+  running = true;
   start(thread_prio);
 }
 
@@ -412,25 +512,11 @@ void socket_manager::stop()
 {
   if (running) {
     // close thread
-    {
-      std::lock_guard<std::mutex> lock(socket_mutex);
-      ctrl_cmd_t                  msg;
-      msg.cmd = ctrl_cmd_t::cmd_id_t::EXIT;
-      if (write(pipefd[1], &msg, sizeof(msg)) != sizeof(msg)) {
-        rxSockError("while writing to control pipe");
-      }
-    }
+    running = false;
+    reactor.wakeup();
     rxSockDebug("Closing rx socket handler thread");
     wait_thread_finish();
   }
-
-  if (pipefd[0] >= 0) {
-    close(pipefd[0]);
-    close(pipefd[1]);
-    pipefd[0] = -1;
-    pipefd[1] = -1;
-    rxSockDebug("closed.");
-  }
 }
 
 bool socket_manager::add_socket_handler(int fd, recv_callback_t handler)
@@ -440,19 +526,22 @@ bool socket_manager::add_socket_handler(int fd, recv_callback_t handler)
     rxSockError("Provided SCTP socket must be already open");
     return false;
   }
-  if (active_sockets.count(fd) > 0) {
+  if (reactor.has_fd(fd)) {
     rxSockError("Tried to register fd=%d, but this fd already exists", fd);
     return false;
   }
 
-  active_sockets.insert(std::make_pair(fd, std::move(handler)));
-
-  // this unlocks the reading thread to add new connections
-  ctrl_cmd_t msg;
-  msg.cmd    = ctrl_cmd_t::cmd_id_t::NEW_FD;
-  msg.new_fd = fd;
-  if (write(pipefd[1], &msg, sizeof(msg)) != sizeof(msg)) {
-    rxSockError("while writing to control pipe");
+  // the socket is removed once the handler reports it was closed by the peer
+  auto callback = [this, handler = std::move(handler)](int sock_fd) mutable {
+    bool socket_valid = handler(sock_fd);
+    if (not socket_valid) {
+      rxSockInfo("The socket fd=%d has been closed by peer", sock_fd);
+      reactor.rem_fd(sock_fd);
+      rxSockDebug("Socket fd=%d has been successfully removed", sock_fd);
+    }
+  };
+  if (not reactor.add_fd(fd, std::move(callback))) {
+    rxSockError("Failed to register fd=%d in epoll", fd);
     return false;
   }
 
@@ -460,133 +549,35 @@ bool socket_manager::add_socket_handler(int fd, recv_callback_t handler)
   return true;
 }
 
-bool socket_manager::remove_socket_nonblocking(int fd, bool signal_completion)
+bool socket_manager::remove_socket(int fd)
 {
   std::lock_guard<std::mutex> lock(socket_mutex);
-  auto                        it = active_sockets.find(fd);
-  if (it == active_sockets.end()) {
+  if (not reactor.rem_fd(fd)) {
     rxSockWarn("The socket fd=%d to be removed does not exist", fd);
     return false;
   }
-
-  ctrl_cmd_t msg;
-  msg.cmd                = ctrl_cmd_t::cmd_id_t::RM_FD;
-  msg.new_fd             = fd;
-  msg.signal_rm_complete = signal_completion;
-  if (write(pipefd[1], &msg, sizeof(msg)) != sizeof(msg)) {
-    rxSockError("while writing to control pipe");
-    return false;
-  }
-  return true;
-}
-
-bool socket_manager::remove_socket(int fd)
-{
-  bool result = remove_socket_nonblocking(fd, true);
-
-  // block waiting for socket removal
-  if (result) {
-    std::unique_lock<std::mutex> lock(socket_mutex);
-    while (std::count(rem_fd_tmp_list.begin(), rem_fd_tmp_list.end(), fd) == 0) {
-      rem_cvar.wait(lock);
-    }
-    rem_fd_tmp_list.erase(std::find(rem_fd_tmp_list.begin(), rem_fd_tmp_list.end(), fd));
-  }
-  return result;
-}
-
-std::map<int, socket_manager::recv_callback_t>::iterator
-socket_manager::remove_socket_unprotected(int fd, fd_set* total_fd_set, int* max_fd)
-{
-  if (fd < 0) {
-    rxSockError("fd to be removed is not valid");
-    return active_sockets.end();
-  }
-  auto it = active_sockets.find(fd);
-  it      = active_sockets.erase(it);
-  FD_CLR(fd, total_fd_set);
-  // assumes ordering
-  *max_fd = (active_sockets.empty()) ? pipefd[0] : std::max(pipefd[0], active_sockets.rbegin()->first);
   rxSockDebug("Socket fd=%d has been successfully removed", fd);
-  return it;
+  return true;
 }
 
 void socket_manager::run_thread()
 {
-  running = true;
-  fd_set total_fd_set, read_fd_set;
-  FD_ZERO(&total_fd_set);
-  int max_fd = 0;
-
-  FD_SET(pipefd[0], &total_fd_set);
-  max_fd = std::max(pipefd[0], max_fd);
-
   while (running.load(std::memory_order_relaxed)) {
-    memcpy(&read_fd_set, &total_fd_set, sizeof(total_fd_set));
-    int n = select(max_fd + 1, &read_fd_set, nullptr, nullptr, nullptr);
+    int n = reactor.wait_events(-1);
 
-    // handle select return
+    // handle epoll return
     if (n == -1) {
-      rxSockError("Error from select(%d,...). Number of rx sockets: %d", max_fd + 1, (int)active_sockets.size() + 1);
+      rxSockError("Error from epoll_wait(). Number of rx sockets: %d", (int)reactor.nof_fds());
       continue;
     }
     if (n == 0) {
-      rxSockDebug("No data from select.");
+      rxSockDebug("No data from epoll_wait.");
       continue;
     }
 
-    // Shared state area
+    // Shared state area. Call read callback for all SCTP/TCP/UDP connections with data
     std::lock_guard<std::mutex> lock(socket_mutex);
-
-    // call read callback for all SCTP/TCP/UDP connections
-    for (auto handler_it = active_sockets.begin(); handler_it != active_sockets.end();) {
-      int              fd       = handler_it->first;
-      recv_callback_t& callback = handler_it->second;
-      if (not FD_ISSET(fd, &read_fd_set)) {
-        ++handler_it;
-        continue;
-      }
-      bool socket_valid = callback(fd);
-      if (not socket_valid) {
-        rxSockInfo("The socket fd=%d has been closed by peer", fd);
-        handler_it = remove_socket_unprotected(fd, &total_fd_set, &max_fd);
-      } else {
-        ++handler_it;
-      }
-    }
-
-    // handle ctrl messages
-    if (FD_ISSET(pipefd[0], &read_fd_set)) {
-      ctrl_cmd_t msg;
-      ssize_t    nrd = read(pipefd[0], &msg, sizeof(msg));
-      if (nrd <= 0) {
-        rxSockError("Unable to read control message.");
-        continue;
-      }
-      switch (msg.cmd) {
-        case ctrl_cmd_t::cmd_id_t::EXIT:
-          running = false;
-          return;
-        case ctrl_cmd_t::cmd_id_t::NEW_FD:
-          if (msg.new_fd >= 0) {
-            FD_SET(msg.new_fd, &total_fd_set);
-            max_fd = std::max(max_fd, msg.new_fd);
-          } else {
-            rxSockError("added fd is not valid");
-          }
-          break;
-        case ctrl_cmd_t::cmd_id_t::RM_FD:
-          remove_socket_unprotected(msg.new_fd, &total_fd_set, &max_fd);
-          if (msg.signal_rm_complete) {
-            rem_fd_tmp_list.push_back(msg.new_fd);
-            rem_cvar.notify_one();
-          }
-          rxSockDebug("Socket fd=%d has been successfully removed", msg.new_fd);
-          break;
-        default:
-          rxSockError("ctrl message command %d is not valid", (int)msg.cmd);
-      }
-    }
+    reactor.handle_events();
   }
 }
 
@@ -650,7 +641,8 @@ make_sctp_sdu_handler(srslog::basic_logger& logger, srsran::task_queue_handle& q
 
 /**
  * Description: Functor for the case the received data is
- * in the form of unique_byte_buffer, and a recvfrom(...) call is used
+ * in the form of unique_byte_buffer, and a recvmmsg(...) call is used to read all the datagrams pending in the socket.
+ * The whole batch is dispatched to the queue as a single task
  */
 class recvfrom_pdu_task
 {
@@ -662,15 +654,11 @@ public:
 
   bool operator()(int fd)
   {
-    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-    if (pdu == nullptr) {
+    int n_recv = rx_batch.recv(fd);
+    if (n_recv == -1 and errno == ENOBUFS) {
       logger.error("Unable to allocate byte buffer");
       return true;
     }
-    sockaddr_in from    = {};
-    socklen_t   fromlen = sizeof(from);
-
-    ssize_t n_recv = recvfrom(fd, pdu->msg, pdu->get_tailroom(), 0, (struct sockaddr*)&from, &fromlen);
     if (n_recv == -1 and errno != EAGAIN) {
       logger.error("Error reading from socket: %s", strerror(errno));
       return true;
@@ -680,19 +668,34 @@ public:
       return true;
     }
 
-    pdu->N_bytes = static_cast<uint32_t>(n_recv);
+    std::vector<rx_pdu_t> pdus;
+    pdus.reserve(rx_batch.size());
+    for (uint32_t i = 0; i < rx_batch.size(); i++) {
+      pdus.push_back(rx_pdu_t{rx_batch.pop_pdu(i), rx_batch.get_addr(i)});
+    }
 
-    // Defer handling of received packet to provided queue
-    queue.push(
-        std::bind([this, from](srsran::unique_byte_buffer_t& sdu) { func(std::move(sdu), from); }, std::move(pdu)));
+    // Defer handling of received packets to provided queue
+    queue.push(std::bind(
+        [this](std::vector<rx_pdu_t>& sdus) {
+          for (rx_pdu_t& sdu : sdus) {
+            func(std::move(sdu.pdu), sdu.from);
+          }
+        },
+        std::move(pdus)));
 
     return true;
   }
 
 private:
+  struct rx_pdu_t {
+    srsran::unique_byte_buffer_t pdu;
+    sockaddr_in                  from;
+  };
+
   srslog::basic_logger&      logger;
   srsran::task_queue_handle& queue;
   callback_t                 func;
+  udp_rx_batch               rx_batch;
 };
 
 socket_manager_itf::recv_callback_t
@@ -20,6 +20,7 @@
  */
 
 #include "srsran/common/s3g.h"
+#include "srsran/phy/utils/simd.h"
 
 /* S-box SQ */
 static const uint8_t SQ[256] = {
@@ -51,115 +52,6 @@ static const uint8_t S[256] = {
     180, 198, 232, 221, 116, 31,  75,  189, 139, 138, 112, 62,  181, 102, 72,  3,   246, 14,  97,  53,  87,  185,
     134, 193, 29,  158, 225, 248, 152, 17,  105, 217, 142, 148, 155, 30,  135, 233, 206, 85,  40,  223, 140, 161,
     137, 13,  191, 230, 66,  104, 65,  153, 45,  15,  176, 84,  187, 22};
-/*********************************************************************
-    Name: s3g_mul_x
-
-    Description: Multiplication with reduction.
-
-    Document Reference: Specification of the 3GPP Confidentiality and
-                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
-                            Section 3.1.1
-*********************************************************************/
-uint8_t s3g_mul_x(uint8_t v, uint8_t c);
-
-/*********************************************************************
-    Name: s3g_mul_x_pow
-
-    Description: Recursive multiplication with reduction.
-
-    Document Reference: Specification of the 3GPP Confidentiality and
-                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
-                            Section 3.1.2
-*********************************************************************/
-uint8_t s3g_mul_x_pow(uint8_t v, uint8_t i, uint8_t c);
-
-/*********************************************************************
-    Name: s3g_mul_alpha
-
-    Description: Multiplication with alpha.
-
-    Document Reference: Specification of the 3GPP Confidentiality and
-                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
-                            Section 3.4.2
-*********************************************************************/
-uint32_t s3g_mul_alpha(uint8_t c);
-
-/*********************************************************************
-    Name: s3g_div_alpha
-
-    Description: Division by alpha.
-
-    Document Reference: Specification of the 3GPP Confidentiality and
-                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
-                            Section 3.4.3
-*********************************************************************/
-uint32_t s3g_div_alpha(uint8_t c);
-
-/*********************************************************************
-    Name: s3g_s1
-
-    Description: S-Box S1.
-
-    Document Reference: Specification of the 3GPP Confidentiality and
-                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
-                            Section 3.3.1
-*********************************************************************/
-uint32_t s3g_s1(uint32_t w);
-
-/*********************************************************************
-    Name: s3g_s2
-
-    Description: S-Box S2.
-
-    Document Reference: Specification of the 3GPP Confidentiality and
-                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
-                            Section 3.3.2
-*********************************************************************/
-uint32_t s3g_s2(uint32_t w);
-
-/*********************************************************************
-    Name: s3g_clock_lfsr
-
-    Description: Clocking LFSR.
-
-    Document Reference: Specification of the 3GPP Confidentiality and
-                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
-                            Section 3.4.4 and Section 3.4.5
-*********************************************************************/
-void s3g_clock_lfsr(S3G_STATE* state, uint32_t f);
-
-/*********************************************************************
-    Name: s3g_clock_fsm
-
-    Description: Clocking FSM.
-
-    Document Reference: Specification of the 3GPP Confidentiality and
-                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
-                            Section 3.4.6
-*********************************************************************/
-uint32_t s3g_clock_fsm(S3G_STATE* state);
-
-/*********************************************************************
-    Name: s3g_deinitialize
-
-    Description: Deinitialization.
-
-    Document Reference: Specification of the 3GPP Confidentiality and
-                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
-*********************************************************************/
-void s3g_deinitialize(S3G_STATE* state);
-
-/*********************************************************************
-    Name: s3g_generate_keystream
-
-    Description: Generation of Keystream.
-
-    Document Reference: Specification of the 3GPP Confidentiality and
-                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
-                            Section 4.2
-*********************************************************************/
-void s3g_generate_keystream(S3G_STATE* state, uint32_t n, uint32_t* ks);
-
 /*********************************************************************
     Name: s3g_mul_x
 
@@ -180,7 +72,7 @@ uint8_t s3g_mul_x(uint8_t v, uint8_t c)
 /*********************************************************************
     Name: s3g_mul_x_pow
 
-    Description: Recursive multiplication with reduction.
+    Description: Multiplication with reduction, i times.
 
     Document Reference: Specification of the 3GPP Confidentiality and
                             Integrity Algorithms UEA2 & UIA2 D2 v1.1
@@ -188,10 +80,58 @@ uint8_t s3g_mul_x(uint8_t v, uint8_t c)
 *********************************************************************/
 uint8_t s3g_mul_x_pow(uint8_t v, uint8_t i, uint8_t c)
 {
-  if (i == 0)
-    return v;
-  else
-    return s3g_mul_x(s3g_mul_x_pow(v, i - 1, c), c);
+  for (; i > 0; i--) {
+    v = s3g_mul_x(v, c);
+  }
+  return v;
+}
+
+/*********************************************************************
+    Name: s3g_tables_t
+
+    Description: Precomputed GF(2^8) products and S-boxes. MULalpha
+                 and DIValpha are the 256-entry tables of section
+                 3.4.2 and 3.4.3. S1 and S2 are split into four
+                 tables, one per input byte, each holding the S-box
+                 output already multiplied by its MixColumn column,
+                 so that S1(w) and S2(w) are the XOR of four lookups.
+                 They are also the tables gathered by the multi-lane
+                 generator.
+*********************************************************************/
+typedef struct {
+  uint32_t mul_alpha[256];
+  uint32_t div_alpha[256];
+  uint32_t s1[4][256];
+  uint32_t s2[4][256];
+} s3g_tables_t;
+
+/* Column j of the MixColumn of an S-box output s: 2s in row j, 3s in row j + 1 and s in the other two rows */
+static uint32_t s3g_mix_column(uint8_t s, uint8_t j, uint8_t c)
+{
+  uint8_t r[4] = {s, s, s, s};
+  r[j]           = s3g_mul_x(s, c);
+  r[(j + 1) % 4] = s3g_mul_x(s, c) ^ s;
+  return (((uint32_t)r[0]) << 24) | (((uint32_t)r[1]) << 16) | (((uint32_t)r[2]) << 8) | ((uint32_t)r[3]);
+}
+
+static const s3g_tables_t& s3g_get_tables()
+{
+  static const s3g_tables_t tables = []() {
+    s3g_tables_t t = {};
+    for (uint32_t i = 0; i < 256; i++) {
+      uint8_t c      = (uint8_t)i;
+      t.mul_alpha[i] = ((((uint32_t)s3g_mul_x_pow(c, 23, 0xa9)) << 24) | (((uint32_t)s3g_mul_x_pow(c, 245, 0xa9)) << 16) |
+                        (((uint32_t)s3g_mul_x_pow(c, 48, 0xa9)) << 8) | (((uint32_t)s3g_mul_x_pow(c, 239, 0xa9))));
+      t.div_alpha[i] = ((((uint32_t)s3g_mul_x_pow(c, 16, 0xa9)) << 24) | (((uint32_t)s3g_mul_x_pow(c, 39, 0xa9)) << 16) |
+                        (((uint32_t)s3g_mul_x_pow(c, 6, 0xa9)) << 8) | (((uint32_t)s3g_mul_x_pow(c, 64, 0xa9))));
+      for (uint8_t j = 0; j < 4; j++) {
+        t.s1[j][i] = s3g_mix_column(S[i], j, 0x1b);
+        t.s2[j][i] = s3g_mix_column(SQ[i], j, 0x69);
+      }
+    }
+    return t;
+  }();
+  return tables;
 }
 
 /*********************************************************************
@@ -205,8 +145,7 @@ uint8_t s3g_mul_x_pow(uint8_t v, uint8_t i, uint8_t c)
 *********************************************************************/
 uint32_t s3g_mul_alpha(uint8_t c)
 {
-  return ((((uint32_t)s3g_mul_x_pow(c, 23, 0xa9)) << 24) | (((uint32_t)s3g_mul_x_pow(c, 245, 0xa9)) << 16) |
-          (((uint32_t)s3g_mul_x_pow(c, 48, 0xa9)) << 8) | (((uint32_t)s3g_mul_x_pow(c, 239, 0xa9))));
+  return s3g_get_tables().mul_alpha[c];
 }
 
 /*********************************************************************
@@ -220,8 +159,7 @@ uint32_t s3g_mul_alpha(uint8_t c)
 *********************************************************************/
 uint32_t s3g_div_alpha(uint8_t c)
 {
-  return ((((uint32_t)s3g_mul_x_pow(c, 16, 0xa9)) << 24) | (((uint32_t)s3g_mul_x_pow(c, 39, 0xa9)) << 16) |
-          (((uint32_t)s3g_mul_x_pow(c, 6, 0xa9)) << 8) | (((uint32_t)s3g_mul_x_pow(c, 64, 0xa9))));
+  return s3g_get_tables().div_alpha[c];
 }
 
 /*********************************************************************
@@ -233,23 +171,9 @@ uint32_t s3g_div_alpha(uint8_t c)
                             Integrity Algorithms UEA2 & UIA2 D2 v1.1
                             Section 3.3.1
 *********************************************************************/
-uint32_t s3g_s1(uint32_t w)
+static inline uint32_t s3g_s1(const s3g_tables_t& t, uint32_t w)
 {
-  uint8_t r0 = 0, r1 = 0, r2 = 0, r3 = 0;
-  uint8_t srw0 = S[(uint8_t)((w >> 24) & 0xff)];
-  uint8_t srw1 = S[(uint8_t)((w >> 16) & 0xff)];
-  uint8_t srw2 = S[(uint8_t)((w >> 8) & 0xff)];
-  uint8_t srw3 = S[(uint8_t)((w)&0xff)];
-
-  r0 = ((s3g_mul_x(srw0, 0x1b)) ^ (srw1) ^ (srw2) ^ ((s3g_mul_x(srw3, 0x1b)) ^ srw3));
-
-  r1 = (((s3g_mul_x(srw0, 0x1b)) ^ srw0) ^ (s3g_mul_x(srw1, 0x1b)) ^ (srw2) ^ (srw3));
-
-  r2 = ((srw0) ^ ((s3g_mul_x(srw1, 0x1b)) ^ srw1) ^ (s3g_mul_x(srw2, 0x1b)) ^ (srw3));
-
-  r3 = ((srw0) ^ (srw1) ^ ((s3g_mul_x(srw2, 0x1b)) ^ srw2) ^ (s3g_mul_x(srw3, 0x1b)));
-
-  return ((((uint32_t)r0) << 24) | (((uint32_t)r1) << 16) | (((uint32_t)r2) << 8) | (((uint32_t)r3)));
+  return t.s1[0][w >> 24] ^ t.s1[1][(w >> 16) & 0xff] ^ t.s1[2][(w >> 8) & 0xff] ^ t.s1[3][w & 0xff];
 }
 
 /*********************************************************************
@@ -261,66 +185,90 @@ uint32_t s3g_s1(uint32_t w)
                             Integrity Algorithms UEA2 & UIA2 D2 v1.1
                             Section 3.3.2
 *********************************************************************/
-uint32_t s3g_s2(uint32_t w)
+static inline uint32_t s3g_s2(const s3g_tables_t& t, uint32_t w)
 {
-  uint8_t r0 = 0, r1 = 0, r2 = 0, r3 = 0;
-  uint8_t sqw0 = SQ[(uint8_t)((w >> 24) & 0xff)];
-  uint8_t sqw1 = SQ[(uint8_t)((w >> 16) & 0xff)];
-  uint8_t sqw2 = SQ[(uint8_t)((w >> 8) & 0xff)];
-  uint8_t sqw3 = SQ[(uint8_t)((w)&0xff)];
-
-  r0 = ((s3g_mul_x(sqw0, 0x69)) ^ (sqw1) ^ (sqw2) ^ ((s3g_mul_x(sqw3, 0x69)) ^ sqw3));
-
-  r1 = (((s3g_mul_x(sqw0, 0x69)) ^ sqw0) ^ (s3g_mul_x(sqw1, 0x69)) ^ (sqw2) ^ (sqw3));
-
-  r2 = ((sqw0) ^ ((s3g_mul_x(sqw1, 0x69)) ^ sqw1) ^ (s3g_mul_x(sqw2, 0x69)) ^ (sqw3));
-
-  r3 = ((sqw0) ^ (sqw1) ^ ((s3g_mul_x(sqw2, 0x69)) ^ sqw2) ^ (s3g_mul_x(sqw3, 0x69)));
-
-  return ((((uint32_t)r0) << 24) | (((uint32_t)r1) << 16) | (((uint32_t)r2) << 8) | (((uint32_t)r3)));
+  return t.s2[0][w >> 24] ^ t.s2[1][(w >> 16) & 0xff] ^ t.s2[2][(w >> 8) & 0xff] ^ t.s2[3][w & 0xff];
 }
 
 /*********************************************************************
-    Name: s3g_clock_lfsr
+    Name: s3g_clock
 
-    Description: Clocking LFSR.
+    Description: Clocking FSM and LFSR. The LFSR is a ring of 16
+                 words where s[(j + i) & 15] is s_i, so the update
+                 overwrites the oldest word instead of shifting all
+                 of them. With a constant j all the ring indexes are
+                 resolved at compile time. Returns the keystream
+                 word F ^ s_0; in initialisation mode F is fed back
+                 into the LFSR instead.
 
     Document Reference: Specification of the 3GPP Confidentiality and
                             Integrity Algorithms UEA2 & UIA2 D2 v1.1
-                            Section 3.4.4 and Section 3.4.5
+                            Section 3.4.4, 3.4.5 and 3.4.6
 *********************************************************************/
-void s3g_clock_lfsr(S3G_STATE* state, uint32_t f)
+template <bool init_mode>
+static inline uint32_t s3g_clock(uint32_t* s, uint32_t* fsm, const s3g_tables_t& t, uint32_t j)
 {
-  uint32_t v = (((state->lfsr[0] << 8) & 0xffffff00) ^ (s3g_mul_alpha((uint8_t)((state->lfsr[0] >> 24) & 0xff))) ^
-                (state->lfsr[2]) ^ ((state->lfsr[11] >> 8) & 0x00ffffff) ^
-                (s3g_div_alpha((uint8_t)((state->lfsr[11]) & 0xff))) ^ (f));
-  uint8_t  i;
-
-  for (i = 0; i < 15; i++) {
-    state->lfsr[i] = state->lfsr[i + 1];
+#define S3G_S(i) s[(j + (i)) & 15]
+  uint32_t f = (S3G_S(15) + fsm[0]) ^ fsm[1];
+  uint32_t r = fsm[1] + (fsm[2] ^ S3G_S(5));
+  fsm[2]     = s3g_s2(t, fsm[1]);
+  fsm[1]     = s3g_s1(t, fsm[0]);
+  fsm[0]     = r;
+
+  uint32_t z = f ^ S3G_S(0);
+  uint32_t v = (S3G_S(0) << 8) ^ t.mul_alpha[S3G_S(0) >> 24] ^ S3G_S(2) ^ (S3G_S(11) >> 8) ^
+               t.div_alpha[S3G_S(11) & 0xff];
+  if (init_mode) {
+    v ^= f;
   }
-  state->lfsr[15] = v;
+  S3G_S(0) = v;
+#undef S3G_S
+  return z;
 }
 
-/*********************************************************************
-    Name: s3g_clock_fsm
-
-    Description: Clocking FSM.
-
-    Document Reference: Specification of the 3GPP Confidentiality and
-                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
-                            Section 3.4.6
-*********************************************************************/
-uint32_t s3g_clock_fsm(S3G_STATE* state)
+/* 16 clocks starting at ring position j, which leaves the ring back at position j */
+#define S3G_CLOCK_16(MODE, OUT, J)                                                                                     \
+  do {                                                                                                                 \
+    OUT(0) s3g_clock<MODE>(s, state->fsm, t, (J) + 0);                                                                 \
+    OUT(1) s3g_clock<MODE>(s, state->fsm, t, (J) + 1);                                                                 \
+    OUT(2) s3g_clock<MODE>(s, state->fsm, t, (J) + 2);                                                                 \
+    OUT(3) s3g_clock<MODE>(s, state->fsm, t, (J) + 3);                                                                 \
+    OUT(4) s3g_clock<MODE>(s, state->fsm, t, (J) + 4);                                                                 \
+    OUT(5) s3g_clock<MODE>(s, state->fsm, t, (J) + 5);                                                                 \
+    OUT(6) s3g_clock<MODE>(s, state->fsm, t, (J) + 6);                                                                 \
+    OUT(7) s3g_clock<MODE>(s, state->fsm, t, (J) + 7);                                                                 \
+    OUT(8) s3g_clock<MODE>(s, state->fsm, t, (J) + 8);                                                                 \
+    OUT(9) s3g_clock<MODE>(s, state->fsm, t, (J) + 9);                                                                 \
+    OUT(10) s3g_clock<MODE>(s, state->fsm, t, (J) + 10);                                                               \
+    OUT(11) s3g_clock<MODE>(s, state->fsm, t, (J) + 11);                                                               \
+    OUT(12) s3g_clock<MODE>(s, state->fsm, t, (J) + 12);                                                               \
+    OUT(13) s3g_clock<MODE>(s, state->fsm, t, (J) + 13);                                                               \
+    OUT(14) s3g_clock<MODE>(s, state->fsm, t, (J) + 14);                                                               \
+    OUT(15) s3g_clock<MODE>(s, state->fsm, t, (J) + 15);                                                               \
+  } while (0)
+#define S3G_DISCARD(i)
+#define S3G_KEYSTREAM(i) ks[n + (i)] =
+
+/* Loads the initial LFSR of section 4.1 */
+static void s3g_load_key(uint32_t* s, const uint32_t k[4], const uint32_t iv[4])
 {
-  uint32_t f = ((state->lfsr[15] + state->fsm[0]) & 0xffffffff) ^ state->fsm[1];
-  uint32_t r = (state->fsm[1] + (state->fsm[2] ^ state->lfsr[5])) & 0xffffffff;
-
-  state->fsm[2] = s3g_s2(state->fsm[1]);
-  state->fsm[1] = s3g_s1(state->fsm[0]);
-  state->fsm[0] = r;
-
-  return f;
+  s[15] = k[3] ^ iv[0];
+  s[14] = k[2];
+  s[13] = k[1];
+  s[12] = k[0] ^ iv[1];
+
+  s[11] = k[3] ^ 0xffffffff;
+  s[10] = k[2] ^ 0xffffffff ^ iv[2];
+  s[9]  = k[1] ^ 0xffffffff ^ iv[3];
+  s[8]  = k[0] ^ 0xffffffff;
+  s[7]  = k[3];
+  s[6]  = k[2];
+  s[5]  = k[1];
+  s[4]  = k[0];
+  s[3]  = k[3] ^ 0xffffffff;
+  s[2]  = k[2] ^ 0xffffffff;
+  s[1]  = k[1] ^ 0xffffffff;
+  s[0]  = k[0] ^ 0xffffffff;
 }
 
 /*********************************************************************
@@ -332,54 +280,30 @@ uint32_t s3g_clock_fsm(S3G_STATE* state)
                             Integrity Algorithms UEA2 & UIA2 D2 v1.1
                             Section 4.1
 *********************************************************************/
-void s3g_initialize(S3G_STATE* state, uint32_t k[4], uint32_t iv[4])
+void s3g_initialize(S3G_STATE* state, const uint32_t k[4], const uint32_t iv[4])
 {
-  uint8_t  i = 0;
-  uint32_t f = 0x0;
-
-  state->lfsr = (uint32_t*)calloc(16, sizeof(uint32_t));
-  state->fsm  = (uint32_t*)calloc(3, sizeof(uint32_t));
-
-  state->lfsr[15] = k[3] ^ iv[0];
-  state->lfsr[14] = k[2];
-  state->lfsr[13] = k[1];
-  state->lfsr[12] = k[0] ^ iv[1];
-
-  state->lfsr[11] = k[3] ^ 0xffffffff;
-  state->lfsr[10] = k[2] ^ 0xffffffff ^ iv[2];
-  state->lfsr[9]  = k[1] ^ 0xffffffff ^ iv[3];
-  state->lfsr[8]  = k[0] ^ 0xffffffff;
-  state->lfsr[7]  = k[3];
-  state->lfsr[6]  = k[2];
-  state->lfsr[5]  = k[1];
-  state->lfsr[4]  = k[0];
-  state->lfsr[3]  = k[3] ^ 0xffffffff;
-  state->lfsr[2]  = k[2] ^ 0xffffffff;
-  state->lfsr[1]  = k[1] ^ 0xffffffff;
-  state->lfsr[0]  = k[0] ^ 0xffffffff;
+  const s3g_tables_t& t = s3g_get_tables();
+  uint32_t*           s = state->lfsr;
 
+  s3g_load_key(s, k, iv);
   state->fsm[0] = 0x0;
   state->fsm[1] = 0x0;
   state->fsm[2] = 0x0;
-  for (i = 0; i < 32; i++) {
-    f = s3g_clock_fsm(state);
-    s3g_clock_lfsr(state, f);
-  }
+
+  // 32 clocks leave the ring at position 0
+  S3G_CLOCK_16(true, S3G_DISCARD, 0);
+  S3G_CLOCK_16(true, S3G_DISCARD, 0);
 }
 
 /*********************************************************************
     Name: s3g_deinitialize
 
-    Description: Deinitialization.
+    Description: Deinitialization. The state holds no resources.
 
     Document Reference: Specification of the 3GPP Confidentiality and
                             Integrity Algorithms UEA2 & UIA2 D2 v1.1
 *********************************************************************/
-void s3g_deinitialize(S3G_STATE* state)
-{
-  free(state->lfsr);
-  free(state->fsm);
-}
+void s3g_deinitialize(S3G_STATE* state) {}
 
 /*********************************************************************
     Name: s3g_generate_keystream
@@ -390,21 +314,151 @@ void s3g_deinitialize(S3G_STATE* state)
                             Integrity Algorithms UEA2 & UIA2 D2 v1.1
                             Section 4.2
 *********************************************************************/
-void s3g_generate_keystream(S3G_STATE* state, uint32_t n, uint32_t* ks)
+void s3g_generate_keystream(S3G_STATE* state, uint32_t n_words, uint32_t* ks)
+{
+  const s3g_tables_t& t = s3g_get_tables();
+  uint32_t            s[16];
+  uint32_t            n = 0;
+
+  memcpy(s, state->lfsr, sizeof(s));
+
+  // Clock FSM once and LFSR in keystream mode once. Discard the output.
+  s3g_clock<false>(s, state->fsm, t, 0);
+
+  // Note that ks[t] corresponds to z_{t+1} in section 4.2
+  for (; n + 16 <= n_words; n += 16) {
+    S3G_CLOCK_16(false, S3G_KEYSTREAM, 1);
+  }
+  uint32_t j = 1;
+  for (; n < n_words; n++, j++) {
+    ks[n] = s3g_clock<false>(s, state->fsm, t, j);
+  }
+
+  for (uint32_t i = 0; i < 16; i++) {
+    state->lfsr[i] = s[(j + i) & 15];
+  }
+}
+
+#if SRSRAN_SIMD_I_SIZE
+
+/* Table lookup of each byte of x, XOR-ed together */
+static inline simd_i_t s3g_simd_sbox(simd_i_t x, const uint32_t (*tab)[256])
+{
+  simd_i_t mask = srsran_simd_i_set1(0xff);
+  simd_i_t y    = srsran_simd_i_gather((const int*)tab[0], srsran_simd_i_srl(x, 24));
+  y = srsran_simd_i_xor(y, srsran_simd_i_gather((const int*)tab[1], srsran_simd_i_and(srsran_simd_i_srl(x, 16), mask)));
+  y = srsran_simd_i_xor(y, srsran_simd_i_gather((const int*)tab[2], srsran_simd_i_and(srsran_simd_i_srl(x, 8), mask)));
+  y = srsran_simd_i_xor(y, srsran_simd_i_gather((const int*)tab[3], srsran_simd_i_and(x, mask)));
+  return y;
+}
+
+/* Same clock as s3g_clock() over SRSRAN_SIMD_I_SIZE independent states, one per SIMD lane */
+template <bool init_mode>
+static inline simd_i_t s3g_simd_clock(simd_i_t* s, simd_i_t* fsm, const s3g_tables_t& t, uint32_t j)
+{
+#define S3G_S(i) s[(j + (i)) & 15]
+  simd_i_t f = srsran_simd_i_xor(srsran_simd_i_add(S3G_S(15), fsm[0]), fsm[1]);
+  simd_i_t r = srsran_simd_i_add(fsm[1], srsran_simd_i_xor(fsm[2], S3G_S(5)));
+  fsm[2]     = s3g_simd_sbox(fsm[1], t.s2);
+  fsm[1]     = s3g_simd_sbox(fsm[0], t.s1);
+  fsm[0]     = r;
+
+  simd_i_t z = srsran_simd_i_xor(f, S3G_S(0));
+  simd_i_t v = srsran_simd_i_xor(srsran_simd_i_sll(S3G_S(0), 8),
+                                 srsran_simd_i_gather((const int*)t.mul_alpha, srsran_simd_i_srl(S3G_S(0), 24)));
+  v          = srsran_simd_i_xor(v, srsran_simd_i_xor(S3G_S(2), srsran_simd_i_srl(S3G_S(11), 8)));
+  v          = srsran_simd_i_xor(
+      v, srsran_simd_i_gather((const int*)t.div_alpha, srsran_simd_i_and(S3G_S(11), srsran_simd_i_set1(0xff))));
+  if (init_mode) {
+    v = srsran_simd_i_xor(v, f);
+  }
+  S3G_S(0) = v;
+#undef S3G_S
+  return z;
+}
+
+/* Generates the keystreams of up to SRSRAN_SIMD_I_SIZE key/iv pairs in parallel */
+static void s3g_generate_keystream_lanes(uint32_t        nof_streams,
+                                         const uint32_t (*k)[4],
+                                         const uint32_t (*iv)[4],
+                                         const uint32_t* n_words,
+                                         uint32_t* const* ks)
+{
+  const s3g_tables_t& t = s3g_get_tables();
+  simd_i_t            s[16];
+  simd_i_t            fsm[3];
+  uint32_t            lfsr[SRSRAN_SIMD_I_SIZE][16];
+  int                 lane_words[SRSRAN_SIMD_I_SIZE] srsran_simd_aligned;
+  uint32_t            max_len = 0;
+
+  // Unused lanes run with an all-zero key
+  for (uint32_t l = 0; l < SRSRAN_SIMD_I_SIZE; l++) {
+    const uint32_t zero[4] = {};
+    s3g_load_key(lfsr[l], l < nof_streams ? k[l] : zero, l < nof_streams ? iv[l] : zero);
+    if (l < nof_streams) {
+      max_len = (n_words[l] > max_len) ? n_words[l] : max_len;
+    }
+  }
+  for (uint32_t i = 0; i < 16; i++) {
+    for (uint32_t l = 0; l < SRSRAN_SIMD_I_SIZE; l++) {
+      lane_words[l] = (int)lfsr[l][i];
+    }
+    s[i] = srsran_simd_i_load(lane_words);
+  }
+  fsm[0] = srsran_simd_i_set1(0);
+  fsm[1] = srsran_simd_i_set1(0);
+  fsm[2] = srsran_simd_i_set1(0);
+
+  for (uint32_t n = 0; n < 32; n++) {
+    s3g_simd_clock<true>(s, fsm, t, n);
+  }
+
+  // Discard the first output
+  s3g_simd_clock<false>(s, fsm, t, 0);
+
+  for (uint32_t n = 0; n < max_len; n++) {
+    srsran_simd_i_store(lane_words, s3g_simd_clock<false>(s, fsm, t, n + 1));
+    for (uint32_t l = 0; l < nof_streams; l++) {
+      if (n < n_words[l]) {
+        ks[l][n] = (uint32_t)lane_words[l];
+      }
+    }
+  }
+}
+
+#endif /* SRSRAN_SIMD_I_SIZE */
+
+/*********************************************************************
+    Name: s3g_generate_keystream_multi
+
+    Description: Generation of the keystreams of several independent
+                 key/iv pairs. Streams are processed in groups as wide
+                 as the SIMD vector, each one in a lane, so a group
+                 costs as much as its longest stream.
+
+    Document Reference: Specification of the 3GPP Confidentiality and
+                            Integrity Algorithms UEA2 & UIA2 D2 v1.1
+                            Section 4
+*********************************************************************/
+void s3g_generate_keystream_multi(uint32_t        nof_streams,
+                                  const uint32_t (*k)[4],
+                                  const uint32_t (*iv)[4],
+                                  const uint32_t* n_words,
+                                  uint32_t* const* ks)
 {
-  uint32_t t = 0;
-  uint32_t f = 0x0;
-
-  // Clock FSM once. Discard the output.
-  s3g_clock_fsm(state);
-  //  Clock LFSR in keystream mode once.
-  s3g_clock_lfsr(state, 0x0);
-
-  for (t = 0; t < n; t++) {
-    f = s3g_clock_fsm(state);
-    // Note that ks[t] corresponds to z_{t+1} in section 4.2
-    ks[t] = f ^ state->lfsr[0];
-    s3g_clock_lfsr(state, 0x0);
+  for (uint32_t i = 0; i < nof_streams;) {
+#if SRSRAN_SIMD_I_SIZE
+    uint32_t nof_lanes = (nof_streams - i < SRSRAN_SIMD_I_SIZE) ? nof_streams - i : SRSRAN_SIMD_I_SIZE;
+    if (nof_lanes > 1) {
+      s3g_generate_keystream_lanes(nof_lanes, &k[i], &iv[i], &n_words[i], &ks[i]);
+      i += nof_lanes;
+      continue;
+    }
+#endif /* SRSRAN_SIMD_I_SIZE */
+    S3G_STATE state;
+    s3g_initialize(&state, k[i], iv[i]);
+    s3g_generate_keystream(&state, n_words[i], ks[i]);
+    i++;
   }
 }
 
@@ -454,9 +508,11 @@ uint64_t s3g_MUL64(uint64_t V, uint64_t P, uint64_t c)
   uint64_t result = 0;
   int      i      = 0;
 
+  // V * x^i is obtained from V * x^(i-1) with a single MUL64x
   for (i = 0; i < 64; i++) {
     if ((P >> i) & 0x1)
-      result ^= s3g_MUL64xPOW(V, i, c);
+      result ^= V;
+    V = s3g_MUL64x(V, c);
   }
   return result;
 }
@@ -24,8 +24,12 @@
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/s3g.h"
 #include "srsran/common/ssl.h"
+#include "srsran/common/zuc.h"
 #include "srsran/config.h"
+#include <algorithm>
 #include <arpa/inet.h>
+#include <array>
+#include <vector>
 
 #define FC_EPS_K_ASME_DERIVATION 0x10
 #define FC_EPS_K_ENB_DERIVATION 0x11
@@ -885,6 +889,124 @@ uint8_t security_128_eea3(uint8_t* key,
   return liblte_security_encryption_eea3(key, count, bearer, direction, msg, msg_len * 8, msg_out);
 }
 
+/* XORs a message with a keystream of big-endian 32-bit words */
+static void security_xor_keystream(const uint32_t* ks, const uint8_t* msg, uint32_t msg_len, uint8_t* msg_out)
+{
+  uint32_t i = 0;
+  for (; i + 4 <= msg_len; i += 4) {
+    uint32_t w;
+    memcpy(&w, &msg[i], sizeof(w));
+    w ^= htonl(ks[i / 4]);
+    memcpy(&msg_out[i], &w, sizeof(w));
+  }
+  for (; i < msg_len; i++) {
+    msg_out[i] = msg[i] ^ (uint8_t)(ks[i / 4] >> (24 - 8 * (i % 4)));
+  }
+}
+
+/* Messages are ciphered in groups of a multiple of the widest SIMD vector of 32-bit lanes, so the per-message arrays
+ * live on the stack */
+#define SECURITY_MULTI_GROUP_SIZE 16
+
+/* Lays out the keystreams of a group back to back in a per-thread buffer, which only grows when a group needs more
+ * words than any previous one */
+static bool security_keystream_ptrs(const security_cipher_msg_t* msgs,
+                                    uint32_t                     nof_msgs,
+                                    uint32_t*                    ks_len,
+                                    uint32_t**                   ks_ptr)
+{
+  static thread_local std::vector<uint32_t> ks;
+
+  uint32_t total = 0;
+  for (uint32_t i = 0; i < nof_msgs; i++) {
+    if (msgs[i].key == nullptr || msgs[i].msg == nullptr || msgs[i].msg_out == nullptr) {
+      return false;
+    }
+    ks_len[i] = (msgs[i].msg_len + 3) / 4;
+    total += ks_len[i];
+  }
+  if (ks.size() < total) {
+    ks.resize(total);
+  }
+  for (uint32_t i = 0, offset = 0; i < nof_msgs; offset += ks_len[i], i++) {
+    ks_ptr[i] = ks.data() + offset;
+  }
+  return true;
+}
+
+uint8_t security_128_eea1_multi(const security_cipher_msg_t* msgs, uint32_t nof_msgs)
+{
+  for (uint32_t g = 0; g < nof_msgs; g += SECURITY_MULTI_GROUP_SIZE) {
+    const security_cipher_msg_t* group = &msgs[g];
+    uint32_t                     n     = std::min(nof_msgs - g, (uint32_t)SECURITY_MULTI_GROUP_SIZE);
+
+    uint32_t  ks_len[SECURITY_MULTI_GROUP_SIZE];
+    uint32_t* ks_ptr[SECURITY_MULTI_GROUP_SIZE];
+    if (!security_keystream_ptrs(group, n, ks_len, ks_ptr)) {
+      return SRSRAN_ERROR;
+    }
+
+    uint32_t k[SECURITY_MULTI_GROUP_SIZE][4];
+    uint32_t iv[SECURITY_MULTI_GROUP_SIZE][4];
+    for (uint32_t i = 0; i < n; i++) {
+      // Key and IV as in liblte_security_encryption_eea1()
+      for (uint32_t j = 0; j < 4; j++) {
+        const uint8_t* key = &group[i].key[4 * (3 - j)];
+        k[i][j]            = (key[0] << 24) | (key[1] << 16) | (key[2] << 8) | key[3];
+      }
+      iv[i][3] = group[i].count;
+      iv[i][2] = ((group[i].bearer & 0x1F) << 27) | ((group[i].direction & 0x01) << 26);
+      iv[i][1] = iv[i][3];
+      iv[i][0] = iv[i][2];
+    }
+
+    s3g_generate_keystream_multi(n, k, iv, ks_len, ks_ptr);
+
+    for (uint32_t i = 0; i < n; i++) {
+      security_xor_keystream(ks_ptr[i], group[i].msg, group[i].msg_len, group[i].msg_out);
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+uint8_t security_128_eea3_multi(const security_cipher_msg_t* msgs, uint32_t nof_msgs)
+{
+  for (uint32_t g = 0; g < nof_msgs; g += SECURITY_MULTI_GROUP_SIZE) {
+    const security_cipher_msg_t* group = &msgs[g];
+    uint32_t                     n     = std::min(nof_msgs - g, (uint32_t)SECURITY_MULTI_GROUP_SIZE);
+
+    uint32_t  ks_len[SECURITY_MULTI_GROUP_SIZE];
+    uint32_t* ks_ptr[SECURITY_MULTI_GROUP_SIZE];
+    if (!security_keystream_ptrs(group, n, ks_len, ks_ptr)) {
+      return SRSRAN_ERROR;
+    }
+
+    uint8_t        iv[SECURITY_MULTI_GROUP_SIZE][16];
+    const uint8_t* k_ptr[SECURITY_MULTI_GROUP_SIZE];
+    const uint8_t* iv_ptr[SECURITY_MULTI_GROUP_SIZE];
+    for (uint32_t i = 0; i < n; i++) {
+      // IV as in liblte_security_encryption_eea3()
+      uint8_t* v = iv[i];
+      v[0]       = (group[i].count >> 24) & 0xFF;
+      v[1]       = (group[i].count >> 16) & 0xFF;
+      v[2]       = (group[i].count >> 8) & 0xFF;
+      v[3]       = group[i].count & 0xFF;
+      v[4]       = ((group[i].bearer & 0x1F) << 3) | ((group[i].direction & 0x01) << 2);
+      v[5] = v[6] = v[7] = 0;
+      std::copy(v, v + 8, v + 8);
+      k_ptr[i]  = group[i].key;
+      iv_ptr[i] = v;
+    }
+
+    zuc_generate_keystream_multi(n, k_ptr, iv_ptr, ks_len, ks_ptr);
+
+    for (uint32_t i = 0; i < n; i++) {
+      security_xor_keystream(ks_ptr[i], group[i].msg, group[i].msg_len, group[i].msg_out);
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
 /******************************************************************************
  * Authentication
  *****************************************************************************/
@@ -914,6 +1036,77 @@ uint8_t security_milenage_f5_star(uint8_t* k, uint8_t* op, uint8_t* rand, uint8_
   return liblte_security_milenage_f5_star(k, op, rand, ak);
 }
 
+/// Encrypts the block formed by rotating temp ^ opc by rot bytes and XOR-ing c into its last byte, as in f2 to f5
+static void milenage_out_block(aes_context*   ctx,
+                               const uint8_t* opc,
+                               const uint8_t* temp,
+                               uint32_t       rot,
+                               uint8_t        c,
+                               uint8_t*       out)
+{
+  uint8_t input[16];
+  for (uint32_t i = 0; i < 16; i++) {
+    input[(i + 16 - rot) % 16] = temp[i] ^ opc[i];
+  }
+  input[15] ^= c;
+  aes_crypt_ecb(ctx, AES_ENCRYPT, input, out);
+  for (uint32_t i = 0; i < 16; i++) {
+    out[i] ^= opc[i];
+  }
+}
+
+uint8_t security_milenage_f12345_multi(const uint8_t*              k,
+                                       const uint8_t*              opc,
+                                       security_milenage_vector_t* vectors,
+                                       uint32_t                    nof_vectors)
+{
+  if (k == nullptr or opc == nullptr or vectors == nullptr) {
+    return SRSRAN_ERROR;
+  }
+
+  aes_context ctx;
+  aes_setkey_enc(&ctx, k, 128);
+
+  for (uint32_t n = 0; n < nof_vectors; n++) {
+    security_milenage_vector_t& v = vectors[n];
+    uint8_t                     temp[16];
+    uint8_t                     input[16];
+    uint8_t                     out[16];
+
+    // TEMP, shared by all the functions
+    for (uint32_t i = 0; i < 16; i++) {
+      input[i] = v.rand[i] ^ opc[i];
+    }
+    aes_crypt_ecb(&ctx, AES_ENCRYPT, input, temp);
+
+    // f1, with IN1 = SQN || AMF || SQN || AMF rotated by r1 = 64 bits
+    uint8_t in1[16];
+    memcpy(&in1[0], v.sqn, 6);
+    memcpy(&in1[6], v.amf, 2);
+    memcpy(&in1[8], in1, 8);
+    for (uint32_t i = 0; i < 16; i++) {
+      input[(i + 8) % 16] = in1[i] ^ opc[i];
+    }
+    for (uint32_t i = 0; i < 16; i++) {
+      input[i] ^= temp[i];
+    }
+    aes_crypt_ecb(&ctx, AES_ENCRYPT, input, out);
+    for (uint32_t i = 0; i < 8; i++) {
+      v.mac_a[i] = out[i] ^ opc[i];
+    }
+
+    // f2 and f5
+    milenage_out_block(&ctx, opc, temp, 0, 1, out);
+    memcpy(v.res, &out[8], 8);
+    memcpy(v.ak, out, 6);
+
+    // f3 and f4
+    milenage_out_block(&ctx, opc, temp, 4, 2, v.ck);
+    milenage_out_block(&ctx, opc, temp, 8, 4, v.ik);
+  }
+  return SRSRAN_SUCCESS;
+}
+
 int security_xor_f2345(uint8_t* k, uint8_t* rand, uint8_t* res, uint8_t* ck, uint8_t* ik, uint8_t* ak)
 {
   uint8_t xdout[16];
@@ -0,0 +1,373 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/security.h"
+#include "srsran/common/ssl.h"
+#include "srsran/config.h"
+#include <algorithm>
+#include <string.h>
+
+#if defined(__AES__)
+#include <immintrin.h>
+#define SECURITY_AES_X86 1
+#if defined(__VAES__) && defined(__AVX512F__)
+#define SECURITY_AES_VAES 1
+#endif
+#elif defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)
+#include <arm_neon.h>
+#define SECURITY_AES_ARM 1
+#endif
+
+namespace srsran {
+
+static const uint8_t aes_sbox[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76, 0xca, 0x82, 0xc9,
+    0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0, 0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f,
+    0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15, 0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07,
+    0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75, 0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3,
+    0x29, 0xe3, 0x2f, 0x84, 0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58,
+    0xcf, 0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8, 0x51, 0xa3,
+    0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2, 0xcd, 0x0c, 0x13, 0xec, 0x5f,
+    0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73, 0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88,
+    0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb, 0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac,
+    0x62, 0x91, 0x95, 0xe4, 0x79, 0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a,
+    0xae, 0x08, 0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a, 0x70,
+    0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e, 0xe1, 0xf8, 0x98, 0x11,
+    0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf, 0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42,
+    0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16};
+
+static const uint8_t aes_rcon[10] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36};
+
+static inline uint32_t aes_bswap32(uint32_t x)
+{
+  return __builtin_bswap32(x);
+}
+
+// Derives the CMAC subkey from the previous one as specified in RFC4493
+static void cmac_subkey(const uint8_t* in, uint8_t* out)
+{
+  for (uint32_t i = 0; i < 15; i++) {
+    out[i] = (uint8_t)((in[i] << 1) | ((in[i + 1] >> 7) & 0x01));
+  }
+  out[15] = (uint8_t)(in[15] << 1);
+  if (in[0] & 0x80) {
+    out[15] ^= 0x87;
+  }
+}
+
+security_aes128_key_t::security_aes128_key_t() = default;
+
+security_aes128_key_t::~security_aes128_key_t() = default;
+
+void security_aes128_key_t::set_key(const uint8_t* key)
+{
+  // FIPS-197 key expansion, the resulting byte layout is the one used by AES-NI and the ARMv8 AES instructions
+  memcpy(round_keys, key, 16);
+  for (uint32_t i = 4; i < 4 * NOF_ROUND_KEYS; i++) {
+    uint8_t t[4];
+    memcpy(t, &round_keys[(i - 1) * 4], 4);
+    if (i % 4 == 0) {
+      uint8_t t0 = t[0];
+      t[0]       = aes_sbox[t[1]] ^ aes_rcon[i / 4 - 1];
+      t[1]       = aes_sbox[t[2]];
+      t[2]       = aes_sbox[t[3]];
+      t[3]       = aes_sbox[t0];
+    }
+    for (uint32_t j = 0; j < 4; j++) {
+      round_keys[i * 4 + j] = round_keys[(i - 4) * 4 + j] ^ t[j];
+    }
+  }
+
+#if !defined(SECURITY_AES_X86) && !defined(SECURITY_AES_ARM)
+  if (sw_ctx == nullptr) {
+    sw_ctx = std::unique_ptr<mbedtls_aes_context>(new mbedtls_aes_context);
+  }
+  aes_setkey_enc(sw_ctx.get(), key, 128);
+#endif // !defined(SECURITY_AES_X86) && !defined(SECURITY_AES_ARM)
+
+  valid = true;
+
+  // CMAC subkeys
+  uint8_t zero[16] = {};
+  uint8_t L[16];
+  encrypt_block(zero, L);
+  cmac_subkey(L, k1);
+  cmac_subkey(k1, k2);
+}
+
+#ifdef SECURITY_AES_X86
+static inline __m128i aes_x86_encrypt(const __m128i* rk, __m128i b)
+{
+  b = _mm_xor_si128(b, rk[0]);
+  for (uint32_t r = 1; r < 10; r++) {
+    b = _mm_aesenc_si128(b, rk[r]);
+  }
+  return _mm_aesenclast_si128(b, rk[10]);
+}
+#endif // SECURITY_AES_X86
+
+#ifdef SECURITY_AES_ARM
+static inline uint8x16_t aes_arm_encrypt(const uint8x16_t* rk, uint8x16_t b)
+{
+  for (uint32_t r = 0; r < 9; r++) {
+    b = vaesmcq_u8(vaeseq_u8(b, rk[r]));
+  }
+  return veorq_u8(vaeseq_u8(b, rk[9]), rk[10]);
+}
+#endif // SECURITY_AES_ARM
+
+void security_aes128_key_t::encrypt_block(const uint8_t* in, uint8_t* out) const
+{
+#if defined(SECURITY_AES_X86)
+  __m128i rk[NOF_ROUND_KEYS];
+  for (uint32_t r = 0; r < NOF_ROUND_KEYS; r++) {
+    rk[r] = _mm_load_si128((const __m128i*)&round_keys[r * 16]);
+  }
+  _mm_storeu_si128((__m128i*)out, aes_x86_encrypt(rk, _mm_loadu_si128((const __m128i*)in)));
+#elif defined(SECURITY_AES_ARM)
+  uint8x16_t rk[NOF_ROUND_KEYS];
+  for (uint32_t r = 0; r < NOF_ROUND_KEYS; r++) {
+    rk[r] = vld1q_u8(&round_keys[r * 16]);
+  }
+  vst1q_u8(out, aes_arm_encrypt(rk, vld1q_u8(in)));
+#else
+  aes_crypt_ecb(sw_ctx.get(), AES_ENCRYPT, in, out);
+#endif
+}
+
+void security_aes128_key_t::crypt_ctr(const uint8_t* nonce_cnt, const uint8_t* in, uint32_t len, uint8_t* out) const
+{
+  // The counter is incremented in the last 32 bits, which is enough for any PDCP/NAS message size
+  uint32_t w[4];
+  memcpy(w, nonce_cnt, 16);
+  uint32_t cnt  = aes_bswap32(w[3]);
+  uint32_t nblk = len / 16;
+  uint32_t i    = 0;
+
+#if defined(SECURITY_AES_X86)
+  __m128i rk[NOF_ROUND_KEYS];
+  for (uint32_t r = 0; r < NOF_ROUND_KEYS; r++) {
+    rk[r] = _mm_load_si128((const __m128i*)&round_keys[r * 16]);
+  }
+
+#ifdef SECURITY_AES_VAES
+  // 16 blocks per iteration, 4 blocks per instruction
+  __m512i rk512[NOF_ROUND_KEYS];
+  for (uint32_t r = 0; r < NOF_ROUND_KEYS; r++) {
+    rk512[r] = _mm512_maskz_broadcast_i32x4(0xffff, rk[r]);
+  }
+  for (; i + 16 <= nblk; i += 16) {
+    __m512i b[4];
+    for (uint32_t k = 0; k < 4; k++) {
+      uint32_t c = cnt + i + 4 * k;
+      b[k]       = _mm512_set_epi32((int)aes_bswap32(c + 3),
+                              (int)w[2],
+                              (int)w[1],
+                              (int)w[0],
+                              (int)aes_bswap32(c + 2),
+                              (int)w[2],
+                              (int)w[1],
+                              (int)w[0],
+                              (int)aes_bswap32(c + 1),
+                              (int)w[2],
+                              (int)w[1],
+                              (int)w[0],
+                              (int)aes_bswap32(c),
+                              (int)w[2],
+                              (int)w[1],
+                              (int)w[0]);
+      b[k]       = _mm512_xor_si512(b[k], rk512[0]);
+    }
+    for (uint32_t r = 1; r < 10; r++) {
+      for (uint32_t k = 0; k < 4; k++) {
+        b[k] = _mm512_aesenc_epi128(b[k], rk512[r]);
+      }
+    }
+    for (uint32_t k = 0; k < 4; k++) {
+      b[k]      = _mm512_aesenclast_epi128(b[k], rk512[10]);
+      __m512i x = _mm512_loadu_si512((const void*)&in[(i + 4 * k) * 16]);
+      _mm512_storeu_si512((void*)&out[(i + 4 * k) * 16], _mm512_xor_si512(x, b[k]));
+    }
+  }
+#endif // SECURITY_AES_VAES
+
+  // 8 blocks per iteration so the AES rounds of independent blocks are pipelined
+  for (; i + 8 <= nblk; i += 8) {
+    __m128i b[8];
+    for (uint32_t k = 0; k < 8; k++) {
+      b[k] = _mm_xor_si128(_mm_set_epi32((int)aes_bswap32(cnt + i + k), (int)w[2], (int)w[1], (int)w[0]), rk[0]);
+    }
+    for (uint32_t r = 1; r < 10; r++) {
+      for (uint32_t k = 0; k < 8; k++) {
+        b[k] = _mm_aesenc_si128(b[k], rk[r]);
+      }
+    }
+    for (uint32_t k = 0; k < 8; k++) {
+      b[k]      = _mm_aesenclast_si128(b[k], rk[10]);
+      __m128i x = _mm_loadu_si128((const __m128i*)&in[(i + k) * 16]);
+      _mm_storeu_si128((__m128i*)&out[(i + k) * 16], _mm_xor_si128(x, b[k]));
+    }
+  }
+
+  for (; i < nblk; i++) {
+    __m128i b = aes_x86_encrypt(rk, _mm_set_epi32((int)aes_bswap32(cnt + i), (int)w[2], (int)w[1], (int)w[0]));
+    __m128i x = _mm_loadu_si128((const __m128i*)&in[i * 16]);
+    _mm_storeu_si128((__m128i*)&out[i * 16], _mm_xor_si128(x, b));
+  }
+#elif defined(SECURITY_AES_ARM)
+  uint8x16_t rk[NOF_ROUND_KEYS];
+  for (uint32_t r = 0; r < NOF_ROUND_KEYS; r++) {
+    rk[r] = vld1q_u8(&round_keys[r * 16]);
+  }
+
+  // 4 blocks per iteration so the AES rounds of independent blocks are pipelined
+  for (; i + 4 <= nblk; i += 4) {
+    uint8x16_t b[4];
+    for (uint32_t k = 0; k < 4; k++) {
+      uint32_t ctr[4] = {w[0], w[1], w[2], aes_bswap32(cnt + i + k)};
+      b[k]            = vreinterpretq_u8_u32(vld1q_u32(ctr));
+    }
+    for (uint32_t r = 0; r < 9; r++) {
+      for (uint32_t k = 0; k < 4; k++) {
+        b[k] = vaesmcq_u8(vaeseq_u8(b[k], rk[r]));
+      }
+    }
+    for (uint32_t k = 0; k < 4; k++) {
+      b[k] = veorq_u8(vaeseq_u8(b[k], rk[9]), rk[10]);
+      vst1q_u8(&out[(i + k) * 16], veorq_u8(vld1q_u8(&in[(i + k) * 16]), b[k]));
+    }
+  }
+
+  for (; i < nblk; i++) {
+    uint32_t   ctr[4] = {w[0], w[1], w[2], aes_bswap32(cnt + i)};
+    uint8x16_t b      = aes_arm_encrypt(rk, vreinterpretq_u8_u32(vld1q_u32(ctr)));
+    vst1q_u8(&out[i * 16], veorq_u8(vld1q_u8(&in[i * 16]), b));
+  }
+#else
+  for (; i < nblk; i++) {
+    uint32_t ctr[4] = {w[0], w[1], w[2], aes_bswap32(cnt + i)};
+    uint8_t  ks[16];
+    encrypt_block((const uint8_t*)ctr, ks);
+    for (uint32_t k = 0; k < 16; k++) {
+      out[i * 16 + k] = in[i * 16 + k] ^ ks[k];
+    }
+  }
+#endif
+
+  // Last partial block
+  uint32_t rem = len - nblk * 16;
+  if (rem > 0) {
+    uint32_t ctr[4] = {w[0], w[1], w[2], aes_bswap32(cnt + nblk)};
+    uint8_t  ks[16];
+    encrypt_block((const uint8_t*)ctr, ks);
+    for (uint32_t k = 0; k < rem; k++) {
+      out[nblk * 16 + k] = in[nblk * 16 + k] ^ ks[k];
+    }
+  }
+}
+
+uint8_t security_128_eia2(const security_aes128_key_t& key,
+                          uint32_t                     count,
+                          uint32_t                     bearer,
+                          uint8_t                      direction,
+                          const uint8_t*               msg,
+                          uint32_t                     msg_len,
+                          uint8_t*                     mac)
+{
+  if (not key.is_set() or (msg == nullptr and msg_len > 0) or mac == nullptr) {
+    return SRSRAN_ERROR;
+  }
+
+  // The CMAC input is COUNT | BEARER | DIRECTION | 0 (8 bytes) followed by the message, it is read in place
+  uint8_t hdr[8] = {};
+  hdr[0]         = (count >> 24) & 0xFF;
+  hdr[1]         = (count >> 16) & 0xFF;
+  hdr[2]         = (count >> 8) & 0xFF;
+  hdr[3]         = count & 0xFF;
+  hdr[4]         = (uint8_t)((bearer << 3) | (direction << 2));
+
+  uint32_t total = msg_len + 8;
+  uint32_t n     = (total + 15) / 16;
+  uint8_t  T[16] = {};
+  uint8_t  blk[16];
+
+  for (uint32_t i = 0; i < n; i++) {
+    uint32_t offset = i * 16;
+    uint32_t len    = std::min(16u, total - offset);
+
+    if (offset >= 8 and len == 16 and i < n - 1) {
+      // Full block entirely in the message
+      const uint8_t* m = &msg[offset - 8];
+      for (uint32_t k = 0; k < 16; k++) {
+        blk[k] = T[k] ^ m[k];
+      }
+    } else {
+      // First and last blocks, assembled byte by byte
+      for (uint32_t k = 0; k < 16; k++) {
+        uint32_t pos = offset + k;
+        uint8_t  v   = 0;
+        if (k < len) {
+          v = pos < 8 ? hdr[pos] : msg[pos - 8];
+        } else if (k == len) {
+          v = 0x80;
+        }
+        blk[k] = T[k] ^ v;
+      }
+      if (i == n - 1) {
+        const uint8_t* sk = (len == 16) ? key.get_k1() : key.get_k2();
+        for (uint32_t k = 0; k < 16; k++) {
+          blk[k] ^= sk[k];
+        }
+      }
+    }
+    key.encrypt_block(blk, T);
+  }
+
+  memcpy(mac, T, 4);
+
+  return SRSRAN_SUCCESS;
+}
+
+uint8_t security_128_eea2(const security_aes128_key_t& key,
+                          uint32_t                     count,
+                          uint8_t                      bearer,
+                          uint8_t                      direction,
+                          const uint8_t*               msg,
+                          uint32_t                     msg_len,
+                          uint8_t*                     msg_out)
+{
+  if (not key.is_set() or msg == nullptr or msg_out == nullptr) {
+    return SRSRAN_ERROR;
+  }
+
+  uint8_t nonce_cnt[16] = {};
+  nonce_cnt[0]          = (count >> 24) & 0xFF;
+  nonce_cnt[1]          = (count >> 16) & 0xFF;
+  nonce_cnt[2]          = (count >> 8) & 0xFF;
+  nonce_cnt[3]          = count & 0xFF;
+  nonce_cnt[4]          = (uint8_t)(((bearer & 0x1F) << 3) | ((direction & 0x01) << 2));
+
+  key.crypt_ctr(nonce_cnt, msg, msg_len, msg_out);
+
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsran
@@ -30,10 +30,13 @@
 ---------------------------------------------------------*/
 
 #include "srsran/common/zuc.h"
+#include "srsran/phy/utils/simd.h"
 
 #define MAKEU32(a, b, c, d) (((u32)(a) << 24) | ((u32)(b) << 16) | ((u32)(c) << 8) | ((u32)(d)))
 #define MulByPow2(x, k) ((((x) << k) | ((x) >> (31 - k))) & 0x7FFFFFFF)
 #define MAKEU31(a, b, c) (((u32)(a) << 23) | ((u32)(b) << 8) | (u32)(c))
+typedef unsigned long long u64;
+
 #define ROT(a, k) (((a) << k) | ((a) >> (32 - k)))
 
 /* the s-boxes */
@@ -87,168 +90,336 @@ static const u32 EK_d[16] = {0x44D7,
                              0x789A,
                              0x47AC};
 
+/* the s-boxes of F as 32-bit words in the byte position they are used, so that the new F_R1 and F_R2 are each the OR
+ * of four lookups. They are also the tables gathered by the multi-lane generator. */
+typedef struct {
+  u32 T[4][256];
+} zuc_tables_t;
+
+static const zuc_tables_t& zuc_get_tables()
+{
+  static const zuc_tables_t tables = []() {
+    zuc_tables_t t = {};
+    for (u32 i = 0; i < 256; i++) {
+      t.T[0][i] = (u32)S0[i] << 24;
+      t.T[1][i] = (u32)S1[i] << 16;
+      t.T[2][i] = (u32)S0[i] << 8;
+      t.T[3][i] = (u32)S1[i];
+    }
+    return t;
+  }();
+  return tables;
+}
+
 /* ——————————————————————- */
 /* c = a + b mod (2^31 – 1) */
-u32 AddM(u32 a, u32 b)
+static inline u32 AddM(u32 a, u32 b)
 {
   u32 c = a + b;
   return (c & 0x7FFFFFFF) + (c >> 31);
 }
 
-/* LFSR with initialization mode */
-void LFSRWithInitialisationMode(zuc_state_t* state, u32 u)
-{
-  u32 f, v;
-  f = state->LFSR_S0;
-  v = MulByPow2(state->LFSR_S0, 8);
-  f = AddM(f, v);
-  v = MulByPow2(state->LFSR_S4, 20);
-  f = AddM(f, v);
-  v = MulByPow2(state->LFSR_S10, 21);
-  f = AddM(f, v);
-  v = MulByPow2(state->LFSR_S13, 17);
-  f = AddM(f, v);
-  v = MulByPow2(state->LFSR_S15, 15);
-  f = AddM(f, v);
-  f = AddM(f, u);
-
-  /* update the state */
-  state->LFSR_S0  = state->LFSR_S1;
-  state->LFSR_S1  = state->LFSR_S2;
-  state->LFSR_S2  = state->LFSR_S3;
-  state->LFSR_S3  = state->LFSR_S4;
-  state->LFSR_S4  = state->LFSR_S5;
-  state->LFSR_S5  = state->LFSR_S6;
-  state->LFSR_S6  = state->LFSR_S7;
-  state->LFSR_S7  = state->LFSR_S8;
-  state->LFSR_S8  = state->LFSR_S9;
-  state->LFSR_S9  = state->LFSR_S10;
-  state->LFSR_S10 = state->LFSR_S11;
-  state->LFSR_S11 = state->LFSR_S12;
-  state->LFSR_S12 = state->LFSR_S13;
-  state->LFSR_S13 = state->LFSR_S14;
-  state->LFSR_S14 = state->LFSR_S15;
-  state->LFSR_S15 = f;
-}
-
-/* LFSR with work mode */
-void LFSRWithWorkMode(zuc_state_t* state)
-{
-  u32 f, v;
-  f = state->LFSR_S0;
-  v = MulByPow2(state->LFSR_S0, 8);
-  f = AddM(f, v);
-  v = MulByPow2(state->LFSR_S4, 20);
-  f = AddM(f, v);
-  v = MulByPow2(state->LFSR_S10, 21);
-  f = AddM(f, v);
-  v = MulByPow2(state->LFSR_S13, 17);
-  f = AddM(f, v);
-  v = MulByPow2(state->LFSR_S15, 15);
-  f = AddM(f, v);
-
-  /* update the state */
-  state->LFSR_S0  = state->LFSR_S1;
-  state->LFSR_S1  = state->LFSR_S2;
-  state->LFSR_S2  = state->LFSR_S3;
-  state->LFSR_S3  = state->LFSR_S4;
-  state->LFSR_S4  = state->LFSR_S5;
-  state->LFSR_S5  = state->LFSR_S6;
-  state->LFSR_S6  = state->LFSR_S7;
-  state->LFSR_S7  = state->LFSR_S8;
-  state->LFSR_S8  = state->LFSR_S9;
-  state->LFSR_S9  = state->LFSR_S10;
-  state->LFSR_S10 = state->LFSR_S11;
-  state->LFSR_S11 = state->LFSR_S12;
-  state->LFSR_S12 = state->LFSR_S13;
-  state->LFSR_S13 = state->LFSR_S14;
-  state->LFSR_S14 = state->LFSR_S15;
-  state->LFSR_S15 = f;
-}
-
-/* BitReorganization */
-void BitReorganization(zuc_state_t* state)
-{
-  state->BRC_X0 = ((state->LFSR_S15 & 0x7FFF8000) << 1) | (state->LFSR_S14 & 0xFFFF);
-  state->BRC_X1 = ((state->LFSR_S11 & 0xFFFF) << 16) | (state->LFSR_S9 >> 15);
-  state->BRC_X2 = ((state->LFSR_S7 & 0xFFFF) << 16) | (state->LFSR_S5 >> 15);
-  state->BRC_X3 = ((state->LFSR_S2 & 0xFFFF) << 16) | (state->LFSR_S0 >> 15);
-}
-
 /* L1 */
-u32 L1(u32 X)
+static inline u32 L1(u32 X)
 {
   return (X ^ ROT(X, 2) ^ ROT(X, 10) ^ ROT(X, 18) ^ ROT(X, 24));
 }
 
 /* L2 */
-u32 L2(u32 X)
+static inline u32 L2(u32 X)
 {
   return (X ^ ROT(X, 8) ^ ROT(X, 14) ^ ROT(X, 22) ^ ROT(X, 30));
 }
 
-/* F */
-u32 F(zuc_state_t* state)
+/* One clock of the cipher: BitReorganization, F and the LFSR update. The LFSR is kept as a ring of 16 words where
+ * s[(j + i) & 15] is LFSR_Si, so the update overwrites the oldest word instead of shifting all of them. With a
+ * constant j all the ring indexes are resolved at compile time. Returns the keystream word Z = W ^ X3; in
+ * initialisation mode W >> 1 is fed back into the LFSR instead. */
+template <bool init_mode>
+static inline u32 zuc_clock(u32* s, u32& r1, u32& r2, const zuc_tables_t& t, u32 j)
+{
+#define ZS(i) s[(j + (i)) & 15]
+  /* BitReorganization */
+  u32 x0 = ((ZS(15) & 0x7FFF8000) << 1) | (ZS(14) & 0xFFFF);
+  u32 x1 = ((ZS(11) & 0xFFFF) << 16) | (ZS(9) >> 15);
+  u32 x2 = ((ZS(7) & 0xFFFF) << 16) | (ZS(5) >> 15);
+  u32 x3 = ((ZS(2) & 0xFFFF) << 16) | (ZS(0) >> 15);
+
+  /* F */
+  u32 w  = (x0 ^ r1) + r2;
+  u32 w1 = r1 + x1;
+  u32 w2 = r2 ^ x2;
+  u32 u  = L1((w1 << 16) | (w2 >> 16));
+  u32 v  = L2((w2 << 16) | (w1 >> 16));
+  r1     = t.T[0][u >> 24] | t.T[1][(u >> 16) & 0xFF] | t.T[2][(u >> 8) & 0xFF] | t.T[3][u & 0xFF];
+  r2     = t.T[0][v >> 24] | t.T[1][(v >> 16) & 0xFF] | t.T[2][(v >> 8) & 0xFF] | t.T[3][v & 0xFF];
+
+  /* LFSR, the terms are added as 64-bit integers and reduced mod (2^31 - 1) at the end, which gives the same result
+   * as the chain of AddM with a shorter dependency chain */
+  u64 f = (u64)ZS(0) + MulByPow2(ZS(0), 8) + MulByPow2(ZS(4), 20) + MulByPow2(ZS(10), 21) + MulByPow2(ZS(13), 17) +
+          MulByPow2(ZS(15), 15);
+  if (init_mode) {
+    f += w >> 1;
+  }
+  f     = (f & 0x7FFFFFFF) + (f >> 31);
+  ZS(0) = AddM((u32)f & 0x7FFFFFFF, (u32)(f >> 31));
+#undef ZS
+  return w ^ x3;
+}
+
+/* 16 clocks starting at ring position j, which leaves the ring back at position j */
+#define ZUC_CLOCK_16(MODE, OUT, J)                                                                                     \
+  do {                                                                                                                 \
+    OUT(0) zuc_clock<MODE>(s, r1, r2, t, (J) + 0);                                                                     \
+    OUT(1) zuc_clock<MODE>(s, r1, r2, t, (J) + 1);                                                                     \
+    OUT(2) zuc_clock<MODE>(s, r1, r2, t, (J) + 2);                                                                     \
+    OUT(3) zuc_clock<MODE>(s, r1, r2, t, (J) + 3);                                                                     \
+    OUT(4) zuc_clock<MODE>(s, r1, r2, t, (J) + 4);                                                                     \
+    OUT(5) zuc_clock<MODE>(s, r1, r2, t, (J) + 5);                                                                     \
+    OUT(6) zuc_clock<MODE>(s, r1, r2, t, (J) + 6);                                                                     \
+    OUT(7) zuc_clock<MODE>(s, r1, r2, t, (J) + 7);                                                                     \
+    OUT(8) zuc_clock<MODE>(s, r1, r2, t, (J) + 8);                                                                     \
+    OUT(9) zuc_clock<MODE>(s, r1, r2, t, (J) + 9);                                                                     \
+    OUT(10) zuc_clock<MODE>(s, r1, r2, t, (J) + 10);                                                                   \
+    OUT(11) zuc_clock<MODE>(s, r1, r2, t, (J) + 11);                                                                   \
+    OUT(12) zuc_clock<MODE>(s, r1, r2, t, (J) + 12);                                                                   \
+    OUT(13) zuc_clock<MODE>(s, r1, r2, t, (J) + 13);                                                                   \
+    OUT(14) zuc_clock<MODE>(s, r1, r2, t, (J) + 14);                                                                   \
+    OUT(15) zuc_clock<MODE>(s, r1, r2, t, (J) + 15);                                                                   \
+  } while (0)
+#define ZUC_DISCARD(i)
+#define ZUC_KEYSTREAM(i) p_keystream[n + (i)] =
+
+static void zuc_load(const zuc_state_t* state, u32* s)
+{
+  s[0]  = state->LFSR_S0;
+  s[1]  = state->LFSR_S1;
+  s[2]  = state->LFSR_S2;
+  s[3]  = state->LFSR_S3;
+  s[4]  = state->LFSR_S4;
+  s[5]  = state->LFSR_S5;
+  s[6]  = state->LFSR_S6;
+  s[7]  = state->LFSR_S7;
+  s[8]  = state->LFSR_S8;
+  s[9]  = state->LFSR_S9;
+  s[10] = state->LFSR_S10;
+  s[11] = state->LFSR_S11;
+  s[12] = state->LFSR_S12;
+  s[13] = state->LFSR_S13;
+  s[14] = state->LFSR_S14;
+  s[15] = state->LFSR_S15;
+}
+
+/* stores the ring back into the state, rotated so that position j becomes LFSR_S0 */
+static void zuc_store(zuc_state_t* state, const u32* s, u32 j)
 {
-  u32 W, W1, W2, u, v;
-  W  = (state->BRC_X0 ^ state->F_R1) + state->F_R2;
-  W1 = state->F_R1 + state->BRC_X1;
-  W2 = state->F_R2 ^ state->BRC_X2;
-  u  = L1((W1 << 16) | (W2 >> 16));
-  v  = L2((W2 << 16) | (W1 >> 16));
+  state->LFSR_S0  = s[(j + 0) & 15];
+  state->LFSR_S1  = s[(j + 1) & 15];
+  state->LFSR_S2  = s[(j + 2) & 15];
+  state->LFSR_S3  = s[(j + 3) & 15];
+  state->LFSR_S4  = s[(j + 4) & 15];
+  state->LFSR_S5  = s[(j + 5) & 15];
+  state->LFSR_S6  = s[(j + 6) & 15];
+  state->LFSR_S7  = s[(j + 7) & 15];
+  state->LFSR_S8  = s[(j + 8) & 15];
+  state->LFSR_S9  = s[(j + 9) & 15];
+  state->LFSR_S10 = s[(j + 10) & 15];
+  state->LFSR_S11 = s[(j + 11) & 15];
+  state->LFSR_S12 = s[(j + 12) & 15];
+  state->LFSR_S13 = s[(j + 13) & 15];
+  state->LFSR_S14 = s[(j + 14) & 15];
+  state->LFSR_S15 = s[(j + 15) & 15];
 
-  state->F_R1 = MAKEU32(S0[u >> 24], S1[(u >> 16) & 0xFF], S0[(u >> 8) & 0xFF], S1[u & 0xFF]);
-  state->F_R2 = MAKEU32(S0[v >> 24], S1[(v >> 16) & 0xFF], S0[(v >> 8) & 0xFF], S1[v & 0xFF]);
-  return W;
+  /* outputs of the last BitReorganization, kept for compatibility with the reference state */
+  state->BRC_X0 = ((state->LFSR_S15 & 0x7FFF8000) << 1) | (state->LFSR_S14 & 0xFFFF);
+  state->BRC_X1 = ((state->LFSR_S11 & 0xFFFF) << 16) | (state->LFSR_S9 >> 15);
+  state->BRC_X2 = ((state->LFSR_S7 & 0xFFFF) << 16) | (state->LFSR_S5 >> 15);
+  state->BRC_X3 = ((state->LFSR_S2 & 0xFFFF) << 16) | (state->LFSR_S0 >> 15);
 }
 
 /* initialize */
 
-void zuc_initialize(zuc_state_t* state, const u8* k, u8* iv)
+void zuc_initialize(zuc_state_t* state, const u8* k, const u8* iv)
 {
-  u32 w, nCount;
+  const zuc_tables_t& t = zuc_get_tables();
+  u32                 s[16];
+  u32                 r1 = 0, r2 = 0;
 
   /* expand key */
-  state->LFSR_S0  = MAKEU31(k[0], EK_d[0], iv[0]);
-  state->LFSR_S1  = MAKEU31(k[1], EK_d[1], iv[1]);
-  state->LFSR_S2  = MAKEU31(k[2], EK_d[2], iv[2]);
-  state->LFSR_S3  = MAKEU31(k[3], EK_d[3], iv[3]);
-  state->LFSR_S4  = MAKEU31(k[4], EK_d[4], iv[4]);
-  state->LFSR_S5  = MAKEU31(k[5], EK_d[5], iv[5]);
-  state->LFSR_S6  = MAKEU31(k[6], EK_d[6], iv[6]);
-  state->LFSR_S7  = MAKEU31(k[7], EK_d[7], iv[7]);
-  state->LFSR_S8  = MAKEU31(k[8], EK_d[8], iv[8]);
-  state->LFSR_S9  = MAKEU31(k[9], EK_d[9], iv[9]);
-  state->LFSR_S10 = MAKEU31(k[10], EK_d[10], iv[10]);
-  state->LFSR_S11 = MAKEU31(k[11], EK_d[11], iv[11]);
-  state->LFSR_S12 = MAKEU31(k[12], EK_d[12], iv[12]);
-  state->LFSR_S13 = MAKEU31(k[13], EK_d[13], iv[13]);
-  state->LFSR_S14 = MAKEU31(k[14], EK_d[14], iv[14]);
-  state->LFSR_S15 = MAKEU31(k[15], EK_d[15], iv[15]);
-
-  /* set F_R1 and F_R2 to zero */
-  state->F_R1 = 0;
-  state->F_R2 = 0;
-  nCount      = 32;
-  while (nCount > 0) {
-    BitReorganization(state);
-    w = F(state);
-    LFSRWithInitialisationMode(state, w >> 1);
-    nCount--;
+  for (u32 i = 0; i < 16; i++) {
+    s[i] = MAKEU31(k[i], EK_d[i], iv[i]);
   }
+
+  /* 32 clocks in initialisation mode */
+  ZUC_CLOCK_16(true, ZUC_DISCARD, 0);
+  ZUC_CLOCK_16(true, ZUC_DISCARD, 0);
+
+  state->F_R1 = r1;
+  state->F_R2 = r2;
+  zuc_store(state, s, 0);
 }
 
 void zuc_generate_keystream(zuc_state_t* state, int key_stream_len, u32* p_keystream)
 {
-  int i;
-  {
-    BitReorganization(state);
-    F(state); /* discard the output of F */
-    LFSRWithWorkMode(state);
+  const zuc_tables_t& t = zuc_get_tables();
+  u32                 s[16];
+  u32                 r1 = state->F_R1;
+  u32                 r2 = state->F_R2;
+  int                 n  = 0;
+
+  zuc_load(state, s);
+
+  /* discard the output of F, the ring is left at position 1 */
+  zuc_clock<false>(s, r1, r2, t, 0);
+
+  for (; n + 16 <= key_stream_len; n += 16) {
+    ZUC_CLOCK_16(false, ZUC_KEYSTREAM, 1);
+  }
+  u32 j = 1;
+  for (; n < key_stream_len; n++, j++) {
+    p_keystream[n] = zuc_clock<false>(s, r1, r2, t, j);
+  }
+
+  state->F_R1 = r1;
+  state->F_R2 = r2;
+  zuc_store(state, s, j);
+}
+
+#if SRSRAN_SIMD_I_SIZE
+
+/* Same clock as zuc_clock() over SRSRAN_SIMD_I_SIZE independent states, one per SIMD lane */
+static inline simd_i_t zuc_simd_addm(simd_i_t a, simd_i_t b)
+{
+  simd_i_t c = srsran_simd_i_add(a, b);
+  return srsran_simd_i_add(srsran_simd_i_and(c, srsran_simd_i_set1(0x7FFFFFFF)), srsran_simd_i_srl(c, 31));
+}
+
+static inline simd_i_t zuc_simd_mul_pow2(simd_i_t x, int k)
+{
+  return srsran_simd_i_and(srsran_simd_i_or(srsran_simd_i_sll(x, k), srsran_simd_i_srl(x, 31 - k)),
+                           srsran_simd_i_set1(0x7FFFFFFF));
+}
+
+static inline simd_i_t zuc_simd_rot(simd_i_t x, int k)
+{
+  return srsran_simd_i_or(srsran_simd_i_sll(x, k), srsran_simd_i_srl(x, 32 - k));
+}
+
+static inline simd_i_t zuc_simd_sbox(simd_i_t x, const zuc_tables_t& t)
+{
+  simd_i_t mask = srsran_simd_i_set1(0xFF);
+  simd_i_t y    = srsran_simd_i_gather((const int*)t.T[0], srsran_simd_i_srl(x, 24));
+  y = srsran_simd_i_or(y, srsran_simd_i_gather((const int*)t.T[1], srsran_simd_i_and(srsran_simd_i_srl(x, 16), mask)));
+  y = srsran_simd_i_or(y, srsran_simd_i_gather((const int*)t.T[2], srsran_simd_i_and(srsran_simd_i_srl(x, 8), mask)));
+  y = srsran_simd_i_or(y, srsran_simd_i_gather((const int*)t.T[3], srsran_simd_i_and(x, mask)));
+  return y;
+}
+
+template <bool init_mode>
+static inline simd_i_t zuc_simd_clock(simd_i_t* s, simd_i_t& r1, simd_i_t& r2, const zuc_tables_t& t, u32 j)
+{
+#define ZS(i) s[(j + (i)) & 15]
+  simd_i_t lo16 = srsran_simd_i_set1(0xFFFF);
+
+  /* BitReorganization */
+  simd_i_t x0 = srsran_simd_i_or(srsran_simd_i_sll(srsran_simd_i_and(ZS(15), srsran_simd_i_set1(0x7FFF8000)), 1),
+                                 srsran_simd_i_and(ZS(14), lo16));
+  simd_i_t x1 = srsran_simd_i_or(srsran_simd_i_sll(ZS(11), 16), srsran_simd_i_srl(ZS(9), 15));
+  simd_i_t x2 = srsran_simd_i_or(srsran_simd_i_sll(ZS(7), 16), srsran_simd_i_srl(ZS(5), 15));
+  simd_i_t x3 = srsran_simd_i_or(srsran_simd_i_sll(ZS(2), 16), srsran_simd_i_srl(ZS(0), 15));
+
+  /* F */
+  simd_i_t w  = srsran_simd_i_add(srsran_simd_i_xor(x0, r1), r2);
+  simd_i_t w1 = srsran_simd_i_add(r1, x1);
+  simd_i_t w2 = srsran_simd_i_xor(r2, x2);
+  simd_i_t u  = srsran_simd_i_or(srsran_simd_i_sll(w1, 16), srsran_simd_i_srl(w2, 16));
+  simd_i_t v  = srsran_simd_i_or(srsran_simd_i_sll(w2, 16), srsran_simd_i_srl(w1, 16));
+  u           = srsran_simd_i_xor(srsran_simd_i_xor(srsran_simd_i_xor(u, zuc_simd_rot(u, 2)),
+                                      srsran_simd_i_xor(zuc_simd_rot(u, 10), zuc_simd_rot(u, 18))),
+                        zuc_simd_rot(u, 24));
+  v           = srsran_simd_i_xor(srsran_simd_i_xor(srsran_simd_i_xor(v, zuc_simd_rot(v, 8)),
+                                      srsran_simd_i_xor(zuc_simd_rot(v, 14), zuc_simd_rot(v, 22))),
+                        zuc_simd_rot(v, 30));
+  r1          = zuc_simd_sbox(u, t);
+  r2          = zuc_simd_sbox(v, t);
+
+  /* LFSR */
+  simd_i_t f = ZS(0);
+  f          = zuc_simd_addm(f, zuc_simd_mul_pow2(ZS(0), 8));
+  f          = zuc_simd_addm(f, zuc_simd_mul_pow2(ZS(4), 20));
+  f          = zuc_simd_addm(f, zuc_simd_mul_pow2(ZS(10), 21));
+  f          = zuc_simd_addm(f, zuc_simd_mul_pow2(ZS(13), 17));
+  f          = zuc_simd_addm(f, zuc_simd_mul_pow2(ZS(15), 15));
+  if (init_mode) {
+    f = zuc_simd_addm(f, srsran_simd_i_srl(w, 1));
+  }
+  ZS(0) = f;
+#undef ZS
+  return srsran_simd_i_xor(w, x3);
+}
+
+/* Generates the keystreams of up to SRSRAN_SIMD_I_SIZE key/iv pairs in parallel */
+static void zuc_generate_keystream_lanes(u32                      nof_streams,
+                                         const u8* const*         k,
+                                         const u8* const*         iv,
+                                         const u32*               key_stream_len,
+                                         u32* const*              p_keystream)
+{
+  const zuc_tables_t& t = zuc_get_tables();
+  simd_i_t            s[16];
+  int                 lane_words[SRSRAN_SIMD_I_SIZE] srsran_simd_aligned;
+  u32                 max_len = 0;
+
+  /* expand keys, unused lanes run with an all-zero key */
+  for (u32 i = 0; i < 16; i++) {
+    for (u32 l = 0; l < SRSRAN_SIMD_I_SIZE; l++) {
+      lane_words[l] = (l < nof_streams) ? MAKEU31(k[l][i], EK_d[i], iv[l][i]) : MAKEU31(0, EK_d[i], 0);
+    }
+    s[i] = srsran_simd_i_load(lane_words);
   }
-  for (i = 0; i < key_stream_len; i++) {
-    BitReorganization(state);
-    p_keystream[i] = F(state) ^ state->BRC_X3;
-    LFSRWithWorkMode(state);
+  for (u32 l = 0; l < nof_streams; l++) {
+    max_len = (key_stream_len[l] > max_len) ? key_stream_len[l] : max_len;
+  }
+
+  simd_i_t r1 = srsran_simd_i_set1(0);
+  simd_i_t r2 = srsran_simd_i_set1(0);
+  for (u32 n = 0; n < 32; n++) {
+    zuc_simd_clock<true>(s, r1, r2, t, n);
+  }
+
+  /* discard the output of F */
+  zuc_simd_clock<false>(s, r1, r2, t, 0);
+
+  for (u32 n = 0; n < max_len; n++) {
+    srsran_simd_i_store(lane_words, zuc_simd_clock<false>(s, r1, r2, t, n + 1));
+    for (u32 l = 0; l < nof_streams; l++) {
+      if (n < key_stream_len[l]) {
+        p_keystream[l][n] = (u32)lane_words[l];
+      }
+    }
+  }
+}
+
+#endif /* SRSRAN_SIMD_I_SIZE */
+
+void zuc_generate_keystream_multi(u32              nof_streams,
+                                  const u8* const* k,
+                                  const u8* const* iv,
+                                  const u32*       key_stream_len,
+                                  u32* const*      p_keystream)
+{
+  for (u32 i = 0; i < nof_streams;) {
+#if SRSRAN_SIMD_I_SIZE
+    u32 nof_lanes = (nof_streams - i < SRSRAN_SIMD_I_SIZE) ? nof_streams - i : SRSRAN_SIMD_I_SIZE;
+    if (nof_lanes > 1) {
+      zuc_generate_keystream_lanes(nof_lanes, &k[i], &iv[i], &key_stream_len[i], &p_keystream[i]);
+      i += nof_lanes;
+      continue;
+    }
+#endif /* SRSRAN_SIMD_I_SIZE */
+    zuc_state_t state;
+    zuc_initialize(&state, k[i], iv[i]);
+    zuc_generate_keystream(&state, key_stream_len[i], p_keystream[i]);
+    i++;
   }
 }
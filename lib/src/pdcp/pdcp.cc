@@ -48,6 +48,14 @@ void pdcp::init(srsue::rlc_interface_pdcp* rlc_, srsue::rrc_interface_pdcp* rrc_
 
 void pdcp::stop() {}
 
+void pdcp::set_security_engine(pdcp_security_engine* engine)
+{
+  sec_engine = engine;
+  for (auto& lcid_it : pdcp_array) {
+    lcid_it.second->set_security_engine(sec_engine);
+  }
+}
+
 void pdcp::reestablish()
 {
   for (auto& lcid_it : pdcp_array) {
@@ -123,6 +131,10 @@ int pdcp::add_bearer(uint32_t lcid, const pdcp_config_t& cfg)
     entity.reset(new pdcp_entity_nr{rlc, rrc, gw, task_sched, logger, lcid});
   }
 
+  if (sec_engine != nullptr) {
+    entity->set_security_engine(sec_engine);
+  }
+
   if (not entity->configure(cfg)) {
     logger.error("Can not configure PDCP entity");
     return SRSRAN_ERROR;
@@ -30,12 +30,28 @@ pdcp_entity_base::pdcp_entity_base(task_sched_handle task_sched_, srslog::basic_
   logger(logger), task_sched(task_sched_)
 {}
 
-pdcp_entity_base::~pdcp_entity_base() {}
+pdcp_entity_base::~pdcp_entity_base()
+{
+  set_security_engine(nullptr);
+}
 
 void pdcp_entity_base::config_security(const as_security_config_t& sec_cfg_)
 {
   sec_cfg = sec_cfg_;
 
+  // Expand the AES keys once instead of for every PDU
+  if (sec_cfg.cipher_algo == CIPHERING_ALGORITHM_ID_128_EEA2) {
+    k_rrc_enc_aes.set_key(&sec_cfg.k_rrc_enc[16]);
+    k_up_enc_aes.set_key(&sec_cfg.k_up_enc[16]);
+  }
+  if (sec_cfg.integ_algo == INTEGRITY_ALGORITHM_ID_128_EIA2) {
+    k_rrc_int_aes.set_key(&sec_cfg.k_rrc_int[16]);
+    k_up_int_aes.set_key(&sec_cfg.k_up_int[16]);
+  }
+
+  // PDUs already handed to the security engine keep the key they were pushed with
+  up_cipher_key = pdcp_security_engine::make_cipher_key(sec_cfg.cipher_algo, sec_cfg.k_up_enc);
+
   logger.info("Configuring security with %s and %s",
               integrity_algorithm_id_text[sec_cfg.integ_algo],
               ciphering_algorithm_id_text[sec_cfg.cipher_algo]);
@@ -46,9 +62,34 @@ void pdcp_entity_base::config_security(const as_security_config_t& sec_cfg_)
   logger.debug(sec_cfg.k_up_int.data(), 32, "K_up_int");
 }
 
+void pdcp_entity_base::set_security_engine(pdcp_security_engine* engine)
+{
+  // Re-registering also drops the PDUs of this entity that are still being ciphered
+  if (sec_engine != nullptr) {
+    sec_engine->rem_handler(sec_engine_id);
+  }
+  sec_engine = engine;
+  if (sec_engine != nullptr) {
+    sec_engine_id = sec_engine->add_handler(this);
+  }
+}
+
 /****************************************************************************
  * Security functions
  ***************************************************************************/
+bool pdcp_entity_base::defer_cipher_encrypt()
+{
+  return sec_engine != nullptr && is_drb() && up_cipher_key != nullptr &&
+         (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX);
+}
+
+void pdcp_entity_base::push_to_security_engine(unique_byte_buffer_t pdu, uint32_t count)
+{
+  logger.debug("Cipher encrypt deferred: COUNT: %" PRIu32 ", Bearer ID: %d", count, cfg.bearer_id);
+  sec_engine->push(
+      sec_engine_id, up_cipher_key, count, cfg.bearer_id - 1, cfg.tx_direction, cfg.hdr_len_bytes, std::move(pdu));
+}
+
 void pdcp_entity_base::integrity_generate(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* mac)
 {
   uint8_t* k_int;
@@ -67,7 +108,8 @@ void pdcp_entity_base::integrity_generate(uint8_t* msg, uint32_t msg_len, uint32
       security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
+      security_128_eia2(
+          is_srb() ? k_rrc_int_aes : k_up_int_aes, count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA3:
       security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, mac);
@@ -105,7 +147,8 @@ bool pdcp_entity_base::integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t
       security_128_eia1(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA2:
-      security_128_eia2(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
+      security_128_eia2(
+          is_srb() ? k_rrc_int_aes : k_up_int_aes, count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
       break;
     case INTEGRITY_ALGORITHM_ID_128_EIA3:
       security_128_eia3(&k_int[16], count, cfg.bearer_id - 1, cfg.rx_direction, msg, msg_len, mac_exp);
@@ -138,7 +181,6 @@ bool pdcp_entity_base::integrity_verify(uint8_t* msg, uint32_t msg_len, uint32_t
 void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t count, uint8_t* ct)
 {
   uint8_t* k_enc;
-  uint8_t  ct_tmp[PDCP_MAX_SDU_SIZE];
 
   // If control plane use RRC encrytion key. If data use user plane key
   if (is_srb()) {
@@ -154,20 +196,19 @@ void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t c
   logger.debug(k_enc, 32, "Cipher encrypt key:");
   logger.debug(msg, msg_len, "Cipher encrypt input msg");
 
+  // All the ciphering algorithms support in-place operation, so the output is written directly
   switch (sec_cfg.cipher_algo) {
     case CIPHERING_ALGORITHM_ID_EEA0:
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA1:
-      security_128_eea1(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
-      memcpy(ct, ct_tmp, msg_len);
+      security_128_eea1(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
-      memcpy(ct, ct_tmp, msg_len);
+      security_128_eea2(
+          is_srb() ? k_rrc_enc_aes : k_up_enc_aes, count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA3:
-      security_128_eea3(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct_tmp);
-      memcpy(ct, ct_tmp, msg_len);
+      security_128_eea3(&(k_enc[16]), count, cfg.bearer_id - 1, cfg.tx_direction, msg, msg_len, ct);
       break;
     default:
       break;
@@ -178,7 +219,6 @@ void pdcp_entity_base::cipher_encrypt(uint8_t* msg, uint32_t msg_len, uint32_t c
 void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t count, uint8_t* msg)
 {
   uint8_t* k_enc;
-  uint8_t  msg_tmp[PDCP_MAX_SDU_SIZE];
 
   // If control plane use RRC encrytion key. If data use user plane key
   if (is_srb()) {
@@ -194,20 +234,19 @@ void pdcp_entity_base::cipher_decrypt(uint8_t* ct, uint32_t ct_len, uint32_t cou
   logger.debug(k_enc, 32, "Cipher decrypt key:");
   logger.debug(ct, ct_len, "Cipher decrypt input msg");
 
+  // All the ciphering algorithms support in-place operation, so the output is written directly
   switch (sec_cfg.cipher_algo) {
     case CIPHERING_ALGORITHM_ID_EEA0:
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA1:
-      security_128_eea1(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
-      memcpy(msg, msg_tmp, ct_len);
+      security_128_eea1(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA2:
-      security_128_eea2(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
-      memcpy(msg, msg_tmp, ct_len);
+      security_128_eea2(
+          is_srb() ? k_rrc_enc_aes : k_up_enc_aes, count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg);
       break;
     case CIPHERING_ALGORITHM_ID_128_EEA3:
-      security_128_eea3(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg_tmp);
-      memcpy(msg, msg_tmp, ct_len);
+      security_128_eea3(&k_enc[16], count, cfg.bearer_id - 1, cfg.rx_direction, ct, ct_len, msg);
       break;
     default:
       break;
@@ -116,6 +116,10 @@ bool pdcp_entity_lte::configure(const pdcp_config_t& cnfg_)
 void pdcp_entity_lte::reestablish()
 {
   logger.info("Re-establish %s with bearer ID: %d", rb_name.c_str(), cfg.bearer_id);
+  // PDUs still being ciphered use the old COUNT and keys
+  if (sec_engine != nullptr) {
+    set_security_engine(sec_engine);
+  }
   // For SRBs
   if (is_srb()) {
     st.next_pdcp_tx_sn = 0;
@@ -202,7 +206,9 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
     append_mac(sdu, mac);
   }
 
-  if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
+  // DRB ciphering is batched with other bearers when a security engine is set
+  bool deferred_cipher = defer_cipher_encrypt();
+  if (not deferred_cipher && (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX)) {
     cipher_encrypt(
         &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_count, &sdu->msg[cfg.hdr_len_bytes]);
   }
@@ -234,9 +240,22 @@ void pdcp_entity_lte::write_sdu(unique_byte_buffer_t sdu, int upper_sn)
   if (rlc->rb_is_um(lcid)) {
     metrics.num_tx_acked_bytes = metrics.num_tx_pdu_bytes;
   }
+  if (deferred_cipher) {
+    push_to_security_engine(std::move(sdu), tx_count);
+    return;
+  }
   rlc->write_sdu(lcid, std::move(sdu));
 }
 
+void pdcp_entity_lte::write_ciphered_pdu(unique_byte_buffer_t pdu)
+{
+  if (!active) {
+    logger.info("Dropping ciphered %s PDU due to inactive bearer", rb_name.c_str());
+    return;
+  }
+  rlc->write_sdu(lcid, std::move(pdu));
+}
+
 // RLC interface
 void pdcp_entity_lte::write_pdu(unique_byte_buffer_t pdu)
 {
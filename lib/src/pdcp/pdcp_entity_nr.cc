@@ -89,6 +89,10 @@ bool pdcp_entity_nr::configure(const pdcp_config_t& cnfg_)
 void pdcp_entity_nr::reestablish()
 {
   logger.info("Re-establish %s with bearer ID: %d", rb_name.c_str(), cfg.bearer_id);
+  // PDUs still being ciphered use the old COUNT and keys
+  if (sec_engine != nullptr) {
+    set_security_engine(sec_engine);
+  }
   // TODO
 }
 
@@ -156,7 +160,8 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
   // The data unit that is ciphered is the MAC-I and the
   // data part of the PDCP Data PDU except the
   // SDAP header and the SDAP Control PDU if included in the PDCP SDU.
-  if (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX) {
+  bool deferred_cipher = defer_cipher_encrypt();
+  if (not deferred_cipher && (encryption_direction == DIRECTION_TX || encryption_direction == DIRECTION_TXRX)) {
     cipher_encrypt(
         &sdu->msg[cfg.hdr_len_bytes], sdu->N_bytes - cfg.hdr_len_bytes, tx_next, &sdu->msg[cfg.hdr_len_bytes]);
   }
@@ -175,13 +180,26 @@ void pdcp_entity_nr::write_sdu(unique_byte_buffer_t sdu, int sn)
               srsran_direction_text[encryption_direction]);
 
   // Check if PDCP is associated with more than on RLC entity TODO
-  // Write to lower layers
-  rlc->write_sdu(lcid, std::move(sdu));
+  // Write to lower layers, once ciphered if the ciphering is batched with other bearers
+  if (deferred_cipher) {
+    push_to_security_engine(std::move(sdu), tx_next);
+  } else {
+    rlc->write_sdu(lcid, std::move(sdu));
+  }
 
   // Increment TX_NEXT
   tx_next++;
 }
 
+void pdcp_entity_nr::write_ciphered_pdu(unique_byte_buffer_t pdu)
+{
+  if (!active) {
+    logger.info("Dropping ciphered %s PDU due to inactive bearer", rb_name.c_str());
+    return;
+  }
+  rlc->write_sdu(lcid, std::move(pdu));
+}
+
 // RLC interface
 void pdcp_entity_nr::write_pdu(unique_byte_buffer_t pdu)
 {
@@ -0,0 +1,199 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/upper/pdcp_security_engine.h"
+#include <algorithm>
+
+namespace srsran {
+
+pdcp_security_engine::cipher_key_ptr pdcp_security_engine::make_cipher_key(CIPHERING_ALGORITHM_ID_ENUM algo,
+                                                                            const as_key_t&             k_enc)
+{
+  std::shared_ptr<cipher_key_t> key = std::make_shared<cipher_key_t>();
+  key->algo                         = algo;
+  key->k_enc                        = k_enc;
+  if (algo == CIPHERING_ALGORITHM_ID_128_EEA2) {
+    key->k_enc_aes.set_key(&k_enc[16]);
+  }
+  return key;
+}
+
+pdcp_security_engine::pdcp_security_engine(srsran::task_sched_handle task_sched_, uint32_t nof_workers) :
+  task_sched(task_sched_),
+  logger(srslog::fetch_basic_logger("PDCP")),
+  pending(new batch_t),
+  alive_token(std::make_shared<pdcp_security_engine*>(this))
+{
+  if (nof_workers > 0) {
+    workers.reset(new task_thread_pool(nof_workers));
+  }
+  logger.info("PDCP security engine started with %d worker threads", nof_workers);
+}
+
+pdcp_security_engine::~pdcp_security_engine()
+{
+  stop();
+}
+
+void pdcp_security_engine::stop()
+{
+  if (workers != nullptr) {
+    workers->stop();
+  }
+  pending->jobs.clear();
+  completed.clear();
+  handlers.clear();
+}
+
+uint32_t pdcp_security_engine::add_handler(pdu_handler* handler)
+{
+  uint32_t id = next_handler_id++;
+  handlers.emplace(id, handler);
+  return id;
+}
+
+void pdcp_security_engine::rem_handler(uint32_t handler_id)
+{
+  // PDUs of this handler still in flight are dropped when they complete
+  handlers.erase(handler_id);
+}
+
+void pdcp_security_engine::push(uint32_t             handler_id,
+                                cipher_key_ptr       key,
+                                uint32_t             count,
+                                uint8_t              bearer,
+                                uint8_t              direction,
+                                uint32_t             hdr_len,
+                                unique_byte_buffer_t pdu)
+{
+  pending->jobs.push_back(job_t{handler_id, std::move(key), count, bearer, direction, hdr_len, std::move(pdu)});
+  if (pending->jobs.size() >= max_batch_size) {
+    flush();
+  }
+}
+
+void pdcp_security_engine::run_tti()
+{
+  if (not pending->jobs.empty()) {
+    flush();
+  }
+}
+
+void pdcp_security_engine::flush()
+{
+  std::unique_ptr<batch_t> batch = std::move(pending);
+  pending.reset(new batch_t);
+  pending->jobs.reserve(batch->jobs.size());
+  batch->seq = next_seq++;
+
+  if (workers == nullptr) {
+    cipher_batch(*batch);
+    handle_completed(std::move(batch));
+    return;
+  }
+
+  workers->push_task([this, batch = std::move(batch)]() mutable {
+    cipher_batch(*batch);
+    std::weak_ptr<pdcp_security_engine*> token = alive_token;
+    task_sched.notify_background_task_result([token, batch = std::move(batch)]() mutable {
+      std::shared_ptr<pdcp_security_engine*> engine = token.lock();
+      if (engine != nullptr) {
+        (*engine)->handle_completed(std::move(batch));
+      }
+    });
+  });
+}
+
+void pdcp_security_engine::cipher_batch(batch_t& batch)
+{
+  // Batches are ciphered on the worker threads, each one reusing its own lists
+  static thread_local std::vector<security_cipher_msg_t> eea1_msgs, eea3_msgs;
+  eea1_msgs.clear();
+  eea3_msgs.clear();
+
+  for (job_t& job : batch.jobs) {
+    if (job.pdu->N_bytes <= job.hdr_len) {
+      continue;
+    }
+    uint8_t*              payload = &job.pdu->msg[job.hdr_len];
+    uint32_t              len     = job.pdu->N_bytes - job.hdr_len;
+    security_cipher_msg_t msg     = {&job.key->k_enc[16], job.count, job.bearer, job.direction, payload, len, payload};
+    switch (job.key->algo) {
+      case CIPHERING_ALGORITHM_ID_EEA0:
+        break;
+      case CIPHERING_ALGORITHM_ID_128_EEA1:
+        eea1_msgs.push_back(msg);
+        break;
+      case CIPHERING_ALGORITHM_ID_128_EEA2:
+        security_128_eea2(job.key->k_enc_aes, job.count, job.bearer, job.direction, payload, len, payload);
+        break;
+      case CIPHERING_ALGORITHM_ID_128_EEA3:
+        eea3_msgs.push_back(msg);
+        break;
+      default:
+        break;
+    }
+  }
+
+  // Messages of similar length share the SIMD lanes of the keystream generators
+  auto by_len = [](const security_cipher_msg_t& a, const security_cipher_msg_t& b) { return a.msg_len < b.msg_len; };
+  if (not eea1_msgs.empty()) {
+    std::sort(eea1_msgs.begin(), eea1_msgs.end(), by_len);
+    security_128_eea1_multi(eea1_msgs.data(), eea1_msgs.size());
+  }
+  if (not eea3_msgs.empty()) {
+    std::sort(eea3_msgs.begin(), eea3_msgs.end(), by_len);
+    security_128_eea3_multi(eea3_msgs.data(), eea3_msgs.size());
+  }
+}
+
+void pdcp_security_engine::handle_completed(std::unique_ptr<batch_t> batch)
+{
+  if (batch->seq != next_deliver) {
+    completed.emplace(batch->seq, std::move(batch));
+    return;
+  }
+  deliver(std::move(batch));
+  next_deliver++;
+
+  // Deliver the batches that completed before this one
+  auto it = completed.begin();
+  while (it != completed.end() and it->first == next_deliver) {
+    deliver(std::move(it->second));
+    next_deliver++;
+    it = completed.erase(it);
+  }
+}
+
+void pdcp_security_engine::deliver(std::unique_ptr<batch_t> batch)
+{
+  for (job_t& job : batch->jobs) {
+    // The handler is looked up for every PDU, as a handler may remove itself while processing the previous one
+    auto it = handlers.find(job.handler_id);
+    if (it == handlers.end()) {
+      logger.debug("Dropping ciphered PDU of removed bearer");
+      continue;
+    }
+    it->second->write_ciphered_pdu(std::move(job.pdu));
+  }
+}
+
+} // namespace srsran
@@ -689,6 +689,78 @@ void srsran_ofdm_tx_sf(srsran_ofdm_t* q)
   }
 }
 
+uint32_t srsran_ofdm_get_symbol_offset(const srsran_ofdm_t* q, uint32_t symbol_idx)
+{
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  uint32_t slot      = symbol_idx / q->nof_symbols;
+  uint32_t offset    = slot * q->slot_sz;
+
+  for (uint32_t i = 0; i < symbol_idx % q->nof_symbols; i++) {
+    offset += symbol_sz;
+    offset += SRSRAN_CP_ISNORM(q->cfg.cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+  }
+
+  return offset;
+}
+
+/* Transforms a single OFDM symbol of a normal subframe, it produces the same samples as ofdm_tx_slot.
+ * It uses the temporal buffer region after the slot guru plan input, so the latter keeps its guards zeroed.
+ */
+static void ofdm_tx_symbol(srsran_ofdm_t* q, uint32_t symbol_idx)
+{
+  uint32_t symbol_sz = q->cfg.symbol_sz;
+  uint32_t i         = symbol_idx % q->nof_symbols;
+  int      cp_len    = SRSRAN_CP_ISNORM(q->cfg.cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+  cf_t*    input     = q->cfg.in_buffer + symbol_idx * q->nof_re;
+  cf_t*    output    = q->cfg.out_buffer + srsran_ofdm_get_symbol_offset(q, symbol_idx);
+#ifdef AVOID_GURU
+  cf_t* tmp = q->tmp;
+#else
+  cf_t* tmp = q->tmp + q->nof_symbols * symbol_sz;
+#endif /* AVOID_GURU */
+
+  // The DFT plan places the resource elements around DC and applies the normalization
+  srsran_vec_cf_zero(tmp, q->nof_guards);
+  srsran_vec_cf_copy(&tmp[q->nof_guards], input, q->nof_re);
+  srsran_vec_cf_zero(&tmp[q->nof_guards + q->nof_re], symbol_sz - q->nof_guards - q->nof_re);
+  srsran_dft_run_c(&q->fft_plan, tmp, &output[cp_len]);
+
+  if (isnormal(q->cfg.phase_compensation_hz)) {
+    srsran_vec_sc_prod_ccc(&output[cp_len], q->phase_compensation[symbol_idx], &output[cp_len], symbol_sz);
+  }
+
+  // CFR: Process the time-domain signal without the CP
+  if (q->cfg.cfr_tx_cfg.cfr_enable) {
+    srsran_cfr_process(&q->tx_cfr, output + cp_len, output + cp_len);
+  }
+
+  /* add CP */
+  srsran_vec_cf_copy(output, &output[symbol_sz], cp_len);
+}
+
+void srsran_ofdm_tx_symbols(srsran_ofdm_t* q, uint32_t first_symbol, uint32_t nof_symbols)
+{
+  uint32_t end = SRSRAN_MIN(first_symbol + nof_symbols, SRSRAN_NOF_SLOTS_PER_SF * q->nof_symbols);
+
+  for (uint32_t l = first_symbol; l < end;) {
+    uint32_t offset = srsran_ofdm_get_symbol_offset(q, l);
+
+    if (l % q->nof_symbols == 0 && l + q->nof_symbols <= end) {
+      // Whole slots use the guru plan
+      ofdm_tx_slot(q, (int)(l / q->nof_symbols));
+      l += q->nof_symbols;
+    } else {
+      ofdm_tx_symbol(q, l);
+      l++;
+    }
+
+    if (isnormal(q->cfg.freq_shift_f)) {
+      uint32_t len = srsran_ofdm_get_symbol_offset(q, l) - offset;
+      srsran_vec_prod_ccc(&q->cfg.out_buffer[offset], &q->shift_buffer[offset], &q->cfg.out_buffer[offset], len);
+    }
+  }
+}
+
 int srsran_ofdm_set_cfr(srsran_ofdm_t* q, srsran_cfr_cfg_t* cfr)
 {
   if (q == NULL || cfr == NULL) {
@@ -97,7 +97,7 @@ int main(int argc, char** argv)
   srsran_random_t random_gen = srsran_random_init(0);
   struct timeval  start, end;
   srsran_ofdm_t   fft = {}, ifft = {};
-  cf_t *          input, *outfft, *outifft;
+  cf_t *          input, *outfft, *outifft, *reference;
   float           mse;
   uint32_t        n_prb, max_prb;
 
@@ -118,10 +118,11 @@ int main(int argc, char** argv)
     printf("Running test for %d PRB, %d RE... ", n_prb, n_re);
     fflush(stdout);
 
-    input   = srsran_vec_cf_malloc(n_re);
-    outfft  = srsran_vec_cf_malloc(n_re);
-    outifft = srsran_vec_cf_malloc(sf_len);
-    if (!input || !outfft || !outifft) {
+    input     = srsran_vec_cf_malloc(n_re);
+    outfft    = srsran_vec_cf_malloc(n_re);
+    outifft   = srsran_vec_cf_malloc(sf_len);
+    reference = srsran_vec_cf_malloc(sf_len);
+    if (!input || !outfft || !outifft || !reference) {
       perror("malloc");
       exit(-1);
     }
@@ -165,6 +166,19 @@ int main(int argc, char** argv)
     gettimeofday(&end, NULL);
     printf(" Tx@%.1fMsps", (float)(sf_len * nof_repetitions) / elapsed_us(&start, &end));
 
+    // Generate the same subframe by ranges of symbols, a partial slot first and the remainder after
+    srsran_vec_cf_copy(reference, outifft, sf_len);
+    srsran_vec_cf_zero(outifft, sf_len);
+    uint32_t nof_symbols = SRSRAN_CP_NSYMB(cp) * SRSRAN_NOF_SLOTS_PER_SF;
+    srsran_ofdm_tx_symbols(&ifft, 0, 3);
+    srsran_ofdm_tx_symbols(&ifft, 3, nof_symbols - 3);
+    srsran_vec_sub_ccc(reference, outifft, reference, sf_len);
+    mse = sqrtf(srsran_vec_avg_power_cf(reference, sf_len));
+    if (mse >= 0.0001) {
+      printf(" Symbols MSE=%.6f too large\n", mse);
+      exit(-1);
+    }
+
     // Execute Rx
     gettimeofday(&start, NULL);
     for (uint32_t i = 0; i < nof_repetitions; i++) {
@@ -190,6 +204,7 @@ int main(int argc, char** argv)
     free(input);
     free(outfft);
     free(outifft);
+    free(reference);
 
     n_prb++;
   }
@@ -465,6 +465,19 @@ void srsran_enb_dl_gen_signal(srsran_enb_dl_t* q)
   }
 }
 
+void srsran_enb_dl_gen_signal_symbols(srsran_enb_dl_t* q, uint32_t port, uint32_t first_symbol, uint32_t nof_symbols)
+{
+  if (q == NULL || port >= q->cell.nof_ports) {
+    return;
+  }
+
+  // Apply the amplitude normalization to the symbols, then perform the IFFT and optional CFR reduction
+  uint32_t nof_re = q->cell.nof_prb * SRSRAN_NRE;
+  cf_t*    in     = &q->ifft[port].cfg.in_buffer[first_symbol * nof_re];
+  srsran_vec_sc_prod_cfc(in, enb_dl_get_norm_factor(q->cell.nof_prb), in, nof_symbols * nof_re);
+  srsran_ofdm_tx_symbols(&q->ifft[port], first_symbol, nof_symbols);
+}
+
 bool srsran_enb_dl_gen_cqi_periodic(const srsran_cell_t*   cell,
                                     const srsran_dl_cfg_t* dl_cfg,
                                     uint32_t               tti,
@@ -240,6 +240,21 @@ void srsran_gnb_dl_gen_signal(srsran_gnb_dl_t* q)
   }
 }
 
+void srsran_gnb_dl_gen_signal_symbols(srsran_gnb_dl_t* q, uint32_t antenna, uint32_t first_symbol, uint32_t nof_symbols)
+{
+  if (q == NULL || antenna >= q->nof_tx_antennas) {
+    return;
+  }
+
+  srsran_ofdm_t* fft = &q->fft[antenna];
+  srsran_ofdm_tx_symbols(fft, first_symbol, nof_symbols);
+
+  uint32_t offset = srsran_ofdm_get_symbol_offset(fft, first_symbol);
+  uint32_t len    = srsran_ofdm_get_symbol_offset(fft, first_symbol + nof_symbols) - offset;
+  float    norm   = gnb_dl_get_norm_factor(q->pdsch.carrier.nof_prb);
+  srsran_vec_sc_prod_cfc(&fft->cfg.out_buffer[offset], norm, &fft->cfg.out_buffer[offset], len);
+}
+
 float srsran_gnb_dl_get_maximum_signal_power_dBfs(uint32_t nof_prb)
 {
   return srsran_convert_amplitude_to_dB(gnb_dl_get_norm_factor(nof_prb)) +
@@ -0,0 +1,280 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/utils/simd.h"
+#include "srsran/phy/utils/vector.h"
+
+/**
+ * Raised cosine filter Roll-off
+ * 0: Frequency sharp, long in time
+ * 1: Frequency relaxed, short in time
+ */
+#define RESAMPLER_POLYPHASE_BETA 0.25
+
+/**
+ * Filter half length in multiples of the lowest rate sampling period
+ */
+#define RESAMPLER_POLYPHASE_HALF_LEN 10
+
+/**
+ * Maximum number of input samples processed at once
+ */
+#define RESAMPLER_POLYPHASE_WINDOW_SZ 1024
+
+static uint32_t resampler_polyphase_gcd(uint32_t a, uint32_t b)
+{
+  while (b != 0) {
+    uint32_t r = a % b;
+    a          = b;
+    b          = r;
+  }
+  return a;
+}
+
+// Raised cosine impulse response for a normalised symbol period, see section "1.2 Impulse Response" of
+// https://dspguru.com/dsp/reference/raised-cosine-and-root-raised-cosine-formulas/
+static double resampler_polyphase_raised_cosine(double t)
+{
+  const double beta = RESAMPLER_POLYPHASE_BETA;
+
+  if (!isnormal(t)) {
+    return 1.0;
+  }
+
+  double sinc = sin(M_PI * t) / (M_PI * t);
+  double den  = 1.0 - 4.0 * beta * beta * t * t;
+
+  // Limit at t = +/- 1/(2 beta)
+  if (fabs(den) < 1e-9) {
+    return M_PI_4 * sin(M_PI / (2.0 * beta)) / (M_PI / (2.0 * beta));
+  }
+
+  return sinc * cos(M_PI * beta * t) / den;
+}
+
+int srsran_resampler_polyphase_init(srsran_resampler_polyphase_t* q, uint32_t interp, uint32_t decim)
+{
+  if (q == NULL || interp == 0 || decim == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Reduce ratio
+  uint32_t gcd = resampler_polyphase_gcd(interp, decim);
+  interp /= gcd;
+  decim /= gcd;
+
+  if (q->interp == interp && q->decim == decim && q->filter != NULL) {
+    srsran_resampler_polyphase_reset_state(q);
+    return SRSRAN_SUCCESS;
+  }
+
+  // Make sure resampler is freed
+  srsran_resampler_polyphase_free(q);
+
+  // The filter cut-off is given by the lowest of both rates, which period is max(interp, decim) at the high rate
+  uint32_t period = SRSRAN_MAX(interp, decim);
+
+  q->interp    = interp;
+  q->decim     = decim;
+  q->nof_taps  = SRSRAN_CEIL(2 * RESAMPLER_POLYPHASE_HALF_LEN * period, interp);
+  q->window_sz = RESAMPLER_POLYPHASE_WINDOW_SZ;
+  q->stream_sz = SRSRAN_CEIL(q->nof_taps - 1 + q->window_sz, decim);
+
+  q->buffer  = srsran_vec_cf_malloc(q->nof_taps + q->window_sz);
+  q->filter  = srsran_vec_f_malloc(q->nof_taps * interp);
+  q->streams = srsran_vec_cf_malloc(q->stream_sz * decim);
+  if (q->buffer == NULL || q->filter == NULL || q->streams == NULL) {
+    srsran_resampler_polyphase_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  // Compute prototype filter coefficients at the high rate, split them in branches and reverse them in time, so each
+  // output sample is a dot product between the input and a branch
+  uint32_t nof_coeff = q->nof_taps * interp;
+  double   center    = (double)(nof_coeff - 1) / 2.0;
+  double   sum       = 0.0;
+  for (uint32_t p = 0; p < interp; p++) {
+    for (uint32_t k = 0; k < q->nof_taps; k++) {
+      double h = resampler_polyphase_raised_cosine(((double)(p + k * interp) - center) / (double)period);
+
+      q->filter[p * q->nof_taps + (q->nof_taps - 1 - k)] = (float)h;
+      sum += h;
+    }
+  }
+
+  // Normalise the filter so that its coefficients add up to interp. Every branch then has about unitary gain, which
+  // compensates the interp - 1 zeros inserted between input samples when interpolating
+  srsran_vec_sc_prod_fff(q->filter, (float)((double)interp / sum), q->filter, nof_coeff);
+
+  // reset state
+  srsran_resampler_polyphase_reset_state(q);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_resampler_polyphase_reset_state(srsran_resampler_polyphase_t* q)
+{
+  if (q == NULL || q->buffer == NULL) {
+    return;
+  }
+
+  q->t = 0;
+  srsran_vec_cf_zero(q->buffer, q->nof_taps - 1);
+}
+
+uint32_t srsran_resampler_polyphase_get_delay(srsran_resampler_polyphase_t* q)
+{
+  if (q == NULL || q->decim == 0) {
+    return UINT32_MAX;
+  }
+
+  return (uint32_t)round((double)(q->nof_taps * q->interp - 1) / (2.0 * (double)q->decim));
+}
+
+uint32_t srsran_resampler_polyphase_get_nof_input(const srsran_resampler_polyphase_t* q, uint32_t nof_output)
+{
+  if (q == NULL || q->interp == 0) {
+    return 0;
+  }
+
+  // The outputs fall at the high rate times t, t + decim, ... which must be below nof_input * interp
+  return (uint32_t)(((uint64_t)nof_output * q->decim + q->t) / q->interp);
+}
+
+// Computes a single output sample for the high rate time index t
+static inline cf_t resampler_polyphase_output(const srsran_resampler_polyphase_t* q, uint32_t t)
+{
+  const float* branch = &q->filter[(t % q->interp) * q->nof_taps];
+  return srsran_vec_dot_prod_cfc(&q->buffer[t / q->interp], branch, q->nof_taps);
+}
+
+// Computes nof_output samples starting at the high rate time index t. Outputs which are interp samples apart use the
+// same branch and their input is decim samples apart, so they are computed in parallel from the decimated streams
+static void resampler_polyphase_window(srsran_resampler_polyphase_t* q, uint32_t t, cf_t* output, uint32_t nof_output)
+{
+  uint32_t nof_phases = SRSRAN_MIN(q->interp, nof_output);
+
+  for (uint32_t r = 0; r < nof_phases; r++) {
+    uint32_t     t_r    = t + r * q->decim;
+    uint32_t     i_r    = t_r / q->interp;
+    const float* branch = &q->filter[(t_r % q->interp) * q->nof_taps];
+    uint32_t     n_r    = SRSRAN_CEIL(nof_output - r, q->interp);
+    uint32_t     j      = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+    __attribute__((aligned(64))) cf_t simd_out[SRSRAN_SIMD_CF_SIZE];
+    for (; j + SRSRAN_SIMD_CF_SIZE <= n_r; j += SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t acc = srsran_simd_cf_zero();
+      uint32_t  s   = i_r % q->decim;     // Stream of the current tap
+      uint32_t  idx = i_r / q->decim + j; // Index in the stream of the current tap
+      for (uint32_t k = 0; k < q->nof_taps; k++) {
+        simd_cf_t x = srsran_simd_cfi_loadu(&q->streams[s * q->stream_sz + idx]);
+        acc         = srsran_simd_cf_add(acc, srsran_simd_cf_mul(x, srsran_simd_f_set1(branch[k])));
+        if (++s == q->decim) {
+          s = 0;
+          idx++;
+        }
+      }
+      srsran_simd_cfi_store(simd_out, acc);
+
+      for (uint32_t l = 0; l < SRSRAN_SIMD_CF_SIZE; l++) {
+        output[r + (j + l) * q->interp] = simd_out[l];
+      }
+    }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+    for (; j < n_r; j++) {
+      output[r + j * q->interp] = resampler_polyphase_output(q, t_r + j * q->interp * q->decim);
+    }
+  }
+}
+
+uint32_t
+srsran_resampler_polyphase_run(srsran_resampler_polyphase_t* q, const cf_t* input, cf_t* output, uint32_t nsamples)
+{
+  if (q == NULL || q->filter == NULL) {
+    return 0;
+  }
+
+  uint32_t count = 0;
+  uint32_t nout  = 0;
+  while (count < nsamples) {
+    uint32_t n = SRSRAN_MIN(q->window_sz, nsamples - count);
+
+    // Append input samples after the filter state
+    if (input) {
+      srsran_vec_cf_copy(&q->buffer[q->nof_taps - 1], &input[count], n);
+    } else {
+      srsran_vec_cf_zero(&q->buffer[q->nof_taps - 1], n);
+    }
+
+    // Count the output samples which fall in this window
+    uint32_t t_end  = n * q->interp;
+    uint32_t n_win  = (q->t < t_end) ? SRSRAN_CEIL(t_end - q->t, q->decim) : 0;
+    uint32_t buf_sz = q->nof_taps - 1 + n;
+
+    if (output != NULL && n_win > 0) {
+      // Split the buffer in decim streams
+      if (q->decim == 1) {
+        srsran_vec_cf_copy(q->streams, q->buffer, buf_sz);
+      } else {
+        for (uint32_t i = 0; i < buf_sz; i++) {
+          q->streams[(i % q->decim) * q->stream_sz + i / q->decim] = q->buffer[i];
+        }
+      }
+
+      resampler_polyphase_window(q, q->t, &output[nout], n_win);
+    }
+    nout += n_win;
+    q->t = q->t + n_win * q->decim - t_end;
+
+    // Save filter state
+    memmove(q->buffer, &q->buffer[n], sizeof(cf_t) * (q->nof_taps - 1));
+
+    count += n;
+  }
+
+  return nout;
+}
+
+void srsran_resampler_polyphase_free(srsran_resampler_polyphase_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->buffer) {
+    free(q->buffer);
+  }
+  if (q->filter) {
+    free(q->filter);
+  }
+  if (q->streams) {
+    free(q->streams);
+  }
+
+  memset(q, 0, sizeof(srsran_resampler_polyphase_t));
+}
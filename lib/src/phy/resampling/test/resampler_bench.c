@@ -0,0 +1,275 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+
+#define RESAMPLER_BENCH_NOF_TONES 32
+
+static uint32_t buffer_size = 23040;
+static uint32_t interp      = 4;
+static uint32_t decim       = 3;
+static uint32_t repetitions = 100;
+static float    occupancy   = 0.6f;
+static float    max_evm     = 0.01f;
+
+// Test signal, sum of tones within the occupied bandwidth
+static double tone_freq[RESAMPLER_BENCH_NOF_TONES] = {};
+static cf_t   tone_ampl[RESAMPLER_BENCH_NOF_TONES] = {};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [sidroev]\n", prog);
+  printf("\t-s Input buffer size [Default %d]\n", buffer_size);
+  printf("\t-i Interpolation factor [Default %d]\n", interp);
+  printf("\t-d Decimation factor [Default %d]\n", decim);
+  printf("\t-r Repetitions [Default %d]\n", repetitions);
+  printf("\t-o Occupied bandwidth relative to the lowest rate [Default %.2f]\n", occupancy);
+  printf("\t-e Maximum polyphase resampler in-band EVM [Default %.3f]\n", max_evm);
+  printf("\t-v Increase verbosity\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "sidroev")) != -1) {
+    switch (opt) {
+      case 's':
+        buffer_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'i':
+        interp = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'd':
+        decim = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'o':
+        occupancy = strtof(argv[optind], NULL);
+        break;
+      case 'e':
+        max_evm = strtof(argv[optind], NULL);
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+// Evaluates the test signal at the given time in input samples
+static cf_t signal_at(double t)
+{
+  cf_t y = 0.0f;
+  for (uint32_t k = 0; k < RESAMPLER_BENCH_NOF_TONES; k++) {
+    y += tone_ampl[k] * (cf_t)cexp(I * 2.0 * M_PI * tone_freq[k] * t);
+  }
+  return y;
+}
+
+// Computes the EVM of the output against the ideal signal, given the output delay in input samples. The first and last
+// samples are skipped to avoid the filter transients
+static float calc_evm(const cf_t* output, uint32_t nof_output, double delay)
+{
+  uint32_t skip    = nof_output / 8;
+  double   err_pwr = 0.0;
+  double   ref_pwr = 0.0;
+  for (uint32_t i = skip; i < nof_output - skip; i++) {
+    cf_t ref = signal_at((double)i * (double)decim / (double)interp - delay);
+    err_pwr += SRSRAN_CSQABS(output[i] - ref);
+    ref_pwr += SRSRAN_CSQABS(ref);
+  }
+
+  return (float)sqrt(err_pwr / ref_pwr);
+}
+
+static uint64_t time_diff_us(struct timespec* start, struct timespec* end)
+{
+  return (uint64_t)(end->tv_sec - start->tv_sec) * 1000000UL + (uint64_t)(end->tv_nsec - start->tv_nsec) / 1000UL;
+}
+
+static void print_result(const char* name, uint64_t cpu_us, uint64_t wall_us, double delay, float evm)
+{
+  // Total number of processed input samples
+  double nof_samples = (double)buffer_size * (double)repetitions;
+
+  printf("%-10s: %7.1f Msps; CPU %6.2f ns/sample; latency %6.1f samples; in-band EVM %6.3f%% (%.1f dB)\n",
+         name,
+         nof_samples / (double)wall_us,
+         1000.0 * (double)cpu_us / nof_samples,
+         delay,
+         100.0f * evm,
+         20.0f * log10f(evm));
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  if (interp == 0 || decim == 0 || buffer_size == 0 || repetitions == 0) {
+    usage(argv[0]);
+    return SRSRAN_ERROR;
+  }
+
+  srsran_random_t              random_gen = srsran_random_init(0x1234);
+  srsran_resampler_polyphase_t polyphase  = {};
+  srsran_resampler_fft_t       fft        = {};
+  uint32_t                     max_output = SRSRAN_CEIL(buffer_size * interp, decim) + 1;
+  cf_t*                        input      = srsran_vec_cf_malloc(buffer_size);
+  cf_t*                        output     = srsran_vec_cf_malloc(max_output);
+  if (input == NULL || output == NULL) {
+    goto clean_exit;
+  }
+
+  // Generate tones in the occupied bandwidth of the lowest rate, frequency is normalised to the input rate
+  double bw = occupancy * SRSRAN_MIN(1.0, (double)interp / (double)decim);
+  for (uint32_t k = 0; k < RESAMPLER_BENCH_NOF_TONES; k++) {
+    tone_freq[k] = srsran_random_uniform_real_dist(random_gen, (float)(-bw / 2.0), (float)(bw / 2.0));
+    tone_ampl[k] = srsran_random_uniform_complex_dist(random_gen, -1.0f, 1.0f) / sqrtf(RESAMPLER_BENCH_NOF_TONES);
+  }
+  for (uint32_t i = 0; i < buffer_size; i++) {
+    input[i] = signal_at((double)i);
+  }
+
+  // Polyphase resampler
+  if (srsran_resampler_polyphase_init(&polyphase, interp, decim) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising polyphase resampler");
+    goto clean_exit;
+  }
+  {
+    struct timespec cpu[2]  = {};
+    struct timespec wall[2] = {};
+    uint32_t        nof_out = 0;
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu[0]);
+    clock_gettime(CLOCK_MONOTONIC, &wall[0]);
+    for (uint32_t r = 0; r < repetitions; r++) {
+      srsran_resampler_polyphase_reset_state(&polyphase);
+      nof_out = srsran_resampler_polyphase_run(&polyphase, input, output, buffer_size);
+    }
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu[1]);
+    clock_gettime(CLOCK_MONOTONIC, &wall[1]);
+
+    // The filter is centered at the middle of the prototype filter, at the high rate
+    double delay = (double)(polyphase.nof_taps * polyphase.interp - 1) / 2.0 / (double)polyphase.interp;
+    float  evm   = calc_evm(output, nof_out, delay);
+    print_result("polyphase",
+                 time_diff_us(&cpu[0], &cpu[1]),
+                 time_diff_us(&wall[0], &wall[1]),
+                 (double)srsran_resampler_polyphase_get_delay(&polyphase),
+                 evm);
+
+    if (nof_out != buffer_size * interp / decim) {
+      ERROR("Unexpected number of output samples (%d/%d)", nof_out, buffer_size * interp / decim);
+      goto clean_exit;
+    }
+
+    if (!(evm < max_evm)) {
+      ERROR("Polyphase in-band EVM (%.3f%%) exceeds the maximum (%.3f%%)", 100.0f * evm, 100.0f * max_evm);
+      goto clean_exit;
+    }
+
+    // Stream the input in blocks sized to produce a given number of output samples, as the radio does. Odd block sizes
+    // leave a fractional output sample to carry across calls
+    uint32_t block_out = 1001;
+    uint32_t count     = 0;
+    srsran_resampler_polyphase_reset_state(&polyphase);
+    while (count < buffer_size) {
+      uint32_t n = srsran_resampler_polyphase_get_nof_input(&polyphase, block_out);
+      n          = SRSRAN_MIN(n, buffer_size - count);
+      uint32_t t = polyphase.t;
+      nof_out    = srsran_resampler_polyphase_run(&polyphase, &input[count], output, n);
+      if (nof_out > block_out || (interp <= decim && count + n < buffer_size && nof_out != block_out)) {
+        ERROR("Unexpected number of output samples for %d input samples (%d/%d)", n, nof_out, block_out);
+        goto clean_exit;
+      }
+      if (nof_out != SRSRAN_CEIL(n * interp - SRSRAN_MIN(t, n * interp), decim)) {
+        ERROR("Output samples (%d) don't match the time of the first one (%d)", nof_out, t);
+        goto clean_exit;
+      }
+      count += n;
+    }
+  }
+
+  // FFT resampler, it only supports integer ratios
+  if (decim == 1 || interp == 1) {
+    srsran_resampler_mode_t mode  = (decim == 1) ? SRSRAN_RESAMPLER_MODE_INTERPOLATE : SRSRAN_RESAMPLER_MODE_DECIMATE;
+    uint32_t                ratio = SRSRAN_MAX(interp, decim);
+    if (srsran_resampler_fft_init(&fft, mode, ratio) < SRSRAN_SUCCESS) {
+      ERROR("Error initialising FFT resampler");
+      goto clean_exit;
+    }
+
+    struct timespec cpu[2]  = {};
+    struct timespec wall[2] = {};
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu[0]);
+    clock_gettime(CLOCK_MONOTONIC, &wall[0]);
+    for (uint32_t r = 0; r < repetitions; r++) {
+      srsran_resampler_fft_reset_state(&fft);
+      srsran_resampler_fft_run(&fft, input, output, buffer_size);
+    }
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu[1]);
+    clock_gettime(CLOCK_MONOTONIC, &wall[1]);
+
+    // The FFT resampler delay is given at the high rate
+    double delay = (double)srsran_resampler_fft_get_delay(&fft);
+    if (mode == SRSRAN_RESAMPLER_MODE_INTERPOLATE) {
+      delay /= (double)ratio;
+    }
+    float  evm   = calc_evm(output, buffer_size * interp / decim, delay);
+    print_result("fft",
+                 time_diff_us(&cpu[0], &cpu[1]),
+                 time_diff_us(&wall[0], &wall[1]),
+                 delay * (double)interp / (double)decim,
+                 evm);
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(random_gen);
+  srsran_resampler_polyphase_free(&polyphase);
+  srsran_resampler_fft_free(&fft);
+  if (input) {
+    free(input);
+  }
+  if (output) {
+    free(output);
+  }
+
+  return ret;
+}
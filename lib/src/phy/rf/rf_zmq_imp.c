@@ -47,6 +47,7 @@ typedef struct {
   uint32_t tx_freq_mhz[SRSRAN_MAX_CHANNELS];
   uint32_t rx_freq_mhz[SRSRAN_MAX_CHANNELS];
   bool     tx_off;
+  bool     virtual_time; // Do not pace the reception to the sample rate, run as fast as the peers process samples
   char     id[RF_PARAM_LEN];
 
   // Server
@@ -288,6 +289,11 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
           goto clean_exit;
         }
       }
+
+      // virtual_time
+      if (parse_string(args, "virtual_time", -1, tmp) == SRSRAN_SUCCESS) {
+        handler->virtual_time = (strncmp(tmp, "true", RF_PARAM_LEN) == 0 || strncmp(tmp, "yes", RF_PARAM_LEN) == 0);
+      }
     } else {
       fprintf(stderr,
               "[zmq] Error: No device 'args' option has been set. Please make sure to set this option to be able to "
@@ -710,8 +716,11 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
     rf_zmq_info(handler->id, " - next rx time: %d + %.3f\n", ts_rx.full_secs, ts_rx.frac_secs);
     rf_zmq_info(handler->id, " - next tx time: %d + %.3f\n", ts_tx.full_secs, ts_tx.frac_secs);
 
-    // Leave time for the Tx to transmit
-    usleep((1000000UL * nsamples_baserate) / handler->base_srate);
+    // Leave time for the Tx to transmit. In virtual time the peers are kept in lock-step by the REQ/REP exchange and
+    // the simulated time only advances as fast as the samples are produced
+    if (!handler->virtual_time) {
+      usleep((1000000UL * nsamples_baserate) / handler->base_srate);
+    }
 
     // check for tx gap if we're also transmitting on this radio
     for (int i = 0; i < handler->nof_channels; i++) {
@@ -0,0 +1,141 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/tsan_options.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/common/timestamp.h"
+#include "srsran/phy/rf/rf.h"
+#include "srsran/phy/utils/vector.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define NUM_SF (1000)
+#define SF_LEN (1920)
+#define BASE_SRATE (1.92e6)
+
+// The virtual time receiver must advance at least this many times faster than real-time
+#define MIN_SPEEDUP (2.0)
+
+static cf_t tx_buffer[SF_LEN];
+static cf_t rx_buffer[SF_LEN];
+
+static srsran_rf_t enb_radio, ue_radio;
+
+static void* enb_tx_thread_function(void* args)
+{
+  char rf_args[RF_PARAM_LEN] = "tx_port=ipc://virtual_time_dl,id=enb,base_srate=1.92e6";
+
+  printf("opening tx device with args=%s\n", rf_args);
+  if (srsran_rf_open_devname(&enb_radio, "zmq", rf_args, 1)) {
+    fprintf(stderr, "Error opening rf\n");
+    exit(-1);
+  }
+
+  // Each transmission is served upon the receiver request, so the transmitter never runs ahead of the receiver
+  void* data_ptr[SRSRAN_MAX_PORTS] = {tx_buffer};
+  for (uint32_t i = 0; i < NUM_SF; i++) {
+    if (srsran_rf_send_multi(&enb_radio, data_ptr, SF_LEN, true, true, false) != SRSRAN_SUCCESS) {
+      fprintf(stderr, "Error sending data\n");
+      exit(-1);
+    }
+  }
+
+  printf("transmitted %d subframes\n", NUM_SF);
+
+  srsran_rf_close(&enb_radio);
+
+  return NULL;
+}
+
+static double elapsed_s(const struct timespec* start, const struct timespec* end)
+{
+  return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) * 1e-9;
+}
+
+int main()
+{
+  int       ret       = SRSRAN_ERROR;
+  pthread_t tx_thread;
+
+  srsran_vec_cf_zero(tx_buffer, SF_LEN);
+
+  char rf_args[RF_PARAM_LEN] = "rx_port=ipc://virtual_time_dl,id=ue,base_srate=1.92e6,virtual_time=true";
+  printf("opening rx device with args=%s\n", rf_args);
+  if (srsran_rf_open_devname(&ue_radio, "zmq", rf_args, 1)) {
+    fprintf(stderr, "Error opening rf\n");
+    return SRSRAN_ERROR;
+  }
+
+  if (pthread_create(&tx_thread, NULL, enb_tx_thread_function, NULL)) {
+    perror("pthread_create");
+    srsran_rf_close(&ue_radio);
+    return SRSRAN_ERROR;
+  }
+
+  struct timespec start = {}, end = {};
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  // Receive subframe by subframe, the timestamp must advance exactly one subframe every time
+  void*    data_ptr[SRSRAN_MAX_PORTS] = {rx_buffer};
+  uint64_t first_ts                   = 0;
+  uint32_t i                          = 0;
+  for (; i < NUM_SF; i++) {
+    srsran_timestamp_t ts = {};
+    if (srsran_rf_recv_with_time_multi(&ue_radio, data_ptr, SF_LEN, true, &ts.full_secs, &ts.frac_secs) != SF_LEN) {
+      fprintf(stderr, "Error receiving subframe %d\n", i);
+      break;
+    }
+
+    uint64_t ts_count = srsran_timestamp_uint64(&ts, BASE_SRATE);
+    if (i == 0) {
+      first_ts = ts_count;
+    } else if (ts_count - first_ts != (uint64_t)i * SF_LEN) {
+      fprintf(stderr,
+              "Timestamp of subframe %d is %ld samples, expected %ld\n",
+              i,
+              (long)(ts_count - first_ts),
+              (long)i * SF_LEN);
+      break;
+    }
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  pthread_join(tx_thread, NULL);
+  srsran_rf_close(&ue_radio);
+
+  // The simulated time is given by the number of received samples
+  double simulated_s = (double)(NUM_SF * SF_LEN) / BASE_SRATE;
+  double wall_s      = elapsed_s(&start, &end);
+  printf("received %d subframes, simulated %.3f s in %.3f s\n", i, simulated_s, wall_s);
+
+  if (i != NUM_SF) {
+    fprintf(stderr, "Virtual time test failed to receive all subframes\n");
+  } else if (wall_s * MIN_SPEEDUP > simulated_s) {
+    fprintf(stderr, "Virtual time did not advance faster than real-time\n");
+  } else {
+    ret = SRSRAN_SUCCESS;
+  }
+
+  return ret;
+}
@@ -59,12 +59,19 @@ static int ssb_init_corr(srsran_ssb_t* q)
   for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2_NR; N_id_2++) {
     // Allocate sequences
     q->pss_seq[N_id_2] = srsran_vec_cf_malloc(q->max_corr_sz);
-    if (q->pss_seq[N_id_2] == NULL) {
+    q->pss_pwr[N_id_2] = srsran_vec_f_malloc(q->max_corr_sz);
+    if (q->pss_seq[N_id_2] == NULL || q->pss_pwr[N_id_2] == NULL) {
       ERROR("Malloc");
       return SRSRAN_ERROR;
     }
   }
 
+  q->tmp_pwr = srsran_vec_f_malloc(q->max_corr_sz);
+  if (q->tmp_pwr == NULL) {
+    ERROR("Malloc");
+    return SRSRAN_ERROR;
+  }
+
   q->sf_buffer = srsran_vec_cf_malloc(q->max_ssb_sz + q->max_sf_sz);
   if (q->sf_buffer == NULL) {
     ERROR("Malloc");
@@ -159,6 +166,13 @@ void srsran_ssb_free(srsran_ssb_t* q)
     if (q->pss_seq[N_id_2] != NULL) {
       free(q->pss_seq[N_id_2]);
     }
+    if (q->pss_pwr[N_id_2] != NULL) {
+      free(q->pss_pwr[N_id_2]);
+    }
+  }
+
+  if (q->tmp_pwr != NULL) {
+    free(q->tmp_pwr);
   }
 
   if (q->sf_buffer != NULL) {
@@ -338,6 +352,45 @@ static void ssb_modulate_symbol(srsran_ssb_t* q, cf_t ssb_grid[SRSRAN_SSB_NOF_RE
   }
 }
 
+static int ssb_setup_corr_seq(srsran_ssb_t* q)
+{
+  // Skip if the sequences were already generated for the current frequency offset
+  if (q->corr_f_offset == q->f_offset) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Zero the time domain signal last samples
+  srsran_vec_cf_zero(&q->tmp_time[q->symbol_sz], q->corr_window);
+
+  // Temporal grid
+  cf_t ssb_grid[SRSRAN_SSB_NOF_RE] = {};
+
+  // Initialise correlation sequence
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2_NR; N_id_2++) {
+    // Put the PSS in SSB grid
+    if (srsran_pss_nr_put(ssb_grid, N_id_2, 1.0f) < SRSRAN_SUCCESS) {
+      ERROR("Error putting PDD N_id_2=%d", N_id_2);
+      return SRSRAN_ERROR;
+    }
+
+    // Modulate symbol with PSS
+    ssb_modulate_symbol(q, ssb_grid, SRSRAN_PSS_NR_SYMBOL_IDX);
+
+    // Convert to frequency domain
+    srsran_dft_run_guru_c(&q->fft_corr);
+
+    // Copy frequency domain sequence
+    srsran_vec_cf_copy(q->pss_seq[N_id_2], q->tmp_freq, q->corr_sz);
+
+    // Store the sequence power for normalising the correlation
+    srsran_vec_abs_square_cf(q->pss_seq[N_id_2], q->pss_pwr[N_id_2], q->corr_sz);
+  }
+
+  q->corr_f_offset = q->f_offset;
+
+  return SRSRAN_SUCCESS;
+}
+
 static int ssb_setup_corr(srsran_ssb_t* q)
 {
   // Skip if disabled
@@ -348,9 +401,9 @@ static int ssb_setup_corr(srsran_ssb_t* q)
   // Compute new correlation size
   uint32_t corr_sz = SSB_CORR_SZ(q->symbol_sz);
 
-  // Skip if the symbol size is unchanged
+  // Only regenerate the sequences if the symbol size is unchanged
   if (q->corr_sz == corr_sz) {
-    return SRSRAN_SUCCESS;
+    return ssb_setup_corr_seq(q);
   }
   q->corr_sz = corr_sz;
 
@@ -377,31 +430,10 @@ static int ssb_setup_corr(srsran_ssb_t* q)
     return SRSRAN_ERROR;
   }
 
-  // Zero the time domain signal last samples
-  srsran_vec_cf_zero(&q->tmp_time[q->symbol_sz], q->corr_window);
-
-  // Temporal grid
-  cf_t ssb_grid[SRSRAN_SSB_NOF_RE] = {};
-
-  // Initialise correlation sequence
-  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2_NR; N_id_2++) {
-    // Put the PSS in SSB grid
-    if (srsran_pss_nr_put(ssb_grid, N_id_2, 1.0f) < SRSRAN_SUCCESS) {
-      ERROR("Error putting PDD N_id_2=%d", N_id_2);
-      return SRSRAN_ERROR;
-    }
-
-    // Modulate symbol with PSS
-    ssb_modulate_symbol(q, ssb_grid, SRSRAN_PSS_NR_SYMBOL_IDX);
+  // Force the sequences generation
+  q->corr_f_offset = INT32_MAX;
 
-    // Convert to frequency domain
-    srsran_dft_run_guru_c(&q->fft_corr);
-
-    // Copy frequency domain sequence
-    srsran_vec_cf_copy(q->pss_seq[N_id_2], q->tmp_freq, q->corr_sz);
-  }
-
-  return SRSRAN_SUCCESS;
+  return ssb_setup_corr_seq(q);
 }
 
 static inline int ssb_get_t_offset(srsran_ssb_t* q, uint32_t ssb_idx)
@@ -850,12 +882,61 @@ static void ssb_vec_prod_conj_circ_shift(const cf_t* a, const cf_t* b, cf_t* c,
   srsran_vec_prod_conj_ccc(a, b, c, n);
 }
 
-static int ssb_pss_search(srsran_ssb_t* q,
-                          const cf_t*   in,
-                          uint32_t      nof_samples,
-                          uint32_t*     found_N_id_2,
-                          uint32_t*     found_delay,
-                          float*        coarse_cfo_hz)
+static float ssb_vec_dot_prod_circ_shift(const float* a, const float* b, uint32_t n, int shift)
+{
+  uint32_t offset = (uint32_t)abs(shift);
+
+  // Avoid negative number of samples
+  if (offset > n) {
+    return 0.0f;
+  }
+
+  // Shift is negative
+  if (shift < 0) {
+    return srsran_vec_dot_prod_fff(&a[offset], &b[0], n - offset) +
+           srsran_vec_dot_prod_fff(&a[0], &b[n - offset], offset);
+  }
+
+  // Shift is positive
+  if (shift > 0) {
+    return srsran_vec_dot_prod_fff(&a[0], &b[offset], n - offset) +
+           srsran_vec_dot_prod_fff(&a[n - offset], &b[0], offset);
+  }
+
+  // Shift is zero
+  return srsran_vec_dot_prod_fff(a, b, n);
+}
+
+/*
+ * PSS search candidate, the PSS sequences generated for the current frequency offset are circularly shifted by
+ * ref_shift correlation bins to reach the candidate SSB center frequency
+ */
+typedef struct {
+  int      ref_shift;   // Correlation bins shift between the configured SSB frequency and the candidate
+  double   ref_cfo_hz;  // Frequency offset of the reference shift with respect to the candidate center frequency
+  float    best_corr;   // Best normalised correlation
+  uint32_t best_delay;  // Delay of the best correlation
+  uint32_t best_N_id_2; // N_id_2 of the best correlation
+  int      best_shift;  // Shift of the best correlation, relative to the reference shift
+} ssb_pss_search_cand_t;
+
+// Wraps a circular shift in the range (-n/2, n/2]
+static inline int ssb_wrap_shift(int shift, uint32_t n)
+{
+  while (shift > (int)n / 2) {
+    shift -= (int)n;
+  }
+  while (shift <= -(int)n / 2) {
+    shift += (int)n;
+  }
+  return shift;
+}
+
+static int ssb_pss_search_multi(srsran_ssb_t*          q,
+                                const cf_t*            in,
+                                uint32_t               nof_samples,
+                                ssb_pss_search_cand_t* cand,
+                                uint32_t               nof_cand)
 {
   // verify it is initialised
   if (q->corr_sz == 0) {
@@ -871,11 +952,13 @@ static int ssb_pss_search(srsran_ssb_t* q,
   // Calculate the coarse shift increment for half of the subcarrier spacing
   int shift_coarse_inc = shift_range / 2;
 
-  // Correlation best sequence
-  float    best_corr   = 0;
-  uint32_t best_delay  = 0;
-  uint32_t best_N_id_2 = 0;
-  int      best_shift  = 0;
+  // Reset candidates best correlation
+  for (uint32_t c = 0; c < nof_cand; c++) {
+    cand[c].best_corr   = 0.0f;
+    cand[c].best_delay  = 0;
+    cand[c].best_N_id_2 = 0;
+    cand[c].best_shift  = 0;
+  }
 
   // Delay in correlation window
   uint32_t t_offset = 0;
@@ -896,38 +979,46 @@ static int ssb_pss_search(srsran_ssb_t* q,
       srsran_vec_cf_zero(&q->tmp_time[n], q->corr_sz - n);
     }
 
-    // Convert to frequency domain
+    // Convert to frequency domain, only once for all the candidates
     srsran_dft_run_guru_c(&q->fft_corr);
 
-    // Try each N_id_2 sequence
-    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2_NR; N_id_2++) {
-      // Steer coarse frequency offset
-      for (int shift = -shift_range; shift <= shift_range; shift += shift_coarse_inc) {
-        // Actual correlation in frequency domain
-        ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[N_id_2], q->tmp_corr, q->corr_sz, shift);
-
-        // Convert to time domain
-        srsran_dft_run_guru_c(&q->ifft_corr);
-
-        // Find maximum
-        uint32_t peak_idx = srsran_vec_max_abs_ci(q->tmp_time, q->corr_window);
-
-        // Average power, take total power of the frequency domain signal after filtering, skip correlation window if
-        // value is invalid (0.0, nan or inf)
-        float avg_pwr_corr = srsran_vec_avg_power_cf(q->tmp_corr, q->corr_sz);
-        if (!isnormal(avg_pwr_corr)) {
-          continue;
-        }
-
-        // Normalise correlation
-        float corr = SRSRAN_CSQABS(q->tmp_time[peak_idx]) / avg_pwr_corr / sqrtf(SRSRAN_PSS_NR_LEN);
-
-        // Update if the correlation is better than the current best
-        if (best_corr < corr) {
-          best_corr   = corr;
-          best_delay  = peak_idx + t_offset;
-          best_N_id_2 = N_id_2;
-          best_shift  = shift;
+    // Compute the window power, the correlation average power is the power of the window weighted by the sequence power
+    srsran_vec_abs_square_cf(q->tmp_freq, q->tmp_pwr, q->corr_sz);
+
+    for (uint32_t c = 0; c < nof_cand; c++) {
+      // Try each N_id_2 sequence
+      for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2_NR; N_id_2++) {
+        // Steer coarse frequency offset
+        for (int shift = -shift_range; shift <= shift_range; shift += shift_coarse_inc) {
+          int total_shift = ssb_wrap_shift(cand[c].ref_shift + shift, q->corr_sz);
+
+          // Actual correlation in frequency domain
+          ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[N_id_2], q->tmp_corr, q->corr_sz, total_shift);
+
+          // Convert to time domain
+          srsran_dft_run_guru_c(&q->ifft_corr);
+
+          // Find maximum
+          uint32_t peak_idx = srsran_vec_max_abs_ci(q->tmp_time, q->corr_window);
+
+          // Average power, take total power of the frequency domain signal after filtering, skip correlation window if
+          // value is invalid (0.0, nan or inf)
+          float avg_pwr_corr =
+              ssb_vec_dot_prod_circ_shift(q->tmp_pwr, q->pss_pwr[N_id_2], q->corr_sz, total_shift) / (float)q->corr_sz;
+          if (!isnormal(avg_pwr_corr)) {
+            continue;
+          }
+
+          // Normalise correlation
+          float corr = SRSRAN_CSQABS(q->tmp_time[peak_idx]) / avg_pwr_corr / sqrtf(SRSRAN_PSS_NR_LEN);
+
+          // Update if the correlation is better than the current best
+          if (cand[c].best_corr < corr) {
+            cand[c].best_corr   = corr;
+            cand[c].best_delay  = peak_idx + t_offset;
+            cand[c].best_N_id_2 = N_id_2;
+            cand[c].best_shift  = shift;
+          }
         }
       }
     }
@@ -937,20 +1028,20 @@ static int ssb_pss_search(srsran_ssb_t* q,
   }
 
   // From the best sequence correlate in frequency domain
-  {
+  for (uint32_t c = 0; c < nof_cand; c++) {
     // Reset best correlation
-    best_corr = 0.0f;
+    float best_corr = 0.0f;
 
     // Number of samples taken in this iteration
     uint32_t n = q->corr_sz;
 
     // Detect if the correlation input exceeds the input length, take the maximum amount of samples
-    if (best_delay + q->corr_sz > nof_samples) {
-      n = nof_samples - best_delay;
+    if (cand[c].best_delay + q->corr_sz > nof_samples) {
+      n = nof_samples - cand[c].best_delay;
     }
 
     // Copy the amount of samples
-    srsran_vec_cf_copy(q->tmp_time, &in[best_delay], n);
+    srsran_vec_cf_copy(q->tmp_time, &in[cand[c].best_delay], n);
 
     // Append zeros if there is space left
     if (n < q->corr_sz) {
@@ -961,24 +1052,42 @@ static int ssb_pss_search(srsran_ssb_t* q,
     srsran_dft_run_guru_c(&q->fft_corr);
 
     for (int shift = -shift_range; shift <= shift_range; shift++) {
+      int total_shift = ssb_wrap_shift(cand[c].ref_shift + shift, q->corr_sz);
+
       // Actual correlation in frequency domain
-      ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[best_N_id_2], q->tmp_corr, q->corr_sz, shift);
+      ssb_vec_prod_conj_circ_shift(q->tmp_freq, q->pss_seq[cand[c].best_N_id_2], q->tmp_corr, q->corr_sz, total_shift);
 
       // Calculate correlation assuming the peak is in the first sample
       float corr = SRSRAN_CSQABS(srsran_vec_acc_cc(q->tmp_corr, q->corr_sz));
 
       // Update if the correlation is better than the current best
       if (best_corr < corr) {
-        best_corr  = corr;
-        best_shift = shift;
+        best_corr          = corr;
+        cand[c].best_shift = shift;
       }
     }
   }
 
+  return SRSRAN_SUCCESS;
+}
+
+static int ssb_pss_search(srsran_ssb_t* q,
+                          const cf_t*   in,
+                          uint32_t      nof_samples,
+                          uint32_t*     found_N_id_2,
+                          uint32_t*     found_delay,
+                          float*        coarse_cfo_hz)
+{
+  // Search the configured SSB frequency only
+  ssb_pss_search_cand_t cand = {};
+  if (ssb_pss_search_multi(q, in, nof_samples, &cand, 1) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
   // Save findings
-  *found_delay   = best_delay;
-  *found_N_id_2  = best_N_id_2;
-  *coarse_cfo_hz = -(float)best_shift * coarse_cfo_ref_hz;
+  *found_delay   = cand.best_delay;
+  *found_N_id_2  = cand.best_N_id_2;
+  *coarse_cfo_hz = (float)(-(double)cand.best_shift * (q->cfg.srate_hz / q->corr_sz));
 
   return SRSRAN_SUCCESS;
 }
@@ -1267,32 +1376,15 @@ int srsran_ssb_decode_pbch(srsran_ssb_t*         q,
   return SRSRAN_SUCCESS;
 }
 
-int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srsran_ssb_search_res_t* res)
+// Decodes the SSB found by the PSS search for the current frequency offset
+static int ssb_search_decode(srsran_ssb_t*            q,
+                             const cf_t*              in,
+                             uint32_t                 nof_samples,
+                             uint32_t                 N_id_2,
+                             uint32_t                 t_offset,
+                             float                    coarse_cfo_hz,
+                             srsran_ssb_search_res_t* res)
 {
-  // Verify inputs
-  if (q == NULL || in == NULL || res == NULL || !isnormal(q->scs_hz)) {
-    return SRSRAN_ERROR_INVALID_INPUTS;
-  }
-
-  if (!q->args.enable_search || !q->args.enable_decode) {
-    ERROR("SSB is not configured to search (%c) and decode (%c)",
-          q->args.enable_search ? 'y' : 'n',
-          q->args.enable_decode ? 'y' : 'n');
-    return SRSRAN_ERROR;
-  }
-
-  // Set the SSB search result with default value with PBCH CRC unmatched, meaning no cell is found
-  SRSRAN_MEM_ZERO(res, srsran_ssb_search_res_t, 1);
-
-  // Search for PSS in time domain
-  uint32_t N_id_2        = 0;
-  uint32_t t_offset      = 0;
-  float    coarse_cfo_hz = 0.0f;
-  if (ssb_pss_search(q, in, nof_samples, &N_id_2, &t_offset, &coarse_cfo_hz) < SRSRAN_SUCCESS) {
-    ERROR("Error searching for N_id_2");
-    return SRSRAN_ERROR;
-  }
-
   // Remove CP offset prior demodulation
   if (t_offset >= q->cp_sz) {
     t_offset -= q->cp_sz;
@@ -1366,6 +1458,109 @@ int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srs
   return SRSRAN_SUCCESS;
 }
 
+int srsran_ssb_search(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, srsran_ssb_search_res_t* res)
+{
+  // Verify inputs
+  if (q == NULL || in == NULL || res == NULL || !isnormal(q->scs_hz)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!q->args.enable_search || !q->args.enable_decode) {
+    ERROR("SSB is not configured to search (%c) and decode (%c)",
+          q->args.enable_search ? 'y' : 'n',
+          q->args.enable_decode ? 'y' : 'n');
+    return SRSRAN_ERROR;
+  }
+
+  // Set the SSB search result with default value with PBCH CRC unmatched, meaning no cell is found
+  SRSRAN_MEM_ZERO(res, srsran_ssb_search_res_t, 1);
+
+  // Search for PSS in time domain
+  uint32_t N_id_2        = 0;
+  uint32_t t_offset      = 0;
+  float    coarse_cfo_hz = 0.0f;
+  if (ssb_pss_search(q, in, nof_samples, &N_id_2, &t_offset, &coarse_cfo_hz) < SRSRAN_SUCCESS) {
+    ERROR("Error searching for N_id_2");
+    return SRSRAN_ERROR;
+  }
+
+  return ssb_search_decode(q, in, nof_samples, N_id_2, t_offset, coarse_cfo_hz, res);
+}
+
+int srsran_ssb_search_multi(srsran_ssb_t*            q,
+                            const cf_t*              in,
+                            uint32_t                 nof_samples,
+                            const double*            ssb_freq_hz,
+                            uint32_t                 nof_freq,
+                            srsran_ssb_search_res_t* res)
+{
+  // Verify inputs
+  if (q == NULL || in == NULL || ssb_freq_hz == NULL || res == NULL || !isnormal(q->scs_hz) ||
+      nof_freq > SRSRAN_SSB_SEARCH_MAX_NOF_FREQ) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!q->args.enable_search || !q->args.enable_decode) {
+    ERROR("SSB is not configured to search (%c) and decode (%c)",
+          q->args.enable_search ? 'y' : 'n',
+          q->args.enable_decode ? 'y' : 'n');
+    return SRSRAN_ERROR;
+  }
+
+  // Verify it is initialised
+  if (q->corr_sz == 0) {
+    return SRSRAN_ERROR;
+  }
+
+  // Set the SSB search results with default value with PBCH CRC unmatched, meaning no cell is found
+  SRSRAN_MEM_ZERO(res, srsran_ssb_search_res_t, nof_freq);
+
+  // Correlation bin width in Hz
+  double corr_bin_hz = q->cfg.srate_hz / q->corr_sz;
+
+  // Compute the frequency offset of each candidate, it must fit in the base-band bandwidth
+  int32_t               f_offset[SRSRAN_SSB_SEARCH_MAX_NOF_FREQ] = {};
+  ssb_pss_search_cand_t cand[SRSRAN_SSB_SEARCH_MAX_NOF_FREQ]     = {};
+  for (uint32_t i = 0; i < nof_freq; i++) {
+    double freq_offset_hz = ssb_freq_hz[i] - q->cfg.center_freq_hz;
+    f_offset[i]           = (int32_t)round(freq_offset_hz / q->scs_hz);
+
+    if (fabs((double)f_offset[i] * q->scs_hz - freq_offset_hz) > SSB_FREQ_OFFSET_MAX_ERROR_HZ) {
+      ERROR("SSB Offset (%.1f kHz) error exceeds maximum allowed", freq_offset_hz / 1e3);
+      return SRSRAN_ERROR;
+    }
+
+    if (abs(f_offset[i]) + SRSRAN_SSB_BW_SUBC / 2 > q->symbol_sz / 2) {
+      ERROR("SSB Offset (%.1f kHz) exceeds the base-band bandwidth", freq_offset_hz / 1e3);
+      return SRSRAN_ERROR;
+    }
+
+    // Distance to the configured SSB frequency, the PSS sequences are generated for it
+    double delta_hz    = (double)(f_offset[i] - q->f_offset) * q->scs_hz;
+    cand[i].ref_shift  = -(int)round(delta_hz / corr_bin_hz);
+    cand[i].ref_cfo_hz = -(double)cand[i].ref_shift * corr_bin_hz - delta_hz;
+  }
+
+  // Search for PSS in time domain for all the candidates
+  if (ssb_pss_search_multi(q, in, nof_samples, cand, nof_freq) < SRSRAN_SUCCESS) {
+    ERROR("Error searching for N_id_2");
+    return SRSRAN_ERROR;
+  }
+
+  // Decode each of the candidates, the demodulation uses the candidate frequency offset
+  int32_t f_offset_cfg = q->f_offset;
+  int     ret          = SRSRAN_SUCCESS;
+  for (uint32_t i = 0; i < nof_freq && ret == SRSRAN_SUCCESS; i++) {
+    float coarse_cfo_hz = (float)(-(double)cand[i].best_shift * corr_bin_hz + cand[i].ref_cfo_hz);
+
+    q->f_offset = f_offset[i];
+    ret = ssb_search_decode(q, in, nof_samples, cand[i].best_N_id_2, cand[i].best_delay, coarse_cfo_hz, &res[i]);
+  }
+  q->f_offset = f_offset_cfg;
+
+  return ret;
+}
+
 static int ssb_pss_find(srsran_ssb_t* q, const cf_t* in, uint32_t nof_samples, uint32_t N_id_2, uint32_t* found_delay)
 {
   // verify it is initialised
@@ -134,9 +134,10 @@ static void gen_pbch_msg(srsran_pbch_msg_nr_t* pbch_msg, uint32_t ssb_idx)
 static int test_case_true(srsran_ssb_t* ssb)
 {
   // For benchmarking purposes
-  uint64_t t_encode_usec = 0;
-  uint64_t t_decode_usec = 0;
-  uint64_t t_search_usec = 0;
+  uint64_t t_encode_usec       = 0;
+  uint64_t t_decode_usec       = 0;
+  uint64_t t_search_usec       = 0;
+  uint64_t t_search_multi_usec = 0;
 
   // SSB configuration
   srsran_ssb_cfg_t ssb_cfg = {};
@@ -208,6 +209,24 @@ static int test_case_true(srsran_ssb_t* ssb)
       // Assert PBCH message CRC
       TESTASSERT(res.pbch_msg.crc);
       TESTASSERT(memcmp(&res.pbch_msg, &pbch_msg_tx, sizeof(srsran_pbch_msg_nr_t)) == 0);
+
+      // Search in the SSB frequency and, if it is different, its mirror about the center frequency where no SSB is
+      // transmitted
+      double                  multi_freq_hz[2] = {ssb_freq_hz, 2.0 * carrier_freq_hz - ssb_freq_hz};
+      uint32_t                nof_multi_freq   = (multi_freq_hz[0] != multi_freq_hz[1]) ? 2 : 1;
+      srsran_ssb_search_res_t multi_res[2]     = {};
+      gettimeofday(&t[1], NULL);
+      TESTASSERT(srsran_ssb_search_multi(ssb, buffer, hf_len, multi_freq_hz, nof_multi_freq, multi_res) ==
+                 SRSRAN_SUCCESS);
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      t_search_multi_usec += t[0].tv_usec + t[0].tv_sec * 1000000UL;
+
+      // Assert the SSB is found only in its frequency
+      TESTASSERT(multi_res[0].pbch_msg.crc);
+      TESTASSERT(multi_res[0].N_id == pci);
+      TESTASSERT(memcmp(&multi_res[0].pbch_msg, &pbch_msg_tx, sizeof(srsran_pbch_msg_nr_t)) == 0);
+      TESTASSERT(!multi_res[1].pbch_msg.crc);
     }
   }
 
@@ -216,10 +235,11 @@ static int test_case_true(srsran_ssb_t* ssb)
     return SRSRAN_ERROR;
   }
 
-  INFO("test_case_true - %.1f usec/encode; %.1f usec/decode; %.1f usec/decode;",
+  INFO("test_case_true - %.1f usec/encode; %.1f usec/decode; %.1f usec/decode; %.1f usec/multi-decode;",
        (double)t_encode_usec / (double)(count),
        (double)t_decode_usec / (double)(count),
-       (double)t_search_usec / (double)(count));
+       (double)t_search_usec / (double)(count),
+       (double)t_search_multi_usec / (double)(count));
 
   return SRSRAN_SUCCESS;
 }
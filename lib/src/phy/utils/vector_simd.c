@@ -796,6 +796,51 @@ cf_t srsran_vec_dot_prod_ccc_simd(const cf_t* x, const cf_t* y, const int len)
   return result;
 }
 
+cf_t srsran_vec_dot_prod_cfc_simd(const cf_t* x, const float* y, const int len)
+{
+  int  i      = 0;
+  cf_t result = 0;
+
+#if SRSRAN_SIMD_CF_SIZE
+  if (len >= SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t avx_result = srsran_simd_cf_zero();
+    if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(y)) {
+      for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+        simd_cf_t xVal = srsran_simd_cfi_load(&x[i]);
+        simd_f_t  yVal = srsran_simd_f_load(&y[i]);
+
+        avx_result = srsran_simd_cf_add(srsran_simd_cf_mul(xVal, yVal), avx_result);
+      }
+    } else {
+      for (; i < len - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+        simd_cf_t xVal = srsran_simd_cfi_loadu(&x[i]);
+        simd_f_t  yVal = srsran_simd_f_loadu(&y[i]);
+
+        avx_result = srsran_simd_cf_add(srsran_simd_cf_mul(xVal, yVal), avx_result);
+      }
+    }
+
+    __attribute__((aligned(64))) float simd_dotProdVector[SRSRAN_SIMD_CF_SIZE];
+    simd_f_t                           acc_re = srsran_simd_cf_re(avx_result);
+    simd_f_t                           acc_im = srsran_simd_cf_im(avx_result);
+
+    simd_f_t acc = srsran_simd_f_hadd(acc_re, acc_im);
+    for (int j = 2; j < SRSRAN_SIMD_F_SIZE; j *= 2) {
+      acc = srsran_simd_f_hadd(acc, acc);
+    }
+    srsran_simd_f_store(simd_dotProdVector, acc);
+    __real__ result = simd_dotProdVector[0];
+    __imag__ result = simd_dotProdVector[1];
+  }
+#endif
+
+  for (; i < len; i++) {
+    result += (x[i] * y[i]);
+  }
+
+  return result;
+}
+
 #ifdef ENABLE_C16
 c16_t srsran_vec_dot_prod_ccc_c16i_simd(const c16_t* x, const c16_t* y, const int len)
 {
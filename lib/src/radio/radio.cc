@@ -24,12 +24,24 @@
 #include "srsran/common/string_helpers.h"
 #include "srsran/config.h"
 #include "srsran/support/srsran_assert.h"
+#include <chrono>
 #include <list>
 #include <string>
 #include <unistd.h>
 
 namespace srsran {
 
+// Greatest common divisor of two sampling rates in Hz
+static uint32_t srate_gcd(uint32_t a, uint32_t b)
+{
+  while (b != 0) {
+    uint32_t r = a % b;
+    a          = b;
+    b          = r;
+  }
+  return a;
+}
+
 radio::radio()
 {
   zeros.resize(SRSRAN_SF_LEN_MAX, 0);
@@ -47,6 +59,14 @@ radio::~radio()
   for (srsran_resampler_fft_t& q : decimators) {
     srsran_resampler_fft_free(&q);
   }
+
+  for (srsran_resampler_polyphase_t& q : pp_interpolators) {
+    srsran_resampler_polyphase_free(&q);
+  }
+
+  for (srsran_resampler_polyphase_t& q : pp_decimators) {
+    srsran_resampler_polyphase_free(&q);
+  }
 }
 
 int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
@@ -140,6 +160,7 @@ int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
 
   is_start_of_burst = true;
   is_initialized    = true;
+  metrics_tp        = std::chrono::steady_clock::now();
 
   // Set RF options
   tx_adv_auto = true;
@@ -153,6 +174,23 @@ int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
     continuous_tx = (args.continuous_tx == "yes");
   }
 
+  // Select the resampler for each channel, the last one in the list applies to the remaining channels
+  std::vector<std::string> resampler_list;
+  string_parse_list(args.resampler, ',', resampler_list);
+  all_polyphase = true;
+  for (uint32_t ch = 0; ch < nof_channels; ch++) {
+    std::string resampler = "fft";
+    if (not resampler_list.empty()) {
+      resampler = resampler_list[std::min(ch, (uint32_t)resampler_list.size() - 1)];
+    }
+    if (resampler != "fft" and resampler != "polyphase") {
+      logger.error("Invalid resampler '%s' for channel %d", resampler.c_str(), ch);
+      return SRSRAN_ERROR;
+    }
+    use_polyphase[ch] = (resampler == "polyphase");
+    all_polyphase &= use_polyphase[ch];
+  }
+
   // Set fixed gain options
   if (args.rx_gain < 0) {
     start_agc(false);
@@ -295,25 +333,34 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
 
   // Extract decimation ratio. As the decimation may take some time to set a new ratio, deactivate the decimation and
   // keep receiving samples to avoid stalling the RX stream
-  uint32_t ratio = 1; // No decimation by default
+  uint32_t interp = 1; // No resampling by default
+  uint32_t decim  = 1;
   if (decimator_busy) {
     lock.unlock();
-  } else if (decimators[0].ratio > 1) {
-    ratio = decimators[0].ratio;
+  } else {
+    interp = rx_interp;
+    decim  = rx_decim;
   }
+  bool resample = (interp != decim);
 
-  // Calculate number of samples, considering the decimation ratio
-  uint32_t nof_samples = buffer.get_nof_samples() * ratio;
+  // Calculate number of samples, considering the resampling ratio. The polyphase resampler carries the fractional output
+  // samples across calls, so its state gives the number of samples that produce the requested ones
+  uint32_t nof_samples = (uint32_t)(((uint64_t)buffer.get_nof_samples() * decim) / interp);
+  uint32_t pp_t0       = 0; // High rate time of the first output sample, relative to the first received sample
+  if (resample and all_polyphase) {
+    pp_t0       = pp_decimators[0].t;
+    nof_samples = srsran_resampler_polyphase_get_nof_input(&pp_decimators[0], buffer.get_nof_samples());
+  }
 
   // Check decimation buffer protection
-  if (ratio > 1 && nof_samples > rx_buffer[0].size()) {
+  if (resample && nof_samples > rx_buffer[0].size()) {
     // This is a corner case that could happen during sample rate change transitions, as it does not have a negative
     // impact, log it as info.
     fmt::memory_buffer buff;
     fmt::format_to(buff,
                    "Rx number of samples ({}/{}) exceeds buffer size ({})",
                    buffer.get_nof_samples(),
-                   buffer.get_nof_samples() * ratio,
+                   nof_samples,
                    rx_buffer[0].size());
     logger.info("%s", to_c_str(buff));
 
@@ -327,7 +374,7 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
   // If the interpolator have been set, interpolate
   for (uint32_t ch = 0; ch < nof_channels; ch++) {
     // Use rx buffer if decimator is required
-    buffer_rx.set(ch, ratio > 1 ? rx_buffer[ch].data() : buffer.get(ch));
+    buffer_rx.set(ch, resample ? rx_buffer[ch].data() : buffer.get(ch));
   }
 
   if (not radio_is_streaming) {
@@ -347,12 +394,27 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
   for (uint32_t device_idx = 0; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
     ret &= rx_dev(device_idx, buffer_rx, rxd_time.get_ptr(device_idx));
   }
+  rx_nof_samples += buffer_rx.get_nof_samples();
 
   // Perform decimation
-  if (ratio > 1) {
+  if (resample) {
+    uint32_t nof_output = buffer.get_nof_samples();
     for (uint32_t ch = 0; ch < nof_channels; ch++) {
       if (buffer.get(ch) and buffer_rx.get(ch)) {
-        srsran_resampler_fft_run(&decimators[ch], buffer_rx.get(ch), buffer.get(ch), buffer_rx.get_nof_samples());
+        if (use_polyphase[ch]) {
+          nof_output = srsran_resampler_polyphase_run(
+              &pp_decimators[ch], buffer_rx.get(ch), buffer.get(ch), buffer_rx.get_nof_samples());
+        } else {
+          srsran_resampler_fft_run(&decimators[ch], buffer_rx.get(ch), buffer.get(ch), buffer_rx.get_nof_samples());
+        }
+      }
+    }
+
+    // Deliver the samples the polyphase resampler produced, and the time of the first one
+    buffer.set_nof_samples(nof_output);
+    if (pp_t0 > 0) {
+      for (uint32_t device_idx = 0; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
+        srsran_timestamp_add(rxd_time.get_ptr(device_idx), 0, (double)pp_t0 / ((double)interp * cur_rx_srate));
       }
     }
   }
@@ -421,39 +483,45 @@ bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_tim
 {
   bool                         ret = true;
   std::unique_lock<std::mutex> lock(tx_mutex);
-  uint32_t                     ratio = interpolators[0].ratio;
+  bool                         resample = (tx_interp != tx_decim);
 
   // Get number of samples at the low rate
   uint32_t nof_samples = buffer.get_nof_samples();
 
   // Check that number of the interpolated samples does not exceed the buffer size
-  if (ratio > 1 && (size_t)nof_samples * (size_t)ratio > tx_buffer[0].size()) {
+  if (resample && SRSRAN_CEIL((size_t)nof_samples * tx_interp, tx_decim) > tx_buffer[0].size()) {
     // This is a corner case that could happen during sample rate change transitions, as it does not have a negative
     // impact, log it as info.
     fmt::memory_buffer buff;
     fmt::format_to(buff,
                    "Tx number of samples ({}/{}) exceeds buffer size ({})\n",
                    buffer.get_nof_samples(),
-                   buffer.get_nof_samples() * ratio,
+                   ((size_t)buffer.get_nof_samples() * tx_interp) / tx_decim,
                    tx_buffer[0].size());
     logger.info("%s", to_c_str(buff));
 
     // Limit number of samples to transmit
-    nof_samples = tx_buffer[0].size() / ratio;
+    nof_samples = (uint32_t)(((size_t)tx_buffer[0].size() * tx_decim) / tx_interp);
   }
 
   // If the interpolator have been set, interpolate
-  if (interpolators[0].ratio > 1) {
+  if (resample) {
+    uint32_t nof_output = (nof_samples * tx_interp) / tx_decim;
     for (uint32_t ch = 0; ch < nof_channels; ch++) {
       // Perform actual interpolation
-      srsran_resampler_fft_run(&interpolators[ch], buffer.get(ch), tx_buffer[ch].data(), nof_samples);
+      if (use_polyphase[ch]) {
+        nof_output =
+            srsran_resampler_polyphase_run(&pp_interpolators[ch], buffer.get(ch), tx_buffer[ch].data(), nof_samples);
+      } else {
+        srsran_resampler_fft_run(&interpolators[ch], buffer.get(ch), tx_buffer[ch].data(), nof_samples);
+      }
 
       // Set the buffer pointer
       buffer.set(ch, tx_buffer[ch].data());
     }
 
     // Set buffer size after applying the interpolation
-    buffer.set_nof_samples(nof_samples * ratio);
+    buffer.set_nof_samples(nof_output);
   }
 
   for (uint32_t device_idx = 0; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
@@ -746,17 +814,25 @@ void radio::set_rx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_rx_srate % (uint32_t)srate) == 0,
+    // Reduce the ratio between the PHY and the device sampling rates
+    uint32_t gcd = srate_gcd((uint32_t)cur_rx_srate, (uint32_t)srate);
+    rx_interp    = (uint32_t)srate / gcd;
+    rx_decim     = (uint32_t)cur_rx_srate / gcd;
+
+    // Assert ratio is integer, only the polyphase resampler supports fractional ratios
+    srsran_assert(all_polyphase or rx_interp == 1,
                   "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
                   cur_rx_srate / 1e6,
                   srate / 1e6,
                   cur_rx_srate / srate);
 
     // Update decimators
-    uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
     for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+      if (use_polyphase[ch]) {
+        srsran_resampler_polyphase_init(&pp_decimators[ch], rx_interp, rx_decim);
+      } else {
+        srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, rx_decim);
+      }
     }
 
     decimator_busy = false;
@@ -1002,17 +1078,25 @@ void radio::set_tx_srate(const double& srate)
       }
     }
 
-    // Assert ratio is integer
-    srsran_assert(((uint32_t)cur_tx_srate % (uint32_t)srate) == 0,
+    // Reduce the ratio between the device and the PHY sampling rates
+    uint32_t gcd = srate_gcd((uint32_t)cur_tx_srate, (uint32_t)srate);
+    tx_interp    = (uint32_t)cur_tx_srate / gcd;
+    tx_decim     = (uint32_t)srate / gcd;
+
+    // Assert ratio is integer, only the polyphase resampler supports fractional ratios
+    srsran_assert(all_polyphase or tx_decim == 1,
                   "The sampling rate ratio is not integer (%.2f MHz / %.2f MHz = %.3f)",
-                  cur_rx_srate / 1e6,
+                  cur_tx_srate / 1e6,
                   srate / 1e6,
-                  cur_rx_srate / srate);
+                  cur_tx_srate / srate);
 
     // Update interpolators
-    uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
     for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+      if (use_polyphase[ch]) {
+        srsran_resampler_polyphase_init(&pp_interpolators[ch], tx_interp, tx_decim);
+      } else {
+        srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, tx_interp);
+      }
     }
   } else {
     for (srsran_rf_t& rf_device : rf_devices) {
@@ -1042,6 +1126,16 @@ bool radio::get_metrics(rf_metrics_t* metrics)
   std::lock_guard<std::mutex> lock(metrics_mutex);
   *metrics   = rf_metrics;
   rf_metrics = {};
+
+  // Rate at which the received sample stream advances, counted in 1 ms subframes per wall-clock second. It stays at
+  // 1000 for real-time devices and reflects the achieved processing speed when the device runs in virtual time
+  std::chrono::steady_clock::time_point now         = std::chrono::steady_clock::now();
+  double                                elapsed_s   = std::chrono::duration<double>(now - metrics_tp).count();
+  uint64_t                              nof_samples = rx_nof_samples.exchange(0);
+  metrics_tp                                        = now;
+  if (std::isnormal(cur_rx_srate) and elapsed_s > 0.0) {
+    metrics->tti_rate = (float)((1000.0 * nof_samples) / (cur_rx_srate * elapsed_s));
+  }
   return true;
 }
 
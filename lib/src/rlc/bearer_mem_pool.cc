@@ -40,6 +40,16 @@ srsran::background_mem_pool* get_bearer_pool()
   return &pool;
 }
 
+srsran::background_mem_pool* get_window_page_pool()
+{
+  static background_mem_pool pool(16,
+                                  std::max(sizeof(rlc_window_page<rlc_amd_tx_pdu_nr, RLC_WINDOW_PAGE_SIZE>),
+                                           sizeof(rlc_window_page<rlc_amd_rx_sdu_nr_t, RLC_WINDOW_PAGE_SIZE>)),
+                                  8,
+                                  16);
+  return &pool;
+}
+
 void reserve_rlc_memblocks(size_t nof_blocks)
 {
   srsran::background_mem_pool* pool = get_bearer_pool();
@@ -56,4 +66,22 @@ void deallocate_rlc_bearer(void* p)
   get_bearer_pool()->deallocate_node(p);
 }
 
+void* allocate_rlc_window_page(std::size_t sz)
+{
+  srsran::background_mem_pool* pool = get_window_page_pool();
+  if (sz > pool->get_node_max_size()) {
+    return ::operator new(sz);
+  }
+  return pool->allocate_node(sz);
+}
+void deallocate_rlc_window_page(void* p, std::size_t sz)
+{
+  srsran::background_mem_pool* pool = get_window_page_pool();
+  if (sz > pool->get_node_max_size()) {
+    ::operator delete(p);
+    return;
+  }
+  pool->deallocate_node(p);
+}
+
 } // namespace srsran
@@ -20,7 +20,6 @@
  */
 
 #include "srsran/rlc/rlc.h"
-#include "srsran/common/rwlock_guard.h"
 #include "srsran/rlc/rlc_am_base.h"
 #include "srsran/rlc/rlc_tm.h"
 #include "srsran/rlc/rlc_um_lte.h"
@@ -28,20 +27,31 @@
 
 namespace srsran {
 
+qsbr_domain& rlc_qsbr_domain()
+{
+  static qsbr_domain domain;
+  return domain;
+}
+
 rlc::rlc(const char* logname) : logger(srslog::fetch_basic_logger(logname)), pool(byte_buffer_pool::get_instance())
 {
-  pthread_rwlock_init(&rwlock, NULL);
+  for (auto& slot : rlc_array) {
+    slot.store(nullptr, std::memory_order_relaxed);
+  }
+  for (auto& slot : rlc_array_mrb) {
+    slot.store(nullptr, std::memory_order_relaxed);
+  }
 }
 
 rlc::~rlc()
 {
-  // destroy all remaining entities
-  {
-    srsran::rwlock_write_guard lock(rwlock);
-    rlc_array.clear();
-    rlc_array_mrb.clear();
+  // destroy all remaining entities. The owner guarantees that no other thread accesses this object anymore
+  for (auto& slot : rlc_array) {
+    delete slot.exchange(nullptr);
+  }
+  for (auto& slot : rlc_array_mrb) {
+    delete slot.exchange(nullptr);
   }
-  pthread_rwlock_destroy(&rwlock);
 }
 
 void rlc::init(srsue::pdcp_interface_rlc* pdcp_,
@@ -72,12 +82,19 @@ void rlc::init(srsue::pdcp_interface_rlc* pdcp_,
 
 void rlc::reset_metrics()
 {
-  for (rlc_map_t::iterator it = rlc_array.begin(); it != rlc_array.end(); ++it) {
-    it->second->reset_metrics();
+  rlc_read_guard guard;
+  for (auto& slot : rlc_array) {
+    rlc_common* entity = slot.load(std::memory_order_acquire);
+    if (entity != nullptr) {
+      entity->reset_metrics();
+    }
   }
 
-  for (rlc_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
-    it->second->reset_metrics();
+  for (auto& slot : rlc_array_mrb) {
+    rlc_common* entity = slot.load(std::memory_order_acquire);
+    if (entity != nullptr) {
+      entity->reset_metrics();
+    }
   }
 
   metrics_tp = std::chrono::high_resolution_clock::now();
@@ -85,11 +102,18 @@ void rlc::reset_metrics()
 
 void rlc::stop()
 {
-  for (rlc_map_t::iterator it = rlc_array.begin(); it != rlc_array.end(); ++it) {
-    it->second->stop();
+  rlc_read_guard guard;
+  for (auto& slot : rlc_array) {
+    rlc_common* entity = slot.load(std::memory_order_acquire);
+    if (entity != nullptr) {
+      entity->stop();
+    }
   }
-  for (rlc_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
-    it->second->stop();
+  for (auto& slot : rlc_array_mrb) {
+    rlc_common* entity = slot.load(std::memory_order_acquire);
+    if (entity != nullptr) {
+      entity->stop();
+    }
   }
 }
 
@@ -97,8 +121,19 @@ void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
 {
   std::chrono::duration<double> secs = std::chrono::high_resolution_clock::now() - metrics_tp;
 
-  for (rlc_map_t::iterator it = rlc_array.begin(); it != rlc_array.end(); ++it) {
-    rlc_bearer_metrics_t metrics = it->second->get_metrics();
+  {
+    // Metrics are collected periodically, free here the entities of the removed bearers too
+    std::lock_guard<std::mutex> lock(cfg_mutex);
+    retired_entities.reclaim();
+  }
+
+  rlc_read_guard guard;
+  for (uint32_t lcid = 0; lcid < rlc_array.size(); ++lcid) {
+    rlc_common* entity = rlc_array[lcid].load(std::memory_order_acquire);
+    if (entity == nullptr) {
+      continue;
+    }
+    rlc_bearer_metrics_t metrics = entity->get_metrics();
 
     // Rx/Tx rate based on real time
     double rx_rate_mbps_real_time = (metrics.num_rx_pdu_bytes * 8 / (double)1e6) / secs.count();
@@ -109,21 +144,25 @@ void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
     double tx_rate_mbps = (nof_tti > 0) ? ((metrics.num_tx_pdu_bytes * 8 / (double)1e6) / (nof_tti / 1000.0)) : 0.0;
 
     logger.debug("lcid=%d, rx_rate_mbps=%4.2f (real=%4.2f), tx_rate_mbps=%4.2f (real=%4.2f)",
-                 it->first,
+                 lcid,
                  rx_rate_mbps,
                  rx_rate_mbps_real_time,
                  tx_rate_mbps,
                  tx_rate_mbps_real_time);
-    m.bearer[it->first] = metrics;
+    m.bearer[lcid] = metrics;
   }
 
   // Add multicast metrics
-  for (rlc_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
-    rlc_bearer_metrics_t metrics = it->second->get_metrics();
+  for (uint32_t lcid = 0; lcid < rlc_array_mrb.size(); ++lcid) {
+    rlc_common* entity = rlc_array_mrb[lcid].load(std::memory_order_acquire);
+    if (entity == nullptr) {
+      continue;
+    }
+    rlc_bearer_metrics_t metrics = entity->get_metrics();
     logger.debug("MCH_LCID=%d, rx_rate_mbps=%4.2f",
-                 it->first,
+                 lcid,
                  (metrics.num_rx_pdu_bytes * 8 / static_cast<double>(1e6)) / secs.count());
-    m.bearer[it->first] = metrics;
+    m.bearer[lcid] = metrics;
   }
 
   reset_metrics();
@@ -132,12 +171,21 @@ void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
 // Reestablish all RLC bearer
 void rlc::reestablish()
 {
-  for (rlc_map_t::iterator it = rlc_array.begin(); it != rlc_array.end(); ++it) {
-    it->second->reestablish();
-  }
+  {
+    rlc_read_guard guard;
+    for (auto& slot : rlc_array) {
+      rlc_common* entity = slot.load(std::memory_order_acquire);
+      if (entity != nullptr) {
+        entity->reestablish();
+      }
+    }
 
-  for (rlc_map_t::iterator it = rlc_array_mrb.begin(); it != rlc_array_mrb.end(); ++it) {
-    it->second->reestablish();
+    for (auto& slot : rlc_array_mrb) {
+      rlc_common* entity = slot.load(std::memory_order_acquire);
+      if (entity != nullptr) {
+        entity->reestablish();
+      }
+    }
   }
 
   reset_metrics();
@@ -146,9 +194,11 @@ void rlc::reestablish()
 // Reestablish a specific RLC bearer
 void rlc::reestablish(uint32_t lcid)
 {
-  if (valid_lcid(lcid)) {
+  rlc_read_guard guard;
+  rlc_common*    entity = get_entity(lcid);
+  if (entity != nullptr) {
     logger.info("Reestablishing LCID %d", lcid);
-    rlc_array.at(lcid)->reestablish();
+    entity->reestablish();
   } else {
     logger.warning("RLC LCID %d doesn't exist.", lcid);
   }
@@ -159,8 +209,10 @@ void rlc::reestablish(uint32_t lcid)
 void rlc::reset()
 {
   {
-    rwlock_write_guard lock(rwlock);
-    rlc_array.clear();
+    std::lock_guard<std::mutex> lock(cfg_mutex);
+    for (auto& slot : rlc_array) {
+      remove_entity(slot);
+    }
     // the multicast bearer (MRB) is not removed here because eMBMS services continue to be streamed in idle mode (3GPP
     // TS 23.246 version 14.1.0 Release 14 section 8)
   }
@@ -172,13 +224,17 @@ void rlc::reset()
 void rlc::empty_queue()
 {
   // Empty Tx queue, not needed for MCH bearers
-  for (rlc_map_t::iterator it = rlc_array.begin(); it != rlc_array.end(); ++it) {
-    it->second->empty_queue();
+  rlc_read_guard guard;
+  for (auto& slot : rlc_array) {
+    rlc_common* entity = slot.load(std::memory_order_acquire);
+    if (entity != nullptr) {
+      entity->empty_queue();
+    }
   }
 }
 
 /*******************************************************************************
-  PDCP interface (called from Stack thread and therefore no lock required)
+  PDCP interface
 *******************************************************************************/
 
 void rlc::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu)
@@ -189,18 +245,45 @@ void rlc::write_sdu(uint32_t lcid, unique_byte_buffer_t sdu)
     return;
   }
 
-  if (valid_lcid(lcid)) {
-    rlc_array.at(lcid)->write_sdu_s(std::move(sdu));
-    update_bsr(lcid);
-  } else {
+  // The eNB may write SDUs from user plane threads while bearers are added or removed
+  rlc_read_guard guard;
+  rlc_common*    entity = get_entity(lcid);
+  if (entity == nullptr) {
     logger.warning("RLC LCID %d doesn't exist. Deallocating SDU", lcid);
+    return;
   }
+  entity->write_sdu_s(std::move(sdu));
+  update_bsr(lcid);
+}
+
+void rlc::write_sdu_batch(uint32_t lcid, srsran::span<unique_byte_buffer_t> sdus)
+{
+  for (unique_byte_buffer_t& sdu : sdus) {
+    if (sdu->N_bytes > RLC_MAX_SDU_SIZE) {
+      // Let write_sdu() drop the oversized SDUs
+      for (unique_byte_buffer_t& s : sdus) {
+        write_sdu(lcid, std::move(s));
+      }
+      return;
+    }
+  }
+
+  rlc_read_guard guard;
+  rlc_common*    entity = get_entity(lcid);
+  if (entity == nullptr) {
+    logger.warning("RLC LCID %d doesn't exist. Deallocating %zd SDUs", lcid, sdus.size());
+    return;
+  }
+  entity->write_sdu_batch_s(sdus);
+  update_bsr(lcid);
 }
 
 void rlc::write_sdu_mch(uint32_t lcid, unique_byte_buffer_t sdu)
 {
-  if (valid_lcid_mrb(lcid)) {
-    rlc_array_mrb.at(lcid)->write_sdu(std::move(sdu));
+  rlc_read_guard guard;
+  rlc_common*    entity = get_entity_mrb(lcid);
+  if (entity != nullptr) {
+    entity->write_sdu(std::move(sdu));
     update_bsr_mch(lcid);
   } else {
     logger.warning("RLC LCID %d doesn't exist. Deallocating SDU", lcid);
@@ -209,12 +292,15 @@ void rlc::write_sdu_mch(uint32_t lcid, unique_byte_buffer_t sdu)
 
 bool rlc::rb_is_um(uint32_t lcid)
 {
-  bool ret = false;
+  rlc_read_guard guard;
+  bool           ret    = false;
+  rlc_common*    entity = get_entity(lcid);
+  if (entity == nullptr) {
+    entity = get_entity_mrb(lcid);
+  }
 
-  if (valid_lcid(lcid)) {
-    ret = rlc_array.at(lcid)->get_mode() == rlc_mode_t::um;
-  } else if (valid_lcid_mrb(lcid)) {
-    ret = rlc_array_mrb.at(lcid)->get_mode() == rlc_mode_t::um;
+  if (entity != nullptr) {
+    ret = entity->get_mode() == rlc_mode_t::um;
   } else {
     logger.warning("LCID %d doesn't exist.", lcid);
   }
@@ -224,43 +310,48 @@ bool rlc::rb_is_um(uint32_t lcid)
 
 void rlc::discard_sdu(uint32_t lcid, uint32_t discard_sn)
 {
-  if (valid_lcid(lcid)) {
-    rlc_array.at(lcid)->discard_sdu(discard_sn);
-    update_bsr(lcid);
-  } else {
+  rlc_read_guard guard;
+  rlc_common*    entity = get_entity(lcid);
+  if (entity == nullptr) {
     logger.warning("RLC LCID %d doesn't exist. Ignoring discard SDU", lcid);
+    return;
   }
+  entity->discard_sdu(discard_sn);
+  update_bsr(lcid);
 }
 
 bool rlc::sdu_queue_is_full(uint32_t lcid)
 {
-  if (valid_lcid(lcid)) {
-    return rlc_array.at(lcid)->sdu_queue_is_full();
-  } else if (valid_lcid_mrb(lcid)) {
-    return rlc_array_mrb.at(lcid)->sdu_queue_is_full();
+  rlc_read_guard guard;
+  rlc_common*    entity = get_entity(lcid);
+  if (entity == nullptr) {
+    entity = get_entity_mrb(lcid);
+  }
+  if (entity != nullptr) {
+    return entity->sdu_queue_is_full();
   }
   logger.warning("RLC LCID %d doesn't exist. Ignoring queue check", lcid);
   return false;
 }
 
 /*******************************************************************************
-  MAC interface (mostly called from PHY workers, lock needs to be hold)
+  MAC interface (mostly called from PHY workers, without taking any lock)
 *******************************************************************************/
 bool rlc::has_data_locked(const uint32_t lcid)
 {
-  rwlock_read_guard lock(rwlock);
   return has_data(lcid);
 }
 
 void rlc::get_buffer_state(uint32_t lcid, uint32_t& tx_queue, uint32_t& prio_tx_queue)
 {
-  rwlock_read_guard lock(rwlock);
-  if (valid_lcid(lcid)) {
-    if (rlc_array.at(lcid)->is_suspended()) {
+  rlc_read_guard guard;
+  rlc_common*    entity = get_entity(lcid);
+  if (entity != nullptr) {
+    if (entity->is_suspended()) {
       tx_queue      = 0;
       prio_tx_queue = 0;
     } else {
-      rlc_array.at(lcid)->get_buffer_state(tx_queue, prio_tx_queue);
+      entity->get_buffer_state(tx_queue, prio_tx_queue);
     }
   }
 }
@@ -276,9 +367,10 @@ uint32_t rlc::get_total_mch_buffer_state(uint32_t lcid)
 {
   uint32_t ret = 0;
 
-  rwlock_read_guard lock(rwlock);
-  if (valid_lcid_mrb(lcid)) {
-    ret = rlc_array_mrb.at(lcid)->get_buffer_state();
+  rlc_read_guard guard;
+  rlc_common*    entity = get_entity_mrb(lcid);
+  if (entity != nullptr) {
+    ret = entity->get_buffer_state();
   }
 
   return ret;
@@ -288,9 +380,10 @@ uint32_t rlc::read_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
   uint32_t ret = 0;
 
-  rwlock_read_guard lock(rwlock);
-  if (valid_lcid(lcid)) {
-    ret = rlc_array.at(lcid)->read_pdu(payload, nof_bytes);
+  rlc_read_guard guard;
+  rlc_common*    entity = get_entity(lcid);
+  if (entity != nullptr) {
+    ret = entity->read_pdu(payload, nof_bytes);
     update_bsr(lcid);
   } else {
     logger.warning("LCID %d doesn't exist.", lcid);
@@ -305,9 +398,10 @@ uint32_t rlc::read_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
   uint32_t ret = 0;
 
-  rwlock_read_guard lock(rwlock);
-  if (valid_lcid_mrb(lcid)) {
-    ret = rlc_array_mrb.at(lcid)->read_pdu(payload, nof_bytes);
+  rlc_read_guard guard;
+  rlc_common*    entity = get_entity_mrb(lcid);
+  if (entity != nullptr) {
+    ret = entity->read_pdu(payload, nof_bytes);
     update_bsr_mch(lcid);
   } else {
     logger.warning("LCID %d doesn't exist.", lcid);
@@ -318,11 +412,12 @@ uint32_t rlc::read_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
   return ret;
 }
 
-// Write PDU methods are called from Stack thread context, no need to acquire the lock
 void rlc::write_pdu(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
-  if (valid_lcid(lcid)) {
-    rlc_array.at(lcid)->write_pdu_s(payload, nof_bytes);
+  rlc_read_guard guard;
+  rlc_common*    entity = get_entity(lcid);
+  if (entity != nullptr) {
+    entity->write_pdu_s(payload, nof_bytes);
     update_bsr(lcid);
   } else {
     logger.warning("LCID %d doesn't exist. Dropping PDU.", lcid);
@@ -360,20 +455,24 @@ void rlc::write_pdu_pcch(srsran::unique_byte_buffer_t pdu)
 
 void rlc::write_pdu_mch(uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
-  if (valid_lcid_mrb(lcid)) {
-    rlc_array_mrb.at(lcid)->write_pdu(payload, nof_bytes);
+  rlc_read_guard guard;
+  rlc_common*    entity = get_entity_mrb(lcid);
+  if (entity != nullptr) {
+    entity->write_pdu(payload, nof_bytes);
   }
 }
 
 /*******************************************************************************
-  RRC interface (write-lock ONLY needs to be hold for all calls modifying the RLC array)
+  RRC interface (cfg_mutex ONLY needs to be hold for all calls modifying the RLC arrays)
 *******************************************************************************/
 bool rlc::is_suspended(const uint32_t lcid)
 {
-  bool ret = false;
+  rlc_read_guard guard;
+  bool           ret    = false;
+  rlc_common*    entity = get_entity(lcid);
 
-  if (valid_lcid(lcid)) {
-    ret = rlc_array.at(lcid)->is_suspended();
+  if (entity != nullptr) {
+    ret = entity->is_suspended();
   }
 
   return ret;
@@ -381,20 +480,26 @@ bool rlc::is_suspended(const uint32_t lcid)
 
 bool rlc::has_data(uint32_t lcid)
 {
-  bool has_data = false;
+  rlc_read_guard guard;
+  bool           has_data = false;
+  rlc_common*    entity   = get_entity(lcid);
 
-  if (valid_lcid(lcid)) {
-    has_data = rlc_array.at(lcid)->has_data();
+  if (entity != nullptr) {
+    has_data = entity->has_data();
   }
 
   return has_data;
 }
 
-// Methods modifying the RLC array need to acquire the write-lock
+// Methods modifying the RLC arrays need to acquire cfg_mutex
 int rlc::add_bearer(uint32_t lcid, const rlc_config_t& cnfg)
 {
-  rwlock_write_guard lock(rwlock);
+  std::lock_guard<std::mutex> lock(cfg_mutex);
 
+  if (lcid >= SRSRAN_N_RADIO_BEARERS) {
+    logger.error("Radio bearer id must be in [0:%d] - %d", SRSRAN_N_RADIO_BEARERS, lcid);
+    return SRSRAN_ERROR;
+  }
   if (valid_lcid(lcid)) {
     logger.warning("LCID %d already exists", lcid);
     return SRSRAN_ERROR;
@@ -453,10 +558,8 @@ int rlc::add_bearer(uint32_t lcid, const rlc_config_t& cnfg)
 
   rlc_entity->set_bsr_callback(bsr_callback);
 
-  if (not rlc_array.emplace(lcid, std::move(rlc_entity)).second) {
-    logger.error("Error inserting RLC entity in to array.");
-    return SRSRAN_ERROR;
-  }
+  // The entity is fully configured before the readers can find it
+  rlc_array[lcid].store(rlc_entity.release(), std::memory_order_release);
 
   logger.info("Added %s radio bearer with LCID %d in %s", to_string(cnfg.rat), lcid, to_string(cnfg.rlc_mode));
 
@@ -465,7 +568,11 @@ int rlc::add_bearer(uint32_t lcid, const rlc_config_t& cnfg)
 
 int rlc::add_bearer_mrb(uint32_t lcid)
 {
-  rwlock_write_guard lock(rwlock);
+  std::lock_guard<std::mutex> lock(cfg_mutex);
+  if (lcid >= SRSRAN_N_MCH_LCIDS) {
+    logger.error("Radio bearer id must be in [0:%d] - %d", SRSRAN_N_MCH_LCIDS, lcid);
+    return SRSRAN_ERROR;
+  }
   if (not valid_lcid_mrb(lcid)) {
     std::unique_ptr<rlc_common> rlc_entity =
         std::unique_ptr<rlc_common>(new rlc_um_lte(logger, lcid, pdcp, rrc, timers));
@@ -475,12 +582,7 @@ int rlc::add_bearer_mrb(uint32_t lcid)
       return SRSRAN_ERROR;
     }
     rlc_entity->set_bsr_callback(bsr_callback);
-    if (rlc_array_mrb.count(lcid) == 0) {
-      if (not rlc_array_mrb.emplace(lcid, std::move(rlc_entity)).second) {
-        logger.error("Error inserting RLC entity in to array.");
-        return SRSRAN_ERROR;
-      }
-    }
+    rlc_array_mrb[lcid].store(rlc_entity.release(), std::memory_order_release);
     logger.info("Added bearer MRB%d with mode RLC_UM", lcid);
   } else {
     logger.info("Bearer MRB%d already created.", lcid);
@@ -491,12 +593,10 @@ int rlc::add_bearer_mrb(uint32_t lcid)
 
 void rlc::del_bearer(uint32_t lcid)
 {
-  rwlock_write_guard lock(rwlock);
+  std::lock_guard<std::mutex> lock(cfg_mutex);
 
   if (valid_lcid(lcid)) {
-    rlc_map_t::iterator it = rlc_array.find(lcid);
-    it->second->stop();
-    rlc_array.erase(it);
+    remove_entity(rlc_array[lcid]);
     logger.info("Deleted RLC bearer with LCID %d", lcid);
   } else {
     logger.error("Can't delete bearer with LCID %d. Bearer doesn't exist.", lcid);
@@ -505,12 +605,10 @@ void rlc::del_bearer(uint32_t lcid)
 
 void rlc::del_bearer_mrb(uint32_t lcid)
 {
-  rwlock_write_guard lock(rwlock);
+  std::lock_guard<std::mutex> lock(cfg_mutex);
 
   if (valid_lcid_mrb(lcid)) {
-    rlc_map_t::iterator it = rlc_array_mrb.find(lcid);
-    it->second->stop();
-    rlc_array_mrb.erase(it);
+    remove_entity(rlc_array_mrb[lcid]);
     logger.info("Deleted RLC MRB bearer with LCID %d", lcid);
   } else {
     logger.error("Can't delete bearer with LCID %d. Bearer doesn't exist.", lcid);
@@ -519,19 +617,14 @@ void rlc::del_bearer_mrb(uint32_t lcid)
 
 void rlc::change_lcid(uint32_t old_lcid, uint32_t new_lcid)
 {
-  rwlock_write_guard lock(rwlock);
+  std::lock_guard<std::mutex> lock(cfg_mutex);
 
   // make sure old LCID exists and new LCID is still free
-  if (valid_lcid(old_lcid) && not valid_lcid(new_lcid)) {
-    // insert old rlc entity into new LCID
-    rlc_map_t::iterator         it         = rlc_array.find(old_lcid);
-    std::unique_ptr<rlc_common> rlc_entity = std::move(it->second);
-    if (not rlc_array.emplace(new_lcid, std::move(rlc_entity)).second) {
-      logger.error("Error inserting RLC entity into array.");
-      return;
-    }
-    // erase from old position
-    rlc_array.erase(it);
+  if (valid_lcid(old_lcid) && new_lcid < SRSRAN_N_RADIO_BEARERS && not valid_lcid(new_lcid)) {
+    // insert old rlc entity into new LCID and erase it from old position. The entity stays alive, so the readers of
+    // the old LCID can finish their access
+    rlc_array[new_lcid].store(rlc_array[old_lcid].load(std::memory_order_relaxed), std::memory_order_release);
+    rlc_array[old_lcid].store(nullptr, std::memory_order_release);
 
     if (valid_lcid(new_lcid) && not valid_lcid(old_lcid)) {
       logger.info("Successfully changed LCID of RLC bearer from %d to %d", old_lcid, new_lcid);
@@ -545,11 +638,13 @@ void rlc::change_lcid(uint32_t old_lcid, uint32_t new_lcid)
   }
 }
 
-// Further RRC calls executed from Stack thread, no need to hold lock
+// Further RRC calls executed from Stack thread, no need to hold cfg_mutex
 void rlc::suspend_bearer(uint32_t lcid)
 {
-  if (valid_lcid(lcid)) {
-    if (rlc_array.at(lcid)->suspend()) {
+  rlc_read_guard guard;
+  rlc_common*    entity = get_entity(lcid);
+  if (entity != nullptr) {
+    if (entity->suspend()) {
       logger.info("Suspended radio bearer with LCID %d", lcid);
     } else {
       logger.error("Error suspending RLC entity: bearer already suspended.");
@@ -562,8 +657,10 @@ void rlc::suspend_bearer(uint32_t lcid)
 void rlc::resume_bearer(uint32_t lcid)
 {
   logger.info("Resuming radio LCID %d", lcid);
-  if (valid_lcid(lcid)) {
-    if (rlc_array.at(lcid)->resume()) {
+  rlc_read_guard guard;
+  rlc_common*    entity = get_entity(lcid);
+  if (entity != nullptr) {
+    if (entity->resume()) {
       logger.info("Resumed radio LCID %d", lcid);
     } else {
       logger.error("Error resuming RLC entity: bearer not suspended.");
@@ -580,34 +677,45 @@ bool rlc::has_bearer(uint32_t lcid)
 }
 
 /*******************************************************************************
-  Helpers (Lock must be hold when calling those)
+  Helpers
 *******************************************************************************/
 bool rlc::valid_lcid(uint32_t lcid)
+{
+  return get_entity(lcid) != nullptr;
+}
+
+bool rlc::valid_lcid_mrb(uint32_t lcid)
+{
+  return get_entity_mrb(lcid) != nullptr;
+}
+
+rlc_common* rlc::get_entity(uint32_t lcid)
 {
   if (lcid >= SRSRAN_N_RADIO_BEARERS) {
     logger.error("Radio bearer id must be in [0:%d] - %d", SRSRAN_N_RADIO_BEARERS, lcid);
-    return false;
+    return nullptr;
   }
-
-  if (rlc_array.find(lcid) == rlc_array.end()) {
-    return false;
-  }
-
-  return true;
+  return rlc_array[lcid].load(std::memory_order_acquire);
 }
 
-bool rlc::valid_lcid_mrb(uint32_t lcid)
+rlc_common* rlc::get_entity_mrb(uint32_t lcid)
 {
   if (lcid >= SRSRAN_N_MCH_LCIDS) {
-    logger.error("Radio bearer id must be in [0:%d] - %d", SRSRAN_N_RADIO_BEARERS, lcid);
-    return false;
+    logger.error("Radio bearer id must be in [0:%d] - %d", SRSRAN_N_MCH_LCIDS, lcid);
+    return nullptr;
   }
+  return rlc_array_mrb[lcid].load(std::memory_order_acquire);
+}
 
-  if (rlc_array_mrb.find(lcid) == rlc_array_mrb.end()) {
-    return false;
+// Unpublishes the entity of a bearer. It is stopped right away, but only deleted once the readers that might have
+// loaded it are done. cfg_mutex must be hold
+void rlc::remove_entity(std::atomic<rlc_common*>& slot)
+{
+  std::unique_ptr<rlc_common> entity(slot.exchange(nullptr, std::memory_order_acq_rel));
+  if (entity != nullptr) {
+    entity->stop();
+    retired_entities.retire(std::move(entity));
   }
-
-  return true;
 }
 
 void rlc::update_bsr(uint32_t lcid)
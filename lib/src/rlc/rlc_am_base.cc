@@ -142,6 +142,21 @@ void rlc_am::write_sdu(unique_byte_buffer_t sdu)
   }
 }
 
+void rlc_am::write_sdu_batch(srsran::span<unique_byte_buffer_t> sdus)
+{
+  uint32_t nof_bytes = 0;
+  for (const unique_byte_buffer_t& sdu : sdus) {
+    nof_bytes += sdu->N_bytes;
+  }
+  uint32_t nof_sdus = tx_base->write_sdu_batch(sdus);
+  for (const unique_byte_buffer_t& sdu : sdus.subspan(nof_sdus, sdus.size() - nof_sdus)) {
+    nof_bytes -= sdu->N_bytes;
+  }
+  std::lock_guard<std::mutex> lock(metrics_mutex);
+  metrics.num_tx_sdus += nof_sdus;
+  metrics.num_tx_sdu_bytes += nof_bytes;
+}
+
 void rlc_am::discard_sdu(uint32_t discard_sn)
 {
   tx_base->discard_sdu(discard_sn);
@@ -229,9 +244,8 @@ void rlc_am::set_bsr_callback(bsr_callback_t callback)
  *******************************************************/
 int rlc_am::rlc_am_base_tx::write_sdu(unique_byte_buffer_t sdu)
 {
-  std::lock_guard<std::mutex> lock(mutex);
-
-  if (!tx_enabled) {
+  // Only the SDU queue is touched, which is safe without the mutex
+  if (!tx_enabled.load(std::memory_order_acquire)) {
     return SRSRAN_ERROR;
   }
 
@@ -243,31 +257,42 @@ int rlc_am::rlc_am_base_tx::write_sdu(unique_byte_buffer_t sdu)
   // Get SDU info
   uint32_t sdu_pdcp_sn = sdu->md.pdcp_sn;
 
-  // Store SDU
-  uint8_t*                                 msg_ptr   = sdu->msg;
-  uint32_t                                 nof_bytes = sdu->N_bytes;
-  srsran::error_type<unique_byte_buffer_t> ret       = tx_sdu_queue.try_write(std::move(sdu));
-  if (ret) {
-    RlcHexInfo(msg_ptr,
-               nof_bytes,
-               "Tx SDU (%d B, PDCP_SN=%ld tx_sdu_queue_len=%d)",
-               nof_bytes,
-               sdu_pdcp_sn,
-               tx_sdu_queue.size());
-  } else {
-    // in case of fail, the try_write returns back the sdu
-    RlcHexWarning(ret.error()->msg,
-                  ret.error()->N_bytes,
+  // Store SDU. The MAC may read and free it as soon as it is queued, so it is logged before. This is the only
+  // producer of the queue, so it can't become full between the check and the write
+  if (tx_sdu_queue.is_full()) {
+    RlcHexWarning(sdu->msg,
+                  sdu->N_bytes,
                   "[Dropped SDU] Tx SDU (%d B, PDCP_SN=%ld, tx_sdu_queue_len=%d)",
-                  ret.error()->N_bytes,
+                  sdu->N_bytes,
                   sdu_pdcp_sn,
                   tx_sdu_queue.size());
     return SRSRAN_ERROR;
   }
+  RlcHexInfo(sdu->msg,
+             sdu->N_bytes,
+             "Tx SDU (%d B, PDCP_SN=%ld tx_sdu_queue_len=%d)",
+             sdu->N_bytes,
+             sdu_pdcp_sn,
+             tx_sdu_queue.size() + 1);
+  tx_sdu_queue.try_write(std::move(sdu));
 
   return SRSRAN_SUCCESS;
 }
 
+uint32_t rlc_am::rlc_am_base_tx::write_sdu_batch(srsran::span<unique_byte_buffer_t> sdus)
+{
+  if (!tx_enabled.load(std::memory_order_acquire)) {
+    return 0;
+  }
+
+  uint32_t nof_sdus = tx_sdu_queue.write_batch(sdus);
+  RlcInfo("Tx %d SDUs, tx_sdu_queue_len=%d", nof_sdus, tx_sdu_queue.size());
+  if (nof_sdus < sdus.size()) {
+    RlcWarning("[Dropped SDU] %zd Tx SDUs, tx_sdu_queue_len=%d", sdus.size() - nof_sdus, tx_sdu_queue.size());
+  }
+  return nof_sdus;
+}
+
 void rlc_am::rlc_am_base_tx::discard_sdu(uint32_t discard_sn)
 {
   std::lock_guard<std::mutex> lock(mutex);
@@ -275,14 +300,8 @@ void rlc_am::rlc_am_base_tx::discard_sdu(uint32_t discard_sn)
   if (!tx_enabled) {
     return;
   }
-  bool discarded = tx_sdu_queue.apply_first([&discard_sn, this](unique_byte_buffer_t& sdu) {
-    if (sdu != nullptr && sdu->md.pdcp_sn == discard_sn) {
-      tx_sdu_queue.queue.pop_func(sdu);
-      sdu = nullptr;
-      return true;
-    }
-    return false;
-  });
+  bool discarded = tx_sdu_queue.discard_first(
+      [discard_sn](const unique_byte_buffer_t& sdu) { return sdu->md.pdcp_sn == discard_sn; });
 
   // Discard fails when the PDCP PDU is already in Tx window.
   RlcInfo("%s PDU with PDCP_SN=%d", discarded ? "Discarding" : "Couldn't discard", discard_sn);
@@ -86,7 +86,7 @@ bool rlc_am_lte_tx::configure(const rlc_config_t& cfg_)
   empty_queue_nolock();
   tx_sdu_queue.resize(cfg_.tx_queue_length);
 
-  tx_enabled = true;
+  tx_enabled.store(true, std::memory_order_release);
 
   return true;
 }
@@ -101,7 +101,7 @@ void rlc_am_lte_tx::stop_nolock()
 {
   empty_queue_nolock();
 
-  tx_enabled = false;
+  tx_enabled.store(false, std::memory_order_release);
 
   if (parent->timers != nullptr && poll_retx_timer.is_valid()) {
     poll_retx_timer.stop();
@@ -124,6 +124,7 @@ void rlc_am_lte_tx::stop_nolock()
 
   // Drop all messages in RETX queue
   retx_queue.clear();
+  retx_size_cache = {};
 
   // Drop all SDU info in queue
   undelivered_sdu_info_queue.clear();
@@ -153,7 +154,7 @@ void rlc_am_lte_tx::reestablish()
 {
   std::lock_guard<std::mutex> lock(mutex);
   stop_nolock();
-  tx_enabled = true;
+  tx_enabled.store(true, std::memory_order_release);
 }
 
 bool rlc_am_lte_tx::do_status()
@@ -239,7 +240,7 @@ void rlc_am_lte_tx::get_buffer_state_nolock(uint32_t& n_bytes_newtx, uint32_t& n
              retx.so_start,
              retx.so_end);
     if (tx_window.has_sn(retx.sn)) {
-      int req_bytes = required_buffer_size(retx);
+      int req_bytes = required_buffer_size_cached(retx);
       if (req_bytes < 0) {
         RlcError("In get_buffer_state(): Removing retx.sn=%d from queue", retx.sn);
         retx_queue.pop();
@@ -907,7 +908,7 @@ int rlc_am_lte_tx::build_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 
 void rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
-  if (not tx_enabled) {
+  if (not tx_enabled.load(std::memory_order_acquire)) {
     return;
   }
 
@@ -1014,6 +1015,9 @@ void rlc_am_lte_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
         update_notification_ack_info(i);
         RlcDebug("Tx PDU SN=%zd being removed from tx window", i);
         tx_window.remove_pdu(i);
+        if (retx_size_cache.sn == i) {
+          retx_size_cache = {};
+        }
       }
       // Advance window if possible
       if (update_vt_a) {
@@ -1089,6 +1093,19 @@ void rlc_am_lte_tx::debug_state()
   RlcDebug("vt_a = %d, vt_ms = %d, vt_s = %d, poll_sn = %d", vt_a, vt_ms, vt_s, poll_sn);
 }
 
+int rlc_am_lte_tx::required_buffer_size_cached(const rlc_amd_retx_lte_t& retx)
+{
+  if (retx_size_cache.sn != retx.sn or retx_size_cache.is_segment != retx.is_segment or
+      retx_size_cache.so_start != retx.so_start or retx_size_cache.so_end != retx.so_end) {
+    retx_size_cache.sn         = retx.sn;
+    retx_size_cache.is_segment = retx.is_segment;
+    retx_size_cache.so_start   = retx.so_start;
+    retx_size_cache.so_end     = retx.so_end;
+    retx_size_cache.nof_bytes  = required_buffer_size(retx);
+  }
+  return retx_size_cache.nof_bytes;
+}
+
 int rlc_am_lte_tx::required_buffer_size(const rlc_amd_retx_lte_t& retx)
 {
   if (!retx.is_segment) {
@@ -1215,14 +1232,17 @@ void rlc_am_lte_rx::stop()
   vr_ms = 0;
   vr_h  = 0;
 
-  poll_received = false;
-  do_status     = false;
+  poll_received        = false;
+  do_status            = false;
+  status_pdu_len_valid = false;
 
   // Drop all messages in RX segments
   rx_segments.clear();
 
   // Drop all messages in RX window
   rx_window.clear();
+  rx_window_present.clear();
+  rx_window_bytes = 0;
 }
 
 /** Called from stack thread when MAC has received a new RLC PDU
@@ -1233,6 +1253,7 @@ void rlc_am_lte_rx::stop()
 void rlc_am_lte_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   std::lock_guard<std::mutex> lock(mutex);
+  status_pdu_len_valid = false;
 
   rlc_amd_pdu_header_t header      = {};
   uint32_t             payload_len = nof_bytes;
@@ -1294,6 +1315,7 @@ void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, r
   // Write to rx window
   rlc_amd_rx_pdu& pdu = rx_window.add_pdu(header.sn);
   pdu.buf             = srsran::make_byte_buffer();
+  rx_window_present.set(header.sn);
   if (pdu.buf == NULL) {
 #ifdef RLC_AM_BUFFER_DEBUG
     srsran::console("Fatal Error: Couldn't allocate PDU in handle_data_pdu().\n");
@@ -1301,6 +1323,7 @@ void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, r
 #else
     RlcError("Fatal Error: Couldn't allocate PDU in handle_data_pdu().");
     rx_window.remove_pdu(header.sn);
+    rx_window_present.reset(header.sn);
     return;
 #endif
   }
@@ -1314,6 +1337,7 @@ void rlc_am_lte_rx::handle_data_pdu_full(uint8_t* payload, uint32_t nof_bytes, r
   memcpy(pdu.buf->msg, payload, nof_bytes);
   pdu.buf->N_bytes = nof_bytes;
   pdu.header       = header;
+  rx_window_bytes += nof_bytes;
 
   // Update vr_h
   if (RX_MOD_BASE(header.sn) >= RX_MOD_BASE(vr_h)) {
@@ -1505,6 +1529,7 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
 
           rx_window[vr_r].buf->msg += len;
           rx_window[vr_r].buf->N_bytes -= len;
+          rx_window_bytes -= len;
 
           RlcHexInfo(rx_sdu->msg, rx_sdu->N_bytes, "Rx SDU (%d B)", rx_sdu->N_bytes);
           sdu_rx_latency_ms.push(std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -1599,7 +1624,9 @@ void rlc_am_lte_rx::reassemble_rx_sdus()
       }
       it->second.segments.clear();
     }
+    rx_window_bytes -= rx_window[vr_r].buf->N_bytes;
     rx_window.remove_pdu(vr_r);
+    rx_window_present.reset(vr_r);
     vr_r  = (vr_r + 1) % MOD;
     vr_mr = (vr_mr + 1) % MOD;
   }
@@ -1619,7 +1646,7 @@ bool rlc_am_lte_rx::get_do_status()
 uint32_t rlc_am_lte_rx::get_rx_buffered_bytes()
 {
   std::lock_guard<std::mutex> lock(mutex);
-  return rx_window.get_buffered_bytes();
+  return rx_window_bytes;
 }
 
 uint32_t rlc_am_lte_rx::get_sdu_rx_latency_ms()
@@ -1638,6 +1665,7 @@ void rlc_am_lte_rx::timer_expired(uint32_t timeout_id)
   std::lock_guard<std::mutex> lock(mutex);
   if (reordering_timer.is_valid() and reordering_timer.id() == timeout_id) {
     RlcDebug("reordering timeout expiry - updating vr_ms (was %d)", vr_ms);
+    status_pdu_len_valid = false;
 
     // 36.322 v10 Section 5.1.3.2.4
     vr_ms = vr_x;
@@ -1658,6 +1686,12 @@ void rlc_am_lte_rx::timer_expired(uint32_t timeout_id)
   }
 }
 
+/// Same as rlc_am_packed_length() for a status PDU with n_nack NACKs without segment offsets, but in constant time
+static uint32_t status_pdu_packed_length(uint32_t n_nack)
+{
+  return (15 + 12 * n_nack + 7) / 8; // 15 bits fixed part, 10 bits SN and 2 bits ext per NACK
+}
+
 // Called from Tx object to pack status PDU that doesn't exceed a given size
 // If lock-acquisition fails, return -1. Otherwise it returns the length of the generated PDU.
 int rlc_am_lte_rx::get_status_pdu(rlc_status_pdu_t* status, const uint32_t max_pdu_size)
@@ -1671,19 +1705,29 @@ int rlc_am_lte_rx::get_status_pdu(rlc_status_pdu_t* status, const uint32_t max_p
   status->ack_sn = vr_r; // start with lower edge of the rx window
 
   // We don't use segment NACKs - just NACK the full PDU
-  uint32_t i = vr_r;
-  while (RX_MOD_BASE(i) <= RX_MOD_BASE(vr_ms) && status->N_nack < RLC_AM_WINDOW_SIZE) {
-    if (rx_window.has_sn(i) || i == vr_ms) {
-      // only update ACK_SN if this SN has been received, or if we reached the maximum possible SN
+  uint32_t nof_sns = RX_MOD_BASE(vr_ms);
+  uint32_t offset  = 0;
+  while (offset <= nof_sns && status->N_nack < RLC_AM_WINDOW_SIZE) {
+    uint32_t i = (vr_r + offset) % MOD;
+    if (i == vr_ms) {
+      // reached the maximum possible SN
       status->ack_sn = i;
+      offset++;
+    } else if (rx_window_present.test(i)) {
+      // only update ACK_SN if this SN has been received. Runs of received SNs are skipped a bitmap word at a time
+      uint32_t nof_received = rx_window_present.find_next(i, nof_sns - offset, false);
+      status->ack_sn        = (i + nof_received - 1) % MOD;
+      offset += nof_received;
     } else {
       status->nacks[status->N_nack].nack_sn = i;
+      status->nacks[status->N_nack].has_so  = false;
       status->N_nack++;
+      offset++;
     }
 
     // make sure we don't exceed grant size
-    if (rlc_am_packed_length(status) > max_pdu_size) {
-      RlcDebug("Status PDU too big (%d > %d)", rlc_am_packed_length(status), max_pdu_size);
+    if (status_pdu_packed_length(status->N_nack) > max_pdu_size) {
+      RlcDebug("Status PDU too big (%d > %d)", status_pdu_packed_length(status->N_nack), max_pdu_size);
       if (status->N_nack >= 1 && status->N_nack < RLC_AM_WINDOW_SIZE) {
         RlcDebug("Removing last NACK SN=%d", status->nacks[status->N_nack].nack_sn);
         status->N_nack--;
@@ -1703,7 +1747,6 @@ int rlc_am_lte_rx::get_status_pdu(rlc_status_pdu_t* status, const uint32_t max_p
       }
       break;
     }
-    i = (i + 1) % MOD;
   }
 
   // valid PDU could be generated
@@ -1719,16 +1762,21 @@ int rlc_am_lte_rx::get_status_pdu_length()
   if (not lock.owns_lock()) {
     return 0;
   }
-  rlc_status_pdu_t status = {};
-  status.ack_sn           = vr_ms;
-  uint32_t i              = vr_r;
-  while (RX_MOD_BASE(i) < RX_MOD_BASE(vr_ms) && status.N_nack < RLC_AM_WINDOW_SIZE) {
-    if (not rx_window.has_sn(i)) {
-      status.N_nack++;
-    }
-    i = (i + 1) % MOD;
-  }
-  return rlc_am_packed_length(&status);
+  if (status_pdu_len_valid) {
+    return status_pdu_len;
+  }
+  // Count the missing SNs a run at a time
+  uint32_t nof_sns = RX_MOD_BASE(vr_ms);
+  uint32_t n_nack  = 0;
+  for (uint32_t offset = rx_window_present.find_next(vr_r, nof_sns, false); offset < nof_sns;
+       offset += rx_window_present.find_next((vr_r + offset) % MOD, nof_sns - offset, false)) {
+    uint32_t nof_missing = rx_window_present.find_next((vr_r + offset) % MOD, nof_sns - offset, true);
+    n_nack += nof_missing;
+    offset += nof_missing;
+  }
+  status_pdu_len       = status_pdu_packed_length(std::min(n_nack, (uint32_t)RLC_AM_WINDOW_SIZE));
+  status_pdu_len_valid = true;
+  return status_pdu_len;
 }
 
 void rlc_am_lte_rx::print_rx_segments()
@@ -26,6 +26,7 @@
 #include "srsran/interfaces/ue_rrc_interfaces.h"
 #include "srsran/rlc/rlc_am_nr_packing.h"
 #include "srsran/srslog/event_trace.h"
+#include <algorithm>
 #include <iostream>
 #include <set>
 
@@ -62,12 +63,12 @@ bool rlc_am_nr_tx::configure(const rlc_config_t& cfg_)
     case rlc_am_nr_sn_size_t::size12bits:
       min_hdr_size = 2;
       tx_window    = std::unique_ptr<rlc_ringbuffer_base<rlc_amd_tx_pdu_nr> >(
-          new rlc_ringbuffer_t<rlc_amd_tx_pdu_nr, am_window_size(rlc_am_nr_sn_size_t::size12bits)>);
+          new rlc_paged_ringbuffer_t<rlc_amd_tx_pdu_nr, am_window_size(rlc_am_nr_sn_size_t::size12bits)>);
       break;
     case rlc_am_nr_sn_size_t::size18bits:
       min_hdr_size = 3;
       tx_window    = std::unique_ptr<rlc_ringbuffer_base<rlc_amd_tx_pdu_nr> >(
-          new rlc_ringbuffer_t<rlc_amd_tx_pdu_nr, am_window_size(rlc_am_nr_sn_size_t::size18bits)>);
+          new rlc_paged_ringbuffer_t<rlc_amd_tx_pdu_nr, am_window_size(rlc_am_nr_sn_size_t::size18bits)>);
       break;
     default:
       RlcError("attempt to configure unsupported tx_sn_field_length %s", to_string(cfg.tx_sn_field_length));
@@ -92,7 +93,7 @@ bool rlc_am_nr_tx::configure(const rlc_config_t& cfg_)
                               [this](uint32_t timerid) { timer_expired(timerid); });
   }
 
-  tx_enabled = true;
+  tx_enabled.store(true, std::memory_order_release);
 
   RlcDebug("RLC AM NR configured tx entity.");
   return true;
@@ -452,20 +453,19 @@ uint32_t rlc_am_nr_tx::build_retx_pdu(uint8_t* payload, uint32_t nof_bytes)
     return 0;
   }
 
-  rlc_amd_retx_nr_t& retx = retx_queue.front();
-
   // Sanity check - drop any retx SNs not present in tx_window
-  while (not tx_window->has_sn(retx.sn)) {
-    RlcInfo("SN=%d not in tx window, probably already ACKed. Skip and remove from retx queue", retx.sn);
+  while (not tx_window->has_sn(retx_queue.front().sn)) {
+    RlcInfo("SN=%d not in tx window, probably already ACKed. Skip and remove from retx queue", retx_queue.front().sn);
+    retx_queue_bytes -= get_retx_pending_bytes(retx_queue.front());
     retx_queue.pop();
-    if (!retx_queue.empty()) {
-      retx = retx_queue.front();
-    } else {
+    if (retx_queue.empty()) {
       RlcInfo("empty retx queue, cannot provide any retx PDU");
       return 0;
     }
   }
 
+  rlc_amd_retx_nr_t& retx = retx_queue.front();
+
   RlcDebug("RETX - SN=%d, is_segment=%s, current_so=%d, so_start=%d, segment_length=%d",
            retx.sn,
            retx.is_segment ? "true" : "false",
@@ -553,6 +553,7 @@ rlc_am_nr_tx::build_retx_pdu_without_segmentation(const rlc_amd_retx_nr_t retx,
 
   // Update RETX queue. This must be done before calculating
   // the polling bit, to make sure the poll bit is calculated correctly
+  retx_queue_bytes -= get_retx_pending_bytes(retx);
   retx_queue.pop();
 
   // Write header to payload
@@ -702,8 +703,10 @@ uint32_t rlc_am_nr_tx::build_retx_pdu_with_segmentation(rlc_amd_retx_nr_t& retx,
   }
 
   // Update retx queue
+  retx_queue_bytes -= get_retx_pending_bytes(retx);
   retx.is_segment = true;
   retx.current_so = retx.current_so + retx_pdu_payload_size;
+  retx_queue_bytes += get_retx_pending_bytes(retx);
 
   RlcDebug("Updated RETX info. is_segment=%s, current_so=%d, so_start=%d, segment_length=%d",
            retx.is_segment ? "true" : "false",
@@ -760,6 +763,11 @@ uint32_t rlc_am_nr_tx::get_retx_expected_hdr_len(const rlc_amd_retx_nr_t& retx)
   return expected_hdr_len;
 }
 
+uint32_t rlc_am_nr_tx::get_retx_pending_bytes(const rlc_amd_retx_nr_t& retx)
+{
+  return retx.segment_length + get_retx_expected_hdr_len(retx);
+}
+
 uint32_t rlc_am_nr_tx::build_status_pdu(byte_buffer_t* payload, uint32_t nof_bytes)
 {
   RlcInfo("generating status PDU. Bytes available:%d", nof_bytes);
@@ -782,7 +790,7 @@ uint32_t rlc_am_nr_tx::build_status_pdu(byte_buffer_t* payload, uint32_t nof_byt
 
 void rlc_am_nr_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
-  if (not tx_enabled) {
+  if (not tx_enabled.load(std::memory_order_acquire)) {
     return;
   }
 
@@ -847,7 +855,10 @@ void rlc_am_nr_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
   for (uint32_t sn = st.tx_next_ack; tx_mod_base_nr(sn) < tx_mod_base_nr(stop_sn); sn = (sn + 1) % mod_nr) {
     if (tx_window->has_sn(sn)) {
       notify_info_vec.push_back((*tx_window)[sn].pdcp_sn);
-      retx_queue.remove_sn(sn); // remove any pending retx for that SN
+      // remove any pending retx for that SN
+      retx_queue.remove_sn(sn, [this](const rlc_amd_retx_nr_t& retx) {
+        retx_queue_bytes -= get_retx_pending_bytes(retx);
+      });
       tx_window->remove_pdu(sn);
       st.tx_next_ack = (sn + 1) % mod_nr;
     } else {
@@ -858,35 +869,41 @@ void rlc_am_nr_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
   RlcDebug("Processed status report ACKs. ACK_SN=%d. Tx_Next_Ack=%d", status.ack_sn, st.tx_next_ack);
 
   // Process N_nacks
-  std::set<uint32_t> retx_sn_set; // Set of PDU SNs added for retransmission (no duplicates)
+  retx_sns.clear();
   for (uint32_t nack_idx = 0; nack_idx < status.nacks.size(); nack_idx++) {
-    if (status.nacks[nack_idx].has_nack_range) {
-      for (uint32_t range_sn = status.nacks[nack_idx].nack_sn;
-           range_sn < status.nacks[nack_idx].nack_sn + status.nacks[nack_idx].nack_range;
-           range_sn++) {
+    const rlc_status_nack_t& range_nack = status.nacks[nack_idx];
+    if (range_nack.has_nack_range) {
+      for (uint32_t range_idx = 0; range_idx < range_nack.nack_range; range_idx++) {
         rlc_status_nack_t nack = {};
-        nack.nack_sn           = range_sn;
-        if (status.nacks[nack_idx].has_so) {
+        nack.nack_sn           = (range_nack.nack_sn + range_idx) % mod_nr;
+        if (range_nack.has_so) {
           // Apply so_start to first range item
-          if (range_sn == status.nacks[nack_idx].nack_sn) {
-            nack.so_start = status.nacks[nack_idx].so_start;
+          if (range_idx == 0) {
+            nack.so_start = range_nack.so_start;
           }
           // Apply so_end to last range item
-          if (range_sn == (status.nacks[nack_idx].nack_sn + status.nacks[nack_idx].nack_range - 1)) {
-            nack.so_end = status.nacks[nack_idx].so_end;
+          if (range_idx == range_nack.nack_range - 1u) {
+            nack.so_end = range_nack.so_end;
           }
           // Enable has_so only if the offsets do not span the whole SDU
           nack.has_so = (nack.so_start != 0) || (nack.so_end != rlc_status_nack_t::so_end_of_sdu);
         }
-        handle_nack(nack, retx_sn_set);
+        handle_nack(nack, retx_sns);
       }
     } else {
-      handle_nack(status.nacks[nack_idx], retx_sn_set);
+      handle_nack(range_nack, retx_sns);
     }
   }
 
+  // Count each SDU once, however many of its segments were NACKed. NACKs come in increasing SN order, so sorting is
+  // only needed when they wrap around the SN space
+  if (not std::is_sorted(retx_sns.begin(), retx_sns.end())) {
+    std::sort(retx_sns.begin(), retx_sns.end());
+  }
+  retx_sns.erase(std::unique(retx_sns.begin(), retx_sns.end()), retx_sns.end());
+
   // Process retx_count and inform upper layers if needed
-  for (uint32_t retx_sn : retx_sn_set) {
+  for (uint32_t retx_sn : retx_sns) {
     auto& pdu = (*tx_window)[retx_sn];
     // Increment retx_count
     if (pdu.retx_count == RETX_COUNT_NOT_STARTED) {
@@ -908,7 +925,15 @@ void rlc_am_nr_tx::handle_control_pdu(uint8_t* payload, uint32_t nof_bytes)
   notify_info_vec.clear();
 }
 
-void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>& retx_sn_set)
+/// Adds sn to the SNs scheduled for RETX. Segments of the same SDU are NACKed one after the other
+static void add_retx_sn(std::vector<uint32_t>& retx_sn_list, uint32_t sn)
+{
+  if (retx_sn_list.empty() or retx_sn_list.back() != sn) {
+    retx_sn_list.push_back(sn);
+  }
+}
+
+void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::vector<uint32_t>& retx_sn_list)
 {
   if (tx_mod_base_nr(st.tx_next_ack) <= tx_mod_base_nr(nack.nack_sn) &&
       tx_mod_base_nr(nack.nack_sn) <= tx_mod_base_nr(st.tx_next)) {
@@ -926,13 +951,13 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
         for (const rlc_amd_tx_pdu_nr::pdu_segment& segm : pdu.segment_list) {
           if (segm.so >= nack.so_start && segm.so <= nack.so_end) {
             if (not retx_queue.has_sn(nack.nack_sn, segm.so)) {
-              rlc_amd_retx_nr_t& retx = retx_queue.push();
-              retx.sn                 = nack.nack_sn;
+              rlc_amd_retx_nr_t& retx = retx_queue.push(nack.nack_sn);
               retx.is_segment         = true;
               retx.so_start           = segm.so;
               retx.current_so         = segm.so;
               retx.segment_length     = segm.payload_len;
-              retx_sn_set.insert(nack.nack_sn);
+              retx_queue_bytes += get_retx_pending_bytes(retx);
+              add_retx_sn(retx_sn_list, nack.nack_sn);
               RlcInfo("Scheduled RETX of SDU segment SN=%d, so_start=%d, segment_length=%d",
                       retx.sn,
                       retx.so_start,
@@ -961,24 +986,24 @@ void rlc_am_nr_tx::handle_nack(const rlc_status_nack_t& nack, std::set<uint32_t>
         if (not retx_queue.has_sn(nack.nack_sn)) {
           // Have we segmented the SDU already?
           if ((*tx_window)[nack.nack_sn].segment_list.empty()) {
-            rlc_amd_retx_nr_t& retx = retx_queue.push();
-            retx.sn                 = nack.nack_sn;
+            rlc_amd_retx_nr_t& retx = retx_queue.push(nack.nack_sn);
             retx.is_segment         = false;
             retx.so_start           = 0;
             retx.current_so         = 0;
             retx.segment_length     = pdu.sdu_buf->N_bytes;
-            retx_sn_set.insert(nack.nack_sn);
+            retx_queue_bytes += get_retx_pending_bytes(retx);
+            add_retx_sn(retx_sn_list, nack.nack_sn);
             RlcInfo("Scheduled RETX of SDU SN=%d", retx.sn);
           } else {
             RlcInfo("Scheduled RETX of SDU SN=%d", nack.nack_sn);
-            retx_sn_set.insert(nack.nack_sn);
+            add_retx_sn(retx_sn_list, nack.nack_sn);
             for (auto segm : (*tx_window)[nack.nack_sn].segment_list) {
-              rlc_amd_retx_nr_t& retx = retx_queue.push();
-              retx.sn                 = nack.nack_sn;
+              rlc_amd_retx_nr_t& retx = retx_queue.push(nack.nack_sn);
               retx.is_segment         = true;
               retx.so_start           = segm.so;
               retx.current_so         = segm.so;
               retx.segment_length     = segm.payload_len;
+              retx_queue_bytes += get_retx_pending_bytes(retx);
               RlcInfo("Scheduled RETX of SDU Segment. SN=%d, SO=%d, len=%d", retx.sn, segm.so, segm.payload_len);
             }
           }
@@ -1049,25 +1074,8 @@ void rlc_am_nr_tx::get_buffer_state(uint32_t& n_bytes_new, uint32_t& n_bytes_pri
   }
 
   // Bytes needed for retx
-  for (const rlc_amd_retx_nr_t& retx : retx_queue.get_inner_queue()) {
-    RlcDebug("buffer state - retx - SN=%d, Segment: %s, %d:%d",
-             retx.sn,
-             retx.is_segment ? "true" : "false",
-             retx.so_start,
-             retx.so_start + retx.segment_length - 1);
-    if (tx_window->has_sn(retx.sn)) {
-      int req_bytes     = retx.segment_length;
-      int hdr_req_bytes = (retx.is_segment && retx.current_so != 0) ? max_hdr_size : min_hdr_size;
-      if (req_bytes <= 0) {
-        RlcError("buffer state - retx - invalid length=%d for SN=%d", req_bytes, retx.sn);
-      } else {
-        n_bytes_prio += (req_bytes + hdr_req_bytes);
-        RlcDebug("buffer state - retx: %d bytes", n_bytes_prio);
-      }
-    } else {
-      RlcWarning("buffer state - retx for SN=%d is outside the tx_window", retx.sn);
-    }
-  }
+  n_bytes_prio += retx_queue_bytes;
+  RlcDebug("buffer state - retx: %zd RETXs, %d bytes", retx_queue.size(), retx_queue_bytes);
 
   // Bytes needed for tx of the rest of the SDU that is currently under segmentation (if any)
   if (sdu_under_segmentation_sn != INVALID_RLC_SN) {
@@ -1234,8 +1242,9 @@ void rlc_am_nr_tx::stop()
 
   // Drop all messages in RETX queue
   retx_queue.clear();
+  retx_queue_bytes = 0;
 
-  tx_enabled = false;
+  tx_enabled.store(false, std::memory_order_release);
 }
 
 void rlc_am_nr_tx::timer_expired(uint32_t timeout_id)
@@ -1274,8 +1283,7 @@ void rlc_am_nr_tx::timer_expired(uint32_t timeout_id)
       // RETX first RLC SDU that has not been ACKed
       // or first SDU segment of the first RLC SDU
       // that has not been acked
-      rlc_amd_retx_nr_t& retx = retx_queue.push();
-      retx.sn                 = st.tx_next_ack;
+      rlc_amd_retx_nr_t& retx = retx_queue.push(st.tx_next_ack);
       if ((*tx_window)[st.tx_next_ack].segment_list.empty()) {
         // Full SDU
         retx.is_segment     = false;
@@ -1293,6 +1301,7 @@ void rlc_am_nr_tx::timer_expired(uint32_t timeout_id)
         retx.current_so     = 0;
         retx.segment_length = (*tx_window)[st.tx_next_ack].segment_list.begin()->payload_len;
       }
+      retx_queue_bytes += get_retx_pending_bytes(retx);
       RlcDebug("Retransmission because of t-PollRetransmit. RETX SN=%d, is_segment=%s, so_start=%d, segment_length=%d",
                retx.sn,
                retx.is_segment ? "true" : "false",
@@ -1396,16 +1405,18 @@ bool rlc_am_nr_rx::configure(const rlc_config_t& cfg_)
   switch (cfg.rx_sn_field_length) {
     case rlc_am_nr_sn_size_t::size12bits:
       rx_window = std::unique_ptr<rlc_ringbuffer_base<rlc_amd_rx_sdu_nr_t> >(
-          new rlc_ringbuffer_t<rlc_amd_rx_sdu_nr_t, am_window_size(rlc_am_nr_sn_size_t::size12bits)>);
+          new rlc_paged_ringbuffer_t<rlc_amd_rx_sdu_nr_t, am_window_size(rlc_am_nr_sn_size_t::size12bits)>);
       break;
     case rlc_am_nr_sn_size_t::size18bits:
       rx_window = std::unique_ptr<rlc_ringbuffer_base<rlc_amd_rx_sdu_nr_t> >(
-          new rlc_ringbuffer_t<rlc_amd_rx_sdu_nr_t, am_window_size(rlc_am_nr_sn_size_t::size18bits)>);
+          new rlc_paged_ringbuffer_t<rlc_amd_rx_sdu_nr_t, am_window_size(rlc_am_nr_sn_size_t::size18bits)>);
       break;
     default:
       RlcError("attempt to configure unsupported rx_sn_field_length %s", to_string(cfg.rx_sn_field_length));
       return false;
   }
+  rx_window_present.resize(am_window_size(cfg.rx_sn_field_length));
+  rx_window_complete.resize(am_window_size(cfg.rx_sn_field_length));
 
   RlcDebug("RLC AM NR configured rx entity.");
 
@@ -1426,10 +1437,11 @@ void rlc_am_nr_rx::stop()
 
   st = {};
 
-  do_status = false;
+  do_status            = false;
+  status_pdu_len_valid = false;
 
   // Drop all messages in RX window
-  rx_window->clear();
+  rx_window_clear();
 }
 
 void rlc_am_nr_rx::reestablish()
@@ -1440,6 +1452,7 @@ void rlc_am_nr_rx::reestablish()
 void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
   std::lock_guard<std::mutex> lock(mutex);
+  status_pdu_len_valid = false;
 
   // Get AMD PDU Header
   rlc_am_nr_pdu_header_t header  = {};
@@ -1536,20 +1549,9 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
      * all bytes have been received.
      */
     if (rx_mod_base_nr(header.sn) == rx_mod_base_nr(st.rx_highest_status)) {
-      uint32_t sn_upd = 0;
-      for (sn_upd = (st.rx_highest_status + 1) % mod_nr; rx_mod_base_nr(sn_upd) < rx_mod_base_nr(st.rx_next_highest);
-           sn_upd = (sn_upd + 1) % mod_nr) {
-        if (rx_window->has_sn(sn_upd)) {
-          if (not(*rx_window)[sn_upd].fully_received) {
-            break; // first SDU not fully received
-          }
-        } else {
-          break; // first SDU not fully received
-        }
-      }
       // Update to the SN of the first SDU with missing bytes.
       // If it not exists, update to the end of the rx_window.
-      st.rx_highest_status = sn_upd;
+      st.rx_highest_status = first_incomplete_sn((st.rx_highest_status + 1) % mod_nr, st.rx_next_highest);
     }
     /*
      * - if x = RX_Next:
@@ -1557,20 +1559,12 @@ void rlc_am_nr_rx::handle_data_pdu(uint8_t* payload, uint32_t nof_bytes)
      *     have been received.
      */
     if (rx_mod_base_nr(header.sn) == rx_mod_base_nr(st.rx_next)) {
-      uint32_t sn_upd = 0;
+      uint32_t sn_upd = first_incomplete_sn(st.rx_next, st.rx_next_highest);
       // move rx_next forward and remove all fully received SDUs from rx_window
-      for (sn_upd = (st.rx_next) % mod_nr; rx_mod_base_nr(sn_upd) < rx_mod_base_nr(st.rx_next_highest);
-           sn_upd = (sn_upd + 1) % mod_nr) {
-        if (rx_window->has_sn(sn_upd)) {
-          if (not(*rx_window)[sn_upd].fully_received) {
-            break; // first SDU not fully received
-          }
-          // RX_Next serves as the lower edge of the receiving window
-          // As such, we remove any SDU from the window if we update this value
-          rx_window->remove_pdu(sn_upd);
-        } else {
-          break; // first SDU not fully received
-        }
+      // RX_Next serves as the lower edge of the receiving window
+      // As such, we remove any SDU from the window if we update this value
+      for (uint32_t sn = st.rx_next; sn != sn_upd; sn = (sn + 1) % mod_nr) {
+        rx_window_remove(sn);
       }
       // Update to the SN of the first SDU with missing bytes.
       // If it not exists, update to the end of the rx_window.
@@ -1637,11 +1631,11 @@ int rlc_am_nr_rx::handle_full_data_sdu(const rlc_am_nr_pdu_header_t& header, con
 {
   uint32_t hdr_len = rlc_am_nr_packed_length(header);
   // Full SDU received. Add SDU to Rx Window and copy full PDU into SDU buffer.
-  rlc_amd_rx_sdu_nr_t& rx_sdu = rx_window->add_pdu(header.sn);
+  rlc_amd_rx_sdu_nr_t& rx_sdu = rx_window_add(header.sn);
   rx_sdu.buf                  = srsran::make_byte_buffer();
   if (rx_sdu.buf == nullptr) {
     RlcError("fatal error. Couldn't allocate PDU in %s.", __FUNCTION__);
-    rx_window->remove_pdu(header.sn);
+    rx_window_remove(header.sn);
     return SRSRAN_ERROR;
   }
   rx_sdu.buf->set_timestamp();
@@ -1649,13 +1643,14 @@ int rlc_am_nr_rx::handle_full_data_sdu(const rlc_am_nr_pdu_header_t& header, con
   // check available space for payload
   if (nof_bytes > rx_sdu.buf->get_tailroom()) {
     RlcError("discarding SN=%d of size %d B (available space %d B)", header.sn, nof_bytes, rx_sdu.buf->get_tailroom());
-    rx_window->remove_pdu(header.sn);
+    rx_window_remove(header.sn);
     return SRSRAN_ERROR;
   }
   memcpy(rx_sdu.buf->msg, payload + hdr_len, nof_bytes - hdr_len); // Don't copy header
   rx_sdu.buf->N_bytes   = nof_bytes - hdr_len;
   rx_sdu.fully_received = true;
   rx_sdu.has_gap        = false;
+  rx_window_complete.set(header.sn);
   return SRSRAN_SUCCESS;
 }
 
@@ -1680,7 +1675,7 @@ int rlc_am_nr_rx::handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header,
   }
 
   // Add a new SDU to the RX window if necessary
-  rlc_amd_rx_sdu_nr_t& rx_sdu = rx_window->has_sn(header.sn) ? (*rx_window)[header.sn] : rx_window->add_pdu(header.sn);
+  rlc_amd_rx_sdu_nr_t& rx_sdu = rx_window->has_sn(header.sn) ? (*rx_window)[header.sn] : rx_window_add(header.sn);
 
   // Create PDU segment info, to be stored later
   rlc_amd_rx_pdu_nr pdu_segment = {};
@@ -1703,7 +1698,7 @@ int rlc_am_nr_rx::handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header,
     rx_sdu.buf = srsran::make_byte_buffer();
     if (rx_sdu.buf == nullptr) {
       RlcError("fatal error. Couldn't allocate PDU in %s.", __FUNCTION__);
-      rx_window->remove_pdu(header.sn);
+      rx_window_remove(header.sn);
       return SRSRAN_ERROR;
     }
     // Assemble SDU from segments
@@ -1711,6 +1706,7 @@ int rlc_am_nr_rx::handle_segment_data_sdu(const rlc_am_nr_pdu_header_t& header,
       memcpy(&rx_sdu.buf->msg[rx_sdu.buf->N_bytes], it.buf->msg, it.buf->N_bytes);
       rx_sdu.buf->N_bytes += it.buf->N_bytes;
     }
+    rx_window_complete.set(header.sn);
   }
   return SRSRAN_SUCCESS;
 }
@@ -1734,74 +1730,86 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
    *   PDU(s) indicated by lower layer:
    */
   RlcDebug("Generating status PDU");
-  for (uint32_t i = st.rx_next; rx_mod_base_nr(i) < rx_mod_base_nr(st.rx_highest_status); i = (i + 1) % mod_nr) {
-    if ((rx_window->has_sn(i) && (*rx_window)[i].fully_received)) {
-      RlcDebug("SDU SN=%d is fully received", i);
-    } else {
-      if (not rx_window->has_sn(i)) {
-        // No segment received, NACK the whole SDU
-        RlcDebug("Adding NACK for full SDU. NACK SN=%d", i);
+  // SDUs that were fully received are skipped a bitmap word at a time, and so are runs of SDUs of which nothing was
+  // received, which are NACKed with NACK ranges
+  uint32_t nof_sns = rx_mod_base_nr(st.rx_highest_status);
+  for (uint32_t offset = rx_window_complete.find_next(st.rx_next, nof_sns, false); offset < nof_sns;
+       offset += rx_window_complete.find_next((st.rx_next + offset) % mod_nr, nof_sns - offset, false)) {
+    uint32_t i = (st.rx_next + offset) % mod_nr;
+    if (not rx_window->has_sn(i)) {
+      // No segment received, NACK the whole SDU and the ones after it that are missing as well
+      uint32_t nof_missing = rx_window_present.find_next(i, nof_sns - offset, true);
+      RlcDebug("Adding NACK for full SDUs. NACK SN=%d, range=%d", i, nof_missing);
+      offset += nof_missing;
+      while (nof_missing > 0) {
         rlc_status_nack_t nack;
-        nack.nack_sn = i;
-        nack.has_so  = false;
+        nack.nack_sn   = i;
+        nack.has_so    = false;
+        uint32_t range = std::min(nof_missing, rlc_am_nr_status_pdu_max_nack_range);
+        if (range > 1) {
+          nack.has_nack_range = true;
+          nack.nack_range     = range;
+        }
         status->push_nack(nack);
-      } else if (not(*rx_window)[i].fully_received) {
-        // Some segments were received, but not all.
-        // NACK non consecutive missing bytes
-        RlcDebug("Adding NACKs for segmented SDU. NACK SN=%d", i);
-        uint32_t last_so         = 0;
-        bool     last_segment_rx = false;
-        for (auto segm = (*rx_window)[i].segments.begin(); segm != (*rx_window)[i].segments.end(); segm++) {
-          if (segm->header.so != last_so) {
-            // Some bytes were not received
-            rlc_status_nack_t nack;
-            nack.nack_sn  = i;
-            nack.has_so   = true;
-            nack.so_start = last_so;
-            nack.so_end   = segm->header.so - 1; // set to last missing byte
-            status->push_nack(nack);
-            if (nack.so_start > nack.so_end) {
-              // Print segment list
-              for (auto segm_it = (*rx_window)[i].segments.begin(); segm_it != (*rx_window)[i].segments.end();
-                   segm_it++) {
-                RlcError("Segment: segm.header.so=%d, segm.buf.N_bytes=%d", segm_it->header.so, segm_it->buf->N_bytes);
-              }
-              RlcError("Error: SO_start=%d > SO_end=%d. NACK_SN=%d. SO_start=%d, SO_end=%d, seg.so=%d",
-                       nack.so_start,
-                       nack.so_end,
-                       nack.nack_sn,
-                       nack.so_start,
-                       nack.so_end,
-                       segm->header.so);
-              srsran_assert(nack.so_start <= nack.so_end,
-                            "Error: SO_start=%d > SO_end=%d. NACK_SN=%d",
-                            nack.so_start,
-                            nack.so_end,
-                            nack.nack_sn);
-            } else {
-              RlcDebug("First/middle segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d",
-                       nack.nack_sn,
-                       nack.so_start,
-                       nack.so_end);
-            }
-          }
-          if (segm->header.si == rlc_nr_si_field_t::last_segment) {
-            last_segment_rx = true;
-          }
-          last_so = segm->header.so + segm->buf->N_bytes;
-        } // Segment loop
-        if (not last_segment_rx) {
+        i = (i + range) % mod_nr;
+        nof_missing -= range;
+      }
+    } else {
+      // Some segments were received, but not all.
+      // NACK non consecutive missing bytes
+      RlcDebug("Adding NACKs for segmented SDU. NACK SN=%d", i);
+      uint32_t last_so         = 0;
+      bool     last_segment_rx = false;
+      for (auto segm = (*rx_window)[i].segments.begin(); segm != (*rx_window)[i].segments.end(); segm++) {
+        if (segm->header.so != last_so) {
+          // Some bytes were not received
           rlc_status_nack_t nack;
           nack.nack_sn  = i;
           nack.has_so   = true;
           nack.so_start = last_so;
-          nack.so_end   = rlc_status_nack_t::so_end_of_sdu;
+          nack.so_end   = segm->header.so - 1; // set to last missing byte
           status->push_nack(nack);
-          RlcDebug(
-              "Final segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d", nack.nack_sn, nack.so_start, nack.so_end);
-          srsran_assert(nack.so_start <= nack.so_end, "Error: SO_start > SO_end. NACK_SN=%d", nack.nack_sn);
+          if (nack.so_start > nack.so_end) {
+            // Print segment list
+            for (auto segm_it = (*rx_window)[i].segments.begin(); segm_it != (*rx_window)[i].segments.end();
+                 segm_it++) {
+              RlcError("Segment: segm.header.so=%d, segm.buf.N_bytes=%d", segm_it->header.so, segm_it->buf->N_bytes);
+            }
+            RlcError("Error: SO_start=%d > SO_end=%d. NACK_SN=%d. SO_start=%d, SO_end=%d, seg.so=%d",
+                     nack.so_start,
+                     nack.so_end,
+                     nack.nack_sn,
+                     nack.so_start,
+                     nack.so_end,
+                     segm->header.so);
+            srsran_assert(nack.so_start <= nack.so_end,
+                          "Error: SO_start=%d > SO_end=%d. NACK_SN=%d",
+                          nack.so_start,
+                          nack.so_end,
+                          nack.nack_sn);
+          } else {
+            RlcDebug("First/middle segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d",
+                     nack.nack_sn,
+                     nack.so_start,
+                     nack.so_end);
+          }
         }
+        if (segm->header.si == rlc_nr_si_field_t::last_segment) {
+          last_segment_rx = true;
+        }
+        last_so = segm->header.so + segm->buf->N_bytes;
+      } // Segment loop
+      if (not last_segment_rx) {
+        rlc_status_nack_t nack;
+        nack.nack_sn  = i;
+        nack.has_so   = true;
+        nack.so_start = last_so;
+        nack.so_end   = rlc_status_nack_t::so_end_of_sdu;
+        status->push_nack(nack);
+        RlcDebug("Final segment missing. NACK_SN=%d. SO_start=%d, SO_end=%d", nack.nack_sn, nack.so_start, nack.so_end);
+        srsran_assert(nack.so_start <= nack.so_end, "Error: SO_start > SO_end. NACK_SN=%d", nack.nack_sn);
       }
+      offset++;
     }
   } // NACK loop
 
@@ -1811,6 +1819,9 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
    */
   status->ack_sn = st.rx_highest_status;
 
+  status_pdu_len       = status->packed_size;
+  status_pdu_len_valid = true;
+
   // trim PDU if necessary
   if (status->packed_size > max_len) {
     RlcInfo("Trimming status PDU with %d NACKs and packed_size=%d into max_len=%d",
@@ -1836,6 +1847,12 @@ uint32_t rlc_am_nr_rx::get_status_pdu(rlc_am_nr_status_pdu_t* status, uint32_t m
 
 uint32_t rlc_am_nr_rx::get_status_pdu_length()
 {
+  {
+    std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+    if (lock.owns_lock() and status_pdu_len_valid) {
+      return status_pdu_len;
+    }
+  }
   rlc_am_nr_status_pdu_t tmp_status(cfg.rx_sn_field_length);
   get_status_pdu(&tmp_status, UINT32_MAX);
   return tmp_status.get_packed_size();
@@ -1863,6 +1880,7 @@ void rlc_am_nr_rx::timer_expired(uint32_t timeout_id)
   // Reassembly
   if (reassembly_timer.is_valid() && reassembly_timer.id() == timeout_id) {
     RlcDebug("Reassembly timer expired after %dms", reassembly_timer.duration());
+    status_pdu_len_valid = false;
     /*
      * 5.2.3.2.4 Actions when t-Reassembly expires:
      * - update RX_Highest_Status to the SN of the first RLC SDU with SN >= RX_Next_Status_Trigger for which not
@@ -1873,14 +1891,7 @@ void rlc_am_nr_rx::timer_expired(uint32_t timeout_id)
      *   - start t-Reassembly;
      *   - set RX_Next_Status_Trigger to RX_Next_Highest.
      */
-    uint32_t sn_upd = {};
-    for (sn_upd = st.rx_next_status_trigger; rx_mod_base_nr(sn_upd) < rx_mod_base_nr(st.rx_next_highest);
-         sn_upd = (sn_upd + 1) % mod_nr) {
-      if (not rx_window->has_sn(sn_upd) || (rx_window->has_sn(sn_upd) && not(*rx_window)[sn_upd].fully_received)) {
-        break;
-      }
-    }
-    st.rx_highest_status = sn_upd;
+    st.rx_highest_status = first_incomplete_sn(st.rx_next_status_trigger, st.rx_next_highest);
     if (not valid_ack_sn(st.rx_highest_status)) {
       RlcError("Rx_Highest_Status not inside RX window");
       debug_state();
@@ -1964,6 +1975,36 @@ void rlc_am_nr_rx::update_segment_inventory(rlc_amd_rx_sdu_nr_t& rx_sdu) const
 /*
  * Window Helpers
  */
+rlc_amd_rx_sdu_nr_t& rlc_am_nr_rx::rx_window_add(uint32_t sn)
+{
+  rx_window_present.set(sn);
+  return rx_window->add_pdu(sn);
+}
+
+void rlc_am_nr_rx::rx_window_remove(uint32_t sn)
+{
+  rx_window_present.reset(sn);
+  rx_window_complete.reset(sn);
+  rx_window->remove_pdu(sn);
+}
+
+void rlc_am_nr_rx::rx_window_clear()
+{
+  rx_window_present.clear();
+  rx_window_complete.clear();
+  rx_window->clear();
+}
+
+/// SN of the first SDU in [sn, end_sn) that has not been fully received, or end_sn if all of them have been
+uint32_t rlc_am_nr_rx::first_incomplete_sn(uint32_t sn, uint32_t end_sn) const
+{
+  if (rx_mod_base_nr(sn) >= rx_mod_base_nr(end_sn)) {
+    return sn;
+  }
+  uint32_t len = rx_mod_base_nr(end_sn) - rx_mod_base_nr(sn);
+  return (sn + rx_window_complete.find_next(sn, len, false)) % mod_nr;
+}
+
 uint32_t rlc_am_nr_rx::rx_mod_base_nr(uint32_t sn) const
 {
   return (sn - st.rx_next) % mod_nr;
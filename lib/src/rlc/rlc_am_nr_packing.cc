@@ -62,6 +62,12 @@ bool rlc_am_nr_status_pdu_t::is_continuous_sequence(const rlc_status_nack_t& lef
   return true;
 }
 
+/// Number of SDUs covered by a NACK
+static uint32_t nack_nof_sns(const rlc_status_nack_t& nack)
+{
+  return nack.has_nack_range ? nack.nack_range : 1;
+}
+
 void rlc_am_nr_status_pdu_t::push_nack(const rlc_status_nack_t& nack)
 {
   if (nacks_.size() == 0) {
@@ -71,7 +77,8 @@ void rlc_am_nr_status_pdu_t::push_nack(const rlc_status_nack_t& nack)
   }
 
   rlc_status_nack_t& prev = nacks_.back();
-  if (is_continuous_sequence(prev, nack) == false) {
+  if (is_continuous_sequence(prev, nack) == false ||
+      nack_nof_sns(prev) + nack_nof_sns(nack) > rlc_am_nr_status_pdu_max_nack_range) {
     nacks_.push_back(nack);
     packed_size_ += nack_size(nack);
     return;
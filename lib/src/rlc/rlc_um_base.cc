@@ -63,7 +63,7 @@ bool rlc_um_base::is_mrb()
 
 void rlc_um_base::reestablish()
 {
-  tx_enabled = false;
+  tx_enabled.store(false, std::memory_order_release);
 
   if (tx) {
     tx->reestablish(); // calls stop and enables tx again
@@ -73,7 +73,7 @@ void rlc_um_base::reestablish()
     rx->reestablish(); // nothing else needed
   }
 
-  tx_enabled = true;
+  tx_enabled.store(true, std::memory_order_release);
 }
 
 void rlc_um_base::empty_queue()
@@ -89,7 +89,7 @@ void rlc_um_base::empty_queue()
  ***************************************************************************/
 void rlc_um_base::write_sdu(unique_byte_buffer_t sdu)
 {
-  if (not tx_enabled || not tx) {
+  if (not tx_enabled.load(std::memory_order_acquire) || not tx) {
     RlcDebug("RB is currently deactivated. Dropping SDU (%d B)", sdu->N_bytes);
     std::lock_guard<std::mutex> lock(metrics_mutex);
     metrics.num_lost_sdus++;
@@ -109,7 +109,7 @@ void rlc_um_base::write_sdu(unique_byte_buffer_t sdu)
 
 void rlc_um_base::discard_sdu(uint32_t discard_sn)
 {
-  if (not tx_enabled || not tx) {
+  if (not tx_enabled.load(std::memory_order_acquire) || not tx) {
     RlcDebug("RB is currently deactivated. Ignoring SDU discard (SN=%u)", discard_sn);
     return;
   }
@@ -154,7 +154,7 @@ void rlc_um_base::get_buffer_state(uint32_t& newtx_queue, uint32_t& prio_tx_queu
 
 uint32_t rlc_um_base::read_pdu(uint8_t* payload, uint32_t nof_bytes)
 {
-  if (tx && tx_enabled) {
+  if (tx && tx_enabled.load(std::memory_order_acquire)) {
     uint32_t len = tx->build_data_pdu(payload, nof_bytes);
     if (len > 0) {
       std::lock_guard<std::mutex> lock(metrics_mutex);
@@ -285,20 +285,20 @@ void rlc_um_base::rlc_um_base_tx::write_sdu(unique_byte_buffer_t sdu)
 int rlc_um_base::rlc_um_base_tx::try_write_sdu(unique_byte_buffer_t sdu)
 {
   if (sdu) {
-    uint8_t*                                 msg_ptr   = sdu->msg;
-    uint32_t                                 nof_bytes = sdu->N_bytes;
-    srsran::error_type<unique_byte_buffer_t> ret       = tx_sdu_queue.try_write(std::move(sdu));
-    if (ret) {
-      RlcHexInfo(msg_ptr, nof_bytes, "Tx SDU (%d B, tx_sdu_queue_len=%d)", nof_bytes, tx_sdu_queue.size());
-      return SRSRAN_SUCCESS;
-    } else {
-      RlcHexWarning(ret.error()->msg,
-                    ret.error()->N_bytes,
+    // The SDU is logged before being queued, as the MAC may free it right after. This is the only producer of the
+    // queue, so it can't become full between the check and the write
+    if (tx_sdu_queue.is_full()) {
+      RlcHexWarning(sdu->msg,
+                    sdu->N_bytes,
                     "[Dropped SDU] %s Tx SDU (%d B, tx_sdu_queue_len=%d)",
                     rb_name.c_str(),
-                    ret.error()->N_bytes,
+                    sdu->N_bytes,
                     tx_sdu_queue.size());
+      return SRSRAN_ERROR;
     }
+    RlcHexInfo(sdu->msg, sdu->N_bytes, "Tx SDU (%d B, tx_sdu_queue_len=%d)", sdu->N_bytes, tx_sdu_queue.size() + 1);
+    tx_sdu_queue.try_write(std::move(sdu));
+    return SRSRAN_SUCCESS;
   } else {
     RlcWarning("NULL SDU pointer in write_sdu()");
   }
@@ -309,13 +309,8 @@ void rlc_um_base::rlc_um_base_tx::discard_sdu(uint32_t discard_sn)
 {
   std::lock_guard<std::mutex> lock(mutex);
 
-  bool discarded = tx_sdu_queue.apply_first([&discard_sn, this](unique_byte_buffer_t& sdu) {
-    if (sdu != nullptr && sdu->md.pdcp_sn == discard_sn) {
-      tx_sdu_queue.queue.pop_func(sdu);
-      sdu = nullptr;
-    }
-    return false;
-  });
+  bool discarded = tx_sdu_queue.discard_first(
+      [discard_sn](const unique_byte_buffer_t& sdu) { return sdu->md.pdcp_sn == discard_sn; });
 
   // Discard fails when the PDCP PDU is already in Tx window.
   RlcInfo("%s PDU with PDCP_SN=%d", discarded ? "Discarding" : "Couldn't discard", discard_sn);
@@ -66,7 +66,7 @@ bool rlc_um_lte::configure(const rlc_config_t& cnfg_)
           srsran::to_number(cfg.um.tx_sn_field_length));
 
   rx_enabled = true;
-  tx_enabled = true;
+  tx_enabled.store(true, std::memory_order_release);
 
   return true;
 }
@@ -64,7 +64,7 @@ bool rlc_um_nr::configure(const rlc_config_t& cnfg_)
           cfg.um_nr.t_reassembly_ms);
 
   rx_enabled = true;
-  tx_enabled = true;
+  tx_enabled.store(true, std::memory_order_release);
 
   return true;
 }
@@ -0,0 +1,154 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/flat_hash_map.h"
+#include "srsran/common/test_common.h"
+#include <map>
+#include <random>
+#include <set>
+
+namespace srsran {
+
+void test_flat_hash_map_basic()
+{
+  flat_hash_map<uint32_t, uint64_t> map;
+  TESTASSERT(map.empty());
+  TESTASSERT(map.find(5) == map.end());
+  TESTASSERT_EQ(0, map.erase(5));
+
+  TESTASSERT(map.emplace(5, 10).second);
+  TESTASSERT(not map.emplace(5, 11).second);
+  TESTASSERT_EQ(1, map.size());
+  TESTASSERT(map.find(5) != map.end() and map.find(5)->second == 10);
+  map[5] = 12;
+  TESTASSERT_EQ(12, map.find(5)->second);
+  TESTASSERT_EQ(0, map[6]);
+  TESTASSERT_EQ(2, map.size());
+  TESTASSERT_EQ(1, map.count(6));
+
+  TESTASSERT_EQ(1, map.erase(5));
+  TESTASSERT_EQ(0, map.count(5));
+  TESTASSERT_EQ(1, map.size());
+
+  map.clear();
+  TESTASSERT(map.empty());
+  TESTASSERT(map.begin() == map.end());
+}
+
+void test_flat_hash_map_growth_and_tombstones()
+{
+  // Consecutive keys, like MME-UE-S1AP-IDs, that are added and removed as UEs attach and detach
+  flat_hash_map<uint32_t, uint32_t> map;
+  const uint32_t                    nof_keys = 10000;
+  for (uint32_t i = 1; i <= nof_keys; ++i) {
+    TESTASSERT(map.emplace(i, i * 3).second);
+  }
+  TESTASSERT_EQ(nof_keys, map.size());
+  TESTASSERT(map.capacity() >= 2 * nof_keys);
+  for (uint32_t i = 1; i <= nof_keys; i += 2) {
+    TESTASSERT_EQ(1, map.erase(i));
+  }
+  for (uint32_t i = 1; i <= nof_keys; ++i) {
+    auto it = map.find(i);
+    TESTASSERT((it != map.end()) == (i % 2 == 0));
+    TESTASSERT(it == map.end() or it->second == i * 3);
+  }
+
+  // Churn with a constant number of entries does not grow the table
+  map.clear();
+  for (uint32_t i = 1; i <= nof_keys; ++i) {
+    map.emplace(i, i);
+  }
+  size_t cap = map.capacity();
+  for (uint32_t i = nof_keys + 1; i <= 20 * nof_keys; ++i) {
+    TESTASSERT(map.emplace(i, i).second);
+    TESTASSERT_EQ(1, map.erase(i - nof_keys));
+  }
+  TESTASSERT_EQ(nof_keys, map.size());
+  TESTASSERT_EQ(cap, map.capacity());
+}
+
+void test_flat_hash_map_iteration()
+{
+  flat_hash_map<uint64_t, std::set<uint32_t> > map(100);
+  size_t                                        cap = map.capacity();
+  for (uint64_t imsi = 1010123456789; imsi < 1010123456789 + 100; ++imsi) {
+    map[imsi].insert((uint32_t)imsi);
+  }
+  TESTASSERT_EQ(cap, map.capacity());
+
+  // Erasing while iterating visits every entry once
+  size_t nof_visited = 0;
+  for (auto it = map.begin(); it != map.end();) {
+    TESTASSERT_EQ(1, it->second.count((uint32_t)it->first));
+    nof_visited++;
+    if (it->first % 2 == 0) {
+      it = map.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  TESTASSERT_EQ(100, nof_visited);
+  TESTASSERT_EQ(50, map.size());
+
+  const flat_hash_map<uint64_t, std::set<uint32_t> >& cmap = map;
+  for (const auto& e : cmap) {
+    TESTASSERT(e.first % 2 == 1);
+  }
+
+  flat_hash_map<uint64_t, std::set<uint32_t> > map2(std::move(map));
+  TESTASSERT(map.empty());
+  TESTASSERT_EQ(50, map2.size());
+}
+
+void test_flat_hash_map_vs_std_map()
+{
+  std::mt19937                            rgen(0);
+  std::uniform_int_distribution<uint32_t> key_dist(0, 2000);
+  flat_hash_map<uint32_t, uint32_t>       map;
+  std::map<uint32_t, uint32_t>            ref;
+
+  for (uint32_t n = 0; n < 100000; ++n) {
+    uint32_t key = key_dist(rgen);
+    if (n % 3 == 0) {
+      TESTASSERT_EQ(ref.erase(key), map.erase(key));
+    } else {
+      TESTASSERT(ref.emplace(key, n).second == map.emplace(key, n).second);
+    }
+  }
+  TESTASSERT_EQ(ref.size(), map.size());
+  for (const auto& e : ref) {
+    auto it = map.find(e.first);
+    TESTASSERT(it != map.end() and it->second == e.second);
+  }
+}
+
+} // namespace srsran
+
+int main()
+{
+  srsran::test_flat_hash_map_basic();
+  srsran::test_flat_hash_map_growth_and_tombstones();
+  srsran::test_flat_hash_map_iteration();
+  srsran::test_flat_hash_map_vs_std_map();
+  printf("Success\n");
+  return 0;
+}
@@ -0,0 +1,193 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/rcu_hash_map.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <thread>
+
+namespace srsran {
+
+void test_rcu_hash_map_single_thread()
+{
+  qsbr_domain                      qsbr;
+  rcu_hash_map<uint32_t, uint32_t> map(qsbr);
+  TESTASSERT(map.empty());
+
+  uint32_t val = 0;
+  TESTASSERT(not map.find(5, val));
+  map.insert(5, 10);
+  TESTASSERT(map.find(5, val) and val == 10);
+  map.insert(5, 11);
+  TESTASSERT_EQ(1, map.size());
+  TESTASSERT(map.find(5, val) and val == 11);
+  TESTASSERT(map.erase(5));
+  TESTASSERT(not map.erase(5));
+  TESTASSERT(not map.find(5, val));
+
+  // Consecutive keys, like UE IPs, and growth of the table
+  const uint32_t nof_keys = 1000, first_key = 0xac100002;
+  for (uint32_t i = 0; i < nof_keys; ++i) {
+    map.insert(first_key + i, i);
+  }
+  TESTASSERT_EQ(nof_keys, map.size());
+  for (uint32_t i = 0; i < nof_keys; i += 2) {
+    TESTASSERT(map.erase(first_key + i));
+  }
+  for (uint32_t i = 0; i < nof_keys; ++i) {
+    bool found = map.find(first_key + i, val);
+    TESTASSERT(found == (i % 2 == 1));
+    TESTASSERT(not found or val == i);
+  }
+
+  // Without readers, the unlinked nodes and old tables are freed right away
+  TESTASSERT_EQ(0, map.nof_retired());
+}
+
+void test_rcu_hash_map_reclaim()
+{
+  qsbr_domain                      qsbr;
+  rcu_hash_map<uint32_t, uint32_t> map(qsbr);
+
+  // New keys are linked without unlinking anything
+  uint32_t reader_id = qsbr.register_reader();
+  map.insert(1, 1);
+  map.insert(2, 2);
+  TESTASSERT_EQ(0, map.nof_retired());
+
+  // An online reader that did not report a quiescent state may still use the replaced and erased nodes
+  map.insert(1, 3);
+  map.erase(2);
+  TESTASSERT_EQ(2, map.nof_retired());
+  qsbr.quiescent(reader_id);
+  map.reclaim();
+  TESTASSERT_EQ(0, map.nof_retired());
+
+  // Growing the table retires the old bucket array, with a copy of every node, as a whole
+  for (uint32_t i = 0; i < 16; ++i) {
+    map.insert(100 + i, i);
+  }
+  TESTASSERT_EQ(1, map.nof_retired());
+  qsbr.quiescent(reader_id);
+  map.reclaim();
+  TESTASSERT_EQ(0, map.nof_retired());
+
+  // An offline reader does not delay the reclamation
+  qsbr.go_offline(reader_id);
+  map.insert(3, 3);
+  TESTASSERT_EQ(0, map.nof_retired());
+  qsbr.go_online(reader_id);
+  map.erase(3);
+  TESTASSERT_EQ(1, map.nof_retired());
+  qsbr.unregister_reader(reader_id);
+  map.reclaim();
+  TESTASSERT_EQ(0, map.nof_retired());
+}
+
+void test_rcu_hash_map_concurrent_readers()
+{
+  qsbr_domain                      qsbr;
+  rcu_hash_map<uint32_t, uint32_t> map(qsbr);
+  std::atomic<bool>                running{true};
+  std::atomic<uint32_t>            nof_errors{0};
+  const uint32_t                   nof_keys = 64;
+
+  // Keys below nof_keys / 2 are never removed
+  for (uint32_t i = 0; i < nof_keys / 2; ++i) {
+    map.insert(i, i * 2);
+  }
+
+  auto reader = [&]() {
+    uint32_t reader_id = qsbr.register_reader();
+    while (running) {
+      for (uint32_t i = 0; i < nof_keys; ++i) {
+        uint32_t val   = 0;
+        bool     found = map.find(i, val);
+        if ((found and val != i * 2) or (not found and i < nof_keys / 2)) {
+          nof_errors++;
+        }
+      }
+      qsbr.quiescent(reader_id);
+    }
+    qsbr.unregister_reader(reader_id);
+  };
+  std::thread t1(reader), t2(reader);
+
+  for (uint32_t n = 0; n < 5000; ++n) {
+    uint32_t key = nof_keys / 2 + n % (nof_keys / 2);
+    if (not map.erase(key)) {
+      map.insert(key, key * 2);
+    }
+  }
+  running = false;
+  t1.join();
+  t2.join();
+
+  TESTASSERT_EQ(0, nof_errors.load());
+  map.reclaim();
+  TESTASSERT_EQ(0, map.nof_retired());
+}
+
+void test_qsbr_many_readers()
+{
+  qsbr_domain                      qsbr;
+  rcu_hash_map<uint32_t, uint32_t> map(qsbr);
+  const uint32_t                   nof_readers = 2 * qsbr_domain::readers_per_block + 1;
+
+  // The reader registry grows beyond its first block, and the ids stay unique
+  std::vector<uint32_t> reader_ids;
+  for (uint32_t i = 0; i < nof_readers; ++i) {
+    reader_ids.push_back(qsbr.register_reader());
+    qsbr.go_offline(reader_ids.back());
+  }
+  std::sort(reader_ids.begin(), reader_ids.end());
+  TESTASSERT(std::adjacent_find(reader_ids.begin(), reader_ids.end()) == reader_ids.end());
+
+  // A reader of the last block delays reclamation like any other
+  uint32_t last_id = reader_ids.back();
+  qsbr.go_online(last_id);
+  map.insert(1, 1);
+  map.insert(1, 2);
+  TESTASSERT_EQ(1, map.nof_retired());
+  qsbr.quiescent(last_id);
+  map.reclaim();
+  TESTASSERT_EQ(0, map.nof_retired());
+
+  // The ids of unregistered readers are reused
+  qsbr.unregister_reader(last_id);
+  uint32_t new_id = qsbr.register_reader();
+  TESTASSERT_EQ(last_id, new_id);
+  for (uint32_t id : reader_ids) {
+    qsbr.unregister_reader(id);
+  }
+}
+
+} // namespace srsran
+
+int main()
+{
+  srsran::test_rcu_hash_map_single_thread();
+  srsran::test_rcu_hash_map_reclaim();
+  srsran::test_rcu_hash_map_concurrent_readers();
+  srsran::test_qsbr_many_readers();
+  printf("Success\n");
+  return 0;
+}
@@ -0,0 +1,199 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#define NMSGS 1000000
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/test_common.h"
+#include "srsran/upper/byte_buffer_queue.h"
+#include <thread>
+
+using namespace srsran;
+
+static unique_byte_buffer_t make_sdu(uint32_t i, uint32_t len = 4)
+{
+  unique_byte_buffer_t b;
+  do {
+    b = srsran::make_byte_buffer();
+    if (b == nullptr) {
+      // wait until pool is not depleted
+      std::this_thread::yield();
+    }
+  } while (b == nullptr);
+  memcpy(b->msg, &i, 4);
+  b->N_bytes = len;
+  return b;
+}
+
+static uint32_t sdu_id(const unique_byte_buffer_t& b)
+{
+  uint32_t r = 0;
+  memcpy(&r, b->msg, 4);
+  return r;
+}
+
+int test_concurrent_writeread()
+{
+  byte_buffer_spsc_queue q(256);
+
+  std::thread t([&q]() {
+    for (uint32_t i = 0; i < NMSGS; i++) {
+      q.write(make_sdu(i));
+    }
+  });
+
+  unique_byte_buffer_t b;
+  for (uint32_t i = 0; i < NMSGS;) {
+    if (not q.try_read(&b)) {
+      std::this_thread::yield();
+      continue;
+    }
+    TESTASSERT_EQ(i, sdu_id(b));
+    i++;
+  }
+  t.join();
+
+  TESTASSERT_EQ(0, q.size());
+  TESTASSERT_EQ(0, q.get_n_sdus());
+  TESTASSERT_EQ(0, q.size_bytes());
+  return SRSRAN_SUCCESS;
+}
+
+int test_blocking_write()
+{
+  byte_buffer_spsc_queue q(1);
+  q.write(make_sdu(0));
+
+  // The writer blocks on the full queue until the SDU in it is read
+  std::atomic<bool> written = {false};
+  std::thread       t([&q, &written]() {
+    q.write(make_sdu(1));
+    written = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  TESTASSERT(not written);
+  TESTASSERT_EQ(0, sdu_id(q.read()));
+  t.join();
+  TESTASSERT(written);
+  TESTASSERT_EQ(1, sdu_id(q.read()));
+  TESTASSERT(q.is_empty());
+  return SRSRAN_SUCCESS;
+}
+
+int test_full_queue()
+{
+  byte_buffer_spsc_queue q(4);
+
+  for (uint32_t i = 0; i < 4; i++) {
+    TESTASSERT(not q.try_write(make_sdu(i, 10)).is_error());
+  }
+  TESTASSERT(q.is_full());
+  TESTASSERT_EQ(40, q.size_bytes());
+
+  // The rejected SDU is handed back to the caller
+  auto ret = q.try_write(make_sdu(4, 10));
+  TESTASSERT(ret.is_error());
+  TESTASSERT_EQ(4, sdu_id(ret.error()));
+
+  TESTASSERT_EQ(0, sdu_id(q.read()));
+  TESTASSERT(not q.try_write(make_sdu(4, 10)).is_error());
+  for (uint32_t i = 1; i < 5; i++) {
+    TESTASSERT_EQ(i, sdu_id(q.read()));
+  }
+  TESTASSERT(q.read() == nullptr);
+  TESTASSERT_EQ(0, q.size_bytes());
+  return SRSRAN_SUCCESS;
+}
+
+int test_write_batch()
+{
+  byte_buffer_spsc_queue            q(8);
+  std::vector<unique_byte_buffer_t> sdus;
+  for (uint32_t i = 0; i < 10; i++) {
+    sdus.push_back(make_sdu(i, i + 1));
+  }
+
+  // Only the SDUs that fit are moved out of the batch
+  TESTASSERT_EQ(8, q.write_batch(sdus));
+  TESTASSERT_EQ(8, q.get_n_sdus());
+  TESTASSERT_EQ(36, q.size_bytes());
+  TESTASSERT(sdus[7] == nullptr);
+  TESTASSERT(sdus[8] != nullptr);
+
+  for (uint32_t i = 0; i < 8; i++) {
+    TESTASSERT_EQ(i, sdu_id(q.read()));
+  }
+  TESTASSERT(q.is_empty());
+  return SRSRAN_SUCCESS;
+}
+
+int test_discard()
+{
+  byte_buffer_spsc_queue q(8);
+  for (uint32_t i = 0; i < 4; i++) {
+    q.write(make_sdu(i, 10));
+  }
+
+  auto match_id = [](uint32_t id) { return [id](const unique_byte_buffer_t& sdu) { return sdu_id(sdu) == id; }; };
+  TESTASSERT(q.discard_first(match_id(2)));
+  TESTASSERT(not q.discard_first(match_id(2)));
+  TESTASSERT(not q.discard_first(match_id(7)));
+
+  // The discarded SDU no longer counts, but its slot is read as a nullptr
+  TESTASSERT_EQ(4, q.size());
+  TESTASSERT_EQ(3, q.get_n_sdus());
+  TESTASSERT_EQ(30, q.size_bytes());
+  TESTASSERT_EQ(0, sdu_id(q.read()));
+  TESTASSERT_EQ(1, sdu_id(q.read()));
+  TESTASSERT(q.read() == nullptr);
+  TESTASSERT_EQ(3, sdu_id(q.read()));
+  TESTASSERT(q.is_empty());
+  TESTASSERT_EQ(0, q.get_n_sdus());
+  return SRSRAN_SUCCESS;
+}
+
+int test_resize()
+{
+  byte_buffer_spsc_queue q(4);
+  for (uint32_t i = 0; i < 4; i++) {
+    q.write(make_sdu(i, 10));
+  }
+  q.resize(2);
+  TESTASSERT_EQ(2, q.capacity());
+  TESTASSERT_EQ(2, q.size());
+  TESTASSERT_EQ(20, q.size_bytes());
+  TESTASSERT_EQ(0, sdu_id(q.read()));
+  TESTASSERT_EQ(1, sdu_id(q.read()));
+  TESTASSERT(q.is_empty());
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_concurrent_writeread() == SRSRAN_SUCCESS);
+  TESTASSERT(test_blocking_write() == SRSRAN_SUCCESS);
+  TESTASSERT(test_full_queue() == SRSRAN_SUCCESS);
+  TESTASSERT(test_write_batch() == SRSRAN_SUCCESS);
+  TESTASSERT(test_discard() == SRSRAN_SUCCESS);
+  TESTASSERT(test_resize() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
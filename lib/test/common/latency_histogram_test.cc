@@ -0,0 +1,124 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/latency_histogram.h"
+#include "srsran/support/srsran_test.h"
+#include <thread>
+#include <vector>
+
+using srsran::latency_histogram;
+using std::chrono::nanoseconds;
+
+void test_bucket_bounds()
+{
+  // Small values have their own bucket
+  for (uint64_t v = 0; v < latency_histogram::nof_sub_buckets; ++v) {
+    TESTASSERT_EQ(v, latency_histogram::bucket_idx(v));
+    TESTASSERT_EQ(v, latency_histogram::bucket_max_value(v));
+  }
+
+  // Every value falls in a bucket whose bound is within the relative error of the histogram
+  uint32_t prev_idx = 0;
+  for (uint64_t v = 1; v < (uint64_t(1) << latency_histogram::max_value_bits); v += 1 + v / 7) {
+    uint32_t idx = latency_histogram::bucket_idx(v);
+    TESTASSERT(idx < latency_histogram::nof_buckets);
+    TESTASSERT(idx >= prev_idx);
+    uint64_t bound = latency_histogram::bucket_max_value(idx);
+    TESTASSERT(bound >= v);
+    TESTASSERT(bound - v <= v / latency_histogram::nof_sub_buckets);
+    TESTASSERT(idx == 0 or latency_histogram::bucket_max_value(idx - 1) < v);
+    prev_idx = idx;
+  }
+
+  // Values above the range are clamped to the last bucket
+  TESTASSERT_EQ(latency_histogram::nof_buckets - 1, latency_histogram::bucket_idx(uint64_t(-1)));
+}
+
+void test_percentiles()
+{
+  latency_histogram hist;
+
+  latency_histogram::snapshot s;
+  hist.read_and_reset(s);
+  TESTASSERT_EQ(0, s.nof_samples);
+  TESTASSERT_EQ(0, s.get_metrics().p99_us);
+
+  // 1..1000 usec
+  for (uint32_t i = 1; i <= 1000; ++i) {
+    hist.record(std::chrono::microseconds(i));
+  }
+  hist.read_and_reset(s);
+  srsran::latency_metrics_t m = s.get_metrics();
+  TESTASSERT_EQ(1000, m.nof_samples);
+  TESTASSERT(std::abs(m.p50_us - 500) <= 500.0 / latency_histogram::nof_sub_buckets);
+  TESTASSERT(std::abs(m.p99_us - 990) <= 990.0 / latency_histogram::nof_sub_buckets);
+  TESTASSERT(std::abs(m.p999_us - 999) <= 999.0 / latency_histogram::nof_sub_buckets);
+  TESTASSERT_EQ(1000, m.max_us);
+
+  // The histogram is cleared after being read
+  latency_histogram::snapshot s2;
+  hist.read_and_reset(s2);
+  TESTASSERT_EQ(0, s2.nof_samples);
+  TESTASSERT_EQ(0, s2.max_ns);
+}
+
+void test_concurrent_writers()
+{
+  const uint32_t nof_threads = 4, nof_samples = 100000;
+
+  // One histogram per thread, merged by the reader
+  std::vector<latency_histogram> hists(nof_threads);
+  std::vector<std::thread>       threads;
+  for (uint32_t t = 0; t < nof_threads; ++t) {
+    threads.emplace_back([&hists, t]() {
+      for (uint32_t i = 0; i < nof_samples; ++i) {
+        hists[t].record(nanoseconds(1000 * (t + 1)));
+      }
+    });
+  }
+
+  // Reads while the samples are being recorded do not lose samples
+  latency_histogram::snapshot s;
+  for (uint32_t n = 0; n < 100; ++n) {
+    for (auto& h : hists) {
+      h.read_and_reset(s);
+    }
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (auto& h : hists) {
+    h.read_and_reset(s);
+  }
+  TESTASSERT_EQ(nof_threads * nof_samples, s.nof_samples);
+  TESTASSERT_EQ(1000 * nof_threads, s.max_ns);
+  uint64_t p10 = s.percentile_ns(0.1);
+  TESTASSERT(p10 >= 1000 and p10 <= 1000 + 1000 / latency_histogram::nof_sub_buckets);
+}
+
+int main()
+{
+  test_bucket_bounds();
+  test_percentiles();
+  test_concurrent_writers();
+  printf("Success\n");
+  return 0;
+}
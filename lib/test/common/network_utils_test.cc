@@ -130,6 +130,65 @@ int test_socket_handler()
   return 0;
 }
 
+int test_udp_socket_handler()
+{
+  auto& logger = srslog::fetch_basic_logger("S1AP", false);
+
+  std::atomic<int> counter = {0};
+  std::atomic<int> nof_ooo = {0};
+
+  srsran::unique_socket  server_socket, client_socket;
+  srsran::socket_manager sockhandler;
+  using namespace srsran::net_utils;
+
+  TESTASSERT(server_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(server_socket.bind_addr("127.0.0.1", 0));
+  TESTASSERT(client_socket.open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP));
+  TESTASSERT(client_socket.bind_addr("127.0.0.1", 0));
+  sockaddr_in server_addrin = {};
+  socklen_t   socklen       = sizeof(server_addrin);
+  getsockname(server_socket.fd(), (struct sockaddr*)&server_addrin, &socklen);
+
+  // register server Rx handler. The datagrams are read in batches, but must be handled one by one and in order
+  auto pdu_handler = [&counter, &nof_ooo](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
+    if (pdu->N_bytes != (uint32_t)counter % 100 + 1 or pdu->msg[0] != (uint8_t)counter) {
+      nof_ooo++;
+    }
+    counter++;
+  };
+  rx_thread_tester rx_tester;
+  sockhandler.add_socket_handler(server_socket.fd(),
+                                 srsran::make_sdu_handler(logger, rx_tester.task_queue, pdu_handler));
+
+  // Send more datagrams than fit in one batch before the socket thread has the chance to read them
+  uint8_t buf[128]   = {};
+  int32_t nof_counts = 3 * srsran::udp_rx_batch::max_batch_size + 5;
+  for (int32_t i = 0; i < nof_counts; ++i) {
+    buf[0] = i;
+    TESTASSERT(sendto(client_socket.fd(), buf, i % 100 + 1, 0, (struct sockaddr*)&server_addrin, socklen) > 0);
+  }
+
+  uint32_t time_elapsed = 0;
+  while (counter != nof_counts) {
+    usleep(100);
+    time_elapsed += 100;
+    if (time_elapsed > 3000000) {
+      // too much time has passed
+      return -1;
+    }
+  }
+  TESTASSERT(nof_ooo == 0);
+
+  // The handler is not called once the socket is removed
+  TESTASSERT(sockhandler.remove_socket(server_socket.fd()));
+  TESTASSERT(not sockhandler.remove_socket(server_socket.fd()));
+  TESTASSERT(sendto(client_socket.fd(), buf, 1, 0, (struct sockaddr*)&server_addrin, socklen) > 0);
+  usleep(10000);
+  TESTASSERT(counter == nof_counts);
+
+  return 0;
+}
+
 int test_sctp_bind_error()
 {
   srsran::unique_socket sock;
@@ -156,6 +215,7 @@ int main()
 
   srslog::init();
 
+  TESTASSERT(test_udp_socket_handler() == 0);
   TESTASSERT(test_socket_handler() == 0);
   TESTASSERT(test_sctp_bind_error() == 0);
 
@@ -0,0 +1,150 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <functional>
+#include <getopt.h>
+#include <vector>
+
+/*
+ * Measures the ciphering throughput of EEA1, EEA2 and EEA3 on a single core, for the one-message-at-a-time API and for
+ * the multi-buffer API where available.
+ */
+
+static uint32_t pdu_len    = 1500; ///< PDU size in bytes
+static uint32_t nof_pdus   = 20000;
+static uint32_t batch_size = 16; ///< PDUs per multi-buffer call
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [snb]\n", prog);
+  printf("\t-s PDU size in bytes [Default %d]\n", pdu_len);
+  printf("\t-n Number of PDUs per measurement [Default %d]\n", nof_pdus);
+  printf("\t-b PDUs per multi-buffer call [Default %d]\n", batch_size);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "snb")) != -1) {
+    switch (opt) {
+      case 's':
+        pdu_len = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_pdus = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'b':
+        batch_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/// Runs the ciphering of nof_pdus PDUs and prints the throughput in Gbps
+static void measure(const char* name, const std::function<void(uint32_t)>& cipher_pdus, uint32_t pdus_per_call)
+{
+  auto     start = std::chrono::steady_clock::now();
+  uint32_t count = 0;
+  for (; count < nof_pdus; count += pdus_per_call) {
+    cipher_pdus(count);
+  }
+  auto     end  = std::chrono::steady_clock::now();
+  double   usec = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+  uint64_t bits = (uint64_t)count * pdu_len * 8;
+  printf("%-16s %8.3f Gbps %10.1f ns/PDU\n", name, bits / usec / 1e3, usec * 1e3 / count);
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  TESTASSERT(batch_size > 0);
+
+  uint8_t key[16] = {};
+  for (uint8_t& b : key) {
+    b = (uint8_t)(rand() & 0xff);
+  }
+  std::vector<std::vector<uint8_t> > pdus(batch_size, std::vector<uint8_t>(pdu_len));
+  for (std::vector<uint8_t>& pdu : pdus) {
+    for (uint8_t& b : pdu) {
+      b = (uint8_t)(rand() & 0xff);
+    }
+  }
+
+  srsran::security_aes128_key_t aes_key;
+  aes_key.set_key(key);
+
+  std::vector<srsran::security_cipher_msg_t> jobs(batch_size);
+  for (uint32_t i = 0; i < batch_size; i++) {
+    jobs[i].key       = key;
+    jobs[i].bearer    = 1;
+    jobs[i].direction = 1;
+    jobs[i].msg       = pdus[i].data();
+    jobs[i].msg_len   = pdu_len;
+    jobs[i].msg_out   = pdus[i].data();
+  }
+  auto set_counts = [&jobs](uint32_t count) {
+    for (uint32_t i = 0; i < jobs.size(); i++) {
+      jobs[i].count = count + i;
+    }
+  };
+
+  printf("PDU size %d bytes, %d PDUs, %d PDUs per multi-buffer call\n", pdu_len, nof_pdus, batch_size);
+
+  uint8_t* pdu = pdus[0].data();
+  measure(
+      "EEA1",
+      [&](uint32_t count) { srsran::security_128_eea1(key, count, 1, 1, pdu, pdu_len, pdu); },
+      1);
+  measure(
+      "EEA1 multi",
+      [&](uint32_t count) {
+        set_counts(count);
+        srsran::security_128_eea1_multi(jobs.data(), batch_size);
+      },
+      batch_size);
+  measure(
+      "EEA2",
+      [&](uint32_t count) { srsran::security_128_eea2(key, count, 1, 1, pdu, pdu_len, pdu); },
+      1);
+  measure(
+      "EEA2 cached key",
+      [&](uint32_t count) { srsran::security_128_eea2(aes_key, count, 1, 1, pdu, pdu_len, pdu); },
+      1);
+  measure(
+      "EEA3",
+      [&](uint32_t count) { srsran::security_128_eea3(key, count, 1, 1, pdu, pdu_len, pdu); },
+      1);
+  measure(
+      "EEA3 multi",
+      [&](uint32_t count) {
+        set_counts(count);
+        srsran::security_128_eea3_multi(jobs.data(), batch_size);
+      },
+      batch_size);
+
+  return SRSRAN_SUCCESS;
+}
@@ -21,9 +21,11 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <vector>
 #include <sys/time.h>
 
 #include "srsran/common/liblte_security.h"
+#include "srsran/common/security.h"
 #include "srsran/common/test_common.h"
 #include "srsran/srsran.h"
 
@@ -453,6 +455,55 @@ int test_set_1_invalid()
  * Functions
  */
 
+// Multi-buffer ciphering of messages with different keys and lengths must match the single-message API
+int test_multi_buffer()
+{
+  const uint32_t nof_msgs = 37;
+
+  std::vector<std::vector<uint8_t> >   keys(nof_msgs), msgs(nof_msgs), outs(nof_msgs);
+  std::vector<srsran::security_cipher_msg_t> jobs(nof_msgs);
+  for (uint32_t i = 0; i < nof_msgs; i++) {
+    uint32_t len = 1 + (uint32_t)rand() % 1500;
+    keys[i].resize(16);
+    msgs[i].resize(len);
+    outs[i].resize(len);
+    for (uint8_t& b : keys[i]) {
+      b = (uint8_t)(rand() & 0xff);
+    }
+    for (uint8_t& b : msgs[i]) {
+      b = (uint8_t)(rand() & 0xff);
+    }
+    jobs[i].key       = keys[i].data();
+    jobs[i].count     = (uint32_t)rand();
+    jobs[i].bearer    = (uint8_t)(rand() & 0x1f);
+    jobs[i].direction = (uint8_t)(rand() & 0x1);
+    jobs[i].msg       = msgs[i].data();
+    jobs[i].msg_len   = len;
+    // every other message is ciphered in place
+    jobs[i].msg_out = (i % 2) ? msgs[i].data() : outs[i].data();
+  }
+
+  // references
+  std::vector<std::vector<uint8_t> > ref(nof_msgs);
+  for (uint32_t i = 0; i < nof_msgs; i++) {
+    ref[i].resize(msgs[i].size());
+    TESTASSERT(srsran::security_128_eea1(keys[i].data(),
+                                          jobs[i].count,
+                                          jobs[i].bearer,
+                                          jobs[i].direction,
+                                          msgs[i].data(),
+                                          msgs[i].size(),
+                                          ref[i].data()) == SRSRAN_SUCCESS);
+  }
+
+  TESTASSERT(srsran::security_128_eea1_multi(jobs.data(), nof_msgs) == SRSRAN_SUCCESS);
+  for (uint32_t i = 0; i < nof_msgs; i++) {
+    TESTASSERT(arrcmp(jobs[i].msg_out, ref[i].data(), ref[i].size()) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int main(int argc, char* argv[])
 {
   TESTASSERT(test_set_1() == SRSRAN_SUCCESS);
@@ -463,5 +514,6 @@ int main(int argc, char* argv[])
   TESTASSERT(test_set_6() == SRSRAN_SUCCESS);
   TESTASSERT(test_set_1_block_size() == SRSRAN_SUCCESS);
   TESTASSERT(test_set_1_invalid() == SRSRAN_SUCCESS);
+  TESTASSERT(test_multi_buffer() == SRSRAN_SUCCESS);
   return SRSRAN_SUCCESS;
 }
@@ -24,6 +24,8 @@
 #include <stdlib.h>
 
 #include "srsran/common/liblte_security.h"
+#include "srsran/common/security.h"
+#include "srsran/common/ssl.h"
 #include "srsran/common/test_common.h"
 #include "srsran/srsran.h"
 
@@ -455,6 +457,49 @@ int test_set_1_invalid()
   return SRSRAN_SUCCESS;
 }
 
+/*
+ * In-place encryption with an expanded key, compared against the mbedTLS counter mode for all the block boundaries
+ * covered by the pipelined implementations
+ */
+int test_expanded_key_in_place()
+{
+  uint8_t key[16] = {};
+  for (uint32_t i = 0; i < 16; i++) {
+    key[i] = (uint8_t)(rand() & 0xff);
+  }
+
+  srsran::security_aes128_key_t aes_key;
+  aes_key.set_key(key);
+
+  aes_context ctx;
+  aes_setkey_enc(&ctx, key, 128);
+
+  std::vector<uint8_t> msg(600), ref(600);
+  for (uint32_t len = 1; len < msg.size(); len++) {
+    uint32_t count  = (uint32_t)rand();
+    uint8_t  bearer = (uint8_t)(rand() & 0x1f);
+    for (uint32_t i = 0; i < len; i++) {
+      msg[i] = (uint8_t)(rand() & 0xff);
+    }
+
+    uint8_t nonce_cnt[16]  = {};
+    uint8_t stream_blk[16] = {};
+    size_t  nc_off         = 0;
+    nonce_cnt[0]           = (count >> 24) & 0xFF;
+    nonce_cnt[1]           = (count >> 16) & 0xFF;
+    nonce_cnt[2]           = (count >> 8) & 0xFF;
+    nonce_cnt[3]           = count & 0xFF;
+    nonce_cnt[4]           = (bearer << 3) | (1 << 2);
+    aes_crypt_ctr(&ctx, len, &nc_off, nonce_cnt, stream_blk, msg.data(), ref.data());
+
+    // encryption in place
+    TESTASSERT(srsran::security_128_eea2(aes_key, count, bearer, 1, msg.data(), len, msg.data()) == SRSRAN_SUCCESS);
+    TESTASSERT(arrcmp(msg.data(), ref.data(), len) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 /*
  * Functions
  */
@@ -469,4 +514,5 @@ int main(int argc, char* argv[])
   TESTASSERT(test_set_6() == SRSRAN_SUCCESS);
   TESTASSERT(test_set_1_block_size() == SRSRAN_SUCCESS);
   TESTASSERT(test_set_1_invalid() == SRSRAN_SUCCESS);
+  TESTASSERT(test_expanded_key_in_place() == SRSRAN_SUCCESS);
 }
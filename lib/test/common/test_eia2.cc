@@ -0,0 +1,109 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "srsran/common/liblte_security.h"
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include "srsran/srsran.h"
+
+/*
+ * Tests
+ *
+ * Document Reference: 33.401 V14.6.0 Annex C.2
+ *
+ */
+
+int test_set_1()
+{
+  uint8_t  key[]     = {0xd3, 0xc5, 0xd5, 0x92, 0x32, 0x7f, 0xb1, 0x1c, 0x40, 0x35, 0xc6, 0x68, 0x0a, 0xf8, 0xc6, 0xd1};
+  uint32_t count     = 0x398a59b4;
+  uint8_t  bearer    = 0x1a;
+  uint8_t  direction = 1;
+  uint32_t len_bits = 64, len_bytes = (len_bits + 7) / 8;
+  uint8_t  msg[] = {0x48, 0x45, 0x83, 0xd5, 0xaf, 0xe0, 0x82, 0xae};
+  uint8_t  mt[]  = {0xb9, 0x37, 0x87, 0xe6};
+
+  uint8_t mac[4];
+
+  // gen mac
+  srsran::security_128_eia2(key, count, bearer, direction, msg, len_bytes, mac);
+
+  for (int i = 0; i < 4; i++) {
+    TESTASSERT(mac[i] == mt[i]);
+  }
+
+  // gen mac with an expanded key
+  srsran::security_aes128_key_t aes_key;
+  aes_key.set_key(key);
+  srsran::security_128_eia2(aes_key, count, bearer, direction, msg, len_bytes, mac);
+
+  for (int i = 0; i < 4; i++) {
+    TESTASSERT(mac[i] == mt[i]);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * Compares the expanded key implementation against the bit-oriented implementation for all the block boundaries
+ */
+int test_expanded_key_lengths()
+{
+  uint8_t key[16] = {};
+  for (uint32_t i = 0; i < 16; i++) {
+    key[i] = (uint8_t)(rand() & 0xff);
+  }
+
+  srsran::security_aes128_key_t aes_key;
+  aes_key.set_key(key);
+
+  static LIBLTE_BIT_MSG_STRUCT bit_msg = {};
+  uint8_t                      msg[256];
+
+  for (uint32_t len = 0; len < sizeof(msg); len++) {
+    uint32_t count = (uint32_t)rand();
+    uint8_t  mac[4], mac_ref[4];
+
+    for (uint32_t i = 0; i < len; i++) {
+      msg[i] = (uint8_t)(rand() & 0xff);
+    }
+    uint8_t* bits = bit_msg.msg;
+    for (uint32_t i = 0; i < len; i++) {
+      srsran_bit_unpack(msg[i], &bits, 8);
+    }
+    bit_msg.N_bits = len * 8;
+
+    TESTASSERT(liblte_security_128_eia2(key, count, 3, 1, &bit_msg, mac_ref) == LIBLTE_SUCCESS);
+    TESTASSERT(srsran::security_128_eia2(aes_key, count, 3, 1, msg, len, mac) == SRSRAN_SUCCESS);
+    TESTASSERT(memcmp(mac, mac_ref, 4) == 0);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char* argv[])
+{
+  TESTASSERT(test_set_1() == SRSRAN_SUCCESS);
+  TESTASSERT(test_expanded_key_lengths() == SRSRAN_SUCCESS);
+  return SRSRAN_SUCCESS;
+}
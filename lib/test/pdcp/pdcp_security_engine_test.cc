@@ -0,0 +1,199 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "pdcp_base_test.h"
+#include "srsran/test/ue_test_interfaces.h"
+#include "srsran/upper/pdcp_entity_lte.h"
+#include "srsran/upper/pdcp_entity_nr.h"
+#include "srsran/upper/pdcp_security_engine.h"
+#include <chrono>
+#include <random>
+#include <thread>
+
+static std::mt19937 rand_gen(1234);
+
+// RLC that keeps all the PDUs it receives
+class rlc_recorder : public srsue::rlc_interface_pdcp
+{
+public:
+  void write_sdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu) override { pdus.push_back(std::move(sdu)); }
+  void discard_sdu(uint32_t lcid, uint32_t discard_sn) override {}
+  bool rb_is_um(uint32_t lcid) override { return false; }
+  bool sdu_queue_is_full(uint32_t lcid) override { return false; }
+  bool is_suspended(uint32_t lcid) override { return false; }
+
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+};
+
+// Pair of bearers with the same configuration, one ciphering inline and the other through the engine
+struct bearer_pair_t {
+  bearer_pair_t(srsran::srsran_rat_t                rat,
+                uint8_t                             bearer_id,
+                const srsran::as_security_config_t& sec_cfg,
+                srsue::stack_test_dummy&            stack,
+                srslog::basic_logger&               logger) :
+    rrc(logger), gw(logger)
+  {
+    srsran::pdcp_config_t cfg = {bearer_id,
+                                 srsran::PDCP_RB_IS_DRB,
+                                 srsran::SECURITY_DIRECTION_DOWNLINK,
+                                 srsran::SECURITY_DIRECTION_UPLINK,
+                                 rat == srsran::srsran_rat_t::lte ? srsran::PDCP_SN_LEN_12 : srsran::PDCP_SN_LEN_18,
+                                 srsran::pdcp_t_reordering_t::ms500,
+                                 srsran::pdcp_discard_timer_t::infinity,
+                                 false,
+                                 rat};
+    uint32_t lcid = bearer_id + 2;
+    for (uint32_t i = 0; i < 2; i++) {
+      if (rat == srsran::srsran_rat_t::lte) {
+        entity[i].reset(new srsran::pdcp_entity_lte(&rlc[i], &rrc, &gw, &stack.task_sched, logger, lcid));
+      } else {
+        entity[i].reset(new srsran::pdcp_entity_nr(&rlc[i], &rrc, &gw, &stack.task_sched, logger, lcid));
+      }
+      entity[i]->configure(cfg);
+      entity[i]->config_security(sec_cfg);
+      entity[i]->enable_encryption(srsran::DIRECTION_TXRX);
+    }
+  }
+
+  void write_random_sdu()
+  {
+    srsran::unique_byte_buffer_t sdu[2] = {srsran::make_byte_buffer(), srsran::make_byte_buffer()};
+    sdu[0]->N_bytes                     = 1 + rand_gen() % 1500;
+    for (uint32_t i = 0; i < sdu[0]->N_bytes; i++) {
+      sdu[0]->msg[i] = rand_gen() & 0xff;
+    }
+    *sdu[1] = *sdu[0];
+    entity[0]->write_sdu(std::move(sdu[0]));
+    entity[1]->write_sdu(std::move(sdu[1]));
+  }
+
+  int check_pdus()
+  {
+    TESTASSERT(rlc[0].pdus.size() == rlc[1].pdus.size());
+    for (uint32_t i = 0; i < rlc[0].pdus.size(); i++) {
+      TESTASSERT(compare_two_packets(rlc[0].pdus[i], rlc[1].pdus[i]) == 0);
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  rlc_recorder                              rlc[2];
+  rrc_dummy                                 rrc;
+  gw_dummy                                  gw;
+  std::unique_ptr<srsran::pdcp_entity_base> entity[2];
+};
+
+srsran::as_security_config_t make_sec_cfg(srsran::CIPHERING_ALGORITHM_ID_ENUM algo)
+{
+  srsran::as_security_config_t sec_cfg = {};
+  for (uint32_t i = 0; i < sec_cfg.k_up_enc.size(); i++) {
+    sec_cfg.k_up_enc[i] = rand_gen() & 0xff;
+  }
+  sec_cfg.integ_algo  = srsran::INTEGRITY_ALGORITHM_ID_EIA0;
+  sec_cfg.cipher_algo = algo;
+  return sec_cfg;
+}
+
+template <typename F>
+void run_tti(srsran::pdcp_security_engine& engine, srsue::stack_test_dummy& stack, const F& nof_pending_pdus)
+{
+  engine.run_tti();
+  // Wait for the workers to return the batch
+  for (uint32_t i = 0; i < 1000 && nof_pending_pdus() > 0; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    stack.run_pending_tasks();
+  }
+}
+
+/*
+ * Ciphering through the engine must give the same PDUs, in the same order, as ciphering each PDU inline
+ */
+int test_engine(srsran::CIPHERING_ALGORITHM_ID_ENUM algo, uint32_t nof_workers, srslog::basic_logger& logger)
+{
+  srsue::stack_test_dummy      stack;
+  srsran::pdcp_security_engine engine(&stack.task_sched, nof_workers);
+
+  std::vector<std::unique_ptr<bearer_pair_t> > bearers;
+  for (uint8_t bearer_id = 1; bearer_id <= 6; bearer_id++) {
+    srsran::srsran_rat_t rat = bearer_id % 2 == 0 ? srsran::srsran_rat_t::nr : srsran::srsran_rat_t::lte;
+    bearers.emplace_back(new bearer_pair_t(rat, bearer_id, make_sec_cfg(algo), stack, logger));
+    bearers.back()->entity[1]->set_security_engine(&engine);
+  }
+
+  auto nof_pending = [&bearers]() {
+    uint32_t n = 0;
+    for (auto& b : bearers) {
+      n += b->rlc[0].pdus.size() - b->rlc[1].pdus.size();
+    }
+    return n;
+  };
+
+  for (uint32_t tti = 0; tti < 20; tti++) {
+    for (uint32_t i = 0; i < 30; i++) {
+      bearers[rand_gen() % bearers.size()]->write_random_sdu();
+    }
+    // PDUs are only delivered once the batch is ciphered
+    TESTASSERT(nof_pending() > 0);
+
+    // Change the key of one bearer while its PDUs are still queued
+    if (tti == 10) {
+      srsran::as_security_config_t sec_cfg = make_sec_cfg(algo);
+      bearers[0]->entity[0]->config_security(sec_cfg);
+      bearers[0]->entity[1]->config_security(sec_cfg);
+      bearers[0]->write_random_sdu();
+    }
+
+    run_tti(engine, stack, nof_pending);
+    TESTASSERT(nof_pending() == 0);
+  }
+
+  for (auto& b : bearers) {
+    TESTASSERT(b->check_pdus() == SRSRAN_SUCCESS);
+  }
+
+  // PDUs of a removed bearer are dropped
+  bearers[1]->write_random_sdu();
+  bearers[2]->write_random_sdu();
+  bearers[1]->entity[1].reset();
+  run_tti(engine, stack, [&bearers]() { return bearers[2]->rlc[0].pdus.size() - bearers[2]->rlc[1].pdus.size(); });
+  TESTASSERT(bearers[2]->check_pdus() == SRSRAN_SUCCESS);
+  TESTASSERT(bearers[1]->rlc[1].pdus.size() + 1 == bearers[1]->rlc[0].pdus.size());
+
+  engine.stop();
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  srslog::init();
+
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("PDCP", false);
+  logger.set_level(srslog::basic_levels::info);
+
+  for (uint32_t nof_workers : {0, 2}) {
+    TESTASSERT(test_engine(srsran::CIPHERING_ALGORITHM_ID_EEA0, nof_workers, logger) == SRSRAN_SUCCESS);
+    TESTASSERT(test_engine(srsran::CIPHERING_ALGORITHM_ID_128_EEA1, nof_workers, logger) == SRSRAN_SUCCESS);
+    TESTASSERT(test_engine(srsran::CIPHERING_ALGORITHM_ID_128_EEA2, nof_workers, logger) == SRSRAN_SUCCESS);
+    TESTASSERT(test_engine(srsran::CIPHERING_ALGORITHM_ID_128_EEA3, nof_workers, logger) == SRSRAN_SUCCESS);
+  }
+
+  return SRSRAN_SUCCESS;
+}
@@ -3435,6 +3435,109 @@ int full_rx_window_t_reassembly_expiry(rlc_am_nr_sn_size_t sn_size)
   return SRSRAN_SUCCESS;
 }
 
+int sn_bitmap_test()
+{
+  test_delimit_logger delimiter("SN bitmap test");
+  rlc_sn_bitmap       bitmap(am_window_size(rlc_am_nr_sn_size_t::size12bits));
+  TESTASSERT_EQ(2048, bitmap.size());
+
+  // Slots are indexed by SN modulo the window size
+  bitmap.set(5);
+  TESTASSERT(bitmap.test(5));
+  TESTASSERT(bitmap.test(5 + 2048));
+  TESTASSERT_EQ(5, bitmap.find_next(0, 100, true));
+  TESTASSERT_EQ(100, bitmap.find_next(6, 100, true));
+  TESTASSERT_EQ(0, bitmap.find_next(0, 100, false));
+
+  // Searches across words and around the end of the window
+  for (uint32_t sn = 2000; sn < 2048 + 70; sn++) {
+    bitmap.set(sn);
+  }
+  TESTASSERT_EQ(2048 + 70 - 2000, bitmap.find_next(2000, 200, false));
+  TESTASSERT_EQ(10, bitmap.find_next(1990, 200, true));
+  TESTASSERT_EQ(3, bitmap.find_next(2000, 3, false));
+
+  bitmap.reset(2048 + 64);
+  TESTASSERT_EQ(2048 + 64 - 2000, bitmap.find_next(2000, 200, false));
+  bitmap.clear();
+  TESTASSERT_EQ(200, bitmap.find_next(2000, 200, true));
+  return SRSRAN_SUCCESS;
+}
+
+// Thousands of lost SDUs are NACKed with NACK ranges, none longer than the 8 bit NACK range field allows
+int long_nack_range_test(rlc_am_nr_sn_size_t sn_size)
+{
+  rlc_am_tester tester(true, nullptr);
+  timer_handler timers(8);
+
+  auto&               test_logger = srslog::fetch_basic_logger("TESTER  ");
+  rlc_am              rlc1(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_AM_1"), 1, &tester, &tester, &timers);
+  rlc_am              rlc2(srsran_rat_t::nr, srslog::fetch_basic_logger("RLC_AM_2"), 1, &tester, &tester, &timers);
+  test_delimit_logger delimiter("Long NACK range test ({} bit SN)", to_number(sn_size));
+
+  rlc_am_nr_tx* tx1 = dynamic_cast<rlc_am_nr_tx*>(rlc1.get_tx());
+  rlc_am_nr_rx* rx2 = dynamic_cast<rlc_am_nr_rx*>(rlc2.get_rx());
+
+  auto rlc_cnfg              = rlc_config_t::default_rlc_am_nr_config(to_number(sn_size));
+  rlc_cnfg.am_nr.t_poll_retx = -1;
+  if (not rlc1.configure(rlc_cnfg)) {
+    return -1;
+  }
+  if (not rlc2.configure(rlc_cnfg)) {
+    return -1;
+  }
+
+  // Only SN=0, SN=300 and SN=599 get through
+  constexpr uint32_t nof_sdus     = 600;
+  constexpr uint32_t payload_size = 3;
+  uint32_t           header_size  = sn_size == rlc_am_nr_sn_size_t::size12bits ? 2 : 3;
+  for (uint32_t sn = 0; sn < nof_sdus; ++sn) {
+    unique_byte_buffer_t sdu_buf = srsran::make_byte_buffer();
+    sdu_buf->msg[0]              = sn;
+    sdu_buf->N_bytes             = payload_size;
+    sdu_buf->md.pdcp_sn          = sn;
+    rlc1.write_sdu(std::move(sdu_buf));
+
+    unique_byte_buffer_t pdu_buf = srsran::make_byte_buffer();
+    pdu_buf->N_bytes             = rlc1.read_pdu(pdu_buf->msg, 100);
+    if (sn == 0 || sn == 300 || sn == nof_sdus - 1) {
+      rlc2.write_pdu(pdu_buf->msg, pdu_buf->N_bytes);
+    }
+  }
+
+  // Let t-Reassembly expire twice, so that RX_Highest_Status reaches the last received SN
+  for (int cnt = 0; cnt < 100; cnt++) {
+    timers.step_all();
+  }
+  TESTASSERT_EQ(nof_sdus, rx2->get_rx_state().rx_highest_status);
+
+  rlc_am_nr_status_pdu_t status(sn_size);
+  rx2->get_status_pdu(&status, UINT32_MAX);
+  TESTASSERT_EQ(nof_sdus, status.ack_sn);
+  TESTASSERT_EQ(4, status.nacks.size());
+  TESTASSERT_EQ(1, status.nacks[0].nack_sn);
+  TESTASSERT_EQ(255, status.nacks[0].nack_range);
+  TESTASSERT_EQ(256, status.nacks[1].nack_sn);
+  TESTASSERT_EQ(44, status.nacks[1].nack_range);
+  TESTASSERT_EQ(301, status.nacks[2].nack_sn);
+  TESTASSERT_EQ(255, status.nacks[2].nack_range);
+  TESTASSERT_EQ(556, status.nacks[3].nack_sn);
+  TESTASSERT_EQ(43, status.nacks[3].nack_range);
+  for (const rlc_status_nack_t& nack : status.nacks) {
+    TESTASSERT(nack.has_nack_range);
+    TESTASSERT(not nack.has_so);
+  }
+
+  // The sender schedules each lost SDU once for RETX
+  byte_buffer_t status_pdu;
+  rlc_am_nr_write_status_pdu(status, sn_size, &status_pdu);
+  rlc1.write_pdu(status_pdu.msg, status_pdu.N_bytes);
+  rlc1.write_pdu(status_pdu.msg, status_pdu.N_bytes);
+  TESTASSERT_EQ(nof_sdus - 3, tx1->get_retx_queue_size());
+  TESTASSERT_EQ((nof_sdus - 3) * (header_size + payload_size), rlc1.get_buffer_state());
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   // Setup the log message spy to intercept error and warning log entries from RLC
@@ -3489,5 +3592,9 @@ int main()
     TESTASSERT(lost_status_and_advanced_rx_window(sn_size) == SRSRAN_SUCCESS);
   }
   TESTASSERT(full_rx_window_t_reassembly_expiry(rlc_am_nr_sn_size_t::size12bits) == SRSRAN_SUCCESS);
+  TESTASSERT(sn_bitmap_test() == SRSRAN_SUCCESS);
+  for (auto sn_size : sn_sizes) {
+    TESTASSERT(long_nack_range_test(sn_size) == SRSRAN_SUCCESS);
+  }
   return SRSRAN_SUCCESS;
 }
@@ -0,0 +1,164 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/rlc/rlc_am_nr.h"
+#include <chrono>
+#include <getopt.h>
+#include <memory>
+
+/*
+ * Compares the static RLC AM window with the paged window used by NR bearers: memory taken per bearer with 18 bit SNs,
+ * and the rate of add/lookup/remove operations of a window that slides over the SN space.
+ */
+
+static uint32_t nof_bearers   = 1000;
+static uint32_t nof_in_flight = 4096;
+static uint32_t nof_sns       = 1000000;
+
+using namespace srsran;
+using bench_clock = std::chrono::steady_clock;
+
+const static size_t window_size_18bit = am_window_size(rlc_am_nr_sn_size_t::size18bits);
+const static size_t mod_18bit         = cardinality(rlc_am_nr_sn_size_t::size18bits);
+
+using static_window_t = rlc_ringbuffer_t<rlc_amd_tx_pdu_nr, window_size_18bit>;
+using paged_window_t  = rlc_paged_ringbuffer_t<rlc_amd_tx_pdu_nr, window_size_18bit>;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [bfn]\n", prog);
+  printf("\t-b Number of bearers [Default %d]\n", nof_bearers);
+  printf("\t-f Number of SNs in flight [Default %d]\n", nof_in_flight);
+  printf("\t-n Number of SNs sent through the window [Default %d]\n", nof_sns);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "bfn")) != -1) {
+    switch (opt) {
+      case 'b':
+        nof_bearers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'f':
+        nof_in_flight = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_sns = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static double elapsed_usec(bench_clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(bench_clock::now() - start).count();
+}
+
+int test_memory_per_bearer()
+{
+  // Every bearer has one TX and one RX window
+  size_t static_bytes = sizeof(static_window_t) + sizeof(rlc_ringbuffer_t<rlc_amd_rx_sdu_nr_t, window_size_18bit>);
+  size_t paged_bytes =
+      sizeof(paged_window_t) + sizeof(rlc_paged_ringbuffer_t<rlc_amd_rx_sdu_nr_t, window_size_18bit>);
+  printf("%-36s %10.1f KB\n", "Static windows, per bearer", static_bytes / 1024.0);
+  printf("%-36s %10.1f KB\n", "Paged windows, idle bearer", paged_bytes / 1024.0);
+
+  // Bearers with nof_in_flight TX PDUs waiting for ACK
+  std::vector<std::unique_ptr<paged_window_t> > windows(nof_bearers);
+  size_t                                        nof_pages = 0;
+  for (auto& w : windows) {
+    w.reset(new paged_window_t);
+    for (uint32_t sn = 0; sn < nof_in_flight; sn++) {
+      w->add_pdu(sn);
+    }
+    TESTASSERT_EQ(nof_in_flight, w->size());
+    nof_pages += w->nof_pages();
+  }
+  size_t in_flight_bytes = sizeof(paged_window_t) + nof_pages * sizeof(paged_window_t::page_t) / nof_bearers;
+  char   name[64];
+  snprintf(name, sizeof(name), "Paged TX window, %d SNs in flight", nof_in_flight);
+  printf("%-36s %10.1f KB\n", name, in_flight_bytes / 1024.0);
+
+  // Pages are returned once the bearer window is emptied
+  for (auto& w : windows) {
+    w->clear();
+    TESTASSERT(w->empty());
+    TESTASSERT_EQ(0, w->nof_pages());
+  }
+  return SRSRAN_SUCCESS;
+}
+
+template <class Window>
+static double run_sliding_window(Window& w)
+{
+  bench_clock::time_point start = bench_clock::now();
+  for (uint32_t i = 0; i < nof_sns; i++) {
+    uint32_t sn = i % mod_18bit;
+    w.add_pdu(sn).pdcp_sn = sn;
+    if (i >= nof_in_flight) {
+      uint32_t acked_sn = (i - nof_in_flight) % mod_18bit;
+      if (w[acked_sn].pdcp_sn != acked_sn) {
+        return 0;
+      }
+      w.remove_pdu(acked_sn);
+    }
+  }
+  return elapsed_usec(start);
+}
+
+int test_window_throughput()
+{
+  std::unique_ptr<static_window_t> static_window(new static_window_t);
+  std::unique_ptr<paged_window_t>  paged_window(new paged_window_t);
+
+  double usec = run_sliding_window(*static_window);
+  TESTASSERT(usec > 0);
+  printf("%-36s %10.1f Mops/s\n", "Static window, add/lookup/remove", nof_sns / usec);
+
+  usec = run_sliding_window(*paged_window);
+  TESTASSERT(usec > 0);
+  printf("%-36s %10.1f Mops/s\n", "Paged window, add/lookup/remove", nof_sns / usec);
+
+  // Both windows hold the same SNs
+  TESTASSERT_EQ(static_window->size(), paged_window->size());
+  for (uint32_t sn = 0; sn < mod_18bit; sn++) {
+    TESTASSERT_EQ(static_window->has_sn(sn), paged_window->has_sn(sn));
+  }
+  TESTASSERT(paged_window->nof_pages() <= nof_in_flight / RLC_WINDOW_PAGE_SIZE + 2);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  srslog::init();
+
+  TESTASSERT(test_memory_per_bearer() == SRSRAN_SUCCESS);
+  TESTASSERT(test_window_throughput() == SRSRAN_SUCCESS);
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,166 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include "srsran/rlc/rlc.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+/*
+ * The bearer tables of the RLC are read without locks, while the stack thread adds and removes bearers. Removed
+ * entities must stay alive until the readers that could have found them are done.
+ */
+
+using namespace srsran;
+
+class rlc_bearer_table_tester : public srsue::pdcp_interface_rlc, public srsue::rrc_interface_rlc
+{
+public:
+  // PDCP interface
+  void write_pdu(uint32_t lcid, unique_byte_buffer_t sdu) final {}
+  void write_pdu_bcch_bch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_bcch_dlsch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_pcch(unique_byte_buffer_t sdu) final {}
+  void write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t sdu) final {}
+  void notify_delivery(uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns) final {}
+  void notify_failure(uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns) final {}
+
+  // RRC interface
+  void        max_retx_attempted() final {}
+  void        protocol_failure() final {}
+  const char* get_rb_name(uint32_t lcid) final { return "DRB1"; }
+};
+
+struct retire_counter {
+  explicit retire_counter(uint32_t& nof_deleted_) : nof_deleted(nof_deleted_) {}
+  ~retire_counter() { nof_deleted++; }
+  uint32_t& nof_deleted;
+};
+
+int test_retire_list()
+{
+  uint32_t                         nof_deleted = 0;
+  qsbr_retire_list<retire_counter> retired(rlc_qsbr_domain());
+
+  {
+    rlc_read_guard guard;
+    {
+      // Nested guards keep the thread online until the outer one exits
+      rlc_read_guard nested_guard;
+    }
+    retired.retire(std::unique_ptr<retire_counter>(new retire_counter(nof_deleted)));
+    TESTASSERT_EQ(1, retired.size());
+    TESTASSERT_EQ(0, nof_deleted);
+  }
+
+  // No thread is inside a guard anymore
+  retired.reclaim();
+  TESTASSERT_EQ(0, retired.size());
+  TESTASSERT_EQ(1, nof_deleted);
+
+  // A reader in another thread delays the reclamation until it leaves its guard
+  std::atomic<int> step{0};
+  std::thread      reader([&step]() {
+    rlc_read_guard guard;
+    step = 1;
+    while (step != 2) {
+      std::this_thread::yield();
+    }
+  });
+  while (step != 1) {
+    std::this_thread::yield();
+  }
+  retired.retire(std::unique_ptr<retire_counter>(new retire_counter(nof_deleted)));
+  TESTASSERT_EQ(1, retired.size());
+  step = 2;
+  reader.join();
+  retired.reclaim();
+  TESTASSERT_EQ(0, retired.size());
+  TESTASSERT_EQ(2, nof_deleted);
+  return SRSRAN_SUCCESS;
+}
+
+int test_concurrent_bearer_changes()
+{
+  const uint32_t          lcid = 3;
+  rlc_bearer_table_tester tester;
+  timer_handler           timers(8);
+  rlc                     rlc1("RLC_1");
+  rlc1.init(&tester, &tester, &timers, 0);
+
+  rlc_config_t cnfg = rlc_config_t::default_rlc_um_config();
+  TESTASSERT(rlc1.add_bearer(lcid, cnfg) == SRSRAN_SUCCESS);
+
+  // MAC and PDCP side, as PHY workers and user plane threads do
+  std::atomic<bool> running{true};
+  std::atomic<int>  nof_pdus{0};
+  std::thread       reader([&]() {
+    uint8_t payload[1500];
+    while (running) {
+      unique_byte_buffer_t sdu = make_byte_buffer();
+      if (sdu != nullptr) {
+        sdu->N_bytes = 100;
+        rlc1.write_sdu(lcid, std::move(sdu));
+      }
+      if (rlc1.get_buffer_state(lcid) > 0 and rlc1.read_pdu(lcid, payload, sizeof(payload)) > 0) {
+        nof_pdus++;
+      }
+    }
+  });
+
+  // Stack thread
+  for (uint32_t i = 0; i < 1000; ++i) {
+    rlc1.del_bearer(lcid);
+    TESTASSERT(not rlc1.has_bearer(lcid));
+    TESTASSERT(rlc1.add_bearer(lcid, cnfg) == SRSRAN_SUCCESS);
+    if (i % 100 == 0) {
+      rlc1.change_lcid(lcid, lcid + 1);
+      rlc1.change_lcid(lcid + 1, lcid);
+    }
+  }
+  // The bearer must still carry traffic once the changes are over. The wait is bounded, so that a regression fails the
+  // test instead of hanging it
+  int  nof_pdus_before = nof_pdus;
+  auto deadline        = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (nof_pdus == nof_pdus_before and std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  bool carried_pdus = nof_pdus != nof_pdus_before;
+  running           = false;
+  reader.join();
+
+  TESTASSERT(carried_pdus);
+  TESTASSERT(rlc1.has_bearer(lcid));
+  rlc1.stop();
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  TESTASSERT(test_retire_list() == SRSRAN_SUCCESS);
+  TESTASSERT(test_concurrent_bearer_changes() == SRSRAN_SUCCESS);
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -25,6 +25,7 @@
 #include <string.h>
 
 #include "../phy_common.h"
+#include "../tx_modulator.h"
 #include "srsran/srslog/srslog.h"
 
 #define LOG_EXECTIME
@@ -32,7 +33,7 @@
 namespace srsenb {
 namespace lte {
 
-class cc_worker
+class cc_worker : public tx_modulator::symbol_modulator
 {
 public:
   cc_worker(srslog::basic_logger& logger);
@@ -59,7 +60,15 @@ public:
   void work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                stack_interface_phy_lte::dl_sched_t& dl_grants,
                stack_interface_phy_lte::ul_sched_t& ul_grants,
-               srsran_mbsfn_cfg_t*                  mbsfn_cfg);
+               srsran_mbsfn_cfg_t*                  mbsfn_cfg,
+               tx_modulator*                        modulator = nullptr);
+
+  /**
+   * @brief Finishes the DL subframe once the whole signal is generated, it must be called after the modulator is idle
+   */
+  void finish_dl();
+
+  void modulate_symbols(uint32_t port, uint32_t first_symbol, uint32_t nof_symbols) override;
 
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
 
@@ -95,6 +104,8 @@ private:
 
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
 
+  float cell_gain_scale = 1.0f; ///< Amplitude scaling of the current subframe, read by the modulator thread
+
   // Class to store user information
   class ue
   {
@@ -26,7 +26,9 @@
 #include <string.h>
 
 #include "../phy_common.h"
+#include "../tx_modulator.h"
 #include "cc_worker.h"
+#include "srsran/common/latency_histogram.h"
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
 
@@ -38,7 +40,7 @@ class sf_worker : public srsran::thread_pool::worker
 public:
   sf_worker(srslog::basic_logger& logger) : logger(logger) {}
   ~sf_worker();
-  void init(phy_common* phy);
+  void init(phy_common* phy, int prio = -1);
 
   cf_t* get_buffer_rx(uint32_t cc_idx, uint32_t antenna_idx);
   void  set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
@@ -57,6 +59,8 @@ public:
   void     start_plot();
 
   uint32_t get_metrics(std::vector<phy_metrics_t>& metrics);
+  /// Collects the DL encoding and UL decoding times recorded by this worker since the last call
+  void read_latency(srsran::latency_histogram::snapshot& dl, srsran::latency_histogram::snapshot& ul);
 
 private:
   void work_imp() final;
@@ -73,6 +77,12 @@ private:
   srsran::phy_common_interface::worker_context_t context = {};
 
   srsran_softbuffer_tx_t temp_mbsfn_softbuffer = {};
+
+  std::unique_ptr<tx_modulator> modulator; ///< Pipelined OFDM modulation, null if disabled
+
+  // Processing time of every TTI handled by this worker
+  srsran::latency_histogram dl_latency;
+  srsran::latency_histogram ul_latency;
 };
 
 } // namespace lte
@@ -22,6 +22,8 @@
 #ifndef SRSENB_NR_SLOT_WORKER_H
 #define SRSENB_NR_SLOT_WORKER_H
 
+#include "../tx_modulator.h"
+#include "srsran/common/latency_histogram.h"
 #include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/gnb_interfaces.h"
 #include "srsran/interfaces/phy_common_interface.h"
@@ -37,7 +39,7 @@ namespace nr {
  * A slot_worker object is executed by a thread within the thread_pool.
  */
 
-class slot_worker final : public srsran::thread_pool::worker
+class slot_worker final : public srsran::thread_pool::worker, public tx_modulator::symbol_modulator
 {
 public:
   /**
@@ -68,6 +70,8 @@ public:
     uint32_t                    pusch_max_its    = 10;
     float                       pusch_min_snr_dB = -10.0f;
     double                      srate_hz         = 0.0;
+    bool                        tx_pipeline      = false; ///< Modulate symbols in a dedicated thread
+    int                         prio             = -1;    ///< Priority of the modulator thread
   };
 
   slot_worker(srsran::phy_common_interface& common_,
@@ -88,6 +92,9 @@ public:
   uint32_t get_buffer_len();
   void     set_context(const srsran::phy_common_interface::worker_context_t& w_ctx);
 
+  /// Collects the DL encoding and UL decoding times recorded by this worker since the last call
+  void read_latency(srsran::latency_histogram::snapshot& dl, srsran::latency_histogram::snapshot& ul);
+
 private:
   /**
    * @brief Inherited from thread_pool::worker. Function called every slot to run the DL/UL processing
@@ -106,6 +113,11 @@ private:
    */
   bool work_dl();
 
+  /**
+   * @brief Inherited from tx_modulator::symbol_modulator. Generates the baseband signal of a range of symbols
+   */
+  void modulate_symbols(uint32_t port, uint32_t first_symbol, uint32_t nof_symbols) override;
+
   srsran::phy_common_interface& common;
   stack_interface_phy_nr&       stack;
   srslog::basic_logger&         logger;
@@ -123,6 +135,11 @@ private:
   std::vector<cf_t*>                             tx_buffer; ///< Baseband transmit buffers
   std::vector<cf_t*>                             rx_buffer; ///< Baseband receive buffers
   std::mutex mutex; ///< Protect concurrent access from workers (and main process that inits the class)
+  std::unique_ptr<tx_modulator> modulator; ///< Pipelined OFDM modulation, null if disabled
+
+  // Processing time of every slot handled by this worker, excluding the calls to the stack for the scheduling
+  srsran::latency_histogram dl_latency;
+  srsran::latency_histogram ul_latency;
 };
 
 } // namespace nr
@@ -107,6 +107,7 @@ public:
     uint32_t               prio              = 52;
     uint32_t               pusch_max_its     = 10;
     float                  pusch_min_snr_dB  = -10;
+    bool                   tx_pipeline       = false;
     srsran::phy_log_args_t log               = {};
   };
   slot_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
@@ -121,6 +122,7 @@ public:
   void         start_worker(slot_worker* w);
   void         stop();
   int          set_common_cfg(const phy_interface_rrc_nr::common_cfg_t& common_cfg);
+  void         read_latency(srsran::latency_histogram::snapshot& dl, srsran::latency_histogram::snapshot& ul);
 };
 
 } // namespace nr
@@ -74,6 +74,7 @@ struct phy_args_t {
   bool                    pucch_meas_ta       = true;
   bool                    use_cedron_alg      = false;
   uint32_t                nof_prach_threads   = 1;
+  bool                    tx_pipeline         = false;
   bool                    extended_cp         = false;
   srsran::channel::args_t dl_channel_args;
   srsran::channel::args_t ul_channel_args;
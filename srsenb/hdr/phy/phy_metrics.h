@@ -22,6 +22,7 @@
 #ifndef SRSENB_PHY_METRICS_H
 #define SRSENB_PHY_METRICS_H
 
+#include "srsran/common/latency_histogram.h"
 #include <limits>
 
 namespace srsenb {
@@ -53,6 +54,14 @@ struct phy_metrics_t {
   ul_metrics_t ul;
 };
 
+// PHY processing time per TTI/slot, over all the LTE and all the NR PHY workers
+struct phy_latency_metrics_t {
+  srsran::latency_metrics_t dl_encode;
+  srsran::latency_metrics_t ul_decode;
+  srsran::latency_metrics_t nr_dl_encode;
+  srsran::latency_metrics_t nr_ul_decode;
+};
+
 } // namespace srsenb
 
 #endif // SRSENB_PHY_METRICS_H
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#ifndef SRSENB_TX_MODULATOR_H
+#define SRSENB_TX_MODULATOR_H
+
+#include "srsran/common/threads.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace srsenb {
+
+/**
+ * @brief Dedicated thread that performs the OFDM modulation of a worker while the worker keeps encoding, so the IFFT
+ * of the symbols whose resource elements are complete overlaps with the encoding of the rest of the subframe/slot.
+ *
+ * Jobs are executed in the order they are pushed, so ranges of symbols of the same port are modulated sequentially.
+ */
+class tx_modulator : public srsran::thread
+{
+public:
+  /// Interface implemented by the carrier workers that own the resource grid and the OFDM modulators
+  class symbol_modulator
+  {
+  public:
+    virtual ~symbol_modulator() = default;
+
+    /**
+     * @brief Modulates a range of OFDM symbols of a given port, called from the modulator thread
+     */
+    virtual void modulate_symbols(uint32_t port, uint32_t first_symbol, uint32_t nof_symbols) = 0;
+  };
+
+  tx_modulator() : thread("TX_MODULATOR") {}
+  ~tx_modulator() override { stop(); }
+
+  /**
+   * @brief Starts the modulator thread
+   * @param prio Real-time priority, set to a negative value for the default priority
+   */
+  void init(int prio);
+
+  /**
+   * @brief Queues the modulation of a range of symbols for all the given ports
+   */
+  void push(symbol_modulator* q, uint32_t nof_ports, uint32_t first_symbol, uint32_t nof_symbols);
+
+  /**
+   * @brief Blocks until all the queued jobs have been modulated
+   */
+  void wait_idle();
+
+  /**
+   * @brief Stops the modulator thread, pending jobs are discarded
+   */
+  void stop();
+
+private:
+  struct job_t {
+    symbol_modulator* q;
+    uint32_t          port;
+    uint32_t          first_symbol;
+    uint32_t          nof_symbols;
+  };
+
+  void run_thread() override;
+
+  std::mutex              mutex;
+  std::condition_variable cvar_job;
+  std::condition_variable cvar_idle;
+  std::deque<job_t>       jobs;
+  bool                    busy    = false;
+  bool                    running = false;
+};
+
+} // namespace srsenb
+
+#endif // SRSENB_TX_MODULATOR_H
@@ -24,6 +24,7 @@
 
 #include "srsran/interfaces/enb_interfaces.h"
 #include "srsran/interfaces/enb_mac_interfaces.h"
+#include "srsran/interfaces/enb_pdcp_interfaces.h"
 #include "srsran/interfaces/enb_s1ap_interfaces.h"
 #include "srsue/hdr/stack/upper/gw.h"
 #include <string>
@@ -71,8 +72,10 @@ typedef struct {
 typedef struct {
   uint32_t         sync_queue_size; // Max allowed difference between PHY and Stack clocks (in TTI)
   uint32_t         gtpu_indirect_tunnel_timeout_msec;
+  uint32_t         gtpu_tx_batch_size;
   mac_args_t       mac;
   s1ap_args_t      s1ap;
+  pdcp_args_t      pdcp;
   pcap_args_t      mac_pcap;
   pcap_net_args_t  mac_pcap_net;
   pcap_args_t      s1ap_pcap;
@@ -22,6 +22,7 @@
 #ifndef SRSENB_MAC_METRICS_H
 #define SRSENB_MAC_METRICS_H
 
+#include "srsran/common/latency_histogram.h"
 #include <cstdint>
 #include <vector>
 
@@ -66,12 +67,24 @@ struct mac_cc_info_t {
   uint32_t cc_rach_counter;
 };
 
+/// Processing time of the MAC stages in each TTI.
+struct mac_latency_metrics_t {
+  /// Scheduling decision.
+  srsran::latency_metrics_t sched;
+  /// PDCCH allocations done while scheduling.
+  srsran::latency_metrics_t pdcch;
+  /// Assembly of the DL MAC PDUs of the scheduled grants.
+  srsran::latency_metrics_t pdu;
+};
+
 /// Main MAC metrics.
 struct mac_metrics_t {
   /// Per CC info.
   std::vector<mac_cc_info_t> cc_info;
   /// Per UE MAC metrics.
   std::vector<mac_ue_metrics_t> ues;
+  /// Latency of the MAC stages.
+  mac_latency_metrics_t latency;
 };
 
 } // namespace srsenb
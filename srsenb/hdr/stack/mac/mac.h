@@ -28,6 +28,7 @@
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_rr.h"
 #include "srsran/adt/circular_map.h"
 #include "srsran/adt/pool/batch_mem_pool.h"
+#include "srsran/common/latency_histogram.h"
 #include "srsran/common/mac_pcap.h"
 #include "srsran/common/mac_pcap_net.h"
 #include "srsran/common/task_scheduler.h"
@@ -200,6 +201,9 @@ private:
   // Number of rach preambles detected for a cc.
   std::vector<uint32_t> detected_rachs;
 
+  // Time to assemble the DL MAC PDUs of each TTI
+  srsran::latency_histogram pdu_latency;
+
   // PDCCH order
   std::vector<sched_interface::dl_sched_po_info_t> pending_po_prachs = {};
 
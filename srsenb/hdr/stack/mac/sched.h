@@ -26,7 +26,10 @@
 #include "sched_interface.h"
 #include "sched_ue.h"
 #include "srsenb/hdr/common/common_enb.h"
+#include "srsran/common/latency_histogram.h"
+#include "srsran/common/thread_pool.h"
 #include <atomic>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 
@@ -89,12 +92,16 @@ public:
   std::array<int, SRSRAN_MAX_CARRIERS> get_enb_ue_activ_cc_map(uint16_t rnti) final;
   int                                  ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes) final;
   int                                  metrics_read(uint16_t rnti, mac_ue_metrics_t& metrics);
+  /// Fills the scheduling and PDCCH allocation latencies recorded since the last call
+  void                                 latency_metrics_read(mac_latency_metrics_t& metrics);
 
   class carrier_sched;
 
 protected:
   void new_tti(srsran::tti_point tti_rx);
+  void start_tti(srsran::tti_point tti_rx);
   bool is_generated(srsran::tti_point, uint32_t enb_cc_idx) const;
+  bool has_ca_users(uint32_t enb_cc_idx);
   // Helper methods
   template <typename Func>
   int ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name = nullptr, bool log_fail = true);
@@ -115,6 +122,18 @@ protected:
   srsran::tti_point last_tti;
   std::mutex        sched_mutex;
   bool              configured;
+
+  // workers that schedule the carriers without CA users in parallel. The PHY worker that runs the scheduler waits for
+  // them, so they get the same real-time priority
+  static const int                          CC_WORKERS_THREAD_PRIO = 2;
+  std::unique_ptr<srsran::task_thread_pool> cc_workers;
+  std::mutex                                cc_workers_mutex;
+  std::condition_variable                   cc_workers_cvar;
+  uint32_t                                  nof_pending_cc_tasks = 0;
+
+  // time to schedule each TTI and to allocate its PDCCHs, over all carriers
+  srsran::latency_histogram sched_latency;
+  srsran::latency_histogram pdcch_latency;
 };
 
 } // namespace srsenb
@@ -52,6 +52,8 @@ public:
   const ra_sched* get_ra_sched() const { return ra_sched_ptr.get(); }
   //! Get a subframe result for a given tti
   const sf_sched_result* get_sf_result(tti_point tti_rx) const;
+  //! Time spent allocating PDCCHs in the last generated TTI
+  std::chrono::nanoseconds get_last_pdcch_alloc_time() const { return last_pdcch_alloc_time; }
 
 private:
   //! Compute DL scheduler result for given TTI
@@ -86,6 +88,8 @@ private:
   std::vector<dl_sched_po_info_t> pending_pdcch_orders;
 
   uint32_t po_aggr_level = 2;
+
+  std::chrono::nanoseconds last_pdcch_alloc_time{0};
 };
 
 //! Broadcast (SIB + paging) scheduler
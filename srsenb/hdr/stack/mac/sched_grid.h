@@ -30,6 +30,7 @@
 #include "srsran/adt/bounded_bitset.h"
 #include "srsran/adt/circular_array.h"
 #include "srsran/srslog/srslog.h"
+#include <chrono>
 #include <vector>
 
 namespace srsenb {
@@ -104,9 +105,10 @@ public:
   // getters
   const rbgmask_t&        get_dl_mask() const { return dl_mask; }
   const prbmask_t&        get_ul_mask() const { return ul_mask; }
-  uint32_t                get_cfi() const { return pdcch_alloc.get_cfi(); }
-  const sf_cch_allocator& get_pdcch_grid() const { return pdcch_alloc; }
-  uint32_t                get_pucch_width() const { return pucch_nrb; }
+  uint32_t                 get_cfi() const { return pdcch_alloc.get_cfi(); }
+  const sf_cch_allocator&  get_pdcch_grid() const { return pdcch_alloc; }
+  uint32_t                 get_pucch_width() const { return pucch_nrb; }
+  std::chrono::nanoseconds get_pdcch_alloc_time() const { return pdcch_alloc_time; }
 
 private:
   alloc_result alloc_dl(uint32_t     aggr_lvl,
@@ -126,9 +128,10 @@ private:
   sf_cch_allocator pdcch_alloc = {};
 
   // internal state
-  tti_point tti_rx;
-  rbgmask_t dl_mask = {};
-  prbmask_t ul_mask = {};
+  tti_point                tti_rx;
+  rbgmask_t                dl_mask          = {};
+  prbmask_t                ul_mask          = {};
+  std::chrono::nanoseconds pdcch_alloc_time = {}; ///< Time spent allocating DCIs in this TTI
 };
 
 /** Description: Stores the RAR, broadcast, paging, DL data, UL data allocations for the given subframe
@@ -218,6 +221,7 @@ public:
   bool                       is_ul_alloc(uint16_t rnti) const;
   uint32_t                   get_enb_cc_idx() const { return cc_cfg->enb_cc_idx; }
   const sched_cell_params_t* get_cc_cfg() const { return cc_cfg; }
+  std::chrono::nanoseconds   get_pdcch_alloc_time() const { return tti_alloc.get_pdcch_alloc_time(); }
 
 private:
   void set_dl_data_sched_result(const sf_cch_allocator::alloc_result_t& dci_result,
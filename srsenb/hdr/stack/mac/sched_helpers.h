@@ -63,6 +63,22 @@ void generate_cce_location(srsran_regs_t*          regs,
                            uint32_t                sf_idx = 0,
                            uint16_t                rnti   = SRSRAN_INVALID_RNTI);
 
+/// Generate the masks of CCEs spanned by the search space of a user for every subframe, CFI and aggregation level
+cce_frame_mask_table generate_cce_mask_table(const cce_frame_position_table& locations,
+                                             const sched_cell_params_t&      cell_cfg);
+
+/**
+ * Generate the masks of CCEs spanned by a list of CCE locations, one per aggregation level
+ * @param cell_cfg cell configuration with the precomputed masks of each PDCCH candidate
+ * @param locations CCE locations of the search space
+ * @param cfi Number of control symbols used for the PDCCH
+ * @param masks Result of the CCE mask computation
+ */
+void generate_cce_mask(const sched_cell_params_t&    cell_cfg,
+                       const cce_cfi_position_table& locations,
+                       uint32_t                      cfi,
+                       cce_cfi_mask_table&           masks);
+
 /// Obtains TB size *in bytes* for a given MCS and nof allocated prbs
 inline uint32_t get_tbs_bytes(uint32_t mcs, uint32_t nof_alloc_prb, bool use_tbs_index_alt, bool is_ul)
 {
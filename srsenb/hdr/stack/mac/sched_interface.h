@@ -80,6 +80,7 @@ public:
     int         init_dl_cqi               = 5;
     float       max_sib_coderate          = 0.8;
     int         pdcch_cqi_offset          = 0;
+    int         nof_cc_workers            = -1;
   };
 
   struct cell_cfg_t {
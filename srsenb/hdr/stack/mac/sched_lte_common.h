@@ -23,6 +23,7 @@
 #define SRSRAN_SCHED_LTE_COMMON_H
 
 #include "sched_interface.h"
+#include "sched_phy_ch/sched_phy_resource.h"
 #include "srsran/adt/bounded_bitset.h"
 #include "srsran/common/tti_point.h"
 
@@ -51,6 +52,18 @@ using cce_sf_position_table = std::array<std::array<cce_position_list, NOF_AGGR_
 /// Map {sf, cfi, L} -> list of CCE positions
 using cce_frame_position_table = std::array<cce_sf_position_table, SRSRAN_NOF_SF_X_FRAME>;
 
+/// Map {L} -> mask of all the CCEs spanned by the PDCCH candidates of a search space
+using cce_cfi_mask_table = std::array<pdcch_mask_t, NOF_AGGR_LEVEL>;
+
+/// Map {cfi, L} -> mask of all the CCEs spanned by the PDCCH candidates of a search space
+using cce_sf_mask_table = std::array<cce_cfi_mask_table, SRSRAN_NOF_CFI>;
+
+/// Map {sf, cfi, L} -> mask of all the CCEs spanned by the PDCCH candidates of a search space
+using cce_frame_mask_table = std::array<cce_sf_mask_table, SRSRAN_NOF_SF_X_FRAME>;
+
+/// Map {cfi, L, ncce} -> mask of the CCEs occupied by a PDCCH starting at CCE ncce
+using cce_candidate_mask_table = std::array<std::array<std::vector<pdcch_mask_t>, NOF_AGGR_LEVEL>, SRSRAN_NOF_CFI>;
+
 /// structs to bundle together all the sched arguments, and share them with all the sched sub-components
 class sched_cell_params_t
 {
@@ -75,6 +88,9 @@ public:
   std::unique_ptr<srsran_regs_t, regs_deleter> regs;
   cce_sf_position_table                        common_locations = {};
   cce_frame_position_table                     rar_locations    = {};
+  cce_sf_mask_table                            common_masks     = {};
+  cce_frame_mask_table                         rar_masks        = {};
+  cce_candidate_mask_table                     cce_masks        = {};
   std::array<uint32_t, SRSRAN_NOF_CFI>         nof_cce_table    = {}; ///< map cfix -> nof cces in PDCCH
   uint32_t                                     P                = 0;
   uint32_t                                     nof_rbgs         = 0;
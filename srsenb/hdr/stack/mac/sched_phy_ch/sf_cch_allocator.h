@@ -34,11 +34,15 @@ class sf_cch_allocator
 {
 public:
   const static uint32_t MAX_CFI = 3;
+  /// Maximum number of DFS nodes visited per allocation attempt and CFI, before moving on to the next CFI. This bounds
+  /// the allocation time, but a DCI may be rejected even though an exhaustive search would have found room for it
+  const static uint32_t MAX_DFS_NODES = 256;
   struct tree_node {
     int8_t                pucch_n_prb = -1; ///< this PUCCH resource identifier
     uint16_t              rnti        = SRSRAN_INVALID_RNTI;
     uint32_t              record_idx  = 0;
     uint32_t              dci_pos_idx = 0;
+    uint32_t              child_idx   = 0; ///< position of dci_pos_idx in the order the DCI positions are tried
     srsran_dci_location_t dci_pos     = {0, 0};
     /// Accumulation of all PDCCH masks for the current solution (DFS path)
     pdcch_mask_t total_mask, current_mask;
@@ -67,6 +71,8 @@ public:
   void        get_allocs(alloc_result_t* vec = nullptr, pdcch_mask_t* tot_mask = nullptr, size_t idx = 0) const;
   uint32_t    nof_cces() const { return cc_cfg->nof_cce_table[current_cfix]; }
   size_t      nof_allocs() const { return dci_record_list.size(); }
+  /// Number of times a CFI was given up because the search exhausted MAX_DFS_NODES
+  uint32_t    nof_dfs_budget_hits() const { return dfs_budget_hits; }
   std::string result_to_string(bool verbose = false) const;
 
 private:
@@ -76,12 +82,24 @@ private:
     uint32_t     aggr_idx;
     alloc_type_t alloc_type;
     sched_ue*    user;
+    int          first_dci_pos_idx; ///< DCI position tried first, or -1 if none is preferred
+  };
+  /// DCI position picked for a user in the last PDCCH allocation of this object
+  struct dci_pos_hint {
+    uint16_t     rnti;
+    alloc_type_t alloc_type;
+    uint32_t     aggr_idx;
+    uint32_t     dci_pos_idx;
   };
   const cce_cfi_position_table* get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uint32_t cfix) const;
+  const cce_cfi_mask_table*     get_cce_mask_table(alloc_type_t alloc_type, sched_ue* user, uint32_t cfix) const;
 
   // PDCCH allocation algorithm
-  bool alloc_dfs_node(const alloc_record& record, uint32_t start_child_idx);
-  bool get_next_dfs();
+  bool   alloc_dfs_node(const alloc_record& record, uint32_t start_child_idx);
+  bool   get_next_dfs(const alloc_record& failed_record);
+  size_t get_nof_blocking_nodes(const alloc_record& record) const;
+  int    get_first_dci_pos_idx(const alloc_record& record) const;
+  void   save_dci_pos_hints();
 
   // consts
   const sched_cell_params_t* cc_cfg = nullptr;
@@ -92,8 +110,15 @@ private:
   tti_point                 tti_rx;
   uint32_t                  current_cfix     = 0;
   uint32_t                  current_max_cfix = 0;
+  uint32_t                  nof_dfs_nodes    = 0; ///< DFS nodes visited in the current allocation attempt and CFI
+  uint32_t                  dfs_budget_hits  = 0;
   std::vector<tree_node>    last_dci_dfs, temp_dci_dfs;
   std::vector<alloc_record> dci_record_list; ///< Keeps a record of all the PDCCH allocations done so far
+
+  // Solution of the last TTI handled by this object, which is used as a starting point when the sf_idx is the same
+  uint32_t                  hint_sf_idx = SRSRAN_NOF_SF_X_FRAME;
+  uint32_t                  hint_cfix   = 0;
+  std::vector<dci_pos_hint> dci_pos_hints;
 };
 
 // Helper methods
@@ -139,6 +139,7 @@ public:
 
   srsran_dci_format_t           get_dci_format();
   const cce_cfi_position_table* get_locations(uint32_t enb_cc_idx, uint32_t current_cfi, uint32_t sf_idx) const;
+  const cce_cfi_mask_table*     get_location_masks(uint32_t enb_cc_idx, uint32_t current_cfi, uint32_t sf_idx) const;
 
   sched_ue_cell*                   find_ue_carrier(uint32_t enb_cc_idx);
   size_t                           nof_carriers_configured() const { return cfg.supported_cc_list.size(); }
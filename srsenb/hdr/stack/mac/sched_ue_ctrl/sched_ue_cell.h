@@ -73,6 +73,9 @@ struct sched_ue_cell {
   /// Allowed DCI locations per per CFI and per subframe
   const cce_frame_position_table dci_locations;
 
+  /// Masks of the CCEs spanned by the allowed DCI locations per subframe, CFI and aggregation level
+  const cce_frame_mask_table dci_masks;
+
   /// Cell HARQ Entity
   harq_entity harq_ent;
 
@@ -25,10 +25,54 @@
 #include "sched_base.h"
 #include "srsenb/hdr/common/common_enb.h"
 #include "srsran/adt/circular_map.h"
-#include <queue>
+#include <limits>
+#include <vector>
 
 namespace srsenb {
 
+/**
+ * Average number of bytes allocated to a UE per TTI (R), together with R^fairness_coeff, the denominator of the PF
+ * metric r / R^fairness_coeff. In a TTI without allocation, which is the common case with many UEs, R shrinks by a
+ * factor that only depends on the number of samples, so R^fairness_coeff is scaled by a precomputed power of that
+ * factor rather than recomputed with pow().
+ */
+class pf_avg_rate
+{
+public:
+  /// Powers to fairness_coeff of the factors by which R decays in a TTI without allocation
+  class decay_table
+  {
+  public:
+    decay_table(float exp_avg_alpha_, float fairness_coeff_);
+    float operator()(uint32_t nof_samples) const
+    {
+      return nof_samples < fast_start.size() ? fast_start[nof_samples] : steady;
+    }
+
+    const float exp_avg_alpha;
+    const float fairness_coeff;
+
+  private:
+    std::vector<float> fast_start; // (n / (n + 1))^fairness_coeff, while the first 1 / alpha samples are averaged
+    float              steady;     // (1 - alpha)^fairness_coeff
+  };
+
+  float    avg() const { return nof_samples == 0 ? 0 : avg_rate; }
+  uint32_t count() const { return nof_samples; }
+  void     save_alloc(uint32_t alloc_bytes, const decay_table& decay);
+
+  /// PF priority of a UE whose expected rate is r
+  float prio(float r) const
+  {
+    return (avg() != 0) ? r / avg_rate_pow : (r == 0 ? 0 : std::numeric_limits<float>::max());
+  }
+
+private:
+  float    avg_rate     = 0;
+  float    avg_rate_pow = 0;
+  uint32_t nof_samples  = 0;
+};
+
 class sched_time_pf final : public sched_base
 {
   using ue_cit_t = sched_ue_list::const_iterator;
@@ -41,23 +85,16 @@ public:
 private:
   void new_tti(sched_ue_list& ue_db, sf_sched* tti_sched);
 
-  const sched_cell_params_t* cc_cfg         = nullptr;
-  float                      fairness_coeff = 1;
+  const sched_cell_params_t* cc_cfg = nullptr;
+  pf_avg_rate::decay_table   rate_decay;
 
   srsran::tti_point current_tti_rx;
 
   struct ue_ctxt {
-    ue_ctxt(uint16_t rnti_, float fairness_coeff_) : rnti(rnti_), fairness_coeff(fairness_coeff_) {}
-    float    dl_avg_rate() const { return dl_nof_samples == 0 ? 0 : dl_avg_rate_; }
-    float    ul_avg_rate() const { return ul_nof_samples == 0 ? 0 : ul_avg_rate_; }
-    uint32_t dl_count() const { return dl_nof_samples; }
-    uint32_t ul_count() const { return ul_nof_samples; }
-    void     new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched);
-    void     save_dl_alloc(uint32_t alloc_bytes, float alpha);
-    void     save_ul_alloc(uint32_t alloc_bytes, float alpha);
+    explicit ue_ctxt(uint16_t rnti_) : rnti(rnti_) {}
+    void new_tti(const sched_cell_params_t& cell, sched_ue& ue, sf_sched* tti_sched);
 
     const uint16_t rnti;
-    const float    fairness_coeff;
 
     int                 ue_cc_idx  = 0;
     float               dl_prio    = 0;
@@ -65,12 +102,8 @@ private:
     const dl_harq_proc* dl_retx_h  = nullptr;
     const dl_harq_proc* dl_newtx_h = nullptr;
     const ul_harq_proc* ul_h       = nullptr;
-
-  private:
-    float    dl_avg_rate_   = 0;
-    float    ul_avg_rate_   = 0;
-    uint32_t dl_nof_samples = 0;
-    uint32_t ul_nof_samples = 0;
+    pf_avg_rate         dl_rate;
+    pf_avg_rate         ul_rate;
   };
 
   rnti_map_t<ue_ctxt> ue_history_db;
@@ -82,11 +115,10 @@ private:
     bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
   };
 
-  using ue_dl_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_dl_prio_compare>;
-  using ue_ul_queue_t = std::priority_queue<ue_ctxt*, std::vector<ue_ctxt*>, ue_ul_prio_compare>;
-
-  ue_dl_queue_t dl_queue;
-  ue_ul_queue_t ul_queue;
+  // Max-heaps of the UEs to schedule in the current TTI. They are built in linear time, and only the UEs that get a
+  // chance of an allocation are popped from them
+  std::vector<ue_ctxt*> dl_queue;
+  std::vector<ue_ctxt*> ul_queue;
 
   uint32_t try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
   uint32_t try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched);
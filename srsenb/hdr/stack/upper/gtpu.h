@@ -156,6 +156,9 @@ public:
   int  init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_);
   void stop();
 
+  /// Sends the S1-U datagrams queued since the last call
+  void run_tti();
+
   // gtpu_interface_rrc
   srsran::expected<uint32_t> add_bearer(uint16_t            rnti,
                                         uint32_t            eps_bearer_id,
@@ -228,6 +231,9 @@ private:
   // Socket file descriptor
   int fd = -1;
 
+  // S1-U data PDUs waiting to be sent in one sendmmsg() call
+  std::unique_ptr<srsran::udp_tx_batch> tx_batch;
+
   void send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buffer_t pdu, int pdcp_sn = -1);
 
   void echo_response(in_addr_t addr, in_port_t port, uint16_t seq);
@@ -19,6 +19,7 @@
  *
  */
 
+#include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsran/common/timers.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
@@ -28,6 +29,8 @@
 #include "srsran/srslog/srslog.h"
 #include "srsran/upper/pdcp.h"
 #include <map>
+#include <memory>
+#include <vector>
 
 #ifndef SRSENB_PDCP_H
 #define SRSENB_PDCP_H
@@ -42,10 +45,16 @@ class pdcp : public pdcp_interface_rlc, public pdcp_interface_gtpu, public pdcp_
 {
 public:
   pdcp(srsran::task_sched_handle task_sched_, srslog::basic_logger& logger);
-  virtual ~pdcp() {}
-  void init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interface_pdcp* gtpu_);
+  virtual ~pdcp();
+  void init(rlc_interface_pdcp*  rlc_,
+            rrc_interface_pdcp*  rrc_,
+            gtpu_interface_pdcp* gtpu_,
+            const pdcp_args_t&   args_ = {});
   void stop();
 
+  /// Runs the PDCP timers of the user plane threads and ciphers the DRB PDUs written since the last TTI
+  void run_tti();
+
   // pdcp_interface_rlc
   void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu) override;
   void notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sn) override;
@@ -125,7 +134,25 @@ private:
 
   void clear_user(user_interface* ue);
 
-  std::map<uint32_t, user_interface> users;
+  // Shared by the PDCP entities of all users, so it must outlive them
+  std::unique_ptr<srsran::pdcp_security_engine> sec_engine;
+  rnti_map_t<user_interface>                    users;
+
+  // User plane threads. Each one runs its own PDCP object with the users whose RNTI maps to it, and all the calls
+  // for a user are marshalled to its thread. UL PDUs and RRC notifications are returned through stack_queue
+  class up_thread;
+  class up_rrc_adapter;
+  class up_gtpu_adapter;
+  std::vector<std::unique_ptr<up_thread> > up_threads;
+  std::unique_ptr<up_rrc_adapter>          up_rrc;
+  std::unique_ptr<up_gtpu_adapter>         up_gtpu;
+  srsran::task_queue_handle                stack_queue;
+
+  up_thread* get_up_thread(uint16_t rnti) { return up_threads[rnti % up_threads.size()].get(); }
+  template <typename F>
+  void run_in_up_thread(uint16_t rnti, F&& func);
+  template <typename F>
+  void run_in_up_thread_sync(up_thread* thread, F&& func);
 
   rlc_interface_pdcp*       rlc  = nullptr;
   rrc_interface_pdcp*       rrc  = nullptr;
@@ -19,13 +19,16 @@
  *
  */
 
+#include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/common/rnti_pool.h"
 #include "srsran/interfaces/enb_metrics_interface.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/ue_interfaces.h"
 #include "srsran/rlc/rlc.h"
 #include "srsran/srslog/srslog.h"
-#include <map>
+#include <array>
+#include <atomic>
+#include <mutex>
 
 #ifndef SRSENB_RLC_H
 #define SRSENB_RLC_H
@@ -43,10 +46,16 @@ class rrc_interface_rlc;
 class pdcp_interface_rlc;
 class mac_interface_rlc;
 
+/**
+ * RLC of the eNB. The users are kept in a table indexed by RNTI slot, like the UE database of the MAC, so that the PHY
+ * workers look them up without taking any lock. Users are added and removed by the stack thread, and a removed user
+ * is deleted once no thread is inside an srsran::rlc_read_guard anymore.
+ */
 class rlc : public rlc_interface_mac, public rlc_interface_rrc, public rlc_interface_pdcp
 {
 public:
-  explicit rlc(srslog::basic_logger& logger) : logger(logger) {}
+  explicit rlc(srslog::basic_logger& logger);
+  ~rlc();
   void
   init(pdcp_interface_rlc* pdcp_, rrc_interface_rlc* rrc_, mac_interface_rlc* mac_, srsran::timer_handler* timers_);
   void stop();
@@ -77,7 +86,7 @@ public:
   void write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes);
 
 private:
-  class user_interface : public srsue::pdcp_interface_rlc, public srsue::rrc_interface_rlc
+  class user_interface final : public srsue::pdcp_interface_rlc, public srsue::rrc_interface_rlc
   {
   public:
     void        write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t sdu);
@@ -100,10 +109,19 @@ private:
 
   void update_bsr(uint32_t rnti, uint32_t lcid, uint32_t tx_queue, uint32_t retx_queue);
 
-  pthread_rwlock_t rwlock;
+  static uint32_t rnti_slot(uint16_t rnti) { return rnti % SRSENB_MAX_UES; }
 
-  std::map<uint32_t, user_interface> users;
-  std::vector<mch_service_t>         mch_services;
+  /// User of the RNTI, or nullptr. Must be called inside an srsran::rlc_read_guard
+  user_interface* find_user(uint16_t rnti)
+  {
+    user_interface* u = users[rnti_slot(rnti)].load(std::memory_order_acquire);
+    return (u != nullptr and u->rnti == rnti) ? u : nullptr;
+  }
+
+  std::array<std::atomic<user_interface*>, SRSENB_MAX_UES> users;
+  srsran::qsbr_retire_list<user_interface>                 retired_users{srsran::rlc_qsbr_domain()};
+  std::mutex                                               users_mutex; ///< Serializes adding and removing users
+  std::vector<mch_service_t>                               mch_services;
 
   mac_interface_rlc*     mac  = nullptr;
   pdcp_interface_rlc*    pdcp = nullptr;
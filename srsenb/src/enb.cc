@@ -231,6 +231,7 @@ bool enb::get_metrics(enb_metrics_t* m)
   }
   radio->get_metrics(&m->rf);
   phy->get_metrics(m->phy);
+  phy->get_latency_metrics(m->phy_latency);
   if (eutra_stack) {
     eutra_stack->get_metrics(&m->stack);
   }
@@ -113,6 +113,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("rf.device_name",       bpo::value<string>(&args->rf.device_name)->default_value("auto"),       "Front-end device name")
     ("rf.device_args",       bpo::value<string>(&args->rf.device_args)->default_value("auto"),       "Front-end device arguments")
     ("rf.time_adv_nsamples", bpo::value<string>(&args->rf.time_adv_nsamples)->default_value("auto"), "Transmission time advance")
+    ("rf.resampler",         bpo::value<string>(&args->rf.resampler)->default_value("fft"),          "Resampler for each RF channel when rf.srate is set (fft/polyphase), comma separated")
 
     ("gui.enable",        bpo::value<bool>(&args->gui.enable)->default_value(false),          "Enable GUI plots")
 
@@ -181,6 +182,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("scheduler.init_dl_cqi", bpo::value<int>(&args->stack.mac.sched.init_dl_cqi)->default_value(5), "DL CQI value used before any CQI report is available to the eNB")
     ("scheduler.max_sib_coderate", bpo::value<float>(&args->stack.mac.sched.max_sib_coderate)->default_value(0.8), "Upper bound on SIB and RAR grants coderate")
     ("scheduler.pdcch_cqi_offset", bpo::value<int>(&args->stack.mac.sched.pdcch_cqi_offset)->default_value(0), "CQI offset in derivation of PDCCH aggregation level")
+    ("scheduler.nof_cc_workers", bpo::value<int>(&args->stack.mac.sched.nof_cc_workers)->default_value(-1), "Number of threads that schedule carriers in parallel (-1 for one per additional carrier)")
 
     /*Slicing conifguration*/
     ("slicing.enable_eMBB", bpo::value<bool>(&args->nr_stack.ngap.nssai[0].active)->default_value(true), "Enables enhanced mobile broadband (eMBB) slice in the gNodeB")
@@ -255,6 +257,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.pusch_meas_evm", bpo::value<bool>(&args->phy.pusch_meas_evm)->default_value(false), "Enable/Disable PUSCH EVM measure.")
     ("expert.tx_amplitude", bpo::value<float>(&args->phy.tx_amplitude)->default_value(0.6), "Transmit amplitude factor.")
     ("expert.nof_phy_threads", bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3), "Number of PHY threads.")
+    ("expert.tx_pipeline", bpo::value<bool>(&args->phy.tx_pipeline)->default_value(false), "Modulate the OFDM symbols in a dedicated thread per PHY worker while the rest of the subframe is encoded.")
     ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. Only 1 or 0 is supported.")
     ("expert.max_prach_offset_us", bpo::value<float>(&args->phy.max_prach_offset_us)->default_value(30), "Maximum allowed RACH offset (in us).")
     ("expert.equalizer_mode", bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"), "Equalizer mode.")
@@ -278,6 +281,9 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.max_mac_dl_kos", bpo::value<uint32_t>(&args->general.max_mac_dl_kos)->default_value(100), "Maximum number of consecutive KOs in DL before triggering the UE's release (default 100).")
     ("expert.max_mac_ul_kos", bpo::value<uint32_t>(&args->general.max_mac_ul_kos)->default_value(100), "Maximum number of consecutive KOs in UL before triggering the UE's release (default 100).")
     ("expert.gtpu_tunnel_timeout", bpo::value<uint32_t>(&args->stack.gtpu_indirect_tunnel_timeout_msec)->default_value(0), "Maximum time that GTPU takes to release indirect forwarding tunnel since the last received GTPU PDU (0 for infinity).")
+    ("expert.gtpu_tx_batch", bpo::value<uint32_t>(&args->stack.gtpu_tx_batch_size)->default_value(1), "Number of S1-U PDUs sent with a single sendmmsg() call, at least once per TTI (1 to send each PDU right away, max 32).")
+    ("expert.pdcp_security_workers", bpo::value<int32_t>(&args->stack.pdcp.nof_security_workers)->default_value(-1), "Threads ciphering the DRB PDUs of all users in one batch per TTI (0 to cipher the batch in the stack thread, -1 to cipher each PDU as it is written).")
+    ("expert.pdcp_up_threads", bpo::value<uint32_t>(&args->stack.pdcp.nof_up_threads)->default_value(0), "User plane threads running PDCP, each one for a disjoint set of RNTIs (0 to run PDCP in the stack thread).")
     ("expert.rlf_release_timer_ms", bpo::value<uint32_t>(&args->general.rlf_release_timer_ms)->default_value(4000), "Time taken by eNB to release UE context after it detects an RLF.")
     ("expert.extended_cp", bpo::value<bool>(&args->phy.extended_cp)->default_value(false), "Use extended cyclic prefix")
     ("expert.ts1_reloc_prep_timeout", bpo::value<uint32_t>(&args->stack.s1ap.ts1_reloc_prep_timeout)->default_value(10000), "S1AP TS 36.413 TS1RelocPrep Expiry Timeout value in milliseconds.")
@@ -303,6 +309,8 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     // NR section
     ("scheduler.nr_pdsch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_dl_mcs)->default_value(28), "Fixed NR DL MCS (-1 for dynamic).")
     ("scheduler.nr_pusch_mcs", bpo::value<int>(&args->nr_stack.mac.sched_cfg.fixed_ul_mcs)->default_value(28), "Fixed NR UL MCS (-1 for dynamic).")
+    ("scheduler.nr_policy", bpo::value<string>(&args->nr_stack.mac.sched_cfg.sched_policy)->default_value("time_rr"), "NR DL and UL data scheduling policy (E.g. time_rr, time_pf)")
+    ("scheduler.nr_policy_args", bpo::value<string>(&args->nr_stack.mac.sched_cfg.sched_policy_args)->default_value("1"), "NR scheduler policy-specific arguments (fairness coefficient of time_pf)")
     ("expert.nr_pusch_max_its", bpo::value<uint32_t>(&args->phy.nr_pusch_max_its)->default_value(10),     "Maximum number of LDPC iterations for NR.")
   ;
 
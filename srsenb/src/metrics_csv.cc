@@ -63,6 +63,22 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
       file << "time;nof_ue;dl_brate;ul_brate;"
               "proc_rmem;proc_rmem_kB;proc_vmem_kB;sys_mem;system_load;thread_count";
 
+      // Add the latency percentiles of each stage
+      for (const char* stage : {"mac_sched",
+                                "mac_pdcch",
+                                "mac_pdu",
+                                "nr_mac_sched",
+                                "nr_mac_pdcch",
+                                "nr_mac_pdu",
+                                "phy_dl",
+                                "phy_ul",
+                                "nr_phy_dl",
+                                "nr_phy_ul"}) {
+        for (const char* stat : {"p50_us", "p99_us", "p99_9_us", "max_us"}) {
+          file << ";" << stage << "_" << stat;
+        }
+      }
+
       // Add the cpus
       for (uint32_t i = 0, e = metrics.sys.cpu_count; i != e; ++i) {
         file << ";cpu_" << std::to_string(i);
@@ -108,6 +124,23 @@ void metrics_csv::set_metrics(const enb_metrics_t& metrics, const uint32_t perio
     file << float_to_string(m.process_cpu_usage, 2);
     file << std::to_string(m.thread_count) << ";";
 
+    // Write the latency metrics.
+    for (const srsran::latency_metrics_t* l : {&metrics.stack.mac.latency.sched,
+                                               &metrics.stack.mac.latency.pdcch,
+                                               &metrics.stack.mac.latency.pdu,
+                                               &metrics.nr_stack.mac.latency.sched,
+                                               &metrics.nr_stack.mac.latency.pdcch,
+                                               &metrics.nr_stack.mac.latency.pdu,
+                                               &metrics.phy_latency.dl_encode,
+                                               &metrics.phy_latency.ul_decode,
+                                               &metrics.phy_latency.nr_dl_encode,
+                                               &metrics.phy_latency.nr_ul_decode}) {
+      file << float_to_string(l->p50_us, 3);
+      file << float_to_string(l->p99_us, 3);
+      file << float_to_string(l->p999_us, 3);
+      file << float_to_string(l->max_us, 3);
+    }
+
     // Write the cpu metrics.
     for (uint32_t i = 0, e = m.cpu_count, last_cpu_index = e - 1; i != e; ++i) {
       file << float_to_string(m.cpu_load[i], 2, (i != last_cpu_index));
@@ -95,13 +95,30 @@ DECLARE_METRIC("nof_rach", metric_nof_rach, uint32_t, "");
 DECLARE_METRIC_LIST("ue_list", mlist_ues, std::vector<mset_ue_container>);
 DECLARE_METRIC_SET("cell_container", mset_cell_container, metric_carrier_id, metric_pci, metric_nof_rach, mlist_ues);
 
+/// Latency container metrics.
+DECLARE_METRIC("stage", metric_stage, std::string, "");
+DECLARE_METRIC("nof_samples", metric_nof_samples, uint32_t, "");
+DECLARE_METRIC("p50_us", metric_p50_us, float, "");
+DECLARE_METRIC("p99_us", metric_p99_us, float, "");
+DECLARE_METRIC("p99_9_us", metric_p999_us, float, "");
+DECLARE_METRIC("max_us", metric_max_us, float, "");
+DECLARE_METRIC_SET("latency_container",
+                   mset_latency_container,
+                   metric_stage,
+                   metric_nof_samples,
+                   metric_p50_us,
+                   metric_p99_us,
+                   metric_p999_us,
+                   metric_max_us);
+
 /// Metrics root object.
 DECLARE_METRIC("type", metric_type_tag, std::string, "");
 DECLARE_METRIC("timestamp", metric_timestamp_tag, double, "");
 DECLARE_METRIC_LIST("cell_list", mlist_cell, std::vector<mset_cell_container>);
+DECLARE_METRIC_LIST("latency_list", mlist_latency, std::vector<mset_latency_container>);
 
 /// Metrics context.
-using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell>;
+using metric_context_t = srslog::build_context_type<metric_type_tag, metric_timestamp_tag, mlist_cell, mlist_latency>;
 
 } // namespace
 
@@ -174,6 +191,23 @@ static void fill_ue_metrics(mset_ue_container& ue, const enb_metrics_t& m, unsig
   }
 }
 
+/// Adds the latency of a processing stage to the list, if the stage ran in the metrics period.
+static void
+add_latency_metrics(std::vector<mset_latency_container>& list, const char* stage, const srsran::latency_metrics_t& m)
+{
+  if (m.nof_samples == 0) {
+    return;
+  }
+  list.emplace_back();
+  auto& latency = list.back();
+  latency.write<metric_stage>(stage);
+  latency.write<metric_nof_samples>(m.nof_samples);
+  latency.write<metric_p50_us>(m.p50_us);
+  latency.write<metric_p99_us>(m.p99_us);
+  latency.write<metric_p999_us>(m.p999_us);
+  latency.write<metric_max_us>(m.max_us);
+}
+
 /// Returns the current time in seconds with ms precision since UNIX epoch.
 static double get_time_stamp()
 {
@@ -238,6 +272,19 @@ void metrics_json::set_metrics(const enb_metrics_t& m, const uint32_t period_use
     }
   }
 
+  // Processing time of the L1/L2 stages in each TTI.
+  auto& latency_list = ctx.get<mlist_latency>();
+  add_latency_metrics(latency_list, "mac_sched", m.stack.mac.latency.sched);
+  add_latency_metrics(latency_list, "mac_pdcch", m.stack.mac.latency.pdcch);
+  add_latency_metrics(latency_list, "mac_pdu", m.stack.mac.latency.pdu);
+  add_latency_metrics(latency_list, "nr_mac_sched", m.nr_stack.mac.latency.sched);
+  add_latency_metrics(latency_list, "nr_mac_pdcch", m.nr_stack.mac.latency.pdcch);
+  add_latency_metrics(latency_list, "nr_mac_pdu", m.nr_stack.mac.latency.pdu);
+  add_latency_metrics(latency_list, "phy_dl_encode", m.phy_latency.dl_encode);
+  add_latency_metrics(latency_list, "phy_ul_decode", m.phy_latency.ul_decode);
+  add_latency_metrics(latency_list, "nr_phy_dl_encode", m.phy_latency.nr_dl_encode);
+  add_latency_metrics(latency_list, "nr_phy_ul_decode", m.phy_latency.nr_ul_decode);
+
   // Log the context.
   ctx.write<metric_timestamp_tag>(get_time_stamp());
   log_c(ctx);
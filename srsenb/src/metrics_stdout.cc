@@ -188,6 +188,11 @@ void metrics_stdout::set_metrics(const enb_metrics_t& metrics, const uint32_t pe
     fmt::print("RF status: O={}, U={}, L={}\n", metrics.rf.rf_o, metrics.rf.rf_u, metrics.rf.rf_l);
   }
 
+  // A real-time radio cannot sustain more than 1000 subframes per second, so a higher rate means virtual time
+  if (metrics.rf.tti_rate > 1050.0f) {
+    fmt::print("Virtual time: {:.0f} TTI/s\n", metrics.rf.tti_rate);
+  }
+
   if (metrics.stack.rrc.ues.size() == 0 && metrics.nr_stack.mac.ues.size() == 0) {
     return;
   }
@@ -231,14 +231,34 @@ void cc_worker::work_ul(const srsran_ul_sf_cfg_t& ul_sf_cfg, stack_interface_phy
 void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
                         stack_interface_phy_lte::dl_sched_t& dl_grants,
                         stack_interface_phy_lte::ul_sched_t& ul_grants,
-                        srsran_mbsfn_cfg_t*                  mbsfn_cfg)
+                        srsran_mbsfn_cfg_t*                  mbsfn_cfg,
+                        tx_modulator*                        modulator)
 {
   std::lock_guard<std::mutex> lock(mutex);
   dl_sf = dl_sf_cfg;
 
+  // Read the cell gain once per subframe, it is applied as the symbols are modulated
+  float cell_gain_db = phy->get_cell_gain(cc_idx);
+  cell_gain_scale    = std::isnormal(cell_gain_db) ? srsran_convert_dB_to_amplitude(cell_gain_db) : 1.0f;
+
   // Put base signals (references, PBCH, PCFICH and PSS/SSS) into the resource grid
   srsran_enb_dl_put_base(&enb_dl, &dl_sf);
 
+  // Normal subframes with a modulator: the control region is modulated while PDSCH is encoded
+  if (modulator != nullptr and dl_sf_cfg.sf_type == SRSRAN_SF_NORM) {
+    uint32_t nof_symbols      = SRSRAN_CP_NSYMB(enb_dl.cell.cp) * SRSRAN_NOF_SLOTS_PER_SF;
+    uint32_t nof_ctrl_symbols = SRSRAN_MIN(SRSRAN_NOF_CTRL_SYMBOLS(enb_dl.cell, dl_sf.cfi), nof_symbols);
+
+    encode_pdcch_dl(dl_grants.pdsch, dl_grants.nof_grants);
+    encode_pdcch_ul(ul_grants.pusch, ul_grants.nof_grants);
+    encode_phich(ul_grants.phich, ul_grants.nof_phich);
+    modulator->push(this, enb_dl.cell.nof_ports, 0, nof_ctrl_symbols);
+
+    encode_pdsch(dl_grants.pdsch, dl_grants.nof_grants);
+    modulator->push(this, enb_dl.cell.nof_ports, nof_ctrl_symbols, nof_symbols - nof_ctrl_symbols);
+    return;
+  }
+
   // Put DL grants to resource grid. PDSCH data will be encoded as well.
   if (dl_sf_cfg.sf_type == SRSRAN_SF_NORM) {
     encode_pdcch_dl(dl_grants.pdsch, dl_grants.nof_grants);
@@ -259,15 +279,28 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
   srsran_enb_dl_gen_signal(&enb_dl);
 
   // Scale if cell gain is set
-  float cell_gain_db = phy->get_cell_gain(cc_idx);
   if (std::isnormal(cell_gain_db)) {
-    float    scale  = srsran_convert_dB_to_amplitude(cell_gain_db);
     uint32_t sf_len = SRSRAN_SF_LEN_PRB(enb_dl.cell.nof_prb);
     for (uint32_t i = 0; i < enb_dl.cell.nof_ports; i++) {
-      srsran_vec_sc_prod_cfc(signal_buffer_tx[i], scale, signal_buffer_tx[i], sf_len);
+      srsran_vec_sc_prod_cfc(signal_buffer_tx[i], cell_gain_scale, signal_buffer_tx[i], sf_len);
     }
   }
+}
 
+void cc_worker::modulate_symbols(uint32_t port, uint32_t first_symbol, uint32_t nof_symbols)
+{
+  srsran_enb_dl_gen_signal_symbols(&enb_dl, port, first_symbol, nof_symbols);
+
+  // Scale if cell gain is set
+  if (cell_gain_scale != 1.0f) {
+    uint32_t offset = srsran_ofdm_get_symbol_offset(&enb_dl.ifft[port], first_symbol);
+    uint32_t len    = srsran_ofdm_get_symbol_offset(&enb_dl.ifft[port], first_symbol + nof_symbols) - offset;
+    srsran_vec_sc_prod_cfc(&signal_buffer_tx[port][offset], cell_gain_scale, &signal_buffer_tx[port][offset], len);
+  }
+}
+
+void cc_worker::finish_dl()
+{
   // Measure PAPR if flag was triggered
   bool cell_meas_flag = phy->get_cell_measure_trigger(cc_idx);
   if (cell_meas_flag) {
@@ -20,6 +20,7 @@
  */
 
 #include "srsran/common/threads.h"
+#include "srsran/common/time_prof.h"
 #include "srsran/srsran.h"
 
 #include "srsenb/hdr/phy/lte/sf_worker.h"
@@ -72,7 +73,7 @@ namespace lte {
 FILE* f;
 #endif
 
-void sf_worker::init(phy_common* phy_)
+void sf_worker::init(phy_common* phy_, int prio)
 {
   phy = phy_;
 
@@ -95,6 +96,12 @@ void sf_worker::init(phy_common* phy_)
 
   srsran_softbuffer_tx_reset(&temp_mbsfn_softbuffer);
 
+  // Start the modulator thread, shared by all the carriers of this worker
+  if (phy->params.tx_pipeline) {
+    modulator = std::unique_ptr<tx_modulator>(new tx_modulator);
+    modulator->init(prio);
+  }
+
   Info("Worker %d configured cell %d PRB", get_id(), phy->get_nof_prb(0));
 
   initiated = true;
@@ -189,9 +196,12 @@ void sf_worker::work_imp()
   }
 
   // Process UL
+  srsran::tprof_measure proc_meas;
+  proc_meas.start();
   for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
     cc_workers[cc]->work_ul(ul_sf, ul_grants[cc]);
   }
+  ul_latency.record(proc_meas.stop());
 
   // Get DL scheduling for the TX TTI from MAC
   if (sf_type == SRSRAN_SF_NORM) {
@@ -225,15 +235,25 @@ void sf_worker::work_imp()
   phy->ue_db.clear_tti_pending_ack(tti_tx_ul);
 
   // Process DL
+  proc_meas.start();
   for (uint32_t cc = 0; cc < cc_workers.size(); cc++) {
     // Select CFI and make sure it is in the right range
     dl_sf.cfi = dl_grants[cc].cfi;
     dl_sf.cfi = SRSRAN_MAX(dl_sf.cfi, 1);
     dl_sf.cfi = SRSRAN_MIN(dl_sf.cfi, 3);
 
-    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg);
+    cc_workers[cc]->work_dl(dl_sf, dl_grants[cc], ul_grants_tx[cc], &mbsfn_cfg, modulator.get());
   }
 
+  // Wait for the modulation of all carriers to finish
+  if (modulator != nullptr) {
+    modulator->wait_idle();
+  }
+  for (auto& w : cc_workers) {
+    w->finish_dl();
+  }
+  dl_latency.record(proc_meas.stop());
+
   // Save grants
   phy->set_ul_grants(tti_tx_ul, ul_grants_tx);
 
@@ -267,6 +287,12 @@ void sf_worker::work_imp()
 }
 
 /************ METRICS interface ********************/
+void sf_worker::read_latency(srsran::latency_histogram::snapshot& dl, srsran::latency_histogram::snapshot& ul)
+{
+  dl_latency.read_and_reset(dl);
+  ul_latency.read_and_reset(ul);
+}
+
 uint32_t sf_worker::get_metrics(std::vector<phy_metrics_t>& metrics)
 {
   uint32_t                   cnt = 0;
@@ -35,7 +35,7 @@ bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink&
     log.set_hex_dump_max_size(args.log.phy_hex_limit);
 
     auto w = std::unique_ptr<lte::sf_worker>(new sf_worker(log));
-    w->init(common);
+    w->init(common, prio);
     pool.init_worker(i, w.get(), prio);
     workers.push_back(std::move(w));
   }
@@ -22,6 +22,7 @@
 #include "srsenb/hdr/phy/nr/slot_worker.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
+#include "srsran/common/time_prof.h"
 
 //#define DEBUG_WRITE_FILE
 
@@ -104,6 +105,12 @@ bool slot_worker::init(const args_t& args)
     return false;
   }
 
+  // Start the modulator thread
+  if (args.tx_pipeline) {
+    modulator = std::unique_ptr<tx_modulator>(new tx_modulator);
+    modulator->init(args.prio);
+  }
+
 #ifdef DEBUG_WRITE_FILE
   const char* filename = "nr_baseband.dat";
   printf("Opening %s to dump baseband\n", filename);
@@ -115,6 +122,11 @@ bool slot_worker::init(const args_t& args)
 
 slot_worker::~slot_worker()
 {
+  // Stop the modulator before releasing the buffers it writes
+  if (modulator != nullptr) {
+    modulator->stop();
+  }
+
   for (auto& b : tx_buffer) {
     if (b) {
       free(b);
@@ -172,8 +184,12 @@ bool slot_worker::work_ul()
     return false;
   }
 
+  srsran::tprof_measure proc_meas;
+  proc_meas.start();
+
   if (ul_sched->pucch.empty() && ul_sched->pusch.empty()) {
     // early exit if nothing has been scheduled
+    ul_latency.record(proc_meas.stop());
     return true;
   }
 
@@ -280,6 +296,7 @@ bool slot_worker::work_ul()
     }
   }
 
+  ul_latency.record(proc_meas.stop());
   return true;
 }
 
@@ -299,6 +316,9 @@ bool slot_worker::work_dl()
     return false;
   }
 
+  srsran::tprof_measure proc_meas;
+  proc_meas.start();
+
   if (srsran_gnb_dl_base_zero(&gnb_dl) < SRSRAN_SUCCESS) {
     logger.error("Error zeroing RE grid");
     return false;
@@ -348,6 +368,19 @@ bool slot_worker::work_dl()
     }
   }
 
+  // Modulate the symbols before the first PDSCH or NZP-CSI-RS symbol while the rest of the slot is encoded
+  uint32_t nof_symbols      = SRSRAN_NSYMB_PER_SLOT_NR;
+  uint32_t nof_ctrl_symbols = nof_symbols;
+  if (modulator != nullptr) {
+    for (const stack_interface_phy_nr::pdsch_t& pdsch : dl_sched_ptr->pdsch) {
+      nof_ctrl_symbols = SRSRAN_MIN(nof_ctrl_symbols, pdsch.sch.grant.S);
+    }
+    for (const srsran_csi_rs_nzp_resource_t& nzp_csi_rs : dl_sched_ptr->nzp_csi_rs) {
+      nof_ctrl_symbols = SRSRAN_MIN(nof_ctrl_symbols, nzp_csi_rs.resource_mapping.first_symbol_idx);
+    }
+    modulator->push(this, gnb_dl.nof_tx_antennas, 0, nof_ctrl_symbols);
+  }
+
   // Encode PDSCH
   for (const stack_interface_phy_nr::pdsch_t& pdsch : dl_sched_ptr->pdsch) {
     // convert MAC to PHY buffer data structures
@@ -388,7 +421,12 @@ bool slot_worker::work_dl()
   }
 
   // Generate baseband signal
-  srsran_gnb_dl_gen_signal(&gnb_dl);
+  if (modulator != nullptr) {
+    modulator->push(this, gnb_dl.nof_tx_antennas, nof_ctrl_symbols, nof_symbols - nof_ctrl_symbols);
+    modulator->wait_idle();
+  } else {
+    srsran_gnb_dl_gen_signal(&gnb_dl);
+  }
 
   // Add SSB to the baseband signal
   for (const stack_interface_phy_nr::ssb_t& ssb : dl_sched_ptr->ssb) {
@@ -398,9 +436,21 @@ bool slot_worker::work_dl()
     }
   }
 
+  dl_latency.record(proc_meas.stop());
   return true;
 }
 
+void slot_worker::modulate_symbols(uint32_t port, uint32_t first_symbol, uint32_t nof_symbols)
+{
+  srsran_gnb_dl_gen_signal_symbols(&gnb_dl, port, first_symbol, nof_symbols);
+}
+
+void slot_worker::read_latency(srsran::latency_histogram::snapshot& dl, srsran::latency_histogram::snapshot& ul)
+{
+  dl_latency.read_and_reset(dl);
+  ul_latency.read_and_reset(ul);
+}
+
 void slot_worker::work_imp()
 {
   // Inform Scheduler about new slot
@@ -425,6 +475,10 @@ void slot_worker::work_imp()
 
   // Process downlink
   if (not work_dl()) {
+    // Make sure the modulator does not write the buffers once the worker is released
+    if (modulator != nullptr) {
+      modulator->wait_idle();
+    }
     common.worker_end(context, false, tx_rf_buffer);
     return;
   }
@@ -73,6 +73,8 @@ bool worker_pool::init(const args_t& args, const phy_cell_cfg_list_nr_t& cell_li
     w_args.srate_hz                = srate_hz;
     w_args.pusch_max_its           = args.pusch_max_its;
     w_args.pusch_min_snr_dB        = args.pusch_min_snr_dB;
+    w_args.tx_pipeline             = args.tx_pipeline;
+    w_args.prio                    = args.prio;
 
     if (not w->init(w_args)) {
       return false;
@@ -116,6 +118,13 @@ void worker_pool::stop()
   prach.stop();
 }
 
+void worker_pool::read_latency(srsran::latency_histogram::snapshot& dl, srsran::latency_histogram::snapshot& ul)
+{
+  for (auto& w : workers) {
+    w->read_latency(dl, ul);
+  }
+}
+
 int worker_pool::set_common_cfg(const phy_interface_rrc_nr::common_cfg_t& common_cfg)
 {
   // Best effort to convert NR carrier into LTE cell
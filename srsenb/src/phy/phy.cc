@@ -286,6 +286,24 @@ void phy::get_metrics(std::vector<phy_metrics_t>& metrics)
   }
 }
 
+void phy::get_latency_metrics(phy_latency_metrics_t& metrics)
+{
+  // The samples of all the workers of a RAT are merged, as any of them can process a given TTI/slot
+  srsran::latency_histogram::snapshot dl, ul;
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    lte_workers[i]->read_latency(dl, ul);
+  }
+  metrics.dl_encode = dl.get_metrics();
+  metrics.ul_decode = ul.get_metrics();
+
+  srsran::latency_histogram::snapshot nr_dl, nr_ul;
+  if (nr_workers != nullptr) {
+    nr_workers->read_latency(nr_dl, nr_ul);
+  }
+  metrics.nr_dl_encode = nr_dl.get_metrics();
+  metrics.nr_ul_decode = nr_ul.get_metrics();
+}
+
 void phy::cmd_cell_gain(uint32_t cell_id, float gain_db)
 {
   Info("set_cell_gain: cell_id=%d, gain_db=%.2f", cell_id, gain_db);
@@ -376,6 +394,7 @@ int phy::init_nr(const phy_args_t& args, const phy_cfg_t& cfg, stack_interface_p
   worker_args.log.phy_level           = args.log.phy_level;
   worker_args.log.phy_hex_limit       = args.log.phy_hex_limit;
   worker_args.pusch_max_its           = args.nr_pusch_max_its;
+  worker_args.tx_pipeline             = args.tx_pipeline;
 
   if (not nr_workers->init(worker_args, cfg.phy_cell_cfg_nr)) {
     return SRSRAN_ERROR;
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "srsenb/hdr/phy/tx_modulator.h"
+
+namespace srsenb {
+
+void tx_modulator::init(int prio)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (running) {
+    return;
+  }
+  running = true;
+  start(prio);
+}
+
+void tx_modulator::push(symbol_modulator* q, uint32_t nof_ports, uint32_t first_symbol, uint32_t nof_symbols)
+{
+  if (q == nullptr or nof_symbols == 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  // Without a running thread, modulate in the caller context
+  if (not running) {
+    for (uint32_t port = 0; port < nof_ports; port++) {
+      q->modulate_symbols(port, first_symbol, nof_symbols);
+    }
+    return;
+  }
+
+  for (uint32_t port = 0; port < nof_ports; port++) {
+    jobs.push_back({q, port, first_symbol, nof_symbols});
+  }
+  cvar_job.notify_one();
+}
+
+void tx_modulator::wait_idle()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while (busy or not jobs.empty()) {
+    cvar_idle.wait(lock);
+  }
+}
+
+void tx_modulator::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not running) {
+      return;
+    }
+    running = false;
+    jobs.clear();
+    cvar_job.notify_all();
+  }
+
+  wait_thread_finish();
+
+  // Release any waiter
+  std::lock_guard<std::mutex> lock(mutex);
+  cvar_idle.notify_all();
+}
+
+void tx_modulator::run_thread()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while (running) {
+    if (jobs.empty()) {
+      cvar_idle.notify_all();
+      cvar_job.wait(lock);
+      continue;
+    }
+
+    job_t job = jobs.front();
+    jobs.pop_front();
+    busy = true;
+
+    // Modulate without holding the lock so the worker can keep queueing jobs
+    lock.unlock();
+    job.q->modulate_symbols(job.port, job.first_symbol, job.nof_symbols);
+    lock.lock();
+
+    busy = false;
+  }
+}
+
+} // namespace srsenb
@@ -134,7 +134,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
     return SRSRAN_ERROR;
   }
   rlc.init(&pdcp, &rrc, &mac, task_sched.get_timer_handler());
-  pdcp.init(&rlc, &rrc, gtpu_adapter.get());
+  pdcp.init(&rlc, &rrc, gtpu_adapter.get(), args.pdcp);
   if (rrc.init(rrc_cfg, phy, &mac, &rlc, &pdcp, &s1ap, &gtpu, x2_) != SRSRAN_SUCCESS) {
     stack_logger.error("Couldn't initialize RRC");
     return SRSRAN_ERROR;
@@ -151,6 +151,7 @@ int enb_stack_lte::init(const stack_args_t&      args_,
   gtpu_args.mme_addr                     = args.s1ap.mme_addr;
   gtpu_args.gtp_bind_addr                = args.s1ap.gtp_bind_addr;
   gtpu_args.indirect_tunnel_timeout_msec = args.gtpu_indirect_tunnel_timeout_msec;
+  gtpu_args.tx_batch_size                = args.gtpu_tx_batch_size;
   if (gtpu.init(gtpu_args, gtpu_adapter.get()) != SRSRAN_SUCCESS) {
     stack_logger.error("Couldn't initialize GTPU");
     return SRSRAN_ERROR;
@@ -173,6 +174,8 @@ void enb_stack_lte::tti_clock_impl()
 {
   task_sched.tic();
   rrc.tti_clock();
+  pdcp.run_tti();
+  gtpu.run_tti();
 }
 
 void enb_stack_lte::stop()
@@ -264,6 +264,11 @@ void mac::get_metrics(mac_metrics_t& metrics)
     metrics.cc_info[cc].cc_rach_counter = detected_rachs[cc];
     metrics.cc_info[cc].pci             = (cc < cell_config.size()) ? cell_config[cc].cell.id : 0;
   }
+
+  scheduler.latency_metrics_read(metrics.latency);
+  srsran::latency_histogram::snapshot pdu_samples;
+  pdu_latency.read_and_reset(pdu_samples);
+  metrics.latency.pdu = pdu_samples.get_metrics();
 }
 
 void mac::toggle_padding()
@@ -650,6 +655,7 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
 
   srsran::rwlock_read_guard lock(rwlock);
 
+  std::chrono::nanoseconds pdu_time{0};
   for (uint32_t enb_cc_idx = 0; enb_cc_idx < cell_config.size(); enb_cc_idx++) {
     // Run scheduler with current info
     sched_interface::dl_sched_res_t sched_result = {};
@@ -658,6 +664,9 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
       return SRSRAN_ERROR;
     }
 
+    srsran::tprof_measure pdu_meas;
+    pdu_meas.start();
+
     int         n            = 0;
     dl_sched_t* dl_sched_res = &dl_sched_res_list[enb_cc_idx];
 
@@ -811,7 +820,10 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
 
     // Number of CCH symbols
     dl_sched_res->cfi = sched_result.cfi;
+
+    pdu_time += pdu_meas.stop();
   }
+  pdu_latency.record(pdu_time);
 
   // Count number of TTIs for all active users
   for (auto& u : ue_db) {
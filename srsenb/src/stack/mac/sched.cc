@@ -25,6 +25,7 @@
 #include "srsenb/hdr/stack/mac/sched.h"
 #include "srsenb/hdr/stack/mac/sched_carrier.h"
 #include "srsenb/hdr/stack/mac/sched_helpers.h"
+#include "srsran/common/time_prof.h"
 #include "srsran/srslog/srslog.h"
 
 #define Console(fmt, ...) srsran::console(fmt, ##__VA_ARGS__)
@@ -91,6 +92,12 @@ int sched::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg)
     carrier_schedulers[i]->carrier_cfg(sched_cell_params[i]);
   }
 
+  // Spawn the workers that schedule carriers in parallel. By default, one per additional carrier
+  uint32_t nof_workers = sched_cfg.nof_cc_workers >= 0 ? sched_cfg.nof_cc_workers : sched_cell_params.size() - 1;
+  if (nof_workers > 0 and cc_workers == nullptr) {
+    cc_workers.reset(new srsran::task_thread_pool(nof_workers, false, CC_WORKERS_THREAD_PRIO));
+  }
+
   configured = true;
   return 0;
 }
@@ -357,17 +364,104 @@ int sched::ul_sched(uint32_t tti, uint32_t enb_cc_idx, srsenb::sched_interface::
 /// Generate scheduling decision for tti_rx, if it wasn't already generated
 /// NOTE: The scheduling decision is made for all CCs in a single call/lock, otherwise the UE can have different
 ///       configurations (e.g. different set of activated SCells) in different CC decisions
+/// NOTE: Carriers without CA users do not share any UE state, so they are scheduled in parallel by the workers. The
+///       carriers of CA users are scheduled sequentially by the calling thread, in CC order
 void sched::new_tti(tti_point tti_rx)
 {
+  srsran::tprof_measure sched_meas;
+  sched_meas.start();
+
   last_tti = std::max(last_tti, tti_rx);
 
-  // Generate sched results for all CCs, if not yet generated
-  for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+  // Find the CCs whose sched result was not yet generated
+  srsran::bounded_vector<uint32_t, SRSRAN_MAX_CARRIERS> serial_ccs, parallel_ccs;
+  for (uint32_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
     if (not is_generated(tti_rx, cc_idx)) {
-      // Generate carrier scheduling result
+      if (cc_workers != nullptr and not has_ca_users(cc_idx)) {
+        parallel_ccs.push_back(cc_idx);
+      } else {
+        serial_ccs.push_back(cc_idx);
+      }
+    }
+  }
+  if (serial_ccs.empty() and parallel_ccs.empty()) {
+    return;
+  }
+  start_tti(tti_rx);
+
+  // The calling thread always schedules at least one carrier
+  if (serial_ccs.empty()) {
+    serial_ccs.push_back(parallel_ccs.back());
+    parallel_ccs.pop_back();
+  }
+
+  // Generate carrier scheduling results
+  {
+    std::lock_guard<std::mutex> lock(cc_workers_mutex);
+    nof_pending_cc_tasks = parallel_ccs.size();
+  }
+  for (uint32_t cc_idx : parallel_ccs) {
+    cc_workers->push_task([this, cc_idx, tti_rx]() {
       carrier_schedulers[cc_idx]->generate_tti_result(tti_rx);
+      std::lock_guard<std::mutex> lock(cc_workers_mutex);
+      if (--nof_pending_cc_tasks == 0) {
+        cc_workers_cvar.notify_one();
+      }
+    });
+  }
+  for (uint32_t cc_idx : serial_ccs) {
+    carrier_schedulers[cc_idx]->generate_tti_result(tti_rx);
+  }
+
+  // Wait for the workers to finish
+  {
+    std::unique_lock<std::mutex> lock(cc_workers_mutex);
+    while (nof_pending_cc_tasks > 0) {
+      cc_workers_cvar.wait(lock);
+    }
+  }
+
+  std::chrono::nanoseconds pdcch_alloc_time{0};
+  for (uint32_t cc_idx : serial_ccs) {
+    pdcch_alloc_time += carrier_schedulers[cc_idx]->get_last_pdcch_alloc_time();
+  }
+  for (uint32_t cc_idx : parallel_ccs) {
+    pdcch_alloc_time += carrier_schedulers[cc_idx]->get_last_pdcch_alloc_time();
+  }
+  pdcch_latency.record(pdcch_alloc_time);
+  sched_latency.record(sched_meas.stop());
+}
+
+/// Sets up the state shared by all carriers for tti_rx, before the carrier scheduling results are generated
+void sched::start_tti(tti_point tti_rx)
+{
+  // Reset the sched results of tti_rx and of its Msg3 TTI
+  for (tti_point tti : {tti_rx, tti_rx + MSG3_DELAY_MS}) {
+    if (not sched_results.has_sf(tti)) {
+      sched_results.new_tti(tti);
     }
   }
+
+  // Refresh UE internal buffers and subframe vars
+  for (auto& user : ue_db) {
+    user.second->new_subframe(tti_rx, 0);
+  }
+}
+
+/// Check if any UE with more than one configured carrier can be scheduled in the given carrier
+bool sched::has_ca_users(uint32_t enb_cc_idx)
+{
+  for (auto& user : ue_db) {
+    const auto& cc_list = user.second->get_ue_cfg().supported_cc_list;
+    if (cc_list.size() > 1) {
+      for (const auto& cc : cc_list) {
+        if (cc.enb_cc_idx == enb_cc_idx) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
 }
 
 /// Check if TTI result is generated
@@ -382,6 +476,15 @@ int sched::metrics_read(uint16_t rnti, mac_ue_metrics_t& metrics)
       rnti, [&metrics](sched_ue& ue) { ue.metrics_read(metrics); }, "metrics_read");
 }
 
+void sched::latency_metrics_read(mac_latency_metrics_t& metrics)
+{
+  srsran::latency_histogram::snapshot sched_samples, pdcch_samples;
+  sched_latency.read_and_reset(sched_samples);
+  pdcch_latency.read_and_reset(pdcch_samples);
+  metrics.sched = sched_samples.get_metrics();
+  metrics.pdcch = pdcch_samples.get_metrics();
+}
+
 // Common way to access ue_db elements in a read locking way
 template <typename Func>
 int sched::ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name, bool log_fail)
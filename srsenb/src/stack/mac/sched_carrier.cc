@@ -401,11 +401,6 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
 
   bool dl_active = sf_dl_mask[tti_sched->get_tti_tx_dl().to_uint() % sf_dl_mask.size()] == 0;
 
-  /* Refresh UE internal buffers and subframe vars */
-  for (auto& user : *ue_db) {
-    user.second->new_subframe(tti_rx, enb_cc_idx);
-  }
-
   /* Schedule PHICH */
   for (auto& ue_pair : *ue_db) {
     if (tti_sched->alloc_phich(ue_pair.second.get()) == alloc_result::no_grant_space) {
@@ -443,6 +438,7 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
 
   /* Select the winner DCI allocation combination, store all the scheduling results */
   tti_sched->generate_sched_results(*ue_db);
+  last_pdcch_alloc_time = tti_sched->get_pdcch_alloc_time();
 
   /* Reset ue harq pending ack state, clean-up blocked pids */
   for (auto& user : *ue_db) {
@@ -22,6 +22,7 @@
 #include "srsenb/hdr/stack/mac/sched_grid.h"
 #include "srsenb/hdr/stack/mac/sched_helpers.h"
 #include "srsran/common/string_helpers.h"
+#include "srsran/common/time_prof.h"
 
 namespace srsenb {
 
@@ -128,6 +129,7 @@ void sf_grid_t::new_tti(tti_point tti_rx_)
 
   // internal state
   pdcch_alloc.new_tti(tti_rx);
+  pdcch_alloc_time = {};
 }
 
 //! Allocates CCEs and RBs for the given mask and allocation type (e.g. data, BC, RAR, paging)
@@ -144,7 +146,11 @@ alloc_result sf_grid_t::alloc_dl(uint32_t     aggr_idx,
   }
 
   // Allocate DCI in PDCCH
-  if (not pdcch_alloc.alloc_dci(alloc_type, aggr_idx, user, has_pusch_grant)) {
+  srsran::tprof_measure pdcch_meas;
+  pdcch_meas.start();
+  bool pdcch_success = pdcch_alloc.alloc_dci(alloc_type, aggr_idx, user, has_pusch_grant);
+  pdcch_alloc_time += pdcch_meas.stop();
+  if (not pdcch_success) {
     if (logger.debug.enabled()) {
       if (user != nullptr) {
         logger.debug("SCHED: No space in PDCCH for rnti=0x%x DL tx. Current PDCCH allocation:\n%s",
@@ -211,7 +217,12 @@ alloc_result sf_grid_t::alloc_ul_data(sched_ue* user, prb_interval alloc, bool n
   if (needs_pdcch) {
     uint32_t nof_bits = srsran_dci_format_sizeof(&cc_cfg->cfg.cell, nullptr, nullptr, SRSRAN_DCI_FORMAT0);
     uint32_t aggr_idx = user->get_aggr_level(cc_cfg->enb_cc_idx, nof_bits);
-    if (not pdcch_alloc.alloc_dci(alloc_type_t::UL_DATA, aggr_idx, user)) {
+
+    srsran::tprof_measure pdcch_meas;
+    pdcch_meas.start();
+    bool pdcch_success = pdcch_alloc.alloc_dci(alloc_type_t::UL_DATA, aggr_idx, user);
+    pdcch_alloc_time += pdcch_meas.stop();
+    if (not pdcch_success) {
       if (logger.debug.enabled()) {
         logger.debug("No space in PDCCH for rnti=0x%x UL tx. Current PDCCH allocation:\n%s",
                      user->get_rnti(),
@@ -538,7 +549,15 @@ alloc_result sf_sched::alloc_dl_user(sched_ue* user, const rbgmask_t& user_mask,
     }
   }
 
-  bool has_pusch_grant = is_ul_alloc(user->get_rnti()) or cc_results->is_ul_alloc(user->get_rnti());
+  // Only the carriers where the UE is active are checked, as the remaining ones may be scheduled by other threads
+  bool has_pusch_grant = is_ul_alloc(user->get_rnti());
+  for (uint32_t enbccidx = 0; enbccidx < cc_results->enb_cc_list.size() and not has_pusch_grant; ++enbccidx) {
+    if (user->get_active_cell_index(enbccidx).first) {
+      for (const auto& pusch : cc_results->enb_cc_list[enbccidx].ul_sched_result.pusch) {
+        has_pusch_grant |= pusch.dci.rnti == user->get_rnti();
+      }
+    }
+  }
 
   // Check if there is space in the PUCCH for HARQ ACKs
   const sched_interface::ue_cfg_t& ue_cfg    = user->get_ue_cfg();
@@ -822,15 +841,18 @@ uci_pusch_t is_uci_included(const sf_sched*        sf_sched,
   }
 
   for (uint32_t enbccidx = 0; enbccidx < other_cc_results.enb_cc_list.size(); ++enbccidx) {
+    // Carriers where the UE is not active may be scheduled concurrently by other threads
+    auto p = user->get_active_cell_index(enbccidx);
+    if (not p.first or p.second >= ue_cc_idx) {
+      continue;
+    }
     for (uint32_t j = 0; j < other_cc_results.enb_cc_list[enbccidx].ul_sched_result.pusch.size(); ++j) {
       // Checks all the UL grants already allocated for the given rnti
       if (other_cc_results.enb_cc_list[enbccidx].ul_sched_result.pusch[j].dci.rnti == user->get_rnti()) {
-        auto p = user->get_active_cell_index(enbccidx);
-        // If the UE CC Idx is the lowest so far
-        if (p.first and p.second < ue_cc_idx) {
-          ue_cc_idx      = p.second;
-          sel_enb_cc_idx = enbccidx;
-        }
+        // The UE CC Idx is the lowest so far
+        ue_cc_idx      = p.second;
+        sel_enb_cc_idx = enbccidx;
+        break;
       }
     }
   }
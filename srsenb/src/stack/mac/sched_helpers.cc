@@ -300,6 +300,24 @@ bool sched_cell_params_t::set_cfg(uint32_t                             enb_cc_id
     nof_cce_table[cfix] = (uint32_t)ret;
   }
 
+  // precompute the CCE masks of the PDCCH candidates and of the common search spaces
+  for (uint32_t cfix = 0; cfix < SRSRAN_NOF_CFI; ++cfix) {
+    for (uint32_t aggr_idx = 0; aggr_idx < NOF_AGGR_LEVEL; ++aggr_idx) {
+      uint32_t                   L     = 1U << aggr_idx;
+      std::vector<pdcch_mask_t>& masks = cce_masks[cfix][aggr_idx];
+      masks.assign(nof_cce_table[cfix], pdcch_mask_t(nof_cce_table[cfix]));
+      for (uint32_t ncce = 0; ncce + L <= nof_cce_table[cfix]; ++ncce) {
+        masks[ncce].fill(ncce, ncce + L);
+      }
+    }
+  }
+  for (uint32_t cfix = 0; cfix < SRSRAN_NOF_CFI; ++cfix) {
+    generate_cce_mask(*this, common_locations[cfix], cfix + 1, common_masks[cfix]);
+    for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+      generate_cce_mask(*this, rar_locations[sf_idx][cfix], cfix + 1, rar_masks[sf_idx][cfix]);
+    }
+  }
+
   // PUCCH config struct for PUCCH position derivation
   pucch_cfg_common.format            = SRSRAN_PUCCH_FORMAT_1;
   pucch_cfg_common.delta_pucch_shift = cfg.delta_pucch_shift;
@@ -364,6 +382,33 @@ cce_frame_position_table generate_cce_location_table(uint16_t rnti, const sched_
   return dci_locations;
 }
 
+cce_frame_mask_table generate_cce_mask_table(const cce_frame_position_table& locations,
+                                             const sched_cell_params_t&      cell_cfg)
+{
+  cce_frame_mask_table dci_masks = {};
+  for (uint32_t cfi = 0; cfi < SRSRAN_NOF_CFI; cfi++) {
+    for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; sf_idx++) {
+      generate_cce_mask(cell_cfg, locations[sf_idx][cfi], cfi + 1, dci_masks[sf_idx][cfi]);
+    }
+  }
+  return dci_masks;
+}
+
+void generate_cce_mask(const sched_cell_params_t&    cell_cfg,
+                       const cce_cfi_position_table& locations,
+                       uint32_t                      cfi,
+                       cce_cfi_mask_table&           masks)
+{
+  const auto& cfi_cce_masks = cell_cfg.cce_masks[cfi - 1];
+  for (uint32_t aggr_idx = 0; aggr_idx < NOF_AGGR_LEVEL; ++aggr_idx) {
+    masks[aggr_idx].resize(cell_cfg.nof_cce_table[cfi - 1]);
+    masks[aggr_idx].reset();
+    for (uint32_t ncce : locations[aggr_idx]) {
+      masks[aggr_idx] |= cfi_cce_masks[aggr_idx][ncce];
+    }
+  }
+}
+
 void generate_cce_location(srsran_regs_t*          regs_,
                            cce_cfi_position_table& locations,
                            uint32_t                cfi,
@@ -40,10 +40,12 @@ void sf_cch_allocator::init(const sched_cell_params_t& cell_params_)
   dci_record_list.reserve(16);
   last_dci_dfs.reserve(16);
   temp_dci_dfs.reserve(16);
+  dci_pos_hints.reserve(16);
 }
 
 void sf_cch_allocator::new_tti(tti_point tti_rx_)
 {
+  save_dci_pos_hints();
   tti_rx = tti_rx_;
 
   dci_record_list.clear();
@@ -72,16 +74,68 @@ sf_cch_allocator::get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uin
   return nullptr;
 }
 
+const cce_cfi_mask_table*
+sf_cch_allocator::get_cce_mask_table(alloc_type_t alloc_type, sched_ue* user, uint32_t cfix) const
+{
+  switch (alloc_type) {
+    case alloc_type_t::DL_BC:
+    case alloc_type_t::DL_PCCH:
+    case alloc_type_t::DL_PDCCH_ORDER:
+      return &cc_cfg->common_masks[cfix];
+    case alloc_type_t::DL_RAR:
+      return &cc_cfg->rar_masks[to_tx_dl(tti_rx).sf_idx()][cfix];
+    case alloc_type_t::DL_DATA:
+    case alloc_type_t::UL_DATA:
+      return user->get_location_masks(cc_cfg->enb_cc_idx, cfix + 1, to_tx_dl(tti_rx).sf_idx());
+    default:
+      break;
+  }
+  return nullptr;
+}
+
+void sf_cch_allocator::save_dci_pos_hints()
+{
+  dci_pos_hints.clear();
+  if (not tti_rx.is_valid()) {
+    return;
+  }
+  hint_sf_idx = to_tx_dl(tti_rx).sf_idx();
+  hint_cfix   = current_cfix;
+  for (size_t i = 0; i < last_dci_dfs.size(); ++i) {
+    const alloc_record& record = dci_record_list[i];
+    if (record.user != nullptr) {
+      dci_pos_hints.push_back({last_dci_dfs[i].rnti, record.alloc_type, record.aggr_idx, last_dci_dfs[i].dci_pos_idx});
+    }
+  }
+}
+
+int sf_cch_allocator::get_first_dci_pos_idx(const alloc_record& record) const
+{
+  // The UE search space only repeats itself every frame
+  if (record.user == nullptr or to_tx_dl(tti_rx).sf_idx() != hint_sf_idx) {
+    return -1;
+  }
+  for (const dci_pos_hint& hint : dci_pos_hints) {
+    if (hint.rnti == record.user->get_rnti() and hint.alloc_type == record.alloc_type and
+        hint.aggr_idx == record.aggr_idx) {
+      return hint.dci_pos_idx;
+    }
+  }
+  return -1;
+}
+
 bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sched_ue* user, bool has_pusch_grant)
 {
   temp_dci_dfs.clear();
   uint32_t start_cfix = current_cfix;
+  nof_dfs_nodes       = 0;
 
   alloc_record record;
-  record.user       = user;
-  record.aggr_idx   = aggr_idx;
-  record.alloc_type = alloc_type;
-  record.pusch_uci  = has_pusch_grant;
+  record.user              = user;
+  record.aggr_idx          = aggr_idx;
+  record.alloc_type        = alloc_type;
+  record.pusch_uci         = has_pusch_grant;
+  record.first_dci_pos_idx = get_first_dci_pos_idx(record);
 
   if (is_dl_ctrl_alloc(alloc_type) and nof_allocs() == 0 and cc_cfg->nof_prb() <= 25 and
       current_max_cfix > current_cfix) {
@@ -116,7 +170,7 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
     if (temp_dci_dfs.empty()) {
       temp_dci_dfs = last_dci_dfs;
     }
-  } while (get_next_dfs());
+  } while (get_next_dfs(record));
 
   // Revert steps to initial state, before dci record allocation was attempted
   last_dci_dfs.swap(temp_dci_dfs);
@@ -124,23 +178,41 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
   return false;
 }
 
-bool sf_cch_allocator::get_next_dfs()
+bool sf_cch_allocator::get_next_dfs(const alloc_record& failed_record)
 {
+  // The nodes after the last node blocking the failed record are erased, as other DCI positions for them cannot
+  // make room for it. They are placed again, starting from their first DCI position, after the blocking node moves
+  last_dci_dfs.erase(last_dci_dfs.begin() + get_nof_blocking_nodes(failed_record), last_dci_dfs.end());
+
   do {
     uint32_t start_child_idx = 0;
-    if (last_dci_dfs.empty()) {
-      // If we reach root, increase CFI
+    if (last_dci_dfs.empty() or nof_dfs_nodes >= MAX_DFS_NODES) {
+      // If we reach root or the search takes too long, increase CFI. In the latter case, the DCI positions not yet
+      // visited for this CFI may still have room for the record
+      if (not last_dci_dfs.empty()) {
+        dfs_budget_hits++;
+        logger.debug("SCHED: PDCCH search for CFI=%d stopped after %d DFS nodes", current_cfix + 1, nof_dfs_nodes);
+      }
+      last_dci_dfs.clear();
+      nof_dfs_nodes = 0;
       current_cfix++;
       if (current_cfix > current_max_cfix) {
         return false;
       }
     } else {
       // Attempt to re-add last tree node, but with a higher node child index
-      start_child_idx = last_dci_dfs.back().dci_pos_idx + 1;
+      start_child_idx = last_dci_dfs.back().child_idx + 1;
       last_dci_dfs.pop_back();
     }
-    while (last_dci_dfs.size() < dci_record_list.size() and
-           alloc_dfs_node(dci_record_list[last_dci_dfs.size()], start_child_idx)) {
+    while (last_dci_dfs.size() < dci_record_list.size()) {
+      const alloc_record& record = dci_record_list[last_dci_dfs.size()];
+      if (not alloc_dfs_node(record, start_child_idx)) {
+        if (start_child_idx == 0) {
+          // None of the DCI positions of the record fit. Jump back to the last node blocking it
+          last_dci_dfs.erase(last_dci_dfs.begin() + get_nof_blocking_nodes(record), last_dci_dfs.end());
+        }
+        break;
+      }
       start_child_idx = 0;
     }
   } while (last_dci_dfs.size() < dci_record_list.size());
@@ -149,7 +221,28 @@ bool sf_cch_allocator::get_next_dfs()
   return true;
 }
 
-bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start_dci_idx)
+size_t sf_cch_allocator::get_nof_blocking_nodes(const alloc_record& record) const
+{
+  const cce_cfi_mask_table* dci_masks = get_cce_mask_table(record.alloc_type, record.user, current_cfix);
+  if (dci_masks == nullptr) {
+    return last_dci_dfs.size();
+  }
+  const pdcch_mask_t& search_space_mask = (*dci_masks)[record.aggr_idx];
+
+  bool pucch_collision = record.alloc_type == alloc_type_t::DL_DATA and not record.pusch_uci and
+                         not cc_cfg->sched_cfg->pucch_mux_enabled;
+
+  // A node blocks the record if it occupies CCEs of its search space or, for HARQ-ACKs, if it occupies a PUCCH PRB
+  for (size_t i = last_dci_dfs.size(); i > 0; --i) {
+    const tree_node& node = last_dci_dfs[i - 1];
+    if ((pucch_collision and node.pucch_n_prb >= 0) or (node.current_mask & search_space_mask).any()) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start_child_idx)
 {
   // Get DCI Location Table
   const cce_cfi_position_table* dci_locs = get_cce_loc_table(record.alloc_type, record.user, current_cfix);
@@ -157,15 +250,24 @@ bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start
     return false;
   }
   const cce_position_list& dci_pos_list = (*dci_locs)[record.aggr_idx];
-  if (start_dci_idx >= dci_pos_list.size()) {
+  uint32_t                 nof_dci_pos  = dci_pos_list.size();
+  if (start_child_idx >= nof_dci_pos) {
     return false;
   }
+  nof_dfs_nodes++;
+
+  // Start from the DCI position of the previous solution, if it was found for the same CFI
+  uint32_t first_dci_pos_idx = 0;
+  if (record.first_dci_pos_idx >= 0 and current_cfix == hint_cfix) {
+    first_dci_pos_idx = record.first_dci_pos_idx % nof_dci_pos;
+  }
+  const std::vector<pdcch_mask_t>& cce_masks = cc_cfg->cce_masks[current_cfix][record.aggr_idx];
 
   tree_node node;
-  node.dci_pos_idx = start_dci_idx;
-  node.dci_pos.L   = record.aggr_idx;
-  node.rnti        = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
-  node.current_mask.resize(nof_cces());
+  node.child_idx  = start_child_idx;
+  node.record_idx = last_dci_dfs.size();
+  node.dci_pos.L  = record.aggr_idx;
+  node.rnti       = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
   // get cumulative pdcch & pucch masks
   if (not last_dci_dfs.empty()) {
     node.total_mask       = last_dci_dfs.back().total_mask;
@@ -175,7 +277,8 @@ bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start
     node.total_pucch_mask.resize(cc_cfg->nof_prb());
   }
 
-  for (; node.dci_pos_idx < dci_pos_list.size(); ++node.dci_pos_idx) {
+  for (; node.child_idx < nof_dci_pos; ++node.child_idx) {
+    node.dci_pos_idx  = (first_dci_pos_idx + node.child_idx) % nof_dci_pos;
     node.dci_pos.ncce = dci_pos_list[node.dci_pos_idx];
 
     if (record.alloc_type == alloc_type_t::DL_DATA and not record.pusch_uci) {
@@ -203,14 +306,14 @@ bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start
       }
     }
 
-    node.current_mask.reset();
-    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
-    if ((node.total_mask & node.current_mask).any()) {
+    const pdcch_mask_t& dci_mask = cce_masks[node.dci_pos.ncce];
+    if ((node.total_mask & dci_mask).any()) {
       // there is a PDCCH collision. Try another CCE position
       continue;
     }
 
     // Allocation successful
+    node.current_mask = dci_mask;
     node.total_mask |= node.current_mask;
     if (node.pucch_n_prb >= 0) {
       node.total_pucch_mask.set(node.pucch_n_prb);
@@ -43,6 +43,7 @@ sched_ue_cell::sched_ue_cell(uint16_t rnti_, const sched_cell_params_t& cell_cfg
   rnti(rnti_),
   cell_cfg(&cell_cfg_),
   dci_locations(generate_cce_location_table(rnti_, cell_cfg_)),
+  dci_masks(generate_cce_mask_table(dci_locations, cell_cfg_)),
   harq_ent(SCHED_MAX_HARQ_PROC, SCHED_MAX_HARQ_PROC),
   tpc_fsm(rnti_,
           cell_cfg->nof_prb(),
@@ -177,6 +178,9 @@ void sched_ue_cell::clear_feedback()
 
 void sched_ue_cell::finish_tti(tti_point tti_rx)
 {
+  if (not configured()) {
+    return;
+  }
   // clear_feedback PIDs with pending data or blocked
   harq_ent.finish_tti(tti_rx);
 }
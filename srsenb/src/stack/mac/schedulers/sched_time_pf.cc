@@ -20,36 +20,32 @@
  */
 
 #include "srsenb/hdr/stack/mac/schedulers/sched_time_pf.h"
-#include <vector>
+#include <algorithm>
+#include <cmath>
 
 namespace srsenb {
 
 using srsran::tti_point;
 
-sched_time_pf::sched_time_pf(const sched_cell_params_t& cell_params_, const sched_interface::sched_args_t& sched_args)
-{
-  cc_cfg = &cell_params_;
-  if (not sched_args.sched_policy_args.empty()) {
-    fairness_coeff = std::stof(sched_args.sched_policy_args);
-  }
+/// Weight of the last TTI in the average rates
+static const float pf_exp_avg_alpha = 0.01;
 
-  std::vector<ue_ctxt*> dl_storage;
-  dl_storage.reserve(SRSENB_MAX_UES);
-  dl_queue = ue_dl_queue_t(ue_dl_prio_compare{}, std::move(dl_storage));
+static float get_fairness_coeff(const sched_interface::sched_args_t& sched_args)
+{
+  return sched_args.sched_policy_args.empty() ? 1 : std::stof(sched_args.sched_policy_args);
+}
 
-  std::vector<ue_ctxt*> ul_storage;
-  ul_storage.reserve(SRSENB_MAX_UES);
-  ul_queue = ue_ul_queue_t(ue_ul_prio_compare{}, std::move(ul_storage));
+sched_time_pf::sched_time_pf(const sched_cell_params_t& cell_params_, const sched_interface::sched_args_t& sched_args) :
+  cc_cfg(&cell_params_), rate_decay(pf_exp_avg_alpha, get_fairness_coeff(sched_args))
+{
+  dl_queue.reserve(SRSENB_MAX_UES);
+  ul_queue.reserve(SRSENB_MAX_UES);
 }
 
 void sched_time_pf::new_tti(sched_ue_list& ue_db, sf_sched* tti_sched)
 {
-  while (not dl_queue.empty()) {
-    dl_queue.pop();
-  }
-  while (not ul_queue.empty()) {
-    ul_queue.pop();
-  }
+  dl_queue.clear();
+  ul_queue.clear();
   current_tti_rx = tti_point{tti_sched->get_tti_rx()};
   // remove deleted users from history
   for (auto it = ue_history_db.begin(); it != ue_history_db.end();) {
@@ -63,17 +59,17 @@ void sched_time_pf::new_tti(sched_ue_list& ue_db, sf_sched* tti_sched)
   for (auto& u : ue_db) {
     auto it = ue_history_db.find(u.first);
     if (it == ue_history_db.end()) {
-      it = ue_history_db.insert(u.first, ue_ctxt{u.first, fairness_coeff}).value();
+      it = ue_history_db.insert(u.first, ue_ctxt{u.first}).value();
     }
     it->second.new_tti(*cc_cfg, *u.second, tti_sched);
     if (it->second.dl_newtx_h != nullptr or it->second.dl_retx_h != nullptr) {
-      dl_queue.push(&it->second);
+      dl_queue.push_back(&it->second);
     }
     if (it->second.ul_h != nullptr) {
       // Allocate only if UL carrier is enabled
       for (auto& i : u.second->get_ue_cfg().supported_cc_list) {
         if (i.enb_cc_idx == cc_cfg->enb_cc_idx and not i.ul_disabled) {
-          ul_queue.push(&it->second);
+          ul_queue.push_back(&it->second);
           break;
         }
       }
@@ -92,11 +88,21 @@ void sched_time_pf::sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched)
     new_tti(ue_db, tti_sched);
   }
 
-  while (not dl_queue.empty()) {
-    ue_ctxt& ue = *dl_queue.top();
-    ue.save_dl_alloc(try_dl_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
-    dl_queue.pop();
+  // Allocate UEs in decreasing priority order, until there are no RBGs left
+  ue_dl_prio_compare cmp;
+  std::make_heap(dl_queue.begin(), dl_queue.end(), cmp);
+  auto heap_end = dl_queue.end();
+  while (heap_end != dl_queue.begin() and not tti_sched->get_dl_mask().all()) {
+    std::pop_heap(dl_queue.begin(), heap_end, cmp);
+    --heap_end;
+    ue_ctxt& ue = **heap_end;
+    ue.dl_rate.save_alloc(try_dl_alloc(ue, *ue_db[ue.rnti], tti_sched), rate_decay);
   }
+  // The UEs left out got nothing in this TTI
+  for (auto it = dl_queue.begin(); it != heap_end; ++it) {
+    (*it)->dl_rate.save_alloc(0, rate_decay);
+  }
+  dl_queue.clear();
 }
 
 uint32_t sched_time_pf::try_dl_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched)
@@ -131,11 +137,26 @@ void sched_time_pf::sched_ul_users(sched_ue_list& ue_db, sf_sched* tti_sched)
     new_tti(ue_db, tti_sched);
   }
 
-  while (not ul_queue.empty()) {
-    ue_ctxt& ue = *ul_queue.top();
-    ue.save_ul_alloc(try_ul_alloc(ue, *ue_db[ue.rnti], tti_sched), 0.01);
-    ul_queue.pop();
+  // Allocate UEs in decreasing priority order, until there are no PRBs left. Retxs come first, and are tried anyway
+  // because Msg3 retxs may collide with the PUCCH in 6 PRB cells
+  ue_ul_prio_compare cmp;
+  std::make_heap(ul_queue.begin(), ul_queue.end(), cmp);
+  auto heap_end = ul_queue.end();
+  while (heap_end != ul_queue.begin()) {
+    if (tti_sched->get_ul_mask().all() and not ul_queue.front()->ul_h->has_pending_retx()) {
+      break;
+    }
+    std::pop_heap(ul_queue.begin(), heap_end, cmp);
+    --heap_end;
+    ue_ctxt& ue = **heap_end;
+    ue.ul_rate.save_alloc(try_ul_alloc(ue, *ue_db[ue.rnti], tti_sched), rate_decay);
   }
+  // The UEs left out only keep the UL grants that were allocated for UCI
+  for (auto it = ul_queue.begin(); it != heap_end; ++it) {
+    ue_ctxt& ue = **it;
+    ue.ul_rate.save_alloc(tti_sched->is_ul_alloc(ue.rnti) ? ue.ul_h->get_pending_data() : 0, rate_decay);
+  }
+  ul_queue.clear();
 }
 
 uint32_t sched_time_pf::try_ul_alloc(ue_ctxt& ue_ctxt, sched_ue& ue, sf_sched* tti_sched)
@@ -195,9 +216,7 @@ void sched_time_pf::ue_ctxt::new_tti(const sched_cell_params_t& cell, sched_ue&
   dl_newtx_h = get_dl_newtx_harq(ue, tti_sched);
   if (dl_retx_h != nullptr or dl_newtx_h != nullptr) {
     // calculate DL PF priority
-    float r = ue.get_expected_dl_bitrate(cell.enb_cc_idx) / 8;
-    float R = dl_avg_rate();
-    dl_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+    dl_prio = dl_rate.prio(ue.get_expected_dl_bitrate(cell.enb_cc_idx) / 8);
   }
 
   // Calculate UL priority
@@ -206,32 +225,39 @@ void sched_time_pf::ue_ctxt::new_tti(const sched_cell_params_t& cell, sched_ue&
     ul_h = get_ul_newtx_harq(ue, tti_sched);
   }
   if (ul_h != nullptr) {
-    float r = ue.get_expected_ul_bitrate(cell.enb_cc_idx) / 8;
-    float R = ul_avg_rate();
-    ul_prio = (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+    ul_prio = ul_rate.prio(ue.get_expected_ul_bitrate(cell.enb_cc_idx) / 8);
   }
 }
 
-void sched_time_pf::ue_ctxt::save_dl_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
+/*****************************************************************
+ *                       PF average rate
+ *****************************************************************/
+
+pf_avg_rate::decay_table::decay_table(float exp_avg_alpha_, float fairness_coeff_) :
+  exp_avg_alpha(exp_avg_alpha_), fairness_coeff(fairness_coeff_), steady(pow(1 - exp_avg_alpha_, fairness_coeff_))
 {
-  if (dl_nof_samples < 1 / exp_avg_alpha) {
-    // fast start
-    dl_avg_rate_ = dl_avg_rate_ + (alloc_bytes - dl_avg_rate_) / (dl_nof_samples + 1);
-  } else {
-    dl_avg_rate_ = (1 - exp_avg_alpha) * dl_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
+  for (uint32_t n = 0; n < 1 / exp_avg_alpha; ++n) {
+    fast_start.push_back(pow(static_cast<float>(n) / (n + 1), fairness_coeff));
   }
-  dl_nof_samples++;
 }
 
-void sched_time_pf::ue_ctxt::save_ul_alloc(uint32_t alloc_bytes, float exp_avg_alpha)
+void pf_avg_rate::save_alloc(uint32_t alloc_bytes, const decay_table& decay)
 {
-  if (ul_nof_samples < 1 / exp_avg_alpha) {
+  float decay_factor = decay(nof_samples);
+  if (nof_samples < 1 / decay.exp_avg_alpha) {
     // fast start
-    ul_avg_rate_ = ul_avg_rate_ + (alloc_bytes - ul_avg_rate_) / (ul_nof_samples + 1);
+    avg_rate = avg_rate + (alloc_bytes - avg_rate) / (nof_samples + 1);
+  } else {
+    avg_rate = (1 - decay.exp_avg_alpha) * avg_rate + decay.exp_avg_alpha * alloc_bytes;
+  }
+  nof_samples++;
+
+  // Only allocations change the power of R by more than a constant factor
+  if (alloc_bytes == 0) {
+    avg_rate_pow *= decay_factor;
   } else {
-    ul_avg_rate_ = (1 - exp_avg_alpha) * ul_avg_rate_ + (exp_avg_alpha)*alloc_bytes;
+    avg_rate_pow = pow(avg_rate, decay.fairness_coeff);
   }
-  ul_nof_samples++;
 }
 
 bool sched_time_pf::ue_dl_prio_compare::operator()(const sched_time_pf::ue_ctxt* lhs,
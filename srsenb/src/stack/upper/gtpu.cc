@@ -425,6 +425,8 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
     srsran::console("Failed to bind on address %s, port %d: %s\n", gtp_bind_addr.c_str(), int(GTPU_PORT), errbuf);
     return SRSRAN_ERROR;
   }
+  tx_batch.reset(new srsran::udp_tx_batch(logger, args.tx_batch_size));
+  tx_batch->set_fd(fd);
 
   // Assign a handler to rx S1U packets
   auto rx_callback = [this](srsran::unique_byte_buffer_t pdu, const sockaddr_in& from) {
@@ -443,12 +445,21 @@ int gtpu::init(const gtpu_args_t& gtpu_args, pdcp_interface_gtpu* pdcp_)
 
 void gtpu::stop()
 {
+  // Send the PDUs still queued
+  run_tti();
   if (fd > 0) {
     close(fd);
     fd = -1;
   }
 }
 
+void gtpu::run_tti()
+{
+  if (tx_batch != nullptr) {
+    tx_batch->flush();
+  }
+}
+
 // gtpu_interface_pdcp
 void gtpu::write_pdu(uint16_t rnti, uint32_t eps_bearer_id, srsran::unique_byte_buffer_t pdu)
 {
@@ -496,9 +507,7 @@ void gtpu::send_pdu_to_tunnel(const gtpu_tunnel& tx_tun, srsran::unique_byte_buf
     logger.error("Error writing GTP-U Header. Flags 0x%x, Message Type 0x%x", header.flags, header.message_type);
     return;
   }
-  if (sendto(fd, pdu->msg, pdu->N_bytes, MSG_EOR, (struct sockaddr*)&servaddr, sizeof(struct sockaddr_in)) < 0) {
-    perror("sendto");
-  }
+  tx_batch->push(std::move(pdu), servaddr);
 }
 
 srsran::expected<uint32_t> gtpu::add_bearer(uint16_t            rnti,
@@ -845,6 +854,8 @@ bool gtpu::send_end_marker(uint32_t teidin)
   servaddr.sin_addr.s_addr    = htonl(tx_tun->spgw_addr);
   servaddr.sin_port           = htons(GTPU_PORT);
 
+  // The End Marker must reach the peer after the data PDUs of the tunnel
+  tx_batch->flush();
   bool success =
       sendto(fd, pdu->msg, pdu->N_bytes, MSG_EOR, (struct sockaddr*)&servaddr, sizeof(struct sockaddr_in)) > 0;
   if (success) {
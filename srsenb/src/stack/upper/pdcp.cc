@@ -24,41 +24,216 @@
 #include "srsran/interfaces/enb_gtpu_interfaces.h"
 #include "srsran/interfaces/enb_rlc_interfaces.h"
 #include "srsran/interfaces/enb_rrc_interface_pdcp.h"
+#include <future>
 
 namespace srsenb {
 
+/// User plane thread, with its own task scheduler for the timers of the PDCP entities it runs
+class pdcp::up_thread final : public srsran::thread
+{
+public:
+  static const uint32_t task_queue_size = 8192;
+
+  up_thread(uint32_t idx, srslog::basic_logger& logger) :
+    thread("PDCP_UP" + std::to_string(idx)), task_sched(task_queue_size, 128), pdcp(&task_sched, logger)
+  {
+    task_queue = task_sched.make_task_queue(task_queue_size);
+  }
+
+  void start_thread()
+  {
+    running = true;
+    start();
+  }
+
+  void stop_thread()
+  {
+    task_queue.push([this]() {
+      pdcp.stop();
+      running = false;
+    });
+    wait_thread_finish();
+    task_sched.stop();
+  }
+
+  srsran::task_scheduler    task_sched;
+  srsran::task_queue_handle task_queue;
+  srsenb::pdcp              pdcp;
+
+private:
+  void run_thread() override
+  {
+    while (running) {
+      task_sched.run_next_task();
+    }
+  }
+
+  bool running = false;
+};
+
+/// Returns the SRB PDUs and integrity failures of the user plane threads to RRC, in the stack thread
+class pdcp::up_rrc_adapter final : public rrc_interface_pdcp
+{
+public:
+  up_rrc_adapter(rrc_interface_pdcp* rrc_, srsran::task_queue_handle& stack_queue_, srslog::basic_logger& logger_) :
+    rrc(rrc_), stack_queue(stack_queue_), logger(logger_)
+  {}
+
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override
+  {
+    auto task = [this, rnti, lcid](srsran::unique_byte_buffer_t& pdu) { rrc->write_pdu(rnti, lcid, std::move(pdu)); };
+    if (stack_queue.try_push(std::bind(task, std::move(pdu))).is_error()) {
+      logger.warning("Dropping PDU rnti=0x%x, lcid=%d due to full stack queue", rnti, lcid);
+    }
+  }
+  void notify_pdcp_integrity_error(uint16_t rnti, uint32_t lcid) override
+  {
+    if (stack_queue.try_push([this, rnti, lcid]() { rrc->notify_pdcp_integrity_error(rnti, lcid); }).is_error()) {
+      logger.warning("Dropping integrity error of rnti=0x%x, lcid=%d due to full stack queue", rnti, lcid);
+    }
+  }
+
+private:
+  rrc_interface_pdcp*        rrc;
+  srsran::task_queue_handle& stack_queue;
+  srslog::basic_logger&      logger;
+};
+
+/// Returns the DRB PDUs of the user plane threads to GTPU, in the stack thread
+class pdcp::up_gtpu_adapter final : public gtpu_interface_pdcp
+{
+public:
+  up_gtpu_adapter(gtpu_interface_pdcp* gtpu_, srsran::task_queue_handle& stack_queue_, srslog::basic_logger& logger_) :
+    gtpu(gtpu_), stack_queue(stack_queue_), logger(logger_)
+  {}
+
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override
+  {
+    auto task = [this, rnti, lcid](srsran::unique_byte_buffer_t& pdu) { gtpu->write_pdu(rnti, lcid, std::move(pdu)); };
+    if (stack_queue.try_push(std::bind(task, std::move(pdu))).is_error()) {
+      logger.warning("Dropping PDU rnti=0x%x, lcid=%d due to full stack queue", rnti, lcid);
+    }
+  }
+
+private:
+  gtpu_interface_pdcp*       gtpu;
+  srsran::task_queue_handle& stack_queue;
+  srslog::basic_logger&      logger;
+};
+
 pdcp::pdcp(srsran::task_sched_handle task_sched_, srslog::basic_logger& logger_) :
   task_sched(task_sched_), logger(logger_)
 {}
 
-void pdcp::init(rlc_interface_pdcp* rlc_, rrc_interface_pdcp* rrc_, gtpu_interface_pdcp* gtpu_)
+pdcp::~pdcp()
+{
+  stop();
+}
+
+void pdcp::init(rlc_interface_pdcp*  rlc_,
+                rrc_interface_pdcp*  rrc_,
+                gtpu_interface_pdcp* gtpu_,
+                const pdcp_args_t&   args_)
 {
   rlc  = rlc_;
   rrc  = rrc_;
   gtpu = gtpu_;
+
+  if (args_.nof_up_threads > 0) {
+    // The PDCP objects of the user plane threads talk to RLC directly, which is thread-safe, and to RRC and GTPU
+    // through the stack queue
+    stack_queue = task_sched.make_task_queue();
+    up_rrc.reset(new up_rrc_adapter(rrc, stack_queue, logger));
+    up_gtpu.reset(new up_gtpu_adapter(gtpu, stack_queue, logger));
+
+    pdcp_args_t up_args    = args_;
+    up_args.nof_up_threads = 0;
+    for (uint32_t i = 0; i < args_.nof_up_threads; i++) {
+      up_threads.emplace_back(new up_thread(i, logger));
+      up_threads.back()->pdcp.init(rlc, up_rrc.get(), up_gtpu.get(), up_args);
+      up_threads.back()->start_thread();
+    }
+    logger.info("Running PDCP in %d user plane threads", args_.nof_up_threads);
+    return;
+  }
+
+  if (args_.nof_security_workers >= 0) {
+    sec_engine.reset(new srsran::pdcp_security_engine(task_sched, args_.nof_security_workers));
+  }
+}
+
+template <typename F>
+void pdcp::run_in_up_thread(uint16_t rnti, F&& func)
+{
+  up_thread* thread = get_up_thread(rnti);
+  thread->task_queue.push([thread, func]() { func(thread->pdcp); });
+}
+
+template <typename F>
+void pdcp::run_in_up_thread_sync(up_thread* thread, F&& func)
+{
+  std::promise<void> done;
+  std::future<void>  result = done.get_future();
+  thread->task_queue.push([thread, &func, &done]() {
+    func(thread->pdcp);
+    done.set_value();
+  });
+  result.wait();
+}
+
+void pdcp::run_tti()
+{
+  for (std::unique_ptr<up_thread>& thread : up_threads) {
+    up_thread* t = thread.get();
+    t->task_queue.push([t]() {
+      t->task_sched.tic();
+      t->pdcp.run_tti();
+    });
+  }
+  if (sec_engine != nullptr) {
+    sec_engine->run_tti();
+  }
 }
 
 void pdcp::stop()
 {
-  for (std::map<uint32_t, user_interface>::iterator iter = users.begin(); iter != users.end(); ++iter) {
-    clear_user(&iter->second);
+  for (std::unique_ptr<up_thread>& thread : up_threads) {
+    thread->stop_thread();
+  }
+  up_threads.clear();
+
+  for (auto& user : users) {
+    clear_user(&user.second);
   }
   users.clear();
+  if (sec_engine != nullptr) {
+    sec_engine->stop();
+  }
 }
 
 void pdcp::add_user(uint16_t rnti)
 {
-  if (users.count(rnti) == 0) {
-    unique_rnti_ptr<srsran::pdcp> obj = make_rnti_obj<srsran::pdcp>(rnti, task_sched, logger.id().c_str());
-    obj->init(&users[rnti].rlc_itf, &users[rnti].rrc_itf, &users[rnti].gtpu_itf);
-    users[rnti].rlc_itf.rnti  = rnti;
-    users[rnti].gtpu_itf.rnti = rnti;
-    users[rnti].rrc_itf.rnti  = rnti;
-
-    users[rnti].rrc_itf.rrc   = rrc;
-    users[rnti].rlc_itf.rlc   = rlc;
-    users[rnti].gtpu_itf.gtpu = gtpu;
-    users[rnti].pdcp          = std::move(obj);
+  if (not up_threads.empty()) {
+    run_in_up_thread(rnti, [rnti](pdcp& p) { p.add_user(rnti); });
+    return;
+  }
+  if (not users.contains(rnti)) {
+    if (not users.insert(rnti, user_interface{})) {
+      logger.error("Can't add rnti=0x%x. Its slot is taken by another user", rnti);
+      return;
+    }
+    user_interface&               user = users[rnti];
+    unique_rnti_ptr<srsran::pdcp> obj  = make_rnti_obj<srsran::pdcp>(rnti, task_sched, logger.id().c_str());
+    obj->init(&user.rlc_itf, &user.rrc_itf, &user.gtpu_itf);
+    obj->set_security_engine(sec_engine.get());
+    user.rlc_itf.rnti  = rnti;
+    user.gtpu_itf.rnti = rnti;
+    user.rrc_itf.rnti  = rnti;
+
+    user.rrc_itf.rrc   = rrc;
+    user.rlc_itf.rlc   = rlc;
+    user.gtpu_itf.gtpu = gtpu;
+    user.pdcp          = std::move(obj);
   }
 }
 
@@ -71,7 +246,11 @@ void pdcp::clear_user(user_interface* ue)
 
 void pdcp::rem_user(uint16_t rnti)
 {
-  if (users.count(rnti)) {
+  if (not up_threads.empty()) {
+    run_in_up_thread(rnti, [rnti](pdcp& p) { p.rem_user(rnti); });
+    return;
+  }
+  if (users.contains(rnti)) {
     clear_user(&users[rnti]);
     users.erase(rnti);
   }
@@ -79,7 +258,11 @@ void pdcp::rem_user(uint16_t rnti)
 
 void pdcp::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t& cfg)
 {
-  if (users.count(rnti)) {
+  if (not up_threads.empty()) {
+    run_in_up_thread(rnti, [rnti, lcid, cfg](pdcp& p) { p.add_bearer(rnti, lcid, cfg); });
+    return;
+  }
+  if (users.contains(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
       users[rnti].pdcp->add_bearer(lcid, cfg);
     } else {
@@ -90,45 +273,74 @@ void pdcp::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::pdcp_config_t&
 
 void pdcp::del_bearer(uint16_t rnti, uint32_t lcid)
 {
-  if (users.count(rnti)) {
+  if (not up_threads.empty()) {
+    run_in_up_thread(rnti, [rnti, lcid](pdcp& p) { p.del_bearer(rnti, lcid); });
+    return;
+  }
+  if (users.contains(rnti)) {
     users[rnti].pdcp->del_bearer(lcid);
   }
 }
 
 void pdcp::set_enabled(uint16_t rnti, uint32_t lcid, bool enabled)
 {
-  if (users.count(rnti)) {
+  if (not up_threads.empty()) {
+    run_in_up_thread(rnti, [rnti, lcid, enabled](pdcp& p) { p.set_enabled(rnti, lcid, enabled); });
+    return;
+  }
+  if (users.contains(rnti)) {
     users[rnti].pdcp->set_enabled(lcid, enabled);
   }
 }
 
 void pdcp::reset(uint16_t rnti)
 {
-  if (users.count(rnti)) {
+  if (not up_threads.empty()) {
+    run_in_up_thread(rnti, [rnti](pdcp& p) { p.reset(rnti); });
+    return;
+  }
+  if (users.contains(rnti)) {
     users[rnti].pdcp->reset();
   }
 }
 
 void pdcp::config_security(uint16_t rnti, uint32_t lcid, const srsran::as_security_config_t& sec_cfg)
 {
-  if (users.count(rnti)) {
+  if (not up_threads.empty()) {
+    run_in_up_thread(rnti, [rnti, lcid, sec_cfg](pdcp& p) { p.config_security(rnti, lcid, sec_cfg); });
+    return;
+  }
+  if (users.contains(rnti)) {
     users[rnti].pdcp->config_security(lcid, sec_cfg);
   }
 }
 
 void pdcp::enable_integrity(uint16_t rnti, uint32_t lcid)
 {
+  if (not up_threads.empty()) {
+    run_in_up_thread(rnti, [rnti, lcid](pdcp& p) { p.enable_integrity(rnti, lcid); });
+    return;
+  }
   users[rnti].pdcp->enable_integrity(lcid, srsran::DIRECTION_TXRX);
 }
 
 void pdcp::enable_encryption(uint16_t rnti, uint32_t lcid)
 {
+  if (not up_threads.empty()) {
+    run_in_up_thread(rnti, [rnti, lcid](pdcp& p) { p.enable_encryption(rnti, lcid); });
+    return;
+  }
   users[rnti].pdcp->enable_encryption(lcid, srsran::DIRECTION_TXRX);
 }
 
 bool pdcp::get_bearer_state(uint16_t rnti, uint32_t lcid, srsran::pdcp_lte_state_t* state)
 {
-  if (users.count(rnti) == 0) {
+  if (not up_threads.empty()) {
+    bool ret = false;
+    run_in_up_thread_sync(get_up_thread(rnti), [&](pdcp& p) { ret = p.get_bearer_state(rnti, lcid, state); });
+    return ret;
+  }
+  if (not users.contains(rnti)) {
     return false;
   }
   return users[rnti].pdcp->get_bearer_state(lcid, state);
@@ -136,7 +348,12 @@ bool pdcp::get_bearer_state(uint16_t rnti, uint32_t lcid, srsran::pdcp_lte_state
 
 bool pdcp::set_bearer_state(uint16_t rnti, uint32_t lcid, const srsran::pdcp_lte_state_t& state)
 {
-  if (users.count(rnti) == 0) {
+  if (not up_threads.empty()) {
+    bool ret = false;
+    run_in_up_thread_sync(get_up_thread(rnti), [&](pdcp& p) { ret = p.set_bearer_state(rnti, lcid, state); });
+    return ret;
+  }
+  if (not users.contains(rnti)) {
     return false;
   }
   return users[rnti].pdcp->set_bearer_state(lcid, state);
@@ -144,7 +361,11 @@ bool pdcp::set_bearer_state(uint16_t rnti, uint32_t lcid, const srsran::pdcp_lte
 
 void pdcp::reestablish(uint16_t rnti)
 {
-  if (users.count(rnti) == 0) {
+  if (not up_threads.empty()) {
+    run_in_up_thread(rnti, [rnti](pdcp& p) { p.reestablish(rnti); });
+    return;
+  }
+  if (not users.contains(rnti)) {
     return;
   }
   users[rnti].pdcp->reestablish();
@@ -152,7 +373,11 @@ void pdcp::reestablish(uint16_t rnti)
 
 void pdcp::send_status_report(uint16_t rnti)
 {
-  if (users.count(rnti) == 0) {
+  if (not up_threads.empty()) {
+    run_in_up_thread(rnti, [rnti](pdcp& p) { p.send_status_report(rnti); });
+    return;
+  }
+  if (not users.contains(rnti)) {
     return;
   }
   users[rnti].pdcp->send_status_report();
@@ -160,21 +385,41 @@ void pdcp::send_status_report(uint16_t rnti)
 
 void pdcp::notify_delivery(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
-  if (users.count(rnti)) {
+  if (not up_threads.empty()) {
+    run_in_up_thread(rnti, [rnti, lcid, pdcp_sns](pdcp& p) { p.notify_delivery(rnti, lcid, pdcp_sns); });
+    return;
+  }
+  if (users.contains(rnti)) {
     users[rnti].pdcp->notify_delivery(lcid, pdcp_sns);
   }
 }
 
 void pdcp::notify_failure(uint16_t rnti, uint32_t lcid, const srsran::pdcp_sn_vector_t& pdcp_sns)
 {
-  if (users.count(rnti)) {
+  if (not up_threads.empty()) {
+    run_in_up_thread(rnti, [rnti, lcid, pdcp_sns](pdcp& p) { p.notify_failure(rnti, lcid, pdcp_sns); });
+    return;
+  }
+  if (users.contains(rnti)) {
     users[rnti].pdcp->notify_failure(lcid, pdcp_sns);
   }
 }
 
 void pdcp::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu, int pdcp_sn)
 {
-  if (users.count(rnti)) {
+  if (not up_threads.empty()) {
+    up_thread* thread = get_up_thread(rnti);
+    auto       task   = [thread, rnti, lcid, pdcp_sn](srsran::unique_byte_buffer_t& sdu) {
+      thread->pdcp.write_sdu(rnti, lcid, std::move(sdu), pdcp_sn);
+    };
+    if (srsran::is_lte_srb(lcid)) {
+      thread->task_queue.push(std::bind(task, std::move(sdu)));
+    } else if (thread->task_queue.try_push(std::bind(task, std::move(sdu))).is_error()) {
+      logger.warning("Dropping SDU rnti=0x%x, lcid=%d due to full user plane queue", rnti, lcid);
+    }
+    return;
+  }
+  if (users.contains(rnti)) {
     if (rnti != SRSRAN_MRNTI) {
       // TODO: Handle PDCP SN coming from GTPU
       users[rnti].pdcp->write_sdu(lcid, std::move(sdu), pdcp_sn);
@@ -186,14 +431,23 @@ void pdcp::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t
 
 void pdcp::send_status_report(uint16_t rnti, uint32_t lcid)
 {
-  if (users.count(rnti)) {
+  if (not up_threads.empty()) {
+    run_in_up_thread(rnti, [rnti, lcid](pdcp& p) { p.send_status_report(rnti, lcid); });
+    return;
+  }
+  if (users.contains(rnti)) {
     users[rnti].pdcp->send_status_report(lcid);
   }
 }
 
 std::map<uint32_t, srsran::unique_byte_buffer_t> pdcp::get_buffered_pdus(uint16_t rnti, uint32_t lcid)
 {
-  if (users.count(rnti)) {
+  if (not up_threads.empty()) {
+    std::map<uint32_t, srsran::unique_byte_buffer_t> ret;
+    run_in_up_thread_sync(get_up_thread(rnti), [&](pdcp& p) { ret = p.get_buffered_pdus(rnti, lcid); });
+    return ret;
+  }
+  if (users.contains(rnti)) {
     return users[rnti].pdcp->get_buffered_pdus(lcid);
   }
   return {};
@@ -201,7 +455,17 @@ std::map<uint32_t, srsran::unique_byte_buffer_t> pdcp::get_buffered_pdus(uint16_
 
 void pdcp::write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu)
 {
-  if (users.count(rnti)) {
+  if (not up_threads.empty()) {
+    up_thread* thread = get_up_thread(rnti);
+    auto       task   = [thread, rnti, lcid](srsran::unique_byte_buffer_t& sdu) {
+      thread->pdcp.write_pdu(rnti, lcid, std::move(sdu));
+    };
+    if (thread->task_queue.try_push(std::bind(task, std::move(sdu))).is_error()) {
+      logger.warning("Dropping PDU rnti=0x%x, lcid=%d due to full user plane queue", rnti, lcid);
+    }
+    return;
+  }
+  if (users.contains(rnti)) {
     users[rnti].pdcp->write_pdu(lcid, std::move(sdu));
   }
 }
@@ -268,6 +532,23 @@ const char* pdcp::user_interface_rrc::get_rb_name(uint32_t lcid)
 
 void pdcp::get_metrics(pdcp_metrics_t& m, const uint32_t nof_tti)
 {
+  if (not up_threads.empty()) {
+    // Report the users sorted by RNTI, whatever the UP thread that serves them
+    std::map<uint16_t, srsran::pdcp_metrics_t> ue_metrics;
+    for (std::unique_ptr<up_thread>& thread : up_threads) {
+      run_in_up_thread_sync(thread.get(), [&ue_metrics, nof_tti](pdcp& p) {
+        for (auto& user : p.users) {
+          user.second.pdcp->get_metrics(ue_metrics[user.first], nof_tti);
+        }
+      });
+    }
+    m.ues.clear();
+    for (auto& ue : ue_metrics) {
+      m.ues.push_back(ue.second);
+    }
+    return;
+  }
+
   m.ues.resize(users.size());
   size_t count = 0;
   for (auto& user : users) {
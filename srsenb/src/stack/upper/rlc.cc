@@ -27,6 +27,18 @@
 
 namespace srsenb {
 
+rlc::rlc(srslog::basic_logger& logger) : logger(logger)
+{
+  for (auto& u : users) {
+    u.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+rlc::~rlc()
+{
+  stop();
+}
+
 void rlc::init(pdcp_interface_rlc*    pdcp_,
                rrc_interface_rlc*     rrc_,
                mac_interface_rlc*     mac_,
@@ -36,162 +48,166 @@ void rlc::init(pdcp_interface_rlc*    pdcp_,
   rrc    = rrc_;
   mac    = mac_;
   timers = timers_;
-
-  pthread_rwlock_init(&rwlock, nullptr);
 }
 
 void rlc::stop()
 {
-  pthread_rwlock_wrlock(&rwlock);
-  for (auto& user : users) {
-    user.second.rlc->stop();
+  std::lock_guard<std::mutex> lock(users_mutex);
+  for (auto& slot : users) {
+    std::unique_ptr<user_interface> u(slot.exchange(nullptr, std::memory_order_acq_rel));
+    if (u != nullptr) {
+      u->rlc->stop();
+      retired_users.retire(std::move(u));
+    }
   }
-  users.clear();
-  pthread_rwlock_unlock(&rwlock);
-  pthread_rwlock_destroy(&rwlock);
 }
 
 void rlc::get_metrics(rlc_metrics_t& m, const uint32_t nof_tti)
 {
-  m.ues.resize(users.size());
-  size_t count = 0;
-  for (auto& user : users) {
-    user.second.rlc->get_metrics(m.ues[count], nof_tti);
-    count++;
+  {
+    std::lock_guard<std::mutex> lock(users_mutex);
+    retired_users.reclaim();
+  }
+
+  // Same order as the UE database of the MAC
+  srsran::rlc_read_guard guard;
+  m.ues.clear();
+  for (auto& slot : users) {
+    user_interface* u = slot.load(std::memory_order_acquire);
+    if (u != nullptr) {
+      m.ues.emplace_back();
+      u->rlc->get_metrics(m.ues.back(), nof_tti);
+    }
   }
 }
 
 void rlc::add_user(uint16_t rnti)
 {
-  pthread_rwlock_wrlock(&rwlock);
-  if (users.count(rnti) == 0) {
-    auto obj = make_rnti_obj<srsran::rlc>(rnti, logger.id().c_str());
-    obj->init(&users[rnti],
-              &users[rnti],
-              timers,
-              srb_to_lcid(lte_srb::srb0),
-              [rnti, this](uint32_t lcid, uint32_t tx_queue, uint32_t retx_queue) {
-                update_bsr(rnti, lcid, tx_queue, retx_queue);
-              });
-    users[rnti].rnti   = rnti;
-    users[rnti].pdcp   = pdcp;
-    users[rnti].rrc    = rrc;
-    users[rnti].rlc    = std::move(obj);
-    users[rnti].parent = this;
+  std::lock_guard<std::mutex> lock(users_mutex);
+  std::atomic<user_interface*>& slot = users[rnti_slot(rnti)];
+  user_interface*               prev = slot.load(std::memory_order_relaxed);
+  if (prev != nullptr) {
+    if (prev->rnti != rnti) {
+      logger.error("Can't add rnti=0x%x. Its slot is taken by rnti=0x%x", rnti, prev->rnti);
+    }
+    return;
   }
-  pthread_rwlock_unlock(&rwlock);
+
+  std::unique_ptr<user_interface> u(new user_interface);
+  u->rnti   = rnti;
+  u->pdcp   = pdcp;
+  u->rrc    = rrc;
+  u->parent = this;
+  u->rlc    = make_rnti_obj<srsran::rlc>(rnti, logger.id().c_str());
+  u->rlc->init(u.get(),
+               u.get(),
+               timers,
+               srb_to_lcid(lte_srb::srb0),
+               [rnti, this](uint32_t lcid, uint32_t tx_queue, uint32_t retx_queue) {
+                 update_bsr(rnti, lcid, tx_queue, retx_queue);
+               });
+  slot.store(u.release(), std::memory_order_release);
 }
 
 void rlc::rem_user(uint16_t rnti)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->stop();
-  } else {
+  std::lock_guard<std::mutex> lock(users_mutex);
+  std::atomic<user_interface*>& slot = users[rnti_slot(rnti)];
+  user_interface*               u    = slot.load(std::memory_order_relaxed);
+  if (u == nullptr or u->rnti != rnti) {
     logger.error("Removing rnti=0x%x. Already removed", rnti);
+    return;
   }
-  pthread_rwlock_unlock(&rwlock);
-
-  pthread_rwlock_wrlock(&rwlock);
-  users.erase(rnti);
-  pthread_rwlock_unlock(&rwlock);
+  slot.store(nullptr, std::memory_order_release);
+  u->rlc->stop();
+  retired_users.retire(std::unique_ptr<user_interface>(u));
 }
 
 void rlc::clear_buffer(uint16_t rnti)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->empty_queue();
+  srsran::rlc_read_guard guard;
+  user_interface*        u = find_user(rnti);
+  if (u != nullptr) {
+    u->rlc->empty_queue();
     for (int i = 0; i < SRSRAN_N_RADIO_BEARERS; i++) {
-      if (users[rnti].rlc->has_bearer(i)) {
+      if (u->rlc->has_bearer(i)) {
         mac->rlc_buffer_state(rnti, i, 0, 0);
       }
     }
     logger.info("Cleared buffer rnti=0x%x", rnti);
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 void rlc::add_bearer(uint16_t rnti, uint32_t lcid, const srsran::rlc_config_t& cnfg)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->add_bearer(lcid, cnfg);
+  srsran::rlc_read_guard guard;
+  user_interface*        u = find_user(rnti);
+  if (u != nullptr) {
+    u->rlc->add_bearer(lcid, cnfg);
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 void rlc::add_bearer_mrb(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->add_bearer_mrb(lcid);
+  srsran::rlc_read_guard guard;
+  user_interface*        u = find_user(rnti);
+  if (u != nullptr) {
+    u->rlc->add_bearer_mrb(lcid);
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 bool rlc::has_bearer(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  bool result = false;
-  if (users.count(rnti)) {
-    result = users[rnti].rlc->has_bearer(lcid);
-  }
-  pthread_rwlock_unlock(&rwlock);
-  return result;
+  srsran::rlc_read_guard guard;
+  user_interface*        u = find_user(rnti);
+  return u != nullptr and u->rlc->has_bearer(lcid);
 }
 
 void rlc::del_bearer(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->del_bearer(lcid);
+  srsran::rlc_read_guard guard;
+  user_interface*        u = find_user(rnti);
+  if (u != nullptr) {
+    u->rlc->del_bearer(lcid);
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 bool rlc::suspend_bearer(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  bool result = false;
-  if (users.count(rnti)) {
-    users[rnti].rlc->suspend_bearer(lcid);
-    result = true;
+  srsran::rlc_read_guard guard;
+  user_interface*        u = find_user(rnti);
+  if (u == nullptr) {
+    return false;
   }
-  pthread_rwlock_unlock(&rwlock);
-  return result;
+  u->rlc->suspend_bearer(lcid);
+  return true;
 }
 
 bool rlc::is_suspended(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  bool result = false;
-  if (users.count(rnti)) {
-    result = users[rnti].rlc->is_suspended(lcid);
-  }
-  pthread_rwlock_unlock(&rwlock);
-  return result;
+  srsran::rlc_read_guard guard;
+  user_interface*        u = find_user(rnti);
+  return u != nullptr and u->rlc->is_suspended(lcid);
 }
 
 bool rlc::resume_bearer(uint16_t rnti, uint32_t lcid)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  bool result = false;
-  if (users.count(rnti)) {
-    users[rnti].rlc->resume_bearer(lcid);
-    result = true;
+  srsran::rlc_read_guard guard;
+  user_interface*        u = find_user(rnti);
+  if (u == nullptr) {
+    return false;
   }
-  pthread_rwlock_unlock(&rwlock);
-  return result;
+  u->rlc->resume_bearer(lcid);
+  return true;
 }
 
 void rlc::reestablish(uint16_t rnti)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->reestablish();
+  srsran::rlc_read_guard guard;
+  user_interface*        u = find_user(rnti);
+  if (u != nullptr) {
+    u->rlc->reestablish();
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 // In the eNodeB, there is no polling for buffer state from the scheduler.
@@ -204,73 +220,60 @@ void rlc::update_bsr(uint32_t rnti, uint32_t lcid, uint32_t tx_queue, uint32_t p
 
 int rlc::read_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
-  int ret;
-
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    if (rnti != SRSRAN_MRNTI) {
-      ret = users[rnti].rlc->read_pdu(lcid, payload, nof_bytes);
-    } else {
-      ret = users[rnti].rlc->read_pdu_mch(lcid, payload, nof_bytes);
-    }
-  } else {
-    ret = SRSRAN_ERROR;
+  srsran::rlc_read_guard guard;
+  user_interface*        u = find_user(rnti);
+  if (u == nullptr) {
+    return SRSRAN_ERROR;
   }
-  pthread_rwlock_unlock(&rwlock);
-  return ret;
+  if (rnti != SRSRAN_MRNTI) {
+    return u->rlc->read_pdu(lcid, payload, nof_bytes);
+  }
+  return u->rlc->read_pdu_mch(lcid, payload, nof_bytes);
 }
 
 void rlc::write_pdu(uint16_t rnti, uint32_t lcid, uint8_t* payload, uint32_t nof_bytes)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->write_pdu(lcid, payload, nof_bytes);
+  srsran::rlc_read_guard guard;
+  user_interface*        u = find_user(rnti);
+  if (u != nullptr) {
+    u->rlc->write_pdu(lcid, payload, nof_bytes);
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 void rlc::write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
+  srsran::rlc_read_guard guard;
+  user_interface*        u = find_user(rnti);
+  if (u != nullptr) {
     if (rnti != SRSRAN_MRNTI) {
-      users[rnti].rlc->write_sdu(lcid, std::move(sdu));
+      u->rlc->write_sdu(lcid, std::move(sdu));
     } else {
-      users[rnti].rlc->write_sdu_mch(lcid, std::move(sdu));
+      u->rlc->write_sdu_mch(lcid, std::move(sdu));
     }
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 void rlc::discard_sdu(uint16_t rnti, uint32_t lcid, uint32_t discard_sn)
 {
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    users[rnti].rlc->discard_sdu(lcid, discard_sn);
+  srsran::rlc_read_guard guard;
+  user_interface*        u = find_user(rnti);
+  if (u != nullptr) {
+    u->rlc->discard_sdu(lcid, discard_sn);
   }
-  pthread_rwlock_unlock(&rwlock);
 }
 
 bool rlc::rb_is_um(uint16_t rnti, uint32_t lcid)
 {
-  bool ret = false;
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    ret = users[rnti].rlc->rb_is_um(lcid);
-  }
-  pthread_rwlock_unlock(&rwlock);
-  return ret;
+  srsran::rlc_read_guard guard;
+  user_interface*        u = find_user(rnti);
+  return u != nullptr and u->rlc->rb_is_um(lcid);
 }
 
 bool rlc::sdu_queue_is_full(uint16_t rnti, uint32_t lcid)
 {
-  bool ret = false;
-  pthread_rwlock_rdlock(&rwlock);
-  if (users.count(rnti)) {
-    ret = users[rnti].rlc->sdu_queue_is_full(lcid);
-  }
-  pthread_rwlock_unlock(&rwlock);
-  return ret;
+  srsran::rlc_read_guard guard;
+  user_interface*        u = find_user(rnti);
+  return u != nullptr and u->rlc->sdu_queue_is_full(lcid);
 }
 
 void rlc::user_interface::max_retx_attempted()
@@ -109,6 +109,26 @@ public:
     metrics[1].phy[0].ul.mcs        = 28.0;
     metrics[1].phy[0].ul.pucch_sinr = 22.2;
     metrics[1].phy[0].ul.pusch_sinr = 22.2;
+    metrics[1].stack.mac.latency.sched.nof_samples = 1000;
+    metrics[1].stack.mac.latency.sched.p50_us      = 45.2;
+    metrics[1].stack.mac.latency.sched.p99_us      = 180.5;
+    metrics[1].stack.mac.latency.sched.p999_us     = 410.0;
+    metrics[1].stack.mac.latency.sched.max_us      = 1250.7;
+    metrics[1].phy_latency.dl_encode.nof_samples   = 1000;
+    metrics[1].phy_latency.dl_encode.p50_us        = 120.3;
+    metrics[1].phy_latency.dl_encode.p99_us        = 301.9;
+    metrics[1].phy_latency.dl_encode.p999_us       = 455.1;
+    metrics[1].phy_latency.dl_encode.max_us        = 612.0;
+    metrics[1].phy_latency.nr_dl_encode.nof_samples = 2000;
+    metrics[1].phy_latency.nr_dl_encode.p50_us      = 60.7;
+    metrics[1].phy_latency.nr_dl_encode.p99_us      = 150.2;
+    metrics[1].phy_latency.nr_dl_encode.p999_us     = 230.4;
+    metrics[1].phy_latency.nr_dl_encode.max_us      = 305.9;
+    metrics[1].nr_stack.mac.latency.sched.nof_samples = 2000;
+    metrics[1].nr_stack.mac.latency.sched.p50_us      = 30.1;
+    metrics[1].nr_stack.mac.latency.sched.p99_us      = 95.4;
+    metrics[1].nr_stack.mac.latency.sched.p999_us     = 160.2;
+    metrics[1].nr_stack.mac.latency.sched.max_us      = 240.8;
 
     // third entry
     metrics[2].rf.rf_o = 10;
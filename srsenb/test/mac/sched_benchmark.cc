@@ -21,9 +21,12 @@
 
 #include "sched_test_common.h"
 #include "srsenb/hdr/stack/mac/sched.h"
+#include "srsenb/hdr/stack/mac/schedulers/sched_time_pf.h"
 #include "srsran/adt/accumulators.h"
 #include "srsran/common/common_lte.h"
 #include <chrono>
+#include <cmath>
+#include <queue>
 
 namespace srsenb {
 
@@ -376,7 +379,7 @@ int run_benchmark()
   run_param_list.nof_ttis     = 1000000;
   run_param_list.nof_prbs     = {100};
   run_param_list.cqi          = {15};
-  run_param_list.nof_ues      = {5};
+  run_param_list.nof_ues      = {5, SRSENB_MAX_UES};
   run_param_list.sched_policy = {"time_pf"};
 
   std::vector<run_data> run_results;
@@ -394,6 +397,114 @@ int run_benchmark()
   return SRSRAN_SUCCESS;
 }
 
+/*
+ * PF metric and UE ordering, at UE counts beyond the SRSENB_MAX_UES that a scheduler instance can hold. Compares the
+ * per-TTI cost of pow() for every UE and a priority queue drained of all UEs, with the cached R^fairness_coeff of
+ * pf_avg_rate and a heap that is only popped for the UEs that get an allocation.
+ */
+struct pf_bench_ue {
+  float       r          = 0;
+  float       prio       = 0;
+  uint32_t    nof_allocs = 0;
+  pf_avg_rate rate;
+  // Average rate as updated by the PF scheduler before pf_avg_rate
+  float    legacy_avg_rate = 0;
+  uint32_t legacy_samples  = 0;
+};
+
+static bool pf_bench_ue_compare(const pf_bench_ue* lhs, const pf_bench_ue* rhs)
+{
+  return lhs->prio < rhs->prio;
+}
+
+static std::chrono::nanoseconds
+run_pf_legacy(std::vector<pf_bench_ue>& ues, uint32_t nof_ttis, uint32_t allocs_per_tti, float fairness_coeff)
+{
+  const float alpha = 0.01;
+  auto        tp    = std::chrono::steady_clock::now();
+  for (uint32_t tti = 0; tti < nof_ttis; ++tti) {
+    std::priority_queue<pf_bench_ue*, std::vector<pf_bench_ue*>, decltype(&pf_bench_ue_compare)> queue(
+        &pf_bench_ue_compare);
+    for (pf_bench_ue& u : ues) {
+      float R = u.legacy_samples == 0 ? 0 : u.legacy_avg_rate;
+      u.prio  = (R != 0) ? u.r / pow(R, fairness_coeff) : (u.r == 0 ? 0 : std::numeric_limits<float>::max());
+      queue.push(&u);
+    }
+    for (uint32_t count = 0; not queue.empty(); ++count) {
+      pf_bench_ue& u           = *queue.top();
+      uint32_t     alloc_bytes = count < allocs_per_tti ? u.r : 0;
+      u.nof_allocs += alloc_bytes > 0 ? 1 : 0;
+      if (u.legacy_samples < 1 / alpha) {
+        u.legacy_avg_rate = u.legacy_avg_rate + (alloc_bytes - u.legacy_avg_rate) / (u.legacy_samples + 1);
+      } else {
+        u.legacy_avg_rate = (1 - alpha) * u.legacy_avg_rate + alpha * alloc_bytes;
+      }
+      u.legacy_samples++;
+      queue.pop();
+    }
+  }
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+}
+
+static std::chrono::nanoseconds
+run_pf_incremental(std::vector<pf_bench_ue>& ues, uint32_t nof_ttis, uint32_t allocs_per_tti, float fairness_coeff)
+{
+  pf_avg_rate::decay_table  decay(0.01, fairness_coeff);
+  std::vector<pf_bench_ue*> queue;
+  queue.reserve(ues.size());
+  auto tp = std::chrono::steady_clock::now();
+  for (uint32_t tti = 0; tti < nof_ttis; ++tti) {
+    for (pf_bench_ue& u : ues) {
+      u.prio = u.rate.prio(u.r);
+      queue.push_back(&u);
+    }
+    std::make_heap(queue.begin(), queue.end(), pf_bench_ue_compare);
+    auto heap_end = queue.end();
+    for (uint32_t count = 0; count < allocs_per_tti and heap_end != queue.begin(); ++count) {
+      std::pop_heap(queue.begin(), heap_end, pf_bench_ue_compare);
+      --heap_end;
+      (*heap_end)->rate.save_alloc((*heap_end)->r, decay);
+      (*heap_end)->nof_allocs++;
+    }
+    for (auto it = queue.begin(); it != heap_end; ++it) {
+      (*it)->rate.save_alloc(0, decay);
+    }
+    queue.clear();
+  }
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+}
+
+int run_pf_benchmark(uint32_t nof_ttis)
+{
+  const uint32_t allocs_per_tti = 8;
+  const float    fairness_coeff = 1;
+
+  fmt::print("\n====== PF metric and UE ordering, {} allocations per TTI ======\n\n", allocs_per_tti);
+  fmt::print("  Nue | pow + priority queue [usec/TTI] | cached pow + heap [usec/TTI]\n");
+  fmt::print("-----------------------------------------------------------------------\n");
+  for (uint32_t nof_ues : {64u, 512u, 1024u}) {
+    // UEs with different channel qualities
+    std::vector<pf_bench_ue> legacy_ues(nof_ues), ues(nof_ues);
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      legacy_ues[i].r = ues[i].r = 100 + (i * 37) % 1000;
+    }
+    std::chrono::nanoseconds legacy_dur = run_pf_legacy(legacy_ues, nof_ttis, allocs_per_tti, fairness_coeff);
+    std::chrono::nanoseconds dur        = run_pf_incremental(ues, nof_ttis, allocs_per_tti, fairness_coeff);
+    fmt::print("{:>5d}{:>34.2f}{:>31.2f}\n",
+               nof_ues,
+               legacy_dur.count() / 1000.0 / nof_ttis,
+               dur.count() / 1000.0 / nof_ttis);
+
+    // Both serve every UE, and the PF averages converge to the same values
+    for (uint32_t i = 0; i < nof_ues; ++i) {
+      TESTASSERT(legacy_ues[i].nof_allocs > 0);
+      TESTASSERT(ues[i].nof_allocs > 0);
+    }
+    TESTASSERT(std::abs((float)legacy_ues[0].nof_allocs - ues[0].nof_allocs) <= 0.1 * legacy_ues[0].nof_allocs + 2);
+  }
+  return SRSRAN_SUCCESS;
+}
+
 } // namespace srsenb
 
 int main(int argc, char* argv[])
@@ -422,7 +533,9 @@ int main(int argc, char* argv[])
 
   if (argc == 1 or strcmp(argv[1], "test") == 0) {
     TESTASSERT(srsenb::run_rate_test() == SRSRAN_SUCCESS);
+    TESTASSERT(srsenb::run_pf_benchmark(2000) == SRSRAN_SUCCESS);
   } else if (strcmp(argv[1], "benchmark") == 0) {
+    TESTASSERT(srsenb::run_pf_benchmark(100000) == SRSRAN_SUCCESS);
     TESTASSERT(srsenb::run_benchmark() == SRSRAN_SUCCESS);
   } else {
     TESTASSERT(srsenb::run_all() == SRSRAN_SUCCESS);
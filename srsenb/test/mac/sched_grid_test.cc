@@ -251,6 +251,126 @@ int test_6prbs()
   return SRSRAN_SUCCESS;
 }
 
+int test_pdcch_many_ues()
+{
+  const uint32_t nof_ues  = 16;
+  const uint32_t aggr_idx = 1;
+
+  std::vector<sched_cell_params_t> cell_params(1);
+  sched_interface::ue_cfg_t        ue_cfg   = generate_default_ue_cfg();
+  sched_interface::cell_cfg_t      cell_cfg = generate_default_cell_cfg(50);
+  sched_interface::sched_args_t    sched_args{};
+  TESTASSERT(cell_params[0].set_cfg(0, cell_cfg, sched_args));
+
+  std::vector<std::unique_ptr<sched_ue> > ues;
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    ues.emplace_back(new sched_ue(0x46 + i, cell_params, ue_cfg));
+  }
+  sf_cch_allocator                 pdcch;
+  sf_cch_allocator::alloc_result_t dci_result;
+  pdcch_mask_t                     result_pdcch_mask;
+  pdcch.init(cell_params[PCell_IDX]);
+
+  // TEST: UEs are allocated until the PDCCH is full, without CCE collisions. Failed allocations leave the
+  // previous ones untouched
+  tti_point tti_rx{std::uniform_int_distribution<uint32_t>(0, 10239)(get_rand_gen())};
+  pdcch.new_tti(tti_rx);
+  std::vector<uint32_t> allocated_ues, first_ncces;
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    pdcch.get_allocs(&dci_result, &result_pdcch_mask);
+    pdcch_mask_t prev_mask = result_pdcch_mask;
+    uint32_t     prev_cfi  = pdcch.get_cfi();
+    if (pdcch.alloc_dci(alloc_type_t::DL_DATA, aggr_idx, ues[i].get(), true)) {
+      allocated_ues.push_back(i);
+    } else {
+      pdcch.get_allocs(&dci_result, &result_pdcch_mask);
+      TESTASSERT(result_pdcch_mask == prev_mask);
+      TESTASSERT(pdcch.get_cfi() == prev_cfi);
+    }
+  }
+  TESTASSERT(pdcch.nof_allocs() == allocated_ues.size() and not allocated_ues.empty());
+  pdcch.get_allocs(&dci_result, &result_pdcch_mask);
+  pdcch_mask_t sum_mask(result_pdcch_mask.size());
+  for (uint32_t i = 0; i < dci_result.size(); ++i) {
+    TESTASSERT(dci_result[i]->rnti == ues[allocated_ues[i]]->get_rnti());
+    TESTASSERT((sum_mask & dci_result[i]->current_mask).none());
+    sum_mask |= dci_result[i]->current_mask;
+    first_ncces.push_back(dci_result[i]->dci_pos.ncce);
+  }
+  TESTASSERT(sum_mask == result_pdcch_mask);
+  TESTASSERT(result_pdcch_mask.count() == allocated_ues.size() * (1U << aggr_idx));
+
+  // TEST: In the same subframe of the next frame, the same UEs get the DCI positions of the previous solution
+  uint32_t cfi = pdcch.get_cfi();
+  pdcch.new_tti(tti_rx + SRSRAN_NOF_SF_X_FRAME);
+  for (uint32_t ue_idx : allocated_ues) {
+    TESTASSERT(pdcch.alloc_dci(alloc_type_t::DL_DATA, aggr_idx, ues[ue_idx].get(), true));
+  }
+  TESTASSERT(pdcch.get_cfi() == cfi);
+  pdcch.get_allocs(&dci_result, &result_pdcch_mask);
+  for (uint32_t i = 0; i < dci_result.size(); ++i) {
+    TESTASSERT(dci_result[i]->dci_pos.ncce == first_ncces[i]);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int test_pdcch_dfs_budget()
+{
+  const uint32_t nof_ues  = 16;
+  const uint32_t aggr_idx = 0;
+
+  std::vector<sched_cell_params_t> cell_params(1);
+  sched_interface::ue_cfg_t        ue_cfg   = generate_default_ue_cfg();
+  sched_interface::cell_cfg_t      cell_cfg = generate_default_cell_cfg(6);
+  sched_interface::sched_args_t    sched_args{};
+  TESTASSERT(cell_params[0].set_cfg(0, cell_cfg, sched_args));
+
+  std::vector<std::unique_ptr<sched_ue> > ues;
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    ues.emplace_back(new sched_ue(0x46 + i, cell_params, ue_cfg));
+  }
+  sf_cch_allocator                 pdcch;
+  sf_cch_allocator::alloc_result_t dci_result;
+  pdcch_mask_t                     result_pdcch_mask;
+  pdcch.init(cell_params[PCell_IDX]);
+
+  // TEST: Once the PDCCH is nearly full, the search for a new DCI visits more than MAX_DFS_NODES nodes at the highest
+  // CFI. The DCI is then rejected, even if an exhaustive search could still make room for it, and the DCIs already
+  // allocated keep their positions
+  pdcch.new_tti(tti_point{0});
+  uint32_t nof_budget_rejections = 0;
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    pdcch.get_allocs(&dci_result, &result_pdcch_mask);
+    std::vector<std::pair<uint16_t, uint32_t> > prev_dcis;
+    for (const sf_cch_allocator::tree_node* node : dci_result) {
+      prev_dcis.emplace_back(node->rnti, node->dci_pos.ncce);
+    }
+    pdcch_mask_t prev_mask   = result_pdcch_mask;
+    uint32_t     prev_cfi    = pdcch.get_cfi();
+    uint32_t     prev_hits   = pdcch.nof_dfs_budget_hits();
+    size_t       prev_allocs = pdcch.nof_allocs();
+    if (pdcch.alloc_dci(alloc_type_t::DL_DATA, aggr_idx, ues[i].get(), true)) {
+      continue;
+    }
+    if (pdcch.nof_dfs_budget_hits() > prev_hits) {
+      nof_budget_rejections++;
+    }
+    TESTASSERT(pdcch.nof_allocs() == prev_allocs);
+    TESTASSERT(pdcch.get_cfi() == prev_cfi);
+    pdcch.get_allocs(&dci_result, &result_pdcch_mask);
+    TESTASSERT(result_pdcch_mask == prev_mask);
+    TESTASSERT(dci_result.size() == prev_dcis.size());
+    for (uint32_t j = 0; j < dci_result.size(); ++j) {
+      TESTASSERT(dci_result[j]->rnti == prev_dcis[j].first);
+      TESTASSERT(dci_result[j]->dci_pos.ncce == prev_dcis[j].second);
+    }
+  }
+  TESTASSERT(nof_budget_rejections > 0);
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   srsenb::set_randseed(seed);
@@ -265,6 +385,8 @@ int main()
   TESTASSERT(test_pdcch_one_ue() == SRSRAN_SUCCESS);
   TESTASSERT(test_pdcch_ue_and_sibs() == SRSRAN_SUCCESS);
   TESTASSERT(test_6prbs() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pdcch_many_ues() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pdcch_dfs_budget() == SRSRAN_SUCCESS);
 
   srslog::flush();
 
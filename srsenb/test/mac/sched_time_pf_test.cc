@@ -0,0 +1,105 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/mac/schedulers/sched_time_pf.h"
+#include "srsran/common/test_common.h"
+#include <cmath>
+#include <random>
+
+namespace srsenb {
+
+/// PF metric as computed before the decay table, with pow() in every TTI
+class ref_pf_avg_rate
+{
+public:
+  ref_pf_avg_rate(float exp_avg_alpha_, float fairness_coeff_) :
+    exp_avg_alpha(exp_avg_alpha_), fairness_coeff(fairness_coeff_)
+  {}
+
+  void save_alloc(uint32_t alloc_bytes)
+  {
+    if (nof_samples < 1 / exp_avg_alpha) {
+      avg_rate = avg_rate + (alloc_bytes - avg_rate) / (nof_samples + 1);
+    } else {
+      avg_rate = (1 - exp_avg_alpha) * avg_rate + exp_avg_alpha * alloc_bytes;
+    }
+    nof_samples++;
+  }
+
+  float prio(float r) const
+  {
+    float R = nof_samples == 0 ? 0 : avg_rate;
+    return (R != 0) ? r / pow(R, fairness_coeff) : (r == 0 ? 0 : std::numeric_limits<float>::max());
+  }
+
+private:
+  float    exp_avg_alpha;
+  float    fairness_coeff;
+  float    avg_rate    = 0;
+  uint32_t nof_samples = 0;
+};
+
+/// Compares the PF metric of pf_avg_rate against the reference computation, for a UE that gets an allocation in a
+/// fraction alloc_ratio of the TTIs
+void test_pf_metric_vs_ref(float fairness_coeff, float alloc_ratio)
+{
+  const float    exp_avg_alpha = 0.01;
+  const uint32_t nof_ttis      = 3000;
+  const float    r             = 1000;
+
+  std::mt19937                          rand_gen(1234);
+  std::uniform_real_distribution<float> unif(0, 1);
+  std::uniform_int_distribution<int>    bytes_dist(1, 5000);
+
+  pf_avg_rate::decay_table decay(exp_avg_alpha, fairness_coeff);
+  pf_avg_rate              rate;
+  ref_pf_avg_rate          ref_rate(exp_avg_alpha, fairness_coeff);
+  TESTASSERT(rate.prio(r) == ref_rate.prio(r));
+
+  for (uint32_t tti = 0; tti < nof_ttis; ++tti) {
+    // A long stretch without allocations after the fast start period, where R^c only decays through the table
+    bool     idle        = tti >= 200 and tti < 800;
+    uint32_t alloc_bytes = (not idle and unif(rand_gen) < alloc_ratio) ? bytes_dist(rand_gen) : 0;
+    rate.save_alloc(alloc_bytes, decay);
+    ref_rate.save_alloc(alloc_bytes);
+
+    float prio = rate.prio(r), ref_prio = ref_rate.prio(r);
+    if (ref_prio == 0 or ref_prio == std::numeric_limits<float>::max()) {
+      TESTASSERT(prio == ref_prio);
+    } else {
+      // The error of the table grows with the number of TTIs since the last allocation
+      TESTASSERT(std::abs(prio - ref_prio) <= 1e-3 * ref_prio);
+    }
+  }
+}
+
+} // namespace srsenb
+
+int main()
+{
+  for (float fairness_coeff : {0.5f, 1.0f, 1.5f, 2.0f, 4.0f}) {
+    for (float alloc_ratio : {0.01f, 0.1f, 0.5f, 1.0f}) {
+      srsenb::test_pf_metric_vs_ref(fairness_coeff, alloc_ratio);
+    }
+  }
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -1175,6 +1175,7 @@ public:
     uint32_t              period_pcell_rotate = 0;
     srsran_tm_t           tm                  = SRSRAN_TM1;
     bool                  extended_cp         = false;
+    bool                  tx_pipeline         = false;
     args_t()
     {
       cell.nof_prb   = 6;
@@ -1243,6 +1244,7 @@ public:
     // PHY arguments
     phy_args.log.phy_level   = args.log_level;
     phy_args.nof_phy_threads = 1; ///< Set number of phy threads to 1 for avoiding concurrency issues
+    phy_args.tx_pipeline     = args.tx_pipeline;
 
     // Create cell configuration
     phy_cfg.phy_cell_cfg.resize(args.nof_enb_cells);
@@ -1462,6 +1464,7 @@ int parse_args(int argc, char** argv, phy_test_bench::args_t& args)
       ("cell.cp",        bpo::value<bool>(&args.extended_cp)->default_value(false),                      "use extended CP")
       ("tm", bpo::value<uint32_t>(&args.tm_u32)->default_value(args.tm_u32),                             "Transmission mode")
       ("rotation", bpo::value<uint32_t>(&args.period_pcell_rotate),                      "Serving cells rotation period in ms, set to zero to disable")
+      ("tx_pipeline", bpo::value<bool>(&args.tx_pipeline)->default_value(false),         "Modulate the OFDM symbols in a dedicated thread")
       ;
   options.add(common).add_options()("help", "Show this message");
   // clang-format on
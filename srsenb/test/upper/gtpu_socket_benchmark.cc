@@ -0,0 +1,172 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/network_utils.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <getopt.h>
+#include <poll.h>
+#include <thread>
+#include <unistd.h>
+
+/*
+ * Measures the packets/s that go through a pair of UDP sockets on the loopback interface, when each GTP-U PDU is sent
+ * and received with its own sendto()/recvfrom() call and when the PDUs are sent and received in batches with
+ * sendmmsg()/recvmmsg().
+ */
+
+static uint32_t pdu_len    = 1400; ///< GTP-U PDU size in bytes
+static uint32_t nof_pdus   = 200000;
+static uint32_t batch_size = srsran::udp_tx_batch::max_batch_size;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [snb]\n", prog);
+  printf("\t-s PDU size in bytes [Default %d]\n", pdu_len);
+  printf("\t-n Number of PDUs per measurement [Default %d]\n", nof_pdus);
+  printf("\t-b PDUs per sendmmsg()/recvmmsg() call [Default %d]\n", batch_size);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "snb")) != -1) {
+    switch (opt) {
+      case 's':
+        pdu_len = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_pdus = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'b':
+        batch_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static int open_udp_socket(sockaddr_in* bound_addr)
+{
+  using namespace srsran::net_utils;
+  int fd = open_socket(addr_family::ipv4, socket_type::datagram, protocol_type::UDP);
+  if (fd < 0) {
+    return -1;
+  }
+  int bufsize = 8 * 1024 * 1024;
+  setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufsize, sizeof(bufsize));
+  setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &bufsize, sizeof(bufsize));
+  if (not bind_addr(fd, "127.0.0.1", 0)) {
+    close(fd);
+    return -1;
+  }
+  socklen_t len = sizeof(*bound_addr);
+  getsockname(fd, (sockaddr*)bound_addr, &len);
+  return fd;
+}
+
+/// Receives until no PDU arrives for 100 msec. Returns the number of PDUs received
+static uint32_t receive_pdus(int fd, bool batched, std::chrono::steady_clock::time_point& last_rx)
+{
+  srsran::udp_rx_batch         rx_batch(batch_size);
+  srsran::unique_byte_buffer_t pdu   = srsran::make_byte_buffer();
+  uint32_t                     count = 0;
+  pollfd                       pfd   = {fd, POLLIN, 0};
+  while (count < nof_pdus and poll(&pfd, 1, 100) > 0) {
+    if (batched) {
+      int n = rx_batch.recv(fd);
+      if (n > 0) {
+        count += n;
+      }
+    } else {
+      sockaddr_in from    = {};
+      socklen_t   fromlen = sizeof(from);
+      if (recvfrom(fd, pdu->msg, pdu->get_tailroom(), 0, (sockaddr*)&from, &fromlen) > 0) {
+        count++;
+      }
+    }
+    last_rx = std::chrono::steady_clock::now();
+  }
+  return count;
+}
+
+static int run_benchmark(const char* name, bool batched)
+{
+  sockaddr_in tx_addr = {}, rx_addr = {};
+  int         tx_fd = open_udp_socket(&tx_addr);
+  int         rx_fd = open_udp_socket(&rx_addr);
+  TESTASSERT(tx_fd >= 0 and rx_fd >= 0);
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now(), last_rx = start;
+  uint32_t                              nof_rx = 0;
+  std::thread rx_thread([&]() { nof_rx = receive_pdus(rx_fd, batched, last_rx); });
+
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("GTPU", false);
+  srsran::udp_tx_batch  tx_batch(logger, batched ? batch_size : 1);
+  tx_batch.set_fd(tx_fd);
+
+  start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_pdus; i++) {
+    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+    TESTASSERT(pdu != nullptr);
+    pdu->N_bytes = pdu_len;
+    memset(pdu->msg, i & 0xff, pdu_len);
+    if (batched) {
+      tx_batch.push(std::move(pdu), rx_addr);
+    } else {
+      TESTASSERT(sendto(tx_fd, pdu->msg, pdu->N_bytes, 0, (sockaddr*)&rx_addr, sizeof(rx_addr)) > 0);
+    }
+  }
+  tx_batch.flush();
+  std::chrono::steady_clock::time_point tx_end = std::chrono::steady_clock::now();
+
+  rx_thread.join();
+  close(tx_fd);
+  close(rx_fd);
+
+  double tx_usec = std::chrono::duration_cast<std::chrono::microseconds>(tx_end - start).count();
+  double rx_usec = std::chrono::duration_cast<std::chrono::microseconds>(last_rx - start).count();
+  printf("%-20s TX %10.0f pkts/s, RX %10.0f pkts/s, received %d/%d PDUs\n",
+         name,
+         nof_pdus / tx_usec * 1e6,
+         nof_rx / rx_usec * 1e6,
+         nof_rx,
+         nof_pdus);
+
+  // Loopback can drop datagrams when the receiver falls behind, but some must arrive
+  TESTASSERT(nof_rx > 0);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  srslog::fetch_basic_logger("COMN", false).set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  TESTASSERT(run_benchmark("sendto/recvfrom", false) == SRSRAN_SUCCESS);
+  TESTASSERT(run_benchmark("sendmmsg/recvmmsg", true) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
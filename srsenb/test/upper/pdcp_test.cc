@@ -0,0 +1,257 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsenb/hdr/stack/upper/pdcp.h"
+#include "srsran/common/test_common.h"
+#include "srsran/interfaces/enb_gtpu_interfaces.h"
+#include "srsran/interfaces/enb_rlc_interfaces.h"
+#include "srsran/interfaces/enb_rrc_interface_pdcp.h"
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace srsenb {
+
+using pdu_list_t = std::map<uint16_t, std::vector<srsran::unique_byte_buffer_t> >;
+
+// Called from the user plane threads
+class rlc_tester : public rlc_interface_pdcp
+{
+public:
+  void write_sdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t sdu) override
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    sdus[rnti].push_back(std::move(sdu));
+    nof_sdus++;
+  }
+  void discard_sdu(uint16_t rnti, uint32_t lcid, uint32_t sn) override {}
+  bool rb_is_um(uint16_t rnti, uint32_t lcid) override { return true; }
+  bool sdu_queue_is_full(uint16_t rnti, uint32_t lcid) override { return false; }
+  bool is_suspended(uint16_t rnti, uint32_t lcid) override { return false; }
+
+  uint32_t get_nof_sdus()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return nof_sdus;
+  }
+
+  std::mutex mutex;
+  pdu_list_t sdus;
+  uint32_t   nof_sdus = 0;
+};
+
+// Called from the stack thread
+class rrc_tester : public rrc_interface_pdcp
+{
+public:
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override { nof_pdus++; }
+  void notify_pdcp_integrity_error(uint16_t rnti, uint32_t lcid) override {}
+
+  uint32_t nof_pdus = 0;
+};
+
+class gtpu_tester : public gtpu_interface_pdcp
+{
+public:
+  void write_pdu(uint16_t rnti, uint32_t lcid, srsran::unique_byte_buffer_t pdu) override
+  {
+    pdus[rnti].push_back(std::move(pdu));
+    nof_pdus++;
+  }
+
+  pdu_list_t pdus;
+  uint32_t   nof_pdus = 0;
+};
+
+struct test_result_t {
+  pdu_list_t               dl_pdus;
+  pdu_list_t               ul_pdus;
+  pdcp_metrics_t           metrics;
+  srsran::pdcp_lte_state_t state = {};
+};
+
+const uint16_t first_rnti  = 0x46;
+const uint32_t nof_users   = 10;
+const uint32_t drb_lcid    = 3;
+const uint32_t nof_dl_sdus = 200;
+
+srsran::unique_byte_buffer_t make_sdu(uint16_t rnti, uint32_t idx)
+{
+  srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+  sdu->N_bytes                     = 20 + (rnti + idx) % 1000;
+  for (uint32_t i = 0; i < sdu->N_bytes; i++) {
+    sdu->msg[i] = (rnti + idx * 3 + i) & 0xff;
+  }
+  return sdu;
+}
+
+/*
+ * Runs the same traffic through PDCP with a given number of user plane threads
+ */
+int run_traffic(uint32_t nof_up_threads, test_result_t& result)
+{
+  srslog::basic_logger&  logger = srslog::fetch_basic_logger("PDCP", false);
+  srsran::task_scheduler task_sched;
+  rlc_tester             rlc;
+  rrc_tester             rrc;
+  gtpu_tester            gtpu;
+
+  pdcp_args_t args;
+  args.nof_up_threads = nof_up_threads;
+  pdcp pdcp_obj(&task_sched, logger);
+  pdcp_obj.init(&rlc, &rrc, &gtpu, args);
+
+  srsran::pdcp_config_t cfg = {1,
+                               srsran::PDCP_RB_IS_DRB,
+                               srsran::SECURITY_DIRECTION_DOWNLINK,
+                               srsran::SECURITY_DIRECTION_UPLINK,
+                               srsran::PDCP_SN_LEN_12,
+                               srsran::pdcp_t_reordering_t::ms500,
+                               srsran::pdcp_discard_timer_t::infinity,
+                               false,
+                               srsran::srsran_rat_t::lte};
+
+  for (uint16_t rnti = first_rnti; rnti < first_rnti + nof_users; rnti++) {
+    srsran::as_security_config_t sec_cfg = {};
+    for (uint32_t i = 0; i < sec_cfg.k_up_enc.size(); i++) {
+      sec_cfg.k_up_enc[i] = (rnti * 7 + i) & 0xff;
+    }
+    sec_cfg.cipher_algo = srsran::CIPHERING_ALGORITHM_ID_128_EEA2;
+    sec_cfg.integ_algo  = srsran::INTEGRITY_ALGORITHM_ID_EIA0;
+
+    pdcp_obj.add_user(rnti);
+    pdcp_obj.add_bearer(rnti, drb_lcid, cfg);
+    pdcp_obj.config_security(rnti, drb_lcid, sec_cfg);
+    pdcp_obj.enable_encryption(rnti, drb_lcid);
+  }
+
+  // DL SDUs from GTPU and UL PDUs from RLC
+  for (uint32_t i = 0; i < nof_dl_sdus; i++) {
+    uint16_t rnti = first_rnti + i % nof_users;
+    pdcp_obj.write_sdu(rnti, drb_lcid, make_sdu(rnti, i));
+  }
+  for (uint16_t rnti = first_rnti; rnti < first_rnti + nof_users; rnti++) {
+    srsran::unique_byte_buffer_t pdu = make_sdu(rnti, 0);
+    pdu->msg[0]                      = 0x80; // D/C bit set, SN=0
+    pdu->msg[1]                      = 0;
+    pdcp_obj.write_pdu(rnti, drb_lcid, std::move(pdu));
+  }
+
+  // Wait for the user plane threads and return the UL PDUs to GTPU
+  for (uint32_t i = 0; i < 1000 && (rlc.get_nof_sdus() < nof_dl_sdus || gtpu.nof_pdus < nof_users); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    task_sched.run_pending_tasks();
+    pdcp_obj.run_tti();
+  }
+  TESTASSERT_EQ(nof_dl_sdus, rlc.get_nof_sdus());
+  TESTASSERT_EQ(nof_users, gtpu.nof_pdus);
+
+  TESTASSERT(pdcp_obj.get_bearer_state(first_rnti, drb_lcid, &result.state));
+  pdcp_obj.get_metrics(result.metrics, 1);
+
+  // Control plane operations run in the thread of the user
+  pdcp_obj.rem_user(first_rnti);
+  TESTASSERT(not pdcp_obj.get_bearer_state(first_rnti, drb_lcid, &result.state));
+
+  pdcp_obj.stop();
+
+  result.dl_pdus = std::move(rlc.sdus);
+  result.ul_pdus = std::move(gtpu.pdus);
+  return SRSRAN_SUCCESS;
+}
+
+int compare_pdus(const pdu_list_t& a, const pdu_list_t& b)
+{
+  TESTASSERT_EQ(a.size(), b.size());
+  for (const auto& ue : a) {
+    TESTASSERT(b.count(ue.first) > 0);
+    const std::vector<srsran::unique_byte_buffer_t>& other = b.at(ue.first);
+    TESTASSERT_EQ(ue.second.size(), other.size());
+    for (uint32_t i = 0; i < other.size(); i++) {
+      TESTASSERT_EQ(ue.second[i]->N_bytes, other[i]->N_bytes);
+      TESTASSERT(memcmp(ue.second[i]->msg, other[i]->msg, other[i]->N_bytes) == 0);
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_up_threads()
+{
+  test_result_t ref, up;
+  TESTASSERT(run_traffic(0, ref) == SRSRAN_SUCCESS);
+  TESTASSERT(run_traffic(3, up) == SRSRAN_SUCCESS);
+
+  // Each user must get the same PDUs and in the same order
+  TESTASSERT(compare_pdus(ref.dl_pdus, up.dl_pdus) == SRSRAN_SUCCESS);
+  TESTASSERT(compare_pdus(ref.ul_pdus, up.ul_pdus) == SRSRAN_SUCCESS);
+  TESTASSERT_EQ(nof_dl_sdus / nof_users, up.state.next_pdcp_tx_sn);
+  TESTASSERT_EQ(ref.state.next_pdcp_tx_sn, up.state.next_pdcp_tx_sn);
+
+  // Metrics are reported for all users, sorted by RNTI
+  TESTASSERT_EQ(nof_users, up.metrics.ues.size());
+  for (uint32_t i = 0; i < nof_users; i++) {
+    TESTASSERT_EQ(ref.metrics.ues[i].bearer[drb_lcid].num_tx_pdus, up.metrics.ues[i].bearer[drb_lcid].num_tx_pdus);
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_up_threads_metrics()
+{
+  srslog::basic_logger&  logger = srslog::fetch_basic_logger("PDCP", false);
+  srsran::task_scheduler task_sched;
+  rlc_tester             rlc;
+  rrc_tester             rrc;
+  gtpu_tester            gtpu;
+
+  pdcp_args_t args;
+  args.nof_up_threads = 3;
+  pdcp pdcp_obj(&task_sched, logger);
+  pdcp_obj.init(&rlc, &rrc, &gtpu, args);
+
+  // These RNTIs share the same slot of the user maps, but are served by different UP threads
+  const uint16_t rntis[] = {first_rnti, first_rnti + SRSENB_MAX_UES};
+  TESTASSERT(rntis[0] % args.nof_up_threads != rntis[1] % args.nof_up_threads);
+  for (uint16_t rnti : rntis) {
+    pdcp_obj.add_user(rnti);
+  }
+
+  pdcp_metrics_t metrics;
+  pdcp_obj.get_metrics(metrics, 1);
+  TESTASSERT_EQ(2, metrics.ues.size());
+
+  pdcp_obj.stop();
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main()
+{
+  srslog::init();
+  srslog::fetch_basic_logger("PDCP", false).set_level(srslog::basic_levels::info);
+
+  TESTASSERT(srsenb::test_up_threads() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_up_threads_metrics() == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -28,6 +28,7 @@
 #ifndef SRSEPC_HSS_H
 #define SRSEPC_HSS_H
 
+#include "srsepc/hdr/hss/hss_db.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
@@ -35,6 +36,7 @@
 #include <cstddef>
 
 #include <map>
+#include <mutex>
 
 #define LTE_FDD_ENB_IND_HE_N_BITS 5
 #define LTE_FDD_ENB_IND_HE_MASK 0x1FUL
@@ -45,31 +47,17 @@ namespace srsepc {
 
 struct hss_args_t {
   std::string db_file;
+  std::string db_bin_file; // Binary subscriber store. Empty to keep the users of db_file in memory
   uint16_t    mcc;
   uint16_t    mnc;
 };
 
-enum hss_auth_algo { HSS_ALGO_XOR, HSS_ALGO_MILENAGE };
-
-struct hss_ue_ctx_t {
-  // Members
-  std::string        name;
-  uint64_t           imsi;
-  enum hss_auth_algo algo;
-  uint8_t            key[16];
-  bool               op_configured;
-  uint8_t            op[16];
-  uint8_t            opc[16];
-  uint8_t            amf[2];
-  uint8_t            sqn[6];
-  uint16_t           qci;
-  uint8_t            last_rand[16];
-  std::string        static_ip_addr;
-
-  // Helper getters/setters
-  void set_sqn(const uint8_t* sqn_);
-  void set_last_rand(const uint8_t* rand_);
-  void get_last_rand(uint8_t* rand_);
+// EPS authentication vector
+struct hss_auth_vector_t {
+  uint8_t k_asme[32];
+  uint8_t autn[16];
+  uint8_t rand[16];
+  uint8_t xres[16];
 };
 
 class hss : public hss_interface_nas
@@ -85,6 +73,10 @@ public:
 
   virtual bool resync_sqn(uint64_t imsi, uint8_t* auts);
 
+  // Generates consecutive authentication vectors of a user, sharing the user lookup and the AES key schedule of K
+  static const uint32_t max_auth_vectors = 5;
+  bool                  gen_auth_vectors(uint64_t imsi, hss_auth_vector_t* vectors, uint32_t nof_vectors);
+
   std::map<std::string, uint64_t> get_ip_to_imsi() const;
 
 private:
@@ -92,12 +84,9 @@ private:
   virtual ~hss();
   static hss* m_instance;
 
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> > m_imsi_to_ue_ctx;
-
   void gen_rand(uint8_t rand_[16]);
 
-  void
-       gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres);
+  void gen_auth_vectors_milenage(hss_ue_ctx_t* ue_ctx, hss_auth_vector_t* vectors, uint32_t nof_vectors);
   void gen_auth_info_answer_xor(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres);
 
   void resync_sqn_milenage(hss_ue_ctx_t* ue_ctx, uint8_t* auts);
@@ -110,8 +99,6 @@ private:
   void increment_sqn(uint8_t* sqn, uint8_t* next_sqn);
 
   bool          set_auth_algo(std::string auth_algo);
-  bool          read_db_file(std::string db_file);
-  bool          write_db_file(std::string db_file);
   hss_ue_ctx_t* get_ue_ctx(uint64_t imsi);
 
   std::string hex_string(uint8_t* hex, int size);
@@ -121,25 +108,16 @@ private:
   /*Logs*/
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("HSS");
 
+  hss_db m_db{m_logger};
+
+  // The NAS shards of the MME request vectors and resynchronizations concurrently, which update the SQNs
+  std::mutex m_mutex;
+
   uint16_t mcc;
   uint16_t mnc;
 
   std::map<std::string, uint64_t> m_ip_to_imsi;
 };
 
-inline void hss_ue_ctx_t::set_sqn(const uint8_t* sqn_)
-{
-  memcpy(sqn, sqn_, 6);
-}
-
-inline void hss_ue_ctx_t::set_last_rand(const uint8_t* last_rand_)
-{
-  memcpy(last_rand, last_rand_, 16);
-}
-
-inline void hss_ue_ctx_t::get_last_rand(uint8_t* last_rand_)
-{
-  memcpy(last_rand_, last_rand, 16);
-}
 } // namespace srsepc
 #endif // SRSEPC_HSS_H
@@ -0,0 +1,137 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        hss_db.h
+ * Description: Subscriber store of the HSS. Fixed-size records in a
+ *              memory-mapped binary file, indexed by IMSI.
+ *****************************************************************************/
+
+#ifndef SRSEPC_HSS_DB_H
+#define SRSEPC_HSS_DB_H
+
+#include "srsran/srslog/srslog.h"
+#include <netinet/in.h>
+#include <string.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace srsepc {
+
+enum hss_auth_algo { HSS_ALGO_XOR, HSS_ALGO_MILENAGE };
+
+// Subscriber record. It has a fixed size, so it is stored as is in the binary database file
+struct hss_ue_ctx_t {
+  // Members
+  uint64_t           imsi;
+  char               name[32];
+  enum hss_auth_algo algo;
+  uint8_t            key[16];
+  bool               op_configured;
+  uint8_t            op[16];
+  uint8_t            opc[16];
+  uint8_t            amf[2];
+  uint8_t            sqn[6];
+  uint16_t           qci;
+  uint8_t            last_rand[16];
+  in_addr_t          static_ip_addr; // INADDR_ANY when the SPGW allocates the IP
+
+  // Helper getters/setters
+  void set_sqn(const uint8_t* sqn_);
+  void set_last_rand(const uint8_t* rand_);
+  void get_last_rand(uint8_t* rand_);
+};
+static_assert(std::is_trivially_copyable<hss_ue_ctx_t>::value, "HSS records are copied to and from the database file");
+
+class hss_db
+{
+public:
+  explicit hss_db(srslog::basic_logger& logger_) : logger(logger_) {}
+  ~hss_db();
+  hss_db(const hss_db&) = delete;
+  hss_db& operator=(const hss_db&) = delete;
+
+  // Maps the binary database file, creating it if it does not exist. With an empty filename the records are kept
+  // in memory only
+  bool open(const std::string& filename);
+  void close();
+
+  // Writes the modified records to the file. Records are updated in place, so this is only needed for durability
+  bool sync();
+  bool is_persistent() const { return fd >= 0; }
+
+  // Returns nullptr if the IMSI is not in the store. Pointers are valid until the next call to add()
+  hss_ue_ctx_t* find(uint64_t imsi);
+  // Returns nullptr if the IMSI is already in the store
+  hss_ue_ctx_t* add(const hss_ue_ctx_t& ue_ctx);
+
+  uint32_t      size() const;
+  hss_ue_ctx_t& operator[](uint32_t idx) { return records[idx]; }
+
+  // CSV user database, in the format of user_db.csv.example
+  bool import_csv(const std::string& filename);
+  bool export_csv(const std::string& filename);
+
+private:
+  struct file_header_t {
+    char     magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t nof_records;
+    uint32_t capacity;
+  };
+  static const size_t   header_size  = 64; // Keeps the records aligned
+  static const uint32_t min_capacity = 1024;
+
+  bool     map_store(uint32_t capacity);
+  uint32_t index_slot(uint64_t imsi) const;
+  void     rebuild_index();
+
+  srslog::basic_logger& logger;
+  std::string           filename;
+  int                   fd       = -1;
+  uint8_t*              base     = nullptr;
+  size_t                map_size = 0;
+  file_header_t*        header   = nullptr;
+  hss_ue_ctx_t*         records  = nullptr;
+
+  // Open addressing hash index by IMSI. Holds the record index + 1, or 0 for an empty slot
+  std::vector<uint32_t> index;
+};
+
+inline void hss_ue_ctx_t::set_sqn(const uint8_t* sqn_)
+{
+  memcpy(sqn, sqn_, 6);
+}
+
+inline void hss_ue_ctx_t::set_last_rand(const uint8_t* last_rand_)
+{
+  memcpy(last_rand, last_rand_, 16);
+}
+
+inline void hss_ue_ctx_t::get_last_rand(uint8_t* last_rand_)
+{
+  memcpy(last_rand_, last_rand, 16);
+}
+
+} // namespace srsepc
+#endif // SRSEPC_HSS_DB_H
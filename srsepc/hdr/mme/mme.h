@@ -29,15 +29,20 @@
 #define SRSEPC_MME_H
 
 #include "s1ap.h"
+#include "srsran/adt/flat_hash_map.h"
+#include "srsran/adt/move_callback.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/epoll_helper.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/threads.h"
 #include <cstddef>
+#include <mutex>
 
 namespace srsepc {
 
 typedef struct {
   s1ap_args_t s1ap_args;
+  uint32_t    nof_nas_workers; // NAS threads. 0 handles the UEs in the MME thread
   // diameter_args_t diameter_args;
   // gtpc_args_t gtpc_args;
 } mme_args_t;
@@ -64,6 +69,14 @@ public:
   virtual bool is_nas_timer_running(enum nas_timer_type type, uint64_t imsi);
   virtual bool remove_nas_timer(enum nas_timer_type type, uint64_t imsi);
 
+  // NAS shards. A UE context belongs to the shard that created it, and its S1AP, NAS, GTP-C and timer events are all
+  // handled in that shard, so the context is only accessed by one thread. Without NAS workers the MME thread is the
+  // only shard
+  uint32_t        get_nof_nas_shards() const { return m_nof_nas_shards; }
+  bool            has_nas_workers() const { return not m_nas_workers.empty(); }
+  static uint32_t get_current_nas_shard();
+  void            run_in_nas_shard(uint32_t shard, srsran::move_task_t task);
+
 private:
   mme();
   virtual ~mme();
@@ -71,14 +84,47 @@ private:
   s1ap*       m_s1ap;
   mme_gtpc*   m_mme_gtpc;
 
-  bool   m_running;
-  fd_set m_set;
+  std::atomic<bool>            m_running;
+  epoll_reactor                m_reactor;
+  srsran::unique_byte_buffer_t m_rx_pdu;
+
+  // NAS timers of a shard, indexed by IMSI and timer type
+  using nas_timer_map_t = srsran::flat_hash_map<uint64_t, mme_timer_t>;
+
+  class nas_worker : public srsran::thread
+  {
+  public:
+    nas_worker(mme* parent_, uint32_t id_);
+    void push_task(srsran::move_task_t task);
+    void stop();
+
+    epoll_reactor   reactor;
+    nas_timer_map_t timers;
+
+  private:
+    void run_thread() override;
+
+    mme*                             parent;
+    uint32_t                         id;
+    std::atomic<bool>                running = {false};
+    std::mutex                       tasks_mutex;
+    std::vector<srsran::move_task_t> pending_tasks;
+  };
+
+  uint32_t                                  m_nof_nas_shards = 1;
+  std::vector<std::unique_ptr<nas_worker> > m_nas_workers;
+
+  // Timers of the MME thread, when it is the only shard
+  nas_timer_map_t timers;
 
-  // Timer map
-  std::vector<mme_timer_t> timers;
+  // Rx Methods
+  void handle_s1mme_rx(int fd);
+  void handle_s11_rx(int fd);
 
   // Timer Methods
-  void handle_timer_expire(int timer_fd);
+  epoll_reactor&   get_nas_reactor();
+  nas_timer_map_t& get_nas_timers();
+  void             handle_timer_expire(int timer_fd, uint64_t key);
 
   // Logs
   srslog::basic_logger& m_s1ap_logger = srslog::fetch_basic_logger("S1AP");
@@ -22,8 +22,10 @@
 #define SRSEPC_MME_GTPC_H
 
 #include "nas.h"
+#include "srsran/adt/flat_hash_map.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
+#include <mutex>
 #include <sys/socket.h>
 #include <sys/un.h>
 
@@ -58,6 +60,8 @@ public:
   void         send_downlink_data_notification_acknowledge(uint64_t imsi, enum srsran::gtpc_cause_value cause);
   virtual bool send_downlink_data_notification_failure_indication(uint64_t imsi, enum srsran::gtpc_cause_value cause);
 
+  bool find_imsi_from_ctrl_teid(uint32_t mme_ctrl_teid, uint64_t* imsi);
+
   int get_s11();
 
 private:
@@ -66,9 +70,11 @@ private:
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("MME GTPC");
   s1ap*                 m_s1ap;
 
-  uint32_t                            m_next_ctrl_teid;
-  std::map<uint32_t, uint64_t>        m_mme_ctr_teid_to_imsi;
-  std::map<uint64_t, struct gtpc_ctx> m_imsi_to_gtpc_ctx;
+  // Guards the GTP-C contexts, which are shared by the NAS shards
+  std::mutex                                  m_mutex;
+  uint32_t                                    m_next_ctrl_teid;
+  srsran::flat_hash_map<uint32_t, uint64_t>   m_mme_ctr_teid_to_imsi;
+  srsran::flat_hash_map<uint64_t, gtpc_ctx_t> m_imsi_to_gtpc_ctx;
 
   int                m_s11;
   struct sockaddr_un m_mme_addr, m_spgw_addr;
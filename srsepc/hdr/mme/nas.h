@@ -158,6 +158,10 @@ public:
   nas(const nas_init_t& args, const nas_if_t& itf);
   void reset();
 
+  // The UE contexts are allocated from a pool, as attach storms create many of them at once
+  void* operator new(size_t sz);
+  void  operator delete(void* p);
+
   /***********************
    * Initial UE messages *
    ***********************/
@@ -264,6 +268,9 @@ public:
   esm_ctx_t m_esm_ctx[MAX_ERABS_PER_UE] = {};
   sec_ctx_t m_sec_ctx                   = {};
 
+  // NAS shard that created the context, which handles all the messages of the UE
+  uint32_t m_shard = 0;
+
 private:
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("NAS");
   gtpc_interface_nas*   m_gtpc   = nullptr;
@@ -29,6 +29,7 @@
 #include "s1ap_nas_transport.h"
 #include "s1ap_paging.h"
 #include "srsepc/hdr/hss/hss.h"
+#include "srsran/adt/flat_hash_map.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/asn1/liblte_mme.h"
 #include "srsran/asn1/s1ap.h"
@@ -39,6 +40,8 @@
 #include "srsran/srslog/srslog.h"
 #include <arpa/inet.h>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <netinet/sctp.h>
 #include <set>
 #include <strings.h>
@@ -52,6 +55,8 @@ const uint16_t S1MME_PORT = 36412;
 
 using s1ap_pdu_t = asn1::s1ap::s1ap_pdu_c;
 
+class mme;
+
 class s1ap : public s1ap_interface_nas, public s1ap_interface_gtpc, public s1ap_interface_mme
 {
 public:
@@ -96,6 +101,15 @@ public:
   uint32_t         allocate_m_tmsi(uint64_t imsi);
   virtual uint64_t find_imsi_from_m_tmsi(uint32_t m_tmsi);
 
+  // NAS shards (see mme). The UE contexts are shared by all the shards, but each one is only accessed by the thread
+  // of its own shard
+  bool     find_nas_shard_from_imsi(uint64_t imsi, uint32_t* shard);
+  bool     find_nas_shard_from_m_tmsi(uint32_t m_tmsi, uint32_t* shard);
+  uint32_t get_nas_shard_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id) const;
+
+  // eNB Id and SCTP info of the connected eNBs
+  std::vector<std::pair<uint16_t, struct sctp_sndrcvinfo> > get_active_enb_sris();
+
   s1ap_args_t           m_s1ap_args;
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("S1AP");
 
@@ -105,8 +119,8 @@ public:
   s1ap_erab_mngmt_proc* m_s1ap_erab_mngmt_proc;
   s1ap_paging*          m_s1ap_paging;
 
-  std::map<uint32_t, uint64_t>   m_tmsi_to_imsi;
-  std::map<uint16_t, enb_ctx_t*> m_active_enbs;
+  srsran::flat_hash_map<uint32_t, uint64_t>   m_tmsi_to_imsi;
+  srsran::flat_hash_map<uint16_t, enb_ctx_t*> m_active_enbs;
 
   // Interfaces
   virtual bool send_initial_context_setup_request(uint64_t imsi, uint16_t erab_to_setup);
@@ -134,24 +148,44 @@ private:
 
   static s1ap* m_instance;
 
-  uint32_t m_plmn;
-
-  hss_interface_nas*                     m_hss;
-  int                                    m_s1mme;
-  std::map<int32_t, uint16_t>            m_sctp_to_enb_id;
-  std::map<int32_t, std::set<uint32_t> > m_enb_assoc_to_ue_ids;
+  // S1AP PDU received from an eNB, handled in a NAS shard
+  struct rx_job_t {
+    s1ap_pdu_t             pdu;
+    struct sctp_sndrcvinfo enb_sri;
+  };
+  int  get_nas_shard(const s1ap_pdu_t& pdu);
+  void handle_rx_job(std::unique_ptr<rx_job_t> job);
+  void release_ue_ecm_ctx_in_lost_enb(uint32_t mme_ue_s1ap_id);
+  // Stops the NAS timers of a UE context, releases its ECM context and deletes it. Runs in the shard of the context
+  void delete_nas_ctx(nas* nas_ctx);
 
-  std::map<uint64_t, nas*> m_imsi_to_nas_ctx;
-  std::map<uint32_t, nas*> m_mme_ue_s1ap_id_to_nas_ctx;
+  uint32_t m_plmn;
 
-  uint32_t m_next_mme_ue_s1ap_id;
-  uint32_t m_next_m_tmsi;
+  mme*               m_mme = nullptr;
+  hss_interface_nas* m_hss;
+  int                m_s1mme;
+
+  // Guards the eNB and UE context maps, the UE set of each eNB and the M-TMSI allocation, which are shared by the
+  // NAS shards. It is held for the map accesses only
+  std::mutex                                          m_ctx_mutex;
+  srsran::flat_hash_map<int32_t, uint16_t>            m_sctp_to_enb_id;
+  srsran::flat_hash_map<int32_t, std::set<uint32_t> > m_enb_assoc_to_ue_ids;
+  srsran::flat_hash_map<uint64_t, nas*>               m_imsi_to_nas_ctx;
+  srsran::flat_hash_map<uint32_t, nas*>               m_mme_ue_s1ap_id_to_nas_ctx;
+  uint32_t                                            m_next_m_tmsi;
+
+  // Each shard allocates the MME-UE-S1AP-IDs congruent to its index modulo the number of shards, so that the S1AP
+  // messages of a UE are routed to its shard without a lookup
+  uint32_t              m_nof_nas_shards = 1;
+  std::vector<uint32_t> m_next_mme_ue_s1ap_id;
+  uint32_t              m_next_new_ue_shard = 0;
 
   // GTP-C Interface
   mme_gtpc* m_mme_gtpc;
 
   // PCAP
   bool              m_pcap_enable;
+  std::mutex        m_pcap_mutex;
   srsran::s1ap_pcap m_pcap;
 };
 
@@ -39,6 +39,8 @@ public:
   void                       init();
 
   bool handle_initial_ue_message(const asn1::s1ap::init_ue_msg_s& init_ue, struct sctp_sndrcvinfo* enb_sri);
+  // Finds the NAS shard of the UE that sent an Initial UE Message, from its S-TMSI or its attach request identity
+  bool find_initial_ue_message_shard(const asn1::s1ap::init_ue_msg_s& init_ue, uint32_t* shard);
   bool handle_uplink_nas_transport(const asn1::s1ap::ul_nas_transport_s& ul_xport, struct sctp_sndrcvinfo* enb_sri);
   bool send_downlink_nas_transport(uint32_t               enb_ue_s1ap_id,
                                    uint32_t               mme_ue_s1ap_id,
@@ -23,13 +23,17 @@
 #define SRSEPC_GTPU_H
 
 #include "srsepc/hdr/spgw/spgw.h"
+#include "srsepc/hdr/spgw/ue_tunnel_table.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/network_utils.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include <cstddef>
+#include <memory>
 #include <queue>
+#include <vector>
 
 namespace srsepc {
 
@@ -46,9 +50,16 @@ public:
   int get_sgi();
   int get_s1u();
 
-  void handle_sgi_pdu(srsran::unique_byte_buffer_t msg);
-  void handle_s1u_pdu(srsran::byte_buffer_t* msg);
-  void send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg);
+  void start_workers();
+
+  void handle_sgi_rx(int sgi, srsran::udp_tx_batch& s1u_tx);
+  void handle_s1u_rx(int s1u, srsran::udp_rx_batch& s1u_rx, int sgi);
+  void handle_sgi_pdu(srsran::unique_byte_buffer_t msg, srsran::udp_tx_batch& s1u_tx);
+  void handle_s1u_pdu(srsran::byte_buffer_t* msg, int sgi);
+  void send_s1u_pdu(srsran::udp_tx_batch&        s1u_tx,
+                    srsran::gtp_fteid_t          enb_fteid,
+                    srsran::unique_byte_buffer_t msg);
+  void flush_s1u_pdus(srsran::udp_tx_batch& s1u_tx);
 
   virtual in_addr_t get_s1u_addr();
 
@@ -58,6 +69,26 @@ public:
   virtual void send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
                                        std::queue<srsran::unique_byte_buffer_t>& pkt_queue);
 
+  // User plane worker. Forwards the packets of one queue of the SGi TUN device and of one S1-U socket
+  class up_worker : public srsran::thread
+  {
+  public:
+    up_worker(gtpu* parent_, uint32_t id_, int sgi_, int s1u_);
+    void stop();
+
+  private:
+    void run_thread() override;
+
+    gtpu*                parent;
+    uint32_t             id;
+    int                  sgi;
+    int                  s1u;
+    std::atomic<bool>    running = {false};
+    epoll_reactor        reactor;
+    srsran::udp_rx_batch s1u_rx;
+    srsran::udp_tx_batch s1u_tx;
+  };
+
   spgw*                m_spgw;
   gtpc_interface_gtpu* m_gtpc;
 
@@ -68,12 +99,18 @@ public:
   int         m_s1u;
   sockaddr_in m_s1u_addr;
 
-  std::map<in_addr_t, srsran::gtp_fteid_t> m_ip_to_usr_teid; // Map IP to User-plane TEID for downlink traffic
-  std::map<in_addr_t, uint32_t>            m_ip_to_ctr_teid; // IP to control TEID map. Important to check if
-                                                             // UE is attached without an active user-plane
-                                                             // for downlink notifications.
+  // With user plane workers, each worker gets a TUN queue and an S1-U socket bound with SO_REUSEPORT. The first ones
+  // are m_sgi and m_s1u
+  uint32_t                                 m_nof_up_workers = 0;
+  std::vector<int>                         m_sgi_queues;
+  std::vector<int>                         m_s1u_socks;
+  std::vector<std::unique_ptr<up_worker> > m_workers;
+
+  // Looked up for every downlink packet without locks. Only GTP-C modifies it, while holding the SPGW control mutex
+  ue_tunnel_table m_tunnels;
 
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("GTPU");
+  srsran::udp_tx_batch  m_s1u_tx{m_logger}; // S1-U PDUs of the SPGW thread, sent once per loop iteration
 };
 
 inline int spgw::gtpu::get_sgi()
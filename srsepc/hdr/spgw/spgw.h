@@ -30,9 +30,11 @@
 
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
+#include "srsran/common/epoll_helper.h"
 #include "srsran/common/threads.h"
 #include "srsran/srslog/srslog.h"
 #include <cstddef>
+#include <mutex>
 #include <queue>
 
 namespace srsepc {
@@ -46,6 +48,7 @@ typedef struct {
   std::string sgi_if_addr;
   std::string sgi_if_name;
   uint32_t    max_paging_queue;
+  uint32_t    nof_up_workers; ///< User plane threads, each with its own SGi TUN queue. 0 runs it in the SPGW thread
 } spgw_args_t;
 
 typedef struct spgw_tunnel_ctx {
@@ -80,8 +83,12 @@ private:
   spgw_tunnel_ctx_t* create_gtp_ctx(struct srsran::gtpc_create_session_request* cs_req);
   bool               delete_gtp_ctx(uint32_t ctrl_teid);
 
-  bool      m_running;
-  mme_gtpc* m_mme_gtpc;
+  std::atomic<bool> m_running;
+  epoll_reactor     m_reactor;
+  mme_gtpc*         m_mme_gtpc;
+
+  // Held while GTP-C handles a message, as the user plane workers also access it to page idle UEs
+  std::mutex m_ctrl_mutex;
 
   // GTP-C and GTP-U handlers
   gtpc* m_gtpc;
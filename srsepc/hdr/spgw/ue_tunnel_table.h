@@ -0,0 +1,93 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSEPC_UE_TUNNEL_TABLE_H
+#define SRSEPC_UE_TUNNEL_TABLE_H
+
+#include "srsran/adt/rcu_hash_map.h"
+#include "srsran/asn1/gtpc_ies.h"
+#include <netinet/in.h>
+
+namespace srsepc {
+
+/**
+ * Downlink tunnels of every UE IP. The user plane workers look it up for every downlink packet without locks, after
+ * registering as readers of qsbr(). Only GTP-C modifies it, one update at a time.
+ */
+class ue_tunnel_table
+{
+public:
+  // The control tunnel is needed to page the UEs that are attached without an active user-plane
+  struct ue_tunnel_t {
+    srsran::gtp_fteid_t enb_fteid     = {}; // User-plane TEID for downlink traffic
+    uint32_t            spgw_ctr_teid = 0;
+    bool                usr_active    = false;
+    bool                ctr_active    = false;
+  };
+
+  /// Reader side. Returns false if the UE IP has no tunnel
+  bool find(in_addr_t ue_ipv4, ue_tunnel_t& tunnel) const { return m_ip_to_tunnel.find(ue_ipv4, tunnel); }
+
+  /// Writer side. Activates both the user and the control tunnels of the UE IP
+  void modify(in_addr_t ue_ipv4, const srsran::gtp_fteid_t& dw_user_fteid, uint32_t up_ctr_teid)
+  {
+    ue_tunnel_t tunnel;
+    tunnel.enb_fteid     = dw_user_fteid;
+    tunnel.spgw_ctr_teid = up_ctr_teid;
+    tunnel.usr_active    = true;
+    tunnel.ctr_active    = true;
+    m_ip_to_tunnel.insert(ue_ipv4, tunnel);
+  }
+
+  /// Writer side. Deactivates the user tunnel, the UE IP is removed if it has no tunnel left
+  bool delete_user_tunnel(in_addr_t ue_ipv4) { return delete_tunnel(ue_ipv4, &ue_tunnel_t::usr_active); }
+
+  /// Writer side. Deactivates the control tunnel, the UE IP is removed if it has no tunnel left
+  bool delete_ctrl_tunnel(in_addr_t ue_ipv4) { return delete_tunnel(ue_ipv4, &ue_tunnel_t::ctr_active); }
+
+  /// Writer side
+  size_t size() const { return m_ip_to_tunnel.size(); }
+
+  srsran::qsbr_domain& qsbr() { return m_qsbr; }
+
+private:
+  bool delete_tunnel(in_addr_t ue_ipv4, bool ue_tunnel_t::*active)
+  {
+    ue_tunnel_t tunnel;
+    if (not m_ip_to_tunnel.find(ue_ipv4, tunnel) or not(tunnel.*active)) {
+      return false;
+    }
+    tunnel.*active = false;
+    if (tunnel.usr_active or tunnel.ctr_active) {
+      m_ip_to_tunnel.insert(ue_ipv4, tunnel);
+    } else {
+      m_ip_to_tunnel.erase(ue_ipv4);
+    }
+    return true;
+  }
+
+  srsran::qsbr_domain                          m_qsbr;
+  srsran::rcu_hash_map<in_addr_t, ue_tunnel_t> m_ip_to_tunnel{m_qsbr};
+};
+
+} // namespace srsepc
+
+#endif // SRSEPC_UE_TUNNEL_TABLE_H
@@ -69,11 +69,29 @@ int hss::init(hss_args_t* hss_args)
   srand(time(NULL));
 
   /*Read user information from DB*/
-  if (read_db_file(hss_args->db_file) == false) {
+  if (not m_db.open(hss_args->db_bin_file)) {
+    srsran::console("Error opening HSS database %s\n", hss_args->db_bin_file.c_str());
+    return -1;
+  }
+  // A new store is filled from the CSV file. An existing binary store is used as is
+  if (m_db.size() == 0 and not m_db.import_csv(hss_args->db_file)) {
     srsran::console("Error reading user database file %s\n", hss_args->db_file.c_str());
     return -1;
   }
 
+  for (uint32_t i = 0; i < m_db.size(); i++) {
+    const hss_ue_ctx_t& ue_ctx = m_db[i];
+    if (ue_ctx.static_ip_addr == INADDR_ANY) {
+      continue;
+    }
+    char ip_str[INET_ADDRSTRLEN] = {};
+    inet_ntop(AF_INET, &ue_ctx.static_ip_addr, ip_str, sizeof(ip_str));
+    if (not m_ip_to_imsi.insert(std::make_pair(std::string(ip_str), ue_ctx.imsi)).second) {
+      m_logger.info("duplicate static ip addr %s", ip_str);
+      return -1;
+    }
+  }
+
   mcc = hss_args->mcc;
   mnc = hss_args->mnc;
 
@@ -86,179 +104,38 @@ int hss::init(hss_args_t* hss_args)
 
 void hss::stop()
 {
-  write_db_file(db_file);
+  // The binary store is updated in place. Without it, the SQNs are saved to the CSV file
+  if (m_db.is_persistent()) {
+    m_db.sync();
+  } else {
+    m_db.export_csv(db_file);
+  }
+  m_db.close();
   return;
 }
 
-bool hss::read_db_file(std::string db_filename)
+bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres)
 {
-  std::ifstream m_db_file;
-
-  m_db_file.open(db_filename.c_str(), std::ifstream::in);
-  if (!m_db_file.is_open()) {
+  hss_auth_vector_t vector;
+  if (not gen_auth_vectors(imsi, &vector, 1)) {
     return false;
   }
-  m_logger.info("Opened DB file: %s", db_filename.c_str());
-
-  std::string line;
-  while (std::getline(m_db_file, line)) {
-    if (line[0] != '#' && line.length() > 0) {
-      uint                     column_size = 10;
-      std::vector<std::string> split       = srsran::split_string(line, ',');
-      if (split.size() != column_size) {
-        m_logger.error("Error parsing UE database. Wrong number of columns in .csv");
-        m_logger.error("Columns: %zd, Expected %d.", split.size(), column_size);
-
-        srsran::console("\nError parsing UE database. Wrong number of columns in user database CSV.\n");
-        srsran::console("Perhaps you are using an old user_db.csv?\n");
-        srsran::console("See 'srsepc/user_db.csv.example' for an example.\n\n");
-        return false;
-      }
-      std::unique_ptr<hss_ue_ctx_t> ue_ctx = std::unique_ptr<hss_ue_ctx_t>(new hss_ue_ctx_t);
-      ue_ctx->name                         = split[0];
-      if (split[1] == std::string("xor")) {
-        ue_ctx->algo = HSS_ALGO_XOR;
-      } else if (split[1] == std::string("mil")) {
-        ue_ctx->algo = HSS_ALGO_MILENAGE;
-      } else {
-        m_logger.error("Neither XOR nor MILENAGE configured.");
-        return false;
-      }
-      ue_ctx->imsi = strtoull(split[2].c_str(), nullptr, 10);
-      srsran::get_uint_vec_from_hex_str(split[3], ue_ctx->key, 16);
-      if (split[4] == std::string("op")) {
-        ue_ctx->op_configured = true;
-        srsran::get_uint_vec_from_hex_str(split[5], ue_ctx->op, 16);
-        srsran::compute_opc(ue_ctx->key, ue_ctx->op, ue_ctx->opc);
-      } else if (split[4] == std::string("opc")) {
-        ue_ctx->op_configured = false;
-        srsran::get_uint_vec_from_hex_str(split[5], ue_ctx->opc, 16);
-      } else {
-        m_logger.error("Neither OP nor OPc configured.");
-        return false;
-      }
-      srsran::get_uint_vec_from_hex_str(split[6], ue_ctx->amf, 2);
-      srsran::get_uint_vec_from_hex_str(split[7], ue_ctx->sqn, 6);
-
-      m_logger.debug("Added user from DB, IMSI: %015" PRIu64 "", ue_ctx->imsi);
-      m_logger.debug(ue_ctx->key, 16, "User Key : ");
-      if (ue_ctx->op_configured) {
-        m_logger.debug(ue_ctx->op, 16, "User OP : ");
-      }
-      m_logger.debug(ue_ctx->opc, 16, "User OPc : ");
-      m_logger.debug(ue_ctx->amf, 2, "AMF : ");
-      m_logger.debug(ue_ctx->sqn, 6, "SQN : ");
-      ue_ctx->qci = (uint16_t)strtol(split[8].c_str(), nullptr, 10);
-      m_logger.debug("Default Bearer QCI: %d", ue_ctx->qci);
-
-      if (split[9] == std::string("dynamic")) {
-        ue_ctx->static_ip_addr = "0.0.0.0";
-      } else {
-        char buf[128] = {0};
-        if (inet_pton(AF_INET, split[9].c_str(), buf)) {
-          if (m_ip_to_imsi.insert(std::make_pair(split[9], ue_ctx->imsi)).second) {
-            ue_ctx->static_ip_addr = split[9];
-            m_logger.info("static ip addr %s", ue_ctx->static_ip_addr.c_str());
-          } else {
-            m_logger.info("duplicate static ip addr %s", split[9].c_str());
-            return false;
-          }
-        } else {
-          m_logger.info("invalid static ip addr %s, %s", split[9].c_str(), strerror(errno));
-          return false;
-        }
-      }
-      m_imsi_to_ue_ctx.insert(std::make_pair(ue_ctx->imsi, std::move(ue_ctx)));
-    }
-  }
-
-  if (m_db_file.is_open()) {
-    m_db_file.close();
-  }
-
+  memcpy(k_asme, vector.k_asme, sizeof(vector.k_asme));
+  memcpy(autn, vector.autn, sizeof(vector.autn));
+  memcpy(rand, vector.rand, sizeof(vector.rand));
+  memcpy(xres, vector.xres, sizeof(vector.xres));
   return true;
 }
 
-bool hss::write_db_file(std::string db_filename)
+bool hss::gen_auth_vectors(uint64_t imsi, hss_auth_vector_t* vectors, uint32_t nof_vectors)
 {
-  std::string line;
-  uint8_t     k[16];
-  uint8_t     amf[2];
-  uint8_t     op[16];
-  uint8_t     sqn[6];
-
-  std::ofstream m_db_file;
-
-  m_db_file.open(db_filename.c_str(), std::ofstream::out);
-  if (!m_db_file.is_open()) {
+  m_logger.debug("Generating AUTH info answer");
+  if (nof_vectors == 0 or nof_vectors > max_auth_vectors) {
+    m_logger.error("Invalid number of authentication vectors %d", nof_vectors);
     return false;
   }
-  m_logger.info("Opened DB file: %s", db_filename.c_str());
-
-  // Write comment info
-  m_db_file << "#                                                                                           \n"
-            << "# .csv to store UE's information in HSS                                                     \n"
-            << "# Kept in the following format: \"Name,Auth,IMSI,Key,OP_Type,OP/OPc,AMF,SQN,QCI,IP_alloc\"  \n"
-            << "#                                                                                           \n"
-            << "# Name:     Human readable name to help distinguish UE's. Ignored by the HSS                \n"
-            << "# Auth:     Authentication algorithm used by the UE. Valid algorithms are XOR               \n"
-            << "#           (xor) and MILENAGE (mil)                                                        \n"
-            << "# IMSI:     UE's IMSI value                                                                 \n"
-            << "# Key:      UE's key, where other keys are derived from. Stored in hexadecimal              \n"
-            << "# OP_Type:  Operator's code type, either OP or OPc                                          \n"
-            << "# OP/OPc:   Operator Code/Cyphered Operator Code, stored in hexadecimal                     \n"
-            << "# AMF:      Authentication management field, stored in hexadecimal                          \n"
-            << "# SQN:      UE's Sequence number for freshness of the authentication                        \n"
-            << "# QCI:      QoS Class Identifier for the UE's default bearer.                               \n"
-            << "# IP_alloc: IP allocation stratagy for the SPGW.                                            \n"
-            << "#           With 'dynamic' the SPGW will automatically allocate IPs                         \n"
-            << "#           With a valid IPv4 (e.g. '172.16.0.2') the UE will have a statically assigned IP.\n"
-            << "#                                                                                           \n"
-            << "# Note: Lines starting by '#' are ignored and will be overwritten                           \n";
-
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator it = m_imsi_to_ue_ctx.begin();
-  while (it != m_imsi_to_ue_ctx.end()) {
-    m_db_file << it->second->name;
-    m_db_file << ",";
-    m_db_file << (it->second->algo == HSS_ALGO_XOR ? "xor" : "mil");
-    m_db_file << ",";
-    m_db_file << std::setfill('0') << std::setw(15) << it->second->imsi;
-    m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->key, 16);
-    m_db_file << ",";
-    if (it->second->op_configured) {
-      m_db_file << "op,";
-      m_db_file << srsran::hex_string(it->second->op, 16);
-    } else {
-      m_db_file << "opc,";
-      m_db_file << srsran::hex_string(it->second->opc, 16);
-    }
-    m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->amf, 2);
-    m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->sqn, 6);
-    m_db_file << ",";
-    m_db_file << it->second->qci;
-    if (it->second->static_ip_addr != "0.0.0.0") {
-      m_db_file << ",";
-      m_db_file << it->second->static_ip_addr;
-    } else {
-      m_db_file << ",dynamic";
-    }
-    m_db_file << std::endl;
-    it++;
-  }
-  if (m_db_file.is_open()) {
-    m_db_file.close();
-  }
-  return true;
-}
-
-bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres)
-{
-
-  m_logger.debug("Generating AUTH info answer");
-  hss_ue_ctx_t* ue_ctx = get_ue_ctx(imsi);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  hss_ue_ctx_t*               ue_ctx = get_ue_ctx(imsi);
   if (ue_ctx == nullptr) {
     srsran::console("User not found at HSS. IMSI: %015" PRIu64 "\n", imsi);
     m_logger.error("User not found at HSS. IMSI: %015" PRIu64 "", imsi);
@@ -267,76 +144,75 @@ bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, ui
 
   switch (ue_ctx->algo) {
     case HSS_ALGO_XOR:
-      gen_auth_info_answer_xor(ue_ctx, k_asme, autn, rand, xres);
+      for (uint32_t i = 0; i < nof_vectors; i++) {
+        memset(&vectors[i], 0, sizeof(vectors[i]));
+        gen_auth_info_answer_xor(ue_ctx, vectors[i].k_asme, vectors[i].autn, vectors[i].rand, vectors[i].xres);
+        increment_ue_sqn(ue_ctx);
+      }
       break;
     case HSS_ALGO_MILENAGE:
-      gen_auth_info_answer_milenage(ue_ctx, k_asme, autn, rand, xres);
+      gen_auth_vectors_milenage(ue_ctx, vectors, nof_vectors);
       break;
   }
-  increment_ue_sqn(ue_ctx);
   return true;
 }
 
-void hss::gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx,
-                                        uint8_t*      k_asme,
-                                        uint8_t*      autn,
-                                        uint8_t*      rand,
-                                        uint8_t*      xres)
+void hss::gen_auth_vectors_milenage(hss_ue_ctx_t* ue_ctx, hss_auth_vector_t* vectors, uint32_t nof_vectors)
 {
   // Get K, AMF, OPC and SQN
   uint8_t* k   = ue_ctx->key;
   uint8_t* amf = ue_ctx->amf;
   uint8_t* opc = ue_ctx->opc;
-  uint8_t* sqn = ue_ctx->sqn;
 
-  // Temp variables
-  uint8_t ck[16];
-  uint8_t ik[16];
-  uint8_t ak[6];
-  uint8_t mac[8];
-
-  gen_rand(rand);
-
-  srsran::security_milenage_f2345(k, opc, rand, xres, ck, ik, ak);
-
-  m_logger.debug(k, 16, "User Key : ");
-  m_logger.debug(opc, 16, "User OPc : ");
-  m_logger.debug(rand, 16, "User Rand : ");
-  m_logger.debug(xres, 8, "User XRES: ");
-  m_logger.debug(ck, 16, "User CK: ");
-  m_logger.debug(ik, 16, "User IK: ");
-  m_logger.debug(ak, 6, "User AK: ");
+  // Each vector takes the next SQN
+  srsran::security_milenage_vector_t milenage[max_auth_vectors];
+  for (uint32_t n = 0; n < nof_vectors; n++) {
+    gen_rand(milenage[n].rand);
+    memcpy(milenage[n].sqn, ue_ctx->sqn, 6);
+    memcpy(milenage[n].amf, amf, 2);
+    increment_ue_sqn(ue_ctx);
+  }
+
+  srsran::security_milenage_f12345_multi(k, opc, milenage, nof_vectors);
+
+  for (uint32_t n = 0; n < nof_vectors; n++) {
+    srsran::security_milenage_vector_t& v      = milenage[n];
+    uint8_t*                            k_asme = vectors[n].k_asme;
+    uint8_t*                            autn   = vectors[n].autn;
+
+    m_logger.debug(k, 16, "User Key : ");
+    m_logger.debug(opc, 16, "User OPc : ");
+    m_logger.debug(v.rand, 16, "User Rand : ");
+    m_logger.debug(v.res, 8, "User XRES: ");
+    m_logger.debug(v.ck, 16, "User CK: ");
+    m_logger.debug(v.ik, 16, "User IK: ");
+    m_logger.debug(v.ak, 6, "User AK: ");
+    m_logger.debug(v.sqn, 6, "User SQN : ");
+    m_logger.debug(v.mac_a, 8, "User MAC : ");
+
+    uint8_t ak_xor_sqn[6];
+    for (int i = 0; i < 6; i++) {
+      ak_xor_sqn[i] = v.sqn[i] ^ v.ak[i];
+    }
+    // Generate K_asme
+    srsran::security_generate_k_asme(v.ck, v.ik, ak_xor_sqn, mcc, mnc, k_asme);
 
-  srsran::security_milenage_f1(k, opc, rand, sqn, amf, mac);
+    m_logger.debug("User MCC : %x  MNC : %x ", mcc, mnc);
+    m_logger.debug(k_asme, 32, "User k_asme : ");
 
-  m_logger.debug(sqn, 6, "User SQN : ");
-  m_logger.debug(mac, 8, "User MAC : ");
+    // Generate AUTN (autn = sqn ^ ak |+| amf |+| mac)
+    memcpy(&autn[0], ak_xor_sqn, 6);
+    memcpy(&autn[6], amf, 2);
+    memcpy(&autn[8], v.mac_a, 8);
+    m_logger.debug(autn, 16, "User AUTN: ");
 
-  uint8_t ak_xor_sqn[6];
-  for (int i = 0; i < 6; i++) {
-    ak_xor_sqn[i] = sqn[i] ^ ak[i];
+    memcpy(vectors[n].rand, v.rand, 16);
+    memset(vectors[n].xres, 0, sizeof(vectors[n].xres));
+    memcpy(vectors[n].xres, v.res, 8);
   }
-  // Generate K_asme
-  srsran::security_generate_k_asme(ck, ik, ak_xor_sqn, mcc, mnc, k_asme);
 
-  m_logger.debug("User MCC : %x  MNC : %x ", mcc, mnc);
-  m_logger.debug(k_asme, 32, "User k_asme : ");
-
-  // Generate AUTN (autn = sqn ^ ak |+| amf |+| mac)
-  for (int i = 0; i < 6; i++) {
-    autn[i] = sqn[i] ^ ak[i];
-  }
-  for (int i = 0; i < 2; i++) {
-    autn[6 + i] = amf[i];
-  }
-  for (int i = 0; i < 8; i++) {
-    autn[8 + i] = mac[i];
-  }
-  m_logger.debug(autn, 16, "User AUTN: ");
-
-  // Set last RAND
-  ue_ctx->set_last_rand(rand);
-  return;
+  // Set last RAND, used if the UE asks for a resynchronization
+  ue_ctx->set_last_rand(milenage[nof_vectors - 1].rand);
 }
 
 void hss::gen_auth_info_answer_xor(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres)
@@ -440,13 +316,13 @@ void hss::gen_auth_info_answer_xor(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_
 
 bool hss::gen_update_loc_answer(uint64_t imsi, uint8_t* qci)
 {
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
-  if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  const hss_ue_ctx_t*         ue_ctx = m_db.find(imsi);
+  if (ue_ctx == nullptr) {
     m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
     srsran::console("User not found at HSS. IMSI: %015" PRIu64 "\n", imsi);
     return false;
   }
-  const std::unique_ptr<hss_ue_ctx_t>& ue_ctx = ue_ctx_it->second;
   m_logger.info("Found User %015" PRIu64 "", imsi);
   *qci = ue_ctx->qci;
   return true;
@@ -455,7 +331,8 @@ bool hss::gen_update_loc_answer(uint64_t imsi, uint8_t* qci)
 bool hss::resync_sqn(uint64_t imsi, uint8_t* auts)
 {
   m_logger.debug("Re-syncing SQN");
-  hss_ue_ctx_t* ue_ctx = get_ue_ctx(imsi);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  hss_ue_ctx_t*               ue_ctx = get_ue_ctx(imsi);
   if (ue_ctx == nullptr) {
     srsran::console("User not found at HSS. IMSI: %015" PRIu64 "\n", imsi);
     m_logger.error("User not found at HSS. IMSI: %015" PRIu64 "", imsi);
@@ -612,13 +489,13 @@ void hss::gen_rand(uint8_t rand_[16])
 
 hss_ue_ctx_t* hss::get_ue_ctx(uint64_t imsi)
 {
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
-  if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
+  hss_ue_ctx_t* ue_ctx = m_db.find(imsi);
+  if (ue_ctx == nullptr) {
     m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
     return nullptr;
   }
 
-  return ue_ctx_it->second.get();
+  return ue_ctx;
 }
 
 std::map<std::string, uint64_t> hss::get_ip_to_imsi(void) const
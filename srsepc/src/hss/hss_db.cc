@@ -0,0 +1,383 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "srsepc/hdr/hss/hss_db.h"
+#include "srsran/common/security.h"
+#include "srsran/common/standard_streams.h"
+#include "srsran/common/string_helpers.h"
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <fstream>
+#include <inttypes.h> // for printing uint64_t
+#include <iomanip>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace srsepc {
+
+static const char     hss_db_magic[8] = "SRSHSS";
+static const uint32_t hss_db_version  = 1;
+
+hss_db::~hss_db()
+{
+  close();
+}
+
+bool hss_db::open(const std::string& filename_)
+{
+  close();
+  filename = filename_;
+
+  if (filename.empty()) {
+    if (not map_store(min_capacity)) {
+      return false;
+    }
+    memcpy(header->magic, hss_db_magic, sizeof(header->magic));
+    header->version     = hss_db_version;
+    header->record_size = sizeof(hss_ue_ctx_t);
+    header->nof_records = 0;
+    rebuild_index();
+    return true;
+  }
+
+  fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    logger.error("Failed to open HSS database %s: %s", filename.c_str(), strerror(errno));
+    return false;
+  }
+  struct stat st = {};
+  if (fstat(fd, &st) < 0) {
+    logger.error("Failed to read HSS database %s: %s", filename.c_str(), strerror(errno));
+    close();
+    return false;
+  }
+
+  if (st.st_size == 0) {
+    // New database
+    if (not map_store(min_capacity)) {
+      close();
+      return false;
+    }
+    memcpy(header->magic, hss_db_magic, sizeof(header->magic));
+    header->version     = hss_db_version;
+    header->record_size = sizeof(hss_ue_ctx_t);
+    header->nof_records = 0;
+    logger.info("Created HSS database %s", filename.c_str());
+  } else {
+    file_header_t hdr = {};
+    if (pread(fd, &hdr, sizeof(hdr), 0) != sizeof(hdr) or memcmp(hdr.magic, hss_db_magic, sizeof(hdr.magic)) != 0 or
+        hdr.version != hss_db_version or hdr.record_size != sizeof(hss_ue_ctx_t) or hdr.nof_records > hdr.capacity or
+        (size_t)st.st_size < header_size + (size_t)hdr.capacity * sizeof(hss_ue_ctx_t)) {
+      logger.error("%s is not a valid HSS database", filename.c_str());
+      srsran::console("%s is not a valid HSS database\n", filename.c_str());
+      close();
+      return false;
+    }
+    if (not map_store(hdr.capacity)) {
+      close();
+      return false;
+    }
+  }
+
+  rebuild_index();
+  logger.info("Opened HSS database %s with %d users", filename.c_str(), header->nof_records);
+  return true;
+}
+
+void hss_db::close()
+{
+  if (base != nullptr) {
+    sync();
+    munmap(base, map_size);
+  }
+  if (fd >= 0) {
+    ::close(fd);
+  }
+  fd       = -1;
+  base     = nullptr;
+  map_size = 0;
+  header   = nullptr;
+  records  = nullptr;
+  index.clear();
+}
+
+bool hss_db::sync()
+{
+  if (fd < 0 or base == nullptr) {
+    return true;
+  }
+  if (msync(base, map_size, MS_SYNC) < 0) {
+    logger.error("Failed to write HSS database %s: %s", filename.c_str(), strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+bool hss_db::map_store(uint32_t capacity)
+{
+  size_t new_size = header_size + (size_t)capacity * sizeof(hss_ue_ctx_t);
+  void*  ptr      = MAP_FAILED;
+
+  if (fd >= 0) {
+    // The records stay in the file while it is remapped with the new size
+    if (ftruncate(fd, new_size) < 0) {
+      logger.error("Failed to resize HSS database %s: %s", filename.c_str(), strerror(errno));
+      return false;
+    }
+    if (base != nullptr) {
+      munmap(base, map_size);
+      base = nullptr;
+    }
+    ptr = mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  } else {
+    ptr = mmap(nullptr, new_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr != MAP_FAILED and base != nullptr) {
+      memcpy(ptr, base, map_size);
+      munmap(base, map_size);
+      base = nullptr;
+    }
+  }
+  if (ptr == MAP_FAILED) {
+    logger.error("Failed to map HSS database: %s", strerror(errno));
+    return false;
+  }
+
+  base             = (uint8_t*)ptr;
+  map_size         = new_size;
+  header           = (file_header_t*)base;
+  records          = (hss_ue_ctx_t*)(base + header_size);
+  header->capacity = capacity;
+  return true;
+}
+
+uint32_t hss_db::size() const
+{
+  return header != nullptr ? header->nof_records : 0;
+}
+
+uint32_t hss_db::index_slot(uint64_t imsi) const
+{
+  // Fibonacci hashing spreads the consecutive IMSIs of a block of SIMs over the index
+  uint32_t mask = index.size() - 1;
+  uint32_t slot = (uint32_t)((imsi * 0x9e3779b97f4a7c15ULL) >> 32u) & mask;
+  while (index[slot] != 0 and records[index[slot] - 1].imsi != imsi) {
+    slot = (slot + 1) & mask;
+  }
+  return slot;
+}
+
+void hss_db::rebuild_index()
+{
+  size_t nof_slots = 16;
+  while (nof_slots < 2 * ((size_t)size() + 1)) {
+    nof_slots *= 2;
+  }
+  index.assign(nof_slots, 0);
+  for (uint32_t i = 0; i < size(); i++) {
+    uint32_t slot = index_slot(records[i].imsi);
+    if (index[slot] == 0) {
+      index[slot] = i + 1;
+    }
+  }
+}
+
+hss_ue_ctx_t* hss_db::find(uint64_t imsi)
+{
+  if (index.empty()) {
+    return nullptr;
+  }
+  uint32_t slot = index_slot(imsi);
+  return index[slot] != 0 ? &records[index[slot] - 1] : nullptr;
+}
+
+hss_ue_ctx_t* hss_db::add(const hss_ue_ctx_t& ue_ctx)
+{
+  if (header == nullptr or find(ue_ctx.imsi) != nullptr) {
+    return nullptr;
+  }
+  if (header->nof_records == header->capacity and not map_store(header->capacity * 2)) {
+    return nullptr;
+  }
+
+  uint32_t idx = header->nof_records;
+  records[idx] = ue_ctx;
+  header->nof_records++;
+  if (2 * ((size_t)size() + 1) > index.size()) {
+    rebuild_index();
+  } else {
+    index[index_slot(ue_ctx.imsi)] = idx + 1;
+  }
+  return &records[idx];
+}
+
+bool hss_db::import_csv(const std::string& db_filename)
+{
+  std::ifstream m_db_file;
+
+  m_db_file.open(db_filename.c_str(), std::ifstream::in);
+  if (!m_db_file.is_open()) {
+    return false;
+  }
+  logger.info("Opened DB file: %s", db_filename.c_str());
+
+  std::string line;
+  while (std::getline(m_db_file, line)) {
+    if (line[0] != '#' && line.length() > 0) {
+      uint                     column_size = 10;
+      std::vector<std::string> split       = srsran::split_string(line, ',');
+      if (split.size() != column_size) {
+        logger.error("Error parsing UE database. Wrong number of columns in .csv");
+        logger.error("Columns: %zd, Expected %d.", split.size(), column_size);
+
+        srsran::console("\nError parsing UE database. Wrong number of columns in user database CSV.\n");
+        srsran::console("Perhaps you are using an old user_db.csv?\n");
+        srsran::console("See 'srsepc/user_db.csv.example' for an example.\n\n");
+        return false;
+      }
+      hss_ue_ctx_t ue_ctx = {};
+      strncpy(ue_ctx.name, split[0].c_str(), sizeof(ue_ctx.name) - 1);
+      if (split[1] == std::string("xor")) {
+        ue_ctx.algo = HSS_ALGO_XOR;
+      } else if (split[1] == std::string("mil")) {
+        ue_ctx.algo = HSS_ALGO_MILENAGE;
+      } else {
+        logger.error("Neither XOR nor MILENAGE configured.");
+        return false;
+      }
+      ue_ctx.imsi = strtoull(split[2].c_str(), nullptr, 10);
+      srsran::get_uint_vec_from_hex_str(split[3], ue_ctx.key, 16);
+      if (split[4] == std::string("op")) {
+        ue_ctx.op_configured = true;
+        srsran::get_uint_vec_from_hex_str(split[5], ue_ctx.op, 16);
+        srsran::compute_opc(ue_ctx.key, ue_ctx.op, ue_ctx.opc);
+      } else if (split[4] == std::string("opc")) {
+        ue_ctx.op_configured = false;
+        srsran::get_uint_vec_from_hex_str(split[5], ue_ctx.opc, 16);
+      } else {
+        logger.error("Neither OP nor OPc configured.");
+        return false;
+      }
+      srsran::get_uint_vec_from_hex_str(split[6], ue_ctx.amf, 2);
+      srsran::get_uint_vec_from_hex_str(split[7], ue_ctx.sqn, 6);
+
+      logger.debug("Added user from DB, IMSI: %015" PRIu64 "", ue_ctx.imsi);
+      logger.debug(ue_ctx.key, 16, "User Key : ");
+      if (ue_ctx.op_configured) {
+        logger.debug(ue_ctx.op, 16, "User OP : ");
+      }
+      logger.debug(ue_ctx.opc, 16, "User OPc : ");
+      logger.debug(ue_ctx.amf, 2, "AMF : ");
+      logger.debug(ue_ctx.sqn, 6, "SQN : ");
+      ue_ctx.qci = (uint16_t)strtol(split[8].c_str(), nullptr, 10);
+      logger.debug("Default Bearer QCI: %d", ue_ctx.qci);
+
+      if (split[9] == std::string("dynamic")) {
+        ue_ctx.static_ip_addr = INADDR_ANY;
+      } else if (inet_pton(AF_INET, split[9].c_str(), &ue_ctx.static_ip_addr) == 1) {
+        logger.info("static ip addr %s", split[9].c_str());
+      } else {
+        logger.info("invalid static ip addr %s, %s", split[9].c_str(), strerror(errno));
+        return false;
+      }
+      if (add(ue_ctx) == nullptr) {
+        logger.warning("Ignoring duplicate user from DB, IMSI: %015" PRIu64 "", ue_ctx.imsi);
+      }
+    }
+  }
+
+  if (m_db_file.is_open()) {
+    m_db_file.close();
+  }
+
+  return true;
+}
+
+bool hss_db::export_csv(const std::string& db_filename)
+{
+  std::ofstream m_db_file;
+
+  m_db_file.open(db_filename.c_str(), std::ofstream::out);
+  if (!m_db_file.is_open()) {
+    return false;
+  }
+  logger.info("Opened DB file: %s", db_filename.c_str());
+
+  // Write comment info
+  m_db_file << "#                                                                                           \n"
+            << "# .csv to store UE's information in HSS                                                     \n"
+            << "# Kept in the following format: \"Name,Auth,IMSI,Key,OP_Type,OP/OPc,AMF,SQN,QCI,IP_alloc\"  \n"
+            << "#                                                                                           \n"
+            << "# Name:     Human readable name to help distinguish UE's. Ignored by the HSS                \n"
+            << "# Auth:     Authentication algorithm used by the UE. Valid algorithms are XOR               \n"
+            << "#           (xor) and MILENAGE (mil)                                                        \n"
+            << "# IMSI:     UE's IMSI value                                                                 \n"
+            << "# Key:      UE's key, where other keys are derived from. Stored in hexadecimal              \n"
+            << "# OP_Type:  Operator's code type, either OP or OPc                                          \n"
+            << "# OP/OPc:   Operator Code/Cyphered Operator Code, stored in hexadecimal                     \n"
+            << "# AMF:      Authentication management field, stored in hexadecimal                          \n"
+            << "# SQN:      UE's Sequence number for freshness of the authentication                        \n"
+            << "# QCI:      QoS Class Identifier for the UE's default bearer.                               \n"
+            << "# IP_alloc: IP allocation stratagy for the SPGW.                                            \n"
+            << "#           With 'dynamic' the SPGW will automatically allocate IPs                         \n"
+            << "#           With a valid IPv4 (e.g. '172.16.0.2') the UE will have a statically assigned IP.\n"
+            << "#                                                                                           \n"
+            << "# Note: Lines starting by '#' are ignored and will be overwritten                           \n";
+
+  for (uint32_t i = 0; i < size(); i++) {
+    hss_ue_ctx_t& ue_ctx = records[i];
+    m_db_file << ue_ctx.name;
+    m_db_file << ",";
+    m_db_file << (ue_ctx.algo == HSS_ALGO_XOR ? "xor" : "mil");
+    m_db_file << ",";
+    m_db_file << std::setfill('0') << std::setw(15) << ue_ctx.imsi;
+    m_db_file << ",";
+    m_db_file << srsran::hex_string(ue_ctx.key, 16);
+    m_db_file << ",";
+    if (ue_ctx.op_configured) {
+      m_db_file << "op,";
+      m_db_file << srsran::hex_string(ue_ctx.op, 16);
+    } else {
+      m_db_file << "opc,";
+      m_db_file << srsran::hex_string(ue_ctx.opc, 16);
+    }
+    m_db_file << ",";
+    m_db_file << srsran::hex_string(ue_ctx.amf, 2);
+    m_db_file << ",";
+    m_db_file << srsran::hex_string(ue_ctx.sqn, 6);
+    m_db_file << ",";
+    m_db_file << ue_ctx.qci;
+    if (ue_ctx.static_ip_addr != INADDR_ANY) {
+      char ip_str[INET_ADDRSTRLEN] = {};
+      inet_ntop(AF_INET, &ue_ctx.static_ip_addr, ip_str, sizeof(ip_str));
+      m_db_file << ",";
+      m_db_file << ip_str;
+    } else {
+      m_db_file << ",dynamic";
+    }
+    m_db_file << std::endl;
+  }
+  if (m_db_file.is_open()) {
+    m_db_file.close();
+  }
+  return true;
+}
+
+} // namespace srsepc
@@ -20,6 +20,7 @@
  */
 
 #include "srsepc/hdr/mme/mme.h"
+#include <algorithm>
 #include <arpa/inet.h>
 #include <inttypes.h> // for printing uint64_t
 #include <netinet/sctp.h>
@@ -31,6 +32,9 @@ namespace srsepc {
 mme*            mme::m_instance    = NULL;
 pthread_mutex_t mme_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+// NAS shard run by the calling thread
+static thread_local uint32_t current_nas_shard = 0;
+
 mme::mme() : m_running(false), thread("MME")
 {
   return;
@@ -63,6 +67,9 @@ void mme::cleanup(void)
 
 int mme::init(mme_args_t* args)
 {
+  // The shards are known before S1AP allocates the MME-UE-S1AP-IDs
+  m_nof_nas_shards = std::max(args->nof_nas_workers, 1u);
+
   /*Init S1AP*/
   m_s1ap = s1ap::get_instance();
   if (m_s1ap->init(args->s1ap_args)) {
@@ -77,6 +84,14 @@ int mme::init(mme_args_t* args)
     exit(-1);
   }
 
+  /*Start NAS workers*/
+  for (uint32_t i = 0; i < args->nof_nas_workers; ++i) {
+    m_nas_workers.emplace_back(new nas_worker(this, i));
+  }
+  if (not m_nas_workers.empty()) {
+    srsran::console("MME NAS handled by %d threads\n", args->nof_nas_workers);
+  }
+
   /*Log successful initialization*/
   m_s1ap_logger.info("MME Initialized. MCC: 0x%x, MNC: 0x%x", args->s1ap_args.mcc, args->s1ap_args.mnc);
   srsran::console("MME Initialized. MCC: 0x%x, MNC: 0x%x\n", args->s1ap_args.mcc, args->s1ap_args.mnc);
@@ -86,10 +101,14 @@ int mme::init(mme_args_t* args)
 void mme::stop()
 {
   if (m_running) {
+    // No UE context is in use once the workers have stopped
+    for (auto& worker : m_nas_workers) {
+      worker->stop();
+    }
     m_s1ap->stop();
     m_s1ap->cleanup();
     m_running = false;
-    thread_cancel();
+    m_reactor.wakeup();
     wait_thread_finish();
   }
   return;
@@ -97,100 +116,181 @@ void mme::stop()
 
 void mme::run_thread()
 {
-  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer("mme::run_thread");
-  if (pdu == nullptr) {
+  m_rx_pdu = srsran::make_byte_buffer("mme::run_thread");
+  if (m_rx_pdu == nullptr) {
     m_s1ap_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
     return;
   }
-  uint32_t                     sz  = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
 
+  // Mark the thread as running
+  m_running = true;
+
+  // Register S1-MME and S11 sockets. NAS timers are registered as they are started
+  m_reactor.add_fd(m_s1ap->get_s1_mme(), [this](int fd) { handle_s1mme_rx(fd); });
+  m_reactor.add_fd(m_mme_gtpc->get_s11(), [this](int fd) { handle_s11_rx(fd); });
+
+  while (m_running) {
+    m_s1ap_logger.debug("Waiting for S1-MME or S11 Message");
+    int n = m_reactor.run_once();
+    if (n == -1) {
+      m_s1ap_logger.error("Error from epoll_wait");
+    } else if (n == 0) {
+      m_s1ap_logger.debug("No data from epoll_wait.");
+    }
+  }
+  return;
+}
+
+void mme::handle_s1mme_rx(int fd)
+{
+  uint32_t               sz = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
   struct sockaddr_in     enb_addr;
   struct sctp_sndrcvinfo sri;
   socklen_t              fromlen = sizeof(enb_addr);
   bzero(&enb_addr, sizeof(enb_addr));
-  int rd_sz;
   int msg_flags = 0;
 
-  // Mark the thread as running
-  m_running = true;
+  srsran::unique_byte_buffer_t& pdu = m_rx_pdu;
+  pdu->clear();
+  int rd_sz = sctp_recvmsg(fd, pdu->msg, sz, (struct sockaddr*)&enb_addr, &fromlen, &sri, &msg_flags);
+  if (rd_sz == -1 && errno != EAGAIN) {
+    m_s1ap_logger.error("Error reading from SCTP socket: %s", strerror(errno));
+  } else if (rd_sz == -1 && errno == EAGAIN) {
+    m_s1ap_logger.debug("Socket timeout reached");
+  } else {
+    if (msg_flags & MSG_NOTIFICATION) {
+      // Received notification
+      union sctp_notification* notification = (union sctp_notification*)pdu->msg;
+      m_s1ap_logger.debug("SCTP Notification %d", notification->sn_header.sn_type);
+      if (notification->sn_header.sn_type == SCTP_SHUTDOWN_EVENT) {
+        m_s1ap_logger.info("SCTP Association Shutdown. Association: %d", sri.sinfo_assoc_id);
+        srsran::console("SCTP Association Shutdown. Association: %d\n", sri.sinfo_assoc_id);
+        m_s1ap->delete_enb_ctx(sri.sinfo_assoc_id);
+      }
+    } else {
+      // Received data
+      pdu->N_bytes = rd_sz;
+      m_s1ap_logger.info("Received S1AP msg. Size: %d", pdu->N_bytes);
+      m_s1ap->handle_s1ap_rx_pdu(pdu.get(), &sri);
+    }
+  }
+}
 
-  // Get S1-MME and S11 sockets
-  int s1mme = m_s1ap->get_s1_mme();
-  int s11   = m_mme_gtpc->get_s11();
+void mme::handle_s11_rx(int fd)
+{
+  uint32_t sz = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+  m_rx_pdu->clear();
+  m_rx_pdu->N_bytes = recvfrom(fd, m_rx_pdu->msg, sz, 0, NULL, NULL);
+  if (not has_nas_workers()) {
+    m_mme_gtpc->handle_s11_pdu(m_rx_pdu.get());
+    return;
+  }
 
-  while (m_running) {
-    pdu->clear();
-    int max_fd = std::max(s1mme, s11);
-
-    FD_ZERO(&m_set);
-    FD_SET(s1mme, &m_set);
-    FD_SET(s11, &m_set);
-
-    // Add timers to select
-    for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end(); ++it) {
-      FD_SET(it->fd, &m_set);
-      max_fd = std::max(max_fd, it->fd);
-      m_s1ap_logger.debug("Adding Timer fd %d to fd_set", it->fd);
-    }
+  // Handle the PDU in the shard of the UE that owns the control TEID. Unknown TEIDs go to the first shard
+  const srsran::gtpc_pdu* gtpc  = (const srsran::gtpc_pdu*)m_rx_pdu->msg;
+  uint32_t                shard = 0;
+  uint64_t                imsi;
+  if (m_mme_gtpc->find_imsi_from_ctrl_teid(gtpc->header.teid, &imsi)) {
+    m_s1ap->find_nas_shard_from_imsi(imsi, &shard);
+  }
+  srsran::unique_byte_buffer_t pdu = std::move(m_rx_pdu);
+  m_rx_pdu                         = srsran::make_byte_buffer("mme::handle_s11_rx");
+  if (m_rx_pdu == nullptr) {
+    m_s1ap_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+    m_rx_pdu = std::move(pdu);
+    return;
+  }
+  run_in_nas_shard(shard, [this, pdu = std::move(pdu)]() { m_mme_gtpc->handle_s11_pdu(pdu.get()); });
+}
 
-    m_s1ap_logger.debug("Waiting for S1-MME or S11 Message");
-    int n = select(max_fd + 1, &m_set, NULL, NULL, NULL);
+/*
+ * NAS shards
+ */
+uint32_t mme::get_current_nas_shard()
+{
+  return current_nas_shard;
+}
+
+void mme::run_in_nas_shard(uint32_t shard, srsran::move_task_t task)
+{
+  if (m_nas_workers.empty()) {
+    task();
+    return;
+  }
+  m_nas_workers[shard % m_nas_workers.size()]->push_task(std::move(task));
+}
+
+mme::nas_worker::nas_worker(mme* parent_, uint32_t id_) :
+  thread("MME-NAS" + std::to_string(id_)), parent(parent_), id(id_)
+{
+  running = true;
+  start();
+}
+
+void mme::nas_worker::push_task(srsran::move_task_t task)
+{
+  bool was_empty;
+  {
+    std::lock_guard<std::mutex> lock(tasks_mutex);
+    was_empty = pending_tasks.empty();
+    pending_tasks.push_back(std::move(task));
+  }
+  // A burst of messages for the worker wakes it up once
+  if (was_empty) {
+    reactor.wakeup();
+  }
+}
+
+void mme::nas_worker::stop()
+{
+  if (running) {
+    running = false;
+    reactor.wakeup();
+    wait_thread_finish();
+  }
+}
+
+void mme::nas_worker::run_thread()
+{
+  current_nas_shard = id;
+
+  std::vector<srsran::move_task_t> tasks;
+  while (running) {
+    int n = reactor.wait_events();
     if (n == -1) {
-      m_s1ap_logger.error("Error from select");
-    } else if (n) {
-      // Handle S1-MME
-      if (FD_ISSET(s1mme, &m_set)) {
-        rd_sz = sctp_recvmsg(s1mme, pdu->msg, sz, (struct sockaddr*)&enb_addr, &fromlen, &sri, &msg_flags);
-        if (rd_sz == -1 && errno != EAGAIN) {
-          m_s1ap_logger.error("Error reading from SCTP socket: %s", strerror(errno));
-        } else if (rd_sz == -1 && errno == EAGAIN) {
-          m_s1ap_logger.debug("Socket timeout reached");
-        } else {
-          if (msg_flags & MSG_NOTIFICATION) {
-            // Received notification
-            union sctp_notification* notification = (union sctp_notification*)pdu->msg;
-            m_s1ap_logger.debug("SCTP Notification %d", notification->sn_header.sn_type);
-            if (notification->sn_header.sn_type == SCTP_SHUTDOWN_EVENT) {
-              m_s1ap_logger.info("SCTP Association Shutdown. Association: %d", sri.sinfo_assoc_id);
-              srsran::console("SCTP Association Shutdown. Association: %d\n", sri.sinfo_assoc_id);
-              m_s1ap->delete_enb_ctx(sri.sinfo_assoc_id);
-            }
-          } else {
-            // Received data
-            pdu->N_bytes = rd_sz;
-            m_s1ap_logger.info("Received S1AP msg. Size: %d", pdu->N_bytes);
-            m_s1ap->handle_s1ap_rx_pdu(pdu.get(), &sri);
-          }
-        }
-      }
-      // Handle S11
-      if (FD_ISSET(s11, &m_set)) {
-        pdu->N_bytes = recvfrom(s11, pdu->msg, sz, 0, NULL, NULL);
-        m_mme_gtpc->handle_s11_pdu(pdu.get());
-      }
-      // Handle NAS Timers
-      for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end();) {
-        if (FD_ISSET(it->fd, &m_set)) {
-          m_s1ap_logger.info("Timer expired");
-          uint64_t exp;
-          rd_sz = read(it->fd, &exp, sizeof(uint64_t));
-          m_s1ap->expire_nas_timer(it->type, it->imsi);
-          close(it->fd);
-          timers.erase(it);
-        } else {
-          ++it;
-        }
-      }
-    } else {
-      m_s1ap_logger.debug("No data from select.");
+      parent->m_s1ap_logger.error("Error from epoll_wait in NAS worker %d", id);
+    } else if (n > 0) {
+      reactor.handle_events();
+    }
+    {
+      std::lock_guard<std::mutex> lock(tasks_mutex);
+      tasks.swap(pending_tasks);
+    }
+    for (srsran::move_task_t& task : tasks) {
+      task();
     }
+    tasks.clear();
   }
-  return;
 }
 
 /*
  * Timer Handling
  */
+static uint64_t nas_timer_key(nas_timer_type type, uint64_t imsi)
+{
+  return (imsi << 4u) | (uint64_t)type;
+}
+
+epoll_reactor& mme::get_nas_reactor()
+{
+  return m_nas_workers.empty() ? m_reactor : m_nas_workers[current_nas_shard]->reactor;
+}
+
+mme::nas_timer_map_t& mme::get_nas_timers()
+{
+  return m_nas_workers.empty() ? timers : m_nas_workers[current_nas_shard]->timers;
+}
+
 bool mme::add_nas_timer(int timer_fd, nas_timer_type type, uint64_t imsi)
 {
   m_s1ap_logger.debug("Adding NAS timer to MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, timer_fd);
@@ -200,40 +300,68 @@ bool mme::add_nas_timer(int timer_fd, nas_timer_type type, uint64_t imsi)
   timer.type = type;
   timer.imsi = imsi;
 
-  timers.push_back(timer);
+  // The timer expires in the shard that started it, which is the shard of the UE
+  uint64_t key = nas_timer_key(type, imsi);
+  if (not get_nas_reactor().add_fd(timer_fd, [this, key](int fd) { handle_timer_expire(fd, key); })) {
+    m_s1ap_logger.error("Could not add NAS timer fd %d to epoll", timer_fd);
+    return false;
+  }
+  auto ret = get_nas_timers().emplace(key, timer);
+  if (not ret.second) {
+    // The timer was restarted. Its previous fd is replaced, as it would never be closed otherwise
+    m_s1ap_logger.debug("Replacing NAS timer. IMSI %" PRIu64 ", Type %d, Old Fd: %d", imsi, type, ret.first->second.fd);
+    get_nas_reactor().rem_fd(ret.first->second.fd);
+    close(ret.first->second.fd);
+    ret.first->second = timer;
+  }
   return true;
 }
 
 bool mme::is_nas_timer_running(nas_timer_type type, uint64_t imsi)
 {
-  std::vector<mme_timer_t>::iterator it;
-  for (it = timers.begin(); it != timers.end(); ++it) {
-    if (it->type == type && it->imsi == imsi) {
-      return true; // found timer
-    }
-  }
-  return false;
+  return get_nas_timers().count(nas_timer_key(type, imsi)) > 0;
 }
 
 bool mme::remove_nas_timer(nas_timer_type type, uint64_t imsi)
 {
-  std::vector<mme_timer_t>::iterator it;
-  for (it = timers.begin(); it != timers.end(); ++it) {
-    if (it->type == type && it->imsi == imsi) {
-      break; // found timer to remove
-    }
-  }
-  if (it == timers.end()) {
+  nas_timer_map_t& shard_timers = get_nas_timers();
+  auto             it           = shard_timers.find(nas_timer_key(type, imsi));
+  if (it == shard_timers.end()) {
     m_s1ap_logger.warning("Could not find timer to remove. IMSI %" PRIu64 ", Type %d", imsi, type);
     return false;
   }
 
   // removing timer
-  m_s1ap_logger.debug("Removing NAS timer from MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, it->fd);
-  FD_CLR(it->fd, &m_set);
-  close(it->fd);
-  timers.erase(it);
+  m_s1ap_logger.debug("Removing NAS timer from MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, it->second.fd);
+  get_nas_reactor().rem_fd(it->second.fd);
+  close(it->second.fd);
+  shard_timers.erase(it);
   return true;
 }
 
+void mme::handle_timer_expire(int timer_fd, uint64_t key)
+{
+  nas_timer_map_t& shard_timers = get_nas_timers();
+  auto             it           = shard_timers.find(key);
+  if (it == shard_timers.end() or it->second.fd != timer_fd) {
+    m_s1ap_logger.warning("Could not find expired timer. Fd: %d", timer_fd);
+    get_nas_reactor().rem_fd(timer_fd);
+    close(timer_fd);
+    return;
+  }
+
+  m_s1ap_logger.info("Timer expired");
+  uint64_t exp;
+  if (read(timer_fd, &exp, sizeof(uint64_t)) != sizeof(uint64_t)) {
+    m_s1ap_logger.warning("Could not read expired timer. Fd: %d", timer_fd);
+  }
+  mme_timer_t timer = it->second;
+  get_nas_reactor().rem_fd(timer_fd);
+  close(timer_fd);
+  shard_timers.erase(it);
+
+  // The timer is removed first, as its expiry may start it again
+  m_s1ap->expire_nas_timer(timer.type, timer.imsi);
+}
+
 } // namespace srsepc
@@ -19,8 +19,10 @@
  *
  */
 
+#include "srsepc/hdr/mme/mme.h"
 #include "srsepc/hdr/mme/s1ap.h"
 #include "srsepc/hdr/mme/s1ap_nas_transport.h"
+#include "srsran/adt/pool/batch_mem_pool.h"
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/security.h"
 #include <cmath>
@@ -49,11 +51,28 @@ nas::nas(const nas_init_t& args, const nas_if_t& itf) :
   m_request_imeisv(args.request_imeisv),
   m_lac(args.lac)
 {
+  m_shard               = mme::get_current_nas_shard();
   m_sec_ctx.integ_algo  = args.integ_algo;
   m_sec_ctx.cipher_algo = args.cipher_algo;
   m_logger.debug("NAS Context Initialized. MCC: 0x%x, MNC 0x%x", m_mcc, m_mnc);
 }
 
+static srsran::background_mem_pool* get_nas_pool()
+{
+  static srsran::background_mem_pool pool(64, sizeof(nas), 32, 256);
+  return &pool;
+}
+
+void* nas::operator new(size_t sz)
+{
+  return get_nas_pool()->allocate_node(sz);
+}
+
+void nas::operator delete(void* p)
+{
+  get_nas_pool()->deallocate_node(p);
+}
+
 void nas::reset()
 {
   m_emm_ctx = {};
@@ -20,6 +20,7 @@
  */
 
 #include "srsepc/hdr/mme/s1ap.h"
+#include "srsepc/hdr/mme/mme.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/bcd_helpers.h"
 #include "srsran/common/liblte_security.h"
@@ -33,7 +34,7 @@ namespace srsepc {
 s1ap*           s1ap::m_instance    = NULL;
 pthread_mutex_t s1ap_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-s1ap::s1ap() : m_s1mme(-1), m_next_mme_ue_s1ap_id(1), m_mme_gtpc(NULL) {}
+s1ap::s1ap() : m_s1mme(-1), m_mme_gtpc(NULL) {}
 
 s1ap::~s1ap()
 {
@@ -70,6 +71,11 @@ int s1ap::init(const s1ap_args_t& s1ap_args)
   std::uniform_int_distribution<uint32_t> distr(0, std::numeric_limits<uint32_t>::max());
   m_next_m_tmsi = distr(generator);
 
+  // MME-UE-S1AP-ID 0 is not valid, so the ids of each shard start from its index plus the number of shards
+  m_mme            = mme::get_instance();
+  m_nof_nas_shards = m_mme->get_nof_nas_shards();
+  m_next_mme_ue_s1ap_id.assign(m_nof_nas_shards, 1);
+
   // Get pointer to the HSS
   m_hss = hss::get_instance();
 
@@ -108,20 +114,20 @@ void s1ap::stop()
   if (m_s1mme != -1) {
     close(m_s1mme);
   }
-  std::map<uint16_t, enb_ctx_t*>::iterator enb_it = m_active_enbs.begin();
+  auto enb_it = m_active_enbs.begin();
   while (enb_it != m_active_enbs.end()) {
     m_logger.info("Deleting eNB context. eNB Id: 0x%x", enb_it->second->enb_id);
     srsran::console("Deleting eNB context. eNB Id: 0x%x\n", enb_it->second->enb_id);
     delete enb_it->second;
-    m_active_enbs.erase(enb_it++);
+    enb_it = m_active_enbs.erase(enb_it);
   }
 
-  std::map<uint64_t, nas*>::iterator ue_it = m_imsi_to_nas_ctx.begin();
+  auto ue_it = m_imsi_to_nas_ctx.begin();
   while (ue_it != m_imsi_to_nas_ctx.end()) {
     m_logger.info("Deleting UE EMM context. IMSI: %015" PRIu64 "", ue_it->first);
     srsran::console("Deleting UE EMM context. IMSI: %015" PRIu64 "\n", ue_it->first);
     delete ue_it->second;
-    m_imsi_to_nas_ctx.erase(ue_it++);
+    ue_it = m_imsi_to_nas_ctx.erase(ue_it);
   }
 
   // Cleanup message handlers
@@ -143,7 +149,8 @@ int s1ap::get_s1_mme()
 
 uint32_t s1ap::get_next_mme_ue_s1ap_id()
 {
-  return m_next_mme_ue_s1ap_id++;
+  uint32_t shard = mme::get_current_nas_shard();
+  return shard + m_nof_nas_shards * m_next_mme_ue_s1ap_id[shard]++;
 }
 
 int s1ap::enb_listen()
@@ -223,6 +230,7 @@ bool s1ap::s1ap_tx_pdu(const asn1::s1ap::s1ap_pdu_c& pdu, struct sctp_sndrcvinfo
   }
 
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(buf->msg, buf->N_bytes);
   }
 
@@ -233,21 +241,79 @@ void s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo
 {
   // Save PCAP
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(pdu->msg, pdu->N_bytes);
   }
 
   // Get PDU type
-  s1ap_pdu_t     rx_pdu;
-  asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  std::unique_ptr<rx_job_t> job(new rx_job_t);
+  asn1::cbit_ref            bref(pdu->msg, pdu->N_bytes);
+  if (job->pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
     m_logger.error("Failed to unpack received PDU");
     return;
   }
+  job->enb_sri = *enb_sri;
+
+  // The UE associated messages are handled in the NAS shard of the UE, and the rest in the MME thread
+  int shard = get_nas_shard(job->pdu);
+  if (shard < 0 or not m_mme->has_nas_workers()) {
+    handle_rx_job(std::move(job));
+    return;
+  }
+  m_mme->run_in_nas_shard(shard, [this, job = std::move(job)]() mutable { handle_rx_job(std::move(job)); });
+}
+
+int s1ap::get_nas_shard(const s1ap_pdu_t& pdu)
+{
+  using init_msg_type_opts_t           = asn1::s1ap::s1ap_elem_procs_o::init_msg_c::types_opts;
+  using successful_outcome_type_opts_t = asn1::s1ap::s1ap_elem_procs_o::successful_outcome_c::types_opts;
+
+  if (pdu.type().value == s1ap_pdu_t::types_opts::init_msg) {
+    const asn1::s1ap::init_msg_s& msg = pdu.init_msg();
+    switch (msg.value.type().value) {
+      case init_msg_type_opts_t::init_ue_msg:
+        // The UE is only known once the NAS message is decoded, which is left to the shard. Spread the new UEs
+        return m_next_new_ue_shard++ % m_nof_nas_shards;
+      case init_msg_type_opts_t::ul_nas_transport:
+        return get_nas_shard_from_mme_ue_s1ap_id(msg.value.ul_nas_transport()->mme_ue_s1ap_id.value.value);
+      case init_msg_type_opts_t::ue_context_release_request:
+        return get_nas_shard_from_mme_ue_s1ap_id(msg.value.ue_context_release_request()->mme_ue_s1ap_id.value.value);
+      default:
+        return -1;
+    }
+  }
+  if (pdu.type().value == s1ap_pdu_t::types_opts::successful_outcome) {
+    const asn1::s1ap::successful_outcome_s& msg = pdu.successful_outcome();
+    switch (msg.value.type().value) {
+      case successful_outcome_type_opts_t::init_context_setup_resp:
+        return get_nas_shard_from_mme_ue_s1ap_id(msg.value.init_context_setup_resp()->mme_ue_s1ap_id.value.value);
+      case successful_outcome_type_opts_t::ue_context_release_complete:
+        return get_nas_shard_from_mme_ue_s1ap_id(msg.value.ue_context_release_complete()->mme_ue_s1ap_id.value.value);
+      default:
+        return -1;
+    }
+  }
+  return -1;
+}
+
+void s1ap::handle_rx_job(std::unique_ptr<rx_job_t> job)
+{
+  s1ap_pdu_t& rx_pdu = job->pdu;
+
+  // An Initial UE Message of a known UE is moved to the shard of its context
+  uint32_t owner;
+  if (m_mme->has_nas_workers() and rx_pdu.type().value == s1ap_pdu_t::types_opts::init_msg and
+      rx_pdu.init_msg().value.type().value == asn1::s1ap::s1ap_elem_procs_o::init_msg_c::types_opts::init_ue_msg and
+      m_s1ap_nas_transport->find_initial_ue_message_shard(rx_pdu.init_msg().value.init_ue_msg(), &owner) and
+      owner != mme::get_current_nas_shard()) {
+    m_mme->run_in_nas_shard(owner, [this, job = std::move(job)]() mutable { handle_rx_job(std::move(job)); });
+    return;
+  }
 
   switch (rx_pdu.type().value) {
     case s1ap_pdu_t::types_opts::init_msg:
       m_logger.info("Received Initiating PDU");
-      handle_initiating_message(rx_pdu.init_msg(), enb_sri);
+      handle_initiating_message(rx_pdu.init_msg(), &job->enb_sri);
       break;
     case s1ap_pdu_t::types_opts::successful_outcome:
       m_logger.info("Received Succeseful Outcome PDU");
@@ -317,6 +383,8 @@ void s1ap::add_new_enb_ctx(const enb_ctx_t& enb_ctx, const struct sctp_sndrcvinf
   std::set<uint32_t> ue_set;
   enb_ctx_t*         enb_ptr = new enb_ctx_t;
   *enb_ptr                   = enb_ctx;
+
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
   m_active_enbs.emplace(enb_ptr->enb_id, enb_ptr);
   m_sctp_to_enb_id.emplace(enb_sri->sinfo_assoc_id, enb_ptr->enb_id);
   m_enb_assoc_to_ue_ids.emplace(enb_sri->sinfo_assoc_id, ue_set);
@@ -324,7 +392,8 @@ void s1ap::add_new_enb_ctx(const enb_ctx_t& enb_ctx, const struct sctp_sndrcvinf
 
 enb_ctx_t* s1ap::find_enb_ctx(uint16_t enb_id)
 {
-  std::map<uint16_t, enb_ctx_t*>::iterator it = m_active_enbs.find(enb_id);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto                        it = m_active_enbs.find(enb_id);
   if (it == m_active_enbs.end()) {
     return nullptr;
   } else {
@@ -334,13 +403,15 @@ enb_ctx_t* s1ap::find_enb_ctx(uint16_t enb_id)
 
 void s1ap::delete_enb_ctx(int32_t assoc_id)
 {
-  std::map<int32_t, uint16_t>::iterator it_assoc = m_sctp_to_enb_id.find(assoc_id);
-  uint16_t                              enb_id   = it_assoc->second;
-
-  std::map<uint16_t, enb_ctx_t*>::iterator it_ctx = m_active_enbs.find(enb_id);
-  if (it_ctx == m_active_enbs.end() || it_assoc == m_sctp_to_enb_id.end()) {
-    m_logger.error("Could not find eNB to delete. Association: %d", assoc_id);
-    return;
+  uint16_t enb_id;
+  {
+    std::lock_guard<std::mutex> lock(m_ctx_mutex);
+    auto                        it_assoc = m_sctp_to_enb_id.find(assoc_id);
+    if (it_assoc == m_sctp_to_enb_id.end() || m_active_enbs.count(it_assoc->second) == 0) {
+      m_logger.error("Could not find eNB to delete. Association: %d", assoc_id);
+      return;
+    }
+    enb_id = it_assoc->second;
   }
 
   m_logger.info("Deleting eNB context. eNB Id: 0x%x", enb_id);
@@ -350,22 +421,36 @@ void s1ap::delete_enb_ctx(int32_t assoc_id)
   release_ues_ecm_ctx_in_enb(assoc_id);
 
   // Delete eNB
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto                        it_ctx = m_active_enbs.find(enb_id);
   delete it_ctx->second;
   m_active_enbs.erase(it_ctx);
-  m_sctp_to_enb_id.erase(it_assoc);
+  m_sctp_to_enb_id.erase(assoc_id);
   return;
 }
 
+std::vector<std::pair<uint16_t, struct sctp_sndrcvinfo> > s1ap::get_active_enb_sris()
+{
+  std::vector<std::pair<uint16_t, struct sctp_sndrcvinfo> > enbs;
+  std::lock_guard<std::mutex>                               lock(m_ctx_mutex);
+  enbs.reserve(m_active_enbs.size());
+  for (const auto& enb : m_active_enbs) {
+    enbs.emplace_back(enb.second->enb_id, enb.second->sri);
+  }
+  return enbs;
+}
+
 // UE Context Management
 bool s1ap::add_nas_ctx_to_imsi_map(nas* nas_ctx)
 {
-  std::map<uint64_t, nas*>::iterator ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto                        ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
   if (ctx_it != m_imsi_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    auto ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
     if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with IMSI does not match context identified by MME UE S1AP Id.");
       return false;
@@ -382,13 +467,14 @@ bool s1ap::add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)
     m_logger.error("Could not add UE context to MME UE S1AP map. MME UE S1AP ID 0 is not valid.");
     return false;
   }
-  std::map<uint32_t, nas*>::iterator ctx_it = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto                        ctx_it = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
   if (ctx_it != m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     m_logger.error("UE Context already exists. MME UE S1AP Id %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
   if (nas_ctx->m_emm_ctx.imsi != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
+    auto ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
     if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
       m_logger.error("Context identified with MME UE S1AP Id does not match context identified by IMSI.");
       return false;
@@ -401,13 +487,13 @@ bool s1ap::add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)
 
 bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 {
-  std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto                        ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
   if (ues_in_enb == m_enb_assoc_to_ue_ids.end()) {
     m_logger.error("Could not find eNB from eNB SCTP association %d", enb_assoc);
     return false;
   }
-  std::set<uint32_t>::iterator ue_id = ues_in_enb->second.find(mme_ue_s1ap_id);
-  if (ue_id != ues_in_enb->second.end()) {
+  if (ues_in_enb->second.count(mme_ue_s1ap_id) > 0) {
     m_logger.error("UE with MME UE S1AP Id already exists %d", mme_ue_s1ap_id);
     return false;
   }
@@ -418,7 +504,8 @@ bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 
 nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 {
-  std::map<uint32_t, nas*>::iterator it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto                        it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
   if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
     return NULL;
   } else {
@@ -428,7 +515,8 @@ nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 
 nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
 {
-  std::map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto                        it = m_imsi_to_nas_ctx.find(imsi);
   if (it == m_imsi_to_nas_ctx.end()) {
     return NULL;
   } else {
@@ -436,32 +524,79 @@ nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
   }
 }
 
+bool s1ap::find_nas_shard_from_imsi(uint64_t imsi, uint32_t* shard)
+{
+  // The contexts are deleted after being removed from the map, so the shard is read under the lock
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto                        it = m_imsi_to_nas_ctx.find(imsi);
+  if (it == m_imsi_to_nas_ctx.end()) {
+    return false;
+  }
+  *shard = it->second->m_shard;
+  return true;
+}
+
+bool s1ap::find_nas_shard_from_m_tmsi(uint32_t m_tmsi, uint32_t* shard)
+{
+  uint64_t imsi;
+  {
+    std::lock_guard<std::mutex> lock(m_ctx_mutex);
+    auto                        it = m_tmsi_to_imsi.find(m_tmsi);
+    if (it == m_tmsi_to_imsi.end()) {
+      return false;
+    }
+    imsi = it->second;
+  }
+  return find_nas_shard_from_imsi(imsi, shard);
+}
+
+uint32_t s1ap::get_nas_shard_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id) const
+{
+  return mme_ue_s1ap_id % m_nof_nas_shards;
+}
+
 void s1ap::release_ues_ecm_ctx_in_enb(int32_t enb_assoc)
 {
   srsran::console("Releasing UEs context\n");
-  std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
-  std::set<uint32_t>::iterator                     ue_id      = ues_in_enb->second.begin();
-  if (ue_id == ues_in_enb->second.end()) {
-    srsran::console("No UEs to be released\n");
-  } else {
-    while (ue_id != ues_in_enb->second.end()) {
-      std::map<uint32_t, nas*>::iterator nas_ctx = m_mme_ue_s1ap_id_to_nas_ctx.find(*ue_id);
-      emm_ctx_t*                         emm_ctx = &nas_ctx->second->m_emm_ctx;
-      ecm_ctx_t*                         ecm_ctx = &nas_ctx->second->m_ecm_ctx;
-
-      m_logger.info(
-          "Releasing UE context. IMSI: %015" PRIu64 ", UE-MME S1AP Id: %d", emm_ctx->imsi, ecm_ctx->mme_ue_s1ap_id);
-      if (emm_ctx->state == EMM_STATE_REGISTERED) {
-        m_mme_gtpc->send_delete_session_request(emm_ctx->imsi);
-        emm_ctx->state = EMM_STATE_DEREGISTERED;
-      }
-      srsran::console("Releasing UE ECM context. UE-MME S1AP Id: %d\n", ecm_ctx->mme_ue_s1ap_id);
-      ecm_ctx->state          = ECM_STATE_IDLE;
-      ecm_ctx->mme_ue_s1ap_id = 0;
-      ecm_ctx->enb_ue_s1ap_id = 0;
-      ues_in_enb->second.erase(ue_id++);
+  std::set<uint32_t> ue_ids;
+  {
+    std::lock_guard<std::mutex> lock(m_ctx_mutex);
+    auto                        ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
+    if (ues_in_enb != m_enb_assoc_to_ue_ids.end()) {
+      ue_ids.swap(ues_in_enb->second);
     }
   }
+  if (ue_ids.empty()) {
+    srsran::console("No UEs to be released\n");
+    return;
+  }
+  // Each UE context is released by its own shard
+  for (uint32_t mme_ue_s1ap_id : ue_ids) {
+    m_mme->run_in_nas_shard(get_nas_shard_from_mme_ue_s1ap_id(mme_ue_s1ap_id),
+                            [this, mme_ue_s1ap_id]() { release_ue_ecm_ctx_in_lost_enb(mme_ue_s1ap_id); });
+  }
+}
+
+void s1ap::release_ue_ecm_ctx_in_lost_enb(uint32_t mme_ue_s1ap_id)
+{
+  nas* nas_ctx = find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id);
+  if (nas_ctx == nullptr) {
+    m_logger.warning("Could not find UE context to release. UE-MME S1AP Id: %d", mme_ue_s1ap_id);
+    return;
+  }
+  emm_ctx_t* emm_ctx = &nas_ctx->m_emm_ctx;
+  ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
+
+  m_logger.info(
+      "Releasing UE context. IMSI: %015" PRIu64 ", UE-MME S1AP Id: %d", emm_ctx->imsi, ecm_ctx->mme_ue_s1ap_id);
+  if (emm_ctx->state == EMM_STATE_REGISTERED) {
+    m_mme_gtpc->send_delete_session_request(emm_ctx->imsi);
+    emm_ctx->state = EMM_STATE_DEREGISTERED;
+  }
+  srsran::console("Releasing UE ECM context. UE-MME S1AP Id: %d\n", ecm_ctx->mme_ue_s1ap_id);
+  ecm_ctx->state          = ECM_STATE_IDLE;
+  ecm_ctx->mme_ue_s1ap_id = 0;
+  ecm_ctx->enb_ue_s1ap_id = 0;
 }
 
 bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
@@ -473,22 +608,24 @@ bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
   }
   ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
 
-  // Delete UE within eNB UE set
-  std::map<int32_t, uint16_t>::iterator it = m_sctp_to_enb_id.find(ecm_ctx->enb_sri.sinfo_assoc_id);
-  if (it == m_sctp_to_enb_id.end()) {
-    m_logger.error("Could not find eNB for UE release request.");
-    return false;
-  }
-  uint16_t                                         enb_id = it->second;
-  std::map<int32_t, std::set<uint32_t> >::iterator ue_set = m_enb_assoc_to_ue_ids.find(ecm_ctx->enb_sri.sinfo_assoc_id);
-  if (ue_set == m_enb_assoc_to_ue_ids.end()) {
-    m_logger.error("Could not find the eNB's UEs.");
-    return false;
-  }
-  ue_set->second.erase(mme_ue_s1ap_id);
+  {
+    // Delete UE within eNB UE set
+    std::lock_guard<std::mutex> lock(m_ctx_mutex);
+    auto                        it = m_sctp_to_enb_id.find(ecm_ctx->enb_sri.sinfo_assoc_id);
+    if (it == m_sctp_to_enb_id.end()) {
+      m_logger.error("Could not find eNB for UE release request.");
+      return false;
+    }
+    auto ue_set = m_enb_assoc_to_ue_ids.find(ecm_ctx->enb_sri.sinfo_assoc_id);
+    if (ue_set == m_enb_assoc_to_ue_ids.end()) {
+      m_logger.error("Could not find the eNB's UEs.");
+      return false;
+    }
+    ue_set->second.erase(mme_ue_s1ap_id);
 
-  // Release UE ECM context
-  m_mme_ue_s1ap_id_to_nas_ctx.erase(mme_ue_s1ap_id);
+    // Release UE ECM context
+    m_mme_ue_s1ap_id_to_nas_ctx.erase(mme_ue_s1ap_id);
+  }
   ecm_ctx->state          = ECM_STATE_IDLE;
   ecm_ctx->mme_ue_s1ap_id = 0;
   ecm_ctx->enb_ue_s1ap_id = 0;
@@ -499,10 +636,38 @@ bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
 
 bool s1ap::delete_ue_ctx(uint64_t imsi)
 {
-  nas* nas_ctx = find_nas_ctx_from_imsi(imsi);
-  if (nas_ctx == NULL) {
-    m_logger.info("Cannot delete UE context, UE not found. IMSI: %" PRIu64 "", imsi);
-    return false;
+  nas* nas_ctx;
+  {
+    std::lock_guard<std::mutex> lock(m_ctx_mutex);
+    auto                        it = m_imsi_to_nas_ctx.find(imsi);
+    if (it == m_imsi_to_nas_ctx.end()) {
+      m_logger.info("Cannot delete UE context, UE not found. IMSI: %" PRIu64 "", imsi);
+      return false;
+    }
+    nas_ctx = it->second;
+    m_imsi_to_nas_ctx.erase(it);
+  }
+
+  // A context of another shard may be in use. It is no longer found by its IMSI, and its shard deletes it
+  uint32_t owner = nas_ctx->m_shard;
+  if (owner != mme::get_current_nas_shard()) {
+    m_mme->run_in_nas_shard(owner, [this, nas_ctx]() { delete_nas_ctx(nas_ctx); });
+    m_logger.info("Deleting UE Context in NAS shard %d.", owner);
+    return true;
+  }
+
+  delete_nas_ctx(nas_ctx);
+  m_logger.info("Deleted UE Context.");
+  return true;
+}
+
+void s1ap::delete_nas_ctx(nas* nas_ctx)
+{
+  // The NAS timers of the UE run in this shard, and would otherwise expire for a UE that no longer exists. They are
+  // keyed by IMSI, so they are left alone if a new context of the same UE was created meanwhile
+  uint64_t imsi = nas_ctx->m_emm_ctx.imsi;
+  if (find_nas_ctx_from_imsi(imsi) == nullptr and m_mme->is_nas_timer_running(T_3413, imsi)) {
+    m_mme->remove_nas_timer(T_3413, imsi);
   }
 
   // Make sure to release ECM ctx
@@ -511,30 +676,26 @@ bool s1ap::delete_ue_ctx(uint64_t imsi)
   }
 
   // Delete UE context
-  m_imsi_to_nas_ctx.erase(imsi);
   delete nas_ctx;
-  m_logger.info("Deleted UE Context.");
-  return true;
 }
 
 // UE Bearer Managment
 void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 {
-  std::map<uint64_t, nas*>::iterator ue_ctx_it = m_imsi_to_nas_ctx.find(imsi);
-  if (ue_ctx_it == m_imsi_to_nas_ctx.end()) {
+  nas* nas_ctx = find_nas_ctx_from_imsi(imsi);
+  if (nas_ctx == nullptr) {
     m_logger.error("Could not activate EPS bearer: Could not find UE context");
     return;
   }
   // Make sure NAS is active
-  uint32_t                           mme_ue_s1ap_id = ue_ctx_it->second->m_ecm_ctx.mme_ue_s1ap_id;
-  std::map<uint32_t, nas*>::iterator it             = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
-  if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
+  uint32_t mme_ue_s1ap_id = nas_ctx->m_ecm_ctx.mme_ue_s1ap_id;
+  if (find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id) == nullptr) {
     m_logger.error("Could not activate EPS bearer: ECM context seems to be missing");
     return;
   }
 
-  ecm_ctx_t* ecm_ctx = &ue_ctx_it->second->m_ecm_ctx;
-  esm_ctx_t* esm_ctx = &ue_ctx_it->second->m_esm_ctx[ebi];
+  ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
+  esm_ctx_t* esm_ctx = &nas_ctx->m_esm_ctx[ebi];
   if (esm_ctx->state != ERAB_CTX_SETUP) {
     m_logger.error(
         "Could not be activate EPS Bearer, bearer in wrong state: MME S1AP Id %d, EPS Bearer id %d, state %d",
@@ -557,7 +718,8 @@ void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 
 uint32_t s1ap::allocate_m_tmsi(uint64_t imsi)
 {
-  uint32_t m_tmsi = m_next_m_tmsi;
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  uint32_t                    m_tmsi = m_next_m_tmsi;
   m_next_m_tmsi   = (m_next_m_tmsi + 1) % UINT32_MAX;
 
   m_tmsi_to_imsi.emplace(m_tmsi, imsi);
@@ -567,7 +729,8 @@ uint32_t s1ap::allocate_m_tmsi(uint64_t imsi)
 
 uint64_t s1ap::find_imsi_from_m_tmsi(uint32_t m_tmsi)
 {
-  std::map<uint32_t, uint64_t>::iterator it = m_tmsi_to_imsi.find(m_tmsi);
+  std::lock_guard<std::mutex> lock(m_ctx_mutex);
+  auto                        it = m_tmsi_to_imsi.find(m_tmsi);
   if (it != m_tmsi_to_imsi.end()) {
     m_logger.debug("Found IMSI %015" PRIu64 " from M-TMSI 0x%x", it->second, m_tmsi);
     return it->second;
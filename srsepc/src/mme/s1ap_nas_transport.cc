@@ -141,6 +141,45 @@ bool s1ap_nas_transport::handle_initial_ue_message(const asn1::s1ap::init_ue_msg
   return err;
 }
 
+bool s1ap_nas_transport::find_initial_ue_message_shard(const asn1::s1ap::init_ue_msg_s& init_ue, uint32_t* shard)
+{
+  if (init_ue->s_tmsi_present) {
+    uint32_t m_tmsi = 0;
+    srsran::uint8_to_uint32(init_ue->s_tmsi.value.m_tmsi.data(), &m_tmsi);
+    if (m_s1ap->find_nas_shard_from_m_tmsi(m_tmsi, shard)) {
+      return true;
+    }
+  }
+
+  // Attach requests without S-TMSI identify the UE in the NAS message
+  uint8_t                      pd, msg_type;
+  srsran::unique_byte_buffer_t nas_msg = srsran::make_byte_buffer();
+  if (nas_msg == nullptr) {
+    return false;
+  }
+  memcpy(nas_msg->msg, init_ue->nas_pdu.value.data(), init_ue->nas_pdu.value.size());
+  nas_msg->N_bytes = init_ue->nas_pdu.value.size();
+  liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get(), &pd, &msg_type);
+  if (msg_type != LIBLTE_MME_MSG_TYPE_ATTACH_REQUEST) {
+    return false;
+  }
+  LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT attach_req = {};
+  if (liblte_mme_unpack_attach_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get(), &attach_req) != LIBLTE_SUCCESS) {
+    return false;
+  }
+  if (attach_req.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI) {
+    uint64_t imsi = 0;
+    for (int i = 0; i <= 14; i++) {
+      imsi += attach_req.eps_mobile_id.imsi[i] * std::pow(10, 14 - i);
+    }
+    return m_s1ap->find_nas_shard_from_imsi(imsi, shard);
+  }
+  if (attach_req.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI) {
+    return m_s1ap->find_nas_shard_from_m_tmsi(attach_req.eps_mobile_id.guti.m_tmsi, shard);
+  }
+  return false;
+}
+
 bool s1ap_nas_transport::handle_uplink_nas_transport(const asn1::s1ap::ul_nas_transport_s& ul_xport,
                                                      struct sctp_sndrcvinfo*               enb_sri)
 {
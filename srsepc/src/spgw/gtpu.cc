@@ -83,16 +83,40 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
 
 void spgw::gtpu::stop()
 {
+  for (std::unique_ptr<up_worker>& w : m_workers) {
+    w->stop();
+  }
+  m_workers.clear();
+
   // Clean up SGi interface
+  for (uint32_t i = 1; i < m_sgi_queues.size(); i++) {
+    close(m_sgi_queues[i]);
+  }
+  m_sgi_queues.clear();
   if (m_sgi_up) {
     close(m_sgi);
   }
   // Clean up S1-U socket
+  for (uint32_t i = 1; i < m_s1u_socks.size(); i++) {
+    close(m_s1u_socks[i]);
+  }
+  m_s1u_socks.clear();
   if (m_s1u_up) {
+    flush_s1u_pdus(m_s1u_tx);
     close(m_s1u);
   }
 }
 
+void spgw::gtpu::start_workers()
+{
+  for (uint32_t i = 0; i < m_nof_up_workers; i++) {
+    m_workers.emplace_back(new up_worker(this, i, m_sgi_queues[i], m_s1u_socks[i]));
+  }
+  if (m_nof_up_workers > 0) {
+    m_logger.info("Started %d user plane workers", m_nof_up_workers);
+  }
+}
+
 int spgw::gtpu::init_sgi(spgw_args_t* args)
 {
   struct ifreq ifr;
@@ -101,6 +125,7 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   if (m_sgi_up) {
     return SRSRAN_ERROR_ALREADY_STARTED;
   }
+  m_nof_up_workers = args->nof_up_workers;
 
   // Construct the TUN device
   m_sgi = open("/dev/net/tun", O_RDWR);
@@ -112,6 +137,10 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
 
   memset(&ifr, 0, sizeof(ifr));
   ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+  if (m_nof_up_workers > 1) {
+    // The kernel spreads the downlink flows over the queues of the device, one per user plane worker
+    ifr.ifr_flags |= IFF_MULTI_QUEUE;
+  }
   strncpy(
       ifr.ifr_ifrn.ifrn_name, args->sgi_if_name.c_str(), std::min(args->sgi_if_name.length(), (size_t)(IFNAMSIZ - 1)));
   ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = '\0';
@@ -168,7 +197,31 @@ int spgw::gtpu::init_sgi(spgw_args_t* args)
   }
 
   close(sgi_sock);
+
+  // The SPGW reads all the packets pending in the SGi interface in one go
+  if (fcntl(m_sgi, F_SETFL, fcntl(m_sgi, F_GETFL) | O_NONBLOCK) < 0) {
+    m_logger.error("Failed to set the TUN device non-blocking: %s", strerror(errno));
+    close(m_sgi);
+    return SRSRAN_ERROR_CANT_START;
+  }
   m_sgi_up = true;
+
+  // Attach the other queues of the TUN device
+  m_sgi_queues.push_back(m_sgi);
+  struct ifreq queue_ifr = {};
+  queue_ifr.ifr_flags    = IFF_TUN | IFF_NO_PI | IFF_MULTI_QUEUE;
+  memcpy(queue_ifr.ifr_ifrn.ifrn_name, ifr.ifr_ifrn.ifrn_name, IFNAMSIZ);
+  for (uint32_t i = 1; i < m_nof_up_workers; i++) {
+    int fd = open("/dev/net/tun", O_RDWR | O_NONBLOCK);
+    if (fd < 0 or ioctl(fd, TUNSETIFF, &queue_ifr) < 0) {
+      m_logger.error("Failed to open TUN device queue %d: %s", i, strerror(errno));
+      if (fd >= 0) {
+        close(fd);
+      }
+      return SRSRAN_ERROR_CANT_START;
+    }
+    m_sgi_queues.push_back(fd);
+  }
   m_logger.info("Initialized SGi interface");
   return SRSRAN_SUCCESS;
 }
@@ -192,10 +245,31 @@ int spgw::gtpu::init_s1u(spgw_args_t* args)
   }
   m_s1u_addr.sin_port        = htons(GTPU_RX_PORT);
 
+  // Each user plane worker has its own S1-U socket. The kernel spreads the uplink flows over them
+  int reuse = 1;
+  if (m_nof_up_workers > 1 and setsockopt(m_s1u, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0) {
+    m_logger.error("Failed to set SO_REUSEPORT: %s", strerror(errno));
+    return SRSRAN_ERROR_CANT_START;
+  }
   if (bind(m_s1u, (struct sockaddr*)&m_s1u_addr, sizeof(struct sockaddr_in))) {
     m_logger.error("Failed to bind socket: %s", strerror(errno));
     return SRSRAN_ERROR_CANT_START;
   }
+  m_s1u_tx.set_fd(m_s1u);
+
+  m_s1u_socks.push_back(m_s1u);
+  for (uint32_t i = 1; i < m_nof_up_workers; i++) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0 or setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0 or
+        bind(fd, (struct sockaddr*)&m_s1u_addr, sizeof(struct sockaddr_in))) {
+      m_logger.error("Failed to open S1-U socket %d: %s", i, strerror(errno));
+      if (fd >= 0) {
+        close(fd);
+      }
+      return SRSRAN_ERROR_CANT_START;
+    }
+    m_s1u_socks.push_back(fd);
+  }
   m_logger.info("S1-U socket = %d", m_s1u);
   m_logger.info("S1-U IP = %s, Port = %d ", inet_ntoa(m_s1u_addr.sin_addr), ntohs(m_s1u_addr.sin_port));
 
@@ -203,16 +277,47 @@ int spgw::gtpu::init_s1u(spgw_args_t* args)
   return SRSRAN_SUCCESS;
 }
 
-void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
+void spgw::gtpu::handle_sgi_rx(int sgi, srsran::udp_tx_batch& s1u_tx)
+{
+  size_t buf_len = SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET;
+
+  /*
+   * SGi messages may need to be queued when waiting for UE Paging procedure.
+   * For this reason, buffers for SGi pdus are allocated here and deallocated
+   * at the gtpu::send_s1u_pdu() when the PDU is sent, at handle_sgi_pdu() when the PDU is dropped or at
+   * gtpc::free_all_queued_packets, which is called when the Downlink Data Notification
+   * procedure fails (see handle_downlink_data_notification_acknowledgment and
+   * handle_downlink_data_notification_failure)
+   */
+  // The SGi interface is non-blocking. Read the pending packets, so their S1-U PDUs are sent in one batch
+  for (uint32_t i = 0; i < srsran::udp_tx_batch::max_batch_size; i++) {
+    srsran::unique_byte_buffer_t sgi_msg = srsran::make_byte_buffer("spgw::gtpu::handle_sgi_rx");
+    if (sgi_msg == nullptr) {
+      break;
+    }
+    ssize_t n_read = read(sgi, sgi_msg->msg, buf_len);
+    if (n_read <= 0) {
+      break;
+    }
+    m_logger.debug("Message received at SPGW: SGi Message");
+    sgi_msg->N_bytes = n_read;
+    handle_sgi_pdu(std::move(sgi_msg), s1u_tx);
+  }
+}
+
+void spgw::gtpu::handle_s1u_rx(int s1u, srsran::udp_rx_batch& s1u_rx, int sgi)
 {
-  bool usr_found = false;
-  bool ctr_found = false;
-
-  std::map<uint32_t, srsran::gtpc_f_teid_ie>::iterator gtpu_fteid_it;
-  std::map<in_addr_t, uint32_t>::iterator              gtpc_teid_it;
-  srsran::gtpc_f_teid_ie                               enb_fteid;
-  uint32_t                                             spgw_teid;
-  struct iphdr*                                        iph = (struct iphdr*)msg->msg;
+  int n_recv = s1u_rx.recv(s1u);
+  for (int i = 0; i < n_recv; i++) {
+    m_logger.debug("Message received at SPGW: S1-U Message");
+    handle_s1u_pdu(s1u_rx.get_pdu(i), sgi);
+  }
+}
+
+void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg, srsran::udp_tx_batch& s1u_tx)
+{
+  ue_tunnel_table::ue_tunnel_t tunnel;
+  struct iphdr*                iph = (struct iphdr*)msg->msg;
   m_logger.debug("Received SGi PDU. Bytes %d", msg->N_bytes);
 
   if (iph->version != 4) {
@@ -225,50 +330,52 @@ void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
   }
 
   // Logging PDU info
-  m_logger.debug("SGi PDU -- IP version %d, Total length %d", int(iph->version), ntohs(iph->tot_len));
-  fmt::memory_buffer buffer;
-  srsran::gtpu_ntoa(buffer, iph->saddr);
-  m_logger.debug("SGi PDU -- IP src addr %s", srsran::to_c_str(buffer));
-  buffer.clear();
-  srsran::gtpu_ntoa(buffer, iph->daddr);
-  m_logger.debug("SGi PDU -- IP dst addr %s", srsran::to_c_str(buffer));
+  if (m_logger.debug.enabled()) {
+    m_logger.debug("SGi PDU -- IP version %d, Total length %d", int(iph->version), ntohs(iph->tot_len));
+    fmt::memory_buffer buffer;
+    srsran::gtpu_ntoa(buffer, iph->saddr);
+    m_logger.debug("SGi PDU -- IP src addr %s", srsran::to_c_str(buffer));
+    buffer.clear();
+    srsran::gtpu_ntoa(buffer, iph->daddr);
+    m_logger.debug("SGi PDU -- IP dst addr %s", srsran::to_c_str(buffer));
+  }
 
   // Find user and control tunnel
-  gtpu_fteid_it = m_ip_to_usr_teid.find(iph->daddr);
-  if (gtpu_fteid_it != m_ip_to_usr_teid.end()) {
-    usr_found = true;
-    enb_fteid = gtpu_fteid_it->second;
+  if (m_tunnels.find(iph->daddr, tunnel) and tunnel.usr_active and tunnel.ctr_active) {
+    send_s1u_pdu(s1u_tx, tunnel.enb_fteid, std::move(msg));
+    return;
   }
-  gtpc_teid_it = m_ip_to_ctr_teid.find(iph->daddr);
-  if (gtpc_teid_it != m_ip_to_ctr_teid.end()) {
-    ctr_found = true;
-    spgw_teid = gtpc_teid_it->second;
+
+  // Paging accesses the GTP-C state. The tunnel may have been modified while waiting for the lock
+  std::lock_guard<std::mutex> lock(m_spgw->m_ctrl_mutex);
+  if (not m_tunnels.find(iph->daddr, tunnel)) {
+    tunnel = {};
   }
 
   // Handle SGi packet
-  if (usr_found == false && ctr_found == false) {
+  if (tunnel.usr_active == false && tunnel.ctr_active == false) {
     m_logger.debug("Packet for unknown UE.");
-  } else if (usr_found == false && ctr_found == true) {
+  } else if (tunnel.usr_active == false && tunnel.ctr_active == true) {
     m_logger.debug("Packet for attached UE that is not ECM connected.");
     m_logger.debug("Triggering Donwlink Notification Requset.");
-    m_gtpc->send_downlink_data_notification(spgw_teid);
-    m_gtpc->queue_downlink_packet(spgw_teid, std::move(msg));
+    m_gtpc->send_downlink_data_notification(tunnel.spgw_ctr_teid);
+    m_gtpc->queue_downlink_packet(tunnel.spgw_ctr_teid, std::move(msg));
     return;
-  } else if (usr_found == true && ctr_found == false) {
+  } else if (tunnel.usr_active == true && tunnel.ctr_active == false) {
     m_logger.error("User plane tunnel found without a control plane tunnel present.");
   } else {
-    send_s1u_pdu(enb_fteid, msg.get());
+    send_s1u_pdu(s1u_tx, tunnel.enb_fteid, std::move(msg));
   }
 }
 
-void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg)
+void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg, int sgi)
 {
   srsran::gtpu_header_t header;
   srsran::gtpu_read_header(msg, &header, m_logger);
 
   m_logger.debug("Received PDU from S1-U. Bytes=%d", msg->N_bytes);
   m_logger.debug("TEID 0x%x. Bytes=%d", header.teid, msg->N_bytes);
-  int n = write(m_sgi, msg->msg, msg->N_bytes);
+  int n = write(sgi, msg->msg, msg->N_bytes);
   if (n < 0) {
     m_logger.error("Could not write to TUN interface.");
   } else {
@@ -277,7 +384,9 @@ void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg)
   return;
 }
 
-void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg)
+void spgw::gtpu::send_s1u_pdu(srsran::udp_tx_batch&        s1u_tx,
+                              srsran::gtp_fteid_t          enb_fteid,
+                              srsran::unique_byte_buffer_t msg)
 {
   // Set eNB destination address
   struct sockaddr_in enb_addr;
@@ -292,27 +401,30 @@ void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer
   header.length       = msg->N_bytes;
   header.teid         = enb_fteid.teid;
 
-  m_logger.debug("User plane tunnel found SGi PDU. Forwarding packet to S1-U.");
-  m_logger.debug("eNB F-TEID -- eNB IP %s, eNB TEID 0x%x.", inet_ntoa(enb_addr.sin_addr), enb_fteid.teid);
+  if (m_logger.debug.enabled()) {
+    fmt::memory_buffer buffer;
+    srsran::gtpu_ntoa(buffer, enb_fteid.ipv4);
+    m_logger.debug("User plane tunnel found SGi PDU. Forwarding packet to S1-U.");
+    m_logger.debug("eNB F-TEID -- eNB IP %s, eNB TEID 0x%x.", srsran::to_c_str(buffer), enb_fteid.teid);
+  }
 
   // Write header into packet
-  int n;
-  if (!srsran::gtpu_write_header(&header, msg, m_logger)) {
+  if (!srsran::gtpu_write_header(&header, msg.get(), m_logger)) {
     m_logger.error("Error writing GTP-U header on PDU");
-    goto out;
+    return;
   }
 
-  // Send packet to destination
-  n = sendto(m_s1u, msg->msg, msg->N_bytes, 0, (struct sockaddr*)&enb_addr, sizeof(enb_addr));
-  if (n < 0) {
-    m_logger.error("Error sending packet to eNB");
-  } else if ((unsigned int)n != msg->N_bytes) {
-    m_logger.error("Mis-match between packet bytes and sent bytes: Sent: %d/%d", n, msg->N_bytes);
-  }
+  // Queue packet. It is sent to its destination at the end of the loop iteration of the calling thread
+  s1u_tx.push(std::move(msg), enb_addr);
+}
 
-out:
-  m_logger.debug("Deallocating packet after sending S1-U message");
-  return;
+void spgw::gtpu::flush_s1u_pdus(srsran::udp_tx_batch& s1u_tx)
+{
+  uint32_t nof_pdus = s1u_tx.size();
+  uint32_t nof_sent = s1u_tx.flush();
+  if (nof_sent != nof_pdus) {
+    m_logger.error("Error sending packets to eNB. Sent: %d/%d", nof_sent, nof_pdus);
+  }
 }
 
 void spgw::gtpu::send_all_queued_packets(srsran::gtp_fteid_t                       dw_user_fteid,
@@ -321,7 +433,7 @@ void spgw::gtpu::send_all_queued_packets(srsran::gtp_fteid_t
   m_logger.debug("Sending all queued packets");
   while (!pkt_queue.empty()) {
     srsran::unique_byte_buffer_t msg = std::move(pkt_queue.front());
-    send_s1u_pdu(dw_user_fteid, msg.get());
+    send_s1u_pdu(m_s1u_tx, dw_user_fteid, std::move(msg));
     pkt_queue.pop();
   }
   return;
@@ -340,17 +452,14 @@ bool spgw::gtpu::modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw
   srsran::gtpu_ntoa(buffer, dw_user_fteid.ipv4);
   m_logger.info("Downlink eNB addr %s, U-TEID 0x%x", srsran::to_c_str(buffer), dw_user_fteid.teid);
   m_logger.info("Uplink C-TEID: 0x%x", up_ctrl_teid);
-  m_ip_to_usr_teid[ue_ipv4] = dw_user_fteid;
-  m_ip_to_ctr_teid[ue_ipv4] = up_ctrl_teid;
+  m_tunnels.modify(ue_ipv4, dw_user_fteid, up_ctrl_teid);
   return true;
 }
 
 bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 {
   // Remove GTP-U connections, if any.
-  if (m_ip_to_usr_teid.count(ue_ipv4)) {
-    m_ip_to_usr_teid.erase(ue_ipv4);
-  } else {
+  if (not m_tunnels.delete_user_tunnel(ue_ipv4)) {
     m_logger.error("Could not find GTP-U Tunnel to delete.");
     return false;
   }
@@ -360,13 +469,56 @@ bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 bool spgw::gtpu::delete_gtpc_tunnel(in_addr_t ue_ipv4)
 {
   // Remove Ctrl TEID from IP mapping.
-  if (m_ip_to_ctr_teid.count(ue_ipv4)) {
-    m_ip_to_ctr_teid.erase(ue_ipv4);
-  } else {
+  if (not m_tunnels.delete_ctrl_tunnel(ue_ipv4)) {
     m_logger.error("Could not find GTP-C Tunnel info to delete.");
     return false;
   }
   return true;
 }
 
+/*
+ * User plane workers
+ */
+spgw::gtpu::up_worker::up_worker(gtpu* parent_, uint32_t id_, int sgi_, int s1u_) :
+  thread("SPGW-UP" + std::to_string(id_)), parent(parent_), id(id_), sgi(sgi_), s1u(s1u_), s1u_tx(parent_->m_logger)
+{
+  s1u_tx.set_fd(s1u);
+  running = true;
+  start();
+}
+
+void spgw::gtpu::up_worker::stop()
+{
+  if (running) {
+    running = false;
+    reactor.wakeup();
+    wait_thread_finish();
+  }
+}
+
+void spgw::gtpu::up_worker::run_thread()
+{
+  uint32_t reader_id = parent->m_tunnels.qsbr().register_reader();
+
+  reactor.add_fd(sgi, [this](int fd) { parent->handle_sgi_rx(fd, s1u_tx); });
+  reactor.add_fd(s1u, [this](int fd) { parent->handle_s1u_rx(fd, s1u_rx, sgi); });
+
+  while (running) {
+    // The worker holds no tunnel while it blocks, so it does not delay the updates from GTP-C
+    parent->m_tunnels.qsbr().go_offline(reader_id);
+    int n = reactor.wait_events();
+    parent->m_tunnels.qsbr().go_online(reader_id);
+    if (n == -1) {
+      parent->m_logger.error("Error from epoll_wait in user plane worker %d", id);
+    } else if (n > 0) {
+      reactor.handle_events();
+    }
+    parent->flush_s1u_pdus(s1u_tx);
+  }
+
+  reactor.rem_fd(sgi);
+  reactor.rem_fd(s1u);
+  parent->m_tunnels.qsbr().unregister_reader(reader_id);
+}
+
 } // namespace srsepc
@@ -0,0 +1,233 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <fstream>
+#include <getopt.h>
+#include <iomanip>
+#include <unistd.h>
+
+/*
+ * Measures the HSS startup time with the CSV user database and with the binary subscriber store, and the rate at which
+ * the HSS generates MILENAGE authentication vectors.
+ */
+
+static uint32_t nof_users    = 100000;
+static uint32_t nof_requests = 200000;
+
+using namespace srsepc;
+using bench_clock = std::chrono::steady_clock;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [ur]\n", prog);
+  printf("\t-u Number of users in the database [Default %d]\n", nof_users);
+  printf("\t-r Number of authentication requests [Default %d]\n", nof_requests);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "ur")) != -1) {
+    switch (opt) {
+      case 'u':
+        nof_users = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_requests = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static double elapsed_usec(bench_clock::time_point start)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(bench_clock::now() - start).count();
+}
+
+static uint64_t user_imsi(uint32_t idx)
+{
+  return 1010000000000ULL + idx;
+}
+
+static void write_csv(const std::string& filename)
+{
+  std::ofstream f(filename);
+  f << "# Name,Auth,IMSI,Key,OP_Type,OP/OPc,AMF,SQN,QCI,IP_alloc\n";
+  for (uint32_t i = 0; i < nof_users; i++) {
+    f << "ue" << i << ",mil," << std::setfill('0') << std::setw(15) << user_imsi(i)
+      << ",00112233445566778899aabbccdd" << std::hex << std::setw(4) << (i & 0xffff) << std::dec
+      << ",opc,63bfa50ee6523365ff14c1f45f88737d,8000,000000001234,7,dynamic\n";
+  }
+}
+
+static hss* start_hss(const std::string& csv_file, const std::string& bin_file, double& usec)
+{
+  hss_args_t args  = {};
+  args.db_file     = csv_file;
+  args.db_bin_file = bin_file;
+  args.mcc         = 0xf001;
+  args.mnc         = 0xff01;
+
+  bench_clock::time_point start = bench_clock::now();
+  hss*                    h     = hss::get_instance();
+  if (h->init(&args) != 0) {
+    return nullptr;
+  }
+  usec = elapsed_usec(start);
+  return h;
+}
+
+static void stop_hss(hss* h)
+{
+  h->stop();
+  hss::cleanup();
+}
+
+int test_startup(const std::string& csv_file, const std::string& bin_file)
+{
+  double usec = 0;
+  hss*   h    = start_hss(csv_file, "", usec);
+  TESTASSERT(h != nullptr);
+  printf("%-36s %10.1f ms\n", "Startup, CSV", usec / 1000);
+  stop_hss(h);
+
+  h = start_hss(csv_file, bin_file, usec);
+  TESTASSERT(h != nullptr);
+  printf("%-36s %10.1f ms\n", "Startup, CSV import to binary store", usec / 1000);
+  stop_hss(h);
+
+  h = start_hss(csv_file, bin_file, usec);
+  TESTASSERT(h != nullptr);
+  printf("%-36s %10.1f ms\n", "Startup, binary store", usec / 1000);
+
+  // All the users are found
+  uint8_t qci = 0;
+  for (uint32_t i = 0; i < nof_users; i++) {
+    TESTASSERT(h->gen_update_loc_answer(user_imsi(i), &qci));
+    TESTASSERT_EQ(7, qci);
+  }
+  stop_hss(h);
+  return SRSRAN_SUCCESS;
+}
+
+int test_milenage_functions()
+{
+  uint8_t k[16]   = {0x46, 0x5b, 0x5c, 0xe8, 0xb1, 0x99, 0xb4, 0x9f, 0xaa, 0x5f, 0x0a, 0x2e, 0xe2, 0x38, 0xa6, 0xbc};
+  uint8_t opc[16] = {0xcd, 0x63, 0xcb, 0x71, 0x95, 0x4a, 0x9f, 0x4e, 0x48, 0xa5, 0x99, 0x4e, 0x37, 0xa0, 0x2b, 0xaf};
+  srsran::security_milenage_vector_t v = {};
+
+  // One f1 and one f2345 call per vector, as the HSS used to do
+  bench_clock::time_point start = bench_clock::now();
+  for (uint32_t i = 0; i < nof_requests; i++) {
+    v.rand[0] = i;
+    srsran::security_milenage_f1(k, opc, v.rand, v.sqn, v.amf, v.mac_a);
+    srsran::security_milenage_f2345(k, opc, v.rand, v.res, v.ck, v.ik, v.ak);
+  }
+  printf("%-36s %10.0f vectors/s\n", "Milenage f1 + f2345", nof_requests / elapsed_usec(start) * 1e6);
+
+  start = bench_clock::now();
+  for (uint32_t i = 0; i < nof_requests; i++) {
+    v.rand[0] = i;
+    srsran::security_milenage_f12345_multi(k, opc, &v, 1);
+  }
+  printf("%-36s %10.0f vectors/s\n", "Milenage f12345", nof_requests / elapsed_usec(start) * 1e6);
+  return SRSRAN_SUCCESS;
+}
+
+int test_auth_vectors(const std::string& csv_file, const std::string& bin_file, uint32_t vectors_per_request)
+{
+  double usec = 0;
+  hss*   h    = start_hss(csv_file, bin_file, usec);
+  TESTASSERT(h != nullptr);
+
+  hss_auth_vector_t       vectors[hss::max_auth_vectors];
+  uint32_t                nof_vectors = 0;
+  bench_clock::time_point start       = bench_clock::now();
+  for (uint32_t i = 0; i < nof_requests; i += vectors_per_request) {
+    TESTASSERT(h->gen_auth_vectors(user_imsi(i % nof_users), vectors, vectors_per_request));
+    nof_vectors += vectors_per_request;
+  }
+  char name[64];
+  snprintf(name, sizeof(name), "HSS, %d vector(s) per request", vectors_per_request);
+  printf("%-36s %10.0f vectors/s\n", name, nof_vectors / elapsed_usec(start) * 1e6);
+
+  stop_hss(h);
+  return SRSRAN_SUCCESS;
+}
+
+int test_sqn_persistence(const std::string& csv_file, const std::string& bin_file)
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("HSS", false);
+  uint8_t               sqn[6], k_asme[32], autn[16], rand[16], xres[16];
+  double                usec = 0;
+
+  hss_db db(logger);
+  TESTASSERT(db.open(bin_file));
+  TESTASSERT(db.find(user_imsi(0)) != nullptr);
+  memcpy(sqn, db.find(user_imsi(0))->sqn, sizeof(sqn));
+  db.close();
+
+  // The SQN updated by an authentication is in the binary store after a restart
+  hss* h = start_hss(csv_file, bin_file, usec);
+  TESTASSERT(h != nullptr);
+  TESTASSERT(h->gen_auth_info_answer(user_imsi(0), k_asme, autn, rand, xres));
+  stop_hss(h);
+
+  TESTASSERT(db.open(bin_file));
+  TESTASSERT_EQ(nof_users, db.size());
+  TESTASSERT(memcmp(db.find(user_imsi(0))->sqn, sqn, sizeof(sqn)) != 0);
+  db.close();
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  srslog::fetch_basic_logger("HSS", false).set_level(srslog::basic_levels::warning);
+  srslog::init();
+
+  char csv_template[] = "/tmp/hss_benchmark_XXXXXX";
+  int  csv_fd         = mkstemp(csv_template);
+  TESTASSERT(csv_fd >= 0);
+  close(csv_fd);
+  std::string csv_file = csv_template;
+  std::string bin_file = csv_file + ".bin";
+  write_csv(csv_file);
+  unlink(bin_file.c_str());
+
+  TESTASSERT(test_startup(csv_file, bin_file) == SRSRAN_SUCCESS);
+  TESTASSERT(test_milenage_functions() == SRSRAN_SUCCESS);
+  TESTASSERT(test_auth_vectors(csv_file, bin_file, 1) == SRSRAN_SUCCESS);
+  TESTASSERT(test_auth_vectors(csv_file, bin_file, hss::max_auth_vectors) == SRSRAN_SUCCESS);
+  TESTASSERT(test_sqn_persistence(csv_file, bin_file) == SRSRAN_SUCCESS);
+
+  unlink(csv_file.c_str());
+  unlink(bin_file.c_str());
+  srslog::flush();
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,591 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/asn1/liblte_mme.h"
+#include "srsran/asn1/s1ap.h"
+#include "srsran/common/bcd_helpers.h"
+#include "srsran/common/byte_buffer.h"
+#include "srsran/common/network_utils.h"
+#include "srsran/common/security.h"
+#include <chrono>
+#include <fstream>
+#include <getopt.h>
+#include <inttypes.h>
+#include <iomanip>
+#include <netinet/sctp.h>
+#include <vector>
+
+/*
+ * Attach-storm load generator for the srsepc MME. It connects to the MME as an eNB, sets up S1 and attaches a
+ * population of UEs with IMSI attaches, keeping a window of attaches in flight. Each UE answers the authentication with
+ * the MILENAGE RES computed from K and OPc and protects the Security Mode Complete and the Attach Complete with the NAS
+ * keys it derives, so the MME runs the whole attach procedure. The eNB restarts between rounds, to reproduce the mass
+ * re-attach that follows an eNB restart.
+ *
+ * All the UEs share K and OPc. Run it with -d first to write the user database that the EPC loads.
+ */
+
+using namespace asn1::s1ap;
+using bench_clock = std::chrono::steady_clock;
+
+static std::string mme_addr   = "127.0.1.100";
+static std::string bind_addr  = "127.0.1.1";
+static std::string mcc_str    = "001";
+static std::string mnc_str    = "01";
+static uint16_t    tac        = 0x0007;
+static uint64_t    first_imsi = 1010000000000ULL;
+static uint32_t    nof_ues    = 1000;
+static uint32_t    window     = 64;
+static uint32_t    nof_rounds = 1;
+static std::string db_file    = "";
+
+static uint8_t k[16] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+static uint8_t opc[16] =
+    {0x63, 0xbf, 0xa5, 0x0e, 0xe6, 0x52, 0x33, 0x65, 0xff, 0x14, 0xc1, 0xf4, 0x5f, 0x88, 0x73, 0x7d};
+
+static const int   mme_port   = 36412;
+static const int   s1ap_ppid  = 18;
+static const int   enb_id     = 0x19b;
+static const char* enb_gtp_ip = "127.0.1.1";
+
+static uint16_t mcc = 0;
+static uint16_t mnc = 0;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [abmctinwrd]\n", prog);
+  printf("\t-a MME S1-MME address [Default %s]\n", mme_addr.c_str());
+  printf("\t-b Local S1-MME address [Default %s]\n", bind_addr.c_str());
+  printf("\t-m MCC [Default %s]\n", mcc_str.c_str());
+  printf("\t-c MNC [Default %s]\n", mnc_str.c_str());
+  printf("\t-t TAC [Default 0x%04x]\n", tac);
+  printf("\t-i IMSI of the first UE [Default %015" PRIu64 "]\n", first_imsi);
+  printf("\t-n Number of UEs [Default %d]\n", nof_ues);
+  printf("\t-w Number of attaches in flight [Default %d]\n", window);
+  printf("\t-r Number of rounds, the eNB restarts between rounds [Default %d]\n", nof_rounds);
+  printf("\t-d Write the user database of the UEs to this file and exit\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "a:b:m:c:t:i:n:w:r:d:")) != -1) {
+    switch (opt) {
+      case 'a':
+        mme_addr = optarg;
+        break;
+      case 'b':
+        bind_addr = optarg;
+        break;
+      case 'm':
+        mcc_str = optarg;
+        break;
+      case 'c':
+        mnc_str = optarg;
+        break;
+      case 't':
+        tac = (uint16_t)strtol(optarg, nullptr, 0);
+        break;
+      case 'i':
+        first_imsi = strtoull(optarg, nullptr, 10);
+        break;
+      case 'n':
+        nof_ues = (uint32_t)strtol(optarg, nullptr, 10);
+        break;
+      case 'w':
+        window = std::max((uint32_t)strtol(optarg, nullptr, 10), 1u);
+        break;
+      case 'r':
+        nof_rounds = (uint32_t)strtol(optarg, nullptr, 10);
+        break;
+      case 'd':
+        db_file = optarg;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static void write_user_db()
+{
+  std::ofstream f(db_file);
+  f << "# Name,Auth,IMSI,Key,OP_Type,OP/OPc,AMF,SQN,QCI,IP_alloc\n";
+  for (uint32_t i = 0; i < nof_ues; i++) {
+    f << "storm" << i << ",mil," << std::setfill('0') << std::setw(15) << first_imsi + i << ",";
+    for (uint8_t b : k) {
+      f << std::hex << std::setw(2) << (int)b;
+    }
+    f << ",opc,";
+    for (uint8_t b : opc) {
+      f << std::hex << std::setw(2) << (int)b;
+    }
+    f << std::dec << ",8000,000000001234,7,dynamic\n";
+  }
+}
+
+/// NAS and S1AP state of one emulated UE
+struct storm_ue_t {
+  enum class state_t { idle, wait_auth, wait_smc, wait_ics, wait_emm_info, attached, failed };
+
+  state_t                             state          = state_t::idle;
+  uint64_t                            imsi           = 0;
+  uint32_t                            mme_ue_s1ap_id = 0;
+  uint32_t                            ul_count       = 0;
+  uint8_t                             k_asme[32]     = {};
+  uint8_t                             k_nas_enc[32]  = {};
+  uint8_t                             k_nas_int[32]  = {};
+  srsran::CIPHERING_ALGORITHM_ID_ENUM cipher_algo    = srsran::CIPHERING_ALGORITHM_ID_EEA0;
+  srsran::INTEGRITY_ALGORITHM_ID_ENUM integ_algo     = srsran::INTEGRITY_ALGORITHM_ID_EIA0;
+};
+
+class storm_enb
+{
+public:
+  bool connect();
+  void disconnect() { socket.close(); }
+  bool s1_setup();
+  bool run_round();
+
+private:
+  bool send_s1ap(const s1ap_pdu_c& pdu);
+  bool recv_s1ap(s1ap_pdu_c& pdu);
+  void fill_tai_cgi(tai_s& tai, eutran_cgi_s& cgi);
+
+  void start_attach(uint32_t idx);
+  void send_ul_nas(uint32_t idx, const srsran::byte_buffer_t& nas);
+  void protect_ul_nas(storm_ue_t& ue, srsran::byte_buffer_t& nas);
+  void handle_dl_nas(uint32_t idx, srsran::byte_buffer_t& nas);
+  void handle_auth_request(uint32_t idx, srsran::byte_buffer_t& nas);
+  void handle_smc(uint32_t idx, srsran::byte_buffer_t& nas);
+  void handle_ics_request(const init_context_setup_request_s& ics);
+  void finish_ue(uint32_t idx, storm_ue_t::state_t state);
+
+  srsran::unique_socket   socket;
+  std::vector<storm_ue_t> ues;
+  uint32_t                next_ue      = 0;
+  uint32_t                nof_done     = 0;
+  uint32_t                nof_attached = 0;
+};
+
+bool storm_enb::connect()
+{
+  if (not socket.open_socket(srsran::net_utils::addr_family::ipv4,
+                             srsran::net_utils::socket_type::seqpacket,
+                             srsran::net_utils::protocol_type::SCTP)) {
+    return false;
+  }
+  if (not socket.bind_addr(bind_addr.c_str(), 0)) {
+    socket.close();
+    return false;
+  }
+  return socket.connect_to(mme_addr.c_str(), mme_port);
+}
+
+bool storm_enb::send_s1ap(const s1ap_pdu_c& pdu)
+{
+  srsran::byte_buffer_t buf;
+  asn1::bit_ref         bref(buf.msg, buf.get_tailroom());
+  if (pdu.pack(bref) != asn1::SRSASN_SUCCESS) {
+    fprintf(stderr, "Failed to pack S1AP PDU\n");
+    return false;
+  }
+  buf.N_bytes = bref.distance_bytes();
+  if (sctp_sendmsg(socket.fd(), buf.msg, buf.N_bytes, nullptr, 0, htonl(s1ap_ppid), 0, 0, 0, 0) < 0) {
+    perror("sctp_sendmsg");
+    return false;
+  }
+  return true;
+}
+
+bool storm_enb::recv_s1ap(s1ap_pdu_c& pdu)
+{
+  srsran::byte_buffer_t  buf;
+  struct sctp_sndrcvinfo sri   = {};
+  int                    flags = 0;
+  ssize_t n = sctp_recvmsg(socket.fd(), buf.msg, buf.get_tailroom(), nullptr, nullptr, &sri, &flags);
+  if (n <= 0) {
+    perror("sctp_recvmsg");
+    return false;
+  }
+  if (flags & MSG_NOTIFICATION) {
+    // Nothing to decode, the caller waits for the next message
+    pdu = {};
+    return true;
+  }
+  asn1::cbit_ref bref(buf.msg, n);
+  if (pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+    fprintf(stderr, "Failed to unpack S1AP PDU\n");
+    return false;
+  }
+  return true;
+}
+
+void storm_enb::fill_tai_cgi(tai_s& tai, eutran_cgi_s& cgi)
+{
+  uint32_t plmn;
+  srsran::s1ap_mccmnc_to_plmn(mcc, mnc, &plmn);
+  tai.plm_nid.from_number(plmn);
+  tai.tac.from_number(tac);
+  cgi.plm_nid.from_number(plmn);
+  cgi.cell_id.from_number((uint32_t)(enb_id << 8) | 1);
+}
+
+bool storm_enb::s1_setup()
+{
+  uint32_t plmn;
+  srsran::s1ap_mccmnc_to_plmn(mcc, mnc, &plmn);
+  plmn = htonl(plmn);
+
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_S1_SETUP);
+  s1_setup_request_s& container             = pdu.init_msg().value.s1_setup_request();
+  container->global_enb_id.value.plm_nid[0] = ((uint8_t*)&plmn)[1];
+  container->global_enb_id.value.plm_nid[1] = ((uint8_t*)&plmn)[2];
+  container->global_enb_id.value.plm_nid[2] = ((uint8_t*)&plmn)[3];
+  container->global_enb_id.value.enb_id.set_macro_enb_id().from_number(enb_id);
+  container->enbname_present = true;
+  container->enbname.value.from_string("attach_storm");
+  container->supported_tas.value.resize(1);
+  uint16_t tac_be = htons(tac);
+  memcpy(container->supported_tas.value[0].tac.data(), &tac_be, 2);
+  container->supported_tas.value[0].broadcast_plmns.resize(1);
+  container->supported_tas.value[0].broadcast_plmns[0][0] = ((uint8_t*)&plmn)[1];
+  container->supported_tas.value[0].broadcast_plmns[0][1] = ((uint8_t*)&plmn)[2];
+  container->supported_tas.value[0].broadcast_plmns[0][2] = ((uint8_t*)&plmn)[3];
+  container->default_paging_drx.value.value = paging_drx_opts::v128;
+  if (not send_s1ap(pdu)) {
+    return false;
+  }
+
+  s1ap_pdu_c rx_pdu;
+  do {
+    if (not recv_s1ap(rx_pdu)) {
+      return false;
+    }
+  } while (rx_pdu.type().value == s1ap_pdu_c::types_opts::nulltype);
+  if (rx_pdu.type().value != s1ap_pdu_c::types_opts::successful_outcome or
+      rx_pdu.successful_outcome().value.type().value !=
+          s1ap_elem_procs_o::successful_outcome_c::types_opts::s1_setup_resp) {
+    fprintf(stderr, "S1 Setup failed\n");
+    return false;
+  }
+  return true;
+}
+
+void storm_enb::start_attach(uint32_t idx)
+{
+  storm_ue_t& ue = ues[idx];
+  ue             = {};
+  ue.imsi        = first_imsi + idx;
+  ue.state       = storm_ue_t::state_t::wait_auth;
+
+  LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT pdn_con_req = {};
+  pdn_con_req.eps_bearer_id                                  = 0;
+  pdn_con_req.proc_transaction_id                            = 1;
+  pdn_con_req.request_type                                   = LIBLTE_MME_REQUEST_TYPE_INITIAL_REQUEST;
+  pdn_con_req.pdn_type                                       = LIBLTE_MME_PDN_TYPE_IPV4;
+
+  LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT attach_req = {};
+  attach_req.eps_attach_type                      = LIBLTE_MME_EPS_ATTACH_TYPE_EPS_ATTACH;
+  for (uint32_t i = 0; i < 4; i++) {
+    attach_req.ue_network_cap.eea[i] = true;
+    attach_req.ue_network_cap.eia[i] = true;
+  }
+  attach_req.eps_mobile_id.type_of_id = LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI;
+  uint64_t imsi                       = ue.imsi;
+  for (int i = 14; i >= 0; i--) {
+    attach_req.eps_mobile_id.imsi[i] = imsi % 10;
+    imsi /= 10;
+  }
+  attach_req.nas_ksi.tsc_flag = LIBLTE_MME_TYPE_OF_SECURITY_CONTEXT_FLAG_NATIVE;
+  attach_req.nas_ksi.nas_ksi  = LIBLTE_MME_NAS_KEY_SET_IDENTIFIER_NO_KEY_AVAILABLE;
+  liblte_mme_pack_pdn_connectivity_request_msg(&pdn_con_req, &attach_req.esm_msg);
+
+  srsran::byte_buffer_t nas;
+  liblte_mme_pack_attach_request_msg(&attach_req, (LIBLTE_BYTE_MSG_STRUCT*)&nas);
+
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_INIT_UE_MSG);
+  init_ue_msg_s& container        = pdu.init_msg().value.init_ue_msg();
+  container->enb_ue_s1ap_id.value = idx + 1;
+  container->nas_pdu.value.resize(nas.N_bytes);
+  memcpy(container->nas_pdu.value.data(), nas.msg, nas.N_bytes);
+  fill_tai_cgi(container->tai.value, container->eutran_cgi.value);
+  container->rrc_establishment_cause.value = rrc_establishment_cause_opts::mo_sig;
+  send_s1ap(pdu);
+}
+
+void storm_enb::send_ul_nas(uint32_t idx, const srsran::byte_buffer_t& nas)
+{
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_UL_NAS_TRANSPORT);
+  ul_nas_transport_s& container   = pdu.init_msg().value.ul_nas_transport();
+  container->mme_ue_s1ap_id.value = ues[idx].mme_ue_s1ap_id;
+  container->enb_ue_s1ap_id.value = idx + 1;
+  container->nas_pdu.value.resize(nas.N_bytes);
+  memcpy(container->nas_pdu.value.data(), nas.msg, nas.N_bytes);
+  fill_tai_cgi(container->tai.value, container->eutran_cgi.value);
+  send_s1ap(pdu);
+}
+
+/// Ciphers and integrity protects a NAS PDU packed with a security header, as the UE does
+void storm_enb::protect_ul_nas(storm_ue_t& ue, srsran::byte_buffer_t& nas)
+{
+  srsran::byte_buffer_t tmp;
+  uint8_t*              payload = &nas.msg[6];
+  uint32_t              len     = nas.N_bytes - 6;
+  uint8_t               dir     = srsran::SECURITY_DIRECTION_UPLINK;
+  switch (ue.cipher_algo) {
+    case srsran::CIPHERING_ALGORITHM_ID_128_EEA1:
+      srsran::security_128_eea1(&ue.k_nas_enc[16], ue.ul_count, 0, dir, payload, len, &tmp.msg[6]);
+      break;
+    case srsran::CIPHERING_ALGORITHM_ID_128_EEA2:
+      srsran::security_128_eea2(&ue.k_nas_enc[16], ue.ul_count, 0, dir, payload, len, &tmp.msg[6]);
+      break;
+    case srsran::CIPHERING_ALGORITHM_ID_128_EEA3:
+      srsran::security_128_eea3(&ue.k_nas_enc[16], ue.ul_count, 0, dir, payload, len, &tmp.msg[6]);
+      break;
+    default:
+      memcpy(&tmp.msg[6], payload, len);
+      break;
+  }
+  memcpy(payload, &tmp.msg[6], len);
+
+  // The MAC covers the sequence number and the ciphered message
+  switch (ue.integ_algo) {
+    case srsran::INTEGRITY_ALGORITHM_ID_128_EIA1:
+      srsran::security_128_eia1(&ue.k_nas_int[16], ue.ul_count, 0, dir, &nas.msg[5], len + 1, &nas.msg[1]);
+      break;
+    case srsran::INTEGRITY_ALGORITHM_ID_128_EIA2:
+      srsran::security_128_eia2(&ue.k_nas_int[16], ue.ul_count, 0, dir, &nas.msg[5], len + 1, &nas.msg[1]);
+      break;
+    case srsran::INTEGRITY_ALGORITHM_ID_128_EIA3:
+      srsran::security_128_eia3(&ue.k_nas_int[16], ue.ul_count, 0, dir, &nas.msg[5], len + 1, &nas.msg[1]);
+      break;
+    default:
+      break;
+  }
+  ue.ul_count++;
+}
+
+void storm_enb::handle_auth_request(uint32_t idx, srsran::byte_buffer_t& nas)
+{
+  storm_ue_t&                                  ue       = ues[idx];
+  LIBLTE_MME_AUTHENTICATION_REQUEST_MSG_STRUCT auth_req = {};
+  liblte_mme_unpack_authentication_request_msg((LIBLTE_BYTE_MSG_STRUCT*)&nas, &auth_req);
+
+  uint8_t res[8], ck[16], ik[16], ak[6];
+  srsran::security_milenage_f2345(k, opc, auth_req.rand, res, ck, ik, ak);
+  // The first 6 bytes of AUTN are SQN ^ AK
+  srsran::security_generate_k_asme(ck, ik, auth_req.autn, mcc, mnc, ue.k_asme);
+
+  LIBLTE_MME_AUTHENTICATION_RESPONSE_MSG_STRUCT auth_resp = {};
+  memcpy(auth_resp.res, res, sizeof(res));
+  auth_resp.res_len = sizeof(res);
+  srsran::byte_buffer_t tx;
+  liblte_mme_pack_authentication_response_msg(
+      &auth_resp, LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS, 0, (LIBLTE_BYTE_MSG_STRUCT*)&tx);
+  ue.state = storm_ue_t::state_t::wait_smc;
+  send_ul_nas(idx, tx);
+}
+
+void storm_enb::handle_smc(uint32_t idx, srsran::byte_buffer_t& nas)
+{
+  storm_ue_t&                                 ue     = ues[idx];
+  LIBLTE_MME_SECURITY_MODE_COMMAND_MSG_STRUCT sm_cmd = {};
+  liblte_mme_unpack_security_mode_command_msg((LIBLTE_BYTE_MSG_STRUCT*)&nas, &sm_cmd);
+
+  ue.cipher_algo = (srsran::CIPHERING_ALGORITHM_ID_ENUM)sm_cmd.selected_nas_sec_algs.type_of_eea;
+  ue.integ_algo  = (srsran::INTEGRITY_ALGORITHM_ID_ENUM)sm_cmd.selected_nas_sec_algs.type_of_eia;
+  srsran::security_generate_k_nas(ue.k_asme, ue.cipher_algo, ue.integ_algo, ue.k_nas_enc, ue.k_nas_int);
+
+  // The UL NAS count restarts with the new security context
+  ue.ul_count = 0;
+
+  LIBLTE_MME_SECURITY_MODE_COMPLETE_MSG_STRUCT sm_comp = {};
+  srsran::byte_buffer_t                        tx;
+  uint8_t sec_hdr = LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED_WITH_NEW_EPS_SECURITY_CONTEXT;
+  liblte_mme_pack_security_mode_complete_msg(&sm_comp, sec_hdr, ue.ul_count, (LIBLTE_BYTE_MSG_STRUCT*)&tx);
+  protect_ul_nas(ue, tx);
+  ue.state = storm_ue_t::state_t::wait_ics;
+  send_ul_nas(idx, tx);
+}
+
+void storm_enb::handle_ics_request(const init_context_setup_request_s& ics)
+{
+  uint32_t idx = ics->enb_ue_s1ap_id.value.value - 1;
+  if (idx >= ues.size() or ues[idx].state != storm_ue_t::state_t::wait_ics or
+      ics->erab_to_be_setup_list_ctxt_su_req.value.size() == 0) {
+    return;
+  }
+  storm_ue_t& ue      = ues[idx];
+  uint8_t     erab_id = ics->erab_to_be_setup_list_ctxt_su_req.value[0]->erab_to_be_setup_item_ctxt_su_req().erab_id;
+
+  // Initial Context Setup Response with the eNB end of the default bearer
+  s1ap_pdu_c pdu;
+  pdu.set_successful_outcome().load_info_obj(ASN1_S1AP_ID_INIT_CONTEXT_SETUP);
+  init_context_setup_resp_s& container = pdu.successful_outcome().value.init_context_setup_resp();
+  container->mme_ue_s1ap_id.value      = ue.mme_ue_s1ap_id;
+  container->enb_ue_s1ap_id.value      = idx + 1;
+  container->erab_setup_list_ctxt_su_res.value.resize(1);
+  container->erab_setup_list_ctxt_su_res.value[0].load_info_obj(ASN1_S1AP_ID_ERAB_SETUP_ITEM_CTXT_SU_RES);
+  erab_setup_item_ctxt_su_res_s& item = container->erab_setup_list_ctxt_su_res.value[0]->erab_setup_item_ctxt_su_res();
+  item.erab_id                        = erab_id;
+  uint32_t addr;
+  inet_pton(AF_INET, enb_gtp_ip, &addr);
+  item.transport_layer_address.resize(32);
+  item.transport_layer_address.from_number(ntohl(addr));
+  item.gtp_teid.from_number(idx + 1);
+  send_s1ap(pdu);
+
+  // Attach Complete
+  LIBLTE_MME_ACTIVATE_DEFAULT_EPS_BEARER_CONTEXT_ACCEPT_MSG_STRUCT act_bearer = {};
+  act_bearer.eps_bearer_id                                                    = erab_id;
+  act_bearer.proc_transaction_id                                              = 1;
+  LIBLTE_MME_ATTACH_COMPLETE_MSG_STRUCT attach_comp                           = {};
+  liblte_mme_pack_activate_default_eps_bearer_context_accept_msg(&act_bearer, &attach_comp.esm_msg);
+  srsran::byte_buffer_t tx;
+  liblte_mme_pack_attach_complete_msg(
+      &attach_comp, LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED, ue.ul_count, (LIBLTE_BYTE_MSG_STRUCT*)&tx);
+  protect_ul_nas(ue, tx);
+  ue.state = storm_ue_t::state_t::wait_emm_info;
+  send_ul_nas(idx, tx);
+}
+
+void storm_enb::handle_dl_nas(uint32_t idx, srsran::byte_buffer_t& nas)
+{
+  storm_ue_t& ue = ues[idx];
+  uint8_t     pd, msg_type;
+  liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)&nas, &pd, &msg_type);
+
+  switch (ue.state) {
+    case storm_ue_t::state_t::wait_auth:
+      if (msg_type == LIBLTE_MME_MSG_TYPE_AUTHENTICATION_REQUEST) {
+        handle_auth_request(idx, nas);
+        return;
+      }
+      break;
+    case storm_ue_t::state_t::wait_smc:
+      if (msg_type == LIBLTE_MME_MSG_TYPE_SECURITY_MODE_COMMAND) {
+        handle_smc(idx, nas);
+        return;
+      }
+      break;
+    case storm_ue_t::state_t::wait_emm_info:
+      // The MME sends the EMM Information once it has handled the Attach Complete
+      finish_ue(idx, storm_ue_t::state_t::attached);
+      return;
+    default:
+      break;
+  }
+  fprintf(stderr, "IMSI %015" PRIu64 ": unexpected NAS message 0x%x\n", ue.imsi, msg_type);
+  finish_ue(idx, storm_ue_t::state_t::failed);
+}
+
+void storm_enb::finish_ue(uint32_t idx, storm_ue_t::state_t state)
+{
+  ues[idx].state = state;
+  nof_done++;
+  if (state == storm_ue_t::state_t::attached) {
+    nof_attached++;
+  }
+  if (next_ue < ues.size()) {
+    start_attach(next_ue++);
+  }
+}
+
+bool storm_enb::run_round()
+{
+  ues.assign(nof_ues, storm_ue_t{});
+  next_ue      = 0;
+  nof_done     = 0;
+  nof_attached = 0;
+
+  bench_clock::time_point start = bench_clock::now();
+  while (next_ue < std::min(window, nof_ues)) {
+    start_attach(next_ue++);
+  }
+
+  s1ap_pdu_c pdu;
+  while (nof_done < nof_ues) {
+    if (not recv_s1ap(pdu)) {
+      return false;
+    }
+    if (pdu.type().value != s1ap_pdu_c::types_opts::init_msg) {
+      continue;
+    }
+    const s1ap_elem_procs_o::init_msg_c& msg = pdu.init_msg().value;
+    switch (msg.type().value) {
+      case s1ap_elem_procs_o::init_msg_c::types_opts::dl_nas_transport: {
+        uint32_t idx = msg.dl_nas_transport()->enb_ue_s1ap_id.value.value - 1;
+        if (idx >= ues.size() or ues[idx].state == storm_ue_t::state_t::attached or
+            ues[idx].state == storm_ue_t::state_t::failed) {
+          break;
+        }
+        ues[idx].mme_ue_s1ap_id = msg.dl_nas_transport()->mme_ue_s1ap_id.value.value;
+        srsran::byte_buffer_t nas;
+        nas.N_bytes = msg.dl_nas_transport()->nas_pdu.value.size();
+        memcpy(nas.msg, msg.dl_nas_transport()->nas_pdu.value.data(), nas.N_bytes);
+        handle_dl_nas(idx, nas);
+        break;
+      }
+      case s1ap_elem_procs_o::init_msg_c::types_opts::init_context_setup_request:
+        handle_ics_request(msg.init_context_setup_request());
+        break;
+      default:
+        break;
+    }
+  }
+
+  double sec = std::chrono::duration_cast<std::chrono::microseconds>(bench_clock::now() - start).count() / 1e6;
+  printf("%d/%d UEs attached in %.2f s, %.0f attaches/s\n", nof_attached, nof_ues, sec, nof_attached / sec);
+  return nof_attached == nof_ues;
+}
+
+int main(int argc, char** argv)
+{
+  parse_args(argc, argv);
+  if (not srsran::string_to_mcc(mcc_str, &mcc) or not srsran::string_to_mnc(mnc_str, &mnc)) {
+    fprintf(stderr, "Invalid MCC or MNC\n");
+    return SRSRAN_ERROR;
+  }
+  if (not db_file.empty()) {
+    write_user_db();
+    printf("Wrote %d users to %s\n", nof_ues, db_file.c_str());
+    return SRSRAN_SUCCESS;
+  }
+
+  storm_enb enb;
+  bool      ok = true;
+  for (uint32_t round = 0; round < nof_rounds and ok; round++) {
+    // A new association for every round, the MME releases the UEs of the old one as after an eNB restart
+    if (not enb.connect() or not enb.s1_setup()) {
+      fprintf(stderr, "Could not set up S1 with the MME at %s\n", mme_addr.c_str());
+      return SRSRAN_ERROR;
+    }
+    printf("Round %d: ", round);
+    ok = enb.run_round();
+    enb.disconnect();
+  }
+  return ok ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+}
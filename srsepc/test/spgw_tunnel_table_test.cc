@@ -0,0 +1,122 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsepc/hdr/spgw/ue_tunnel_table.h"
+#include "srsran/common/test_common.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/*
+ * Looks up the downlink tunnels of the UE IPs from several user plane threads while GTP-C creates, releases and
+ * deletes sessions. Every lookup must return a whole tunnel of its UE IP, and the UEs that stay attached must always be
+ * found.
+ */
+
+using namespace srsepc;
+
+static const in_addr_t first_ue_ip      = 0xac100002; // 172.16.0.2
+static const uint32_t  nof_attached_ues = 64;
+static const uint32_t  nof_churn_ues    = 256;
+static const uint32_t  nof_readers      = 4;
+static const uint32_t  nof_sessions     = 20000;
+
+// The TEIDs of a session encode its UE IP and generation, so that a lookup can check it got a consistent tunnel
+static srsran::gtp_fteid_t enb_fteid(in_addr_t ue_ip, uint32_t gen)
+{
+  srsran::gtp_fteid_t fteid = {};
+  fteid.ipv4                = 0x0a000001;
+  fteid.teid                = (ue_ip << 12u) | (gen & 0xfffu);
+  return fteid;
+}
+
+static uint32_t ctr_teid(in_addr_t ue_ip, uint32_t gen)
+{
+  return enb_fteid(ue_ip, gen).teid + 1;
+}
+
+int test_concurrent_session_churn()
+{
+  ue_tunnel_table       tunnels;
+  std::atomic<bool>     running{true};
+  std::atomic<uint32_t> nof_errors{0};
+  std::atomic<uint64_t> nof_lookups{0};
+
+  for (uint32_t i = 0; i < nof_attached_ues; ++i) {
+    tunnels.modify(first_ue_ip + i, enb_fteid(first_ue_ip + i, 0), ctr_teid(first_ue_ip + i, 0));
+  }
+
+  auto reader = [&]() {
+    uint32_t reader_id = tunnels.qsbr().register_reader();
+    uint64_t n         = 0;
+    while (running) {
+      for (in_addr_t ip = first_ue_ip; ip < first_ue_ip + nof_attached_ues + nof_churn_ues; ++ip, ++n) {
+        ue_tunnel_table::ue_tunnel_t tunnel;
+        if (not tunnels.find(ip, tunnel)) {
+          if (ip < first_ue_ip + nof_attached_ues) {
+            nof_errors++;
+          }
+          continue;
+        }
+        if (tunnel.spgw_ctr_teid != tunnel.enb_fteid.teid + 1 or (tunnel.enb_fteid.teid >> 12u) != (ip & 0xfffffu) or
+            not tunnel.ctr_active) {
+          nof_errors++;
+        }
+      }
+      tunnels.qsbr().quiescent(reader_id);
+    }
+    tunnels.qsbr().unregister_reader(reader_id);
+    nof_lookups += n;
+  };
+  std::vector<std::thread> readers;
+  for (uint32_t i = 0; i < nof_readers; ++i) {
+    readers.emplace_back(reader);
+  }
+
+  // Each session is created, released to idle, re-established and finally deleted
+  for (uint32_t gen = 1; gen <= nof_sessions; ++gen) {
+    in_addr_t ip = first_ue_ip + nof_attached_ues + gen % nof_churn_ues;
+    tunnels.modify(ip, enb_fteid(ip, gen), ctr_teid(ip, gen));
+    TESTASSERT(tunnels.delete_user_tunnel(ip));
+    tunnels.modify(ip, enb_fteid(ip, gen), ctr_teid(ip, gen));
+    TESTASSERT(tunnels.delete_user_tunnel(ip));
+    TESTASSERT(tunnels.delete_ctrl_tunnel(ip));
+    TESTASSERT(not tunnels.delete_ctrl_tunnel(ip));
+  }
+
+  running = false;
+  for (std::thread& t : readers) {
+    t.join();
+  }
+  printf("%lu lookups during %d sessions\n", (unsigned long)nof_lookups.load(), nof_sessions);
+
+  TESTASSERT_EQ(0, nof_errors.load());
+  TESTASSERT_EQ(nof_attached_ues, tunnels.size());
+  return SRSRAN_SUCCESS;
+}
+
+int main()
+{
+  TESTASSERT(test_concurrent_session_churn() == SRSRAN_SUCCESS);
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -23,6 +23,7 @@
 #define SRSENB_MAC_NR_H
 
 #include "srsran/common/block_queue.h"
+#include "srsran/common/latency_histogram.h"
 #include "srsran/common/mac_pcap.h"
 
 #include "srsenb/hdr/common/rnti_pool.h"
@@ -150,6 +151,9 @@ private:
   // Number of rach preambles detected for a CC
   std::vector<uint32_t> detected_rachs;
 
+  // Time to assemble the DL MAC PDUs of each slot
+  srsran::latency_histogram pdu_latency;
+
   // Decoding of UL PDUs
   std::unique_ptr<mac_nr_rx> rx;
 };
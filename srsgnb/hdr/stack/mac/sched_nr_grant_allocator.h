@@ -29,6 +29,7 @@
 #include "sched_nr_sch.h"
 #include "sched_nr_ue.h"
 #include "srsenb/hdr/stack/mac/sched_common.h"
+#include "srsran/common/time_prof.h"
 
 namespace srsenb {
 namespace sched_nr_impl {
@@ -122,16 +123,32 @@ public:
   }
   const prb_bitmap& occupied_ul_prbs(slot_point sl_tx) const { return bwp_grid[sl_tx].puschs.occupied_prbs(); }
 
+  /// Time spent in PDCCH allocations by this allocator
+  std::chrono::nanoseconds get_pdcch_alloc_time() const { return pdcch_alloc_time; }
+
   srslog::basic_logger& logger;
   const bwp_params_t&   cfg;
 
 private:
   alloc_result verify_uci_space(const bwp_slot_grid& uci_grid) const;
 
+  /// Runs a PDCCH allocation, accounting for the time it takes
+  template <typename AllocFunc>
+  auto timed_pdcch_alloc(const AllocFunc& alloc_pdcch) -> decltype(alloc_pdcch())
+  {
+    srsran::tprof_measure pdcch_meas;
+    pdcch_meas.start();
+    auto ret = alloc_pdcch();
+    pdcch_alloc_time += pdcch_meas.stop();
+    return ret;
+  }
+
   bwp_res_grid& bwp_grid;
 
   slot_point     pdcch_slot;
   slot_ue_map_t& slot_ues;
+
+  std::chrono::nanoseconds pdcch_alloc_time{0};
 };
 
 prb_grant find_optimal_dl_grant(bwp_slot_allocator& slot_alloc, const slot_ue& ue, uint32_t ss_id);
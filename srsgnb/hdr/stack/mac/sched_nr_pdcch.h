@@ -95,7 +95,8 @@ private:
 
   srsran::span<const uint32_t> get_cce_loc_table(const alloc_record& record) const;
   bool                         alloc_dfs_node(const alloc_record& record, uint32_t dci_idx);
-  bool                         get_next_dfs();
+  bool                         get_next_dfs(const alloc_record& failed_record);
+  size_t                       get_nof_blocking_nodes(const alloc_record& record) const;
 };
 
 using pdcch_dl_alloc_result = srsran::expected<pdcch_dl_t*, alloc_result>;
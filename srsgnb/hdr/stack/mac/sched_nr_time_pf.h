@@ -0,0 +1,105 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_SCHED_NR_TIME_PF_H
+#define SRSRAN_SCHED_NR_TIME_PF_H
+
+#include "sched_nr_time_rr.h"
+#include <limits>
+#include <vector>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/**
+ * Time-domain proportional fair scheduler with QoS priorities. In every slot, the UEs are served in the order:
+ * - HARQ retxs
+ * - UEs with a GBR bearer (finite prioritised bit rate) whose average rate is below the guaranteed one
+ * - UEs whose highest priority bearer with pending data has the lowest priority level
+ * - highest PF metric r / R^fairness_coeff, where r is the rate expected for the UE and R its average rate
+ * New txs get the PRBs needed for their pending bytes, so that several UEs can be allocated in the same slot.
+ */
+class sched_nr_time_pf : public sched_nr_base
+{
+public:
+  explicit sched_nr_time_pf(const bwp_params_t& bwp_cfg_);
+
+  void sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+  void sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc) override;
+
+private:
+  /// Exponential average of the bytes allocated per slot, with a fast start while there are few samples
+  struct avg_rate {
+    float    avg         = 0;
+    uint32_t nof_samples = 0;
+    void     save_alloc(uint32_t alloc_bytes);
+  };
+
+  struct ue_ctxt {
+    explicit ue_ctxt(uint16_t rnti_) : rnti(rnti_) {}
+    void new_slot(const bwp_params_t& bwp_cfg, slot_ue& ue, float fairness_coeff);
+
+    const uint16_t rnti;
+
+    slot_ue* ue               = nullptr; ///< UE in the current slot
+    bool     dl_retx          = false;
+    bool     dl_newtx         = false;
+    bool     dl_gbr           = false; ///< GBR bearer below its guaranteed rate
+    int      dl_lc_prio       = std::numeric_limits<int>::max();
+    float    dl_bytes_per_prb = 0;
+    float    dl_prio          = 0;
+    uint32_t dl_alloc         = 0;
+    bool     ul_retx          = false;
+    bool     ul_newtx         = false;
+    float    ul_bytes_per_prb = 0;
+    float    ul_prio          = 0;
+    uint32_t ul_alloc         = 0;
+    avg_rate dl_rate;
+    avg_rate ul_rate;
+  };
+
+  void         new_slot(slot_ue_map_t& ue_db, slot_point pdcch_slot);
+  alloc_result alloc_dl_ue(ue_ctxt& ue, bwp_slot_allocator& slot_alloc);
+  alloc_result alloc_ul_ue(ue_ctxt& ue, bwp_slot_allocator& slot_alloc);
+
+  struct ue_dl_prio_compare {
+    bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
+  };
+  struct ue_ul_prio_compare {
+    bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
+  };
+
+  const bwp_params_t& bwp_cfg;
+  const float         fairness_coeff;
+
+  slot_point current_slot;
+
+  rnti_map_t<ue_ctxt> ue_history_db;
+
+  // UEs of the current slot, stored contiguously and kept as max-heaps by priority
+  std::vector<ue_ctxt*> dl_queue;
+  std::vector<ue_ctxt*> ul_queue;
+};
+
+} // namespace sched_nr_impl
+} // namespace srsenb
+
+#endif // SRSRAN_SCHED_NR_TIME_PF_H
@@ -195,7 +195,7 @@ public:
     return ue->pdu_builder.alloc_subpdus(rem_bytes, pdu);
   }
 
-  bool get_pending_bytes(uint32_t lcid) const { return ue->pdu_builder.pending_bytes(lcid); }
+  uint32_t get_pending_bytes(uint32_t lcid) const { return ue->pdu_builder.pending_bytes(lcid); }
 
   /// Channel Information Getters
   uint32_t dl_cqi() const { return ue->dl_cqi; }
@@ -30,6 +30,7 @@
 #include "srsran/adt/optional.h"
 #include "srsran/adt/pool/cached_alloc.h"
 #include "srsran/adt/span.h"
+#include "srsran/common/latency_histogram.h"
 #include <condition_variable>
 #include <mutex>
 
@@ -56,6 +57,10 @@ public:
   // cc-specific resources
   srsran::bounded_vector<bwp_manager, SCHED_NR_MAX_BWP_PER_CELL> bwps;
 
+  // time to schedule each slot of this cc and to allocate its PDCCHs
+  srsran::latency_histogram sched_latency;
+  srsran::latency_histogram pdcch_latency;
+
 private:
   void alloc_dl_ues(bwp_slot_allocator& bwp_alloc);
   void alloc_ul_ues(bwp_slot_allocator& bwp_alloc);
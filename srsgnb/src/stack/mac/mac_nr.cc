@@ -272,6 +272,10 @@ void mac_nr::get_metrics(srsenb::mac_metrics_t& metrics)
   // others from the scheduler.
   get_metrics_nolock(metrics);
   sched->get_metrics(metrics);
+
+  srsran::latency_histogram::snapshot pdu_samples;
+  pdu_latency.read_and_reset(pdu_samples);
+  metrics.latency.pdu = pdu_samples.get_metrics();
 }
 
 void mac_nr::get_metrics_nolock(srsenb::mac_metrics_t& metrics)
@@ -500,6 +504,8 @@ mac_nr::dl_sched_t* mac_nr::get_dl_sched(const srsran_slot_cfg_t& slot_cfg)
   }
 
   // Generate MAC DL PDUs
+  srsran::tprof_measure pdu_meas;
+  pdu_meas.start();
   uint32_t                  rar_count = 0, si_count = 0, data_count = 0;
   srsran::rwlock_read_guard rw_lock(rwmutex);
   for (pdsch_t& pdsch : dl_res->phy.pdsch) {
@@ -539,6 +545,8 @@ mac_nr::dl_sched_t* mac_nr::get_dl_sched(const srsran_slot_cfg_t& slot_cfg)
 #endif
     }
   }
+  pdu_latency.record(pdu_meas.stop());
+
   for (auto& u : ue_db) {
     u.second->metrics_cnt();
   }
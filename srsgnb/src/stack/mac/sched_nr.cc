@@ -27,6 +27,7 @@
 #include "srsran/common/phy_cfg_nr_default.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/common/thread_pool.h"
+#include "srsran/common/time_prof.h"
 
 namespace srsenb {
 
@@ -397,6 +398,9 @@ sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
 {
   srsran_assert(pdsch_tti == current_slot_tx, "Unexpected pdsch_tti slot received");
 
+  srsran::tprof_measure sched_meas;
+  sched_meas.start();
+
   // process non-cc specific feedback if pending (e.g. SRs, buffer state updates, UE config) for non-CA UEs
   pending_events->process_cc_events(ue_db, cc);
 
@@ -409,6 +413,7 @@ sched_nr::dl_res_t* sched_nr::get_dl_sched(slot_point pdsch_tti, uint32_t cc)
 
   // Process pending CC-specific feedback, generate {slot_idx,cc} scheduling decision
   sched_nr::dl_res_t* ret = cc_workers[cc]->run_slot(pdsch_tti, ue_db);
+  cc_workers[cc]->sched_latency.record(sched_meas.stop());
 
   // decrement the number of active workers
   int rem_workers = worker_count.fetch_sub(1, std::memory_order_release) - 1;
@@ -430,6 +435,14 @@ sched_nr::ul_res_t* sched_nr::get_ul_sched(slot_point slot_ul, uint32_t cc)
 void sched_nr::get_metrics(mac_metrics_t& metrics)
 {
   metrics_handler->get_metrics(metrics);
+
+  srsran::latency_histogram::snapshot sched_samples, pdcch_samples;
+  for (auto& worker : cc_workers) {
+    worker->sched_latency.read_and_reset(sched_samples);
+    worker->pdcch_latency.read_and_reset(pdcch_samples);
+  }
+  metrics.latency.sched = sched_samples.get_metrics();
+  metrics.latency.pdcch = pdcch_samples.get_metrics();
 }
 
 int sched_nr::dl_rach_info(const rar_info_t& rar_info)
@@ -139,7 +139,7 @@ alloc_result bwp_slot_allocator::alloc_si(uint32_t            aggr_idx,
   }
 
   // Allocate PDCCH
-  auto pdcch_result = bwp_pdcch_slot.pdcchs.alloc_si_pdcch(ss_id, aggr_idx);
+  auto pdcch_result = timed_pdcch_alloc([&]() { return bwp_pdcch_slot.pdcchs.alloc_si_pdcch(ss_id, aggr_idx); });
   if (pdcch_result.is_error()) {
     logger.warning("SCHED: Cannot allocate SIB due to lack of PDCCH space.");
     return pdcch_result.error();
@@ -221,7 +221,7 @@ alloc_result bwp_slot_allocator::alloc_rar_and_msg3(uint16_t
   }
 
   // Allocate PDCCH position for RAR
-  auto pdcch_result = bwp_pdcch_slot.pdcchs.alloc_rar_pdcch(ra_rnti, aggr_idx);
+  auto pdcch_result = timed_pdcch_alloc([&]() { return bwp_pdcch_slot.pdcchs.alloc_rar_pdcch(ra_rnti, aggr_idx); });
   if (pdcch_result.is_error()) {
     // Could not find space in PDCCH
     return pdcch_result.error();
@@ -320,7 +320,8 @@ alloc_result bwp_slot_allocator::alloc_pdsch(slot_ue& ue, uint32_t ss_id, const
   // TODO
 
   // Find space and allocate PDCCH
-  auto pdcch_result = bwp_pdcch_slot.pdcchs.alloc_dl_pdcch(rnti_type, ss_id, aggr_idx, ue.cfg());
+  auto pdcch_result = timed_pdcch_alloc(
+      [&]() { return bwp_pdcch_slot.pdcchs.alloc_dl_pdcch(rnti_type, ss_id, aggr_idx, ue.cfg()); });
   if (pdcch_result.is_error()) {
     // Could not find space in PDCCH
     return pdcch_result.error();
@@ -445,7 +446,8 @@ alloc_result bwp_slot_allocator::alloc_pusch(slot_ue& ue, const prb_grant& ul_gr
     return ret;
   }
 
-  auto pdcch_result = bwp_pdcch_slot.pdcchs.alloc_ul_pdcch(ss.id, aggr_idx, ue.cfg());
+  auto pdcch_result = timed_pdcch_alloc(
+      [&]() { return bwp_pdcch_slot.pdcchs.alloc_ul_pdcch(ss.id, aggr_idx, ue.cfg()); });
   if (pdcch_result.is_error()) {
     // Could not find space in PDCCH
     return pdcch_result.error();
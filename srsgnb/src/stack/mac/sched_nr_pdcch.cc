@@ -120,7 +120,7 @@ bool coreset_region::alloc_pdcch(srsran_rnti_type_t         rnti_type,
     if (saved_dfs_tree.empty()) {
       saved_dfs_tree = dfs_tree;
     }
-  } while (get_next_dfs());
+  } while (get_next_dfs(record));
 
   // Revert steps to initial state, before dci record allocation was attempted
   dfs_tree.swap(saved_dfs_tree);
@@ -136,8 +136,12 @@ void coreset_region::rem_last_pdcch()
   dci_list.pop_back();
 }
 
-bool coreset_region::get_next_dfs()
+bool coreset_region::get_next_dfs(const alloc_record& failed_record)
 {
+  // The nodes after the last node blocking the failed record are erased, as other DCI positions for them cannot
+  // make room for it. They are placed again, starting from their first DCI position, after the blocking node moves
+  dfs_tree.erase(dfs_tree.begin() + get_nof_blocking_nodes(failed_record), dfs_tree.end());
+
   do {
     if (dfs_tree.empty()) {
       // If we reach root, the allocation failed
@@ -146,7 +150,15 @@ bool coreset_region::get_next_dfs()
     // Attempt to re-add last tree node, but with a higher node child index
     uint32_t start_child_idx = dfs_tree.back().dci_pos_idx + 1;
     dfs_tree.pop_back();
-    while (dfs_tree.size() < dci_list.size() and alloc_dfs_node(dci_list[dfs_tree.size()], start_child_idx)) {
+    while (dfs_tree.size() < dci_list.size()) {
+      const alloc_record& record = dci_list[dfs_tree.size()];
+      if (not alloc_dfs_node(record, start_child_idx)) {
+        if (start_child_idx == 0) {
+          // None of the DCI positions of the record fit. Jump back to the last node blocking it
+          dfs_tree.erase(dfs_tree.begin() + get_nof_blocking_nodes(record), dfs_tree.end());
+        }
+        break;
+      }
       start_child_idx = 0;
     }
   } while (dfs_tree.size() < dci_list.size());
@@ -155,6 +167,22 @@ bool coreset_region::get_next_dfs()
   return true;
 }
 
+size_t coreset_region::get_nof_blocking_nodes(const alloc_record& record) const
+{
+  // CCEs spanned by all the PDCCH candidates of the record
+  coreset_bitmap search_space_mask(nof_cces());
+  for (uint32_t ncce : get_cce_loc_table(record)) {
+    search_space_mask.fill(ncce, ncce + (1U << record.aggr_idx));
+  }
+
+  for (size_t i = dfs_tree.size(); i > 0; --i) {
+    if ((dfs_tree[i - 1].current_mask & search_space_mask).any()) {
+      return i;
+    }
+  }
+  return 0;
+}
+
 bool coreset_region::alloc_dfs_node(const alloc_record& record, uint32_t start_dci_idx)
 {
   alloc_tree_dfs_t& alloc_dfs = dfs_tree;
@@ -0,0 +1,293 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsgnb/hdr/stack/mac/sched_nr_time_pf.h"
+#include "srsran/phy/phch/ra_nr.h"
+#include <cmath>
+
+namespace srsenb {
+namespace sched_nr_impl {
+
+/// Weight of the last slot in the average rates
+static const float pf_exp_avg_alpha = 0.01;
+
+/// REs of a PRB left for PDSCH/PUSCH once the PDCCH and DMRS symbols are discounted. Only used to size grants
+static const uint32_t nof_re_per_prb = SRSRAN_NRE * (SRSRAN_NSYMB_PER_SLOT_NR - 3);
+
+/// Room left in new tx grants for the MAC subheaders
+static const uint32_t mac_overhead_bytes = 4;
+
+/// Spectral efficiency assumed for UEs that did not report a valid CQI
+static const float min_spectral_eff = 0.15;
+
+/// Prioritised bit rate of non-GBR bearers
+static const uint32_t pbr_infinity = -1;
+
+static float get_fairness_coeff(const sched_args_t& sched_args)
+{
+  return sched_args.sched_policy_args.empty() ? 1 : std::stof(sched_args.sched_policy_args);
+}
+
+/// Bits per RE of a fixed MCS, or of the reported CQI if the MCS is dynamic
+static float get_spectral_eff(const slot_ue& ue, int mcs, uint32_t cqi, bool is_dl)
+{
+  const srsran_search_space_type_t ss_type = srsran_search_space_type_ue;
+  const srsran_rnti_type_t         rnti    = srsran_rnti_type_c;
+
+  double se = 0;
+  if (mcs >= 0) {
+    srsran_mcs_table_t     mcs_table = is_dl ? ue->phy().pdsch.mcs_table : ue->phy().pusch.mcs_table;
+    srsran_dci_format_nr_t dci_fmt   = is_dl ? srsran_dci_format_nr_1_0 : srsran_dci_format_nr_0_0;
+    srsran_mod_t           mod       = srsran_ra_nr_mod_from_mcs(mcs_table, dci_fmt, ss_type, rnti, mcs);
+
+    se = srsran_ra_nr_R_from_mcs(mcs_table, dci_fmt, ss_type, rnti, mcs) * srsran_mod_bits_x_symbol(mod);
+  } else if (cqi < 16) {
+    se = srsran_ra_nr_cqi_to_se(cqi, ue->phy().csi.reports->cqi_table);
+  }
+  return std::isnormal(se) ? std::max((float)se, min_spectral_eff) : min_spectral_eff;
+}
+
+/// Number of PRBs needed to transmit nof_bytes
+static uint32_t get_nof_prbs(uint32_t nof_bytes, float bytes_per_prb)
+{
+  return static_cast<uint32_t>(std::ceil((nof_bytes + mac_overhead_bytes) / bytes_per_prb));
+}
+
+sched_nr_time_pf::sched_nr_time_pf(const bwp_params_t& bwp_cfg_) :
+  bwp_cfg(bwp_cfg_), fairness_coeff(get_fairness_coeff(bwp_cfg_.sched_cfg))
+{
+  dl_queue.reserve(SRSENB_MAX_UES);
+  ul_queue.reserve(SRSENB_MAX_UES);
+}
+
+void sched_nr_time_pf::new_slot(slot_ue_map_t& ue_db, slot_point pdcch_slot)
+{
+  current_slot = pdcch_slot;
+  dl_queue.clear();
+  ul_queue.clear();
+
+  // remove deleted users from history
+  for (auto it = ue_history_db.begin(); it != ue_history_db.end();) {
+    if (not ue_db.contains(it->first)) {
+      it = ue_history_db.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  // add new users to history db, and gather the UEs with pending data
+  for (auto& u : ue_db) {
+    auto it = ue_history_db.find(u.first);
+    if (it == ue_history_db.end()) {
+      it = ue_history_db.insert(u.first, ue_ctxt{u.first}).value();
+    }
+    ue_ctxt& ctxt = it->second;
+    ctxt.new_slot(bwp_cfg, u.second, fairness_coeff);
+    if (ctxt.dl_retx or ctxt.dl_newtx) {
+      dl_queue.push_back(&ctxt);
+    }
+    if (ctxt.ul_retx or ctxt.ul_newtx) {
+      ul_queue.push_back(&ctxt);
+    }
+  }
+}
+
+void sched_nr_time_pf::sched_dl_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  if (current_slot != slot_alloc.get_pdcch_tti()) {
+    new_slot(ue_db, slot_alloc.get_pdcch_tti());
+  }
+
+  // Allocate UEs in decreasing priority order, until there are no PRBs left
+  ue_dl_prio_compare cmp;
+  std::make_heap(dl_queue.begin(), dl_queue.end(), cmp);
+  auto heap_end = dl_queue.end();
+  while (heap_end != dl_queue.begin()) {
+    std::pop_heap(dl_queue.begin(), heap_end, cmp);
+    --heap_end;
+    ue_ctxt&     ue  = **heap_end;
+    alloc_result ret = alloc_dl_ue(ue, slot_alloc);
+    if (ret == alloc_result::no_sch_space and not ue.dl_retx) {
+      break;
+    }
+  }
+  for (ue_ctxt* ue : dl_queue) {
+    ue->dl_rate.save_alloc(ue->dl_alloc);
+  }
+}
+
+void sched_nr_time_pf::sched_ul_users(slot_ue_map_t& ue_db, bwp_slot_allocator& slot_alloc)
+{
+  if (current_slot != slot_alloc.get_pdcch_tti()) {
+    new_slot(ue_db, slot_alloc.get_pdcch_tti());
+  }
+
+  ue_ul_prio_compare cmp;
+  std::make_heap(ul_queue.begin(), ul_queue.end(), cmp);
+  auto heap_end = ul_queue.end();
+  while (heap_end != ul_queue.begin()) {
+    std::pop_heap(ul_queue.begin(), heap_end, cmp);
+    --heap_end;
+    ue_ctxt&     ue  = **heap_end;
+    alloc_result ret = alloc_ul_ue(ue, slot_alloc);
+    if (ret == alloc_result::no_sch_space and not ue.ul_retx) {
+      break;
+    }
+  }
+  for (ue_ctxt* ue : ul_queue) {
+    ue->ul_rate.save_alloc(ue->ul_alloc);
+  }
+}
+
+alloc_result sched_nr_time_pf::alloc_dl_ue(ue_ctxt& ctxt, bwp_slot_allocator& slot_alloc)
+{
+  static const srsran_dci_format_nr_t dci_fmt = srsran_dci_format_nr_1_0;
+
+  slot_ue& ue    = *ctxt.ue;
+  int      ss_id = ue->find_ss_id(dci_fmt);
+  if (ss_id < 0) {
+    return alloc_result::no_cch_space;
+  }
+
+  alloc_result ret;
+  if (ctxt.dl_retx) {
+    ret = slot_alloc.alloc_pdsch(ue, ss_id, ue.h_dl->prbs());
+  } else {
+    // Take the PRBs needed for the pending bytes, or the largest interval left
+    prb_bitmap   used_prbs = slot_alloc.occupied_dl_prbs(ue.pdsch_slot, ss_id, dci_fmt);
+    prb_interval prbs = find_empty_interval_of_length(used_prbs, get_nof_prbs(ue.dl_bytes, ctxt.dl_bytes_per_prb));
+    if (prbs.empty()) {
+      return alloc_result::no_sch_space;
+    }
+    ret = slot_alloc.alloc_pdsch(ue, ss_id, prbs);
+  }
+  if (ret == alloc_result::success) {
+    ctxt.dl_alloc = ue.h_dl->tbs() / 8;
+  }
+  return ret;
+}
+
+alloc_result sched_nr_time_pf::alloc_ul_ue(ue_ctxt& ctxt, bwp_slot_allocator& slot_alloc)
+{
+  slot_ue& ue = *ctxt.ue;
+
+  alloc_result ret;
+  if (ctxt.ul_retx) {
+    ret = slot_alloc.alloc_pusch(ue, ue.h_ul->prbs());
+  } else {
+    const prb_bitmap& used_prbs = slot_alloc.occupied_ul_prbs(ue.pusch_slot);
+    prb_interval      prbs = find_empty_interval_of_length(used_prbs, get_nof_prbs(ue.ul_bytes, ctxt.ul_bytes_per_prb));
+    if (prbs.empty()) {
+      return alloc_result::no_sch_space;
+    }
+    ret = slot_alloc.alloc_pusch(ue, prbs);
+  }
+  if (ret == alloc_result::success) {
+    ctxt.ul_alloc = ue.h_ul->tbs() / 8;
+  }
+  return ret;
+}
+
+/*****************************************************************
+ *                          UE history
+ *****************************************************************/
+
+void sched_nr_time_pf::ue_ctxt::new_slot(const bwp_params_t& bwp_cfg, slot_ue& u, float fairness_coeff)
+{
+  slot_point slot_rx = u.pdcch_slot - TX_ENB_DELAY;
+
+  ue         = &u;
+  dl_alloc   = 0;
+  ul_alloc   = 0;
+  dl_retx    = u.h_dl != nullptr and u.h_dl->has_pending_retx(slot_rx);
+  dl_newtx   = not dl_retx and u.h_dl != nullptr and u.h_dl->empty() and u.dl_bytes > 0;
+  ul_retx    = u.h_ul != nullptr and u.h_ul->has_pending_retx(slot_rx);
+  ul_newtx   = not ul_retx and u.h_ul != nullptr and u.h_ul->empty() and u.ul_bytes > 0;
+  dl_gbr     = false;
+  dl_lc_prio = std::numeric_limits<int>::max();
+  dl_prio    = 0;
+  ul_prio    = 0;
+
+  // The expected rate is the one of the whole BWP, as in the time domain only the order of the UEs matters
+  auto pf_prio = [fairness_coeff](float r, const avg_rate& rate) {
+    return rate.avg > 0 ? r / std::pow(rate.avg, fairness_coeff) : std::numeric_limits<float>::max();
+  };
+
+  // Calculate DL QoS and PF priorities
+  if (dl_newtx) {
+    dl_bytes_per_prb = get_spectral_eff(u, u->fixed_pdsch_mcs(), u.dl_cqi(), true) * nof_re_per_prb / 8;
+    dl_prio          = pf_prio(dl_bytes_per_prb * bwp_cfg.cfg.rb_width, dl_rate);
+
+    // The highest priority bearer with pending data sets the QoS of the UE
+    const auto& bearers   = u->ue_cfg().ue_bearers;
+    float       gbr_bytes = 0;
+    for (uint32_t lcid = 0; lcid < bearers.size(); ++lcid) {
+      if (bearers[lcid].is_dl() and u.get_pending_bytes(lcid) > 0) {
+        dl_lc_prio = std::min(dl_lc_prio, bearers[lcid].priority);
+        if (bearers[lcid].pbr != pbr_infinity) {
+          gbr_bytes += bearers[lcid].pbr;
+        }
+      }
+    }
+    // The prioritised bit rate is given in kBps, i.e. bytes per ms
+    uint32_t slots_per_ms = 1U << bwp_cfg.cfg.numerology_idx;
+    dl_gbr                = gbr_bytes > 0 and dl_rate.avg < gbr_bytes / slots_per_ms;
+  }
+
+  // Calculate UL PF priority
+  if (ul_newtx) {
+    ul_bytes_per_prb = get_spectral_eff(u, u->fixed_pusch_mcs(), u.ul_cqi(), false) * nof_re_per_prb / 8;
+    ul_prio          = pf_prio(ul_bytes_per_prb * bwp_cfg.cfg.rb_width, ul_rate);
+  }
+}
+
+void sched_nr_time_pf::avg_rate::save_alloc(uint32_t alloc_bytes)
+{
+  if (nof_samples < 1 / pf_exp_avg_alpha) {
+    // fast start
+    avg = avg + (alloc_bytes - avg) / (nof_samples + 1);
+  } else {
+    avg = (1 - pf_exp_avg_alpha) * avg + pf_exp_avg_alpha * alloc_bytes;
+  }
+  nof_samples++;
+}
+
+bool sched_nr_time_pf::ue_dl_prio_compare::operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const
+{
+  if (lhs->dl_retx != rhs->dl_retx) {
+    return rhs->dl_retx;
+  }
+  if (lhs->dl_gbr != rhs->dl_gbr) {
+    return rhs->dl_gbr;
+  }
+  if (lhs->dl_lc_prio != rhs->dl_lc_prio) {
+    return lhs->dl_lc_prio > rhs->dl_lc_prio;
+  }
+  return lhs->dl_prio < rhs->dl_prio;
+}
+
+bool sched_nr_time_pf::ue_ul_prio_compare::operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const
+{
+  return (not lhs->ul_retx and rhs->ul_retx) or (lhs->ul_retx == rhs->ul_retx and lhs->ul_prio < rhs->ul_prio);
+}
+
+} // namespace sched_nr_impl
+} // namespace srsenb
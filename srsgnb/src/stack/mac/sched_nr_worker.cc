@@ -111,6 +111,8 @@ dl_sched_res_t* cc_worker::run_slot(slot_point tx_sl, ue_map_t& ue_db)
   // releases UE resources
   slot_ues.clear();
 
+  pdcch_latency.record(bwp_alloc.get_pdcch_alloc_time());
+
   return &bwp_alloc.tx_slot_grid().dl;
 }
 
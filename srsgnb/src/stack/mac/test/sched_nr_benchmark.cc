@@ -0,0 +1,193 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_nr_cfg_generators.h"
+#include "sched_nr_sim_ue.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+
+/*
+ * Measures the latency of the NR scheduler to generate a slot result as the number of UEs grows, for the RR and PF
+ * policies, and checks that the PF policy serves several UEs per slot and respects the bearer priorities.
+ */
+
+namespace srsenb {
+
+class sched_nr_bench_tester : public sched_nr_base_test_bench
+{
+public:
+  using sched_nr_base_test_bench::sched_nr_base_test_bench;
+
+  void process_slot_result(const sim_nr_enb_ctxt_t& slot_ctxt, srsran::const_span<cc_result_t> cc_list) override
+  {
+    for (auto& cc_out : cc_list) {
+      uint64_t latency_ns = cc_out.cc_latency_ns.count();
+      tot_latency_ns += latency_ns;
+      max_latency_ns = std::max(max_latency_ns, latency_ns);
+      nof_cc_results++;
+
+      uint32_t nof_ue_pdschs = 0;
+      for (auto& pdsch : cc_out.res.dl->phy.pdsch) {
+        if (pdsch.sch.grant.rnti_type == srsran_rnti_type_c) {
+          dl_bytes[pdsch.sch.grant.rnti] += pdsch.sch.grant.tb[0].tbs / 8u;
+          nof_ue_pdschs++;
+        }
+      }
+      if (nof_ue_pdschs > 0) {
+        nof_pdschs += nof_ue_pdschs;
+        nof_dl_slots++;
+      }
+      max_pdschs_per_slot = std::max(max_pdschs_per_slot, nof_ue_pdschs);
+    }
+  }
+
+  double avg_latency_usec() const { return tot_latency_ns / 1000.0 / std::max(nof_cc_results, 1U); }
+
+  uint64_t                     tot_latency_ns      = 0;
+  uint64_t                     max_latency_ns      = 0;
+  uint32_t                     nof_cc_results      = 0;
+  uint32_t                     nof_pdschs          = 0;
+  uint32_t                     nof_dl_slots        = 0;
+  uint32_t                     max_pdschs_per_slot = 0;
+  std::map<uint16_t, uint64_t> dl_bytes;
+};
+
+static const uint16_t first_rnti = 0x4601;
+static const uint32_t drb_lcid   = 4;
+
+sched_nr_interface::ue_cfg_t get_bench_ue_cfg(int drb_priority)
+{
+  sched_nr_interface::ue_cfg_t uecfg = get_default_ue_cfg(1);
+  uecfg.lc_ch_to_add.emplace_back();
+  uecfg.lc_ch_to_add.back().lcid          = drb_lcid;
+  uecfg.lc_ch_to_add.back().cfg.direction = mac_lc_ch_cfg_t::BOTH;
+  uecfg.lc_ch_to_add.back().cfg.priority  = drb_priority;
+  return uecfg;
+}
+
+/// Runs nof_slots in which the UEs get dl_bytes_per_slot[i] new DL bytes per slot each
+void run_slots(sched_nr_bench_tester& tester, const std::vector<uint32_t>& dl_bytes_per_slot, uint32_t nof_slots)
+{
+  for (uint32_t nof_slot = 0; nof_slot < nof_slots; ++nof_slot) {
+    slot_point slot_rx(0, nof_slot % 10240);
+    slot_point slot_tx = slot_rx + TX_ENB_DELAY;
+    if (nof_slot > 10) {
+      for (uint32_t i = 0; i < dl_bytes_per_slot.size(); ++i) {
+        tester.add_rlc_dl_bytes(first_rnti + i, drb_lcid, dl_bytes_per_slot[i]);
+      }
+    }
+    tester.run_slot(slot_tx);
+  }
+  tester.stop();
+}
+
+void bench_slot_latency(const std::string& policy, uint32_t nof_ues)
+{
+  uint32_t nof_slots = 2000;
+
+  sched_nr_interface::sched_args_t cfg;
+  cfg.sched_policy = policy;
+  std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(1);
+
+  sched_nr_bench_tester tester(cfg, cells_cfg, fmt::format("{} with {} UEs", policy, nof_ues));
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    tester.user_cfg(first_rnti + i, get_bench_ue_cfg(1));
+  }
+
+  // The offered load is below the cell capacity, so that every UE gets served
+  std::vector<uint32_t> dl_bytes_per_slot(nof_ues, 1500 / nof_ues);
+  run_slots(tester, dl_bytes_per_slot, nof_slots);
+
+  uint64_t min_bytes = std::numeric_limits<uint64_t>::max();
+  for (uint32_t i = 0; i < nof_ues; ++i) {
+    min_bytes = std::min(min_bytes, tester.dl_bytes[first_rnti + i]);
+  }
+  fmt::print("{:>8} {:>8} {:>14.2f} {:>14.2f} {:>16.2f} {:>14}\n",
+             policy,
+             nof_ues,
+             tester.avg_latency_usec(),
+             tester.max_latency_ns / 1000.0,
+             tester.nof_pdschs / (double)std::max(tester.nof_dl_slots, 1U),
+             min_bytes);
+
+  // No UE is starved
+  TESTASSERT(min_bytes > 0);
+  if (policy == "time_pf" and nof_ues > 1) {
+    // The PRBs left by a UE are given to other UEs in the same slot
+    TESTASSERT(tester.max_pdschs_per_slot > 1);
+  }
+}
+
+void test_pf_bearer_priority()
+{
+  uint32_t nof_slots = 2000;
+
+  sched_nr_interface::sched_args_t cfg;
+  cfg.sched_policy = "time_pf";
+  std::vector<sched_nr_cell_cfg_t> cells_cfg = get_default_cells_cfg(1);
+
+  sched_nr_bench_tester tester(cfg, cells_cfg, "PF bearer priority");
+  // The first UE has a low priority bearer with more data than the cell can carry
+  tester.user_cfg(first_rnti, get_bench_ue_cfg(10));
+  // The second UE has a high priority bearer with a moderate rate
+  tester.user_cfg(first_rnti + 1, get_bench_ue_cfg(2));
+
+  std::vector<uint32_t> dl_bytes_per_slot = {20000, 400};
+  run_slots(tester, dl_bytes_per_slot, nof_slots);
+
+  // The high priority UE is served in spite of its PF metric, which drops as it gets served
+  uint64_t offered_bytes = (nof_slots - 11) * dl_bytes_per_slot[1];
+  TESTASSERT(tester.dl_bytes[first_rnti + 1] >= offered_bytes * 9 / 10);
+  TESTASSERT(tester.dl_bytes[first_rnti] > 0);
+}
+
+} // namespace srsenb
+
+int main()
+{
+  auto& test_logger = srslog::fetch_basic_logger("TEST");
+  test_logger.set_level(srslog::basic_levels::warning);
+  auto& mac_nr_logger = srslog::fetch_basic_logger("MAC-NR");
+  // Many UEs exceed the PUCCH capacity of the default cell config, which is not what is measured here
+  mac_nr_logger.set_level(srslog::basic_levels::error);
+
+  // Start the log backend.
+  srslog::init();
+
+  fmt::print("{:>8} {:>8} {:>14} {:>14} {:>16} {:>14}\n",
+             "policy",
+             "nof_ues",
+             "avg_slot_usec",
+             "max_slot_usec",
+             "pdschs_per_slot",
+             "min_ue_bytes");
+  for (const char* policy : {"time_rr", "time_pf"}) {
+    for (uint32_t nof_ues : {1, 4, 16, 32}) {
+      srsenb::bench_slot_latency(policy, nof_ues);
+    }
+  }
+
+  srsenb::test_pf_bearer_priority();
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
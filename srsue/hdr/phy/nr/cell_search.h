@@ -40,6 +40,7 @@ public:
     double                      srate_hz;
     double                      center_freq_hz;
     double                      ssb_freq_hz;
+    std::vector<double>         other_ssb_freq_hz; ///< Additional SSB center frequencies searched in the same slot
     srsran_subcarrier_spacing_t ssb_scs;
     srsran_ssb_pattern_t        ssb_pattern;
     srsran_duplex_mode_t        duplex_mode;
@@ -48,6 +49,7 @@ public:
   struct ret_t {
     enum { CELL_FOUND = 1, CELL_NOT_FOUND = 0, ERROR = -1 } result;
     srsran_ssb_search_res_t ssb_res;
+    double                  ssb_freq_hz; ///< SSB center frequency the cell was found at
   };
 
   cell_search(srslog::basic_logger& logger);
@@ -59,8 +61,13 @@ public:
   ret_t run_slot(const cf_t* buffer, uint32_t slot_sz);
 
 private:
-  srslog::basic_logger&        logger;
-  srsran_ssb_t                 ssb    = {};
+  ret_t run_slot_multi(const cf_t* buffer, uint32_t slot_sz);
+
+  srslog::basic_logger&                                               logger;
+  srsran_ssb_t                                                        ssb         = {};
+  uint32_t                                                            nof_freq    = 0;
+  std::array<double, SRSRAN_SSB_SEARCH_MAX_NOF_FREQ>                  ssb_freq_hz = {};
+  std::array<srsran_ssb_search_res_t, SRSRAN_SSB_SEARCH_MAX_NOF_FREQ> ssb_res     = {};
 };
 } // namespace nr
 } // namespace srsue
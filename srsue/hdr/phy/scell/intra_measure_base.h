@@ -27,11 +27,14 @@
 #include <srsran/common/common.h>
 #include <srsran/common/threads.h>
 #include <srsran/common/tti_sync_cv.h>
+#include <srsran/phy/resampling/resampler.h>
 #include <vector>
 
 namespace srsue {
 namespace scell {
 
+class intra_measure_runner;
+
 /**
  * @brief Describes a generic base class to perform intra-frequency measurements
  */
@@ -76,12 +79,14 @@ public:
    * @brief Describes the default generic configuration arguments
    */
   struct args_t {
-    double   srate_hz          = 0.0;  ///< Sampling rate in Hz, optional for LTE, compulsory for NR
-    uint32_t len_ms            = 20;   ///< Amount of time to accumulate
-    uint32_t period_ms         = 200;  ///< Minimum time interval between measurements, set to 0 for free-run
-    uint32_t tti_period        = 0;    ///< Measurement TTI trigger period, set to 0 to trigger at any TTI
-    uint32_t tti_offset        = 0;    ///< Measurement TTI trigger offset
-    float    rx_gain_offset_db = 0.0f; ///< Gain offset, for calibrated measurements
+    double                srate_hz          = 0.0;     ///< Sampling rate in Hz, optional for LTE, compulsory for NR
+    uint32_t              len_ms            = 20;      ///< Amount of time to accumulate
+    uint32_t              period_ms         = 200;     ///< Minimum time interval between measurements, 0 for free-run
+    uint32_t              tti_period        = 0;       ///< Measurement TTI trigger period, 0 to trigger at any TTI
+    uint32_t              tti_offset        = 0;       ///< Measurement TTI trigger offset
+    float                 rx_gain_offset_db = 0.0f;    ///< Gain offset, for calibrated measurements
+    bool                  channelizer       = false;   ///< Store only the sync signal bandwidth, LTE only
+    intra_measure_runner* runner            = nullptr; ///< Shared measurement thread, null for a dedicated thread
   };
 
   /**
@@ -141,6 +146,7 @@ protected:
     uint32_t           meas_period_ms     = 200; ///< Minimum time between measurements
     uint32_t           trigger_tti_period = 0;   ///< Measurement TTI trigger period
     uint32_t           trigger_tti_offset = 0;   ///< Measurement TTI trigger offset
+    uint32_t           decimation         = 1;   ///< Channelizer decimation of the stored samples
     meas_itf&          new_cell_itf;
 
     explicit measure_context_t(meas_itf& new_cell_itf_) : new_cell_itf(new_cell_itf_) {}
@@ -175,6 +181,19 @@ protected:
     context.sf_len = new_sf_len;
   }
 
+  /**
+   * @brief Configures the channelizer that extracts the synchronization signal bandwidth before storing the samples.
+   * The inherited class shall provide the subframe length after decimation through set_current_sf_len()
+   * @param decimation Integer decimation factor, set to 1 for storing the full band
+   * @return True if the configuration is successful, otherwise false
+   */
+  bool set_channelizer(uint32_t decimation);
+
+  /**
+   * @brief Get whether the channelizer has been enabled in the configuration arguments
+   */
+  bool channelizer_enabled() const { return channelizer_en; }
+
 private:
   /**
    * @brief Describes the internal state class, provides thread safe state management
@@ -265,6 +284,14 @@ private:
    */
   void write(cf_t* data, uint32_t nsamples);
 
+  /**
+   * @brief Filters and decimates baseband data into the channelizer buffer
+   * @param data Provides baseband data
+   * @param nsamples Number of samples to process
+   * @return The number of decimated samples
+   */
+  uint32_t channelize(const cf_t* data, uint32_t nsamples);
+
   /**
    * @brief Get the Radio Access Technology (RAT) that is being measured
    * @return The measured RAT
@@ -293,6 +320,13 @@ private:
    */
   void run_thread() override;
 
+  /**
+   * @brief Runs the measurement process if there is one pending, called from a shared runner thread
+   */
+  void run_pending();
+
+  friend class intra_measure_runner;
+
   ///< Internal Thread priority, low by default
   const static int INTRA_FREQ_MEAS_PRIO = DEFAULT_PRIORITY + 5;
 
@@ -311,6 +345,51 @@ private:
 
   std::vector<cf_t>   search_buffer;
   srsran_ringbuffer_t ring_buffer = {};
+
+  /// Channelizer, protected by the mutex
+  bool                         channelizer_en = false; ///< Set by the configuration arguments
+  uint32_t                     decimation     = 1;     ///< Current decimation factor, 1 if disabled
+  srsran_resampler_polyphase_t decimator      = {};
+  std::vector<cf_t>            channel_buffer;
+
+  intra_measure_runner* runner = nullptr; ///< Shared thread, null if the measurements run in this thread
+};
+
+/**
+ * @brief Runs the measurements of several intra_measure_base instances (one per carrier) in a single thread, which can
+ * be pinned to a dedicated low priority core
+ */
+class intra_measure_runner : public srsran::thread
+{
+public:
+  intra_measure_runner() : thread("SYNC_INTRA_MEASURE") {}
+
+  ~intra_measure_runner() override { stop(); }
+
+  /**
+   * @brief Starts the shared measurement thread
+   * @param cpu Core index the thread is pinned to, set to a negative value for no affinity
+   */
+  void init(int cpu);
+
+  /**
+   * @brief Stops the shared measurement thread, it waits for the current measurement to finish
+   */
+  void stop();
+
+private:
+  friend class intra_measure_base;
+
+  void add(intra_measure_base* q);
+  void notify();
+  void run_thread() override;
+
+  std::mutex                        mutex;
+  std::condition_variable           cvar;
+  std::vector<intra_measure_base*> measures;
+  uint32_t                          pending = 0;
+  bool                              running = false;
+  bool                              quit    = false;
 };
 
 } // namespace scell
@@ -81,8 +81,12 @@ private:
    */
   bool measure_rat(const measure_context_t& context, std::vector<cf_t>& buffer, float rx_gain_offset) override;
 
+  /// Bandwidth stored by the channelizer, the central PRB carry PSS/SSS and are enough for CRS based measurements
+  const static uint32_t CHANNELIZER_NOF_PRB = 6;
+
   srslog::basic_logger& logger;
   srsran_cell_t         serving_cell   = {};  ///< Current serving cell in the EARFCN, to avoid reporting it
+  uint32_t              meas_nof_prb   = 0;   ///< Number of PRB in the stored baseband
   std::atomic<uint32_t> current_earfcn = {0}; ///< Current EARFCN
   std::mutex            mutex;
 
@@ -215,6 +215,7 @@ private:
   search                                                  search_p;
   sfn_sync                                                sfn_p;
   std::vector<std::unique_ptr<scell::intra_measure_lte> > intra_freq_meas;
+  scell::intra_measure_runner                             intra_freq_runner;
   std::mutex                                              intra_freq_cfg_mutex;
 
   // Pointers to other classes
@@ -30,6 +30,7 @@
 #include "srsran/interfaces/ue_gw_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include "tft_packet_filter.h"
+#include "tun_offload.h"
 #include <atomic>
 #include <mutex>
 #include <net/if.h>
@@ -47,6 +48,7 @@ struct gw_args_t {
   std::string netns;
   std::string tun_dev_name;
   std::string tun_dev_netmask;
+  bool        tun_offload = false;
 };
 
 class gw : public gw_interface_stack, public srsran::thread
@@ -73,8 +75,12 @@ public:
   void add_mch_port(uint32_t lcid, uint32_t port);
   bool is_running();
 
+  // Stack interface
+  void run_tti();
+
 private:
-  static const int GW_THREAD_PRIO = -1;
+  static const int      GW_THREAD_PRIO = -1;
+  static const uint32_t UL_BATCH_SIZE  = 32;
 
   stack_interface_gw* stack = nullptr;
 
@@ -102,6 +108,7 @@ private:
   std::chrono::high_resolution_clock::time_point metrics_tp; // stores time when last metrics have been taken
 
   void run_thread();
+  int  read_tun(std::vector<srsran::unique_byte_buffer_t>& pdus);
   int  init_if(char* err_str);
   int  setup_if_addr4(uint32_t ip_addr, char* err_str);
   int  setup_if_addr6(uint8_t* ipv6_if_id, char* err_str);
@@ -115,6 +122,11 @@ private:
 
   // TFT
   tft_pdu_matcher tft_matcher;
+
+  // TUN offloads
+  std::vector<uint8_t> tun_rx_frame; // Scratch buffer for a frame of up to 64 KB
+  std::mutex           dl_mutex;
+  tun_tx_coalescer     dl_coalescer;
 };
 
 } // namespace srsue
@@ -22,6 +22,7 @@
 #ifndef SRSUE_PACKET_FILTER_H
 #define SRSUE_PACKET_FILTER_H
 
+#include "srsran/adt/flat_hash_map.h"
 #include "srsran/asn1/liblte_mme.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/srslog/srslog.h"
@@ -63,6 +64,30 @@ const uint8_t IPV6_ADDR_SIZE = 16;
 const uint8_t UDP_PROTOCOL   = 0x11;
 const uint8_t TCP_PROTOCOL   = 0x06;
 
+/**
+ * Header fields of an outgoing IP packet that the packet filters look at. Addresses and ports are kept in network
+ * byte order, IPv4 addresses use the first 4 bytes of the address arrays. All the packets of a flow share the same
+ * key, so the key is what the filter result is cached against.
+ */
+struct tft_flow_key_t {
+  uint8_t  version                  = 0;
+  uint8_t  protocol                 = 0;
+  uint8_t  type_of_service          = 0;
+  uint16_t src_port                 = 0;
+  uint16_t dst_port                 = 0;
+  uint8_t  src_addr[IPV6_ADDR_SIZE] = {};
+  uint8_t  dst_addr[IPV6_ADDR_SIZE] = {};
+
+  /// Returns false if the packet is not a valid IPv4 or IPv6 packet
+  bool parse(const srsran::byte_buffer_t& pdu);
+
+  bool operator==(const tft_flow_key_t& other) const;
+};
+
+struct tft_flow_key_hasher {
+  size_t operator()(const tft_flow_key_t& key) const;
+};
+
 // TS 24.008 Table 10.5.162
 class tft_packet_filter_t
 {
@@ -71,6 +96,7 @@ public:
                       const LIBLTE_MME_PACKET_FILTER_STRUCT& tft_,
                       srslog::basic_logger&                  logger);
   bool match(const srsran::unique_byte_buffer_t& pdu);
+  bool match(const tft_flow_key_t& key);
   bool filter_contains(uint16_t filtertype);
 
   uint8_t  eps_bearer_id             = {};
@@ -99,15 +125,17 @@ public:
 
   srslog::basic_logger& logger;
 
-  bool match_ip(const srsran::unique_byte_buffer_t& pdu);
-  bool match_protocol(const srsran::unique_byte_buffer_t& pdu);
-  bool match_type_of_service(const srsran::unique_byte_buffer_t& pdu);
+  bool match_ip(const tft_flow_key_t& key);
+  bool match_protocol(const tft_flow_key_t& key);
+  bool match_type_of_service(const tft_flow_key_t& key);
   bool match_flow_label(const srsran::unique_byte_buffer_t& pdu);
-  bool match_port(const srsran::unique_byte_buffer_t& pdu);
+  bool match_port(const tft_flow_key_t& key);
 };
 
 /**
- * TFT PDU matcher class used by GW and TTCN3 DUT testloop handler
+ * TFT PDU matcher class used by GW and TTCN3 DUT testloop handler.
+ * The result of the filters is cached per flow, so that the filters are evaluated for the first packet of a flow only.
+ * The cache is dropped whenever the filters change.
  */
 class tft_pdu_matcher
 {
@@ -122,11 +150,17 @@ public:
                                       const LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT* tft);
   void    delete_tft_for_eps_bearer(const uint8_t eps_bearer_id);
 
+  size_t nof_cached_flows();
+
 private:
-  srslog::basic_logger&                           logger;
-  std::mutex                                      tft_mutex;
-  typedef std::map<uint16_t, tft_packet_filter_t> tft_filter_map_t;
-  tft_filter_map_t                                tft_filter_map;
+  static const size_t  max_cached_flows = 1024;
+  static const uint8_t no_match         = 0xff;
+
+  srslog::basic_logger&                                               logger;
+  std::mutex                                                          tft_mutex;
+  typedef std::map<uint16_t, tft_packet_filter_t>                     tft_filter_map_t;
+  tft_filter_map_t                                                    tft_filter_map;
+  srsran::flat_hash_map<tft_flow_key_t, uint8_t, tft_flow_key_hasher> flow_cache;
 };
 
 } // namespace srsue
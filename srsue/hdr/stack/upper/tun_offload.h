@@ -0,0 +1,122 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSUE_TUN_OFFLOAD_H
+#define SRSUE_TUN_OFFLOAD_H
+
+#include "srsran/common/buffer_pool.h"
+#include "srsran/srslog/srslog.h"
+#include <array>
+#include <sys/uio.h>
+#include <vector>
+
+/**
+ * Helpers for a TUN device opened with IFF_VNET_HDR. Every frame exchanged with such a device starts with a
+ * virtio_net_hdr, which lets the kernel hand over TCP super-packets of up to 64 KB (TSO) and take them back (GSO),
+ * instead of one read() or write() per MTU-sized packet.
+ */
+
+namespace srsue {
+
+/// Layout of struct virtio_net_hdr. linux/virtio_net.h can't be included from C++
+struct tun_vnet_hdr_t {
+  uint8_t  flags;
+  uint8_t  gso_type;
+  uint16_t hdr_len;
+  uint16_t gso_size;
+  uint16_t csum_start;
+  uint16_t csum_offset;
+};
+
+const uint8_t TUN_VNET_F_NEEDS_CSUM = 1;
+const uint8_t TUN_VNET_GSO_NONE     = 0;
+const uint8_t TUN_VNET_GSO_TCPV4    = 1;
+const uint8_t TUN_VNET_GSO_TCPV6    = 4;
+const uint8_t TUN_VNET_GSO_ECN      = 0x80;
+
+/// One's complement sum of len bytes, added to sum. Not folded
+uint32_t tun_csum_partial(const uint8_t* data, uint32_t len, uint32_t sum = 0);
+
+/// Folds a one's complement sum to 16 bits. Not inverted
+uint16_t tun_csum_fold(uint32_t sum);
+
+/// Sum of the TCP/UDP pseudo-header of the IPv4 or IPv6 packet ip_pkt, for an L4 segment of l4_len bytes
+uint32_t tun_pseudo_hdr_sum(const uint8_t* ip_pkt, uint32_t l4_len, uint8_t protocol);
+
+/**
+ * Splits a frame read from the TUN device into IP packets, which are appended to pdus. Super-packets flagged for TCP
+ * segmentation are cut into gso_size segments with their own IP and TCP headers, and the checksums that the kernel
+ * left to the device (TUN_VNET_F_NEEDS_CSUM) are completed.
+ * @return number of packets appended to pdus
+ */
+uint32_t tun_split_frame(const uint8_t*                             frame,
+                         uint32_t                                   len,
+                         std::vector<srsran::unique_byte_buffer_t>& pdus,
+                         srslog::basic_logger&                      logger);
+
+/**
+ * Merges consecutive in-order segments of a TCP flow into a single frame, which the kernel receives as one GSO packet.
+ * Segments are merged only if they differ in nothing but their sequence number, payload and checksums, like the GRO
+ * of the kernel does. Any other packet is written to the TUN device as it is.
+ */
+class tun_tx_coalescer
+{
+public:
+  static const uint32_t max_segments = 64;
+
+  explicit tun_tx_coalescer(srslog::basic_logger& logger_) : logger(logger_) {}
+
+  void set_fd(int fd_) { fd = fd_; }
+
+  /// Queues an IP packet. Packets that cannot be merged are written right away, after the queued segments
+  void push(srsran::unique_byte_buffer_t pdu);
+
+  /// Writes the queued segments. Returns the number of frames written
+  uint32_t flush();
+
+  uint32_t size() const { return nof_segments; }
+
+private:
+  struct tcp_segment_t {
+    uint32_t ip_hlen;
+    uint32_t hlen;
+    uint32_t payload_len;
+    uint32_t seq;
+    uint8_t  flags;
+  };
+
+  bool parse_segment(const srsran::byte_buffer_t& pdu, tcp_segment_t& seg) const;
+  bool can_merge(const srsran::byte_buffer_t& pdu, const tcp_segment_t& seg) const;
+  bool write_frame(const tun_vnet_hdr_t& vnet_hdr, iovec* iov, uint32_t nof_iov, uint32_t nof_bytes);
+  void write_single(const srsran::byte_buffer_t& pdu);
+
+  srslog::basic_logger&                                  logger;
+  int                                                    fd           = -1;
+  uint32_t                                               nof_segments = 0;
+  tcp_segment_t                                          first        = {};
+  uint32_t                                               next_seq     = 0;
+  uint32_t                                               nof_payload  = 0;
+  std::array<srsran::unique_byte_buffer_t, max_segments> segments;
+};
+
+} // namespace srsue
+
+#endif // SRSUE_TUN_OFFLOAD_H
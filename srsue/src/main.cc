@@ -104,6 +104,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("rf.device_args", bpo::value<string>(&args->rf.device_args)->default_value("auto"), "Front-end device arguments")
     ("rf.time_adv_nsamples", bpo::value<string>(&args->rf.time_adv_nsamples)->default_value("auto"), "Transmission time advance")
     ("rf.continuous_tx", bpo::value<string>(&args->rf.continuous_tx)->default_value("auto"), "Transmit samples continuously to the radio or on bursts (auto/yes/no). Default is auto (yes for UHD, no for rest)")
+    ("rf.resampler", bpo::value<string>(&args->rf.resampler)->default_value("fft"), "Resampler for each RF channel when rf.srate is set (fft/polyphase), comma separated")
 
     ("rf.bands.rx[0].min", bpo::value<float>(&args->rf.ch_rx_bands[0].min)->default_value(0), "Lower frequency boundary for CH0-RX")
     ("rf.bands.rx[0].max", bpo::value<float>(&args->rf.ch_rx_bands[0].max)->default_value(0), "Higher frequency boundary for CH0-RX")
@@ -212,6 +213,7 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("gw.netns", bpo::value<string>(&args->gw.netns)->default_value(""), "Network namespace to for TUN device (empty for default netns)")
     ("gw.ip_devname", bpo::value<string>(&args->gw.tun_dev_name)->default_value("tun_srsue"), "Name of the tun_srsue device")
     ("gw.ip_netmask", bpo::value<string>(&args->gw.tun_dev_netmask)->default_value("255.255.255.0"), "Netmask of the tun_srsue device")
+    ("gw.tun_offload", bpo::value<bool>(&args->gw.tun_offload)->default_value(false), "Exchange TCP segments of up to 64 KB with the tun_srsue device (TSO/GSO)")
 
     /* Downlink Channel emulator section */
     ("channel.dl.enable",            bpo::value<bool>(&args->phy.dl_channel_args.enable)->default_value(false),                 "Enable/Disable internal Downlink channel emulator")
@@ -326,6 +328,14 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
        bpo::value<uint32_t>(&args->phy.intra_freq_meas_period_ms)->default_value(200),
        "Period of intra-frequency neighbour cell measurement in ms. Maximum as per 3GPP is 200 ms.")
 
+    ("phy.intra_freq_meas_channelizer",
+       bpo::value<bool>(&args->phy.intra_freq_meas_channelizer)->default_value(false),
+       "Stores only the central PRB of the cell for intra-frequency measurements, reducing copy and search cost.")
+
+    ("phy.intra_freq_meas_cpu",
+       bpo::value<int>(&args->phy.intra_freq_meas_cpu)->default_value(-1),
+       "Index of the core measuring all the carriers in a single thread. Set to -1 for one thread per carrier.")
+
     ("phy.correct_sync_error",
        bpo::value<bool>(&args->phy.correct_sync_error)->default_value(false),
        "Channel estimator measures and pre-compensates time synchronization error. Increases CPU usage, improves PDSCH "
@@ -95,7 +95,8 @@ DECLARE_METRIC_SET("nas_container", mset_nas_container, metric_emm_state);
 DECLARE_METRIC("rf_o", metric_rf_o, uint32_t, "");
 DECLARE_METRIC("rf_u", metric_rf_u, uint32_t, "");
 DECLARE_METRIC("rf_l", metric_rf_l, uint32_t, "");
-DECLARE_METRIC_SET("rf_container", mset_rf_container, metric_rf_o, metric_rf_u, metric_rf_l);
+DECLARE_METRIC("tti_rate", metric_tti_rate, float, "");
+DECLARE_METRIC_SET("rf_container", mset_rf_container, metric_rf_o, metric_rf_u, metric_rf_l, metric_tti_rate);
 
 /// System memory container.
 DECLARE_METRIC("proc_realmem_percent", metric_proc_rmem_percent, uint32_t, "");
@@ -222,6 +223,7 @@ void metrics_json::set_metrics(const ue_metrics_t& metrics, const uint32_t perio
   ctx.get<mset_rf_container>().write<metric_rf_o>(metrics.rf.rf_o);
   ctx.get<mset_rf_container>().write<metric_rf_u>(metrics.rf.rf_u);
   ctx.get<mset_rf_container>().write<metric_rf_l>(metrics.rf.rf_l);
+  ctx.get<mset_rf_container>().write<metric_tti_rate>(metrics.rf.tti_rate);
 
   // Fill system memory container.
   ctx.get<mset_sys_mem_container>().write<metric_proc_rmem_percent>(metrics.sys.process_realmem);
@@ -190,6 +190,11 @@ void metrics_stdout::set_metrics(const ue_metrics_t& metrics, const uint32_t per
     return;
   }
 
+  // A real-time radio cannot sustain more than 1000 subframes per second, so a higher rate means virtual time
+  if (metrics.rf.tti_rate > 1050.0f) {
+    fmt::print("Virtual time: {:.0f} TTI/s\n", metrics.rf.tti_rate);
+  }
+
   if (metrics.stack.rrc.state != RRC_STATE_CONNECTED && metrics.stack.rrc_nr.state != RRC_NR_STATE_CONNECTED) {
     fmt::print("--- disconnected ---\n");
     return;
@@ -75,12 +75,31 @@ bool cell_search::start(const cfg_t& cfg)
     logger.error("Cell search: Error setting SSB configuration");
     return false;
   }
+
+  // Load the SSB center frequencies to search, the configured one goes first
+  nof_freq                = 0;
+  ssb_freq_hz[nof_freq++] = cfg.ssb_freq_hz;
+  for (double f : cfg.other_ssb_freq_hz) {
+    if (nof_freq == SRSRAN_SSB_SEARCH_MAX_NOF_FREQ) {
+      logger.warning("Cell search: Too many SSB frequencies, only the first %d are searched",
+                     SRSRAN_SSB_SEARCH_MAX_NOF_FREQ);
+      break;
+    }
+    ssb_freq_hz[nof_freq++] = f;
+  }
+
   return true;
 }
 
 cell_search::ret_t cell_search::run_slot(const cf_t* buffer, uint32_t slot_sz)
 {
   cell_search::ret_t ret = {};
+  ret.ssb_freq_hz        = ssb_freq_hz[0];
+
+  // Search for SSB in all the frequencies at once if more than one is given
+  if (nof_freq > 1) {
+    return run_slot_multi(buffer, slot_sz);
+  }
 
   // Search for SSB
   if (srsran_ssb_search(&ssb, buffer, slot_sz + ssb.ssb_sz, &ret.ssb_res) < SRSRAN_SUCCESS) {
@@ -95,5 +114,36 @@ cell_search::ret_t cell_search::run_slot(const cf_t* buffer, uint32_t slot_sz)
   return ret;
 }
 
+cell_search::ret_t cell_search::run_slot_multi(const cf_t* buffer, uint32_t slot_sz)
+{
+  cell_search::ret_t ret = {};
+  ret.result             = ret_t::CELL_NOT_FOUND;
+  ret.ssb_freq_hz        = ssb_freq_hz[0];
+
+  // Search for SSB in all the frequencies
+  if (srsran_ssb_search_multi(&ssb, buffer, slot_sz + ssb.ssb_sz, ssb_freq_hz.data(), nof_freq, ssb_res.data()) <
+      SRSRAN_SUCCESS) {
+    logger.error("Error occurred searching SSB in %d frequencies", nof_freq);
+    ret.result = ret_t::ERROR;
+    return ret;
+  }
+
+  // Select the decoded SSB with the highest SNR
+  for (uint32_t i = 0; i < nof_freq; i++) {
+    const srsran_ssb_search_res_t& res = ssb_res[i];
+    if (res.measurements.snr_dB < -10.0f or not res.pbch_msg.crc) {
+      continue;
+    }
+    if (ret.result == ret_t::CELL_FOUND and res.measurements.snr_dB <= ret.ssb_res.measurements.snr_dB) {
+      continue;
+    }
+    ret.result      = ret_t::CELL_FOUND;
+    ret.ssb_res     = res;
+    ret.ssb_freq_hz = ssb_freq_hz[i];
+  }
+
+  return ret;
+}
+
 } // namespace nr
 } // namespace srsue
@@ -35,6 +35,7 @@ intra_measure_base::intra_measure_base(srslog::basic_logger& logger, meas_itf& n
 intra_measure_base::~intra_measure_base()
 {
   srsran_ringbuffer_free(&ring_buffer);
+  srsran_resampler_polyphase_free(&decimator);
 }
 
 void intra_measure_base::init_generic(uint32_t cc_idx_, const args_t& args)
@@ -46,6 +47,7 @@ void intra_measure_base::init_generic(uint32_t cc_idx_, const args_t& args)
   context.trigger_tti_period = args.tti_period;
   context.trigger_tti_offset = args.tti_offset;
   rx_gain_offset_db          = args.rx_gain_offset_db;
+  channelizer_en             = args.channelizer;
 
   // Compute subframe length from the sampling rate if available
   if (std::isnormal(args.srate_hz)) {
@@ -77,18 +79,65 @@ void intra_measure_base::init_generic(uint32_t cc_idx_, const args_t& args)
 
   if (state.get_state() == internal_state::initial) {
     state.set_state(internal_state::idle);
-    start(INTRA_FREQ_MEAS_PRIO);
+
+    // Measurements run in a shared thread if a runner is provided, otherwise in this instance thread
+    runner = args.runner;
+    if (runner != nullptr) {
+      runner->add(this);
+    } else {
+      start(INTRA_FREQ_MEAS_PRIO);
+    }
   }
 }
 
+bool intra_measure_base::set_channelizer(uint32_t decimation_)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if (decimation_ == 0) {
+    ERROR("Invalid decimation factor");
+    return false;
+  }
+
+  // Skip if the configuration has not changed
+  if (decimation_ == decimation) {
+    return true;
+  }
+
+  if (decimation_ > 1) {
+    if (srsran_resampler_polyphase_init(&decimator, 1, decimation_) < SRSRAN_SUCCESS) {
+      ERROR("Error initiating channelizer decimator");
+      return false;
+    }
+  } else {
+    srsran_resampler_polyphase_free(&decimator);
+  }
+
+  decimation         = decimation_;
+  context.decimation = decimation_;
+  return true;
+}
+
+uint32_t intra_measure_base::channelize(const cf_t* data, uint32_t nsamples)
+{
+  if (channel_buffer.size() < nsamples) {
+    channel_buffer.resize(nsamples);
+  }
+
+  // Filter the synchronization signal bandwidth, centered at DC, and decimate
+  return srsran_resampler_polyphase_run(&decimator, data, channel_buffer.data(), nsamples);
+}
+
 void intra_measure_base::stop()
 {
   // Notify quit to asynchronous thread. If it is measuring, it will first finish the measure, report to stack and
   // then it will finish
   state.set_state(internal_state::quit);
 
-  // Wait for the asynchronous thread to finish
-  wait_thread_finish();
+  // Wait for the asynchronous thread to finish, the shared thread is stopped by its owner
+  if (runner == nullptr) {
+    wait_thread_finish();
+  }
 
   srsran_ringbuffer_stop(&ring_buffer);
 }
@@ -117,11 +166,17 @@ void intra_measure_base::set_cells_to_meas(const std::set<uint32_t>& pci)
 
 void intra_measure_base::write(cf_t* data, uint32_t nsamples)
 {
-  int nbytes = (int)(nsamples * sizeof(cf_t));
-
-  mutex.lock();
+  std::unique_lock<std::mutex> lock(mutex);
   int required_nbytes = ((int)context.meas_len_ms * (int)context.sf_len * (int)sizeof(cf_t));
-  mutex.unlock();
+
+  // Only the synchronization signal bandwidth is stored if the channelizer is enabled
+  if (decimation > 1) {
+    nsamples = channelize(data, nsamples);
+    data     = channel_buffer.data();
+  }
+  lock.unlock();
+
+  int nbytes = (int)(nsamples * sizeof(cf_t));
 
   // As nbytes might not match the sub-frame size, make sure that buffer does not overflow
   nbytes = SRSRAN_MIN(srsran_ringbuffer_space(&ring_buffer), nbytes);
@@ -137,6 +192,11 @@ void intra_measure_base::write(cf_t* data, uint32_t nsamples)
     if (srsran_ringbuffer_status(&ring_buffer) >= required_nbytes) {
       Log(debug, "Starting search and measurements");
       state.set_state(internal_state::measure);
+
+      // Wake up the shared thread if any
+      if (runner != nullptr) {
+        runner->notify();
+      }
     }
   }
 }
@@ -160,6 +220,11 @@ void intra_measure_base::run_tti(uint32_t tti, cf_t* data, uint32_t nsamples)
         last_measure_tti = tti;
         srsran_ringbuffer_reset(&ring_buffer);
 
+        // Captures are not contiguous, clear the channelizer filter state
+        mutex.lock();
+        srsran_resampler_polyphase_reset_state(&decimator);
+        mutex.unlock();
+
         // Write baseband to ensure measurement starts in the right TTI
         Log(debug, "Start writing");
         write(data, nsamples);
@@ -201,6 +266,13 @@ void intra_measure_base::measure_proc()
   }
 }
 
+void intra_measure_base::run_pending()
+{
+  if (state.get_state() == internal_state::measure) {
+    measure_proc();
+  }
+}
+
 void intra_measure_base::run_thread()
 {
   bool quit = false;
@@ -229,5 +301,70 @@ void intra_measure_base::run_thread()
   } while (not quit);
 }
 
+void intra_measure_runner::init(int cpu)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if (running) {
+    return;
+  }
+  running = true;
+  quit    = false;
+
+  if (cpu < 0) {
+    start(intra_measure_base::INTRA_FREQ_MEAS_PRIO);
+  } else {
+    start_cpu(intra_measure_base::INTRA_FREQ_MEAS_PRIO, cpu);
+  }
+}
+
+void intra_measure_runner::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (not running) {
+      return;
+    }
+    running = false;
+    quit    = true;
+    cvar.notify_all();
+  }
+
+  wait_thread_finish();
+}
+
+void intra_measure_runner::add(intra_measure_base* q)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  measures.push_back(q);
+}
+
+void intra_measure_runner::notify()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  pending++;
+  cvar.notify_all();
+}
+
+void intra_measure_runner::run_thread()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while (not quit) {
+    // Wait for any instance to have a measurement ready
+    while (pending == 0 and not quit) {
+      cvar.wait(lock);
+    }
+    pending = 0;
+
+    // Run all the pending measurements in a batch, new notifications are accumulated meanwhile
+    for (size_t i = 0; i < measures.size() and not quit; i++) {
+      intra_measure_base* q = measures[i];
+      lock.unlock();
+      q->run_pending();
+      lock.lock();
+    }
+  }
+}
+
 } // namespace scell
 } // namespace srsue
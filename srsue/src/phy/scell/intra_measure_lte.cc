@@ -51,12 +51,26 @@ void intra_measure_lte::init(uint32_t cc_idx, const args_t& args)
 
 void intra_measure_lte::set_primary_cell(uint32_t earfcn, srsran_cell_t cell)
 {
+  // Select the stored bandwidth, the channelizer keeps only the central PRB if the cell is wider
+  uint32_t nof_prb    = cell.nof_prb;
+  uint32_t sf_len     = (uint32_t)SRSRAN_SF_LEN_PRB(cell.nof_prb);
+  uint32_t decimation = 1;
+  if (channelizer_enabled() and cell.nof_prb > CHANNELIZER_NOF_PRB) {
+    nof_prb    = CHANNELIZER_NOF_PRB;
+    decimation = sf_len / (uint32_t)SRSRAN_SF_LEN_PRB(nof_prb);
+    sf_len     = (uint32_t)SRSRAN_SF_LEN_PRB(nof_prb);
+  }
+
   {
     std::lock_guard<std::mutex> lock(mutex);
-    serving_cell   = cell;
+    serving_cell = cell;
+    meas_nof_prb = nof_prb;
   }
   current_earfcn = earfcn;
-  set_current_sf_len((uint32_t)SRSRAN_SF_LEN_PRB(cell.nof_prb));
+  if (not set_channelizer(decimation)) {
+    Log(error, "Error setting channelizer");
+  }
+  set_current_sf_len(sf_len);
 }
 
 bool intra_measure_lte::measure_rat(const measure_context_t& context, std::vector<cf_t>& buffer, float rx_gain_offset)
@@ -66,12 +80,16 @@ bool intra_measure_lte::measure_rat(const measure_context_t& context, std::vecto
   srsran_cell_t serving_cell_copy{};
   {
     std::lock_guard<std::mutex> lock(mutex);
-    serving_cell_copy = serving_cell;
+    serving_cell_copy         = serving_cell;
+    serving_cell_copy.nof_prb = meas_nof_prb;
   }
 
   // Detect new cells using PSS/SSS
   scell_rx.find_cells(buffer.data(), serving_cell_copy, context.meas_len_ms, cells_to_measure);
 
+  // The decimated baseband is transformed with a smaller FFT, compensate its amplitude scaling
+  float decimation_gain_db = srsran_convert_amplitude_to_dB((float)context.decimation);
+
   // Initialise empty neighbour cell list
   std::vector<phy_meas_t> neighbour_cells = {};
 
@@ -102,7 +120,7 @@ bool intra_measure_lte::measure_rat(const measure_context_t& context, std::vecto
       m.rat        = srsran::srsran_rat_t::lte;
       m.pci        = cell.id;
       m.earfcn     = current_earfcn;
-      m.rsrp       = refsignal_dl_sync.rsrp_dBfs - rx_gain_offset_db;
+      m.rsrp       = refsignal_dl_sync.rsrp_dBfs + decimation_gain_db - rx_gain_offset_db;
       m.rsrq       = refsignal_dl_sync.rsrq_dB;
       m.cfo_hz     = refsignal_dl_sync.cfo_Hz;
       neighbour_cells.push_back(m);
@@ -99,12 +99,22 @@ void sync::init(srsran::radio_interface_phy* _radio,
   // Start intra-frequency measurement
   {
     std::lock_guard<std::mutex> lock(intra_freq_cfg_mutex);
+
+    // All carriers are measured by a single thread if a core is given
+    scell::intra_measure_runner* runner = nullptr;
+    if (worker_com->args->intra_freq_meas_cpu >= 0) {
+      intra_freq_runner.init(worker_com->args->intra_freq_meas_cpu);
+      runner = &intra_freq_runner;
+    }
+
     for (uint32_t i = 0; i < worker_com->args->nof_lte_carriers; i++) {
       scell::intra_measure_lte*         q    = new scell::intra_measure_lte(phy_logger, *this);
       scell::intra_measure_base::args_t args = {};
       args.len_ms                            = worker_com->args->intra_freq_meas_len_ms;
       args.period_ms                         = worker_com->args->intra_freq_meas_period_ms;
       args.rx_gain_offset_db                 = worker_com->args->rx_gain_offset;
+      args.channelizer                       = worker_com->args->intra_freq_meas_channelizer;
+      args.runner                            = runner;
       q->init(i, args);
       intra_freq_meas.push_back(std::unique_ptr<scell::intra_measure_lte>(q));
     }
@@ -143,6 +153,7 @@ void sync::stop()
   for (auto& q : intra_freq_meas) {
     q->stop();
   }
+  intra_freq_runner.stop();
 
   // Reset (stop Rx stream) as soon as possible to avoid base-band Rx buffer overflow
   radio_h->reset();
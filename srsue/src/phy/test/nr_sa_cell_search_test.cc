@@ -252,7 +252,7 @@ static cell_search_result_t cell_search(const args_t& args, dummy_ue& ue)
   srsran_assert(band != UINT16_MAX, "Invalid band");
 
   // Calculate SSB center frequency boundaries
-  double   ssb_bw_hz              = SRSRAN_SSB_BW_SUBC * bands.get_ssb_scs(band);
+  double   ssb_bw_hz              = SRSRAN_SSB_BW_SUBC * SRSRAN_SUBC_SPACING_NR(bands.get_ssb_scs(band));
   double   ssb_center_freq_min_hz = args.base_carrier.dl_center_frequency_hz - (args.srate_hz * 0.7 - ssb_bw_hz) / 2.0;
   double   ssb_center_freq_max_hz = args.base_carrier.dl_center_frequency_hz + (args.srate_hz * 0.7 - ssb_bw_hz) / 2.0;
   uint32_t ssb_scs_hz             = SRSRAN_SUBC_SPACING_NR(args.ssb_scs);
@@ -261,25 +261,34 @@ static cell_search_result_t cell_search(const args_t& args, dummy_ue& ue)
   srsran::srsran_band_helper::sync_raster_t ss = bands.get_sync_raster(band, args.ssb_scs);
   srsran_assert(ss.valid(), "Invalid synchronization raster");
 
-  // Iterate every possible frequency in the synchronization raster
+  // Collect every valid frequency in the synchronization raster
+  std::vector<double> ssb_freq_hz;
   while (not ss.end()) {
     // Get SSB center frequency
-    cs_args.ssb_freq_hz = ss.get_frequency();
+    double freq_hz = ss.get_frequency();
 
     // Advance SSB frequency raster
     ss.next();
 
     // Calculate frequency offset between the base-band center frequency and the SSB absolute frequency
-    uint32_t offset_hz = (uint32_t)std::abs(std::round(cs_args.ssb_freq_hz - args.base_carrier.dl_center_frequency_hz));
+    uint32_t offset_hz = (uint32_t)std::abs(std::round(freq_hz - args.base_carrier.dl_center_frequency_hz));
 
     // The SSB absolute frequency is invalid if it is outside the range and the offset is NOT multiple of the subcarrier
     // spacing
-    if ((cs_args.ssb_freq_hz < ssb_center_freq_min_hz) or (cs_args.ssb_freq_hz > ssb_center_freq_max_hz) or
-        (offset_hz % ssb_scs_hz != 0)) {
+    if ((freq_hz < ssb_center_freq_min_hz) or (freq_hz > ssb_center_freq_max_hz) or (offset_hz % ssb_scs_hz != 0)) {
       // Skip this frequency
       continue;
     }
 
+    ssb_freq_hz.push_back(freq_hz);
+  }
+
+  // Search the valid frequencies, as many as possible at once
+  for (size_t i = 0; i < ssb_freq_hz.size(); i += SRSRAN_SSB_SEARCH_MAX_NOF_FREQ) {
+    size_t i_end        = std::min(ssb_freq_hz.size(), i + SRSRAN_SSB_SEARCH_MAX_NOF_FREQ);
+    cs_args.ssb_freq_hz = ssb_freq_hz[i];
+    cs_args.other_ssb_freq_hz.assign(ssb_freq_hz.begin() + i + 1, ssb_freq_hz.begin() + i_end);
+
     // Transition PHY to cell search
     srsran_assert(ue.start_cell_search(cs_args), "Failed cell search start");
 
@@ -296,7 +305,9 @@ static cell_search_result_t cell_search(const args_t& args, dummy_ue& ue)
     }
 
     // Print found cells
-    printf("Cells found at SSB center frequency %.2f MHz:\n", cs_args.ssb_freq_hz / 1e6);
+    printf("Cells found at SSB center frequencies %.2f to %.2f MHz:\n",
+           ssb_freq_hz[i] / 1e6,
+           ssb_freq_hz[i_end - 1] / 1e6);
     printf("| %10s | %10s | %10s | %10s | %10s | %10s | %10s | %10s | %10s | %10s | %10s | %10s |\n",
            "PCI",
            "SSB",
@@ -334,7 +345,7 @@ static cell_search_result_t cell_search(const args_t& args, dummy_ue& ue)
         // If this is the first found cell, then set return value
         if (not ret.found) {
           ret.found           = true;
-          ret.ssb_abs_freq_hz = cs_args.ssb_freq_hz;
+          ret.ssb_abs_freq_hz = bands.nr_arfcn_to_freq(ssb.second.last_result.ssb_arfcn);
           ret.ssb_scs         = cs_args.ssb_scs;
           ret.ssb_pattern     = cs_args.ssb_pattern;
           ret.duplex_mode     = cs_args.duplex_mode;
@@ -369,6 +369,8 @@ int parse_args(int argc, char** argv)
       ("intra_meas_log_level",      bpo::value<std::string>(&intra_meas_log_level)->default_value("none"),         "Intra measurement log level (none, warning, info, debug)")
       ("intra_freq_meas_len_ms",    bpo::value<uint32_t>(&phy_args.intra_freq_meas_len_ms)->default_value(20),     "Intra measurement measurement length")
       ("intra_freq_meas_period_ms", bpo::value<uint32_t>(&phy_args.intra_freq_meas_period_ms)->default_value(200), "Intra measurement measurement period")
+      ("intra_freq_meas_channelizer", bpo::value<bool>(&phy_args.intra_freq_meas_channelizer)->default_value(false), "Intra measurement stores only the central PRB")
+      ("intra_freq_meas_cpu",       bpo::value<int>(&phy_args.intra_freq_meas_cpu)->default_value(-1),             "Intra measurement shared thread core, -1 for a dedicated thread")
       ("phy_lib_log_level",         bpo::value<int>(&phy_lib_log_level)->default_value(SRSRAN_VERBOSE_NONE),       "Phy lib log level (0: none, 1: info, 2: debug)")
       ("active_cell_list",          bpo::value<std::string>(&active_cell_list)->default_value("10,17,24,31,38,45,52"),    "Comma separated neighbour PCI cell list")
       ("enable_json_report",        bpo::value<bool>(&enable_json_report)->default_value(false),                   "Enable JSON file reporting")
@@ -457,10 +459,11 @@ int main(int argc, char** argv)
   json_channel.set_enabled(enable_json_report);
   srslog::init();
 
-  cf_t*                           baseband_buffer = srsran_vec_cf_malloc(SRSRAN_SF_LEN_MAX);
-  srsran::rf_timestamp_t          ts              = {};
-  meas_itf_listener               rrc(json_channel);
-  srsue::scell::intra_measure_lte intra_measure(logger, rrc);
+  cf_t*                              baseband_buffer = srsran_vec_cf_malloc(SRSRAN_SF_LEN_MAX);
+  srsran::rf_timestamp_t             ts              = {};
+  meas_itf_listener                  rrc(json_channel);
+  srsue::scell::intra_measure_lte    intra_measure(logger, rrc);
+  srsue::scell::intra_measure_runner runner;
 
   // Simulation only
   std::vector<std::unique_ptr<test_enb> > test_enb_v;
@@ -532,6 +535,13 @@ int main(int argc, char** argv)
   args.len_ms                                   = phy_args.intra_freq_meas_len_ms;
   args.period_ms                                = phy_args.intra_freq_meas_period_ms;
   args.rx_gain_offset_db                        = phy_args.rx_gain_offset;
+  args.channelizer                              = phy_args.intra_freq_meas_channelizer;
+
+  // Exercise the shared measurement thread if a core is given
+  if (phy_args.intra_freq_meas_cpu >= 0) {
+    runner.init(phy_args.intra_freq_meas_cpu);
+    args.runner = &runner;
+  }
 
   intra_measure.init(0, args);
   intra_measure.set_primary_cell(SRSRAN_MAX(earfcn_dl, 0), cell_base);
@@ -711,6 +721,7 @@ int main(int argc, char** argv)
 
   // Stop, it will block until the asynchronous thread quits
   intra_measure.stop();
+  runner.stop();
 
   ret = rrc.print_stats() ? SRSRAN_SUCCESS : SRSRAN_ERROR;
 
@@ -533,6 +533,7 @@ void ue_stack_lte::run_tti_impl(uint32_t tti, uint32_t tti_jump)
   rrc_nr.run_tti(tti);
   nas.run_tti();
   nas_5g.run_tti();
+  gw->run_tti();
 
   if (args.have_tti_time_stats) {
     std::chrono::nanoseconds dur = tti_tprof.stop();
@@ -211,6 +211,7 @@ void ue_stack_nr::run_tti_impl(uint32_t tti)
   mac->run_tti(tti);
   rrc->run_tti(tti);
   task_sched.tic();
+  gw->run_tti();
 }
 
 void ue_stack_nr::set_phy_config_complete(bool status)
@@ -32,13 +32,14 @@
 #include <linux/netlink.h>
 #include <linux/rtnetlink.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
 namespace srsue {
 
-gw::gw(srslog::basic_logger& logger_) : thread("GW"), logger(logger_), tft_matcher(logger) {}
+gw::gw(srslog::basic_logger& logger_) : thread("GW"), logger(logger_), tft_matcher(logger), dl_coalescer(logger) {}
 
 int gw::init(const gw_args_t& args_, stack_interface_gw* stack_)
 {
@@ -150,7 +151,11 @@ void gw::write_pdu(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
   } else {
     // Only handle IPv4 and IPv6 packets
     struct iphdr* ip_pkt = (struct iphdr*)pdu->msg;
-    if (ip_pkt->version == 4 || ip_pkt->version == 6) {
+    if ((ip_pkt->version == 4 || ip_pkt->version == 6) && args.tun_offload) {
+      // Held back until the end of the TTI, so that the segments of a TCP flow go to the kernel as a single packet
+      std::lock_guard<std::mutex> lock(dl_mutex);
+      dl_coalescer.push(std::move(pdu));
+    } else if (ip_pkt->version == 4 || ip_pkt->version == 6) {
       int n = write(tun_fd, pdu->msg, pdu->N_bytes);
       if (n > 0 && (pdu->N_bytes != (uint32_t)n)) {
         logger.warning("DL TUN/TAP write failure. Wanted to write %d B but only wrote %d B.", pdu->N_bytes, n);
@@ -184,6 +189,9 @@ void gw::write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
       if (run_enable) {
         logger.warning("TUN/TAP not up - dropping gw RX message");
       }
+    } else if (args.tun_offload) {
+      std::lock_guard<std::mutex> lock(dl_mutex);
+      dl_coalescer.push(std::move(pdu));
     } else {
       int n = write(tun_fd, pdu->msg, pdu->N_bytes);
       if (n > 0 && (pdu->N_bytes != (uint32_t)n)) {
@@ -193,6 +201,17 @@ void gw::write_pdu_mch(uint32_t lcid, srsran::unique_byte_buffer_t pdu)
   }
 }
 
+/*******************************************************************************
+  Stack interface
+*******************************************************************************/
+void gw::run_tti()
+{
+  if (args.tun_offload && if_up) {
+    std::lock_guard<std::mutex> lock(dl_mutex);
+    dl_coalescer.flush();
+  }
+}
+
 /*******************************************************************************
   NAS interface
 *******************************************************************************/
@@ -274,14 +293,8 @@ void gw::add_mch_port(uint32_t lcid, uint32_t port)
 /********************/
 void gw::run_thread()
 {
-  uint32 idx     = 0;
-  int32  N_bytes = 0;
-
-  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
-  if (!pdu) {
-    logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
-    return;
-  }
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+  pdus.reserve(UL_BATCH_SIZE);
 
   const static uint32_t REGISTER_WAIT_TOUT = 40, SERVICE_WAIT_TOUT = 40; // 4 sec
   uint32_t              register_wait = 0, service_wait = 0;
@@ -290,29 +303,20 @@ void gw::run_thread()
 
   running = true;
   while (run_enable) {
-    // Read packet from TUN
-    if (SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET > idx) {
-      N_bytes = read(tun_fd, &pdu->msg[idx], SRSRAN_MAX_BUFFER_SIZE_BYTES - SRSRAN_BUFFER_HEADER_OFFSET - idx);
-    } else {
-      logger.error("GW pdu buffer full - gw receive thread exiting.");
-      srsran::console("GW pdu buffer full - gw receive thread exiting.\n");
-      break;
-    }
-    logger.debug("Read %d bytes from TUN fd=%d, idx=%d", N_bytes, tun_fd, idx);
-
-    if (N_bytes <= 0) {
+    // Read a batch of packets from TUN
+    pdus.clear();
+    if (read_tun(pdus) != SRSRAN_SUCCESS) {
       logger.error("Failed to read from TUN interface - gw receive thread exiting.");
       srsran::console("Failed to read from TUN interface - gw receive thread exiting.\n");
       break;
     }
 
-    {
-      std::unique_lock<std::mutex> lock(gw_mutex);
+    std::unique_lock<std::mutex> lock(gw_mutex);
+    for (srsran::unique_byte_buffer_t& pdu : pdus) {
       // Check if IP version makes sense and get packtet length
       struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
       struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
       uint16_t        pkt_len = 0;
-      pdu->N_bytes            = idx + N_bytes;
       if (ip_pkt->version == 4) {
         pkt_len = ntohs(ip_pkt->tot_len);
       } else if (ip_pkt->version == 6) {
@@ -323,74 +327,122 @@ void gw::run_thread()
       }
       logger.debug("IPv%d packet total length: %d Bytes", int(ip_pkt->version), pkt_len);
 
-      // Check if entire packet was received
-      if (pkt_len == pdu->N_bytes) {
-        logger.info(pdu->msg, pdu->N_bytes, "TX PDU");
+      // TUN reads return whole packets, a mismatch means a malformed packet
+      if (pkt_len != pdu->N_bytes) {
+        logger.error(pdu->msg,
+                     pdu->N_bytes,
+                     "IP packet length %d does not match the %d B read. Dropping packet.",
+                     pkt_len,
+                     pdu->N_bytes);
+        continue;
+      }
+      logger.info(pdu->msg, pdu->N_bytes, "TX PDU");
 
-        // Make sure UE is attached and has default EPS bearer activated
-        while (run_enable && default_eps_bearer_id == NOT_ASSIGNED && register_wait < REGISTER_WAIT_TOUT) {
-          if (!register_wait) {
-            logger.info("UE is not attached, waiting for NAS attach (%d/%d)", register_wait, REGISTER_WAIT_TOUT);
-          }
-          lock.unlock();
-          std::this_thread::sleep_for(std::chrono::microseconds(100));
-          lock.lock();
-          register_wait++;
+      // Make sure UE is attached and has default EPS bearer activated
+      while (run_enable && default_eps_bearer_id == NOT_ASSIGNED && register_wait < REGISTER_WAIT_TOUT) {
+        if (!register_wait) {
+          logger.info("UE is not attached, waiting for NAS attach (%d/%d)", register_wait, REGISTER_WAIT_TOUT);
         }
-        register_wait = 0;
+        lock.unlock();
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        lock.lock();
+        register_wait++;
+      }
+      register_wait = 0;
 
-        // If we are still not attached by this stage, drop packet
-        if (run_enable && default_eps_bearer_id == NOT_ASSIGNED) {
-          continue;
-        }
+      // If we are still not attached by this stage, drop packet
+      if (run_enable && default_eps_bearer_id == NOT_ASSIGNED) {
+        continue;
+      }
 
-        if (!run_enable) {
-          break;
-        }
+      if (!run_enable) {
+        break;
+      }
 
-        // Beyond this point we should have a activated default EPS bearer
-        srsran_assert(default_eps_bearer_id != NOT_ASSIGNED, "Default EPS bearer not activated");
+      // Beyond this point we should have a activated default EPS bearer
+      srsran_assert(default_eps_bearer_id != NOT_ASSIGNED, "Default EPS bearer not activated");
 
-        uint8_t eps_bearer_id = default_eps_bearer_id;
-        tft_matcher.check_tft_filter_match(pdu, eps_bearer_id);
+      uint8_t eps_bearer_id = default_eps_bearer_id;
+      tft_matcher.check_tft_filter_match(pdu, eps_bearer_id);
 
-        // Wait for service request if necessary
-        while (run_enable && !stack->has_active_radio_bearer(eps_bearer_id) && service_wait < SERVICE_WAIT_TOUT) {
-          if (!service_wait) {
-            logger.info(
-                "UE does not have service, waiting for NAS service request (%d/%d)", service_wait, SERVICE_WAIT_TOUT);
-            stack->start_service_request();
-          }
-          usleep(100000);
-          service_wait++;
+      // Wait for service request if necessary
+      while (run_enable && !stack->has_active_radio_bearer(eps_bearer_id) && service_wait < SERVICE_WAIT_TOUT) {
+        if (!service_wait) {
+          logger.info(
+              "UE does not have service, waiting for NAS service request (%d/%d)", service_wait, SERVICE_WAIT_TOUT);
+          stack->start_service_request();
         }
-        service_wait = 0;
+        usleep(100000);
+        service_wait++;
+      }
+      service_wait = 0;
+
+      // Quit before writing packet if necessary
+      if (!run_enable) {
+        break;
+      }
 
-        // Quit before writing packet if necessary
-        if (!run_enable) {
+      // Send PDU directly to PDCP
+      pdu->set_timestamp();
+      ul_tput_bytes += pdu->N_bytes;
+      stack->write_sdu(eps_bearer_id, std::move(pdu));
+    }
+  }
+  running = false;
+  logger.info("GW IP receiver thread exiting.");
+}
+
+/**
+ * Reads the packets waiting in the TUN device, blocking until there is at least one. A batch ends when the device has
+ * no more packets or when it holds UL_BATCH_SIZE packets, so that gw_mutex is taken once per batch.
+ */
+int gw::read_tun(std::vector<srsran::unique_byte_buffer_t>& pdus)
+{
+  while (pdus.size() < UL_BATCH_SIZE && run_enable) {
+    if (pdus.empty()) {
+      struct pollfd pfd = {tun_fd, POLLIN, 0};
+      if (poll(&pfd, 1, -1) < 0 && errno != EINTR) {
+        return SRSRAN_ERROR;
+      }
+    }
+
+    if (args.tun_offload) {
+      int N_bytes = read(tun_fd, tun_rx_frame.data(), tun_rx_frame.size());
+      if (N_bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+        if (!pdus.empty()) {
           break;
         }
+        continue;
+      }
+      if (N_bytes <= 0) {
+        return SRSRAN_ERROR;
+      }
+      uint32_t nof_pdus = tun_split_frame(tun_rx_frame.data(), N_bytes, pdus, logger);
+      logger.debug("Read %d bytes from TUN fd=%d, %d packets", N_bytes, tun_fd, nof_pdus);
+      continue;
+    }
 
-        // Send PDU directly to PDCP
-        pdu->set_timestamp();
-        ul_tput_bytes += pdu->N_bytes;
-        stack->write_sdu(eps_bearer_id, std::move(pdu));
-        do {
-          pdu = srsran::make_byte_buffer();
-          if (!pdu) {
-            logger.error("Fatal Error: Couldn't allocate PDU in run_thread().");
-            usleep(100000);
-          }
-        } while (!pdu);
-        idx = 0;
-      } else {
-        idx += N_bytes;
-        logger.debug("Entire packet not read from socket. Total Length %d, N_Bytes %d.", ip_pkt->tot_len, pdu->N_bytes);
+    srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+    if (!pdu) {
+      logger.error("Fatal Error: Couldn't allocate PDU in %s().", __FUNCTION__);
+      usleep(100000);
+      continue;
+    }
+    int N_bytes = read(tun_fd, pdu->msg, pdu->get_tailroom());
+    if (N_bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+      if (!pdus.empty()) {
+        break;
       }
-    } // end of holdering gw_mutex
+      continue;
+    }
+    if (N_bytes <= 0) {
+      return SRSRAN_ERROR;
+    }
+    logger.debug("Read %d bytes from TUN fd=%d", N_bytes, tun_fd);
+    pdu->N_bytes = N_bytes;
+    pdus.push_back(std::move(pdu));
   }
-  running = false;
-  logger.info("GW IP receiver thread exiting.");
+  return SRSRAN_SUCCESS;
 }
 
 /**************************/
@@ -430,6 +482,10 @@ int gw::init_if(char* err_str)
 
   memset(&ifr, 0, sizeof(ifr));
   ifr.ifr_flags = IFF_TUN | IFF_NO_PI;
+  if (args.tun_offload) {
+    // Frames are prefixed with a virtio_net_hdr, which describes TCP super-packets and partial checksums
+    ifr.ifr_flags |= IFF_VNET_HDR;
+  }
   strncpy(
       ifr.ifr_ifrn.ifrn_name, args.tun_dev_name.c_str(), std::min(args.tun_dev_name.length(), (size_t)(IFNAMSIZ - 1)));
   ifr.ifr_ifrn.ifrn_name[IFNAMSIZ - 1] = 0;
@@ -440,6 +496,26 @@ int gw::init_if(char* err_str)
     return SRSRAN_ERROR_CANT_START;
   }
 
+  if (args.tun_offload) {
+    // Let the kernel hand over TCP segments of up to 64 KB and leave the checksums to the GW
+    if (0 > ioctl(tun_fd, TUNSETOFFLOAD, TUN_F_CSUM | TUN_F_TSO4 | TUN_F_TSO6)) {
+      err_str = strerror(errno);
+      logger.error("Failed to enable TUN offloads: %s", err_str);
+      close(tun_fd);
+      return SRSRAN_ERROR_CANT_START;
+    }
+    tun_rx_frame.resize(sizeof(tun_vnet_hdr_t) + 65535);
+    dl_coalescer.set_fd(tun_fd);
+  }
+
+  // The receive thread drains the device in batches
+  if (fcntl(tun_fd, F_SETFL, O_NONBLOCK)) {
+    err_str = strerror(errno);
+    logger.error("Failed to set non-blocking TUN device: %s", err_str);
+    close(tun_fd);
+    return SRSRAN_ERROR_CANT_START;
+  }
+
   // Bring up the interface
   sock = socket(AF_INET, SOCK_DGRAM, 0);
   if (0 > ioctl(sock, SIOCGIFFLAGS, &ifr)) {
@@ -409,6 +409,58 @@ int tft_filter_test_ipv4_tos()
   return 0;
 }
 
+int tft_filter_test_flow_cache()
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT");
+
+  srsran::unique_byte_buffer_t ip_msg1, ip_msg2;
+  ip_msg1 = make_byte_buffer();
+  TESTASSERT(ip_msg1 != nullptr);
+  ip_msg2 = make_byte_buffer();
+  TESTASSERT(ip_msg2 != nullptr);
+
+  ip_msg1->N_bytes = ip_message_len1;
+  memcpy(ip_msg1->msg, ip_tst_message1, ip_message_len1);
+  ip_msg2->N_bytes = ip_message_len2;
+  memcpy(ip_msg2->msg, ip_tst_message2, ip_message_len2);
+
+  // Single local port 2222, which matches the first message only
+  LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT tft = {};
+  tft.tft_op_code                             = LIBLTE_MME_TFT_OPERATION_CODE_CREATE_NEW_TFT;
+  tft.packet_filter_list_size                 = 1;
+  tft.packet_filter_list[0].dir               = LIBLTE_MME_TFT_PACKET_FILTER_DIRECTION_BIDIRECTIONAL;
+  tft.packet_filter_list[0].id                = 1;
+  tft.packet_filter_list[0].eval_precedence   = 0;
+  tft.packet_filter_list[0].filter_size       = 3;
+  tft.packet_filter_list[0].filter[0]         = SINGLE_LOCAL_PORT_TYPE;
+  srsran::uint16_to_uint8(2222, &tft.packet_filter_list[0].filter[1]);
+
+  srsue::tft_pdu_matcher matcher(logger);
+  uint8_t                eps_bearer_id = 0;
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg1, eps_bearer_id) == SRSRAN_ERROR);
+  TESTASSERT(matcher.apply_traffic_flow_template(EPS_BEARER_ID, &tft) == SRSRAN_SUCCESS);
+
+  // Repeated packets of a flow hit the cache and get the same result
+  for (uint32_t i = 0; i < 3; i++) {
+    eps_bearer_id = 0;
+    TESTASSERT(matcher.check_tft_filter_match(ip_msg1, eps_bearer_id) == SRSRAN_SUCCESS);
+    TESTASSERT(eps_bearer_id == EPS_BEARER_ID);
+    TESTASSERT(matcher.check_tft_filter_match(ip_msg2, eps_bearer_id) == SRSRAN_ERROR);
+    TESTASSERT(eps_bearer_id == EPS_BEARER_ID);
+  }
+  TESTASSERT(matcher.nof_cached_flows() == 2);
+
+  // Removing the filter drops the cached results
+  matcher.delete_tft_for_eps_bearer(EPS_BEARER_ID);
+  TESTASSERT(matcher.nof_cached_flows() == 0);
+  eps_bearer_id = 0;
+  TESTASSERT(matcher.check_tft_filter_match(ip_msg1, eps_bearer_id) == SRSRAN_ERROR);
+  TESTASSERT(eps_bearer_id == 0);
+
+  printf("Test TFT flow cache successfull\n");
+  return 0;
+}
+
 int main(int argc, char** argv)
 {
   srslog::basic_logger& logger = srslog::fetch_basic_logger("TFT", false);
@@ -435,4 +487,7 @@ int main(int argc, char** argv)
   if (tft_filter_test_ipv6_combined()) {
     return -1;
   }
+  if (tft_filter_test_flow_cache()) {
+    return -1;
+  }
 }
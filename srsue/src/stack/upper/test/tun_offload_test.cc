@@ -0,0 +1,269 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsue/hdr/stack/upper/tun_offload.h"
+#include "srsran/common/int_helpers.h"
+#include "srsran/common/test_common.h"
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace srsue;
+
+static const uint32_t MSS         = 1448;
+static const uint32_t TCP_HLEN    = 32; // With the timestamp option
+static const uint32_t PAYLOAD_LEN = 10000;
+
+/// Builds an IP/TCP packet with a payload of payload_len bytes, preceded by a vnet header for a TSO super-packet
+static std::vector<uint8_t> make_tso_frame(bool ipv6, uint32_t payload_len, uint32_t seq)
+{
+  uint32_t             ip_hlen = ipv6 ? 40 : 20;
+  uint32_t             hlen    = ip_hlen + TCP_HLEN;
+  std::vector<uint8_t> frame(sizeof(tun_vnet_hdr_t) + hlen + payload_len);
+
+  uint8_t* ip = &frame[sizeof(tun_vnet_hdr_t)];
+  if (ipv6) {
+    ip[0] = 0x60;
+    srsran::uint16_to_uint8(TCP_HLEN + payload_len, &ip[4]);
+    ip[6]  = IPPROTO_TCP;
+    ip[7]  = 64;
+    ip[8]  = 0x20;
+    ip[9]  = 0x01;
+    ip[23] = 1;
+    ip[24] = 0x20;
+    ip[25] = 0x01;
+    ip[39] = 2;
+  } else {
+    ip[0] = 0x45;
+    srsran::uint16_to_uint8(hlen + payload_len, &ip[2]);
+    srsran::uint16_to_uint8(0x1234, &ip[4]);
+    ip[6]            = 0x40; // DF
+    ip[8]            = 64;
+    ip[9]            = IPPROTO_TCP;
+    uint8_t addrs[8] = {172, 16, 0, 2, 8, 8, 8, 8};
+    memcpy(&ip[12], addrs, sizeof(addrs));
+  }
+
+  uint8_t* tcp = &ip[ip_hlen];
+  srsran::uint16_to_uint8(40000, &tcp[0]);
+  srsran::uint16_to_uint8(5201, &tcp[2]);
+  srsran::uint32_to_uint8(seq, &tcp[4]);
+  srsran::uint32_to_uint8(0xa0a0a0a0, &tcp[8]);
+  tcp[12] = (TCP_HLEN / 4) << 4u;
+  tcp[13] = 0x18; // PSH, ACK
+  srsran::uint16_to_uint8(502, &tcp[14]);
+  // NOP, NOP, timestamps
+  uint8_t opts[12] = {1, 1, 8, 10, 0, 0, 1, 0, 0, 0, 2, 0};
+  memcpy(&tcp[20], opts, sizeof(opts));
+  for (uint32_t i = 0; i < payload_len; i++) {
+    tcp[TCP_HLEN + i] = (uint8_t)(i * 7 + 3);
+  }
+
+  // The kernel leaves the pseudo-header sum in the checksum field
+  srsran::uint16_to_uint8(tun_csum_fold(tun_pseudo_hdr_sum(ip, TCP_HLEN + payload_len, IPPROTO_TCP)), &tcp[16]);
+
+  tun_vnet_hdr_t vnet_hdr = {};
+  vnet_hdr.flags          = TUN_VNET_F_NEEDS_CSUM;
+  vnet_hdr.gso_type       = ipv6 ? TUN_VNET_GSO_TCPV6 : TUN_VNET_GSO_TCPV4;
+  vnet_hdr.hdr_len        = hlen;
+  vnet_hdr.gso_size       = MSS;
+  vnet_hdr.csum_start     = ip_hlen;
+  vnet_hdr.csum_offset    = 16;
+  memcpy(frame.data(), &vnet_hdr, sizeof(vnet_hdr));
+  return frame;
+}
+
+static bool tcp_csum_ok(const srsran::byte_buffer_t& pdu, uint32_t ip_hlen)
+{
+  uint32_t l4_len = pdu.N_bytes - ip_hlen;
+  uint32_t sum    = tun_pseudo_hdr_sum(pdu.msg, l4_len, IPPROTO_TCP);
+  return tun_csum_fold(tun_csum_partial(&pdu.msg[ip_hlen], l4_len, sum)) == 0xffff;
+}
+
+int test_segmentation(bool ipv6)
+{
+  srslog::basic_logger& logger  = srslog::fetch_basic_logger("TUN", false);
+  uint32_t              ip_hlen = ipv6 ? 40 : 20;
+  uint32_t              hlen    = ip_hlen + TCP_HLEN;
+
+  std::vector<uint8_t>                      frame = make_tso_frame(ipv6, PAYLOAD_LEN, 1000);
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+  uint32_t                                  nof_segments = (PAYLOAD_LEN + MSS - 1) / MSS;
+  TESTASSERT(tun_split_frame(frame.data(), frame.size(), pdus, logger) == nof_segments);
+  TESTASSERT(pdus.size() == nof_segments);
+
+  const uint8_t* payload = &frame[sizeof(tun_vnet_hdr_t) + hlen];
+  for (uint32_t i = 0; i < nof_segments; i++) {
+    srsran::byte_buffer_t& seg     = *pdus[i];
+    uint32_t               seg_len = std::min(MSS, PAYLOAD_LEN - i * MSS);
+    TESTASSERT(seg.N_bytes == hlen + seg_len);
+    TESTASSERT(memcmp(&seg.msg[hlen], &payload[i * MSS], seg_len) == 0);
+    if (ipv6) {
+      uint16_t payload_len;
+      srsran::uint8_to_uint16(&seg.msg[4], &payload_len);
+      TESTASSERT(payload_len == seg.N_bytes - 40);
+    } else {
+      uint16_t tot_len, ip_id;
+      srsran::uint8_to_uint16(&seg.msg[2], &tot_len);
+      srsran::uint8_to_uint16(&seg.msg[4], &ip_id);
+      TESTASSERT(tot_len == seg.N_bytes);
+      TESTASSERT(ip_id == 0x1234 + i);
+      TESTASSERT(tun_csum_fold(tun_csum_partial(seg.msg, 20)) == 0xffff);
+    }
+    uint32_t seq;
+    srsran::uint8_to_uint32(&seg.msg[ip_hlen + 4], &seq);
+    TESTASSERT(seq == 1000 + i * MSS);
+    // PSH is kept for the last segment only
+    TESTASSERT(seg.msg[ip_hlen + 13] == (i + 1 == nof_segments ? 0x18 : 0x10));
+    TESTASSERT(tcp_csum_ok(seg, ip_hlen));
+  }
+  return SRSRAN_SUCCESS;
+}
+
+int test_csum_completion()
+{
+  srslog::basic_logger& logger = srslog::fetch_basic_logger("TUN", false);
+
+  // IPv4/UDP packet with a partial checksum
+  std::vector<uint8_t> frame(sizeof(tun_vnet_hdr_t) + 20 + 8 + 101);
+  uint8_t*             ip = &frame[sizeof(tun_vnet_hdr_t)];
+  ip[0]                   = 0x45;
+  srsran::uint16_to_uint8(20 + 8 + 101, &ip[2]);
+  ip[8]            = 64;
+  ip[9]            = IPPROTO_UDP;
+  uint8_t addrs[8] = {172, 16, 0, 2, 10, 0, 0, 1};
+  memcpy(&ip[12], addrs, sizeof(addrs));
+  uint8_t* udp = &ip[20];
+  srsran::uint16_to_uint8(2152, &udp[0]);
+  srsran::uint16_to_uint8(53, &udp[2]);
+  srsran::uint16_to_uint8(8 + 101, &udp[4]);
+  for (uint32_t i = 0; i < 101; i++) {
+    udp[8 + i] = (uint8_t)(i * 13);
+  }
+  srsran::uint16_to_uint8(tun_csum_fold(tun_pseudo_hdr_sum(ip, 8 + 101, IPPROTO_UDP)), &udp[6]);
+
+  tun_vnet_hdr_t vnet_hdr = {};
+  vnet_hdr.flags          = TUN_VNET_F_NEEDS_CSUM;
+  vnet_hdr.csum_start     = 20;
+  vnet_hdr.csum_offset    = 6;
+  memcpy(frame.data(), &vnet_hdr, sizeof(vnet_hdr));
+
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+  TESTASSERT(tun_split_frame(frame.data(), frame.size(), pdus, logger) == 1);
+  srsran::byte_buffer_t& pdu = *pdus[0];
+  TESTASSERT(pdu.N_bytes == 20 + 8 + 101);
+  uint32_t sum = tun_pseudo_hdr_sum(pdu.msg, 8 + 101, IPPROTO_UDP);
+  TESTASSERT(tun_csum_fold(tun_csum_partial(&pdu.msg[20], 8 + 101, sum)) == 0xffff);
+  return SRSRAN_SUCCESS;
+}
+
+/// Reads the next frame written by the coalescer
+static std::vector<uint8_t> read_frame(int fd)
+{
+  std::vector<uint8_t> frame(sizeof(tun_vnet_hdr_t) + 65535);
+  ssize_t              n = recv(fd, frame.data(), frame.size(), MSG_DONTWAIT);
+  frame.resize(n > 0 ? n : 0);
+  return frame;
+}
+
+int test_coalescing(bool ipv6)
+{
+  srslog::basic_logger& logger  = srslog::fetch_basic_logger("TUN", false);
+  uint32_t              ip_hlen = ipv6 ? 40 : 20;
+
+  int fds[2];
+  TESTASSERT(socketpair(AF_UNIX, SOCK_DGRAM, 0, fds) == 0);
+  tun_tx_coalescer coalescer(logger);
+  coalescer.set_fd(fds[0]);
+
+  // The segments of a super-packet go out as a single frame, which segments back to the same packets
+  std::vector<uint8_t>                      frame = make_tso_frame(ipv6, PAYLOAD_LEN, 7);
+  std::vector<srsran::unique_byte_buffer_t> segments;
+  std::vector<srsran::byte_buffer_t>        originals;
+  uint32_t nof_segments = tun_split_frame(frame.data(), frame.size(), segments, logger);
+  for (srsran::unique_byte_buffer_t& seg : segments) {
+    originals.push_back(*seg);
+  }
+  for (uint32_t i = 0; i < nof_segments; i++) {
+    coalescer.push(std::move(segments[i]));
+    // The short last segment closes the burst
+    TESTASSERT(coalescer.size() == (i + 1 == nof_segments ? 0 : i + 1));
+  }
+  std::vector<uint8_t> merged = read_frame(fds[1]);
+  TESTASSERT(merged.size() == frame.size());
+  tun_vnet_hdr_t vnet_hdr;
+  memcpy(&vnet_hdr, merged.data(), sizeof(vnet_hdr));
+  TESTASSERT(vnet_hdr.gso_type == (ipv6 ? TUN_VNET_GSO_TCPV6 : TUN_VNET_GSO_TCPV4));
+  TESTASSERT(vnet_hdr.gso_size == MSS);
+  TESTASSERT(vnet_hdr.flags == TUN_VNET_F_NEEDS_CSUM);
+  TESTASSERT(read_frame(fds[1]).empty());
+
+  std::vector<srsran::unique_byte_buffer_t> resegmented;
+  TESTASSERT(tun_split_frame(merged.data(), merged.size(), resegmented, logger) == nof_segments);
+  for (uint32_t i = 0; i < nof_segments; i++) {
+    TESTASSERT(resegmented[i]->N_bytes == originals[i].N_bytes);
+    TESTASSERT(memcmp(resegmented[i]->msg, originals[i].msg, originals[i].N_bytes) == 0);
+  }
+
+  // A gap in the sequence numbers splits the burst
+  resegmented.clear();
+  tun_split_frame(frame.data(), frame.size(), resegmented, logger);
+  coalescer.push(std::move(resegmented[0]));
+  coalescer.push(std::move(resegmented[2]));
+  TESTASSERT(coalescer.size() == 1);
+  std::vector<uint8_t> single = read_frame(fds[1]);
+  TESTASSERT(single.size() == sizeof(tun_vnet_hdr_t) + originals[0].N_bytes);
+  memcpy(&vnet_hdr, single.data(), sizeof(vnet_hdr));
+  TESTASSERT(vnet_hdr.gso_type == TUN_VNET_GSO_NONE);
+  TESTASSERT(memcmp(&single[sizeof(vnet_hdr)], originals[0].msg, originals[0].N_bytes) == 0);
+  TESTASSERT(coalescer.flush() == 1);
+  TESTASSERT(read_frame(fds[1]).size() == sizeof(tun_vnet_hdr_t) + originals[2].N_bytes);
+
+  // Segments with a bad checksum are not merged
+  resegmented.clear();
+  tun_split_frame(frame.data(), frame.size(), resegmented, logger);
+  resegmented[1]->msg[ip_hlen + TCP_HLEN] ^= 0xff;
+  coalescer.push(std::move(resegmented[0]));
+  coalescer.push(std::move(resegmented[1]));
+  TESTASSERT(coalescer.size() == 0);
+  TESTASSERT(read_frame(fds[1]).size() == sizeof(tun_vnet_hdr_t) + originals[0].N_bytes);
+  TESTASSERT(read_frame(fds[1]).size() == sizeof(tun_vnet_hdr_t) + originals[1].N_bytes);
+
+  close(fds[0]);
+  close(fds[1]);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  TESTASSERT(test_segmentation(false) == SRSRAN_SUCCESS);
+  TESTASSERT(test_segmentation(true) == SRSRAN_SUCCESS);
+  TESTASSERT(test_csum_completion() == SRSRAN_SUCCESS);
+  TESTASSERT(test_coalescing(false) == SRSRAN_SUCCESS);
+  TESTASSERT(test_coalescing(true) == SRSRAN_SUCCESS);
+
+  srslog::flush();
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
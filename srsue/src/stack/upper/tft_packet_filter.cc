@@ -192,6 +192,15 @@ bool inline tft_packet_filter_t::filter_contains(uint16_t filtertype)
  * Note: 'active_filters' is a bitmask; bits set to '1' represent active filter components.
  */
 bool tft_packet_filter_t::match(const srsran::unique_byte_buffer_t& pdu)
+{
+  tft_flow_key_t key;
+  if (!key.parse(*pdu)) {
+    return false;
+  }
+  return match(key);
+}
+
+bool tft_packet_filter_t::match(const tft_flow_key_t& key)
 {
   uint16_t ip_flags = IPV4_REMOTE_ADDR_FLAG | IPV4_LOCAL_ADDR_FLAG | IPV6_REMOTE_ADDR_FLAG |
                       IPV6_REMOTE_ADDR_LENGTH_FLAG | IPV6_LOCAL_ADDR_LENGTH_FLAG;
@@ -204,53 +213,53 @@ bool tft_packet_filter_t::match(const srsran::unique_byte_buffer_t& pdu)
   }
 
   // Match IP Header to active filters
-  if (filter_contains(ip_flags) && !match_ip(pdu)) {
+  if (filter_contains(ip_flags) && !match_ip(key)) {
     return false;
   }
 
   // Check Protocol ID/Next Header Field
-  if (filter_contains(PROTOCOL_ID_FLAG) && !match_protocol(pdu)) {
+  if (filter_contains(PROTOCOL_ID_FLAG) && !match_protocol(key)) {
     return false;
   }
 
   // Check Ports/Port Range
-  if (filter_contains(port_flags) && !match_port(pdu)) {
+  if (filter_contains(port_flags) && !match_port(key)) {
     return false;
   }
 
   // Check Type of Service/Traffic class
-  if (filter_contains(TYPE_OF_SERVICE_FLAG) && !match_type_of_service(pdu)) {
+  if (filter_contains(TYPE_OF_SERVICE_FLAG) && !match_type_of_service(key)) {
     return false;
   }
 
   return true;
 }
 
-bool tft_packet_filter_t::match_ip(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_ip(const tft_flow_key_t& key)
 {
-  struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
-  struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
   // It is implied, that this is always an OUTGOING packet
-  if (ip_pkt->version == 4) {
+  if (key.version == 4) {
+    uint32_t saddr, daddr;
+    memcpy(&saddr, key.src_addr, IPV4_ADDR_SIZE);
+    memcpy(&daddr, key.dst_addr, IPV4_ADDR_SIZE);
     // Check match on IPv4 packet
     if (filter_contains(IPV4_LOCAL_ADDR_FLAG)) {
-      if ((ip_pkt->saddr & ipv4_local_addr_mask) != (ipv4_local_addr & ipv4_local_addr_mask)) {
+      if ((saddr & ipv4_local_addr_mask) != (ipv4_local_addr & ipv4_local_addr_mask)) {
         return false;
       }
     }
 
     if (filter_contains(IPV4_REMOTE_ADDR_FLAG)) {
-      if ((ip_pkt->daddr & ipv4_remote_addr_mask) != (ipv4_remote_addr & ipv4_remote_addr_mask)) {
+      if ((daddr & ipv4_remote_addr_mask) != (ipv4_remote_addr & ipv4_remote_addr_mask)) {
         return false;
       }
     }
-  } else if (ip_pkt->version == 6) {
+  } else if (key.version == 6) {
     // Check match on IPv6
     if (filter_contains(IPV6_REMOTE_ADDR_FLAG | IPV6_REMOTE_ADDR_LENGTH_FLAG)) {
-      bool match = true;
-      for (int i = 0; i < ipv6_remote_addr_length; i++) {
-        match &= ((ipv6_remote_addr[i] ^ ip6_pkt->daddr.in6_u.u6_addr8[i]) & ipv6_remote_addr_mask[i]) == 0;
-        if (!match) {
+      // The mask covers the prefix, so comparing all the bytes is enough
+      for (int i = 0; i < IPV6_ADDR_SIZE; i++) {
+        if ((ipv6_remote_addr[i] ^ key.dst_addr[i]) & ipv6_remote_addr_mask[i]) {
           return false;
         }
       }
@@ -263,38 +272,24 @@ bool tft_packet_filter_t::match_ip(const srsran::unique_byte_buffer_t& pdu)
   return true;
 }
 
-bool tft_packet_filter_t::match_protocol(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_protocol(const tft_flow_key_t& key)
 {
-  struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
-  struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
-
-  if (ip_pkt->version == 4) {
-    // Check match on IPv4 packet
-    if (ip_pkt->protocol != protocol_id) {
-      return false;
-    }
-  } else if (ip_pkt->version == 6) {
-    // Check match on IPv6 packet
-    if (ip6_pkt->nexthdr != protocol_id) {
-      return false;
-    }
-  } else {
+  if (key.version != 4 && key.version != 6) {
     // Error
     return false;
   }
-  return true;
+  // Protocol for IPv4, next header for IPv6
+  return key.protocol == protocol_id;
 }
 
-bool tft_packet_filter_t::match_type_of_service(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_type_of_service(const tft_flow_key_t& key)
 {
-  struct iphdr* ip_pkt = (struct iphdr*)pdu->msg;
-
-  if (ip_pkt->version == 4) {
+  if (key.version == 4) {
     // Check match on IPv4 packet
-    if ((ip_pkt->tos ^ type_of_service) & type_of_service_mask) {
+    if ((key.type_of_service ^ type_of_service) & type_of_service_mask) {
       return false;
     }
-  } else if (ip_pkt->version == 6) {
+  } else if (key.version == 6) {
     // IPv6 traffic class not supported yet
     return false;
   }
@@ -314,82 +309,97 @@ bool tft_packet_filter_t::match_flow_label(const srsran::unique_byte_buffer_t& p
   return true;
 }
 
-bool tft_packet_filter_t::match_port(const srsran::unique_byte_buffer_t& pdu)
+bool tft_packet_filter_t::match_port(const tft_flow_key_t& key)
 {
-  struct iphdr*   ip_pkt  = (struct iphdr*)pdu->msg;
-  struct ipv6hdr* ip6_pkt = (struct ipv6hdr*)pdu->msg;
-  struct udphdr*  udp_pkt;
-  struct tcphdr*  tcp_pkt;
+  if (key.version != 4 && key.version != 6) {
+    return true;
+  }
+  if (key.protocol != UDP_PROTOCOL && key.protocol != TCP_PROTOCOL) {
+    return false;
+  }
+  if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
+    if (key.src_port != single_local_port) {
+      return false;
+    }
+  }
+  if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
+    if (key.dst_port != single_remote_port) {
+      return false;
+    }
+  }
+  return true;
+}
 
+bool tft_flow_key_t::parse(const srsran::byte_buffer_t& pdu)
+{
+  *this = {};
+  if (pdu.N_bytes < sizeof(struct iphdr)) {
+    return false;
+  }
+  const struct iphdr*   ip_pkt  = (const struct iphdr*)pdu.msg;
+  const struct ipv6hdr* ip6_pkt = (const struct ipv6hdr*)pdu.msg;
+  uint32_t              l4_offset;
   if (ip_pkt->version == 4) {
-    switch (ip_pkt->protocol) {
-      case UDP_PROTOCOL:
-        udp_pkt = (struct udphdr*)&pdu->msg[ip_pkt->ihl * 4];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (udp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (udp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
-        break;
-      case TCP_PROTOCOL:
-        tcp_pkt = (struct tcphdr*)&pdu->msg[ip_pkt->ihl * 4];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (tcp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (tcp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
-        break;
-      default:
-        return false;
-    }
+    protocol        = ip_pkt->protocol;
+    type_of_service = ip_pkt->tos;
+    memcpy(src_addr, &ip_pkt->saddr, IPV4_ADDR_SIZE);
+    memcpy(dst_addr, &ip_pkt->daddr, IPV4_ADDR_SIZE);
+    l4_offset = ip_pkt->ihl * 4;
   } else if (ip_pkt->version == 6) {
-    switch (ip6_pkt->nexthdr) {
-      case UDP_PROTOCOL:
-        udp_pkt = (struct udphdr*)&pdu->msg[sizeof(ipv6hdr)];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (udp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (udp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
-        break;
-      case TCP_PROTOCOL:
-        tcp_pkt = (struct tcphdr*)&pdu->msg[sizeof(ipv6hdr)];
-        if (active_filters & SINGLE_LOCAL_PORT_FLAG) {
-          if (tcp_pkt->source != single_local_port) {
-            return false;
-          }
-        }
-        if (active_filters & SINGLE_REMOTE_PORT_FLAG) {
-          if (tcp_pkt->dest != single_remote_port) {
-            return false;
-          }
-        }
-        break;
-      default:
-        return false;
+    if (pdu.N_bytes < sizeof(struct ipv6hdr)) {
+      return false;
     }
+    protocol = ip6_pkt->nexthdr;
+    memcpy(src_addr, ip6_pkt->saddr.in6_u.u6_addr8, IPV6_ADDR_SIZE);
+    memcpy(dst_addr, ip6_pkt->daddr.in6_u.u6_addr8, IPV6_ADDR_SIZE);
+    l4_offset = sizeof(struct ipv6hdr);
+  } else {
+    return false;
+  }
+  version = ip_pkt->version;
+
+  // Source and destination ports are at the same offset for UDP and TCP
+  if ((protocol == UDP_PROTOCOL || protocol == TCP_PROTOCOL) && pdu.N_bytes >= l4_offset + 4) {
+    memcpy(&src_port, &pdu.msg[l4_offset], 2);
+    memcpy(&dst_port, &pdu.msg[l4_offset + 2], 2);
   }
   return true;
 }
 
+bool tft_flow_key_t::operator==(const tft_flow_key_t& other) const
+{
+  return version == other.version && protocol == other.protocol && type_of_service == other.type_of_service &&
+         src_port == other.src_port && dst_port == other.dst_port &&
+         memcmp(src_addr, other.src_addr, IPV6_ADDR_SIZE) == 0 && memcmp(dst_addr, other.dst_addr, IPV6_ADDR_SIZE) == 0;
+}
+
+size_t tft_flow_key_hasher::operator()(const tft_flow_key_t& key) const
+{
+  uint64_t words[4];
+  memcpy(&words[0], key.src_addr, 8);
+  memcpy(&words[1], key.src_addr + 8, 8);
+  memcpy(&words[2], key.dst_addr, 8);
+  memcpy(&words[3], key.dst_addr + 8, 8);
+  uint64_t h = ((uint64_t)key.src_port << 32u) | ((uint64_t)key.dst_port << 16u) | ((uint64_t)key.protocol << 8u) |
+               key.type_of_service;
+  for (uint64_t w : words) {
+    h = (h ^ w) * 0x100000001b3ULL;
+    h ^= h >> 29u;
+  }
+  return (size_t)h;
+}
+
 void tft_pdu_matcher::reset()
 {
+  std::lock_guard<std::mutex> lock(tft_mutex);
   tft_filter_map.clear();
+  flow_cache.clear();
+}
+
+size_t tft_pdu_matcher::nof_cached_flows()
+{
+  std::lock_guard<std::mutex> lock(tft_mutex);
+  return flow_cache.size();
 }
 
 /**
@@ -402,15 +412,37 @@ void tft_pdu_matcher::reset()
 int tft_pdu_matcher::check_tft_filter_match(const srsran::unique_byte_buffer_t& pdu, uint8_t& eps_bearer_id)
 {
   std::lock_guard<std::mutex> lock(tft_mutex);
-  for (std::pair<const uint16_t, tft_packet_filter_t>& filter_pair : tft_filter_map) {
-    bool match = filter_pair.second.match(pdu);
-    if (match) {
-      eps_bearer_id = filter_pair.second.eps_bearer_id;
-      logger.debug("Found filter match -- EPS bearer Id %d", filter_pair.second.eps_bearer_id);
-      return SRSRAN_SUCCESS;
+  if (tft_filter_map.empty()) {
+    return SRSRAN_ERROR;
+  }
+
+  tft_flow_key_t key;
+  if (!key.parse(*pdu)) {
+    return SRSRAN_ERROR;
+  }
+
+  // Only the first packet of a flow goes through the filters
+  auto cached = flow_cache.find(key);
+  if (cached == flow_cache.end()) {
+    uint8_t result = no_match;
+    for (std::pair<const uint16_t, tft_packet_filter_t>& filter_pair : tft_filter_map) {
+      if (filter_pair.second.match(key)) {
+        result = filter_pair.second.eps_bearer_id;
+        logger.debug("Found filter match -- EPS bearer Id %d", filter_pair.second.eps_bearer_id);
+        break;
+      }
+    }
+    if (flow_cache.size() >= max_cached_flows) {
+      flow_cache.clear();
     }
+    cached = flow_cache.emplace(key, result).first;
   }
-  return SRSRAN_ERROR;
+
+  if (cached->second == no_match) {
+    return SRSRAN_ERROR;
+  }
+  eps_bearer_id = cached->second;
+  return SRSRAN_SUCCESS;
 }
 
 /**
@@ -428,6 +460,7 @@ void tft_pdu_matcher::delete_tft_for_eps_bearer(const uint8_t eps_bearer_id)
   if (old_filter != tft_filter_map.end()) {
     logger.debug("Deleting TFT for EPS bearer %d", eps_bearer_id);
     tft_filter_map.erase(old_filter);
+    flow_cache.clear();
   }
 }
 
@@ -435,6 +468,7 @@ int tft_pdu_matcher::apply_traffic_flow_template(const uint8_t&
                                                  const LIBLTE_MME_TRAFFIC_FLOW_TEMPLATE_STRUCT* tft)
 {
   std::lock_guard<std::mutex> lock(tft_mutex);
+  flow_cache.clear();
   switch (tft->tft_op_code) {
     case LIBLTE_MME_TFT_OPERATION_CODE_CREATE_NEW_TFT:
       for (int i = 0; i < tft->packet_filter_list_size; i++) {
@@ -0,0 +1,413 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsue/hdr/stack/upper/tun_offload.h"
+#include "srsran/common/int_helpers.h"
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <string.h>
+
+namespace srsue {
+
+static const uint32_t IPV4_HDR_LEN       = 20;
+static const uint32_t IPV6_HDR_LEN       = 40;
+static const uint32_t TCP_HDR_LEN        = 20;
+static const uint32_t TCP_CSUM_OFFSET    = 16;
+static const uint32_t MAX_IP_PACKET_SIZE = 65535;
+
+static const uint8_t TCP_FLAG_FIN = 0x01;
+static const uint8_t TCP_FLAG_PSH = 0x08;
+static const uint8_t TCP_FLAG_ACK = 0x10;
+static const uint8_t TCP_FLAG_CWR = 0x80;
+
+static inline uint16_t read_u16(const uint8_t* buf)
+{
+  return (uint16_t)((buf[0] << 8u) | buf[1]);
+}
+
+static inline uint32_t read_u32(const uint8_t* buf)
+{
+  return ((uint32_t)buf[0] << 24u) | ((uint32_t)buf[1] << 16u) | ((uint32_t)buf[2] << 8u) | buf[3];
+}
+
+uint32_t tun_csum_partial(const uint8_t* data, uint32_t len, uint32_t sum)
+{
+  uint64_t acc = sum;
+  for (; len > 1; len -= 2, data += 2) {
+    acc += read_u16(data);
+  }
+  if (len > 0) {
+    acc += (uint32_t)data[0] << 8u;
+  }
+  while (acc >> 32u) {
+    acc = (acc & 0xffffffffULL) + (acc >> 32u);
+  }
+  return (uint32_t)acc;
+}
+
+uint16_t tun_csum_fold(uint32_t sum)
+{
+  while (sum >> 16u) {
+    sum = (sum & 0xffffu) + (sum >> 16u);
+  }
+  return (uint16_t)sum;
+}
+
+uint32_t tun_pseudo_hdr_sum(const uint8_t* ip_pkt, uint32_t l4_len, uint8_t protocol)
+{
+  uint32_t sum;
+  if ((ip_pkt[0] >> 4u) == 4) {
+    // Source and destination addresses
+    sum = tun_csum_partial(&ip_pkt[12], 8);
+  } else {
+    sum = tun_csum_partial(&ip_pkt[8], 32);
+  }
+  return sum + protocol + (l4_len >> 16u) + (l4_len & 0xffffu);
+}
+
+static void set_ipv4_hdr_csum(uint8_t* ip_pkt, uint32_t ip_hlen)
+{
+  ip_pkt[10] = 0;
+  ip_pkt[11] = 0;
+  srsran::uint16_to_uint8(~tun_csum_fold(tun_csum_partial(ip_pkt, ip_hlen)), &ip_pkt[10]);
+}
+
+/// Fills in the full TCP checksum of a packet whose headers and payload are in place
+static void set_tcp_csum(uint8_t* ip_pkt, uint32_t ip_hlen, uint32_t len)
+{
+  uint8_t* tcp             = &ip_pkt[ip_hlen];
+  tcp[TCP_CSUM_OFFSET]     = 0;
+  tcp[TCP_CSUM_OFFSET + 1] = 0;
+  uint32_t sum             = tun_pseudo_hdr_sum(ip_pkt, len - ip_hlen, IPPROTO_TCP);
+  srsran::uint16_to_uint8(~tun_csum_fold(tun_csum_partial(tcp, len - ip_hlen, sum)), &tcp[TCP_CSUM_OFFSET]);
+}
+
+/// Returns the IP header length of a TCP packet, or 0 if the packet is not IPv4/IPv6 TCP
+static uint32_t tcp_ip_hlen(const uint8_t* pkt, uint32_t len)
+{
+  if (len < IPV4_HDR_LEN) {
+    return 0;
+  }
+  if ((pkt[0] >> 4u) == 4) {
+    uint32_t ip_hlen = (pkt[0] & 0x0fu) * 4;
+    return (ip_hlen >= IPV4_HDR_LEN && pkt[9] == IPPROTO_TCP) ? ip_hlen : 0;
+  }
+  if ((pkt[0] >> 4u) == 6) {
+    // Extension headers are not expected in TCP segments from the local stack
+    return (len >= IPV6_HDR_LEN && pkt[6] == IPPROTO_TCP) ? IPV6_HDR_LEN : 0;
+  }
+  return 0;
+}
+
+static uint32_t segment_tcp(const tun_vnet_hdr_t&                      vnet_hdr,
+                            const uint8_t*                             pkt,
+                            uint32_t                                   len,
+                            std::vector<srsran::unique_byte_buffer_t>& pdus,
+                            srslog::basic_logger&                      logger)
+{
+  uint32_t ip_hlen = tcp_ip_hlen(pkt, len);
+  if (ip_hlen == 0 || len < ip_hlen + TCP_HDR_LEN) {
+    logger.error("Dropping GSO frame with %d B that is not a TCP packet", len);
+    return 0;
+  }
+  const uint8_t* tcp      = &pkt[ip_hlen];
+  uint32_t       hlen     = ip_hlen + (tcp[12] >> 4u) * 4;
+  uint32_t       mss      = vnet_hdr.gso_size;
+  bool           is_ipv4  = (pkt[0] >> 4u) == 4;
+  uint32_t       seq      = read_u32(&tcp[4]);
+  uint16_t       ip_id    = read_u16(&pkt[4]);
+  uint8_t        flags    = tcp[13];
+  uint32_t       nof_pdus = 0;
+  if (hlen > len || mss == 0) {
+    logger.error("Dropping malformed GSO frame with %d B (hdr_len=%d, gso_size=%d)", len, hlen, mss);
+    return 0;
+  }
+
+  for (uint32_t offset = hlen; offset < len; offset += mss) {
+    uint32_t                     seg_len = std::min(mss, len - offset);
+    srsran::unique_byte_buffer_t pdu     = srsran::make_byte_buffer();
+    if (pdu == nullptr) {
+      logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+      break;
+    }
+    if (hlen + seg_len > pdu->get_tailroom()) {
+      logger.error("Dropping GSO frame with segments of %d B", hlen + seg_len);
+      break;
+    }
+    memcpy(pdu->msg, pkt, hlen);
+    memcpy(&pdu->msg[hlen], &pkt[offset], seg_len);
+    pdu->N_bytes = hlen + seg_len;
+
+    uint8_t* ip_hdr  = pdu->msg;
+    uint8_t* tcp_hdr = &pdu->msg[ip_hlen];
+    if (is_ipv4) {
+      srsran::uint16_to_uint8(pdu->N_bytes, &ip_hdr[2]);
+      srsran::uint16_to_uint8(ip_id + nof_pdus, &ip_hdr[4]);
+      set_ipv4_hdr_csum(ip_hdr, ip_hlen);
+    } else {
+      srsran::uint16_to_uint8(pdu->N_bytes - IPV6_HDR_LEN, &ip_hdr[4]);
+    }
+    srsran::uint32_to_uint8(seq + (offset - hlen), &tcp_hdr[4]);
+    // FIN and PSH belong to the last segment, CWR to the first one
+    uint8_t seg_flags = flags;
+    if (offset + seg_len < len) {
+      seg_flags &= ~(TCP_FLAG_FIN | TCP_FLAG_PSH);
+    }
+    if (offset > hlen) {
+      seg_flags &= ~TCP_FLAG_CWR;
+    }
+    tcp_hdr[13] = seg_flags;
+    set_tcp_csum(ip_hdr, ip_hlen, pdu->N_bytes);
+
+    pdus.push_back(std::move(pdu));
+    nof_pdus++;
+  }
+  return nof_pdus;
+}
+
+uint32_t tun_split_frame(const uint8_t*                             frame,
+                         uint32_t                                   len,
+                         std::vector<srsran::unique_byte_buffer_t>& pdus,
+                         srslog::basic_logger&                      logger)
+{
+  tun_vnet_hdr_t vnet_hdr;
+  if (len <= sizeof(vnet_hdr)) {
+    logger.error("Dropping TUN frame with %d B, too short for the vnet header", len);
+    return 0;
+  }
+  memcpy(&vnet_hdr, frame, sizeof(vnet_hdr));
+  const uint8_t* pkt     = &frame[sizeof(vnet_hdr)];
+  uint32_t       pkt_len = len - sizeof(vnet_hdr);
+
+  uint8_t gso_type = vnet_hdr.gso_type & ~TUN_VNET_GSO_ECN;
+  if (gso_type == TUN_VNET_GSO_TCPV4 || gso_type == TUN_VNET_GSO_TCPV6) {
+    // Segmentation computes all the checksums from scratch
+    return segment_tcp(vnet_hdr, pkt, pkt_len, pdus, logger);
+  }
+  if (gso_type != TUN_VNET_GSO_NONE) {
+    logger.error("Dropping TUN frame with unsupported GSO type %d", vnet_hdr.gso_type);
+    return 0;
+  }
+
+  srsran::unique_byte_buffer_t pdu = srsran::make_byte_buffer();
+  if (pdu == nullptr) {
+    logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+    return 0;
+  }
+  if (pkt_len > pdu->get_tailroom()) {
+    logger.error("Dropping TUN frame with %d B", pkt_len);
+    return 0;
+  }
+  memcpy(pdu->msg, pkt, pkt_len);
+  pdu->N_bytes = pkt_len;
+
+  if (vnet_hdr.flags & TUN_VNET_F_NEEDS_CSUM) {
+    // The checksum field holds the pseudo-header sum, the rest of the L4 segment has to be added to it
+    uint32_t csum_start = vnet_hdr.csum_start;
+    uint32_t csum_pos   = csum_start + vnet_hdr.csum_offset;
+    if (csum_pos + 2 > pkt_len) {
+      logger.error("Dropping TUN frame with checksum offset %d beyond its %d B", csum_pos, pkt_len);
+      return 0;
+    }
+    uint16_t csum = ~tun_csum_fold(tun_csum_partial(&pdu->msg[csum_start], pkt_len - csum_start));
+    // A computed 0 is sent as 0xffff, since 0 means no checksum for UDP
+    srsran::uint16_to_uint8(csum == 0 ? 0xffff : csum, &pdu->msg[csum_pos]);
+  }
+  pdus.push_back(std::move(pdu));
+  return 1;
+}
+
+/**
+ * Returns true if pdu is an IPv4/IPv6 TCP segment with payload and valid checksums, that carries no flags other than
+ * ACK and PSH. Only such segments are merged.
+ */
+bool tun_tx_coalescer::parse_segment(const srsran::byte_buffer_t& pdu, tcp_segment_t& seg) const
+{
+  const uint8_t* pkt     = pdu.msg;
+  uint32_t       len     = pdu.N_bytes;
+  uint32_t       ip_hlen = tcp_ip_hlen(pkt, len);
+  if (ip_hlen == 0 || len < ip_hlen + TCP_HDR_LEN) {
+    return false;
+  }
+  if ((pkt[0] >> 4u) == 4) {
+    // No IP options nor fragments
+    if (ip_hlen != IPV4_HDR_LEN || read_u16(&pkt[2]) != len || (read_u16(&pkt[6]) & 0x3fffu) != 0 ||
+        tun_csum_fold(tun_csum_partial(pkt, ip_hlen)) != 0xffff) {
+      return false;
+    }
+  } else if (read_u16(&pkt[4]) + IPV6_HDR_LEN != len) {
+    return false;
+  }
+
+  const uint8_t* tcp  = &pkt[ip_hlen];
+  uint32_t       hlen = ip_hlen + (tcp[12] >> 4u) * 4;
+  uint8_t        flgs = tcp[13];
+  if (hlen < ip_hlen + TCP_HDR_LEN || hlen >= len || (flgs & TCP_FLAG_ACK) == 0 ||
+      (flgs & ~(TCP_FLAG_ACK | TCP_FLAG_PSH)) != 0) {
+    return false;
+  }
+  if (tun_csum_fold(tun_csum_partial(tcp, len - ip_hlen, tun_pseudo_hdr_sum(pkt, len - ip_hlen, IPPROTO_TCP))) !=
+      0xffff) {
+    return false;
+  }
+
+  seg.ip_hlen     = ip_hlen;
+  seg.hlen        = hlen;
+  seg.payload_len = len - hlen;
+  seg.seq         = read_u32(&tcp[4]);
+  seg.flags       = flgs;
+  return true;
+}
+
+bool tun_tx_coalescer::can_merge(const srsran::byte_buffer_t& pdu, const tcp_segment_t& seg) const
+{
+  if (seg.ip_hlen != first.ip_hlen || seg.hlen != first.hlen || seg.seq != next_seq ||
+      seg.payload_len > first.payload_len || first.hlen + nof_payload + seg.payload_len > MAX_IP_PACKET_SIZE) {
+    return false;
+  }
+
+  // Everything but the lengths, IPv4 id, sequence numbers and checksums has to match the first segment
+  const uint8_t* a = segments[0]->msg;
+  const uint8_t* b = pdu.msg;
+  if ((a[0] >> 4u) == 4) {
+    if (memcmp(a, b, 2) != 0 || memcmp(&a[6], &b[6], 4) != 0 || memcmp(&a[12], &b[12], 8) != 0) {
+      return false;
+    }
+  } else if (memcmp(a, b, 4) != 0 || memcmp(&a[6], &b[6], IPV6_HDR_LEN - 6) != 0) {
+    return false;
+  }
+  const uint8_t* tcp_a = &a[seg.ip_hlen];
+  const uint8_t* tcp_b = &b[seg.ip_hlen];
+  return memcmp(tcp_a, tcp_b, 4) == 0 && memcmp(&tcp_a[8], &tcp_b[8], 5) == 0 &&
+         memcmp(&tcp_a[14], &tcp_b[14], 2) == 0 &&
+         memcmp(&tcp_a[18], &tcp_b[18], seg.hlen - seg.ip_hlen - 18) == 0;
+}
+
+void tun_tx_coalescer::push(srsran::unique_byte_buffer_t pdu)
+{
+  tcp_segment_t seg;
+  if (!parse_segment(*pdu, seg)) {
+    flush();
+    write_single(*pdu);
+    return;
+  }
+  if (nof_segments > 0 && !can_merge(*pdu, seg)) {
+    flush();
+  }
+  if (nof_segments == 0) {
+    first       = seg;
+    next_seq    = seg.seq;
+    nof_payload = 0;
+  }
+  next_seq += seg.payload_len;
+  nof_payload += seg.payload_len;
+  segments[nof_segments++] = std::move(pdu);
+
+  // A short segment or a PSH ends the burst, like in the GRO of the kernel
+  if (seg.payload_len < first.payload_len || (seg.flags & TCP_FLAG_PSH) || nof_segments == max_segments) {
+    flush();
+  }
+}
+
+uint32_t tun_tx_coalescer::flush()
+{
+  if (nof_segments == 0) {
+    return 0;
+  }
+  if (nof_segments == 1) {
+    write_single(*segments[0]);
+    segments[0].reset();
+    nof_segments = 0;
+    return 1;
+  }
+
+  // Headers of the first segment, with the length of the whole super-packet
+  uint8_t  hdr[IPV6_HDR_LEN + 60];
+  uint32_t ip_hlen = first.ip_hlen;
+  uint32_t tot_len = first.hlen + nof_payload;
+  memcpy(hdr, segments[0]->msg, first.hlen);
+  if ((hdr[0] >> 4u) == 4) {
+    srsran::uint16_to_uint8(tot_len, &hdr[2]);
+    set_ipv4_hdr_csum(hdr, ip_hlen);
+  } else {
+    srsran::uint16_to_uint8(tot_len - IPV6_HDR_LEN, &hdr[4]);
+  }
+  hdr[ip_hlen + 13] |= segments[nof_segments - 1]->msg[ip_hlen + 13] & TCP_FLAG_PSH;
+  // The kernel completes the checksum of each segment from the pseudo-header sum
+  srsran::uint16_to_uint8(tun_csum_fold(tun_pseudo_hdr_sum(hdr, tot_len - ip_hlen, IPPROTO_TCP)),
+                          &hdr[ip_hlen + TCP_CSUM_OFFSET]);
+
+  tun_vnet_hdr_t vnet_hdr = {};
+  vnet_hdr.flags          = TUN_VNET_F_NEEDS_CSUM;
+  vnet_hdr.gso_type       = (hdr[0] >> 4u) == 4 ? TUN_VNET_GSO_TCPV4 : TUN_VNET_GSO_TCPV6;
+  vnet_hdr.hdr_len        = first.hlen;
+  vnet_hdr.gso_size       = first.payload_len;
+  vnet_hdr.csum_start     = ip_hlen;
+  vnet_hdr.csum_offset    = TCP_CSUM_OFFSET;
+
+  std::array<iovec, max_segments + 2> iov;
+  iov[1] = {hdr, first.hlen};
+  for (uint32_t i = 0; i < nof_segments; i++) {
+    iov[i + 2] = {&segments[i]->msg[first.hlen], segments[i]->N_bytes - first.hlen};
+  }
+  write_frame(vnet_hdr, iov.data(), nof_segments + 2, tot_len);
+
+  for (uint32_t i = 0; i < nof_segments; i++) {
+    segments[i].reset();
+  }
+  nof_segments = 0;
+  return 1;
+}
+
+void tun_tx_coalescer::write_single(const srsran::byte_buffer_t& pdu)
+{
+  tun_vnet_hdr_t vnet_hdr = {};
+  iovec          iov[2];
+  iov[1] = {pdu.msg, pdu.N_bytes};
+  write_frame(vnet_hdr, iov, 2, pdu.N_bytes);
+}
+
+/// iov[0] is reserved for the vnet header
+bool tun_tx_coalescer::write_frame(const tun_vnet_hdr_t& vnet_hdr,
+                                   iovec*                iov,
+                                   uint32_t              nof_iov,
+                                   uint32_t              nof_bytes)
+{
+  iov[0] = {const_cast<tun_vnet_hdr_t*>(&vnet_hdr), sizeof(vnet_hdr)};
+  ssize_t n;
+  do {
+    n = writev(fd, iov, nof_iov);
+  } while (n < 0 && errno == EINTR);
+  if (n < 0) {
+    logger.error("DL TUN/TAP write failure: %s", strerror(errno));
+    return false;
+  }
+  if ((size_t)n != sizeof(vnet_hdr) + nof_bytes) {
+    logger.warning("DL TUN/TAP write failure. Wanted to write %zd B but only wrote %zd B.",
+                   sizeof(vnet_hdr) + nof_bytes,
+                   (size_t)n);
+    return false;
+  }
+  return true;
+}
+
+} // namespace srsue
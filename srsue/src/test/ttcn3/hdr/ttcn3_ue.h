@@ -67,6 +67,7 @@ public:
                      uint8_t* ipv6_if_id,
                      char*    err_str);
   bool is_running();
+  void run_tti() {}
 
   int deactivate_eps_bearer(const uint32_t eps_bearer_id);
 